@@ -0,0 +1,582 @@
+// End-to-end appearance sync benchmark.
+//
+// Generates a synthetic mod set with a realistic size mix (many small .mtrl/.mdl,
+// some small .tex, a few 10-100MB .tex) and drives the same pipeline a player
+// sync goes through: manifest, delta against the receiver cache, 128KB FCHK
+// chunking, send over loopback peers, reassembly, SHA-256 verify and write.
+// Hashing the sender's manifest is timed separately (manifest_ms); the
+// first-byte, renderable and complete times start at the request.
+// --compact-frames switches the chunks to the chunk_frame.h OPEN/DATA format.
+// --unordered (implies --compact-frames) models unordered bulk channels: frames
+// arrive shuffled within a reorder window and are written at their offsets.
+// --game-friendly runs the workers under the thread_policy.h game preset.
+//
+// Usage: appearance_sync_bench [--mtrl N] [--mdl N] [--small-tex N] [--large-tex N]
+//                              [--channels N] [--cached-percent P] [--link-mbps M]
+//                              [--buffered-kb K] [--seed S] [--compact-frames]
+//                              [--unordered] [--game-friendly] [--keep] [--json]
+
+#include "bench_util.h"
+#include "../chunk_assembler.h"
+#include "../chunk_frame.h"
+#include "../sha256.h"
+#include "../thread_policy.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace fyteclub::bench;
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr size_t kChunkSize = 128 * 1024; // ProgressiveFileTransfer.CHUNK_SIZE
+constexpr uint64_t kLargeTextureThreshold = 10ull * 1024 * 1024;
+constexpr size_t kReorderWindow = 8; // frames an unordered channel may shuffle
+
+struct SyntheticFile {
+    std::string game_path;
+    std::vector<uint8_t> content;
+    std::string hash;
+    bool renderable = true;
+};
+
+struct ManifestEntry {
+    std::string game_path;
+    std::string hash;
+    uint64_t size = 0;
+    bool renderable = true;
+};
+
+// Stand-in for a data channel between two loopback peers: messages are
+// delivered in order, Send blocks once bufferedAmount would exceed the limit
+// (like the SCTP send buffer) and an optional link rate paces delivery.
+class LoopbackChannel {
+public:
+    LoopbackChannel(size_t max_buffered, double link_bytes_per_ms)
+        : max_buffered_(max_buffered), link_bytes_per_ms_(link_bytes_per_ms) {}
+
+    void Send(std::vector<uint8_t> message) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        can_send_.wait(lock, [&] { return closed_ || buffered_ + message.size() <= max_buffered_ || queue_.empty(); });
+        if (closed_) return;
+
+        auto ready_at = Clock::now();
+        if (link_bytes_per_ms_ > 0) {
+            auto transmit = std::chrono::duration<double, std::milli>(message.size() / link_bytes_per_ms_);
+            link_free_at_ = std::max(link_free_at_, ready_at) + std::chrono::duration_cast<Clock::duration>(transmit);
+            ready_at = link_free_at_;
+        }
+        buffered_ += message.size();
+        queue_.push_back({ready_at, std::move(message)});
+        can_receive_.notify_one();
+    }
+
+    bool Receive(std::vector<uint8_t>& message) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        can_receive_.wait(lock, [&] { return closed_ || !queue_.empty(); });
+        if (queue_.empty()) return false;
+
+        auto ready_at = queue_.front().ready_at;
+        if (ready_at > Clock::now()) {
+            lock.unlock();
+            std::this_thread::sleep_until(ready_at);
+            lock.lock();
+        }
+        message = std::move(queue_.front().payload);
+        queue_.pop_front();
+        buffered_ -= message.size();
+        can_send_.notify_all();
+        return true;
+    }
+
+    void Close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        can_send_.notify_all();
+        can_receive_.notify_all();
+    }
+
+private:
+    struct Pending {
+        Clock::time_point ready_at;
+        std::vector<uint8_t> payload;
+    };
+
+    std::mutex mutex_;
+    std::condition_variable can_send_;
+    std::condition_variable can_receive_;
+    std::deque<Pending> queue_;
+    size_t max_buffered_;
+    size_t buffered_ = 0;
+    double link_bytes_per_ms_;
+    Clock::time_point link_free_at_{};
+    bool closed_ = false;
+};
+
+void AppendInt32(std::vector<uint8_t>& out, int32_t value) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(value >> (i * 8)));
+}
+
+void AppendString(std::vector<uint8_t>& out, const std::string& value) {
+    AppendInt32(out, static_cast<int32_t>(value.size()));
+    out.insert(out.end(), value.begin(), value.end());
+}
+
+int32_t ReadInt32(const uint8_t* data, size_t& offset) {
+    int32_t value = 0;
+    for (int i = 0; i < 4; ++i) value |= static_cast<int32_t>(data[offset + i]) << (i * 8);
+    offset += 4;
+    return value;
+}
+
+std::string ReadString(const uint8_t* data, size_t& offset) {
+    int32_t length = ReadInt32(data, offset);
+    std::string value(reinterpret_cast<const char*>(data + offset), length);
+    offset += length;
+    return value;
+}
+
+// Same layout as SmartTransferOrchestrator.SerializeFileChunkToBinary
+std::vector<uint8_t> SerializeFileChunk(const std::string& session_id, int chunk_index, int total_chunks,
+                                        int channel_index, const std::string& file_name, const std::string& hash,
+                                        const uint8_t* data, size_t length) {
+    std::vector<uint8_t> out;
+    out.reserve(40 + session_id.size() + file_name.size() + hash.size() + length);
+    out.insert(out.end(), {'F', 'C', 'H', 'K'});
+    AppendString(out, session_id);
+    AppendInt32(out, chunk_index);
+    AppendInt32(out, total_chunks);
+    AppendInt32(out, channel_index);
+    AppendString(out, file_name);
+    AppendString(out, hash);
+    AppendInt32(out, static_cast<int32_t>(length));
+    out.insert(out.end(), data, data + length);
+    return out;
+}
+
+std::string MakeSessionId(Random& rng) {
+    static const char kHex[] = "0123456789abcdef";
+    std::string id = "xxxxxxxx-xxxx-4xxx-yxxx-xxxxxxxxxxxx";
+    for (auto& c : id) {
+        if (c == 'x' || c == 'y') c = kHex[rng.Next() & 0xF];
+    }
+    return id;
+}
+
+std::vector<SyntheticFile> GenerateModSet(Random& rng, uint64_t mtrl, uint64_t mdl, uint64_t small_tex, uint64_t large_tex) {
+    std::vector<SyntheticFile> files;
+    auto add = [&](const char* folder, const char* extension, uint64_t count, uint64_t min_size, uint64_t max_size) {
+        for (uint64_t i = 0; i < count; ++i) {
+            SyntheticFile file;
+            file.game_path = std::string("chara/") + folder + "/c" + std::to_string(rng.Range(101, 1801)) +
+                             "/synthetic_" + std::to_string(files.size()) + extension;
+            file.content.resize(static_cast<size_t>(rng.LogRange(min_size, max_size)));
+            FillSyntheticContent(rng, file.content.data(), file.content.size());
+            file.renderable = file.content.size() < kLargeTextureThreshold;
+            files.push_back(std::move(file));
+        }
+    };
+
+    add("material", ".mtrl", mtrl, 1024, 24 * 1024);
+    add("model", ".mdl", mdl, 40 * 1024, 2 * 1024 * 1024);
+    add("texture", ".tex", small_tex, 64 * 1024, 4 * 1024 * 1024);
+    add("texture", ".tex", large_tex, kLargeTextureThreshold, 100ull * 1024 * 1024);
+    return files;
+}
+
+std::vector<uint8_t> SerializeManifest(const std::vector<ManifestEntry>& manifest) {
+    std::vector<uint8_t> out;
+    AppendInt32(out, static_cast<int32_t>(manifest.size()));
+    for (const auto& entry : manifest) {
+        AppendString(out, entry.game_path);
+        AppendString(out, entry.hash);
+        AppendInt32(out, static_cast<int32_t>(entry.size));
+        out.push_back(entry.renderable ? 1 : 0);
+    }
+    return out;
+}
+
+std::vector<ManifestEntry> DeserializeManifest(const std::vector<uint8_t>& data) {
+    size_t offset = 0;
+    std::vector<ManifestEntry> manifest(ReadInt32(data.data(), offset));
+    for (auto& entry : manifest) {
+        entry.game_path = ReadString(data.data(), offset);
+        entry.hash = ReadString(data.data(), offset);
+        entry.size = static_cast<uint32_t>(ReadInt32(data.data(), offset));
+        entry.renderable = data[offset++] != 0;
+    }
+    return manifest;
+}
+
+struct Timeline {
+    Clock::time_point start;
+    std::atomic<int64_t> first_byte_us{-1};
+    std::atomic<int> renderable_remaining{0};
+    std::atomic<int> files_remaining{0};
+    std::atomic<int64_t> renderable_us{-1};
+    std::atomic<int64_t> complete_us{-1};
+    std::atomic<int> verify_failures{0};
+    std::atomic<uint64_t> bytes_received{0};
+
+    int64_t ElapsedUs() const {
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    }
+};
+
+struct Reassembly {
+    std::vector<uint8_t> data;
+    int received = 0;
+    int total = 0;
+};
+
+void CompleteFile(const ManifestEntry& entry, const std::string& hash, const std::vector<uint8_t>& data,
+                  const fs::path& output_dir, Timeline& timeline) {
+    if (fyteclub::Sha256::HexDigest(data.data(), data.size()) != hash || hash != entry.hash) {
+        timeline.verify_failures++;
+    }
+
+    auto path = output_dir / entry.hash;
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    stream.close();
+
+    auto now_us = timeline.ElapsedUs();
+    if (entry.renderable && --timeline.renderable_remaining == 0) timeline.renderable_us = now_us;
+    if (--timeline.files_remaining == 0) timeline.complete_us = now_us;
+}
+
+void ReceiveChannel(LoopbackChannel& channel, const std::unordered_map<std::string, ManifestEntry>& expected,
+                    const fs::path& output_dir, Timeline& timeline) {
+    std::unordered_map<std::string, Reassembly> sessions;
+    std::vector<uint8_t> message;
+
+    while (channel.Receive(message)) {
+        int64_t expected_first = -1;
+        timeline.first_byte_us.compare_exchange_strong(expected_first, timeline.ElapsedUs());
+        timeline.bytes_received += message.size();
+
+        size_t offset = 4;
+        std::string session_id = ReadString(message.data(), offset);
+        int chunk_index = ReadInt32(message.data(), offset);
+        int total_chunks = ReadInt32(message.data(), offset);
+        ReadInt32(message.data(), offset); // channel index
+        std::string file_name = ReadString(message.data(), offset);
+        std::string hash = ReadString(message.data(), offset);
+        int data_length = ReadInt32(message.data(), offset);
+
+        auto& session = sessions[session_id];
+        if (session.total == 0) {
+            session.total = total_chunks;
+            session.data.resize(expected.at(file_name).size);
+        }
+        memcpy(session.data.data() + static_cast<size_t>(chunk_index) * kChunkSize, message.data() + offset, data_length);
+        if (++session.received < session.total) continue;
+
+        CompleteFile(expected.at(file_name), hash, session.data, output_dir, timeline);
+        sessions.erase(session_id);
+    }
+}
+
+// Compact frames: one OPEN per file, then offset-addressed DATA frames
+void ReceiveCompactChannel(LoopbackChannel& channel, const std::unordered_map<std::string, ManifestEntry>& expected,
+                           const fs::path& output_dir, Timeline& timeline) {
+    fyteclub::ChunkStreamTable streams;
+    std::unordered_map<uint64_t, Reassembly> files;
+    std::vector<uint8_t> message;
+
+    while (channel.Receive(message)) {
+        int64_t expected_first = -1;
+        timeline.first_byte_us.compare_exchange_strong(expected_first, timeline.ElapsedUs());
+        timeline.bytes_received += message.size();
+
+        fyteclub::ParsedChunkFrame frame;
+        if (fyteclub::ParseChunkFrame(message.data(), message.size(), frame) != fyteclub::ChunkFrameStatus::Ok) {
+            timeline.verify_failures++;
+            continue;
+        }
+        if (frame.type == fyteclub::ChunkFrameType::Open) {
+            streams.Register(frame.open);
+            auto& file = files[frame.open.stream_id];
+            file.data.resize(static_cast<size_t>(frame.open.file_size));
+            file.total = static_cast<int>((frame.open.file_size + frame.open.chunk_size - 1) / frame.open.chunk_size);
+            continue;
+        }
+
+        auto stream = streams.Find(frame.data.stream_id);
+        auto& file = files[frame.data.stream_id];
+        if (!stream || frame.data.offset + frame.data.length > file.data.size()) {
+            timeline.verify_failures++;
+            continue;
+        }
+        memcpy(file.data.data() + frame.data.offset, frame.data.payload, frame.data.length);
+        if (++file.received < file.total) continue;
+
+        CompleteFile(expected.at(stream->file_name), stream->file_hash, file.data, output_dir, timeline);
+        files.erase(stream->id);
+        streams.Close(stream->id);
+    }
+}
+
+// Unordered channels: every channel feeds one ChunkAssembler, which writes
+// chunks at their offsets and verifies each file as it completes
+void ReceiveUnorderedChannel(LoopbackChannel& channel, fyteclub::ChunkAssembler& assembler,
+                             const std::unordered_map<std::string, ManifestEntry>& expected, Timeline& timeline) {
+    std::vector<uint8_t> message;
+    while (channel.Receive(message)) {
+        int64_t expected_first = -1;
+        timeline.first_byte_us.compare_exchange_strong(expected_first, timeline.ElapsedUs());
+        timeline.bytes_received += message.size();
+
+        fyteclub::ParsedChunkFrame frame;
+        if (fyteclub::ParseChunkFrame(message.data(), message.size(), frame) != fyteclub::ChunkFrameStatus::Ok ||
+            assembler.OnFrame(frame) == fyteclub::ChunkAssemblyResult::Rejected) {
+            timeline.verify_failures++;
+            continue;
+        }
+
+        fyteclub::CompletedChunkFile completed;
+        while (assembler.PopCompleted(completed)) {
+            const auto& entry = expected.at(completed.file_name);
+            if (!completed.verified || completed.file_hash != entry.hash) timeline.verify_failures++;
+            auto now_us = timeline.ElapsedUs();
+            if (entry.renderable && --timeline.renderable_remaining == 0) timeline.renderable_us = now_us;
+            if (--timeline.files_remaining == 0) timeline.complete_us = now_us;
+        }
+    }
+}
+
+}
+
+int main(int argc, char** argv) {
+    const uint64_t mtrl_count = ArgOr(argc, argv, "--mtrl", 300);
+    const uint64_t mdl_count = ArgOr(argc, argv, "--mdl", 120);
+    const uint64_t small_tex_count = ArgOr(argc, argv, "--small-tex", 40);
+    const uint64_t large_tex_count = ArgOr(argc, argv, "--large-tex", 4);
+    const int channel_count = static_cast<int>(std::max<uint64_t>(1, ArgOr(argc, argv, "--channels", 4)));
+    const uint64_t cached_percent = std::min<uint64_t>(100, ArgOr(argc, argv, "--cached-percent", 0));
+    const double link_mbps = static_cast<double>(ArgOr(argc, argv, "--link-mbps", 0));
+    const size_t buffered_limit = static_cast<size_t>(ArgOr(argc, argv, "--buffered-kb", 16 * 1024)) * 1024;
+    const uint64_t seed = ArgOr(argc, argv, "--seed", 0xFC1B);
+    const bool unordered = HasFlag(argc, argv, "--unordered");
+    const bool compact_frames = unordered || HasFlag(argc, argv, "--compact-frames");
+    const bool game_friendly = HasFlag(argc, argv, "--game-friendly");
+    const bool keep_output = HasFlag(argc, argv, "--keep");
+    const bool json = HasFlag(argc, argv, "--json");
+
+    if (game_friendly) fyteclub::ThreadPolicy::ApplyGameFriendlyPreset();
+
+    Random rng(seed);
+    fprintf(stderr, "Generating synthetic mod set...\n");
+    auto files = GenerateModSet(rng, mtrl_count, mdl_count, small_tex_count, large_tex_count);
+
+    uint64_t total_bytes = 0, renderable_bytes = 0;
+    int renderable_files = 0;
+    for (const auto& file : files) {
+        total_bytes += file.content.size();
+        if (file.renderable) {
+            renderable_bytes += file.content.size();
+            renderable_files++;
+        }
+    }
+
+    // Receiver cache from an earlier encounter, keyed by content hash
+    std::unordered_set<size_t> cached_indexes;
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (rng.Range(1, 100) <= cached_percent) cached_indexes.insert(i);
+    }
+
+    auto output_dir = fs::temp_directory_path() / ("fyteclub_appearance_bench_" + std::to_string(seed));
+    fs::remove_all(output_dir);
+    fs::create_directories(output_dir);
+
+    const double link_bytes_per_ms = link_mbps > 0 ? link_mbps * 1000.0 * 1000.0 / 8.0 / 1000.0 : 0;
+    std::vector<std::unique_ptr<LoopbackChannel>> channels;
+    for (int i = 0; i < channel_count; ++i) {
+        channels.push_back(std::make_unique<LoopbackChannel>(buffered_limit, link_bytes_per_ms / channel_count));
+    }
+    LoopbackChannel control_to_sender(buffered_limit, 0);
+    LoopbackChannel control_to_receiver(buffered_limit, 0);
+
+    Timeline timeline;
+    double manifest_ms = 0, delta_ms = 0;
+    uint64_t requested_bytes = 0;
+    int requested_files = 0;
+
+    // The sender hashes its mod set when it changes, not per request, so the
+    // manifest is built (and reported) on its own, outside the sync timeline
+    auto manifest_start = Clock::now();
+    std::vector<ManifestEntry> sender_manifest;
+    for (auto& file : files) {
+        file.hash = fyteclub::Sha256::HexDigest(file.content.data(), file.content.size());
+        sender_manifest.push_back({file.game_path, file.hash, file.content.size(), file.renderable});
+    }
+    manifest_ms = MillisecondsSince(manifest_start);
+    auto usage_before = QueryProcessUsage();
+
+    // "Player appears": the receiver asks for mod data and the clock starts
+    timeline.start = Clock::now();
+    control_to_sender.Send({'R', 'E', 'Q'});
+
+    std::thread sender([&] {
+        std::vector<uint8_t> message;
+        control_to_sender.Receive(message);
+        control_to_receiver.Send(SerializeManifest(sender_manifest));
+
+        control_to_sender.Receive(message);
+        size_t offset = 0;
+        std::vector<size_t> requested(ReadInt32(message.data(), offset));
+        for (auto& index : requested) index = static_cast<size_t>(ReadInt32(message.data(), offset));
+
+        // Renderable content first, smallest first, so the character can be
+        // redrawn before the large textures finish streaming
+        std::sort(requested.begin(), requested.end(), [&](size_t a, size_t b) {
+            if (files[a].renderable != files[b].renderable) return files[a].renderable;
+            return files[a].content.size() < files[b].content.size();
+        });
+
+        std::atomic<size_t> next{0};
+        fyteclub::ChunkStreamTable streams;
+        std::vector<std::thread> workers;
+        for (int channel_index = 0; channel_index < channel_count; ++channel_index) {
+            workers.emplace_back([&, channel_index] {
+                fyteclub::ThreadPolicy::ApplyToCurrentThread(fyteclub::ThreadPool::Io);
+                Random session_rng(seed ^ (channel_index + 1));
+                for (size_t i = next++; i < requested.size(); i = next++) {
+                    const auto& file = files[requested[i]];
+                    auto session_id = MakeSessionId(session_rng);
+                    int total_chunks = static_cast<int>((file.content.size() + kChunkSize - 1) / kChunkSize);
+                    if (compact_frames) {
+                        auto stream = streams.Open(session_id, file.game_path, file.hash, file.content.size(),
+                                                   static_cast<uint32_t>(kChunkSize));
+                        std::vector<uint8_t> open(fyteclub::ChunkOpenFrameSize(stream->View()));
+                        fyteclub::WriteChunkOpenFrame(stream->View(), open.data(), open.size());
+                        std::deque<std::vector<uint8_t>> reorder;
+                        reorder.push_back(std::move(open));
+                        auto send_one = [&] {
+                            // Unordered delivery: any frame in the window may go next, OPEN included
+                            size_t pick = unordered ? static_cast<size_t>(session_rng.Next() % reorder.size()) : 0;
+                            std::swap(reorder[pick], reorder.front());
+                            channels[channel_index]->Send(std::move(reorder.front()));
+                            reorder.pop_front();
+                        };
+                        for (size_t offset = 0; offset < file.content.size(); offset += kChunkSize) {
+                            size_t length = std::min(kChunkSize, file.content.size() - offset);
+                            std::vector<uint8_t> frame(fyteclub::ChunkDataFrameSize(stream->id, offset, length));
+                            fyteclub::WriteChunkDataFrame({stream->id, offset, file.content.data() + offset, length},
+                                                          frame.data(), frame.size());
+                            reorder.push_back(std::move(frame));
+                            if (reorder.size() >= kReorderWindow) send_one();
+                        }
+                        while (!reorder.empty()) send_one();
+                        streams.Close(stream->id);
+                        continue;
+                    }
+                    for (int chunk = 0; chunk < total_chunks; ++chunk) {
+                        size_t chunk_offset = static_cast<size_t>(chunk) * kChunkSize;
+                        size_t length = std::min(kChunkSize, file.content.size() - chunk_offset);
+                        channels[channel_index]->Send(SerializeFileChunk(session_id, chunk, total_chunks, channel_index,
+                                                                         file.game_path, file.hash,
+                                                                         file.content.data() + chunk_offset, length));
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+    });
+
+    std::vector<uint8_t> manifest_bytes;
+    control_to_receiver.Receive(manifest_bytes);
+
+    auto delta_start = Clock::now();
+    auto manifest = DeserializeManifest(manifest_bytes);
+    std::unordered_set<std::string> cached_hashes;
+    for (size_t index : cached_indexes) {
+        cached_hashes.insert(manifest[index].hash);
+    }
+    std::unordered_map<std::string, ManifestEntry> expected;
+    std::vector<uint8_t> request;
+    std::vector<int32_t> missing;
+    for (size_t i = 0; i < manifest.size(); ++i) {
+        if (cached_hashes.count(manifest[i].hash)) continue;
+        missing.push_back(static_cast<int32_t>(i));
+        expected[manifest[i].game_path] = manifest[i];
+        requested_bytes += manifest[i].size;
+        if (manifest[i].renderable) timeline.renderable_remaining++;
+    }
+    requested_files = static_cast<int>(missing.size());
+    timeline.files_remaining = requested_files;
+    AppendInt32(request, requested_files);
+    for (int32_t index : missing) AppendInt32(request, index);
+    delta_ms = MillisecondsSince(delta_start);
+    control_to_sender.Send(std::move(request));
+
+    fyteclub::ChunkAssembler assembler(output_dir.u8string());
+    std::vector<std::thread> receivers;
+    for (int i = 0; i < channel_count; ++i) {
+        receivers.emplace_back([&, i] {
+            fyteclub::ThreadPolicy::ApplyToCurrentThread(fyteclub::ThreadPool::Disk);
+            if (unordered) {
+                ReceiveUnorderedChannel(*channels[i], assembler, expected, timeline);
+            } else if (compact_frames) {
+                ReceiveCompactChannel(*channels[i], expected, output_dir, timeline);
+            } else {
+                ReceiveChannel(*channels[i], expected, output_dir, timeline);
+            }
+        });
+    }
+
+    sender.join();
+    for (auto& channel : channels) channel->Close();
+    for (auto& receiver : receivers) receiver.join();
+
+    auto wall_ms = MillisecondsSince(timeline.start);
+    auto usage_after = QueryProcessUsage();
+    double cpu_ms = (usage_after.user_ms - usage_before.user_ms) + (usage_after.kernel_ms - usage_before.kernel_ms);
+    auto to_ms = [](int64_t us) { return us < 0 ? -1.0 : us / 1000.0; };
+    double first_byte_ms = to_ms(timeline.first_byte_us);
+    double renderable_ms = timeline.renderable_remaining == 0 && timeline.renderable_us < 0 ? delta_ms : to_ms(timeline.renderable_us);
+    double complete_ms = requested_files == 0 ? delta_ms : to_ms(timeline.complete_us);
+
+    if (!keep_output) fs::remove_all(output_dir);
+
+    if (json) {
+        printf("{\"files\":%zu,\"total_bytes\":%llu,\"requested_files\":%d,\"requested_bytes\":%llu,"
+               "\"channels\":%d,\"manifest_ms\":%.3f,\"delta_ms\":%.3f,\"time_to_first_byte_ms\":%.3f,"
+               "\"time_to_renderable_ms\":%.3f,\"time_to_complete_ms\":%.3f,\"wire_bytes\":%llu,"
+               "\"cpu_user_ms\":%.1f,\"cpu_kernel_ms\":%.1f,\"peak_rss_bytes\":%llu,\"verify_failures\":%d}\n",
+               files.size(), static_cast<unsigned long long>(total_bytes), requested_files,
+               static_cast<unsigned long long>(requested_bytes), channel_count, manifest_ms, delta_ms, first_byte_ms,
+               renderable_ms, complete_ms, static_cast<unsigned long long>(timeline.bytes_received.load()),
+               usage_after.user_ms - usage_before.user_ms, usage_after.kernel_ms - usage_before.kernel_ms,
+               static_cast<unsigned long long>(usage_after.peak_rss_bytes), timeline.verify_failures.load());
+    } else {
+        printf("Mod set        : %zu files, %.1f MB (%d renderable, %.1f MB)\n", files.size(),
+               total_bytes / 1048576.0, renderable_files, renderable_bytes / 1048576.0);
+        printf("Delta          : %d files, %.1f MB requested (%llu%% cached), %d channels\n", requested_files,
+               requested_bytes / 1048576.0, static_cast<unsigned long long>(cached_percent), channel_count);
+        printf("Manifest       : %10.2f ms (hashing, not part of the timings below)\n", manifest_ms);
+        printf("Delta compute  : %10.2f ms\n", delta_ms);
+        printf("First byte     : %10.2f ms\n", first_byte_ms);
+        printf("Renderable     : %10.2f ms\n", renderable_ms);
+        printf("Complete       : %10.2f ms (%.1f MB/s)\n", complete_ms, MegabytesPerSecond(requested_bytes, complete_ms));
+        printf("Wire overhead  : %10.2f %%\n",
+               requested_bytes ? (timeline.bytes_received.load() - requested_bytes) * 100.0 / requested_bytes : 0.0);
+        printf("CPU            : %10.1f ms (%.2f cores avg)\n", cpu_ms, wall_ms > 0 ? cpu_ms / wall_ms : 0.0);
+        printf("Peak RSS       : %10.1f MB\n", usage_after.peak_rss_bytes / 1048576.0);
+        if (timeline.verify_failures > 0) printf("VERIFY FAILURES: %d\n", timeline.verify_failures.load());
+    }
+
+    return timeline.verify_failures > 0 ? 1 : 0;
+}
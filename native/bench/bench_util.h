@@ -0,0 +1,139 @@
+#pragma once
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// Shared helpers for the native benchmark targets (timing, process CPU and
+// peak RSS, deterministic synthetic data, argument parsing).
+
+namespace fyteclub::bench {
+
+using Clock = std::chrono::steady_clock;
+
+inline double MillisecondsSince(Clock::time_point start, Clock::time_point end = Clock::now()) {
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+struct ProcessUsage {
+    double user_ms = 0;
+    double kernel_ms = 0;
+    uint64_t peak_rss_bytes = 0;
+};
+
+inline ProcessUsage QueryProcessUsage() {
+    ProcessUsage usage;
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    if (GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+        auto to_ms = [](const FILETIME& ft) {
+            ULARGE_INTEGER value;
+            value.LowPart = ft.dwLowDateTime;
+            value.HighPart = ft.dwHighDateTime;
+            return value.QuadPart / 10000.0;
+        };
+        usage.user_ms = to_ms(user);
+        usage.kernel_ms = to_ms(kernel);
+    }
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        usage.peak_rss_bytes = counters.PeakWorkingSetSize;
+    }
+#else
+    rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) == 0) {
+        usage.user_ms = ru.ru_utime.tv_sec * 1000.0 + ru.ru_utime.tv_usec / 1000.0;
+        usage.kernel_ms = ru.ru_stime.tv_sec * 1000.0 + ru.ru_stime.tv_usec / 1000.0;
+#ifdef __APPLE__
+        usage.peak_rss_bytes = static_cast<uint64_t>(ru.ru_maxrss);
+#else
+        usage.peak_rss_bytes = static_cast<uint64_t>(ru.ru_maxrss) * 1024;
+#endif
+    }
+#endif
+    return usage;
+}
+
+// SplitMix64 - deterministic so runs with the same seed are comparable
+class Random {
+public:
+    explicit Random(uint64_t seed) : state_(seed) {}
+
+    uint64_t Next() {
+        uint64_t z = (state_ += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t Range(uint64_t min, uint64_t max) {
+        return min + Next() % (max - min + 1);
+    }
+
+    // Log-uniform sizes give the long tail real mod files have
+    uint64_t LogRange(uint64_t min, uint64_t max) {
+        double t = (Next() >> 11) * (1.0 / 9007199254740992.0);
+        double value = static_cast<double>(min) * std::pow(static_cast<double>(max) / min, t);
+        return static_cast<uint64_t>(value);
+    }
+
+private:
+    uint64_t state_;
+};
+
+// Game assets are partly compressible: headers and padding repeat, texel data
+// mostly doesn't. Fill roughly a quarter with runs so codecs see realistic input.
+inline void FillSyntheticContent(Random& rng, uint8_t* data, size_t length) {
+    size_t offset = 0;
+    while (offset < length) {
+        size_t run = static_cast<size_t>(rng.Range(64, 4096));
+        if (run > length - offset) run = length - offset;
+        if ((rng.Next() & 3) == 0) {
+            memset(data + offset, static_cast<int>(rng.Next() & 0xFF), run);
+        } else {
+            size_t i = 0;
+            for (; i + 8 <= run; i += 8) {
+                uint64_t value = rng.Next();
+                memcpy(data + offset + i, &value, 8);
+            }
+            for (; i < run; ++i) data[offset + i] = static_cast<uint8_t>(rng.Next());
+        }
+        offset += run;
+    }
+}
+
+inline const char* FindArg(int argc, char** argv, const char* name) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (strcmp(argv[i], name) == 0) return argv[i + 1];
+    }
+    return nullptr;
+}
+
+inline bool HasFlag(int argc, char** argv, const char* name) {
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], name) == 0) return true;
+    }
+    return false;
+}
+
+inline uint64_t ArgOr(int argc, char** argv, const char* name, uint64_t fallback) {
+    const char* value = FindArg(argc, argv, name);
+    return value ? std::strtoull(value, nullptr, 10) : fallback;
+}
+
+inline double MegabytesPerSecond(uint64_t bytes, double ms) {
+    return ms > 0 ? (bytes / (1024.0 * 1024.0)) / (ms / 1000.0) : 0.0;
+}
+
+}
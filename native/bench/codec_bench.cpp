@@ -0,0 +1,1239 @@
+// Serialization and compression codec comparison.
+//
+// Runs a corpus shaped like the real P2P messages (ModDataResponse with large
+// FileReplacements, metadata-only ModDataResponse, ComponentResponse, the 1KB
+// ChunkedMessage, ModManifest and a small ModDataRequest) through:
+//   json+gzip  - what P2PModProtocol.SerializeMessage does today (camelCase JSON,
+//                byte[] as base64, gzip Optimal above 1KB)
+//   json+zstd  - same JSON, zstd at several levels
+//   binary     - length-prefixed binary encoding of the same fields
+//   binary+zstd
+//   schema     - the generated tag/varint codec (generated/p2p_messages.h),
+//                decoded as zero-copy views; ModManifest has no schema row
+//   schema+zstd
+// and reports encode/decode throughput, compression ratio and heap
+// allocations per message. All codecs use the SerializeMessage framing
+// (1 byte flag + 4 byte original size) and the same 1KB compression threshold.
+//
+// Usage: codec_bench [--min-ms N] [--seed S] [--csv]
+
+#include "bench_util.h"
+#include "../generated/p2p_messages.h"
+
+#include <atomic>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef FYTECLUB_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef FYTECLUB_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace fyteclub::bench;
+
+// Every heap allocation in the process goes through here so codecs can be
+// compared on allocation count, not just speed. The whole new/delete family is
+// replaced, sized and aligned forms included, so nothing frees with our free()
+// what the library's operator new allocated
+static std::atomic<uint64_t> g_allocations{0};
+static std::atomic<uint64_t> g_allocated_bytes{0};
+
+static void* CountedAlloc(size_t size, size_t alignment) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (size == 0) size = 1;
+    void* p;
+    if (alignment <= alignof(std::max_align_t)) {
+        p = std::malloc(size);
+    } else {
+#if defined(_MSC_VER)
+        p = _aligned_malloc(size, alignment);
+#else
+        p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+    }
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+static void CountedFree(void* p, size_t alignment) noexcept {
+#if defined(_MSC_VER)
+    if (alignment > alignof(std::max_align_t)) {
+        _aligned_free(p);
+        return;
+    }
+#else
+    (void)alignment;
+#endif
+    std::free(p);
+}
+
+void* operator new(size_t size) { return CountedAlloc(size, 0); }
+void* operator new[](size_t size) { return CountedAlloc(size, 0); }
+void* operator new(size_t size, std::align_val_t al) { return CountedAlloc(size, static_cast<size_t>(al)); }
+void* operator new[](size_t size, std::align_val_t al) { return CountedAlloc(size, static_cast<size_t>(al)); }
+
+void operator delete(void* p) noexcept { CountedFree(p, 0); }
+void operator delete[](void* p) noexcept { CountedFree(p, 0); }
+void operator delete(void* p, size_t) noexcept { CountedFree(p, 0); }
+void operator delete[](void* p, size_t) noexcept { CountedFree(p, 0); }
+void operator delete(void* p, std::align_val_t al) noexcept { CountedFree(p, static_cast<size_t>(al)); }
+void operator delete[](void* p, std::align_val_t al) noexcept { CountedFree(p, static_cast<size_t>(al)); }
+void operator delete(void* p, size_t, std::align_val_t al) noexcept { CountedFree(p, static_cast<size_t>(al)); }
+void operator delete[](void* p, size_t, std::align_val_t al) noexcept { CountedFree(p, static_cast<size_t>(al)); }
+
+namespace {
+
+constexpr size_t kCompressionThreshold = 1024;
+
+// ---------------------------------------------------------------------------
+// Message model (mirrors the C# classes field for field)
+// ---------------------------------------------------------------------------
+
+struct TransferableFile {
+    std::string game_path;
+    std::string hash;
+    std::vector<uint8_t> content;
+    int64_t size = 0;
+};
+
+struct PlayerInfo {
+    std::string player_id;
+    std::string player_name;
+    int64_t state = 0;
+    std::vector<std::string> mods;
+    std::string manipulation_data;
+    std::string glamourer_data;
+    std::string customize_plus_data;
+    float simple_heels_offset = 0;
+    std::string honorific_title;
+    int64_t world_id = 0;
+};
+
+struct MessageHeader {
+    int64_t type = 0;
+    std::string message_id;
+    int64_t timestamp = 0;
+    std::string response_to;
+};
+
+struct ModDataRequest {
+    MessageHeader header;
+    std::string player_name;
+    std::string last_known_hash;
+};
+
+struct ModDataResponse {
+    MessageHeader header;
+    std::string player_name;
+    std::string data_hash;
+    PlayerInfo player_info;
+    std::map<std::string, TransferableFile> file_replacements;
+    bool is_compressed = false;
+};
+
+struct ComponentResponse {
+    MessageHeader header;
+    std::map<std::string, TransferableFile> components;
+    std::vector<std::string> missing_hashes;
+};
+
+struct ChunkedMessage {
+    MessageHeader header;
+    std::string chunk_id;
+    int64_t chunk_index = 0;
+    int64_t total_chunks = 0;
+    std::vector<uint8_t> chunk_data;
+    int64_t original_message_type = 0;
+    std::string original_message_type_name;
+    std::map<std::string, std::string> message_metadata;
+};
+
+struct ModManifest {
+    std::string player_name;
+    std::map<std::string, std::string> file_hashes;
+    std::string glamourer_data;
+    std::string customize_plus_data;
+    std::string manipulation_data;
+    std::string honorific_title;
+    float simple_heels_offset = 0;
+};
+
+template <typename V> void Visit(V& v, MessageHeader& m) {
+    v("type", m.type);
+    v("messageId", m.message_id);
+    v("timestamp", m.timestamp);
+    v("responseTo", m.response_to);
+}
+
+template <typename V> void Visit(V& v, TransferableFile& m) {
+    v("gamePath", m.game_path);
+    v("hash", m.hash);
+    v("content", m.content);
+    v("size", m.size);
+}
+
+template <typename V> void Visit(V& v, PlayerInfo& m) {
+    v("playerId", m.player_id);
+    v("playerName", m.player_name);
+    v("state", m.state);
+    v("mods", m.mods);
+    v("manipulationData", m.manipulation_data);
+    v("glamourerData", m.glamourer_data);
+    v("customizePlusData", m.customize_plus_data);
+    v("simpleHeelsOffset", m.simple_heels_offset);
+    v("honorificTitle", m.honorific_title);
+    v("worldId", m.world_id);
+}
+
+template <typename V> void Visit(V& v, ModDataRequest& m) {
+    v("playerName", m.player_name);
+    v("lastKnownHash", m.last_known_hash);
+    Visit(v, m.header);
+}
+
+template <typename V> void Visit(V& v, ModDataResponse& m) {
+    v("playerName", m.player_name);
+    v("dataHash", m.data_hash);
+    v("playerInfo", m.player_info);
+    v("fileReplacements", m.file_replacements);
+    v("isCompressed", m.is_compressed);
+    Visit(v, m.header);
+}
+
+template <typename V> void Visit(V& v, ComponentResponse& m) {
+    v("components", m.components);
+    v("missingHashes", m.missing_hashes);
+    Visit(v, m.header);
+}
+
+template <typename V> void Visit(V& v, ChunkedMessage& m) {
+    v("chunkId", m.chunk_id);
+    v("chunkIndex", m.chunk_index);
+    v("totalChunks", m.total_chunks);
+    v("chunkData", m.chunk_data);
+    v("originalMessageType", m.original_message_type);
+    v("originalMessageTypeName", m.original_message_type_name);
+    v("messageMetadata", m.message_metadata);
+    Visit(v, m.header);
+}
+
+template <typename V> void Visit(V& v, ModManifest& m) {
+    v("playerName", m.player_name);
+    v("fileHashes", m.file_hashes);
+    v("glamourerData", m.glamourer_data);
+    v("customizePlusData", m.customize_plus_data);
+    v("manipulationData", m.manipulation_data);
+    v("honorificTitle", m.honorific_title);
+    v("simpleHeelsOffset", m.simple_heels_offset);
+}
+
+struct ProbeVisitor {
+    template <typename X> void operator()(const char*, X&) {}
+};
+
+template <typename T, typename = void> struct IsMessage : std::false_type {};
+template <typename T>
+struct IsMessage<T, decltype(Visit(std::declval<ProbeVisitor&>(), std::declval<T&>()))> : std::true_type {};
+
+// ---------------------------------------------------------------------------
+// Base64 (System.Text.Json writes byte[] as standard padded base64)
+// ---------------------------------------------------------------------------
+
+const char kBase64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+void AppendBase64(std::string& out, const std::vector<uint8_t>& data) {
+    size_t i = 0;
+    out.reserve(out.size() + (data.size() + 2) / 3 * 4);
+    for (; i + 3 <= data.size(); i += 3) {
+        uint32_t n = (data[i] << 16) | (data[i + 1] << 8) | data[i + 2];
+        out += kBase64[n >> 18];
+        out += kBase64[(n >> 12) & 63];
+        out += kBase64[(n >> 6) & 63];
+        out += kBase64[n & 63];
+    }
+    if (i < data.size()) {
+        uint32_t n = data[i] << 16;
+        if (i + 1 < data.size()) n |= data[i + 1] << 8;
+        out += kBase64[n >> 18];
+        out += kBase64[(n >> 12) & 63];
+        out += (i + 1 < data.size()) ? kBase64[(n >> 6) & 63] : '=';
+        out += '=';
+    }
+}
+
+bool DecodeBase64(const std::string& text, std::vector<uint8_t>& out) {
+    static int8_t table[256];
+    static bool initialized = [] {
+        for (auto& entry : table) entry = -1;
+        for (int i = 0; i < 64; ++i) table[static_cast<uint8_t>(kBase64[i])] = static_cast<int8_t>(i);
+        return true;
+    }();
+    (void)initialized;
+
+    out.clear();
+    out.reserve(text.size() / 4 * 3);
+    uint32_t accumulator = 0;
+    int bits = 0;
+    for (char c : text) {
+        if (c == '=') break;
+        int8_t value = table[static_cast<uint8_t>(c)];
+        if (value < 0) return false;
+        accumulator = (accumulator << 6) | static_cast<uint32_t>(value);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out.push_back(static_cast<uint8_t>(accumulator >> bits));
+        }
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// JSON encode (camelCase, compact - JsonSerializerOptions in SerializeMessage)
+// ---------------------------------------------------------------------------
+
+void AppendJsonString(std::string& out, const std::string& value) {
+    static const char kHex[] = "0123456789abcdef";
+    out += '"';
+    for (char c : value) {
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<uint8_t>(c) < 0x20) {
+                out += "\\u00";
+                out += kHex[(c >> 4) & 0xF];
+                out += kHex[c & 0xF];
+            } else {
+                out += c;
+            }
+        }
+    }
+    out += '"';
+}
+
+struct JsonWriter {
+    std::string& out;
+    bool first = true;
+
+    void Key(const char* name) {
+        if (!first) out += ',';
+        first = false;
+        out += '"';
+        out += name;
+        out += "\":";
+    }
+
+    void Write(std::string& value) { AppendJsonString(out, value); }
+    void Write(std::vector<uint8_t>& value) {
+        out += '"';
+        AppendBase64(out, value);
+        out += '"';
+    }
+    void Write(int64_t& value) { out += std::to_string(value); }
+    void Write(bool& value) { out += value ? "true" : "false"; }
+    void Write(float& value) {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%.9g", value);
+        out += buffer;
+    }
+    template <typename T> void Write(std::vector<T>& values) {
+        out += '[';
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (i) out += ',';
+            Write(values[i]);
+        }
+        out += ']';
+    }
+    template <typename T> void Write(std::map<std::string, T>& values) {
+        out += '{';
+        bool first_entry = true;
+        for (auto& [key, value] : values) {
+            if (!first_entry) out += ',';
+            first_entry = false;
+            AppendJsonString(out, key);
+            out += ':';
+            Write(value);
+        }
+        out += '}';
+    }
+    template <typename T> std::enable_if_t<IsMessage<T>::value> Write(T& value) {
+        out += '{';
+        JsonWriter nested{out};
+        Visit(nested, value);
+        out += '}';
+    }
+
+    template <typename T> void operator()(const char* name, T& value) {
+        Key(name);
+        Write(value);
+    }
+};
+
+// ---------------------------------------------------------------------------
+// JSON decode - parse to a document first, as DeserializeMessage does with
+// JsonDocument.Parse, then bind fields (base64 decode included)
+// ---------------------------------------------------------------------------
+
+struct JsonValue {
+    enum class Kind { Null, Bool, Number, String, Array, Object } kind = Kind::Null;
+    bool boolean = false;
+    double number = 0;
+    std::string text;
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string, JsonValue>> members;
+
+    const JsonValue* Find(const char* name) const {
+        for (const auto& [key, value] : members) {
+            if (key == name) return &value;
+        }
+        return nullptr;
+    }
+};
+
+class JsonParser {
+public:
+    JsonParser(const char* data, size_t length) : p_(data), end_(data + length) {}
+
+    bool Parse(JsonValue& value) {
+        SkipWhitespace();
+        return ParseValue(value);
+    }
+
+private:
+    void SkipWhitespace() {
+        while (p_ < end_ && (*p_ == ' ' || *p_ == '\n' || *p_ == '\r' || *p_ == '\t')) ++p_;
+    }
+
+    static void AppendUtf8(std::string& out, uint32_t cp) {
+        if (cp < 0x80) {
+            out += static_cast<char>(cp);
+        } else if (cp < 0x800) {
+            out += static_cast<char>(0xC0 | (cp >> 6));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            out += static_cast<char>(0xE0 | (cp >> 12));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (cp >> 18));
+            out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+
+    bool ParseHex4(uint32_t& value) {
+        if (end_ - p_ < 4) return false;
+        value = 0;
+        for (int i = 0; i < 4; ++i) {
+            char c = *p_++;
+            value <<= 4;
+            if (c >= '0' && c <= '9') value |= c - '0';
+            else if (c >= 'a' && c <= 'f') value |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') value |= c - 'A' + 10;
+            else return false;
+        }
+        return true;
+    }
+
+    bool ParseString(std::string& out) {
+        ++p_; // opening quote
+        const char* run = p_;
+        while (p_ < end_) {
+            char c = *p_;
+            if (c == '"') {
+                out.append(run, p_);
+                ++p_;
+                return true;
+            }
+            if (c != '\\') {
+                ++p_;
+                continue;
+            }
+            out.append(run, p_);
+            if (++p_ >= end_) return false;
+            char escape = *p_++;
+            switch (escape) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                uint32_t cp;
+                if (!ParseHex4(cp)) return false;
+                if (cp >= 0xD800 && cp <= 0xDBFF && end_ - p_ >= 6 && p_[0] == '\\' && p_[1] == 'u') {
+                    p_ += 2;
+                    uint32_t low;
+                    if (!ParseHex4(low)) return false;
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                }
+                AppendUtf8(out, cp);
+                break;
+            }
+            default: return false;
+            }
+            run = p_;
+        }
+        return false;
+    }
+
+    bool ParseValue(JsonValue& value) {
+        if (p_ >= end_) return false;
+        switch (*p_) {
+        case '{': {
+            value.kind = JsonValue::Kind::Object;
+            ++p_;
+            SkipWhitespace();
+            if (p_ < end_ && *p_ == '}') { ++p_; return true; }
+            while (p_ < end_) {
+                SkipWhitespace();
+                if (p_ >= end_ || *p_ != '"') return false;
+                value.members.emplace_back();
+                auto& member = value.members.back();
+                if (!ParseString(member.first)) return false;
+                SkipWhitespace();
+                if (p_ >= end_ || *p_++ != ':') return false;
+                SkipWhitespace();
+                if (!ParseValue(member.second)) return false;
+                SkipWhitespace();
+                if (p_ < end_ && *p_ == ',') { ++p_; continue; }
+                if (p_ < end_ && *p_ == '}') { ++p_; return true; }
+                return false;
+            }
+            return false;
+        }
+        case '[': {
+            value.kind = JsonValue::Kind::Array;
+            ++p_;
+            SkipWhitespace();
+            if (p_ < end_ && *p_ == ']') { ++p_; return true; }
+            while (p_ < end_) {
+                SkipWhitespace();
+                value.items.emplace_back();
+                if (!ParseValue(value.items.back())) return false;
+                SkipWhitespace();
+                if (p_ < end_ && *p_ == ',') { ++p_; continue; }
+                if (p_ < end_ && *p_ == ']') { ++p_; return true; }
+                return false;
+            }
+            return false;
+        }
+        case '"':
+            value.kind = JsonValue::Kind::String;
+            return ParseString(value.text);
+        case 't':
+        case 'f':
+            value.kind = JsonValue::Kind::Bool;
+            value.boolean = *p_ == 't';
+            p_ += value.boolean ? 4 : 5;
+            return p_ <= end_;
+        case 'n':
+            value.kind = JsonValue::Kind::Null;
+            p_ += 4;
+            return p_ <= end_;
+        default: {
+            value.kind = JsonValue::Kind::Number;
+            char* number_end = nullptr;
+            value.number = std::strtod(p_, &number_end);
+            if (number_end == p_) return false;
+            p_ = number_end;
+            return true;
+        }
+        }
+    }
+
+    const char* p_;
+    const char* end_;
+};
+
+struct JsonBinder {
+    const JsonValue& object;
+    bool ok = true;
+
+    void Read(const JsonValue& v, std::string& value) { value = v.text; }
+    void Read(const JsonValue& v, std::vector<uint8_t>& value) { ok &= DecodeBase64(v.text, value); }
+    void Read(const JsonValue& v, int64_t& value) { value = static_cast<int64_t>(v.number); }
+    void Read(const JsonValue& v, bool& value) { value = v.boolean; }
+    void Read(const JsonValue& v, float& value) { value = static_cast<float>(v.number); }
+    template <typename T> void Read(const JsonValue& v, std::vector<T>& values) {
+        values.resize(v.items.size());
+        for (size_t i = 0; i < values.size(); ++i) Read(v.items[i], values[i]);
+    }
+    template <typename T> void Read(const JsonValue& v, std::map<std::string, T>& values) {
+        for (const auto& [key, item] : v.members) Read(item, values[key]);
+    }
+    template <typename T> std::enable_if_t<IsMessage<T>::value> Read(const JsonValue& v, T& value) {
+        JsonBinder nested{v};
+        Visit(nested, value);
+        ok &= nested.ok;
+    }
+
+    template <typename T> void operator()(const char* name, T& value) {
+        if (const JsonValue* member = object.Find(name)) Read(*member, value);
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Binary encode: varint lengths, zigzag varint integers, raw bytes
+// ---------------------------------------------------------------------------
+
+void AppendVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+struct BinaryWriter {
+    std::string& out;
+
+    void Write(std::string& value) {
+        AppendVarint(out, value.size());
+        out.append(value);
+    }
+    void Write(std::vector<uint8_t>& value) {
+        AppendVarint(out, value.size());
+        out.append(reinterpret_cast<const char*>(value.data()), value.size());
+    }
+    void Write(int64_t& value) { AppendVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63)); }
+    void Write(bool& value) { out += static_cast<char>(value ? 1 : 0); }
+    void Write(float& value) { out.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+    template <typename T> void Write(std::vector<T>& values) {
+        AppendVarint(out, values.size());
+        for (auto& value : values) Write(value);
+    }
+    template <typename T> void Write(std::map<std::string, T>& values) {
+        AppendVarint(out, values.size());
+        for (auto& [key, value] : values) {
+            AppendVarint(out, key.size());
+            out.append(key);
+            Write(value);
+        }
+    }
+    template <typename T> std::enable_if_t<IsMessage<T>::value> Write(T& value) { Visit(*this, value); }
+
+    template <typename T> void operator()(const char*, T& value) { Write(value); }
+};
+
+struct BinaryReader {
+    const uint8_t* p;
+    const uint8_t* end;
+    bool ok = true;
+
+    uint64_t Varint() {
+        uint64_t value = 0;
+        for (int shift = 0; p < end && shift < 64; shift += 7) {
+            uint8_t byte = *p++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+        ok = false;
+        return 0;
+    }
+
+    const uint8_t* Take(size_t length) {
+        if (static_cast<size_t>(end - p) < length) {
+            ok = false;
+            p = end;
+            return nullptr;
+        }
+        const uint8_t* start = p;
+        p += length;
+        return start;
+    }
+
+    void Read(std::string& value) {
+        size_t length = static_cast<size_t>(Varint());
+        if (auto* data = Take(length)) value.assign(reinterpret_cast<const char*>(data), length);
+    }
+    void Read(std::vector<uint8_t>& value) {
+        size_t length = static_cast<size_t>(Varint());
+        if (auto* data = Take(length)) value.assign(data, data + length);
+    }
+    void Read(int64_t& value) {
+        uint64_t raw = Varint();
+        value = static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1);
+    }
+    void Read(bool& value) {
+        if (auto* data = Take(1)) value = *data != 0;
+    }
+    void Read(float& value) {
+        if (auto* data = Take(sizeof(value))) memcpy(&value, data, sizeof(value));
+    }
+    template <typename T> void Read(std::vector<T>& values) {
+        size_t count = static_cast<size_t>(Varint());
+        if (count > static_cast<size_t>(end - p)) { ok = false; return; }
+        values.resize(count);
+        for (auto& value : values) Read(value);
+    }
+    template <typename T> void Read(std::map<std::string, T>& values) {
+        size_t count = static_cast<size_t>(Varint());
+        for (size_t i = 0; i < count && ok; ++i) {
+            std::string key;
+            Read(key);
+            Read(values[key]);
+        }
+    }
+    template <typename T> std::enable_if_t<IsMessage<T>::value> Read(T& value) { Visit(*this, value); }
+
+    template <typename T> void operator()(const char*, T& value) { Read(value); }
+};
+
+// ---------------------------------------------------------------------------
+// Schema codec: wire views over the source message, built once per entry
+// ---------------------------------------------------------------------------
+
+namespace wire = fyteclub::wire;
+
+wire::Bytes View(const std::vector<uint8_t>& bytes) { return {bytes.data(), bytes.size()}; }
+
+std::optional<std::string_view> Optional(const std::string& value) {
+    return value.empty() ? std::nullopt : std::optional<std::string_view>(value);
+}
+
+template <typename W> void SetHeader(W& message, const MessageHeader& header) {
+    message.message_id = header.message_id;
+    message.timestamp = header.timestamp;
+    message.response_to = Optional(header.response_to);
+}
+
+struct WireFiles {
+    std::vector<wire::MapEntry<wire::TransferableFile>> entries;
+
+    explicit WireFiles(const std::map<std::string, TransferableFile>& files) {
+        for (const auto& [path, file] : files) {
+            entries.push_back({path, wire::TransferableFile{file.game_path, file.hash, View(file.content), file.size}});
+        }
+    }
+    wire::List<wire::MapEntry<wire::TransferableFile>> List() const { return {entries.data(), entries.size()}; }
+};
+
+struct WireStrings {
+    std::vector<std::string_view> items;
+
+    explicit WireStrings(const std::vector<std::string>& values) : items(values.begin(), values.end()) {}
+    wire::List<std::string_view> List() const { return {items.data(), items.size()}; }
+};
+
+template <typename T> struct SchemaView {
+    static constexpr bool kSupported = false;
+    explicit SchemaView(const T&) {}
+};
+
+template <> struct SchemaView<ModDataRequest> {
+    static constexpr bool kSupported = true;
+    wire::ModDataRequest message;
+
+    explicit SchemaView(const ModDataRequest& m) {
+        SetHeader(message, m.header);
+        message.player_name = m.player_name;
+        message.last_known_hash = Optional(m.last_known_hash);
+    }
+};
+
+template <> struct SchemaView<ModDataResponse> {
+    static constexpr bool kSupported = true;
+    WireStrings mods;
+    WireFiles files;
+    wire::ModDataResponse message;
+
+    explicit SchemaView(const ModDataResponse& m) : mods(m.player_info.mods), files(m.file_replacements) {
+        SetHeader(message, m.header);
+        message.player_name = m.player_name;
+        message.data_hash = m.data_hash;
+        message.file_replacements = files.List();
+        message.is_compressed = m.is_compressed;
+
+        const PlayerInfo& info = m.player_info;
+        auto& out = message.player_info;
+        out.player_id = info.player_id;
+        out.player_name = info.player_name;
+        out.state = static_cast<wire::PlayerState>(info.state);
+        out.mods = mods.List();
+        out.manipulation_data = Optional(info.manipulation_data);
+        out.glamourer_data = Optional(info.glamourer_data);
+        out.customize_plus_data = Optional(info.customize_plus_data);
+        out.simple_heels_offset = info.simple_heels_offset;
+        out.honorific_title = Optional(info.honorific_title);
+        out.world_id = static_cast<uint32_t>(info.world_id);
+    }
+};
+
+template <> struct SchemaView<ComponentResponse> {
+    static constexpr bool kSupported = true;
+    WireFiles files;
+    WireStrings missing;
+    wire::ComponentResponse message;
+
+    explicit SchemaView(const ComponentResponse& m) : files(m.components), missing(m.missing_hashes) {
+        SetHeader(message, m.header);
+        message.components = files.List();
+        message.missing_hashes = missing.List();
+    }
+};
+
+// The schema carries the original type as the enum only, without the type name
+// string and metadata dictionary
+template <> struct SchemaView<ChunkedMessage> {
+    static constexpr bool kSupported = true;
+    wire::ChunkedMessage message;
+
+    explicit SchemaView(const ChunkedMessage& m) {
+        SetHeader(message, m.header);
+        message.chunk_id = m.chunk_id;
+        message.chunk_index = static_cast<int32_t>(m.chunk_index);
+        message.total_chunks = static_cast<int32_t>(m.total_chunks);
+        message.chunk_data = View(m.chunk_data);
+        message.original_message_type = static_cast<wire::P2PModMessageType>(m.original_message_type);
+    }
+};
+
+// Decoded lists are lazy, so walk them to validate the whole message
+template <typename T> bool WalkLists(const T&) { return true; }
+
+bool WalkLists(const wire::ModDataResponse& m) {
+    return m.file_replacements.ForEach([](const auto&) {}) && m.player_info.mods.ForEach([](const auto&) {});
+}
+
+bool WalkLists(const wire::ComponentResponse& m) {
+    return m.components.ForEach([](const auto&) {}) && m.missing_hashes.ForEach([](const auto&) {});
+}
+
+// ---------------------------------------------------------------------------
+// Compression backends
+// ---------------------------------------------------------------------------
+
+struct Compressor {
+    std::string name;
+    std::function<bool(const std::string& in, std::string& out)> compress;
+    std::function<bool(const uint8_t* in, size_t length, size_t original, std::string& out)> decompress;
+};
+
+#ifdef FYTECLUB_HAVE_ZLIB
+voidpf CountingZalloc(voidpf, uInt items, uInt size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_allocated_bytes.fetch_add(static_cast<uint64_t>(items) * size, std::memory_order_relaxed);
+    return std::calloc(items, size);
+}
+
+void CountingZfree(voidpf, voidpf address) { std::free(address); }
+
+Compressor MakeGzip(int level, const char* name) {
+    Compressor c;
+    c.name = name;
+    c.compress = [level](const std::string& in, std::string& out) {
+        z_stream stream{};
+        stream.zalloc = CountingZalloc;
+        stream.zfree = CountingZfree;
+        if (deflateInit2(&stream, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) return false;
+        out.resize(deflateBound(&stream, static_cast<uLong>(in.size())));
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+        stream.avail_in = static_cast<uInt>(in.size());
+        stream.next_out = reinterpret_cast<Bytef*>(&out[0]);
+        stream.avail_out = static_cast<uInt>(out.size());
+        int result = deflate(&stream, Z_FINISH);
+        out.resize(stream.total_out);
+        deflateEnd(&stream);
+        return result == Z_STREAM_END;
+    };
+    c.decompress = [](const uint8_t* in, size_t length, size_t original, std::string& out) {
+        z_stream stream{};
+        stream.zalloc = CountingZalloc;
+        stream.zfree = CountingZfree;
+        if (inflateInit2(&stream, 15 + 16) != Z_OK) return false;
+        out.resize(original);
+        stream.next_in = const_cast<Bytef*>(in);
+        stream.avail_in = static_cast<uInt>(length);
+        stream.next_out = reinterpret_cast<Bytef*>(&out[0]);
+        stream.avail_out = static_cast<uInt>(out.size());
+        int result = inflate(&stream, Z_FINISH);
+        inflateEnd(&stream);
+        return result == Z_STREAM_END;
+    };
+    return c;
+}
+#endif
+
+#ifdef FYTECLUB_HAVE_ZSTD
+// Contexts are created once and reused, which is how a native codec would
+// hold them; steady-state zstd calls then do not allocate
+Compressor MakeZstd(int level) {
+    auto cctx = std::shared_ptr<ZSTD_CCtx>(ZSTD_createCCtx(), ZSTD_freeCCtx);
+    auto dctx = std::shared_ptr<ZSTD_DCtx>(ZSTD_createDCtx(), ZSTD_freeDCtx);
+    Compressor c;
+    c.name = "zstd-" + std::to_string(level);
+    c.compress = [cctx, level](const std::string& in, std::string& out) {
+        out.resize(ZSTD_compressBound(in.size()));
+        size_t written = ZSTD_compressCCtx(cctx.get(), &out[0], out.size(), in.data(), in.size(), level);
+        if (ZSTD_isError(written)) return false;
+        out.resize(written);
+        return true;
+    };
+    c.decompress = [dctx](const uint8_t* in, size_t length, size_t original, std::string& out) {
+        out.resize(original);
+        size_t written = ZSTD_decompressDCtx(dctx.get(), &out[0], out.size(), in, length);
+        return !ZSTD_isError(written) && written == original;
+    };
+    return c;
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// Codec = serializer + optional compressor, framed like SerializeMessage
+// ---------------------------------------------------------------------------
+
+enum class Format { Json, Binary, Schema };
+
+struct CorpusEntry {
+    std::string name;
+    bool has_schema = false;
+    std::function<void(Format, std::string&)> encode;
+    std::function<bool(Format, const uint8_t*, size_t)> decode;
+};
+
+template <typename T> CorpusEntry MakeEntry(std::string name, T message) {
+    auto shared = std::make_shared<T>(std::move(message));
+    auto view = std::make_shared<SchemaView<T>>(*shared);
+    CorpusEntry entry;
+    entry.name = std::move(name);
+    entry.has_schema = SchemaView<T>::kSupported;
+    entry.encode = [shared, view](Format format, std::string& out) {
+        if (format == Format::Json) {
+            JsonWriter writer{out};
+            writer.Write(*shared);
+        } else if (format == Format::Binary) {
+            BinaryWriter writer{out};
+            writer.Write(*shared);
+        } else if constexpr (SchemaView<T>::kSupported) {
+            out.resize(wire::EncodedSize(view->message, wire::kSchemaVersion));
+            out.resize(wire::Encode(view->message, reinterpret_cast<uint8_t*>(&out[0]), out.size()));
+        }
+    };
+    entry.decode = [](Format format, const uint8_t* data, size_t length) {
+        if (format == Format::Schema) {
+            if constexpr (SchemaView<T>::kSupported) {
+                using Wire = decltype(SchemaView<T>::message);
+                wire::FrameHeader header;
+                Wire decoded;
+                return wire::ReadFrameHeader(data, length, header) && wire::Decode(header, decoded) &&
+                       WalkLists(decoded);
+            }
+            return false;
+        }
+        T decoded;
+        if (format == Format::Json) {
+            JsonValue document;
+            JsonParser parser(reinterpret_cast<const char*>(data), length);
+            if (!parser.Parse(document)) return false;
+            JsonBinder binder{document};
+            binder.Read(document, decoded);
+            return binder.ok;
+        }
+        BinaryReader reader{data, data + length};
+        reader.Read(decoded);
+        return reader.ok && reader.p == reader.end;
+    };
+    return entry;
+}
+
+bool EncodeFramed(const CorpusEntry& entry, Format format, const Compressor* compressor, std::string& serialized,
+                  std::string& compressed, std::string& frame) {
+    serialized.clear();
+    entry.encode(format, serialized);
+    frame.clear();
+    if (compressor && serialized.size() > kCompressionThreshold) {
+        if (!compressor->compress(serialized, compressed)) return false;
+        uint32_t original = static_cast<uint32_t>(serialized.size());
+        frame += static_cast<char>(1);
+        frame.append(reinterpret_cast<const char*>(&original), 4);
+        frame.append(compressed);
+    } else if (format == Format::Schema) {
+        frame.append(serialized); // carries its own flag byte
+    } else {
+        frame += static_cast<char>(0);
+        frame.append(serialized);
+    }
+    return true;
+}
+
+bool DecodeFramed(const CorpusEntry& entry, Format format, const Compressor* compressor, const std::string& frame,
+                  std::string& scratch) {
+    auto* data = reinterpret_cast<const uint8_t*>(frame.data());
+    if (frame[0] == 1) {
+        uint32_t original;
+        memcpy(&original, data + 1, 4);
+        if (!compressor || !compressor->decompress(data + 5, frame.size() - 5, original, scratch)) return false;
+        return entry.decode(format, reinterpret_cast<const uint8_t*>(scratch.data()), scratch.size());
+    }
+    if (format == Format::Schema) return entry.decode(format, data, frame.size());
+    return entry.decode(format, data + 1, frame.size() - 1);
+}
+
+// ---------------------------------------------------------------------------
+// Corpus
+// ---------------------------------------------------------------------------
+
+std::string RandomHash(Random& rng) {
+    static const char kHex[] = "0123456789ABCDEF";
+    std::string hash(64, '0');
+    for (auto& c : hash) c = kHex[rng.Next() & 0xF];
+    return hash;
+}
+
+std::string RandomGuid(Random& rng) {
+    static const char kHex[] = "0123456789abcdef";
+    std::string id = "xxxxxxxx-xxxx-4xxx-yxxx-xxxxxxxxxxxx";
+    for (auto& c : id) {
+        if (c == 'x' || c == 'y') c = kHex[rng.Next() & 0xF];
+    }
+    return id;
+}
+
+std::string RandomBase64Blob(Random& rng, size_t bytes) {
+    std::vector<uint8_t> raw(bytes);
+    FillSyntheticContent(rng, raw.data(), raw.size());
+    std::string out;
+    AppendBase64(out, raw);
+    return out;
+}
+
+std::string GamePath(Random& rng, size_t index, const char* extension) {
+    return "chara/equipment/e" + std::to_string(rng.Range(1, 9999)) + "/material/v0001/mt_c0101e" +
+           std::to_string(index) + extension;
+}
+
+MessageHeader Header(Random& rng, int64_t type) {
+    return MessageHeader{type, RandomGuid(rng), 1760000000 + static_cast<int64_t>(rng.Range(0, 100000)), RandomGuid(rng)};
+}
+
+PlayerInfo MakePlayerInfo(Random& rng) {
+    PlayerInfo info;
+    info.player_id = RandomGuid(rng);
+    info.player_name = "Synthetic Player@Balmung";
+    info.state = 6;
+    for (int i = 0; i < 40; ++i) info.mods.push_back("Mod Collection Entry " + std::to_string(i));
+    info.manipulation_data = RandomBase64Blob(rng, 6 * 1024);
+    info.glamourer_data = RandomBase64Blob(rng, 3 * 1024);
+    info.customize_plus_data = RandomBase64Blob(rng, 1024);
+    info.simple_heels_offset = 0.125f;
+    info.honorific_title = "Of The Synthetic Corpus";
+    info.world_id = 91;
+    return info;
+}
+
+std::map<std::string, TransferableFile> MakeFiles(Random& rng, size_t count, uint64_t min_size, uint64_t max_size) {
+    std::map<std::string, TransferableFile> files;
+    for (size_t i = 0; i < count; ++i) {
+        TransferableFile file;
+        file.game_path = GamePath(rng, i, (i % 3 == 0) ? ".mdl" : (i % 3 == 1) ? ".mtrl" : ".tex");
+        file.hash = RandomHash(rng);
+        if (max_size > 0) {
+            file.content.resize(static_cast<size_t>(rng.LogRange(min_size, max_size)));
+            FillSyntheticContent(rng, file.content.data(), file.content.size());
+        }
+        file.size = static_cast<int64_t>(file.content.size());
+        files[file.game_path] = std::move(file);
+    }
+    return files;
+}
+
+std::vector<CorpusEntry> BuildCorpus(Random& rng) {
+    std::vector<CorpusEntry> corpus;
+
+    ModDataRequest request;
+    request.header = Header(rng, 0);
+    request.player_name = "Synthetic Player@Balmung";
+    request.last_known_hash = RandomHash(rng).substr(0, 16);
+    corpus.push_back(MakeEntry("ModDataRequest", std::move(request)));
+
+    ModDataResponse full;
+    full.header = Header(rng, 1);
+    full.player_name = "Synthetic Player@Balmung";
+    full.data_hash = RandomHash(rng).substr(0, 16);
+    full.player_info = MakePlayerInfo(rng);
+    full.file_replacements = MakeFiles(rng, 150, 2 * 1024, 64 * 1024);
+    corpus.push_back(MakeEntry("ModDataResponse/files", std::move(full)));
+
+    ModDataResponse recipe;
+    recipe.header = Header(rng, 1);
+    recipe.player_name = "Synthetic Player@Balmung";
+    recipe.data_hash = RandomHash(rng).substr(0, 16);
+    recipe.player_info = MakePlayerInfo(rng);
+    recipe.file_replacements = MakeFiles(rng, 400, 0, 0);
+    corpus.push_back(MakeEntry("ModDataResponse/recipe", std::move(recipe)));
+
+    ComponentResponse components;
+    components.header = Header(rng, 3);
+    components.components = MakeFiles(rng, 20, 32 * 1024, 256 * 1024);
+    for (int i = 0; i < 4; ++i) components.missing_hashes.push_back(RandomHash(rng));
+    corpus.push_back(MakeEntry("ComponentResponse", std::move(components)));
+
+    ChunkedMessage chunk;
+    chunk.header = Header(rng, 8);
+    chunk.chunk_id = RandomGuid(rng);
+    chunk.chunk_index = 17;
+    chunk.total_chunks = 512;
+    chunk.chunk_data.resize(1024); // P2PModProtocol.CHUNK_SIZE
+    FillSyntheticContent(rng, chunk.chunk_data.data(), chunk.chunk_data.size());
+    chunk.original_message_type = 3;
+    chunk.original_message_type_name = "FyteClub.ModSystem.ComponentResponse";
+    chunk.message_metadata = {{"MessageId", RandomGuid(rng)}, {"Timestamp", "1760000000"}, {"ResponseTo", RandomGuid(rng)}};
+    corpus.push_back(MakeEntry("ChunkedMessage", std::move(chunk)));
+
+    ModManifest manifest;
+    manifest.player_name = "Synthetic Player@Balmung";
+    for (size_t i = 0; i < 400; ++i) manifest.file_hashes[GamePath(rng, i, ".tex")] = RandomHash(rng);
+    manifest.glamourer_data = RandomBase64Blob(rng, 3 * 1024);
+    manifest.customize_plus_data = RandomBase64Blob(rng, 1024);
+    manifest.manipulation_data = RandomBase64Blob(rng, 6 * 1024);
+    manifest.honorific_title = "Of The Synthetic Corpus";
+    manifest.simple_heels_offset = 0.125f;
+    corpus.push_back(MakeEntry("ModManifest", std::move(manifest)));
+
+    return corpus;
+}
+
+struct Codec {
+    std::string name;
+    Format format;
+    const Compressor* compressor;
+};
+
+struct Result {
+    size_t raw_size = 0;
+    size_t frame_size = 0;
+    double encode_mbps = 0;
+    double decode_mbps = 0;
+    double encode_allocs = 0;
+    double decode_allocs = 0;
+    double encode_alloc_kb = 0;
+    double decode_alloc_kb = 0;
+    bool ok = true;
+};
+
+Result Measure(const CorpusEntry& entry, const Codec& codec, double min_ms) {
+    Result result;
+    std::string serialized, compressed, frame, scratch;
+
+    // Throughput is measured against the uncompressed JSON size for every codec
+    // so rows for the same message compare like for like
+    std::string baseline;
+    entry.encode(Format::Json, baseline);
+    result.raw_size = baseline.size();
+
+    if (!EncodeFramed(entry, codec.format, codec.compressor, serialized, compressed, frame) ||
+        !DecodeFramed(entry, codec.format, codec.compressor, frame, scratch)) {
+        result.ok = false;
+        return result;
+    }
+    result.frame_size = frame.size();
+
+    uint64_t iterations = 0;
+    auto allocs_before = g_allocations.load();
+    auto bytes_before = g_allocated_bytes.load();
+    auto start = Clock::now();
+    do {
+        EncodeFramed(entry, codec.format, codec.compressor, serialized, compressed, frame);
+        ++iterations;
+    } while (MillisecondsSince(start) < min_ms);
+    double encode_ms = MillisecondsSince(start);
+    result.encode_mbps = MegabytesPerSecond(result.raw_size * iterations, encode_ms);
+    result.encode_allocs = static_cast<double>(g_allocations.load() - allocs_before) / iterations;
+    result.encode_alloc_kb = (g_allocated_bytes.load() - bytes_before) / 1024.0 / iterations;
+
+    iterations = 0;
+    allocs_before = g_allocations.load();
+    bytes_before = g_allocated_bytes.load();
+    start = Clock::now();
+    do {
+        result.ok &= DecodeFramed(entry, codec.format, codec.compressor, frame, scratch);
+        ++iterations;
+    } while (MillisecondsSince(start) < min_ms);
+    double decode_ms = MillisecondsSince(start);
+    result.decode_mbps = MegabytesPerSecond(result.raw_size * iterations, decode_ms);
+    result.decode_allocs = static_cast<double>(g_allocations.load() - allocs_before) / iterations;
+    result.decode_alloc_kb = (g_allocated_bytes.load() - bytes_before) / 1024.0 / iterations;
+    return result;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const double min_ms = static_cast<double>(ArgOr(argc, argv, "--min-ms", 300));
+    const bool csv = HasFlag(argc, argv, "--csv");
+    Random rng(ArgOr(argc, argv, "--seed", 0xC0DEC));
+
+    auto corpus = BuildCorpus(rng);
+
+    std::vector<Compressor> compressors;
+#ifdef FYTECLUB_HAVE_ZLIB
+    compressors.push_back(MakeGzip(Z_DEFAULT_COMPRESSION, "gzip")); // CompressionLevel.Optimal
+    compressors.push_back(MakeGzip(Z_BEST_SPEED, "gzip-fast"));     // CompressionLevel.Fastest
+#endif
+#ifdef FYTECLUB_HAVE_ZSTD
+    for (int level : {1, 3, 6, 12, 19}) compressors.push_back(MakeZstd(level));
+#endif
+
+    std::vector<Codec> codecs;
+    codecs.push_back({"json", Format::Json, nullptr});
+    for (const auto& compressor : compressors) codecs.push_back({"json+" + compressor.name, Format::Json, &compressor});
+    codecs.push_back({"binary", Format::Binary, nullptr});
+    for (const auto& compressor : compressors) {
+        if (compressor.name.rfind("zstd", 0) == 0) codecs.push_back({"binary+" + compressor.name, Format::Binary, &compressor});
+    }
+    codecs.push_back({"schema", Format::Schema, nullptr});
+    for (const auto& compressor : compressors) {
+        if (compressor.name.rfind("zstd", 0) == 0) codecs.push_back({"schema+" + compressor.name, Format::Schema, &compressor});
+    }
+
+    if (csv) {
+        printf("message,codec,raw_bytes,wire_bytes,ratio,encode_mbps,decode_mbps,encode_allocs,decode_allocs,encode_alloc_kb,decode_alloc_kb\n");
+    } else {
+        printf("%-24s %-18s %10s %10s %7s %10s %10s %10s %10s\n", "message", "codec", "json bytes", "wire bytes",
+               "ratio", "enc MB/s", "dec MB/s", "enc alloc", "dec alloc");
+    }
+
+    bool all_ok = true;
+    for (const auto& entry : corpus) {
+        for (const auto& codec : codecs) {
+            if (codec.format == Format::Schema && !entry.has_schema) continue;
+            auto r = Measure(entry, codec, min_ms);
+            all_ok &= r.ok;
+            double ratio = r.frame_size ? static_cast<double>(r.raw_size) / r.frame_size : 0;
+            if (csv) {
+                printf("%s,%s,%zu,%zu,%.3f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f\n", entry.name.c_str(), codec.name.c_str(),
+                       r.raw_size, r.frame_size, ratio, r.encode_mbps, r.decode_mbps, r.encode_allocs, r.decode_allocs,
+                       r.encode_alloc_kb, r.decode_alloc_kb);
+            } else {
+                printf("%-24s %-18s %10zu %10zu %7.2f %10.1f %10.1f %10.1f %10.1f%s\n", entry.name.c_str(),
+                       codec.name.c_str(), r.raw_size, r.frame_size, ratio, r.encode_mbps, r.decode_mbps,
+                       r.encode_allocs, r.decode_allocs, r.ok ? "" : "  ROUNDTRIP FAILED");
+            }
+        }
+        if (!csv) printf("\n");
+    }
+
+#ifndef FYTECLUB_HAVE_ZSTD
+    if (!csv) printf("zstd not found at configure time - zstd codecs skipped (vcpkg install zstd)\n");
+#endif
+    return all_ok ? 0 : 1;
+}
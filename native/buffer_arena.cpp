@@ -0,0 +1,132 @@
+#include "buffer_arena.h"
+#include <new>
+
+namespace fyteclub {
+
+BufferArena::BufferArena(size_t slot_size, size_t slot_count)
+    : slot_size_((slot_size + kAlignment - 1) / kAlignment * kAlignment), slot_count_(slot_count),
+      held_(slot_count, false) {
+    if (slot_size_ && slot_count_) {
+        data_ = static_cast<uint8_t*>(::operator new(slot_size_ * slot_count_, std::align_val_t(kAlignment)));
+    }
+    free_.reserve(slot_count_);
+    for (size_t i = slot_count_; i > 0; --i) free_.push_back(static_cast<int>(i - 1));
+}
+
+BufferArena::~BufferArena() {
+    if (data_) ::operator delete(data_, std::align_val_t(kAlignment));
+}
+
+uint8_t* BufferArena::Slot(int slot) const {
+    if (slot < 0 || static_cast<size_t>(slot) >= slot_count_) return nullptr;
+    return data_ + static_cast<size_t>(slot) * slot_size_;
+}
+
+bool BufferArena::HeldLocked(int slot) const {
+    return slot >= 0 && static_cast<size_t>(slot) < slot_count_ && held_[static_cast<size_t>(slot)];
+}
+
+int BufferArena::Acquire() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (free_.empty()) {
+        ++exhausted_;
+        return -1;
+    }
+    int slot = free_.back();
+    free_.pop_back();
+    held_[static_cast<size_t>(slot)] = true;
+    return slot;
+}
+
+bool BufferArena::Release(int slot) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!HeldLocked(slot)) return false;
+    held_[static_cast<size_t>(slot)] = false;
+    free_.push_back(slot);
+    return true;
+}
+
+bool BufferArena::Post(int slot, size_t length) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!HeldLocked(slot) || length > slot_size_) return false;
+    posted_.emplace_back(slot, length);
+    return true;
+}
+
+bool BufferArena::Poll(int& slot, size_t& length) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (posted_.empty()) return false;
+    slot = posted_.front().first;
+    length = posted_.front().second;
+    posted_.pop_front();
+    return true;
+}
+
+size_t BufferArena::InUse() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return slot_count_ - free_.size();
+}
+
+uint64_t BufferArena::Exhausted() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return exhausted_;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// C exports for the plugin
+// ---------------------------------------------------------------------------
+
+extern "C" {
+
+// Sized once for the connection's largest frame; arenas over 1 GB are refused
+__declspec(dllexport) void* CreateBufferArena(int slot_size, int slot_count) {
+    if (slot_size <= 0 || slot_count <= 0) return nullptr;
+    if (static_cast<uint64_t>(slot_size) * static_cast<uint64_t>(slot_count) > (1ull << 30)) return nullptr;
+    return new fyteclub::BufferArena(static_cast<size_t>(slot_size), static_cast<size_t>(slot_count));
+}
+
+// Base of the arena; slot i starts at base + i * BufferArenaSlotSize
+__declspec(dllexport) uint8_t* BufferArenaData(void* arena) {
+    return arena ? static_cast<fyteclub::BufferArena*>(arena)->Data() : nullptr;
+}
+
+__declspec(dllexport) int BufferArenaSlotSize(void* arena) {
+    return arena ? static_cast<int>(static_cast<fyteclub::BufferArena*>(arena)->SlotSize()) : 0;
+}
+
+__declspec(dllexport) int BufferArenaSlotCount(void* arena) {
+    return arena ? static_cast<int>(static_cast<fyteclub::BufferArena*>(arena)->SlotCount()) : 0;
+}
+
+// Slot index, or -1 when every slot is held
+__declspec(dllexport) int BufferArenaAcquire(void* arena) {
+    return arena ? static_cast<fyteclub::BufferArena*>(arena)->Acquire() : -1;
+}
+
+__declspec(dllexport) int BufferArenaRelease(void* arena, int slot) {
+    return arena && static_cast<fyteclub::BufferArena*>(arena)->Release(slot) ? 1 : 0;
+}
+
+// 1 and a posted slot (now owned by the caller, release it when done), or 0
+__declspec(dllexport) int BufferArenaPoll(void* arena, int* slot, int* length) {
+    if (!arena || !slot || !length) return 0;
+    int polled;
+    size_t size;
+    if (!static_cast<fyteclub::BufferArena*>(arena)->Poll(polled, size)) return 0;
+    *slot = polled;
+    *length = static_cast<int>(size);
+    return 1;
+}
+
+__declspec(dllexport) int BufferArenaInUse(void* arena) {
+    return arena ? static_cast<int>(static_cast<fyteclub::BufferArena*>(arena)->InUse()) : 0;
+}
+
+// Only once nothing native or managed still uses a slot
+__declspec(dllexport) void DestroyBufferArena(void* arena) {
+    delete static_cast<fyteclub::BufferArena*>(arena);
+}
+
+}
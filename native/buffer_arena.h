@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Long-lived buffers shared by native code and the plugin. Every send
+// otherwise pins (or marshals) a managed byte[] for the call, and every
+// receive allocates a new managed array for the GC to track. An arena is one
+// native allocation cut into equal slots. It is created once per connection
+// or per transfer path, and the plugin wraps its slots as Memory<byte>
+// (NativeBufferArena.cs). Native memory never moves, so neither side pins
+// or copies to hand a slot across.
+//
+// A sender frames straight into an acquired slot and passes the slot's
+// pointer to SendData/LanSend/etc. A receiver fills a slot natively, either
+// returning its index to the caller (LanReceiveSlot) or, from a native
+// callback thread, posting it for the plugin to poll. Whoever ends up with a
+// slot releases it when done. Thread-safe; slots are never reused while
+// held, so a slot's bytes belong to whoever acquired it.
+//
+// Only native callers use it so far. The plugin sends and receives through
+// MixedReality WebRTC, whose DataChannel.SendMessage and MessageReceived
+// take and hand out managed arrays, and it has no binding for the LAN
+// transport, so NativeBufferArena is not constructed anywhere yet. It pays
+// off once a transport the plugin binds takes a pointer: SendData on the
+// native WebRTC build, or LanSend/LanReceiveSlot.
+
+namespace fyteclub {
+
+class BufferArena {
+public:
+    static constexpr size_t kAlignment = 64;
+
+    // slot_size is rounded up to kAlignment
+    BufferArena(size_t slot_size, size_t slot_count);
+    ~BufferArena();
+    BufferArena(const BufferArena&) = delete;
+    BufferArena& operator=(const BufferArena&) = delete;
+
+    uint8_t* Data() const { return data_; }
+    size_t SlotSize() const { return slot_size_; }
+    size_t SlotCount() const { return slot_count_; }
+    // nullptr for an index outside the arena
+    uint8_t* Slot(int slot) const;
+
+    // -1 when every slot is held
+    int Acquire();
+    // False if the slot was not held (double release, bad index)
+    bool Release(int slot);
+
+    // Hands a filled, held slot to whoever polls; it stays held until released
+    bool Post(int slot, size_t length);
+    bool Poll(int& slot, size_t& length);
+
+    size_t InUse() const;
+    // Acquires answered with -1
+    uint64_t Exhausted() const;
+
+private:
+    bool HeldLocked(int slot) const;
+
+    const size_t slot_size_;
+    const size_t slot_count_;
+    uint8_t* data_ = nullptr;
+
+    mutable std::mutex mutex_;
+    std::vector<int> free_; // LIFO so recently used (cache-warm) slots go out first
+    std::vector<bool> held_;
+    std::deque<std::pair<int, size_t>> posted_;
+    uint64_t exhausted_ = 0;
+};
+
+}
@@ -13,7 +13,7 @@ chcp 65001
 REM Build with all required includes and libraries
 cl /LD /std:c++17 ^
    /DWEBRTC_WIN /DNOMINMAX /D_WIN32_WINNT=0x0A00 /DRTC_DISABLE_LOGGING ^
-   webrtc_wrapper.cpp ^
+   webrtc_wrapper.cpp sha256.cpp crc32c.cpp chunk_frame.cpp fec.cpp lan_transport.cpp thread_policy.cpp flow_control.cpp decode_pool.cpp chunk_assembler.cpp inflight_registry.cpp timer_wheel.cpp selective_ack.cpp manifest_log.cpp state_hasher.cpp phonebook_crdt.cpp gossip.cpp component_pipeline.cpp snapshot_pack.cpp upload_admission.cpp memory_budget.cpp sha1.cpp mod_data_stream.cpp buffer_arena.cpp chacha20_poly1305.cpp ^
    /I"%WEBRTC_SRC%" ^
    /I"%WEBRTC_SRC%\third_party\abseil-cpp" ^
    /I"%WEBRTC_SRC%\third_party\boringssl\src\include" ^
@@ -0,0 +1,221 @@
+#include "chacha20_poly1305.h"
+#include "frame_util.h"
+#include <cstring>
+
+namespace fyteclub {
+
+namespace {
+
+uint32_t Rotl(uint32_t value, int shift) { return (value << shift) | (value >> (32 - shift)); }
+
+// ---------------------------------------------------------------------------
+// ChaCha20
+// ---------------------------------------------------------------------------
+
+#define FC_QUARTER_ROUND(a, b, c, d)                                                                \
+    a += b; d = Rotl(d ^ a, 16);                                                                    \
+    c += d; b = Rotl(b ^ c, 12);                                                                    \
+    a += b; d = Rotl(d ^ a, 8);                                                                     \
+    c += d; b = Rotl(b ^ c, 7)
+
+void ChaChaBlock(const uint32_t input[16], uint8_t out[64]) {
+    uint32_t x[16];
+    memcpy(x, input, sizeof(x));
+    for (int round = 0; round < 10; ++round) {
+        FC_QUARTER_ROUND(x[0], x[4], x[8], x[12]);
+        FC_QUARTER_ROUND(x[1], x[5], x[9], x[13]);
+        FC_QUARTER_ROUND(x[2], x[6], x[10], x[14]);
+        FC_QUARTER_ROUND(x[3], x[7], x[11], x[15]);
+        FC_QUARTER_ROUND(x[0], x[5], x[10], x[15]);
+        FC_QUARTER_ROUND(x[1], x[6], x[11], x[12]);
+        FC_QUARTER_ROUND(x[2], x[7], x[8], x[13]);
+        FC_QUARTER_ROUND(x[3], x[4], x[9], x[14]);
+    }
+    for (int i = 0; i < 16; ++i) StoreLe32(out + i * 4, x[i] + input[i]);
+}
+
+#undef FC_QUARTER_ROUND
+
+void ChaChaInit(uint32_t state[16], const uint8_t key[kAeadKeySize], const uint8_t nonce[kAeadNonceSize],
+                uint32_t counter) {
+    state[0] = 0x61707865;
+    state[1] = 0x3320646e;
+    state[2] = 0x79622d32;
+    state[3] = 0x6b206574;
+    for (int i = 0; i < 8; ++i) state[4 + i] = LoadLe32(key + i * 4);
+    state[12] = counter;
+    for (int i = 0; i < 3; ++i) state[13 + i] = LoadLe32(nonce + i * 4);
+}
+
+void ChaChaXor(uint32_t state[16], uint8_t* data, size_t length) {
+    uint8_t block[64];
+    while (length > 0) {
+        ChaChaBlock(state, block);
+        ++state[12];
+        const size_t take = length < sizeof(block) ? length : sizeof(block);
+        for (size_t i = 0; i < take; ++i) data[i] ^= block[i];
+        data += take;
+        length -= take;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Poly1305, 26-bit limbs so every product fits in 64 bits on any compiler
+// ---------------------------------------------------------------------------
+
+class Poly1305 {
+public:
+    explicit Poly1305(const uint8_t key[32]) {
+        r_[0] = LoadLe32(key + 0) & 0x3ffffff;
+        r_[1] = (LoadLe32(key + 3) >> 2) & 0x3ffff03;
+        r_[2] = (LoadLe32(key + 6) >> 4) & 0x3ffc0ff;
+        r_[3] = (LoadLe32(key + 9) >> 6) & 0x3f03fff;
+        r_[4] = (LoadLe32(key + 12) >> 8) & 0x00fffff;
+        for (int i = 0; i < 4; ++i) pad_[i] = LoadLe32(key + 16 + i * 4);
+    }
+
+    void Update(const uint8_t* data, size_t length) {
+        if (buffered_) {
+            size_t take = 16 - buffered_;
+            if (take > length) take = length;
+            memcpy(buffer_ + buffered_, data, take);
+            buffered_ += take;
+            data += take;
+            length -= take;
+            if (buffered_ < 16) return;
+            Block(buffer_, 1u << 24);
+            buffered_ = 0;
+        }
+        for (; length >= 16; data += 16, length -= 16) Block(data, 1u << 24);
+        if (length) {
+            memcpy(buffer_, data, length);
+            buffered_ = length;
+        }
+    }
+
+    // Zero bytes up to the next 16-byte boundary, as the AEAD layout requires
+    void Pad() {
+        if (!buffered_) return;
+        static const uint8_t kZeros[16] = {};
+        Update(kZeros, 16 - buffered_);
+    }
+
+    void Final(uint8_t tag[16]) {
+        if (buffered_) {
+            buffer_[buffered_] = 1;
+            memset(buffer_ + buffered_ + 1, 0, 16 - buffered_ - 1);
+            Block(buffer_, 0);
+        }
+        uint32_t h0 = h_[0], h1 = h_[1], h2 = h_[2], h3 = h_[3], h4 = h_[4];
+        uint32_t c = h1 >> 26; h1 &= 0x3ffffff;
+        h2 += c; c = h2 >> 26; h2 &= 0x3ffffff;
+        h3 += c; c = h3 >> 26; h3 &= 0x3ffffff;
+        h4 += c; c = h4 >> 26; h4 &= 0x3ffffff;
+        h0 += c * 5; c = h0 >> 26; h0 &= 0x3ffffff;
+        h1 += c;
+
+        // h - p, kept only if it did not go negative
+        uint32_t g0 = h0 + 5; c = g0 >> 26; g0 &= 0x3ffffff;
+        uint32_t g1 = h1 + c; c = g1 >> 26; g1 &= 0x3ffffff;
+        uint32_t g2 = h2 + c; c = g2 >> 26; g2 &= 0x3ffffff;
+        uint32_t g3 = h3 + c; c = g3 >> 26; g3 &= 0x3ffffff;
+        uint32_t g4 = h4 + c - (1u << 26);
+        uint32_t mask = (g4 >> 31) - 1;
+        h0 = (h0 & ~mask) | (g0 & mask);
+        h1 = (h1 & ~mask) | (g1 & mask);
+        h2 = (h2 & ~mask) | (g2 & mask);
+        h3 = (h3 & ~mask) | (g3 & mask);
+        h4 = (h4 & ~mask) | (g4 & mask);
+
+        h0 = h0 | (h1 << 26);
+        h1 = (h1 >> 6) | (h2 << 20);
+        h2 = (h2 >> 12) | (h3 << 14);
+        h3 = (h3 >> 18) | (h4 << 8);
+
+        uint64_t f = uint64_t(h0) + pad_[0];
+        StoreLe32(tag + 0, static_cast<uint32_t>(f));
+        f = uint64_t(h1) + pad_[1] + (f >> 32);
+        StoreLe32(tag + 4, static_cast<uint32_t>(f));
+        f = uint64_t(h2) + pad_[2] + (f >> 32);
+        StoreLe32(tag + 8, static_cast<uint32_t>(f));
+        f = uint64_t(h3) + pad_[3] + (f >> 32);
+        StoreLe32(tag + 12, static_cast<uint32_t>(f));
+    }
+
+private:
+    void Block(const uint8_t* m, uint32_t hibit) {
+        const uint32_t r0 = r_[0], r1 = r_[1], r2 = r_[2], r3 = r_[3], r4 = r_[4];
+        const uint32_t s1 = r1 * 5, s2 = r2 * 5, s3 = r3 * 5, s4 = r4 * 5;
+        uint32_t h0 = h_[0] + (LoadLe32(m + 0) & 0x3ffffff);
+        uint32_t h1 = h_[1] + ((LoadLe32(m + 3) >> 2) & 0x3ffffff);
+        uint32_t h2 = h_[2] + ((LoadLe32(m + 6) >> 4) & 0x3ffffff);
+        uint32_t h3 = h_[3] + ((LoadLe32(m + 9) >> 6) & 0x3ffffff);
+        uint32_t h4 = h_[4] + ((LoadLe32(m + 12) >> 8) | hibit);
+
+        uint64_t d0 = uint64_t(h0) * r0 + uint64_t(h1) * s4 + uint64_t(h2) * s3 + uint64_t(h3) * s2 + uint64_t(h4) * s1;
+        uint64_t d1 = uint64_t(h0) * r1 + uint64_t(h1) * r0 + uint64_t(h2) * s4 + uint64_t(h3) * s3 + uint64_t(h4) * s2;
+        uint64_t d2 = uint64_t(h0) * r2 + uint64_t(h1) * r1 + uint64_t(h2) * r0 + uint64_t(h3) * s4 + uint64_t(h4) * s3;
+        uint64_t d3 = uint64_t(h0) * r3 + uint64_t(h1) * r2 + uint64_t(h2) * r1 + uint64_t(h3) * r0 + uint64_t(h4) * s4;
+        uint64_t d4 = uint64_t(h0) * r4 + uint64_t(h1) * r3 + uint64_t(h2) * r2 + uint64_t(h3) * r1 + uint64_t(h4) * r0;
+
+        uint32_t c = static_cast<uint32_t>(d0 >> 26); h0 = static_cast<uint32_t>(d0) & 0x3ffffff;
+        d1 += c; c = static_cast<uint32_t>(d1 >> 26); h1 = static_cast<uint32_t>(d1) & 0x3ffffff;
+        d2 += c; c = static_cast<uint32_t>(d2 >> 26); h2 = static_cast<uint32_t>(d2) & 0x3ffffff;
+        d3 += c; c = static_cast<uint32_t>(d3 >> 26); h3 = static_cast<uint32_t>(d3) & 0x3ffffff;
+        d4 += c; c = static_cast<uint32_t>(d4 >> 26); h4 = static_cast<uint32_t>(d4) & 0x3ffffff;
+        h0 += c * 5; c = h0 >> 26; h0 &= 0x3ffffff;
+        h1 += c;
+
+        h_[0] = h0; h_[1] = h1; h_[2] = h2; h_[3] = h3; h_[4] = h4;
+    }
+
+    uint32_t r_[5];
+    uint32_t h_[5] = {};
+    uint32_t pad_[4];
+    uint8_t buffer_[16];
+    size_t buffered_ = 0;
+};
+
+void ComputeTag(const uint32_t state[16], const uint8_t* aad, size_t aad_length, const uint8_t* ciphertext,
+                size_t length, uint8_t tag[kAeadTagSize]) {
+    // The one-time Poly1305 key is the first half of keystream block 0
+    uint8_t block[64];
+    ChaChaBlock(state, block);
+    Poly1305 mac(block);
+    if (aad_length) mac.Update(aad, aad_length);
+    mac.Pad();
+    if (length) mac.Update(ciphertext, length);
+    mac.Pad();
+    uint8_t lengths[16];
+    StoreLe64(lengths, aad_length);
+    StoreLe64(lengths + 8, length);
+    mac.Update(lengths, sizeof(lengths));
+    mac.Final(tag);
+}
+
+}
+
+void AeadSeal(const uint8_t key[kAeadKeySize], const uint8_t nonce[kAeadNonceSize], const uint8_t* aad,
+              size_t aad_length, uint8_t* data, size_t length, uint8_t tag[kAeadTagSize]) {
+    uint32_t state[16];
+    ChaChaInit(state, key, nonce, 1);
+    ChaChaXor(state, data, length);
+    ChaChaInit(state, key, nonce, 0);
+    ComputeTag(state, aad, aad_length, data, length, tag);
+}
+
+bool AeadOpen(const uint8_t key[kAeadKeySize], const uint8_t nonce[kAeadNonceSize], const uint8_t* aad,
+              size_t aad_length, uint8_t* data, size_t length, const uint8_t tag[kAeadTagSize]) {
+    uint32_t state[16];
+    ChaChaInit(state, key, nonce, 0);
+    uint8_t expected[kAeadTagSize];
+    ComputeTag(state, aad, aad_length, data, length, expected);
+    uint8_t difference = 0;
+    for (size_t i = 0; i < kAeadTagSize; ++i) difference |= expected[i] ^ tag[i];
+    if (difference != 0) return false;
+    ChaChaInit(state, key, nonce, 1);
+    ChaChaXor(state, data, length);
+    return true;
+}
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// ChaCha20-Poly1305 AEAD (RFC 8439), used to encrypt and authenticate the LAN
+// bulk path once the handshake has agreed on session keys. Portable C++ with
+// no library dependency; a scalar implementation comfortably outruns gigabit
+// Ethernet, which is all the LAN path needs.
+//
+// A (key, nonce) pair must never seal two different messages. LanConnection
+// uses a separate key per direction and a message counter as the nonce.
+
+namespace fyteclub {
+
+constexpr size_t kAeadKeySize = 32;
+constexpr size_t kAeadNonceSize = 12;
+constexpr size_t kAeadTagSize = 16;
+
+// Encrypts data in place and writes the tag over aad and the ciphertext
+void AeadSeal(const uint8_t key[kAeadKeySize], const uint8_t nonce[kAeadNonceSize], const uint8_t* aad,
+              size_t aad_length, uint8_t* data, size_t length, uint8_t tag[kAeadTagSize]);
+
+// Checks the tag and only then decrypts in place. False, with data left as
+// ciphertext, if the message or aad was altered.
+bool AeadOpen(const uint8_t key[kAeadKeySize], const uint8_t nonce[kAeadNonceSize], const uint8_t* aad,
+              size_t aad_length, uint8_t* data, size_t length, const uint8_t tag[kAeadTagSize]);
+
+}
@@ -0,0 +1,541 @@
+#include "chunk_assembler.h"
+#include "frame_util.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace fyteclub {
+
+namespace {
+
+constexpr size_t kMaxIoSize = 1u << 30;
+constexpr size_t kHashReadBlock = 1024 * 1024;
+constexpr size_t kFinishedMemory = 4096; // finished stream ids remembered to spot late duplicates
+
+// SHA-1 (40 hex) or SHA-256 (64 hex), as ModDataStreamDecoder accepts
+bool IsContentHash(std::string_view hash) {
+    return (hash.size() == Sha1::kDigestSize * 2 || hash.size() == Sha256::kDigestSize * 2) &&
+           std::all_of(hash.begin(), hash.end(), [](char c) { return isxdigit(static_cast<unsigned char>(c)) != 0; });
+}
+
+bool SameHex(const uint8_t* digest, size_t digest_size, std::string_view hex) {
+    static const char kDigits[] = "0123456789ABCDEF";
+    if (hex.size() != digest_size * 2) return false;
+    for (size_t i = 0; i < digest_size; ++i) {
+        if (toupper(static_cast<unsigned char>(hex[i * 2])) != kDigits[digest[i] >> 4] ||
+            toupper(static_cast<unsigned char>(hex[i * 2 + 1])) != kDigits[digest[i] & 0xF]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// ByteRangeSet
+// ---------------------------------------------------------------------------
+
+uint64_t ByteRangeSet::Add(uint64_t begin, uint64_t end) {
+    if (begin >= end) return 0;
+    uint64_t added = end - begin;
+
+    // Merge with a range that starts before begin and reaches it
+    auto it = ranges_.upper_bound(begin);
+    if (it != ranges_.begin()) {
+        auto previous = std::prev(it);
+        if (previous->second >= begin) {
+            if (previous->second >= end) return 0;
+            added -= previous->second - begin;
+            begin = previous->first;
+            it = ranges_.erase(previous);
+        }
+    }
+    // Swallow every range that starts inside [begin, end]
+    while (it != ranges_.end() && it->first <= end) {
+        uint64_t overlap_end = std::min(it->second, end);
+        added -= overlap_end - it->first;
+        end = std::max(end, it->second);
+        it = ranges_.erase(it);
+    }
+    ranges_.emplace(begin, end);
+    covered_ += added;
+    return added;
+}
+
+bool ByteRangeSet::Contains(uint64_t begin, uint64_t end) const {
+    if (begin >= end) return true;
+    auto it = ranges_.upper_bound(begin);
+    if (it == ranges_.begin()) return false;
+    return std::prev(it)->second >= end;
+}
+
+uint64_t ByteRangeSet::ContiguousFrom(uint64_t offset) const {
+    auto it = ranges_.upper_bound(offset);
+    if (it == ranges_.begin()) return offset;
+    return std::max(offset, std::prev(it)->second);
+}
+
+// ---------------------------------------------------------------------------
+// PositionalFile
+// ---------------------------------------------------------------------------
+
+#ifdef _WIN32
+std::unique_ptr<PositionalFile> PositionalFile::Create(const std::string& path, uint64_t size) {
+    HANDLE handle = CreateFileW(fs::u8path(path).wstring().c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+                                nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) return nullptr;
+    LARGE_INTEGER end;
+    end.QuadPart = static_cast<LONGLONG>(size);
+    if (!SetFilePointerEx(handle, end, nullptr, FILE_BEGIN) || !SetEndOfFile(handle)) {
+        CloseHandle(handle);
+        return nullptr;
+    }
+    return std::unique_ptr<PositionalFile>(new PositionalFile(reinterpret_cast<intptr_t>(handle)));
+}
+
+PositionalFile::~PositionalFile() {
+    CloseHandle(reinterpret_cast<HANDLE>(handle_));
+}
+
+bool PositionalFile::WriteAt(uint64_t offset, const uint8_t* data, size_t length) {
+    while (length > 0) {
+        OVERLAPPED position{};
+        position.Offset = static_cast<DWORD>(offset);
+        position.OffsetHigh = static_cast<DWORD>(offset >> 32);
+        DWORD written = 0;
+        DWORD chunk = static_cast<DWORD>(std::min(length, kMaxIoSize));
+        if (!WriteFile(reinterpret_cast<HANDLE>(handle_), data, chunk, &written, &position) || written == 0) return false;
+        data += written;
+        offset += written;
+        length -= written;
+    }
+    return true;
+}
+
+bool PositionalFile::ReadAt(uint64_t offset, uint8_t* data, size_t length) {
+    while (length > 0) {
+        OVERLAPPED position{};
+        position.Offset = static_cast<DWORD>(offset);
+        position.OffsetHigh = static_cast<DWORD>(offset >> 32);
+        DWORD read = 0;
+        DWORD chunk = static_cast<DWORD>(std::min(length, kMaxIoSize));
+        if (!ReadFile(reinterpret_cast<HANDLE>(handle_), data, chunk, &read, &position) || read == 0) return false;
+        data += read;
+        offset += read;
+        length -= read;
+    }
+    return true;
+}
+#else
+std::unique_ptr<PositionalFile> PositionalFile::Create(const std::string& path, uint64_t size) {
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return nullptr;
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        return nullptr;
+    }
+    return std::unique_ptr<PositionalFile>(new PositionalFile(fd));
+}
+
+PositionalFile::~PositionalFile() {
+    close(static_cast<int>(handle_));
+}
+
+bool PositionalFile::WriteAt(uint64_t offset, const uint8_t* data, size_t length) {
+    while (length > 0) {
+        ssize_t written = pwrite(static_cast<int>(handle_), data, std::min(length, kMaxIoSize), static_cast<off_t>(offset));
+        if (written <= 0) return false;
+        data += written;
+        offset += static_cast<uint64_t>(written);
+        length -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+bool PositionalFile::ReadAt(uint64_t offset, uint8_t* data, size_t length) {
+    while (length > 0) {
+        ssize_t read = pread(static_cast<int>(handle_), data, std::min(length, kMaxIoSize), static_cast<off_t>(offset));
+        if (read <= 0) return false;
+        data += read;
+        offset += static_cast<uint64_t>(read);
+        length -= static_cast<size_t>(read);
+    }
+    return true;
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// ChunkAssembler
+// ---------------------------------------------------------------------------
+
+ChunkAssembler::ChunkAssembler(std::string output_dir, size_t max_pending_bytes, InflightRegistry* registry)
+    : output_dir_(std::move(output_dir)), max_pending_bytes_(max_pending_bytes), registry_(registry) {}
+
+ChunkAssembler::~ChunkAssembler() {
+    if (budget_) {
+        budget_->Release(budget_peer_, pending_bytes_);
+        budget_->RemovePeer(budget_peer_);
+    }
+    std::error_code error;
+    for (auto& [id, stream] : streams_) {
+        stream->file.reset();
+        fs::remove(fs::u8path(stream->part_path), error);
+        // Hands the download to a waiter on another peer, if there is one
+        if (registry_) registry_->Release(stream->info.file_hash, stream->registry_owner);
+    }
+    // Nobody is left here to fetch what these were waiting for
+    if (registry_) {
+        for (const auto& [hash, waiter] : waiting_) registry_->Release(hash, waiter);
+    }
+}
+
+ChunkAssemblyResult ChunkAssembler::OnFrame(const ParsedChunkFrame& frame) {
+    if (frame.type == ChunkFrameType::Open) return Open(frame.open);
+
+    const ChunkData& data = frame.data;
+    std::shared_ptr<Stream> stream;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (finished_.count(data.stream_id)) return ChunkAssemblyResult::Duplicate;
+        auto it = streams_.find(data.stream_id);
+        if (it == streams_.end()) {
+            // Overtook its OPEN on the unordered channel
+            if (pending_bytes_ + data.length > max_pending_bytes_) return ChunkAssemblyResult::Rejected;
+            if (budget_ && budget_->Reserve(budget_peer_, data.length) != MemoryReservation::Granted) {
+                return ChunkAssemblyResult::Rejected;
+            }
+            pending_[data.stream_id].push_back({data.offset, std::vector<uint8_t>(data.payload, data.payload + data.length)});
+            pending_bytes_ += data.length;
+            return ChunkAssemblyResult::Pending;
+        }
+        stream = it->second;
+    }
+    return Write(stream, data.offset, data.payload, data.length);
+}
+
+ChunkAssemblyResult ChunkAssembler::Open(const ChunkStreamOpen& open) {
+    // The hash names the file on disk, so it must not be able to escape the directory
+    if (!IsContentHash(open.file_hash)) return ChunkAssemblyResult::Rejected;
+
+    auto stream = std::make_shared<Stream>();
+    stream->info.id = open.stream_id;
+    stream->info.file_size = open.file_size;
+    stream->info.chunk_size = open.chunk_size;
+    stream->info.session_id = std::string(open.session_id);
+    stream->info.file_name = std::string(open.file_name);
+    stream->info.file_hash = std::string(open.file_hash);
+    stream->sha1 = open.file_hash.size() == Sha1::kDigestSize * 2;
+    stream->part_path = (fs::u8path(output_dir_) / (stream->info.file_hash + ".part")).u8string();
+
+    std::vector<PendingChunk> early;
+    size_t early_bytes = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (streams_.count(open.stream_id) || finished_.count(open.stream_id)) return ChunkAssemblyResult::Duplicate;
+
+        // Another stream is already fetching this content: drop this one and
+        // everything it sends
+        bool in_flight = std::any_of(streams_.begin(), streams_.end(),
+                                     [&](const auto& entry) { return entry.second->info.file_hash == open.file_hash; });
+        if (!in_flight && registry_) {
+            // A hash this peer was refused before keeps its waiter id, so the
+            // stream re-requested after a promotion claims it as the owner
+            PruneWaitingLocked();
+            auto waiting = waiting_.find(stream->info.file_hash);
+            stream->registry_owner = waiting != waiting_.end() ? waiting->second : registry_->NewWaiterId();
+            in_flight = registry_->Claim(stream->info.file_hash, stream->registry_owner) != InflightClaim::Owner;
+            if (in_flight) {
+                waiting_[stream->info.file_hash] = stream->registry_owner;
+            } else if (waiting != waiting_.end()) {
+                waiting_.erase(waiting);
+            }
+        }
+        if (in_flight) {
+            DropPendingLocked(open.stream_id);
+            MarkFinished(open.stream_id);
+            return ChunkAssemblyResult::DuplicateContent;
+        }
+
+        stream->file = PositionalFile::Create(stream->part_path, open.file_size);
+        if (!stream->file) {
+            if (registry_) registry_->Release(stream->info.file_hash, stream->registry_owner);
+            return ChunkAssemblyResult::Rejected;
+        }
+        streams_.emplace(open.stream_id, stream);
+        auto it = pending_.find(open.stream_id);
+        if (it != pending_.end()) {
+            early = std::move(it->second);
+            pending_.erase(it);
+            for (const auto& chunk : early) early_bytes += chunk.payload.size();
+            pending_bytes_ -= early_bytes;
+        }
+    }
+
+    auto result = ChunkAssemblyResult::Written;
+    if (open.file_size == 0) {
+        Finish(stream);
+        result = ChunkAssemblyResult::Completed;
+    }
+    for (const auto& chunk : early) {
+        if (Write(stream, chunk.offset, chunk.payload.data(), chunk.payload.size()) == ChunkAssemblyResult::Completed) {
+            result = ChunkAssemblyResult::Completed;
+        }
+    }
+    // The held chunks stay charged until they are on disk
+    if (budget_ && early_bytes) budget_->Release(budget_peer_, early_bytes);
+    return result;
+}
+
+ChunkAssemblyResult ChunkAssembler::Write(const std::shared_ptr<Stream>& stream, uint64_t offset, const uint8_t* data,
+                                          size_t length) {
+    {
+        std::lock_guard<std::mutex> lock(stream->mutex);
+        const uint64_t size = stream->info.file_size;
+        if (stream->failed || offset > size || length > size - offset) return ChunkAssemblyResult::Rejected;
+        if (stream->received.Contains(offset, offset + length)) return ChunkAssemblyResult::Duplicate;
+        if (!stream->file->WriteAt(offset, data, length)) {
+            stream->failed = true;
+            return ChunkAssemblyResult::Rejected;
+        }
+        stream->received.Add(offset, offset + length);
+        AdvanceHash(*stream, data, offset, length);
+        if (stream->received.Covered() < size) return ChunkAssemblyResult::Written;
+    }
+    Finish(stream);
+    return ChunkAssemblyResult::Completed;
+}
+
+void ChunkAssembler::AdvanceHash(Stream& stream, const uint8_t* data, uint64_t offset, size_t length) {
+    // In-order arrival: hash straight from the frame
+    if (offset <= stream.hashed_through && stream.hashed_through < offset + length) {
+        size_t skip = static_cast<size_t>(stream.hashed_through - offset);
+        UpdateHash(stream, data + skip, length - skip);
+        stream.hashed_through = offset + length;
+    }
+    // A gap just closed: catch up on the chunks that were written ahead of it
+    const uint64_t run_end = stream.received.ContiguousFrom(stream.hashed_through);
+    std::vector<uint8_t> block;
+    while (stream.hashed_through < run_end) {
+        size_t chunk = static_cast<size_t>(std::min<uint64_t>(kHashReadBlock, run_end - stream.hashed_through));
+        block.resize(chunk);
+        if (!stream.file->ReadAt(stream.hashed_through, block.data(), chunk)) {
+            stream.failed = true;
+            return;
+        }
+        UpdateHash(stream, block.data(), chunk);
+        stream.hashed_through += chunk;
+    }
+}
+
+void ChunkAssembler::UpdateHash(Stream& stream, const uint8_t* data, size_t length) {
+    if (stream.sha1) {
+        stream.sha1_hash.Update(data, length);
+    } else {
+        stream.sha256_hash.Update(data, length);
+    }
+}
+
+void ChunkAssembler::Finish(const std::shared_ptr<Stream>& stream) {
+    CompletedChunkFile completed;
+    {
+        std::lock_guard<std::mutex> lock(stream->mutex);
+        uint8_t digest[Sha256::kDigestSize];
+        size_t digest_size = Sha256::kDigestSize;
+        if (stream->sha1) {
+            stream->sha1_hash.Final(digest);
+            digest_size = Sha1::kDigestSize;
+        } else {
+            stream->sha256_hash.Final(digest);
+        }
+        completed.verified = !stream->failed && stream->hashed_through == stream->info.file_size &&
+                             SameHex(digest, digest_size, stream->info.file_hash);
+        stream->file.reset();
+
+        std::error_code error;
+        auto part = fs::u8path(stream->part_path);
+        auto final_path = fs::u8path(output_dir_) / stream->info.file_hash;
+        if (completed.verified) {
+            fs::rename(part, final_path, error);
+            if (error) {
+                // Same content already landed from another stream
+                completed.verified = fs::exists(final_path);
+                fs::remove(part, error);
+            }
+            completed.path = final_path.u8string();
+        } else {
+            fs::remove(part, error);
+            completed.path = stream->part_path;
+        }
+        completed.stream_id = stream->info.id;
+        completed.session_id = stream->info.session_id;
+        completed.file_name = stream->info.file_name;
+        completed.file_hash = stream->info.file_hash;
+    }
+
+    if (registry_) registry_->Complete(completed.file_hash, stream->registry_owner, completed.verified, completed.path);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    streams_.erase(completed.stream_id);
+    MarkFinished(completed.stream_id);
+    completed_.push_back(std::move(completed));
+}
+
+void ChunkAssembler::DropPendingLocked(uint64_t stream_id) {
+    auto it = pending_.find(stream_id);
+    if (it == pending_.end()) return;
+    size_t bytes = 0;
+    for (const auto& chunk : it->second) bytes += chunk.payload.size();
+    pending_bytes_ -= bytes;
+    if (budget_) budget_->Release(budget_peer_, bytes);
+    pending_.erase(it);
+}
+
+void ChunkAssembler::MarkFinished(uint64_t stream_id) {
+    finished_.insert(stream_id);
+    finished_order_.push_back(stream_id);
+    if (finished_order_.size() > kFinishedMemory) {
+        finished_.erase(finished_order_.front());
+        finished_order_.pop_front();
+    }
+}
+
+bool ChunkAssembler::Abort(uint64_t stream_id) {
+    std::shared_ptr<Stream> stream;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        DropPendingLocked(stream_id);
+        auto it = streams_.find(stream_id);
+        if (it != streams_.end()) {
+            stream = std::move(it->second);
+            streams_.erase(it);
+        }
+        if (!finished_.count(stream_id)) MarkFinished(stream_id);
+    }
+    if (!stream) return false;
+
+    {
+        std::lock_guard<std::mutex> lock(stream->mutex);
+        stream->failed = true;
+        stream->file.reset();
+        std::error_code error;
+        fs::remove(fs::u8path(stream->part_path), error);
+    }
+    if (registry_) registry_->Release(stream->info.file_hash, stream->registry_owner);
+    return true;
+}
+
+uint64_t ChunkAssembler::WaiterFor(const std::string& file_hash) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = waiting_.find(file_hash);
+    return it != waiting_.end() ? it->second : 0;
+}
+
+// Forgets hashes whose download has finished; their waiters were notified
+void ChunkAssembler::PruneWaitingLocked() {
+    for (auto it = waiting_.begin(); it != waiting_.end();) {
+        it = registry_->IsInflight(it->first) ? std::next(it) : waiting_.erase(it);
+    }
+}
+
+bool ChunkAssembler::PopCompleted(CompletedChunkFile& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (completed_.empty()) return false;
+    out = std::move(completed_.front());
+    completed_.pop_front();
+    return true;
+}
+
+void ChunkAssembler::SetMemoryBudget(MemoryBudget* budget, uint64_t peer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    budget_ = budget;
+    budget_peer_ = peer;
+}
+
+size_t ChunkAssembler::OpenStreams() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return streams_.size();
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// C exports for the plugin
+// ---------------------------------------------------------------------------
+
+extern "C" {
+
+// registry (from CreateInflightRegistry) may be null; share one across every
+// peer's assembler to deduplicate content between peers
+__declspec(dllexport) void* CreateChunkAssembler(const char* output_dir, int max_pending_bytes, void* registry) {
+    if (!output_dir) return nullptr;
+    size_t pending = max_pending_bytes > 0 ? static_cast<size_t>(max_pending_bytes) : 16 * 1024 * 1024;
+    return new fyteclub::ChunkAssembler(output_dir, pending, static_cast<fyteclub::InflightRegistry*>(registry));
+}
+
+// Returns a ChunkAssemblyResult value, or -1 for a frame that does not parse
+__declspec(dllexport) int ChunkAssemblerOnFrame(void* assembler, const uint8_t* frame, int size) {
+    if (!assembler || !frame || size < 0) return -1;
+    fyteclub::ParsedChunkFrame parsed;
+    if (fyteclub::ParseChunkFrame(frame, static_cast<size_t>(size), parsed) != fyteclub::ChunkFrameStatus::Ok) return -1;
+    return static_cast<int>(static_cast<fyteclub::ChunkAssembler*>(assembler)->OnFrame(parsed));
+}
+
+// Returns 1 and fills the outputs when a file finished, 0 when none is waiting.
+// path receives the UTF-8 path, truncated to path_capacity - 1 bytes.
+__declspec(dllexport) int ChunkAssemblerPopCompleted(void* assembler, uint64_t* stream_id, int* verified, char* path,
+                                                     int path_capacity) {
+    if (!assembler) return 0;
+    fyteclub::CompletedChunkFile completed;
+    if (!static_cast<fyteclub::ChunkAssembler*>(assembler)->PopCompleted(completed)) return 0;
+    if (stream_id) *stream_id = completed.stream_id;
+    if (verified) *verified = completed.verified ? 1 : 0;
+    fyteclub::CopyString(completed.path, path, path_capacity);
+    return 1;
+}
+
+// budget comes from CreateMemoryBudget; peer is the plugin's handle for the
+// connection this assembler serves
+__declspec(dllexport) void ChunkAssemblerSetMemoryBudget(void* assembler, void* budget, uint64_t peer) {
+    if (assembler) {
+        static_cast<fyteclub::ChunkAssembler*>(assembler)->SetMemoryBudget(static_cast<fyteclub::MemoryBudget*>(budget),
+                                                                           peer);
+    }
+}
+
+// Registry waiter id for a stream refused with DuplicateContent (5), or 0.
+// Watch InflightPopNotification for it: Completed hands over the file, and
+// Promoted means the other download failed, so request the content from this
+// peer again; its OPEN is then accepted as the owner.
+__declspec(dllexport) uint64_t ChunkAssemblerWaiter(void* assembler, const char* file_hash) {
+    if (!assembler || !file_hash) return 0;
+    return static_cast<fyteclub::ChunkAssembler*>(assembler)->WaiterFor(file_hash);
+}
+
+// 1 = the stream was open and has been dropped, 0 otherwise
+__declspec(dllexport) int ChunkAssemblerAbort(void* assembler, uint64_t stream_id) {
+    return assembler && static_cast<fyteclub::ChunkAssembler*>(assembler)->Abort(stream_id) ? 1 : 0;
+}
+
+__declspec(dllexport) void DestroyChunkAssembler(void* assembler) {
+    delete static_cast<fyteclub::ChunkAssembler*>(assembler);
+}
+
+}
@@ -0,0 +1,158 @@
+#pragma once
+#include "chunk_frame.h"
+#include "inflight_registry.h"
+#include "memory_budget.h"
+#include "sha1.h"
+#include "sha256.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Receiver for chunk streams on unordered data channels. On an ordered
+// channel one retransmitted chunk holds back every chunk behind it; DATA
+// frames already carry their file offset, so with unordered delivery each
+// chunk is written straight to its place in the file as it arrives, whatever
+// the order, and duplicates from retransmission are ignored.
+//
+// The file is hashed as its in-order prefix grows: chunks that arrive in
+// order are hashed from the frame, and gaps filled later are read back from
+// disk. It is written to <dir>/<hash>.part and renamed to <dir>/<hash> once
+// the digest matches: a 40-hex hash is SHA-1 (the plugin's FileReplacements
+// hashes), a 64-hex one SHA-256. DATA that overtakes its OPEN frame is held (bounded)
+// until the OPEN arrives.
+//
+// Only one stream per content hash is assembled at a time. With an
+// InflightRegistry the check spans every peer's assembler: an OPEN for a hash
+// already being downloaded is refused with DuplicateContent, so the caller
+// can cancel that stream. The refused stream is attached to the registry as
+// a waiter (see WaiterFor): it is told when the download finishes, or
+// promoted to fetch the content itself if the download fails.
+
+namespace fyteclub {
+
+// Merged set of [begin, end) byte ranges
+class ByteRangeSet {
+public:
+    // Returns the number of bytes not already covered
+    uint64_t Add(uint64_t begin, uint64_t end);
+    bool Contains(uint64_t begin, uint64_t end) const;
+    // End of the covered run starting at offset (offset itself if uncovered)
+    uint64_t ContiguousFrom(uint64_t offset) const;
+    uint64_t Covered() const { return covered_; }
+    size_t RangeCount() const { return ranges_.size(); }
+    const std::map<uint64_t, uint64_t>& Ranges() const { return ranges_; }
+
+private:
+    std::map<uint64_t, uint64_t> ranges_; // begin -> end
+    uint64_t covered_ = 0;
+};
+
+// File written and read at explicit offsets; safe for concurrent use on
+// disjoint ranges
+class PositionalFile {
+public:
+    // Creates (truncating) the file and sets its size up front
+    static std::unique_ptr<PositionalFile> Create(const std::string& path, uint64_t size);
+    ~PositionalFile();
+    PositionalFile(const PositionalFile&) = delete;
+    PositionalFile& operator=(const PositionalFile&) = delete;
+
+    bool WriteAt(uint64_t offset, const uint8_t* data, size_t length);
+    bool ReadAt(uint64_t offset, uint8_t* data, size_t length);
+
+private:
+    explicit PositionalFile(intptr_t handle) : handle_(handle) {}
+    intptr_t handle_;
+};
+
+enum class ChunkAssemblyResult {
+    Written,          // new bytes stored
+    Duplicate,        // already had every byte (or the stream already finished)
+    Completed,        // this chunk finished the file; see PopCompleted
+    Pending,          // held until the stream's OPEN frame arrives
+    Rejected,         // out of range, pending limit hit or I/O error
+    DuplicateContent, // OPEN for a hash already in flight; cancel the stream
+};
+
+struct CompletedChunkFile {
+    uint64_t stream_id = 0;
+    std::string session_id;
+    std::string file_name;
+    std::string file_hash;
+    std::string path;      // final path, or the removed .part path when not verified
+    bool verified = false;
+};
+
+class ChunkAssembler {
+public:
+    explicit ChunkAssembler(std::string output_dir, size_t max_pending_bytes = 16 * 1024 * 1024,
+                            InflightRegistry* registry = nullptr);
+    ~ChunkAssembler();
+
+    // Thread-safe; every channel of a peer feeds the same assembler
+    ChunkAssemblyResult OnFrame(const ParsedChunkFrame& frame);
+    bool PopCompleted(CompletedChunkFile& out);
+    // Drops a stream the caller has cancelled: its .part file is removed and
+    // any frames still arriving for it are ignored. False if it was not open.
+    bool Abort(uint64_t stream_id);
+    size_t OpenStreams() const;
+    // Registry waiter id standing in for streams refused with
+    // DuplicateContent for this hash, 0 if none is waiting
+    uint64_t WaiterFor(const std::string& file_hash) const;
+    // Charges held DATA to peer in a budget shared with other peers, on top
+    // of max_pending_bytes. Call before the first frame arrives.
+    void SetMemoryBudget(MemoryBudget* budget, uint64_t peer);
+
+private:
+    struct Stream {
+        std::mutex mutex;
+        ChunkStream info;
+        std::unique_ptr<PositionalFile> file;
+        std::string part_path;
+        ByteRangeSet received;
+        bool sha1 = false; // digest picked from the hash length at OPEN
+        Sha1 sha1_hash;
+        Sha256 sha256_hash;
+        uint64_t hashed_through = 0;
+        uint64_t registry_owner = 0;
+        bool failed = false;
+    };
+
+    struct PendingChunk {
+        uint64_t offset;
+        std::vector<uint8_t> payload;
+    };
+
+    ChunkAssemblyResult Open(const ChunkStreamOpen& open);
+    ChunkAssemblyResult Write(const std::shared_ptr<Stream>& stream, uint64_t offset, const uint8_t* data, size_t length);
+    void AdvanceHash(Stream& stream, const uint8_t* data, uint64_t offset, size_t length);
+    static void UpdateHash(Stream& stream, const uint8_t* data, size_t length);
+    void Finish(const std::shared_ptr<Stream>& stream);
+    void MarkFinished(uint64_t stream_id);
+    void DropPendingLocked(uint64_t stream_id);
+    void PruneWaitingLocked();
+
+    std::string output_dir_;
+    size_t max_pending_bytes_;
+    InflightRegistry* registry_;
+    MemoryBudget* budget_ = nullptr;
+    uint64_t budget_peer_ = 0;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, std::shared_ptr<Stream>> streams_;
+    std::unordered_map<uint64_t, std::vector<PendingChunk>> pending_;
+    size_t pending_bytes_ = 0;
+    std::unordered_set<uint64_t> finished_;
+    std::deque<uint64_t> finished_order_;
+    std::deque<CompletedChunkFile> completed_;
+    std::unordered_map<std::string, uint64_t> waiting_; // refused hash -> registry waiter id
+};
+
+}
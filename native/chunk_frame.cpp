@@ -0,0 +1,267 @@
+#include "chunk_frame.h"
+#include "crc32c.h"
+#include "frame_util.h"
+#include "wire_codec.h"
+#include <cstring>
+
+namespace fyteclub {
+
+using wire::ReadVarint;
+using wire::VarintSize;
+using wire::WriteVarint;
+
+namespace {
+
+size_t StringSize(std::string_view value) {
+    return VarintSize(value.size()) + value.size();
+}
+
+uint8_t* WriteString(uint8_t* out, std::string_view value) {
+    out = WriteVarint(out, value.size());
+    if (!value.empty()) memcpy(out, value.data(), value.size());
+    return out + value.size();
+}
+
+bool ReadString(const uint8_t*& p, const uint8_t* end, std::string_view& value) {
+    uint64_t length;
+    if (!ReadVarint(p, end, length) || length > static_cast<uint64_t>(end - p)) return false;
+    value = std::string_view(reinterpret_cast<const char*>(p), static_cast<size_t>(length));
+    p += length;
+    return true;
+}
+
+}
+
+bool IsChunkFrame(const uint8_t* frame, size_t size) {
+    return size > kChunkFrameTrailerSize &&
+           (frame[0] == static_cast<uint8_t>(ChunkFrameType::Open) || frame[0] == static_cast<uint8_t>(ChunkFrameType::Data));
+}
+
+size_t ChunkOpenFrameSize(const ChunkStreamOpen& open) {
+    return 1 + VarintSize(open.stream_id) + VarintSize(open.file_size) + VarintSize(open.chunk_size) +
+           StringSize(open.session_id) + StringSize(open.file_name) + StringSize(open.file_hash) + kChunkFrameTrailerSize;
+}
+
+size_t ChunkDataHeaderSize(uint64_t stream_id, uint64_t offset) {
+    return 1 + VarintSize(stream_id) + VarintSize(offset);
+}
+
+size_t ChunkDataFrameSize(uint64_t stream_id, uint64_t offset, size_t length) {
+    return ChunkDataHeaderSize(stream_id, offset) + length + kChunkFrameTrailerSize;
+}
+
+size_t WriteChunkOpenFrame(const ChunkStreamOpen& open, uint8_t* out, size_t capacity) {
+    const size_t size = ChunkOpenFrameSize(open);
+    if (size > capacity) return 0;
+    uint8_t* p = out;
+    *p++ = static_cast<uint8_t>(ChunkFrameType::Open);
+    p = WriteVarint(p, open.stream_id);
+    p = WriteVarint(p, open.file_size);
+    p = WriteVarint(p, open.chunk_size);
+    p = WriteString(p, open.session_id);
+    p = WriteString(p, open.file_name);
+    p = WriteString(p, open.file_hash);
+    return SealChunkFrame(out, static_cast<size_t>(p - out));
+}
+
+size_t WriteChunkDataHeader(uint64_t stream_id, uint64_t offset, uint8_t* out) {
+    uint8_t* p = out;
+    *p++ = static_cast<uint8_t>(ChunkFrameType::Data);
+    p = WriteVarint(p, stream_id);
+    p = WriteVarint(p, offset);
+    return static_cast<size_t>(p - out);
+}
+
+size_t WriteChunkDataFrame(const ChunkData& data, uint8_t* out, size_t capacity) {
+    if (ChunkDataFrameSize(data.stream_id, data.offset, data.length) > capacity) return 0;
+    size_t header = WriteChunkDataHeader(data.stream_id, data.offset, out);
+    if (data.length > 0) memcpy(out + header, data.payload, data.length);
+    return SealChunkFrame(out, header + data.length);
+}
+
+size_t SealChunkFrame(uint8_t* frame, size_t length) {
+    StoreLe32(frame + length, Crc32c(frame, length));
+    return length + kChunkFrameTrailerSize;
+}
+
+ChunkFrameStatus ParseChunkFrame(const uint8_t* frame, size_t size, ParsedChunkFrame& out) {
+    if (size < 1 + kChunkFrameTrailerSize) return ChunkFrameStatus::Truncated;
+    const uint8_t type = frame[0];
+    if (type != static_cast<uint8_t>(ChunkFrameType::Open) && type != static_cast<uint8_t>(ChunkFrameType::Data)) {
+        return ChunkFrameStatus::UnknownType;
+    }
+
+    const size_t body_size = size - kChunkFrameTrailerSize;
+    if (Crc32c(frame, body_size) != LoadLe32(frame + body_size)) return ChunkFrameStatus::BadChecksum;
+
+    const uint8_t* p = frame + 1;
+    const uint8_t* end = frame + body_size;
+    out.type = static_cast<ChunkFrameType>(type);
+    if (out.type == ChunkFrameType::Open) {
+        uint64_t chunk_size;
+        if (!ReadVarint(p, end, out.open.stream_id) || !ReadVarint(p, end, out.open.file_size) ||
+            !ReadVarint(p, end, chunk_size) || chunk_size > UINT32_MAX || !ReadString(p, end, out.open.session_id) ||
+            !ReadString(p, end, out.open.file_name) || !ReadString(p, end, out.open.file_hash)) {
+            return ChunkFrameStatus::Truncated;
+        }
+        out.open.chunk_size = static_cast<uint32_t>(chunk_size);
+        return ChunkFrameStatus::Ok;
+    }
+
+    if (!ReadVarint(p, end, out.data.stream_id) || !ReadVarint(p, end, out.data.offset)) {
+        return ChunkFrameStatus::Truncated;
+    }
+    out.data.payload = p;
+    out.data.length = static_cast<size_t>(end - p);
+    return ChunkFrameStatus::Ok;
+}
+
+ChunkStreamOpen ChunkStream::View() const {
+    ChunkStreamOpen open;
+    open.stream_id = id;
+    open.file_size = file_size;
+    open.chunk_size = chunk_size;
+    open.session_id = session_id;
+    open.file_name = file_name;
+    open.file_hash = file_hash;
+    return open;
+}
+
+std::shared_ptr<const ChunkStream> ChunkStreamTable::Open(std::string session_id, std::string file_name,
+                                                          std::string file_hash, uint64_t file_size,
+                                                          uint32_t chunk_size) {
+    auto stream = std::make_shared<ChunkStream>();
+    stream->file_size = file_size;
+    stream->chunk_size = chunk_size;
+    stream->session_id = std::move(session_id);
+    stream->file_name = std::move(file_name);
+    stream->file_hash = std::move(file_hash);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stream->id = next_id_++;
+    streams_[stream->id] = stream;
+    return stream;
+}
+
+bool ChunkStreamTable::Register(const ChunkStreamOpen& open) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = streams_.find(open.stream_id);
+    if (it != streams_.end()) {
+        // A resent OPEN (reconnect, duplicate delivery) is fine if it matches
+        const ChunkStream& existing = *it->second;
+        return existing.file_size == open.file_size && existing.file_hash == open.file_hash &&
+               existing.session_id == open.session_id;
+    }
+
+    auto stream = std::make_shared<ChunkStream>();
+    stream->id = open.stream_id;
+    stream->file_size = open.file_size;
+    stream->chunk_size = open.chunk_size;
+    stream->session_id = std::string(open.session_id);
+    stream->file_name = std::string(open.file_name);
+    stream->file_hash = std::string(open.file_hash);
+    streams_[stream->id] = std::move(stream);
+    return true;
+}
+
+std::shared_ptr<const ChunkStream> ChunkStreamTable::Find(uint64_t stream_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = streams_.find(stream_id);
+    return it == streams_.end() ? nullptr : it->second;
+}
+
+void ChunkStreamTable::Close(uint64_t stream_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    streams_.erase(stream_id);
+}
+
+size_t ChunkStreamTable::Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return streams_.size();
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// C exports for the plugin
+// ---------------------------------------------------------------------------
+
+extern "C" {
+
+// Flat view of a parsed frame; string and payload fields are offsets into the
+// caller's buffer so nothing is allocated across the boundary
+struct ChunkFrameInfo {
+    int32_t type;
+    uint32_t chunk_size;
+    uint64_t stream_id;
+    uint64_t offset;    // DATA: payload offset within the file; OPEN: file size
+    int32_t payload_start;
+    int32_t payload_length;
+    int32_t session_start;
+    int32_t session_length;
+    int32_t name_start;
+    int32_t name_length;
+    int32_t hash_start;
+    int32_t hash_length;
+};
+
+__declspec(dllexport) uint32_t ComputeCrc32c(const uint8_t* data, int length, uint32_t crc) {
+    if (!data || length < 0) return crc;
+    return fyteclub::Crc32c(data, static_cast<size_t>(length), crc);
+}
+
+__declspec(dllexport) int EncodeChunkOpenFrame(uint64_t stream_id, uint64_t file_size, uint32_t chunk_size,
+                                               const char* session_id, const char* file_name, const char* file_hash,
+                                               uint8_t* out, int capacity) {
+    if (!out || capacity < 0 || !session_id || !file_name || !file_hash) return -1;
+    fyteclub::ChunkStreamOpen open;
+    open.stream_id = stream_id;
+    open.file_size = file_size;
+    open.chunk_size = chunk_size;
+    open.session_id = session_id;
+    open.file_name = file_name;
+    open.file_hash = file_hash;
+    return static_cast<int>(fyteclub::WriteChunkOpenFrame(open, out, static_cast<size_t>(capacity)));
+}
+
+__declspec(dllexport) int EncodeChunkDataFrame(uint64_t stream_id, uint64_t offset, const uint8_t* payload,
+                                               int length, uint8_t* out, int capacity) {
+    if (!out || capacity < 0 || length < 0 || (!payload && length > 0)) return -1;
+    fyteclub::ChunkData data;
+    data.stream_id = stream_id;
+    data.offset = offset;
+    data.payload = payload;
+    data.length = static_cast<size_t>(length);
+    return static_cast<int>(fyteclub::WriteChunkDataFrame(data, out, static_cast<size_t>(capacity)));
+}
+
+// Returns a ChunkFrameStatus value (0 = ok)
+__declspec(dllexport) int DecodeChunkFrame(const uint8_t* frame, int size, ChunkFrameInfo* info) {
+    if (!frame || size < 0 || !info) return -1;
+    fyteclub::ParsedChunkFrame parsed;
+    auto status = fyteclub::ParseChunkFrame(frame, static_cast<size_t>(size), parsed);
+    if (status != fyteclub::ChunkFrameStatus::Ok) return static_cast<int>(status);
+
+    auto start = [frame](const void* p) { return static_cast<int32_t>(static_cast<const uint8_t*>(p) - frame); };
+    *info = ChunkFrameInfo{};
+    info->type = static_cast<int32_t>(parsed.type);
+    if (parsed.type == fyteclub::ChunkFrameType::Open) {
+        info->stream_id = parsed.open.stream_id;
+        info->offset = parsed.open.file_size;
+        info->chunk_size = parsed.open.chunk_size;
+        info->session_start = start(parsed.open.session_id.data());
+        info->session_length = static_cast<int32_t>(parsed.open.session_id.size());
+        info->name_start = start(parsed.open.file_name.data());
+        info->name_length = static_cast<int32_t>(parsed.open.file_name.size());
+        info->hash_start = start(parsed.open.file_hash.data());
+        info->hash_length = static_cast<int32_t>(parsed.open.file_hash.size());
+    } else {
+        info->stream_id = parsed.data.stream_id;
+        info->offset = parsed.data.offset;
+        info->payload_start = start(parsed.data.payload);
+        info->payload_length = static_cast<int32_t>(parsed.data.length);
+    }
+    return 0;
+}
+
+}
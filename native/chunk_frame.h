@@ -0,0 +1,113 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Compact bulk-transfer frames, replacing the FCHK chunk layout from
+// SmartTransferOrchestrator.SerializeFileChunkToBinary. FCHK repeats the
+// session GUID, file name and hash in every 128KB chunk; here they travel once
+// in an OPEN frame and each DATA frame carries only a varint stream id and the
+// byte offset of its payload. Every frame ends with a CRC-32C over the bytes
+// before it, so corruption is caught per chunk instead of at the final hash.
+//
+//   OPEN  C1 | stream id | file size | chunk size | session | name | hash | crc32c
+//   DATA  C2 | stream id | offset | payload | crc32c
+//
+// Integers are LEB128 varints, strings are varint length + UTF-8, the CRC is
+// 4 bytes little-endian. A frame is one data channel message, so DATA needs no
+// length field. The type bytes do not collide with the 0/1/2 P2PModProtocol
+// flags, '{' or the FCHK magic, so both formats can share a channel.
+
+namespace fyteclub {
+
+enum class ChunkFrameType : uint8_t {
+    Open = 0xC1,
+    Data = 0xC2,
+};
+
+enum class ChunkFrameStatus {
+    Ok,
+    Truncated,
+    BadChecksum,
+    UnknownType,
+};
+
+struct ChunkStreamOpen {
+    uint64_t stream_id = 0;
+    uint64_t file_size = 0;
+    uint32_t chunk_size = 0;
+    std::string_view session_id;
+    std::string_view file_name;
+    std::string_view file_hash;
+};
+
+struct ChunkData {
+    uint64_t stream_id = 0;
+    uint64_t offset = 0;
+    const uint8_t* payload = nullptr;
+    size_t length = 0;
+};
+
+struct ParsedChunkFrame {
+    ChunkFrameType type = ChunkFrameType::Data;
+    ChunkStreamOpen open; // type == Open; views into the frame
+    ChunkData data;       // type == Data; payload points into the frame
+};
+
+constexpr size_t kChunkFrameTrailerSize = 4;
+constexpr size_t kMaxChunkDataHeaderSize = 1 + 10 + 10;
+
+bool IsChunkFrame(const uint8_t* frame, size_t size);
+
+size_t ChunkOpenFrameSize(const ChunkStreamOpen& open);
+size_t ChunkDataHeaderSize(uint64_t stream_id, uint64_t offset);
+size_t ChunkDataFrameSize(uint64_t stream_id, uint64_t offset, size_t length);
+
+// Return the frame size, or 0 when capacity is too small
+size_t WriteChunkOpenFrame(const ChunkStreamOpen& open, uint8_t* out, size_t capacity);
+size_t WriteChunkDataFrame(const ChunkData& data, uint8_t* out, size_t capacity);
+
+// Zero-copy send path: write the DATA header, read the file straight into the
+// buffer after it, then seal. out needs kMaxChunkDataHeaderSize bytes.
+size_t WriteChunkDataHeader(uint64_t stream_id, uint64_t offset, uint8_t* out);
+// Appends the CRC to a frame of length bytes and returns the sealed size;
+// the buffer needs kChunkFrameTrailerSize spare bytes
+size_t SealChunkFrame(uint8_t* frame, size_t length);
+
+ChunkFrameStatus ParseChunkFrame(const uint8_t* frame, size_t size, ParsedChunkFrame& out);
+
+struct ChunkStream {
+    uint64_t id = 0;
+    uint64_t file_size = 0;
+    uint32_t chunk_size = 0;
+    std::string session_id;
+    std::string file_name;
+    std::string file_hash;
+
+    ChunkStreamOpen View() const;
+};
+
+// Stream id <-> file metadata for one peer connection. The sender allocates
+// ids with Open; the receiver records OPEN frames with Register and looks up
+// each DATA frame's stream. Thread-safe, channels can share one table.
+class ChunkStreamTable {
+public:
+    std::shared_ptr<const ChunkStream> Open(std::string session_id, std::string file_name, std::string file_hash,
+                                            uint64_t file_size, uint32_t chunk_size);
+    // Returns false if the id is already registered with different metadata
+    bool Register(const ChunkStreamOpen& open);
+    std::shared_ptr<const ChunkStream> Find(uint64_t stream_id) const;
+    void Close(uint64_t stream_id);
+    size_t Size() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, std::shared_ptr<const ChunkStream>> streams_;
+    uint64_t next_id_ = 1;
+};
+
+}
@@ -0,0 +1,521 @@
+#include "component_pipeline.h"
+#include "frame_util.h"
+#include "wire_codec.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace fyteclub {
+
+using wire::ReadVarint;
+
+namespace {
+
+// Hashes are hex; compare and deduplicate them case-insensitively
+std::string NormalizeHash(std::string_view hash) {
+    std::string out(hash);
+    for (char& c : out) c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+    return out;
+}
+
+}
+
+std::vector<uint8_t> WriteComponentFrame(const ComponentControl& control) {
+    std::vector<uint8_t> frame = {kComponentFrameType, static_cast<uint8_t>(control.kind)};
+    AppendVarint(frame, control.request_id);
+    if (control.kind == ComponentFrameKind::Request) {
+        AppendVarint(frame, control.hash.size());
+        frame.insert(frame.end(), control.hash.begin(), control.hash.end());
+    }
+    SealFrame(frame);
+    return frame;
+}
+
+bool ParseComponentFrame(const uint8_t* frame, size_t size, ComponentControl& out) {
+    if (!frame || size < 2 + kFrameTrailerSize || frame[0] != kComponentFrameType) return false;
+    const uint8_t* end = frame + size - kFrameTrailerSize;
+    if (!FrameTrailerMatches(frame, size)) return false;
+    if (frame[1] > static_cast<uint8_t>(ComponentFrameKind::Cancel)) return false;
+
+    out.kind = static_cast<ComponentFrameKind>(frame[1]);
+    const uint8_t* p = frame + 2;
+    if (!ReadVarint(p, end, out.request_id)) return false;
+    out.hash.clear();
+    if (out.kind == ComponentFrameKind::Request) {
+        uint64_t length;
+        if (!ReadVarint(p, end, length) || length == 0 || length > kMaxComponentHashLength ||
+            length > static_cast<uint64_t>(end - p)) {
+            return false;
+        }
+        out.hash.assign(reinterpret_cast<const char*>(p), static_cast<size_t>(length));
+        p += length;
+    }
+    return p == end;
+}
+
+// ---------------------------------------------------------------------------
+// ComponentFetcher
+// ---------------------------------------------------------------------------
+
+ComponentFetcher::ComponentFetcher(std::string output_dir, size_t window)
+    : assembler_(std::move(output_dir)), window_(std::max<size_t>(window, 1)) {}
+
+uint64_t ComponentFetcher::Request(const std::string& hash) {
+    if (hash.empty() || hash.size() > kMaxComponentHashLength) return 0;
+    std::string key = NormalizeHash(hash);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto existing = by_hash_.find(key);
+    if (existing != by_hash_.end()) return existing->second;
+
+    uint64_t id = next_id_++;
+    requests_.emplace(id, Pending{key, false});
+    by_hash_.emplace(std::move(key), id);
+    queued_.push_back(id);
+    return id;
+}
+
+bool ComponentFetcher::Cancel(uint64_t request_id) {
+    bool sent;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = requests_.find(request_id);
+        if (it == requests_.end()) return false;
+        sent = it->second.sent;
+        by_hash_.erase(it->second.hash);
+        requests_.erase(it);
+        if (sent) {
+            --in_flight_;
+            cancels_.push_back(request_id);
+        }
+    }
+    // Frames for the id still in transit are dropped by the assembler
+    if (sent) assembler_.Abort(request_id);
+    return true;
+}
+
+bool ComponentFetcher::PopFrame(std::vector<uint8_t>& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!cancels_.empty()) {
+        out = WriteComponentFrame({ComponentFrameKind::Cancel, cancels_.front(), {}});
+        cancels_.pop_front();
+        return true;
+    }
+    while (in_flight_ < window_ && !queued_.empty()) {
+        uint64_t id = queued_.front();
+        queued_.pop_front();
+        auto it = requests_.find(id);
+        if (it == requests_.end()) continue; // cancelled while queued
+
+        it->second.sent = true;
+        ++in_flight_;
+        out = WriteComponentFrame({ComponentFrameKind::Request, id, it->second.hash});
+        return true;
+    }
+    return false;
+}
+
+ComponentFrameResult ComponentFetcher::OnFrame(const uint8_t* frame, size_t size) {
+    if (!frame || size == 0) return ComponentFrameResult::Invalid;
+
+    if (frame[0] == kComponentFrameType) {
+        ComponentControl control;
+        if (!ParseComponentFrame(frame, size, control) || control.kind != ComponentFrameKind::Missing) {
+            return ComponentFrameResult::Invalid;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = requests_.find(control.request_id);
+            if (it == requests_.end() || !it->second.sent) return ComponentFrameResult::Ignored;
+            FinishLocked(control.request_id, ComponentStatus::Missing, {});
+        }
+        // The server may have failed partway through a stream it had opened
+        assembler_.Abort(control.request_id);
+        return ComponentFrameResult::Accepted;
+    }
+
+    if (!IsChunkFrame(frame, size)) return ComponentFrameResult::NotComponent;
+    ParsedChunkFrame parsed;
+    if (ParseChunkFrame(frame, size, parsed) != ChunkFrameStatus::Ok) return ComponentFrameResult::Invalid;
+    const uint64_t id = parsed.type == ChunkFrameType::Open ? parsed.open.stream_id : parsed.data.stream_id;
+    if (!IsComponentStream(id)) return ComponentFrameResult::NotComponent;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = requests_.find(id);
+        if (it == requests_.end() || !it->second.sent) return ComponentFrameResult::Ignored;
+        if (parsed.type == ChunkFrameType::Open && NormalizeHash(parsed.open.file_hash) != it->second.hash) {
+            FinishLocked(id, ComponentStatus::Failed, {});
+            cancels_.push_back(id);
+            return ComponentFrameResult::Invalid;
+        }
+    }
+
+    // Disk writes run outside the lock so every channel can feed chunks at
+    // once; a Cancel racing with this leaves the id finished in the assembler,
+    // which then drops the frame
+    auto result = assembler_.OnFrame(parsed);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (result == ChunkAssemblyResult::Rejected && parsed.type == ChunkFrameType::Open) {
+        if (requests_.count(id)) {
+            FinishLocked(id, ComponentStatus::Failed, {});
+            cancels_.push_back(id);
+        }
+        assembler_.Abort(id);
+        return ComponentFrameResult::Invalid;
+    }
+    DrainAssemblerLocked();
+    return result == ChunkAssemblyResult::Rejected ? ComponentFrameResult::Invalid : ComponentFrameResult::Accepted;
+}
+
+void ComponentFetcher::DrainAssemblerLocked() {
+    CompletedChunkFile file;
+    while (assembler_.PopCompleted(file)) {
+        if (!requests_.count(file.stream_id)) continue;
+        FinishLocked(file.stream_id, file.verified ? ComponentStatus::Completed : ComponentStatus::Failed,
+                     std::move(file.path));
+    }
+}
+
+void ComponentFetcher::FinishLocked(uint64_t request_id, ComponentStatus status, std::string path) {
+    auto it = requests_.find(request_id);
+    if (it == requests_.end()) return;
+    if (it->second.sent) --in_flight_;
+
+    ComponentCompletion completion;
+    completion.request_id = request_id;
+    completion.hash = std::move(it->second.hash);
+    completion.path = status == ComponentStatus::Completed ? std::move(path) : std::string();
+    completion.status = status;
+    by_hash_.erase(completion.hash);
+    requests_.erase(it);
+    completions_.push_back(std::move(completion));
+}
+
+bool ComponentFetcher::PopCompletion(ComponentCompletion& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (completions_.empty()) return false;
+    out = std::move(completions_.front());
+    completions_.pop_front();
+    return true;
+}
+
+void ComponentFetcher::SetWindow(size_t window) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    window_ = std::max<size_t>(window, 1);
+}
+
+size_t ComponentFetcher::InFlight() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_flight_;
+}
+
+size_t ComponentFetcher::Queued() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return requests_.size() - in_flight_;
+}
+
+// ---------------------------------------------------------------------------
+// ComponentServer
+// ---------------------------------------------------------------------------
+
+ComponentServer::ComponentServer(uint32_t chunk_size) : chunk_size_(std::max<uint32_t>(chunk_size, 1024)) {}
+
+ComponentServer::~ComponentServer() {
+    for (auto& stream : streams_) {
+        if (stream.file) fclose(stream.file);
+    }
+}
+
+bool ComponentServer::OnFrame(const uint8_t* frame, size_t size) {
+    ComponentControl control;
+    if (!ParseComponentFrame(frame, size, control)) return false;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    switch (control.kind) {
+    case ComponentFrameKind::Request:
+        if (!IsComponentStream(control.request_id) || requested_.count(control.request_id)) return false;
+        requested_.emplace(control.request_id, control.hash);
+        requests_.push_back({control.request_id, std::move(control.hash)});
+        return true;
+    case ComponentFrameKind::Cancel: {
+        requested_.erase(control.request_id);
+        auto it = std::find_if(streams_.begin(), streams_.end(),
+                               [&](const Stream& stream) { return stream.id == control.request_id; });
+        if (it != streams_.end()) CloseLocked(static_cast<size_t>(it - streams_.begin()));
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+bool ComponentServer::PopRequest(ComponentServeRequest& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Requests cancelled before the plugin got to them are skipped
+    while (!requests_.empty()) {
+        ComponentServeRequest request = std::move(requests_.front());
+        requests_.pop_front();
+        if (requested_.count(request.request_id)) {
+            out = std::move(request);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ComponentServer::Serve(uint64_t request_id, const std::string& path) {
+    std::error_code error;
+    uint64_t size = fs::file_size(fs::u8path(path), error);
+#ifdef _WIN32
+    FILE* file = error ? nullptr : _wfopen(fs::u8path(path).c_str(), L"rb");
+#else
+    FILE* file = error ? nullptr : fopen(path.c_str(), "rb");
+#endif
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = requested_.find(request_id);
+    if (it == requested_.end()) {
+        // Cancelled meanwhile
+        if (file) fclose(file);
+        return false;
+    }
+    if (!file) {
+        requested_.erase(it);
+        replies_.push_back(WriteComponentFrame({ComponentFrameKind::Missing, request_id, {}}));
+        return false;
+    }
+
+    Stream stream;
+    stream.id = request_id;
+    stream.hash = std::move(it->second);
+    stream.file = file;
+    stream.size = size;
+    streams_.push_back(std::move(stream));
+    requested_.erase(it);
+    return true;
+}
+
+void ComponentServer::Reject(uint64_t request_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (requested_.erase(request_id) == 0) return;
+    replies_.push_back(WriteComponentFrame({ComponentFrameKind::Missing, request_id, {}}));
+}
+
+ChunkStreamOpen ComponentServer::OpenView(const Stream& stream) const {
+    ChunkStreamOpen open;
+    open.stream_id = stream.id;
+    open.file_size = stream.size;
+    open.chunk_size = chunk_size_;
+    open.file_name = stream.hash;
+    open.file_hash = stream.hash;
+    return open;
+}
+
+size_t ComponentServer::FrameSizeLocked(const Stream& stream) const {
+    if (!stream.opened) return ChunkOpenFrameSize(OpenView(stream));
+    size_t length = static_cast<size_t>(std::min<uint64_t>(chunk_size_, stream.size - stream.offset));
+    return ChunkDataFrameSize(stream.id, stream.offset, length);
+}
+
+void ComponentServer::CloseLocked(size_t index) {
+    if (streams_[index].file) fclose(streams_[index].file);
+    streams_.erase(streams_.begin() + static_cast<std::ptrdiff_t>(index));
+    if (next_stream_ > index) --next_stream_;
+    if (next_stream_ >= streams_.size()) next_stream_ = 0;
+}
+
+bool ComponentServer::PeekFrameSize(size_t& size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!replies_.empty()) {
+        size = replies_.front().size();
+        return true;
+    }
+    if (streams_.empty()) return false;
+    size = FrameSizeLocked(streams_[next_stream_]);
+    return true;
+}
+
+size_t ComponentServer::NextFrame(uint8_t* out, size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!replies_.empty()) {
+        const auto& reply = replies_.front();
+        if (reply.size() > capacity) return 0;
+        memcpy(out, reply.data(), reply.size());
+        size_t written = reply.size();
+        replies_.pop_front();
+        return written;
+    }
+    if (streams_.empty()) return 0;
+
+    const size_t index = next_stream_;
+    Stream& stream = streams_[index];
+    if (FrameSizeLocked(stream) > capacity) return 0;
+
+    size_t written;
+    if (!stream.opened) {
+        written = WriteChunkOpenFrame(OpenView(stream), out, capacity);
+        stream.opened = true;
+    } else {
+        // Read the file straight into the frame behind its header
+        size_t length = static_cast<size_t>(std::min<uint64_t>(chunk_size_, stream.size - stream.offset));
+        size_t header = WriteChunkDataHeader(stream.id, stream.offset, out);
+        if (fread(out + header, 1, length, stream.file) != length) {
+            // The file changed under us; the fetcher drops what it has
+            uint64_t id = stream.id;
+            CloseLocked(index);
+            written = 0;
+            std::vector<uint8_t> missing = WriteComponentFrame({ComponentFrameKind::Missing, id, {}});
+            if (missing.size() <= capacity) {
+                memcpy(out, missing.data(), missing.size());
+                written = missing.size();
+            } else {
+                replies_.push_back(std::move(missing));
+            }
+            return written;
+        }
+        written = SealChunkFrame(out, header + length);
+        stream.offset += length;
+    }
+
+    // A stream leaves once its last chunk is out; the rest take turns
+    if (stream.opened && stream.offset >= stream.size) {
+        CloseLocked(index);
+    } else {
+        next_stream_ = (index + 1) % streams_.size();
+    }
+    return written;
+}
+
+size_t ComponentServer::ActiveStreams() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return streams_.size();
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// C exports for the plugin
+// ---------------------------------------------------------------------------
+
+extern "C" {
+
+__declspec(dllexport) void* CreateComponentFetcher(const char* output_dir, int window) {
+    if (!output_dir) return nullptr;
+    return new fyteclub::ComponentFetcher(output_dir, window > 0 ? static_cast<size_t>(window) : 8);
+}
+
+// Returns the request id, or 0 for an empty or oversized hash
+__declspec(dllexport) uint64_t ComponentFetcherRequest(void* fetcher, const char* hash) {
+    if (!fetcher || !hash || !*hash) return 0;
+    return static_cast<fyteclub::ComponentFetcher*>(fetcher)->Request(hash);
+}
+
+__declspec(dllexport) int ComponentFetcherCancel(void* fetcher, uint64_t request_id) {
+    return fetcher && static_cast<fyteclub::ComponentFetcher*>(fetcher)->Cancel(request_id) ? 1 : 0;
+}
+
+// Returns the frame size, 0 when nothing is due, or -(kMaxComponentFrameSize)
+// when capacity could not hold every control frame (nothing is popped)
+__declspec(dllexport) int ComponentFetcherPopFrame(void* fetcher, uint8_t* out, int capacity) {
+    if (!fetcher || !out || capacity < 0) return -1;
+    if (static_cast<size_t>(capacity) < fyteclub::kMaxComponentFrameSize) {
+        return -static_cast<int>(fyteclub::kMaxComponentFrameSize);
+    }
+    std::vector<uint8_t> frame;
+    if (!static_cast<fyteclub::ComponentFetcher*>(fetcher)->PopFrame(frame)) return 0;
+    memcpy(out, frame.data(), frame.size());
+    return static_cast<int>(frame.size());
+}
+
+// Returns a ComponentFrameResult value: 0 = not a component frame (pass it
+// on), 1 = accepted, 2 = ignored, 3 = invalid
+__declspec(dllexport) int ComponentFetcherOnFrame(void* fetcher, const uint8_t* frame, int size) {
+    if (!fetcher || !frame || size < 0) return 3;
+    return static_cast<int>(
+        static_cast<fyteclub::ComponentFetcher*>(fetcher)->OnFrame(frame, static_cast<size_t>(size)));
+}
+
+// Returns 1 and fills the outputs when a request finished, 0 when none has.
+// status is a ComponentStatus value: 0 = completed, 1 = missing, 2 = failed.
+__declspec(dllexport) int ComponentFetcherPopCompletion(void* fetcher, uint64_t* request_id, int* status, char* hash,
+                                                        int hash_capacity, char* path, int path_capacity) {
+    if (!fetcher) return 0;
+    fyteclub::ComponentCompletion completion;
+    if (!static_cast<fyteclub::ComponentFetcher*>(fetcher)->PopCompletion(completion)) return 0;
+    if (request_id) *request_id = completion.request_id;
+    if (status) *status = static_cast<int>(completion.status);
+    fyteclub::CopyString(completion.hash, hash, hash_capacity);
+    fyteclub::CopyString(completion.path, path, path_capacity);
+    return 1;
+}
+
+__declspec(dllexport) void ComponentFetcherSetWindow(void* fetcher, int window) {
+    if (fetcher && window > 0) static_cast<fyteclub::ComponentFetcher*>(fetcher)->SetWindow(static_cast<size_t>(window));
+}
+
+__declspec(dllexport) int ComponentFetcherInFlight(void* fetcher) {
+    return fetcher ? static_cast<int>(static_cast<fyteclub::ComponentFetcher*>(fetcher)->InFlight()) : 0;
+}
+
+__declspec(dllexport) int ComponentFetcherQueued(void* fetcher) {
+    return fetcher ? static_cast<int>(static_cast<fyteclub::ComponentFetcher*>(fetcher)->Queued()) : 0;
+}
+
+__declspec(dllexport) void DestroyComponentFetcher(void* fetcher) {
+    delete static_cast<fyteclub::ComponentFetcher*>(fetcher);
+}
+
+__declspec(dllexport) void* CreateComponentServer(int chunk_size) {
+    return new fyteclub::ComponentServer(chunk_size > 0 ? static_cast<uint32_t>(chunk_size) : 64 * 1024);
+}
+
+// 0 = handled, -1 = not a valid component frame
+__declspec(dllexport) int ComponentServerOnFrame(void* server, const uint8_t* frame, int size) {
+    if (!server || !frame || size < 0) return -1;
+    return static_cast<fyteclub::ComponentServer*>(server)->OnFrame(frame, static_cast<size_t>(size)) ? 0 : -1;
+}
+
+// Returns 1 and fills the outputs when a request is waiting, 0 when none
+__declspec(dllexport) int ComponentServerPopRequest(void* server, uint64_t* request_id, char* hash, int hash_capacity) {
+    if (!server) return 0;
+    fyteclub::ComponentServeRequest request;
+    if (!static_cast<fyteclub::ComponentServer*>(server)->PopRequest(request)) return 0;
+    if (request_id) *request_id = request.request_id;
+    fyteclub::CopyString(request.hash, hash, hash_capacity);
+    return 1;
+}
+
+// 1 = streaming, 0 = could not open the file (the peer is told it is missing)
+__declspec(dllexport) int ComponentServerServe(void* server, uint64_t request_id, const char* path) {
+    if (!server || !path) return 0;
+    return static_cast<fyteclub::ComponentServer*>(server)->Serve(request_id, path) ? 1 : 0;
+}
+
+__declspec(dllexport) void ComponentServerReject(void* server, uint64_t request_id) {
+    if (server) static_cast<fyteclub::ComponentServer*>(server)->Reject(request_id);
+}
+
+// Returns the frame size, 0 when there is nothing to send, or -(size needed)
+// when capacity is too small (the frame stays due)
+__declspec(dllexport) int ComponentServerNextFrame(void* server, uint8_t* out, int capacity) {
+    if (!server || !out || capacity < 0) return -1;
+    auto* component_server = static_cast<fyteclub::ComponentServer*>(server);
+    size_t size;
+    if (!component_server->PeekFrameSize(size)) return 0;
+    if (size > static_cast<size_t>(capacity)) return -static_cast<int>(size);
+    return static_cast<int>(component_server->NextFrame(out, static_cast<size_t>(capacity)));
+}
+
+__declspec(dllexport) int ComponentServerActiveStreams(void* server) {
+    return server ? static_cast<int>(static_cast<fyteclub::ComponentServer*>(server)->ActiveStreams()) : 0;
+}
+
+__declspec(dllexport) void DestroyComponentServer(void* server) {
+    delete static_cast<fyteclub::ComponentServer*>(server);
+}
+
+}
@@ -0,0 +1,174 @@
+#pragma once
+#include "chunk_assembler.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Pipelined component fetch. ComponentRequest carries every missing hash and
+// the peer answers with one ComponentResponse holding all of them, so nothing
+// is usable until the largest component has crossed. Here each hash is its
+// own request with an id; the fetcher keeps up to a window of them in flight
+// and the server answers each as a chunk stream whose stream id is the
+// request id, interleaving chunks so a small component finishes as soon as
+// its own bytes are through. Completions are reported one by one, in
+// whatever order they land.
+//
+//   REQUEST  C9 | 0 | request id | hash | crc32c
+//   MISSING  C9 | 1 | request id | crc32c          server has no such component
+//   CANCEL   C9 | 2 | request id | crc32c
+//
+// Responses are ordinary chunk OPEN/DATA frames (chunk_frame.h), verified by
+// the fetcher's ChunkAssembler, so the hash must be the component's SHA-1 (40
+// hex, as the plugin names files) or SHA-256 (64 hex).
+// Request ids start at kComponentRequestIdBase, above the ids ChunkStreamTable
+// hands out, so component responses can share a channel with pushed files.
+
+namespace fyteclub {
+
+constexpr uint8_t kComponentFrameType = 0xC9;
+constexpr uint64_t kComponentRequestIdBase = 1ull << 32;
+constexpr size_t kMaxComponentHashLength = 128;
+// type, kind, id, hash length, hash, crc
+constexpr size_t kMaxComponentFrameSize = 2 + 10 + 2 + kMaxComponentHashLength + 4;
+
+enum class ComponentFrameKind : uint8_t {
+    Request = 0,
+    Missing = 1,
+    Cancel = 2,
+};
+
+struct ComponentControl {
+    ComponentFrameKind kind = ComponentFrameKind::Request;
+    uint64_t request_id = 0;
+    std::string hash; // Request only
+};
+
+std::vector<uint8_t> WriteComponentFrame(const ComponentControl& control);
+bool ParseComponentFrame(const uint8_t* frame, size_t size, ComponentControl& out);
+
+inline bool IsComponentStream(uint64_t stream_id) {
+    return stream_id >= kComponentRequestIdBase;
+}
+
+enum class ComponentStatus {
+    Completed, // verified file at path
+    Missing,   // the peer does not have it
+    Failed,    // hash mismatch, bad OPEN or I/O error
+};
+
+struct ComponentCompletion {
+    uint64_t request_id = 0;
+    std::string hash;
+    std::string path;
+    ComponentStatus status = ComponentStatus::Failed;
+};
+
+enum class ComponentFrameResult {
+    NotComponent, // not a component frame; hand it to the next handler
+    Accepted,
+    Ignored,      // for a request that was cancelled or already finished
+    Invalid,
+};
+
+// Requesting side, one per peer. Thread-safe.
+class ComponentFetcher {
+public:
+    explicit ComponentFetcher(std::string output_dir, size_t window = 8);
+
+    // Queues a hash; a hash already requested returns the existing id, and
+    // 0 means the hash is empty or longer than kMaxComponentHashLength
+    uint64_t Request(const std::string& hash);
+    // Drops a request; one already sent is cancelled on the peer too
+    bool Cancel(uint64_t request_id);
+
+    // Next frame to send: cancels first, then requests while the window allows
+    bool PopFrame(std::vector<uint8_t>& out);
+    // Takes component control frames and chunk frames of component streams
+    ComponentFrameResult OnFrame(const uint8_t* frame, size_t size);
+    bool PopCompletion(ComponentCompletion& out);
+
+    void SetWindow(size_t window);
+    size_t InFlight() const;
+    size_t Queued() const;
+
+private:
+    struct Pending {
+        std::string hash;
+        bool sent = false;
+    };
+
+    void FinishLocked(uint64_t request_id, ComponentStatus status, std::string path);
+    void DrainAssemblerLocked();
+
+    ChunkAssembler assembler_;
+
+    mutable std::mutex mutex_;
+    size_t window_;
+    uint64_t next_id_ = kComponentRequestIdBase;
+    std::unordered_map<uint64_t, Pending> requests_;
+    std::unordered_map<std::string, uint64_t> by_hash_;
+    std::deque<uint64_t> queued_; // may hold ids cancelled before they were sent
+    std::deque<uint64_t> cancels_;
+    size_t in_flight_ = 0;
+    std::deque<ComponentCompletion> completions_;
+};
+
+struct ComponentServeRequest {
+    uint64_t request_id = 0;
+    std::string hash;
+};
+
+// Serving side, one per peer. The plugin looks up each requested hash and
+// answers with Serve or Reject; NextFrame then hands out one frame at a time,
+// taking turns between the open streams. Thread-safe.
+class ComponentServer {
+public:
+    explicit ComponentServer(uint32_t chunk_size = 64 * 1024);
+    ~ComponentServer();
+    ComponentServer(const ComponentServer&) = delete;
+    ComponentServer& operator=(const ComponentServer&) = delete;
+
+    // False for a frame that is not a valid component control frame
+    bool OnFrame(const uint8_t* frame, size_t size);
+    bool PopRequest(ComponentServeRequest& out);
+
+    // False (and a MISSING reply queued) if the file cannot be opened
+    bool Serve(uint64_t request_id, const std::string& path);
+    void Reject(uint64_t request_id);
+
+    // Size of the next frame, false when there is nothing to send
+    bool PeekFrameSize(size_t& size);
+    // Writes the next frame; 0 when there is none or capacity is too small
+    size_t NextFrame(uint8_t* out, size_t capacity);
+    size_t ActiveStreams() const;
+
+private:
+    struct Stream {
+        uint64_t id = 0;
+        std::string hash;
+        FILE* file = nullptr;
+        uint64_t size = 0;
+        uint64_t offset = 0;
+        bool opened = false;
+    };
+
+    ChunkStreamOpen OpenView(const Stream& stream) const;
+    size_t FrameSizeLocked(const Stream& stream) const;
+    void CloseLocked(size_t index);
+
+    const uint32_t chunk_size_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, std::string> requested_; // id -> hash, awaiting Serve/Reject
+    std::deque<ComponentServeRequest> requests_;
+    std::deque<std::vector<uint8_t>> replies_;
+    std::vector<Stream> streams_;
+    size_t next_stream_ = 0; // round-robin cursor
+};
+
+}
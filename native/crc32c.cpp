@@ -0,0 +1,110 @@
+#include "crc32c.h"
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define FYTECLUB_CRC32C_X64 1
+#include <nmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace fyteclub {
+
+namespace {
+
+constexpr uint32_t kPolynomial = 0x82F63B78; // reflected Castagnoli
+
+struct Tables {
+    uint32_t t[8][256];
+
+    Tables() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit) crc = (crc >> 1) ^ (kPolynomial & (0u - (crc & 1)));
+            t[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < 256; ++i) {
+            for (int slice = 1; slice < 8; ++slice) t[slice][i] = (t[slice - 1][i] >> 8) ^ t[0][t[slice - 1][i] & 0xFF];
+        }
+    }
+};
+
+const Tables& GetTables() {
+    static const Tables tables;
+    return tables;
+}
+
+uint32_t Crc32cSoftware(const uint8_t* data, size_t length, uint32_t crc) {
+    const auto& t = GetTables().t;
+    while (length >= 8) {
+        uint32_t low, high;
+        memcpy(&low, data, 4);
+        memcpy(&high, data + 4, 4);
+        low ^= crc; // little-endian hosts only, same as the rest of the native code
+        crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+              t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+        data += 8;
+        length -= 8;
+    }
+    while (length--) crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xFF];
+    return crc;
+}
+
+#ifdef FYTECLUB_CRC32C_X64
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("sse4.2")))
+#endif
+uint32_t Crc32cHardware(const uint8_t* data, size_t length, uint32_t crc) {
+    uint64_t crc64 = crc;
+    while (length >= 8) {
+        uint64_t word;
+        memcpy(&word, data, 8);
+        crc64 = _mm_crc32_u64(crc64, word);
+        data += 8;
+        length -= 8;
+    }
+    uint32_t crc32 = static_cast<uint32_t>(crc64);
+    while (length--) crc32 = _mm_crc32_u8(crc32, *data++);
+    return crc32;
+}
+
+bool DetectSse42() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;
+#else
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+    return (ecx & bit_SSE4_2) != 0;
+#endif
+}
+#endif
+
+bool HasHardwareCrc() {
+#ifdef FYTECLUB_CRC32C_X64
+    static const bool supported = DetectSse42();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+}
+
+uint32_t Crc32c(const uint8_t* data, size_t length, uint32_t crc) {
+    crc = ~crc;
+#ifdef FYTECLUB_CRC32C_X64
+    if (HasHardwareCrc()) return ~Crc32cHardware(data, length, crc);
+#endif
+    return ~Crc32cSoftware(data, length, crc);
+}
+
+bool Crc32cIsHardwareAccelerated() {
+    return HasHardwareCrc();
+}
+
+}
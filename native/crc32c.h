@@ -0,0 +1,16 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// CRC-32C (Castagnoli), the checksum used by SCTP and iSCSI. Uses the SSE4.2
+// crc32 instruction when the CPU has it and a slicing-by-8 table otherwise.
+
+namespace fyteclub {
+
+// Pass the previous result as crc to checksum data in pieces
+uint32_t Crc32c(const uint8_t* data, size_t length, uint32_t crc = 0);
+
+// True when Crc32c is running on the hardware instruction
+bool Crc32cIsHardwareAccelerated();
+
+}
@@ -0,0 +1,256 @@
+#include "decode_pool.h"
+#include "buffer_arena.h"
+#include "chunk_assembler.h"
+#include "chunk_frame.h"
+#include <algorithm>
+#include <cstring>
+
+namespace fyteclub {
+
+namespace {
+
+// Tasks a worker runs from one strand before giving others a turn
+constexpr int kStrandBatch = 32;
+
+}
+
+DecodePool::DecodePool(unsigned threads, ThreadPool pool) : pool_(pool) {
+    if (threads == 0) threads = std::max(std::thread::hardware_concurrency(), 1u);
+    threads = ThreadPolicy::ThreadCount(pool, threads);
+    for (unsigned i = 0; i < threads; ++i) workers_.push_back(std::make_unique<Worker>());
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        workers_[i]->thread = std::thread([this, i] { Run(i); });
+    }
+}
+
+DecodePool::~DecodePool() {
+    WaitIdle();
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) worker->thread.join();
+}
+
+void DecodePool::Submit(uint64_t stream_key, Task task) {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        pending_tasks_++;
+    }
+    std::shared_ptr<Strand> to_schedule;
+    {
+        std::lock_guard<std::mutex> lock(strands_mutex_);
+        auto& strand = strands_[stream_key];
+        if (!strand) {
+            strand = std::make_shared<Strand>();
+            strand->key = stream_key;
+        }
+        strand->tasks.push_back(std::move(task));
+        if (!strand->scheduled) {
+            strand->scheduled = true;
+            to_schedule = strand;
+        }
+    }
+    if (to_schedule) Schedule(std::hash<uint64_t>{}(stream_key) % workers_.size(), std::move(to_schedule));
+}
+
+void DecodePool::WaitIdle() {
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    idle_.wait(lock, [this] { return pending_tasks_ == 0; });
+}
+
+DecodePool::Stats DecodePool::GetStats() const {
+    return {tasks_run_.load(), steals_.load()};
+}
+
+void DecodePool::Schedule(size_t worker_index, std::shared_ptr<Strand> strand) {
+    {
+        // Counted under wake_mutex_ so Take can never see the strand before the count
+        std::lock_guard<std::mutex> wake_lock(wake_mutex_);
+        {
+            std::lock_guard<std::mutex> lock(workers_[worker_index]->mutex);
+            workers_[worker_index]->ready.push_back(std::move(strand));
+        }
+        ready_strands_++;
+    }
+    wake_.notify_one();
+}
+
+std::shared_ptr<DecodePool::Strand> DecodePool::Take(size_t worker_index) {
+    std::shared_ptr<Strand> strand;
+    {
+        std::lock_guard<std::mutex> lock(workers_[worker_index]->mutex);
+        auto& ready = workers_[worker_index]->ready;
+        if (!ready.empty()) {
+            strand = std::move(ready.front());
+            ready.pop_front();
+        }
+    }
+    // Steal from the back of the other queues: the strand its owner would reach last
+    for (size_t i = 1; !strand && i < workers_.size(); ++i) {
+        auto& victim = *workers_[(worker_index + i) % workers_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.ready.empty()) {
+            strand = std::move(victim.ready.back());
+            victim.ready.pop_back();
+            steals_++;
+        }
+    }
+    if (strand) {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        ready_strands_--;
+    }
+    return strand;
+}
+
+void DecodePool::Run(size_t worker_index) {
+    ThreadPolicy::ApplyToCurrentThread(pool_);
+    for (;;) {
+        if (auto strand = Take(worker_index)) {
+            Drain(worker_index, strand);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_.wait(lock, [this] { return ready_strands_ > 0 || stopping_; });
+        if (stopping_ && ready_strands_ == 0) return;
+    }
+}
+
+void DecodePool::Drain(size_t worker_index, const std::shared_ptr<Strand>& strand) {
+    for (int run = 0;; ++run) {
+        Task task;
+        {
+            std::lock_guard<std::mutex> lock(strands_mutex_);
+            if (strand->tasks.empty()) {
+                strand->scheduled = false;
+                auto it = strands_.find(strand->key);
+                if (it != strands_.end() && it->second == strand) strands_.erase(it);
+                return;
+            }
+            if (run == kStrandBatch) break;
+            task = std::move(strand->tasks.front());
+            strand->tasks.pop_front();
+        }
+        try {
+            task();
+        } catch (...) {
+            // A bad message must not take the worker down with it
+        }
+        tasks_run_++;
+        bool idle;
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            idle = --pending_tasks_ == 0;
+        }
+        if (idle) idle_.notify_all();
+    }
+    // Still scheduled; requeue behind whatever else this worker has
+    Schedule(worker_index, strand);
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// C exports for the plugin
+// ---------------------------------------------------------------------------
+//
+// Received chunk frames are applied to a ChunkAssembler on the pool, so the
+// CRC check, the positioned file write and the hashing all leave the thread
+// that received them. The frame stays in the BufferArena slot it was received
+// into (LanReceiveSlot, or a slot the plugin rented and filled): nothing is
+// copied in, and only a small result record comes back.
+
+extern "C" {
+
+struct DecodedFrameResult {
+    uint64_t stream_key;
+    uint64_t stream_id; // 0 when the frame did not parse
+    int32_t status;     // ChunkFrameStatus
+    int32_t result;     // ChunkAssemblyResult, valid when status == 0
+};
+
+}
+
+namespace {
+
+struct DecodePoolHandle {
+    explicit DecodePoolHandle(unsigned threads) : pool(threads) {}
+
+    std::mutex results_mutex;
+    std::deque<DecodedFrameResult> results;
+    fyteclub::DecodePool pool; // last: workers stop before the result queue goes away
+};
+
+void ApplyFrame(DecodePoolHandle* handle, uint64_t stream_key, fyteclub::ChunkAssembler* assembler,
+                fyteclub::BufferArena* arena, int slot, size_t size) {
+    DecodedFrameResult result{};
+    result.stream_key = stream_key;
+    fyteclub::ParsedChunkFrame parsed;
+    auto status = fyteclub::ParseChunkFrame(arena->Slot(slot), size, parsed);
+    result.status = static_cast<int32_t>(status);
+    if (status == fyteclub::ChunkFrameStatus::Ok) {
+        result.stream_id = parsed.type == fyteclub::ChunkFrameType::Open ? parsed.open.stream_id : parsed.data.stream_id;
+        result.result = static_cast<int32_t>(assembler->OnFrame(parsed));
+    }
+    // The assembler has written or copied what it keeps
+    arena->Release(slot);
+    std::lock_guard<std::mutex> lock(handle->results_mutex);
+    handle->results.push_back(result);
+}
+
+}
+
+extern "C" {
+
+// threads = 0 sizes the pool from the hardware and the compression pool policy.
+// Destroy the pool before any assembler or arena it has been handed.
+__declspec(dllexport) void* CreateDecodePool(int threads) {
+    return new DecodePoolHandle(threads > 0 ? static_cast<unsigned>(threads) : 0);
+}
+
+// Queues the chunk frame in arena slot (size bytes) for assembler. On 0 the
+// pool owns the slot and releases it once the frame is applied; on -1 the
+// caller keeps it. Frames with the same stream_key are applied in submission
+// order; give each transfer stream its own key so streams write in parallel.
+__declspec(dllexport) int DecodePoolSubmitChunkSlot(void* pool, uint64_t stream_key, void* assembler, void* arena,
+                                                    int slot, int size) {
+    auto* handle = static_cast<DecodePoolHandle*>(pool);
+    auto* target = static_cast<fyteclub::ChunkAssembler*>(assembler);
+    auto* buffers = static_cast<fyteclub::BufferArena*>(arena);
+    if (!handle || !target || !buffers || !buffers->Slot(slot) || size <= 0 ||
+        static_cast<size_t>(size) > buffers->SlotSize()) {
+        return -1;
+    }
+    handle->pool.Submit(stream_key, [handle, stream_key, target, buffers, slot, size] {
+        ApplyFrame(handle, stream_key, target, buffers, slot, static_cast<size_t>(size));
+    });
+    return 0;
+}
+
+// 1 and the next applied frame's result, or 0 when none is ready. Completed
+// files are then taken from the assembler with ChunkAssemblerPopCompleted.
+__declspec(dllexport) int DecodePoolPollResult(void* pool, DecodedFrameResult* result) {
+    auto* handle = static_cast<DecodePoolHandle*>(pool);
+    if (!handle || !result) return 0;
+    std::lock_guard<std::mutex> lock(handle->results_mutex);
+    if (handle->results.empty()) return 0;
+    *result = handle->results.front();
+    handle->results.pop_front();
+    return 1;
+}
+
+// Blocks until every submitted frame has been applied
+__declspec(dllexport) void DecodePoolWaitIdle(void* pool) {
+    if (pool) static_cast<DecodePoolHandle*>(pool)->pool.WaitIdle();
+}
+
+__declspec(dllexport) int DecodePoolThreadCount(void* pool) {
+    return pool ? static_cast<int>(static_cast<DecodePoolHandle*>(pool)->pool.ThreadCount()) : 0;
+}
+
+__declspec(dllexport) void DestroyDecodePool(void* pool) {
+    delete static_cast<DecodePoolHandle*>(pool);
+}
+
+}
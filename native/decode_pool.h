@@ -0,0 +1,85 @@
+#pragma once
+#include "thread_policy.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Receive-side decode workers shared by all channels. Messages from every
+// channel are otherwise decoded on whichever thread raised MessageReceived,
+// so a burst on one channel holds up the others.
+//
+// Work is submitted under a stream key (transfer stream, channel, peer).
+// Tasks with the same key run one at a time in submission order; different
+// keys run in parallel. Each key's queue (a strand) is scheduled on a home
+// worker picked from the key, and idle workers steal whole strands from busy
+// ones, so one hot stream cannot starve the rest and no stream is ever split
+// across two threads at once.
+
+namespace fyteclub {
+
+class DecodePool {
+public:
+    using Task = std::function<void()>;
+
+    struct Stats {
+        uint64_t tasks_run = 0;
+        uint64_t steals = 0;
+    };
+
+    // threads = 0 sizes the pool from the hardware, capped by the pool policy
+    explicit DecodePool(unsigned threads = 0, ThreadPool pool = ThreadPool::Compression);
+    // Runs every task already submitted, then stops the workers
+    ~DecodePool();
+    DecodePool(const DecodePool&) = delete;
+    DecodePool& operator=(const DecodePool&) = delete;
+
+    void Submit(uint64_t stream_key, Task task);
+    // Blocks until every submitted task has finished
+    void WaitIdle();
+
+    unsigned ThreadCount() const { return static_cast<unsigned>(workers_.size()); }
+    Stats GetStats() const;
+
+private:
+    struct Strand {
+        uint64_t key = 0;
+        std::deque<Task> tasks;
+        bool scheduled = false;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::shared_ptr<Strand>> ready;
+        std::thread thread;
+    };
+
+    void Schedule(size_t worker_index, std::shared_ptr<Strand> strand);
+    std::shared_ptr<Strand> Take(size_t worker_index);
+    void Run(size_t worker_index);
+    void Drain(size_t worker_index, const std::shared_ptr<Strand>& strand);
+
+    ThreadPool pool_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    std::mutex strands_mutex_;
+    std::unordered_map<uint64_t, std::shared_ptr<Strand>> strands_;
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    size_t ready_strands_ = 0; // strands sitting in worker queues
+    size_t pending_tasks_ = 0; // submitted and not yet finished
+    bool stopping_ = false;
+
+    std::atomic<uint64_t> tasks_run_{0};
+    std::atomic<uint64_t> steals_{0};
+};
+
+}
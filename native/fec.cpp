@@ -0,0 +1,423 @@
+#include "fec.h"
+#include "frame_util.h"
+#include "wire_codec.h"
+#include <algorithm>
+#include <cstring>
+#include <deque>
+
+namespace fyteclub {
+
+using wire::ReadVarint;
+using wire::VarintSize;
+using wire::WriteVarint;
+
+namespace {
+
+constexpr size_t kLengthPrefixSize = 4;
+
+// GF(2^8) with the 0x11D polynomial; the full product table keeps the
+// per-byte inner loop to one lookup
+struct Gf256 {
+    uint8_t exp[512];
+    uint8_t log[256];
+    uint8_t mul[256][256];
+
+    Gf256() {
+        unsigned value = 1;
+        for (int i = 0; i < 255; ++i) {
+            exp[i] = static_cast<uint8_t>(value);
+            log[value] = static_cast<uint8_t>(i);
+            value <<= 1;
+            if (value & 0x100) value ^= 0x11D;
+        }
+        for (int i = 255; i < 512; ++i) exp[i] = exp[i - 255];
+        log[0] = 0;
+        for (int a = 0; a < 256; ++a) {
+            for (int b = 0; b < 256; ++b) mul[a][b] = (a && b) ? exp[log[a] + log[b]] : 0;
+        }
+    }
+
+    uint8_t Inverse(uint8_t a) const { return exp[255 - log[a]]; }
+};
+
+const Gf256& Gf() {
+    static const Gf256 gf;
+    return gf;
+}
+
+// dst += c * src
+void MulAdd(uint8_t* dst, const uint8_t* src, size_t length, uint8_t c) {
+    if (c == 0) return;
+    const uint8_t* row = Gf().mul[c];
+    for (size_t i = 0; i < length; ++i) dst[i] ^= row[src[i]];
+}
+
+// Cauchy matrix entry 1 / (x_j + y_i) with x_j = j and y_i = r + i; the two
+// sets are disjoint, so every square submatrix is invertible
+uint8_t Coefficient(uint8_t r, uint8_t repair_index, uint8_t source_index) {
+    return Gf().Inverse(static_cast<uint8_t>(repair_index ^ (r + source_index)));
+}
+
+// Adds c * symbol(message) to dst without materializing the padded symbol
+void MulAddSymbol(uint8_t* dst, const uint8_t* message, size_t length, uint8_t c) {
+    uint8_t prefix[kLengthPrefixSize];
+    StoreLe32(prefix, static_cast<uint32_t>(length));
+    MulAdd(dst, prefix, kLengthPrefixSize, c);
+    MulAdd(dst + kLengthPrefixSize, message, length, c);
+}
+
+// In-place Gauss-Jordan inverse of an n x n matrix (row-major)
+bool Invert(std::vector<uint8_t>& matrix, size_t n) {
+    const Gf256& gf = Gf();
+    std::vector<uint8_t> inverse(n * n, 0);
+    for (size_t i = 0; i < n; ++i) inverse[i * n + i] = 1;
+
+    for (size_t col = 0; col < n; ++col) {
+        size_t pivot = col;
+        while (pivot < n && matrix[pivot * n + col] == 0) ++pivot;
+        if (pivot == n) return false;
+        if (pivot != col) {
+            for (size_t k = 0; k < n; ++k) {
+                std::swap(matrix[pivot * n + k], matrix[col * n + k]);
+                std::swap(inverse[pivot * n + k], inverse[col * n + k]);
+            }
+        }
+        uint8_t scale = gf.Inverse(matrix[col * n + col]);
+        for (size_t k = 0; k < n; ++k) {
+            matrix[col * n + k] = gf.mul[scale][matrix[col * n + k]];
+            inverse[col * n + k] = gf.mul[scale][inverse[col * n + k]];
+        }
+        for (size_t row = 0; row < n; ++row) {
+            uint8_t factor = matrix[row * n + col];
+            if (row == col || factor == 0) continue;
+            MulAdd(&matrix[row * n], &matrix[col * n], n, factor);
+            MulAdd(&inverse[row * n], &inverse[col * n], n, factor);
+        }
+    }
+    matrix.swap(inverse);
+    return true;
+}
+
+}
+
+bool IsFecPacket(const uint8_t* packet, size_t size) {
+    return size >= 3 &&
+           (packet[0] == static_cast<uint8_t>(FecPacketType::Source) || packet[0] == static_cast<uint8_t>(FecPacketType::Repair));
+}
+
+// ---------------------------------------------------------------------------
+// Encoder
+// ---------------------------------------------------------------------------
+
+FecEncoder::FecEncoder(FecConfig config) : config_(config) {
+    config_.source_symbols = std::max<uint8_t>(1, config_.source_symbols);
+    if (config_.source_symbols + config_.repair_symbols > 256) {
+        config_.repair_symbols = static_cast<uint8_t>(256 - config_.source_symbols);
+    }
+    repair_.resize(config_.repair_symbols);
+}
+
+void FecEncoder::Add(const uint8_t* message, size_t length, FecPackets& out) {
+    std::vector<uint8_t> packet(1 + VarintSize(block_id_) + 1 + length);
+    uint8_t* p = packet.data();
+    *p++ = static_cast<uint8_t>(FecPacketType::Source);
+    p = WriteVarint(p, block_id_);
+    *p++ = count_;
+    if (length > 0) memcpy(p, message, length);
+    out.push_back(std::move(packet));
+
+    // Zero padding is free in the parity sums, so they just grow to the
+    // longest symbol seen so far
+    for (uint8_t j = 0; j < config_.repair_symbols; ++j) {
+        auto& parity = repair_[j];
+        if (parity.size() < kLengthPrefixSize + length) parity.resize(kLengthPrefixSize + length, 0);
+        MulAddSymbol(parity.data(), message, length, Coefficient(config_.repair_symbols, j, count_));
+    }
+
+    if (++count_ == config_.source_symbols) EmitRepair(out);
+}
+
+void FecEncoder::Flush(FecPackets& out) {
+    EmitRepair(out);
+}
+
+void FecEncoder::EmitRepair(FecPackets& out) {
+    if (count_ == 0) return;
+    for (uint8_t j = 0; j < config_.repair_symbols; ++j) {
+        auto& parity = repair_[j];
+        std::vector<uint8_t> packet(1 + VarintSize(block_id_) + 3 + parity.size());
+        uint8_t* p = packet.data();
+        *p++ = static_cast<uint8_t>(FecPacketType::Repair);
+        p = WriteVarint(p, block_id_);
+        *p++ = j;
+        *p++ = count_;
+        *p++ = config_.repair_symbols;
+        memcpy(p, parity.data(), parity.size());
+        out.push_back(std::move(packet));
+        parity.clear();
+    }
+    ++block_id_;
+    count_ = 0;
+}
+
+// ---------------------------------------------------------------------------
+// Decoder
+// ---------------------------------------------------------------------------
+
+FecDecoder::FecDecoder(size_t window_blocks) : window_blocks_(std::max<size_t>(1, window_blocks)) {}
+
+FecDecoder::Block* FecDecoder::GetBlock(uint64_t block_id) {
+    if (any_evicted_ && block_id <= evicted_through_) return nullptr;
+    Block* block = &blocks_[block_id];
+    while (blocks_.size() > window_blocks_) {
+        auto oldest = blocks_.begin();
+        const Block& evicted = oldest->second;
+        if (!evicted.done && evicted.k > evicted.delivered_count) stats_.lost += evicted.k - evicted.delivered_count;
+        evicted_through_ = any_evicted_ ? std::max(evicted_through_, oldest->first) : oldest->first;
+        any_evicted_ = true;
+        bool was_requested = oldest->first == block_id;
+        blocks_.erase(oldest);
+        if (was_requested) return nullptr;
+    }
+    return block;
+}
+
+bool FecDecoder::Receive(const uint8_t* packet, size_t size, FecPackets& delivered) {
+    if (!IsFecPacket(packet, size)) {
+        stats_.malformed++;
+        return false;
+    }
+    const uint8_t* p = packet + 1;
+    const uint8_t* end = packet + size;
+    uint64_t block_id;
+    if (!ReadVarint(p, end, block_id) || p >= end) {
+        stats_.malformed++;
+        return false;
+    }
+
+    const bool is_source = packet[0] == static_cast<uint8_t>(FecPacketType::Source);
+    const uint8_t index = *p++;
+    uint8_t k = 0, r = 0;
+    if (!is_source) {
+        if (end - p < 2) {
+            stats_.malformed++;
+            return false;
+        }
+        k = *p++;
+        r = *p++;
+        if (k == 0 || index >= r || k + r > 256 || static_cast<size_t>(end - p) < kLengthPrefixSize) {
+            stats_.malformed++;
+            return false;
+        }
+    }
+
+    Block* block = GetBlock(block_id);
+    if (!block) {
+        stats_.late++;
+        return true;
+    }
+    if (block->done) return true;
+
+    if (is_source) {
+        if (block->k && index >= block->k) {
+            stats_.malformed++;
+            return false;
+        }
+        if (block->have_source.size() <= index) {
+            block->have_source.resize(index + 1u, false);
+            block->sources.resize(index + 1u);
+        }
+        if (block->have_source[index]) return true;
+        block->have_source[index] = true;
+        block->sources[index].assign(p, end);
+        delivered.emplace_back(p, end);
+        block->delivered_count++;
+        stats_.delivered++;
+    } else {
+        if (block->k == 0) {
+            block->k = k;
+            block->r = r;
+        } else if (block->k != k || block->r != r) {
+            stats_.malformed++;
+            return false;
+        }
+        if (!block->repairs.empty() && block->repairs.begin()->second.size() != static_cast<size_t>(end - p)) {
+            stats_.malformed++;
+            return false;
+        }
+        block->repairs.emplace(index, std::vector<uint8_t>(p, end));
+    }
+
+    TryRecover(*block, delivered);
+    return true;
+}
+
+void FecDecoder::TryRecover(Block& block, FecPackets& delivered) {
+    if (block.k == 0) return;
+    block.have_source.resize(block.k, false);
+    block.sources.resize(block.k);
+
+    std::vector<uint8_t> missing;
+    for (uint8_t i = 0; i < block.k; ++i) {
+        if (!block.have_source[i]) missing.push_back(i);
+    }
+    if (!missing.empty() && block.repairs.size() < missing.size()) return;
+
+    if (!missing.empty()) {
+        const size_t m = missing.size();
+        const size_t symbol_size = block.repairs.begin()->second.size();
+
+        // Each used repair, minus the known sources, is a combination of the missing ones
+        std::vector<uint8_t> rows;
+        std::vector<std::vector<uint8_t>> rhs;
+        for (const auto& [repair_index, symbol] : block.repairs) {
+            if (rows.size() == m) break;
+            std::vector<uint8_t> residual = symbol;
+            for (uint8_t i = 0; i < block.k; ++i) {
+                if (!block.have_source[i]) continue;
+                const auto& source = block.sources[i];
+                if (kLengthPrefixSize + source.size() > symbol_size) {
+                    stats_.malformed++;
+                    block.done = true;
+                    return;
+                }
+                MulAddSymbol(residual.data(), source.data(), source.size(), Coefficient(block.r, repair_index, i));
+            }
+            rows.push_back(repair_index);
+            rhs.push_back(std::move(residual));
+        }
+
+        std::vector<uint8_t> matrix(m * m);
+        for (size_t row = 0; row < m; ++row) {
+            for (size_t col = 0; col < m; ++col) matrix[row * m + col] = Coefficient(block.r, rows[row], missing[col]);
+        }
+        if (!Invert(matrix, m)) return;
+
+        std::vector<uint8_t> symbol(symbol_size);
+        for (size_t col = 0; col < m; ++col) {
+            std::fill(symbol.begin(), symbol.end(), 0);
+            for (size_t row = 0; row < m; ++row) MulAdd(symbol.data(), rhs[row].data(), symbol_size, matrix[col * m + row]);
+
+            uint32_t length = uint32_t(symbol[0]) | (uint32_t(symbol[1]) << 8) | (uint32_t(symbol[2]) << 16) |
+                              (uint32_t(symbol[3]) << 24);
+            if (length > symbol_size - kLengthPrefixSize) {
+                stats_.malformed++;
+                continue;
+            }
+            delivered.emplace_back(symbol.begin() + kLengthPrefixSize, symbol.begin() + kLengthPrefixSize + length);
+            block.delivered_count++;
+            stats_.delivered++;
+            stats_.recovered++;
+        }
+    }
+
+    // Everything is delivered; keep only the marker so late packets are ignored
+    block.done = true;
+    block.sources.clear();
+    block.sources.shrink_to_fit();
+    block.repairs.clear();
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// C exports for the plugin. Packets and messages are queued natively and
+// drained with the Pop calls so no callbacks cross into managed code.
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct FecQueue {
+    std::deque<std::vector<uint8_t>> items;
+
+    int Append(fyteclub::FecPackets& packets) {
+        for (auto& packet : packets) items.push_back(std::move(packet));
+        packets.clear();
+        return static_cast<int>(items.size());
+    }
+
+    // Size written, 0 when empty, or -size when the buffer is too small
+    int Pop(uint8_t* out, int capacity) {
+        if (items.empty()) return 0;
+        const auto& front = items.front();
+        if (static_cast<int>(front.size()) > capacity) return -static_cast<int>(front.size());
+        int size = static_cast<int>(front.size());
+        if (size > 0) memcpy(out, front.data(), front.size());
+        items.pop_front();
+        return size;
+    }
+};
+
+struct FecEncoderHandle {
+    fyteclub::FecEncoder encoder;
+    fyteclub::FecPackets scratch;
+    FecQueue queue;
+};
+
+struct FecDecoderHandle {
+    fyteclub::FecDecoder decoder;
+    fyteclub::FecPackets scratch;
+    FecQueue queue;
+};
+
+}
+
+extern "C" {
+
+__declspec(dllexport) void* CreateFecEncoder(int source_symbols, int repair_symbols) {
+    if (source_symbols < 1 || source_symbols > 255 || repair_symbols < 0 || source_symbols + repair_symbols > 256) {
+        return nullptr;
+    }
+    fyteclub::FecConfig config;
+    config.source_symbols = static_cast<uint8_t>(source_symbols);
+    config.repair_symbols = static_cast<uint8_t>(repair_symbols);
+    return new FecEncoderHandle{fyteclub::FecEncoder(config), {}, {}};
+}
+
+// Returns the number of packets waiting to be sent
+__declspec(dllexport) int FecEncoderAdd(void* encoder, const uint8_t* message, int length) {
+    auto* handle = static_cast<FecEncoderHandle*>(encoder);
+    if (!handle || length < 0 || (!message && length > 0)) return -1;
+    handle->encoder.Add(message, static_cast<size_t>(length), handle->scratch);
+    return handle->queue.Append(handle->scratch);
+}
+
+__declspec(dllexport) int FecEncoderFlush(void* encoder) {
+    auto* handle = static_cast<FecEncoderHandle*>(encoder);
+    if (!handle) return -1;
+    handle->encoder.Flush(handle->scratch);
+    return handle->queue.Append(handle->scratch);
+}
+
+__declspec(dllexport) int FecEncoderPopPacket(void* encoder, uint8_t* out, int capacity) {
+    auto* handle = static_cast<FecEncoderHandle*>(encoder);
+    return handle && out ? handle->queue.Pop(out, capacity) : -1;
+}
+
+__declspec(dllexport) void DestroyFecEncoder(void* encoder) {
+    delete static_cast<FecEncoderHandle*>(encoder);
+}
+
+__declspec(dllexport) void* CreateFecDecoder(int window_blocks) {
+    return new FecDecoderHandle{fyteclub::FecDecoder(window_blocks > 0 ? static_cast<size_t>(window_blocks) : 64), {}, {}};
+}
+
+// Returns the number of messages ready to be popped, or -1 for a malformed packet
+__declspec(dllexport) int FecDecoderReceive(void* decoder, const uint8_t* packet, int size) {
+    auto* handle = static_cast<FecDecoderHandle*>(decoder);
+    if (!handle || !packet || size < 0) return -1;
+    bool ok = handle->decoder.Receive(packet, static_cast<size_t>(size), handle->scratch);
+    int ready = handle->queue.Append(handle->scratch);
+    return ok ? ready : -1;
+}
+
+__declspec(dllexport) int FecDecoderPopMessage(void* decoder, uint8_t* out, int capacity) {
+    auto* handle = static_cast<FecDecoderHandle*>(decoder);
+    return handle && out ? handle->queue.Pop(out, capacity) : -1;
+}
+
+__declspec(dllexport) void DestroyFecDecoder(void* decoder) {
+    delete static_cast<FecDecoderHandle*>(decoder);
+}
+
+}
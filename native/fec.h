@@ -0,0 +1,101 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+// Forward error correction for bulk data on unordered, partially reliable
+// data channels. A lost SCTP packet on an ordered reliable channel stalls
+// everything behind it for a retransmit RTT; with FEC the sender adds R
+// repair packets per block of K messages and the receiver rebuilds up to R
+// lost messages per block from whatever arrives.
+//
+// Systematic Reed-Solomon over GF(2^8) with a Cauchy generator matrix: source
+// messages go out unchanged (plus a small header) the moment they are added,
+// so nothing waits for a block to fill, and any K of the K+R packets recover
+// the block.
+//
+//   SOURCE  C3 | block id | index | message
+//   REPAIR  C4 | block id | repair index | k | r | symbol
+//
+// Block ids are varints and increase monotonically. A symbol is the message
+// with a 4-byte little-endian length prefix, zero padded to the longest
+// message in the block. Type bytes continue the chunk_frame.h range.
+
+namespace fyteclub {
+
+enum class FecPacketType : uint8_t {
+    Source = 0xC3,
+    Repair = 0xC4,
+};
+
+struct FecConfig {
+    uint8_t source_symbols = 8; // K messages per block
+    uint8_t repair_symbols = 2; // R repair packets per block, 0 disables FEC
+};
+
+using FecPackets = std::vector<std::vector<uint8_t>>;
+
+bool IsFecPacket(const uint8_t* packet, size_t size);
+
+class FecEncoder {
+public:
+    explicit FecEncoder(FecConfig config = {});
+
+    // Appends the message's source packet to out, followed by the block's
+    // repair packets when this message completes a block
+    void Add(const uint8_t* message, size_t length, FecPackets& out);
+    // Closes a partial block (end of a file, idle sender) so its tail is protected too
+    void Flush(FecPackets& out);
+
+private:
+    void EmitRepair(FecPackets& out);
+
+    FecConfig config_;
+    uint64_t block_id_ = 0;
+    uint8_t count_ = 0;
+    std::vector<std::vector<uint8_t>> repair_; // running parity sums for the current block
+};
+
+class FecDecoder {
+public:
+    struct Stats {
+        uint64_t delivered = 0;       // messages handed to the caller
+        uint64_t recovered = 0;       // of which rebuilt from repair packets
+        uint64_t lost = 0;            // messages in evicted blocks that could not be rebuilt
+        uint64_t late = 0;            // packets for blocks already evicted
+        uint64_t malformed = 0;
+    };
+
+    // window_blocks bounds memory: older blocks are dropped once it is exceeded
+    explicit FecDecoder(size_t window_blocks = 64);
+
+    // Appends every message that became available: the packet's own message
+    // for a source packet, plus any messages a repair made recoverable.
+    // Returns false for a malformed packet.
+    bool Receive(const uint8_t* packet, size_t size, FecPackets& delivered);
+
+    const Stats& GetStats() const { return stats_; }
+
+private:
+    struct Block {
+        uint8_t k = 0; // 0 until a repair packet tells us the block size
+        uint8_t r = 0;
+        uint8_t delivered_count = 0;
+        std::vector<std::vector<uint8_t>> sources;   // indexed by source index
+        std::vector<bool> have_source;
+        std::map<uint8_t, std::vector<uint8_t>> repairs;
+        bool done = false;
+    };
+
+    Block* GetBlock(uint64_t block_id);
+    void TryRecover(Block& block, FecPackets& delivered);
+
+    size_t window_blocks_;
+    std::map<uint64_t, Block> blocks_;
+    bool any_evicted_ = false;
+    uint64_t evicted_through_ = 0;
+    Stats stats_;
+};
+
+}
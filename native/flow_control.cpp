@@ -0,0 +1,320 @@
+#include "flow_control.h"
+#include "frame_util.h"
+#include "wire_codec.h"
+#include <algorithm>
+#include <chrono>
+
+namespace fyteclub {
+
+using wire::ReadVarint;
+using wire::VarintSize;
+using wire::WriteVarint;
+
+bool IsCreditFrame(const uint8_t* frame, size_t size) {
+    return size > kFrameTrailerSize && frame[0] == kCreditFrameType;
+}
+
+size_t CreditFrameSize(const CreditGrant& grant) {
+    return 1 + VarintSize(grant.stream_id) + VarintSize(grant.limit) + kFrameTrailerSize;
+}
+
+size_t WriteCreditFrame(const CreditGrant& grant, uint8_t* out, size_t capacity) {
+    const size_t size = CreditFrameSize(grant);
+    if (size > capacity) return 0;
+    uint8_t* p = out;
+    *p++ = kCreditFrameType;
+    p = WriteVarint(p, grant.stream_id);
+    p = WriteVarint(p, grant.limit);
+    WriteFrameTrailer(out, p);
+    return size;
+}
+
+bool ParseCreditFrame(const uint8_t* frame, size_t size, CreditGrant& out) {
+    if (!IsCreditFrame(frame, size)) return false;
+    const uint8_t* end = frame + size - kFrameTrailerSize;
+    if (!FrameTrailerMatches(frame, size)) return false;
+    const uint8_t* p = frame + 1;
+    CreditGrant grant;
+    if (!ReadVarint(p, end, grant.stream_id) || !ReadVarint(p, end, grant.limit) || p != end) return false;
+    out = grant;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// CreditSender
+// ---------------------------------------------------------------------------
+
+CreditSender::CreditSender(FlowControlConfig config) : config_(config) {
+    connection_.limit = config_.initial_connection_credit;
+}
+
+CreditSender::Window& CreditSender::StreamWindow(uint64_t stream_id) {
+    auto it = streams_.find(stream_id);
+    if (it == streams_.end()) {
+        it = streams_.emplace(stream_id, Window{config_.initial_stream_credit, 0, ++next_open_id_}).first;
+    }
+    return it->second;
+}
+
+uint64_t CreditSender::AvailableLocked(uint64_t stream_id) const {
+    uint64_t stream_available = config_.initial_stream_credit;
+    auto it = streams_.find(stream_id);
+    if (it != streams_.end()) stream_available = it->second.limit - std::min(it->second.sent, it->second.limit);
+    uint64_t connection_available = connection_.limit - std::min(connection_.sent, connection_.limit);
+    return std::min(stream_available, connection_available);
+}
+
+void CreditSender::OnGrant(const CreditGrant& grant) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Window* window = &connection_;
+    if (grant.stream_id != kConnectionCreditStream) {
+        // Grants for streams we have closed (or never sent on) are stale
+        auto it = streams_.find(grant.stream_id);
+        if (it == streams_.end()) return;
+        window = &it->second;
+    }
+    if (grant.limit <= window->limit) return;
+    window->limit = grant.limit;
+    credit_changed_.notify_all();
+}
+
+bool CreditSender::Acquire(uint64_t stream_id, uint64_t bytes, int timeout_ms) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const uint64_t open_id = StreamWindow(stream_id).open_id;
+    // The wait drops the lock, so CloseStream can erase the window meanwhile:
+    // look it up again on every wake instead of holding a reference to it
+    Window* stream = nullptr;
+    auto ready = [&] {
+        auto it = streams_.find(stream_id);
+        stream = it != streams_.end() && it->second.open_id == open_id ? &it->second : nullptr;
+        return closed_ || !stream || AvailableLocked(stream_id) >= bytes;
+    };
+    if (!credit_changed_.wait_for(lock, std::chrono::milliseconds(std::max(timeout_ms, 0)), ready) || closed_ ||
+        !stream) {
+        return false;
+    }
+    stream->sent += bytes;
+    connection_.sent += bytes;
+    return true;
+}
+
+uint64_t CreditSender::Available(uint64_t stream_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return AvailableLocked(stream_id);
+}
+
+void CreditSender::CloseStream(uint64_t stream_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Waiters on the stream give up rather than send on a closed one
+    if (streams_.erase(stream_id)) credit_changed_.notify_all();
+}
+
+void CreditSender::Close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    credit_changed_.notify_all();
+}
+
+// ---------------------------------------------------------------------------
+// CreditReceiver
+// ---------------------------------------------------------------------------
+
+CreditReceiver::CreditReceiver(FlowControlConfig config) : config_(config) {
+    connection_.limit = config_.initial_connection_credit;
+}
+
+CreditReceiver::~CreditReceiver() {
+    if (budget_) {
+        budget_->Release(budget_peer_, connection_.received - connection_.consumed);
+        budget_->RemovePeer(budget_peer_);
+    }
+}
+
+void CreditReceiver::SetMemoryBudget(MemoryBudget* budget, uint64_t peer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    budget_ = budget;
+    budget_peer_ = peer;
+}
+
+bool CreditReceiver::OnData(uint64_t stream_id, uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = streams_.find(stream_id);
+    if (it == streams_.end()) it = streams_.emplace(stream_id, Stream{0, 0, config_.initial_stream_credit}).first;
+    Stream& stream = it->second;
+    stream.received += bytes;
+    connection_.received += bytes;
+    // Already here, so it is charged even past the peer's share
+    if (budget_) budget_->Charge(budget_peer_, bytes);
+    return stream.received <= stream.limit && connection_.received <= connection_.limit;
+}
+
+void CreditReceiver::OnConsumed(uint64_t stream_id, uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = streams_.find(stream_id);
+    if (it == streams_.end()) return;
+    bytes = std::min(bytes, it->second.received - it->second.consumed);
+    it->second.consumed += bytes;
+    connection_.consumed += bytes;
+    if (budget_) budget_->Release(budget_peer_, bytes);
+}
+
+void CreditReceiver::CloseStream(uint64_t stream_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = streams_.find(stream_id);
+    if (it == streams_.end()) return;
+    // Whatever was still buffered for the stream is dropped with it
+    const uint64_t dropped = it->second.received - it->second.consumed;
+    connection_.consumed += dropped;
+    if (budget_) budget_->Release(budget_peer_, dropped);
+    streams_.erase(it);
+}
+
+uint64_t CreditReceiver::NextLimit(const Stream& stream, uint64_t window) const {
+    return std::max(stream.limit, stream.consumed + window);
+}
+
+void CreditReceiver::CollectGrants(std::vector<CreditGrant>& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint64_t buffered = connection_.received - connection_.consumed;
+    uint64_t budget = config_.memory_budget;
+    // Other peers may have used up the shared budget: only grant what is left
+    if (budget_) budget = std::min(budget, buffered + budget_->Available(budget_peer_));
+    const uint64_t free_memory = budget > buffered ? budget - buffered : 0;
+
+    // The connection limit alone keeps buffered bytes within the budget
+    uint64_t next = NextLimit(connection_, budget);
+    if (next > connection_.limit && next - connection_.limit >= budget / 4) {
+        connection_.limit = next;
+        out.push_back({kConnectionCreditStream, next});
+    }
+
+    if (streams_.empty()) return;
+    uint64_t share = free_memory / streams_.size();
+    uint64_t window = std::min(config_.max_stream_window, std::max(config_.initial_stream_credit, share));
+    for (auto& [id, stream] : streams_) {
+        next = NextLimit(stream, window);
+        if (next - stream.limit >= window / 4) {
+            stream.limit = next;
+            out.push_back({id, next});
+        }
+    }
+}
+
+uint64_t CreditReceiver::Buffered() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return connection_.received - connection_.consumed;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// C exports for the plugin
+// ---------------------------------------------------------------------------
+
+namespace {
+
+fyteclub::FlowControlConfig MakeConfig(uint64_t initial_stream_credit, uint64_t initial_connection_credit) {
+    fyteclub::FlowControlConfig config;
+    if (initial_stream_credit > 0) config.initial_stream_credit = initial_stream_credit;
+    if (initial_connection_credit > 0) config.initial_connection_credit = initial_connection_credit;
+    return config;
+}
+
+struct CreditReceiverHandle {
+    fyteclub::CreditReceiver receiver;
+    std::vector<fyteclub::CreditGrant> pending;
+};
+
+}
+
+extern "C" {
+
+// Zero for any argument keeps the FlowControlConfig default
+__declspec(dllexport) void* CreateCreditSender(uint64_t initial_stream_credit, uint64_t initial_connection_credit) {
+    return new fyteclub::CreditSender(MakeConfig(initial_stream_credit, initial_connection_credit));
+}
+
+// Returns 0 if the frame was a valid CREDIT frame, -1 otherwise
+__declspec(dllexport) int CreditSenderOnFrame(void* sender, const uint8_t* frame, int size) {
+    fyteclub::CreditGrant grant;
+    if (!sender || !frame || size < 0 || !fyteclub::ParseCreditFrame(frame, static_cast<size_t>(size), grant)) return -1;
+    static_cast<fyteclub::CreditSender*>(sender)->OnGrant(grant);
+    return 0;
+}
+
+// 0 = credit reserved, 1 = timed out or closed
+__declspec(dllexport) int CreditSenderAcquire(void* sender, uint64_t stream_id, int bytes, int timeout_ms) {
+    if (!sender || bytes < 0) return -1;
+    return static_cast<fyteclub::CreditSender*>(sender)->Acquire(stream_id, static_cast<uint64_t>(bytes), timeout_ms)
+               ? 0
+               : 1;
+}
+
+__declspec(dllexport) uint64_t CreditSenderAvailable(void* sender, uint64_t stream_id) {
+    return sender ? static_cast<fyteclub::CreditSender*>(sender)->Available(stream_id) : 0;
+}
+
+__declspec(dllexport) void CreditSenderCloseStream(void* sender, uint64_t stream_id) {
+    if (sender) static_cast<fyteclub::CreditSender*>(sender)->CloseStream(stream_id);
+}
+
+__declspec(dllexport) void DestroyCreditSender(void* sender) {
+    auto* credit_sender = static_cast<fyteclub::CreditSender*>(sender);
+    if (!credit_sender) return;
+    credit_sender->Close();
+    delete credit_sender;
+}
+
+__declspec(dllexport) void* CreateCreditReceiver(uint64_t initial_stream_credit, uint64_t initial_connection_credit,
+                                                 uint64_t memory_budget, uint64_t max_stream_window) {
+    auto config = MakeConfig(initial_stream_credit, initial_connection_credit);
+    if (memory_budget > 0) config.memory_budget = memory_budget;
+    if (max_stream_window > 0) config.max_stream_window = max_stream_window;
+    return new CreditReceiverHandle{fyteclub::CreditReceiver(config), {}};
+}
+
+// Returns 0, or -1 when the peer exceeded its credit
+__declspec(dllexport) int CreditReceiverOnData(void* receiver, uint64_t stream_id, int bytes) {
+    if (!receiver || bytes < 0) return -1;
+    return static_cast<CreditReceiverHandle*>(receiver)->receiver.OnData(stream_id, static_cast<uint64_t>(bytes)) ? 0 : -1;
+}
+
+__declspec(dllexport) void CreditReceiverOnConsumed(void* receiver, uint64_t stream_id, int bytes) {
+    if (receiver && bytes > 0) {
+        static_cast<CreditReceiverHandle*>(receiver)->receiver.OnConsumed(stream_id, static_cast<uint64_t>(bytes));
+    }
+}
+
+__declspec(dllexport) void CreditReceiverCloseStream(void* receiver, uint64_t stream_id) {
+    if (receiver) static_cast<CreditReceiverHandle*>(receiver)->receiver.CloseStream(stream_id);
+}
+
+// Writes the next CREDIT frame to send back; returns its size, 0 when there
+// is nothing to advertise, -1 if capacity is too small
+__declspec(dllexport) int CreditReceiverPopFrame(void* receiver, uint8_t* out, int capacity) {
+    auto* handle = static_cast<CreditReceiverHandle*>(receiver);
+    if (!handle || !out || capacity < 0) return -1;
+    if (handle->pending.empty()) {
+        handle->receiver.CollectGrants(handle->pending);
+        std::reverse(handle->pending.begin(), handle->pending.end());
+    }
+    if (handle->pending.empty()) return 0;
+    size_t size = fyteclub::WriteCreditFrame(handle->pending.back(), out, static_cast<size_t>(capacity));
+    if (size == 0) return -1;
+    handle->pending.pop_back();
+    return static_cast<int>(size);
+}
+
+// budget comes from CreateMemoryBudget; peer is the plugin's handle for the connection
+__declspec(dllexport) void CreditReceiverSetMemoryBudget(void* receiver, void* budget, uint64_t peer) {
+    if (receiver) {
+        static_cast<CreditReceiverHandle*>(receiver)->receiver.SetMemoryBudget(
+            static_cast<fyteclub::MemoryBudget*>(budget), peer);
+    }
+}
+
+__declspec(dllexport) void DestroyCreditReceiver(void* receiver) {
+    delete static_cast<CreditReceiverHandle*>(receiver);
+}
+
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include "memory_budget.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Receiver-driven flow control for chunk streams. ProgressiveFileTransfer
+// paces itself with fixed delays and MAX_CONCURRENT_CHUNKS because the
+// receiver has no way to push back; here the receiver grants byte credit and
+// the sender never sends past it, so throughput follows the receiver's actual
+// reassembly memory and disk speed.
+//
+//   CREDIT  C5 | stream id | limit | crc32c
+//
+// limit is an absolute byte count: the sender may send stream bytes
+// [0, limit). Stream id 0 carries the connection-wide limit over all streams
+// together. Limits only grow, so duplicated or reordered CREDIT frames are
+// harmless. Both sides start every stream (and the connection) with the
+// agreed initial credit, so the first chunks go out without waiting a round
+// trip. Same varint/CRC conventions as chunk_frame.h.
+
+namespace fyteclub {
+
+constexpr uint8_t kCreditFrameType = 0xC5;
+constexpr uint64_t kConnectionCreditStream = 0;
+
+struct CreditGrant {
+    uint64_t stream_id = 0;
+    uint64_t limit = 0;
+};
+
+struct FlowControlConfig {
+    uint64_t initial_stream_credit = 512 * 1024;      // must match on both sides
+    uint64_t initial_connection_credit = 4 * 1024 * 1024;
+    uint64_t max_stream_window = 8 * 1024 * 1024;     // receiver: most credit one stream may hold ahead
+    uint64_t memory_budget = 64 * 1024 * 1024;        // receiver: reassembly + write backlog bound
+};
+
+bool IsCreditFrame(const uint8_t* frame, size_t size);
+size_t CreditFrameSize(const CreditGrant& grant);
+// Returns the frame size, or 0 when capacity is too small
+size_t WriteCreditFrame(const CreditGrant& grant, uint8_t* out, size_t capacity);
+bool ParseCreditFrame(const uint8_t* frame, size_t size, CreditGrant& out);
+
+// Sending side. Thread-safe: channel workers block in Acquire while the
+// thread reading the control channel feeds CREDIT frames to OnGrant.
+class CreditSender {
+public:
+    explicit CreditSender(FlowControlConfig config = {});
+
+    void OnGrant(const CreditGrant& grant);
+    // Reserves bytes on the stream and the connection, waiting up to
+    // timeout_ms for credit. Returns false on timeout, after Close, or when
+    // the stream is closed while waiting.
+    bool Acquire(uint64_t stream_id, uint64_t bytes, int timeout_ms);
+    // Bytes that could be sent on the stream right now
+    uint64_t Available(uint64_t stream_id) const;
+    void CloseStream(uint64_t stream_id);
+    // Wakes every waiter; later Acquire calls fail
+    void Close();
+
+private:
+    struct Window {
+        uint64_t limit = 0;
+        uint64_t sent = 0;
+        uint64_t open_id = 0; // tells a reopened stream from the one a waiter started on
+    };
+
+    Window& StreamWindow(uint64_t stream_id);
+    uint64_t AvailableLocked(uint64_t stream_id) const;
+
+    FlowControlConfig config_;
+    mutable std::mutex mutex_;
+    std::condition_variable credit_changed_;
+    Window connection_;
+    std::unordered_map<uint64_t, Window> streams_;
+    uint64_t next_open_id_ = 0;
+    bool closed_ = false;
+};
+
+// Receiving side. Credit handed out is bounded by the memory budget minus
+// what is buffered (received but not yet written), split across open streams.
+class CreditReceiver {
+public:
+    explicit CreditReceiver(FlowControlConfig config = {});
+    ~CreditReceiver();
+
+    // Charges buffered bytes to peer in a budget shared with other peers;
+    // grants then also stay within what the budget has left for the peer.
+    // Call before the first OnData.
+    void SetMemoryBudget(MemoryBudget* budget, uint64_t peer);
+
+    // Returns false if the peer sent past its credit
+    bool OnData(uint64_t stream_id, uint64_t bytes);
+    // Bytes left memory (written to disk or handed off)
+    void OnConsumed(uint64_t stream_id, uint64_t bytes);
+    void CloseStream(uint64_t stream_id);
+
+    // Appends grants worth sending; a limit is re-advertised only once it can
+    // move by a quarter window, to keep CREDIT traffic low
+    void CollectGrants(std::vector<CreditGrant>& out);
+
+    uint64_t Buffered() const;
+
+private:
+    struct Stream {
+        uint64_t received = 0;
+        uint64_t consumed = 0;
+        uint64_t limit = 0;
+    };
+
+    uint64_t NextLimit(const Stream& stream, uint64_t window) const;
+
+    FlowControlConfig config_;
+    mutable std::mutex mutex_;
+    MemoryBudget* budget_ = nullptr;
+    uint64_t budget_peer_ = 0;
+    Stream connection_;
+    std::unordered_map<uint64_t, Stream> streams_;
+};
+
+}
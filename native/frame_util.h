@@ -0,0 +1,86 @@
+#pragma once
+#include "crc32c.h"
+#include "wire_codec.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Byte-level helpers shared by the native frame formats (chunk, credit,
+// SACK, gossip, manifest, component and snapshot frames) and by the C
+// exports that hand strings back to the plugin. Frames put a CRC-32C of
+// everything before it in a 4-byte little-endian trailer.
+
+namespace fyteclub {
+
+constexpr size_t kFrameTrailerSize = 4;
+
+inline uint32_t LoadLe32(const uint8_t* p) {
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+inline uint64_t LoadLe64(const uint8_t* p) {
+    return uint64_t(LoadLe32(p)) | (uint64_t(LoadLe32(p + 4)) << 32);
+}
+
+inline void StoreLe32(uint8_t* p, uint32_t value) {
+    for (int i = 0; i < 4; ++i) p[i] = static_cast<uint8_t>(value >> (i * 8));
+}
+
+inline void StoreLe64(uint8_t* p, uint64_t value) {
+    for (int i = 0; i < 8; ++i) p[i] = static_cast<uint8_t>(value >> (i * 8));
+}
+
+inline void AppendVarint(std::vector<uint8_t>& out, uint64_t value) {
+    uint8_t buffer[10];
+    uint8_t* end = wire::WriteVarint(buffer, value);
+    out.insert(out.end(), buffer, end);
+}
+
+// Varint length, then the bytes
+inline void AppendBytes(std::vector<uint8_t>& out, const void* data, size_t size) {
+    AppendVarint(out, size);
+    auto* bytes = static_cast<const uint8_t*>(data);
+    out.insert(out.end(), bytes, bytes + size);
+}
+
+// Reads what AppendBytes wrote; data points into the input
+inline bool ReadBytes(const uint8_t*& p, const uint8_t* end, const uint8_t*& data, size_t& size) {
+    uint64_t length;
+    if (!wire::ReadVarint(p, end, length) || length > static_cast<uint64_t>(end - p)) return false;
+    data = p;
+    size = static_cast<size_t>(length);
+    p += length;
+    return true;
+}
+
+// Appends the CRC-32C trailer
+inline void SealFrame(std::vector<uint8_t>& frame) {
+    uint8_t trailer[kFrameTrailerSize];
+    StoreLe32(trailer, Crc32c(frame.data(), frame.size()));
+    frame.insert(frame.end(), trailer, trailer + kFrameTrailerSize);
+}
+
+// Writes the CRC-32C of [frame, end) at end; returns the end of the trailer
+inline uint8_t* WriteFrameTrailer(uint8_t* frame, uint8_t* end) {
+    StoreLe32(end, Crc32c(frame, static_cast<size_t>(end - frame)));
+    return end + kFrameTrailerSize;
+}
+
+// True when the frame is long enough for a trailer and the trailer matches
+inline bool FrameTrailerMatches(const uint8_t* frame, size_t size) {
+    return size >= kFrameTrailerSize &&
+           Crc32c(frame, size - kFrameTrailerSize) == LoadLe32(frame + size - kFrameTrailerSize);
+}
+
+// NUL-terminated copy into a caller's buffer, truncated to capacity - 1 bytes
+inline void CopyString(const std::string& value, char* out, int capacity) {
+    if (!out || capacity <= 0) return;
+    size_t length = std::min(value.size(), static_cast<size_t>(capacity - 1));
+    memcpy(out, value.data(), length);
+    out[length] = '\0';
+}
+
+}
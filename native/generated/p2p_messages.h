@@ -0,0 +1,611 @@
+// <auto-generated> by schema_codegen from schema/p2p_messages.schema - do not edit.
+#pragma once
+#include "../wire_codec.h"
+
+namespace fyteclub::wire {
+
+constexpr uint32_t kSchemaVersion = 2;
+
+enum class P2PModMessageType : int32_t {
+    ModDataRequest = 0,
+    ModDataResponse = 1,
+    ComponentRequest = 2,
+    ComponentResponse = 3,
+    ModApplicationRequest = 4,
+    ModApplicationResponse = 5,
+    SyncComplete = 6,
+    Error = 7,
+    ChunkedMessage = 8,
+    FileChunkMessage = 9,
+    MemberListRequest = 10,
+    MemberListResponse = 11,
+    ChannelNegotiation = 12,
+    ChannelNegotiationResponse = 13,
+    ReconnectOffer = 14,
+    ReconnectAnswer = 15,
+    RecoveryRequest = 16,
+};
+
+enum class PlayerState : int32_t {
+    Unknown = 0,
+    Offline = 1,
+    Online = 2,
+    Requesting = 3,
+    Downloading = 4,
+    Applying = 5,
+    Applied = 6,
+    Failed = 7,
+    Paused = 8,
+    Visible = 9,
+    Hidden = 10,
+};
+
+struct TransferableFile {
+    std::string_view game_path;
+    std::string_view hash;
+    Bytes content;
+    int64_t size = 0;
+};
+
+template <> struct MessageSchema<TransferableFile> {
+    static constexpr auto kFields = std::make_tuple(
+        Field<&TransferableFile::game_path, 1>{"gamePath"},
+        Field<&TransferableFile::hash, 2>{"hash"},
+        Field<&TransferableFile::content, 3>{"content"},
+        Field<&TransferableFile::size, 4>{"size"});
+};
+
+struct PlayerInfo {
+    std::string_view player_id;
+    std::string_view player_name;
+    PlayerState state{};
+    List<std::string_view> mods;
+    std::optional<std::string_view> active_collection;
+    std::optional<std::string_view> manipulation_data;
+    std::optional<std::string_view> glamourer_design;
+    std::optional<std::string_view> glamourer_data;
+    std::optional<std::string_view> customize_plus_profile;
+    std::optional<std::string_view> customize_plus_data;
+    std::optional<float> simple_heels_offset;
+    std::optional<std::string_view> heels_data;
+    std::optional<std::string_view> honorific_title;
+    std::optional<std::string_view> lock_code;
+    uint32_t world_id = 0;
+};
+
+template <> struct MessageSchema<PlayerInfo> {
+    static constexpr auto kFields = std::make_tuple(
+        Field<&PlayerInfo::player_id, 1>{"playerId"},
+        Field<&PlayerInfo::player_name, 2>{"playerName"},
+        Field<&PlayerInfo::state, 3>{"state"},
+        Field<&PlayerInfo::mods, 4>{"mods"},
+        Field<&PlayerInfo::active_collection, 5>{"activeCollection"},
+        Field<&PlayerInfo::manipulation_data, 6>{"manipulationData"},
+        Field<&PlayerInfo::glamourer_design, 7>{"glamourerDesign"},
+        Field<&PlayerInfo::glamourer_data, 8>{"glamourerData"},
+        Field<&PlayerInfo::customize_plus_profile, 9>{"customizePlusProfile"},
+        Field<&PlayerInfo::customize_plus_data, 10>{"customizePlusData"},
+        Field<&PlayerInfo::simple_heels_offset, 11>{"simpleHeelsOffset"},
+        Field<&PlayerInfo::heels_data, 12>{"heelsData"},
+        Field<&PlayerInfo::honorific_title, 13>{"honorificTitle"},
+        Field<&PlayerInfo::lock_code, 14>{"lockCode"},
+        Field<&PlayerInfo::world_id, 15>{"worldId"});
+};
+
+struct FileChunk {
+    std::string_view session_id;
+    std::string_view file_name;
+    int32_t chunk_index = 0;
+    int32_t total_chunks = 0;
+    Bytes data;
+    std::string_view file_hash;
+    int32_t channel_index = 0;
+};
+
+template <> struct MessageSchema<FileChunk> {
+    static constexpr auto kFields = std::make_tuple(
+        Field<&FileChunk::session_id, 1>{"sessionId"},
+        Field<&FileChunk::file_name, 2>{"fileName"},
+        Field<&FileChunk::chunk_index, 3>{"chunkIndex"},
+        Field<&FileChunk::total_chunks, 4>{"totalChunks"},
+        Field<&FileChunk::data, 5>{"data"},
+        Field<&FileChunk::file_hash, 6>{"fileHash"},
+        Field<&FileChunk::channel_index, 7>{"channelIndex"});
+};
+
+struct ModDataRequest {
+    static constexpr uint32_t kType = 0;
+
+    std::string_view message_id;
+    int64_t timestamp = 0;
+    std::optional<std::string_view> response_to;
+    std::string_view player_name;
+    std::optional<std::string_view> last_known_hash;
+};
+
+template <> struct MessageSchema<ModDataRequest> {
+    static constexpr auto kFields = std::make_tuple(
+        Field<&ModDataRequest::message_id, 1>{"messageId"},
+        Field<&ModDataRequest::timestamp, 2>{"timestamp"},
+        Field<&ModDataRequest::response_to, 3>{"responseTo"},
+        Field<&ModDataRequest::player_name, 4>{"playerName"},
+        Field<&ModDataRequest::last_known_hash, 5>{"lastKnownHash"});
+};
+
+struct ModDataResponse {
+    static constexpr uint32_t kType = 1;
+
+    std::string_view message_id;
+    int64_t timestamp = 0;
+    std::optional<std::string_view> response_to;
+    std::string_view player_name;
+    std::string_view data_hash;
+    PlayerInfo player_info;
+    List<MapEntry<TransferableFile>> file_replacements;
+    bool is_compressed = false;
+    bool upload_deferred = false;
+    int32_t queue_position = 0;
+    int32_t retry_after_ms = 0;
+};
+
+template <> struct MessageSchema<ModDataResponse> {
+    static constexpr auto kFields = std::make_tuple(
+        Field<&ModDataResponse::message_id, 1>{"messageId"},
+        Field<&ModDataResponse::timestamp, 2>{"timestamp"},
+        Field<&ModDataResponse::response_to, 3>{"responseTo"},
+        Field<&ModDataResponse::player_name, 4>{"playerName"},
+        Field<&ModDataResponse::data_hash, 5>{"dataHash"},
+        Field<&ModDataResponse::player_info, 6>{"playerInfo"},
+        Field<&ModDataResponse::file_replacements, 7>{"fileReplacements"},
+        Field<&ModDataResponse::is_compressed, 8>{"isCompressed"},
+        Field<&ModDataResponse::upload_deferred, 9, 2>{"uploadDeferred"},
+        Field<&ModDataResponse::queue_position, 10, 2>{"queuePosition"},
+        Field<&ModDataResponse::retry_after_ms, 11, 2>{"retryAfterMs"});
+};
+
+struct ComponentRequest {
+    static constexpr uint32_t kType = 2;
+
+    std::string_view message_id;
+    int64_t timestamp = 0;
+    std::optional<std::string_view> response_to;
+    List<std::string_view> requested_hashes;
+    std::string_view player_name;
+};
+
+template <> struct MessageSchema<ComponentRequest> {
+    static constexpr auto kFields = std::make_tuple(
+        Field<&ComponentRequest::message_id, 1>{"messageId"},
+        Field<&ComponentRequest::timestamp, 2>{"timestamp"},
+        Field<&ComponentRequest::response_to, 3>{"responseTo"},
+        Field<&ComponentRequest::requested_hashes, 4>{"requestedHashes"},
+        Field<&ComponentRequest::player_name, 5>{"playerName"});
+};
+
+struct ComponentResponse {
+    static constexpr uint32_t kType = 3;
+
+    std::string_view message_id;
+    int64_t timestamp = 0;
+    std::optional<std::string_view> response_to;
+    List<MapEntry<TransferableFile>> components;
+    List<std::string_view> missing_hashes;
+};
+
+template <> struct MessageSchema<ComponentResponse> {
+    static constexpr auto kFields = std::make_tuple(
+        Field<&ComponentResponse::message_id, 1>{"messageId"},
+        Field<&ComponentResponse::timestamp, 2>{"timestamp"},
+        Field<&ComponentResponse::response_to, 3>{"responseTo"},
+        Field<&ComponentResponse::components, 4>{"components"},
+        Field<&ComponentResponse::missing_hashes, 5>{"missingHashes"});
+};
+
+struct ModApplicationRequest {
+    static constexpr uint32_t kType = 4;
+
+    std::string_view message_id;
+    int64_t timestamp = 0;
+    std::optional<std::string_view> response_to;
+    std::string_view target_player_name;
+    std::string_view source_player_name;
+    PlayerInfo player_info;
+    List<MapEntry<TransferableFile>> file_replacements;
+};
+
+template <> struct MessageSchema<ModApplicationRequest> {
+    static constexpr auto kFields = std::make_tuple(
+        Field<&ModApplicationRequest::message_id, 1>{"messageId"},
+        Field<&ModApplicationRequest::timestamp, 2>{"timestamp"},
+        Field<&ModApplicationRequest::response_to, 3>{"responseTo"},
+        Field<&ModApplicationRequest::target_player_name, 4>{"targetPlayerName"},
+        Field<&ModApplicationRequest::source_player_name, 5>{"sourcePlayerName"},
+        Field<&ModApplicationRequest::player_info, 6>{"playerInfo"},
+        Field<&ModApplicationRequest::file_replacements, 7>{"fileReplacements"});
+};
+
+struct ModApplicationResponse {
+    static constexpr uint32_t kType = 5;
+
+    std::string_view message_id;
+    int64_t timestamp = 0;
+    std::optional<std::string_view> response_to;
+    bool success = false;
+    std::optional<std::string_view> error_message;
+    std::string_view player_name;
+};
+
+template <> struct MessageSchema<ModApplicationResponse> {
+    static constexpr auto kFields = std::make_tuple(
+        Field<&ModApplicationResponse::message_id, 1>{"messageId"},
+        Field<&ModApplicationResponse::timestamp, 2>{"timestamp"},
+        Field<&ModApplicationResponse::response_to, 3>{"responseTo"},
+        Field<&ModApplicationResponse::success, 4>{"success"},
+        Field<&ModApplicationResponse::error_message, 5>{"errorMessage"},
+        Field<&ModApplicationResponse::player_name, 6>{"playerName"});
+};
+
+struct SyncCompleteMessage {
+    static constexpr uint32_t kType = 6;
+
+    std::string_view message_id;
+    int64_t timestamp = 0;
+    std::optional<std::string_view> response_to;
+    std::string_view player_name;
+    int32_t processed_files = 0;
+    int64_t total_bytes = 0;
+};
+
+template <> struct MessageSchema<SyncCompleteMessage> {
+    static constexpr auto kFields = std::make_tuple(
+        Field<&SyncCompleteMessage::message_id, 1>{"messageId"},
+        Field<&SyncCompleteMessage::timestamp, 2>{"timestamp"},
+        Field<&SyncCompleteMessage::response_to, 3>{"responseTo"},
+        Field<&SyncCompleteMessage::player_name, 4>{"playerName"},
+        Field<&SyncCompleteMessage::processed_files, 5>{"processedFiles"},
+        Field<&SyncCompleteMessage::total_bytes, 6>{"totalBytes"});
+};
+
+struct ErrorMessage {
+    static constexpr uint32_t kType = 7;
+
+    std::string_view message_id;
+    int64_t timestamp = 0;
+    std::optional<std::string_view> response_to;
+    std::string_view error_code;
+    std::string_view error_description;
+    std::optional<std::string_view> failed_operation;
+};
+
+template <> struct MessageSchema<ErrorMessage> {
+    static constexpr auto kFields = std::make_tuple(
+        Field<&ErrorMessage::message_id, 1>{"messageId"},
+        Field<&ErrorMessage::timestamp, 2>{"timestamp"},
+        Field<&ErrorMessage::response_to, 3>{"responseTo"},
+        Field<&ErrorMessage::error_code, 4>{"errorCode"},
+        Field<&ErrorMessage::error_description, 5>{"errorDescription"},
+        Field<&ErrorMessage::failed_operation, 6>{"failedOperation"});
+};
+
+struct ChunkedMessage {
+    static constexpr uint32_t kType = 8;
+
+    std::string_view message_id;
+    int64_t timestamp = 0;
+    std::optional<std::string_view> response_to;
+    std::string_view chunk_id;
+    int32_t chunk_index = 0;
+    int32_t total_chunks = 0;
+    Bytes chunk_data;
+    P2PModMessageType original_message_type{};
+};
+
+template <> struct MessageSchema<ChunkedMessage> {
+    static constexpr auto kFields = std::make_tuple(
+        Field<&ChunkedMessage::message_id, 1>{"messageId"},
+        Field<&ChunkedMessage::timestamp, 2>{"timestamp"},
+        Field<&ChunkedMessage::response_to, 3>{"responseTo"},
+        Field<&ChunkedMessage::chunk_id, 4>{"chunkId"},
+        Field<&ChunkedMessage::chunk_index, 5>{"chunkIndex"},
+        Field<&ChunkedMessage::total_chunks, 6>{"totalChunks"},
+        Field<&ChunkedMessage::chunk_data, 7>{"chunkData"},
+        Field<&ChunkedMessage::original_message_type, 8>{"originalMessageType"});
+};
+
+struct FileChunkMessage {
+    static constexpr uint32_t kType = 9;
+
+    std::string_view message_id;
+    int64_t timestamp = 0;
+    std::optional<std::string_view> response_to;
+    FileChunk chunk;
+};
+
+template <> struct MessageSchema<FileChunkMessage> {
+    static constexpr auto kFields = std::make_tuple(
+        Field<&FileChunkMessage::message_id, 1>{"messageId"},
+        Field<&FileChunkMessage::timestamp, 2>{"timestamp"},
+        Field<&FileChunkMessage::response_to, 3>{"responseTo"},
+        Field<&FileChunkMessage::chunk, 4>{"chunk"});
+};
+
+struct MemberListRequestMessage {
+    static constexpr uint32_t kType = 10;
+
+    std::string_view message_id;
+    int64_t timestamp = 0;
+    std::optional<std::string_view> response_to;
+    std::string_view syncshell_id;
+    std::string_view requested_by;
+};
+
+template <> struct MessageSchema<MemberListRequestMessage> {
+    static constexpr auto kFields = std::make_tuple(
+        Field<&MemberListRequestMessage::message_id, 1>{"messageId"},
+        Field<&MemberListRequestMessage::timestamp, 2>{"timestamp"},
+        Field<&MemberListRequestMessage::response_to, 3>{"responseTo"},
+        Field<&MemberListRequestMessage::syncshell_id, 4>{"syncshellId"},
+        Field<&MemberListRequestMessage::requested_by, 5>{"requestedBy"});
+};
+
+struct MemberListResponseMessage {
+    static constexpr uint32_t kType = 11;
+
+    std::string_view message_id;
+    int64_t timestamp = 0;
+    std::optional<std::string_view> response_to;
+    std::string_view syncshell_id;
+    std::string_view host_name;
+    List<std::string_view> members;
+    bool is_host = false;
+};
+
+template <> struct MessageSchema<MemberListResponseMessage> {
+    static constexpr auto kFields = std::make_tuple(
+        Field<&MemberListResponseMessage::message_id, 1>{"messageId"},
+        Field<&MemberListResponseMessage::timestamp, 2>{"timestamp"},
+        Field<&MemberListResponseMessage::response_to, 3>{"responseTo"},
+        Field<&MemberListResponseMessage::syncshell_id, 4>{"syncshellId"},
+        Field<&MemberListResponseMessage::host_name, 5>{"hostName"},
+        Field<&MemberListResponseMessage::members, 6>{"members"},
+        Field<&MemberListResponseMessage::is_host, 7>{"isHost"});
+};
+
+struct ChannelNegotiationMessage {
+    static constexpr uint32_t kType = 12;
+
+    std::string_view message_id;
+    int64_t timestamp = 0;
+    std::optional<std::string_view> response_to;
+    int32_t mod_count = 0;
+    int32_t large_mod_count = 0;
+    int32_t small_mod_count = 0;
+    uint64_t available_memory_mb = 0;
+    uint64_t total_data_mb = 0;
+    int32_t requested_channels = 0;
+    std::string_view player_name;
+};
+
+template <> struct MessageSchema<ChannelNegotiationMessage> {
+    static constexpr auto kFields = std::make_tuple(
+        Field<&ChannelNegotiationMessage::message_id, 1>{"messageId"},
+        Field<&ChannelNegotiationMessage::timestamp, 2>{"timestamp"},
+        Field<&ChannelNegotiationMessage::response_to, 3>{"responseTo"},
+        Field<&ChannelNegotiationMessage::mod_count, 4>{"modCount"},
+        Field<&ChannelNegotiationMessage::large_mod_count, 5>{"largeModCount"},
+        Field<&ChannelNegotiationMessage::small_mod_count, 6>{"smallModCount"},
+        Field<&ChannelNegotiationMessage::available_memory_mb, 7>{"availableMemoryMB"},
+        Field<&ChannelNegotiationMessage::total_data_mb, 8>{"totalDataMB"},
+        Field<&ChannelNegotiationMessage::requested_channels, 9>{"requestedChannels"},
+        Field<&ChannelNegotiationMessage::player_name, 10>{"playerName"});
+};
+
+struct ChannelNegotiationResponse {
+    static constexpr uint32_t kType = 13;
+
+    std::string_view message_id;
+    int64_t timestamp = 0;
+    std::optional<std::string_view> response_to;
+    int32_t my_channels = 0;
+    int32_t your_channels = 0;
+    uint64_t limiting_memory_mb = 0;
+    std::string_view player_name;
+};
+
+template <> struct MessageSchema<ChannelNegotiationResponse> {
+    static constexpr auto kFields = std::make_tuple(
+        Field<&ChannelNegotiationResponse::message_id, 1>{"messageId"},
+        Field<&ChannelNegotiationResponse::timestamp, 2>{"timestamp"},
+        Field<&ChannelNegotiationResponse::response_to, 3>{"responseTo"},
+        Field<&ChannelNegotiationResponse::my_channels, 4>{"myChannels"},
+        Field<&ChannelNegotiationResponse::your_channels, 5>{"yourChannels"},
+        Field<&ChannelNegotiationResponse::limiting_memory_mb, 6>{"limitingMemoryMB"},
+        Field<&ChannelNegotiationResponse::player_name, 7>{"playerName"});
+};
+
+struct ReconnectOfferMessage {
+    static constexpr uint32_t kType = 14;
+
+    std::string_view message_id;
+    int64_t timestamp = 0;
+    std::optional<std::string_view> response_to;
+    std::string_view target_peer_id;
+    std::string_view source_peer_id;
+    std::string_view offer_sdp;
+    std::string_view recovery_session_id;
+};
+
+template <> struct MessageSchema<ReconnectOfferMessage> {
+    static constexpr auto kFields = std::make_tuple(
+        Field<&ReconnectOfferMessage::message_id, 1>{"messageId"},
+        Field<&ReconnectOfferMessage::timestamp, 2>{"timestamp"},
+        Field<&ReconnectOfferMessage::response_to, 3>{"responseTo"},
+        Field<&ReconnectOfferMessage::target_peer_id, 4>{"targetPeerId"},
+        Field<&ReconnectOfferMessage::source_peer_id, 5>{"sourcePeerId"},
+        Field<&ReconnectOfferMessage::offer_sdp, 6>{"offerSdp"},
+        Field<&ReconnectOfferMessage::recovery_session_id, 7>{"recoverySessionId"});
+};
+
+struct ReconnectAnswerMessage {
+    static constexpr uint32_t kType = 15;
+
+    std::string_view message_id;
+    int64_t timestamp = 0;
+    std::optional<std::string_view> response_to;
+    std::string_view target_peer_id;
+    std::string_view source_peer_id;
+    std::string_view answer_sdp;
+    std::string_view recovery_session_id;
+};
+
+template <> struct MessageSchema<ReconnectAnswerMessage> {
+    static constexpr auto kFields = std::make_tuple(
+        Field<&ReconnectAnswerMessage::message_id, 1>{"messageId"},
+        Field<&ReconnectAnswerMessage::timestamp, 2>{"timestamp"},
+        Field<&ReconnectAnswerMessage::response_to, 3>{"responseTo"},
+        Field<&ReconnectAnswerMessage::target_peer_id, 4>{"targetPeerId"},
+        Field<&ReconnectAnswerMessage::source_peer_id, 5>{"sourcePeerId"},
+        Field<&ReconnectAnswerMessage::answer_sdp, 6>{"answerSdp"},
+        Field<&ReconnectAnswerMessage::recovery_session_id, 7>{"recoverySessionId"});
+};
+
+struct RecoveryRequestMessage {
+    static constexpr uint32_t kType = 16;
+
+    std::string_view message_id;
+    int64_t timestamp = 0;
+    std::optional<std::string_view> response_to;
+    std::string_view syncshell_id;
+    std::string_view peer_id;
+    List<std::string_view> completed_files;
+    List<MapEntry<std::string_view>> completed_hashes;
+};
+
+template <> struct MessageSchema<RecoveryRequestMessage> {
+    static constexpr auto kFields = std::make_tuple(
+        Field<&RecoveryRequestMessage::message_id, 1>{"messageId"},
+        Field<&RecoveryRequestMessage::timestamp, 2>{"timestamp"},
+        Field<&RecoveryRequestMessage::response_to, 3>{"responseTo"},
+        Field<&RecoveryRequestMessage::syncshell_id, 4>{"syncshellId"},
+        Field<&RecoveryRequestMessage::peer_id, 5>{"peerId"},
+        Field<&RecoveryRequestMessage::completed_files, 6>{"completedFiles"},
+        Field<&RecoveryRequestMessage::completed_hashes, 7>{"completedHashes"});
+};
+
+template <typename T> size_t Encode(const T& message, uint8_t* out, size_t capacity) {
+    return Encode(message, out, capacity, kSchemaVersion);
+}
+
+// Decodes a frame and calls visitor(message) with the concrete message type
+template <typename Visitor> bool DecodeFrame(const uint8_t* data, size_t size, Visitor&& visitor) {
+    FrameHeader header;
+    if (!ReadFrameHeader(data, size, header)) return false;
+    switch (header.message_type) {
+    case ModDataRequest::kType: {
+        ModDataRequest message;
+        if (!Decode(header, message)) return false;
+        visitor(message);
+        return true;
+    }
+    case ModDataResponse::kType: {
+        ModDataResponse message;
+        if (!Decode(header, message)) return false;
+        visitor(message);
+        return true;
+    }
+    case ComponentRequest::kType: {
+        ComponentRequest message;
+        if (!Decode(header, message)) return false;
+        visitor(message);
+        return true;
+    }
+    case ComponentResponse::kType: {
+        ComponentResponse message;
+        if (!Decode(header, message)) return false;
+        visitor(message);
+        return true;
+    }
+    case ModApplicationRequest::kType: {
+        ModApplicationRequest message;
+        if (!Decode(header, message)) return false;
+        visitor(message);
+        return true;
+    }
+    case ModApplicationResponse::kType: {
+        ModApplicationResponse message;
+        if (!Decode(header, message)) return false;
+        visitor(message);
+        return true;
+    }
+    case SyncCompleteMessage::kType: {
+        SyncCompleteMessage message;
+        if (!Decode(header, message)) return false;
+        visitor(message);
+        return true;
+    }
+    case ErrorMessage::kType: {
+        ErrorMessage message;
+        if (!Decode(header, message)) return false;
+        visitor(message);
+        return true;
+    }
+    case ChunkedMessage::kType: {
+        ChunkedMessage message;
+        if (!Decode(header, message)) return false;
+        visitor(message);
+        return true;
+    }
+    case FileChunkMessage::kType: {
+        FileChunkMessage message;
+        if (!Decode(header, message)) return false;
+        visitor(message);
+        return true;
+    }
+    case MemberListRequestMessage::kType: {
+        MemberListRequestMessage message;
+        if (!Decode(header, message)) return false;
+        visitor(message);
+        return true;
+    }
+    case MemberListResponseMessage::kType: {
+        MemberListResponseMessage message;
+        if (!Decode(header, message)) return false;
+        visitor(message);
+        return true;
+    }
+    case ChannelNegotiationMessage::kType: {
+        ChannelNegotiationMessage message;
+        if (!Decode(header, message)) return false;
+        visitor(message);
+        return true;
+    }
+    case ChannelNegotiationResponse::kType: {
+        ChannelNegotiationResponse message;
+        if (!Decode(header, message)) return false;
+        visitor(message);
+        return true;
+    }
+    case ReconnectOfferMessage::kType: {
+        ReconnectOfferMessage message;
+        if (!Decode(header, message)) return false;
+        visitor(message);
+        return true;
+    }
+    case ReconnectAnswerMessage::kType: {
+        ReconnectAnswerMessage message;
+        if (!Decode(header, message)) return false;
+        visitor(message);
+        return true;
+    }
+    case RecoveryRequestMessage::kType: {
+        RecoveryRequestMessage message;
+        if (!Decode(header, message)) return false;
+        visitor(message);
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+}
@@ -0,0 +1,397 @@
+#include "gossip.h"
+#include "frame_util.h"
+#include "state_hasher.h"
+#include "wire_codec.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace fyteclub {
+
+using wire::ReadVarint;
+
+namespace {
+
+bool ReadString(const uint8_t*& p, const uint8_t* end, std::string& out) {
+    const uint8_t* data;
+    size_t size;
+    if (!ReadBytes(p, end, data, size)) return false;
+    out.assign(reinterpret_cast<const char*>(data), size);
+    return true;
+}
+
+std::vector<uint8_t> BeginFrame(uint8_t kind) {
+    return {kGossipFrameType, kind};
+}
+
+}
+
+GossipEngine::GossipEngine(std::string self_id, const GossipConfig& config)
+    : self_id_(std::move(self_id)), config_(config), rng_(std::random_device{}()) {}
+
+uint64_t GossipEngine::EntryHash(const std::string& origin, uint64_t sequence) {
+    // Goes out in SUMMARY, so it must not depend on whether this build has xxhash.h
+    return StateHasher::WireHash(origin.data(), origin.size(), sequence);
+}
+
+bool GossipEngine::StoreLocked(const std::string& origin, uint64_t sequence, const uint8_t* payload, size_t size) {
+    if (size > config_.max_record_bytes) return false;
+    auto it = records_.find(origin);
+    if (it != records_.end()) {
+        if (sequence <= it->second.sequence) return false;
+        vector_hash_ -= EntryHash(origin, it->second.sequence);
+    } else {
+        it = records_.emplace(origin, Record{}).first;
+    }
+    // The vector hash is a sum, so replacing one record is a subtract and an add
+    vector_hash_ += EntryHash(origin, sequence);
+    it->second.sequence = sequence;
+    it->second.payload.assign(payload, payload + size);
+    return true;
+}
+
+uint64_t GossipEngine::Publish(const uint8_t* payload, size_t size) {
+    const uint64_t now_ms = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                      std::chrono::system_clock::now().time_since_epoch())
+                                                      .count());
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = records_.find(self_id_);
+    uint64_t sequence = std::max(now_ms, self_floor_ + 1);
+    if (it != records_.end()) sequence = std::max(sequence, it->second.sequence + 1);
+    return StoreLocked(self_id_, sequence, payload, size) ? sequence : 0;
+}
+
+void GossipEngine::OutrunLocked(uint64_t sequence) {
+    // Someone holds our record from an earlier run (or a clock that was
+    // ahead): republish the current payload past it so ours wins again
+    if (sequence <= self_floor_) return;
+    self_floor_ = sequence;
+    auto it = records_.find(self_id_);
+    if (it == records_.end() || it->second.sequence >= sequence) return;
+    std::vector<uint8_t> payload = it->second.payload;
+    StoreLocked(self_id_, sequence + 1, payload.data(), payload.size());
+}
+
+void GossipEngine::AddUpdateLocked(GossipUpdate update) {
+    auto it = updates_.find(update.origin);
+    if (it != updates_.end()) {
+        // A peer re-offering a record, or a newer one from another: keep the newest
+        if (update.sequence > it->second.sequence) it->second = std::move(update);
+        return;
+    }
+    // Dropped candidates are offered again by the next round's digest
+    if (updates_.size() >= config_.max_pending_updates) return;
+    update_order_.push_back(update.origin);
+    updates_.emplace(update.origin, std::move(update));
+}
+
+bool GossipEngine::Merge(const std::string& origin, uint64_t sequence, const uint8_t* payload, size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return StoreLocked(origin, sequence, payload, size);
+}
+
+void GossipEngine::AddPeer(uint64_t peer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (std::find(peers_.begin(), peers_.end(), peer) == peers_.end()) peers_.push_back(peer);
+}
+
+void GossipEngine::RemovePeer(uint64_t peer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    peers_.erase(std::remove(peers_.begin(), peers_.end(), peer), peers_.end());
+}
+
+void GossipEngine::QueueLocked(uint64_t peer, std::vector<uint8_t> frame) {
+    outgoing_.push_back({peer, std::move(frame)});
+}
+
+std::vector<uint8_t> GossipEngine::SummaryLocked() const {
+    auto frame = BeginFrame(Summary);
+    AppendVarint(frame, vector_hash_);
+    AppendVarint(frame, records_.size());
+    SealFrame(frame);
+    return frame;
+}
+
+std::vector<uint8_t> GossipEngine::DigestLocked() const {
+    auto frame = BeginFrame(Digest);
+    AppendVarint(frame, records_.size());
+    for (const auto& record : records_) {
+        AppendBytes(frame, record.first.data(), record.first.size());
+        AppendVarint(frame, record.second.sequence);
+    }
+    SealFrame(frame);
+    return frame;
+}
+
+std::vector<uint8_t> GossipEngine::DeltaLocked(const std::vector<std::string>& push,
+                                               const std::vector<std::string>& wants) const {
+    std::vector<uint8_t> records;
+    size_t count = 0;
+    for (const auto& origin : push) {
+        auto it = records_.find(origin);
+        if (it == records_.end()) continue;
+        // Always send at least one record so an oversized frame still makes progress
+        if (count > 0 && records.size() + origin.size() + it->second.payload.size() + 32 > config_.max_frame_bytes) {
+            break;
+        }
+        AppendBytes(records, origin.data(), origin.size());
+        AppendVarint(records, it->second.sequence);
+        AppendBytes(records, it->second.payload.data(), it->second.payload.size());
+        count++;
+    }
+
+    auto frame = BeginFrame(Delta);
+    AppendVarint(frame, count);
+    frame.insert(frame.end(), records.begin(), records.end());
+    AppendVarint(frame, wants.size());
+    for (const auto& origin : wants) AppendBytes(frame, origin.data(), origin.size());
+    SealFrame(frame);
+    return frame;
+}
+
+size_t GossipEngine::Tick(uint64_t now_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (started_ && now_ms - last_round_ms_ < config_.interval_ms) return 0;
+    started_ = true;
+    last_round_ms_ = now_ms;
+
+    // Partial shuffle: the first `contacts` peers become a uniform random pick
+    size_t contacts = std::min<size_t>(config_.fanout, peers_.size());
+    for (size_t i = 0; i < contacts; ++i) {
+        std::uniform_int_distribution<size_t> pick(i, peers_.size() - 1);
+        std::swap(peers_[i], peers_[pick(rng_)]);
+        QueueLocked(peers_[i], SummaryLocked());
+    }
+    return contacts;
+}
+
+bool GossipEngine::OnFrame(uint64_t peer, const uint8_t* frame, size_t size) {
+    if (size < 2 + kFrameTrailerSize || frame[0] != kGossipFrameType) return false;
+    const uint8_t* end = frame + size - kFrameTrailerSize;
+    if (!FrameTrailerMatches(frame, size)) return false;
+    const uint8_t* p = frame + 2;
+
+    switch (frame[1]) {
+    case Summary: {
+        uint64_t hash, count;
+        if (!ReadVarint(p, end, hash) || !ReadVarint(p, end, count) || p != end) return false;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (hash != vector_hash_ || count != records_.size()) QueueLocked(peer, DigestLocked());
+        return true;
+    }
+    case Digest: {
+        uint64_t count;
+        if (!ReadVarint(p, end, count)) return false;
+        std::unordered_map<std::string, uint64_t> theirs;
+        for (uint64_t i = 0; i < count; ++i) {
+            std::string origin;
+            uint64_t sequence;
+            if (!ReadString(p, end, origin) || !ReadVarint(p, end, sequence)) return false;
+            theirs[std::move(origin)] = sequence;
+        }
+        if (p != end) return false;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto self = theirs.find(self_id_);
+        if (self != theirs.end()) OutrunLocked(self->second);
+        std::vector<std::string> push, wants;
+        for (const auto& record : records_) {
+            auto it = theirs.find(record.first);
+            if (it == theirs.end() || it->second < record.second.sequence) push.push_back(record.first);
+        }
+        for (const auto& entry : theirs) {
+            if (entry.first == self_id_) continue;
+            auto it = records_.find(entry.first);
+            if (it == records_.end() || it->second.sequence < entry.second) wants.push_back(entry.first);
+        }
+        if (!push.empty() || !wants.empty()) QueueLocked(peer, DeltaLocked(push, wants));
+        return true;
+    }
+    case Delta: {
+        uint64_t count;
+        if (!ReadVarint(p, end, count)) return false;
+        std::vector<GossipUpdate> received;
+        for (uint64_t i = 0; i < count; ++i) {
+            GossipUpdate update;
+            const uint8_t* payload;
+            size_t payload_size;
+            if (!ReadString(p, end, update.origin) || !ReadVarint(p, end, update.sequence) ||
+                !ReadBytes(p, end, payload, payload_size)) {
+                return false;
+            }
+            update.payload.assign(payload, payload + payload_size);
+            received.push_back(std::move(update));
+        }
+        uint64_t want_count;
+        if (!ReadVarint(p, end, want_count)) return false;
+        std::vector<std::string> wants;
+        for (uint64_t i = 0; i < want_count; ++i) {
+            std::string origin;
+            if (!ReadString(p, end, origin)) return false;
+            wants.push_back(std::move(origin));
+        }
+        if (p != end) return false;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& update : received) {
+            if (update.origin == self_id_) {
+                OutrunLocked(update.sequence);
+                continue;
+            }
+            // Candidates only: they enter records_ when the plugin Merges them
+            auto it = records_.find(update.origin);
+            if (update.payload.size() > config_.max_record_bytes ||
+                (it != records_.end() && it->second.sequence >= update.sequence)) {
+                continue;
+            }
+            AddUpdateLocked(std::move(update));
+        }
+        if (!wants.empty()) QueueLocked(peer, DeltaLocked(wants, {}));
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+bool GossipEngine::PopOutgoing(GossipOutgoing& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (outgoing_.empty()) return false;
+    out = std::move(outgoing_.front());
+    outgoing_.pop_front();
+    return true;
+}
+
+bool GossipEngine::PopUpdate(GossipUpdate& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (update_order_.empty()) return false;
+    auto it = updates_.find(update_order_.front());
+    out = std::move(it->second);
+    updates_.erase(it);
+    update_order_.pop_front();
+    return true;
+}
+
+bool GossipEngine::PeekOutgoingSize(size_t& size) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (outgoing_.empty()) return false;
+    size = outgoing_.front().frame.size();
+    return true;
+}
+
+bool GossipEngine::PeekUpdateSize(size_t& size) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (update_order_.empty()) return false;
+    size = updates_.at(update_order_.front()).payload.size();
+    return true;
+}
+
+uint64_t GossipEngine::VectorHash() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return vector_hash_;
+}
+
+size_t GossipEngine::RecordCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return records_.size();
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// C exports for the plugin
+// ---------------------------------------------------------------------------
+//
+// The plugin calls GossipTick from its framework update in place of
+// PollPhonebookUpdates' fixed interval, sends each GossipPopOutgoing frame on
+// the peer's data channel, and feeds received C8 frames to GossipOnFrame.
+
+extern "C" {
+
+__declspec(dllexport) void* CreateGossipEngine(const char* self_id, int interval_ms, int fanout) {
+    if (!self_id) return nullptr;
+    fyteclub::GossipConfig config;
+    if (interval_ms > 0) config.interval_ms = static_cast<uint32_t>(interval_ms);
+    if (fanout > 0) config.fanout = static_cast<uint32_t>(fanout);
+    return new fyteclub::GossipEngine(self_id, config);
+}
+
+__declspec(dllexport) uint64_t GossipPublish(void* engine, const uint8_t* payload, int size) {
+    if (!engine || !payload || size < 0) return 0;
+    return static_cast<fyteclub::GossipEngine*>(engine)->Publish(payload, static_cast<size_t>(size));
+}
+
+// 1 = stored, 0 = not newer (or too large)
+__declspec(dllexport) int GossipMerge(void* engine, const char* origin, uint64_t sequence, const uint8_t* payload,
+                                      int size) {
+    if (!engine || !origin || !payload || size < 0) return 0;
+    return static_cast<fyteclub::GossipEngine*>(engine)->Merge(origin, sequence, payload, static_cast<size_t>(size))
+               ? 1
+               : 0;
+}
+
+__declspec(dllexport) void GossipAddPeer(void* engine, uint64_t peer) {
+    if (engine) static_cast<fyteclub::GossipEngine*>(engine)->AddPeer(peer);
+}
+
+__declspec(dllexport) void GossipRemovePeer(void* engine, uint64_t peer) {
+    if (engine) static_cast<fyteclub::GossipEngine*>(engine)->RemovePeer(peer);
+}
+
+__declspec(dllexport) int GossipTick(void* engine, uint64_t now_ms) {
+    return engine ? static_cast<int>(static_cast<fyteclub::GossipEngine*>(engine)->Tick(now_ms)) : 0;
+}
+
+// 0 = handled, -1 = not a valid gossip frame
+__declspec(dllexport) int GossipOnFrame(void* engine, uint64_t peer, const uint8_t* frame, int size) {
+    if (!engine || !frame || size < 0) return -1;
+    return static_cast<fyteclub::GossipEngine*>(engine)->OnFrame(peer, frame, static_cast<size_t>(size)) ? 0 : -1;
+}
+
+// Returns the frame size and fills peer when a frame was waiting, 0 when
+// none, or -(size needed) when capacity is too small (the frame stays queued)
+__declspec(dllexport) int GossipPopOutgoing(void* engine, uint64_t* peer, uint8_t* out, int capacity) {
+    if (!engine || !out || capacity < 0) return -1;
+    auto* gossip = static_cast<fyteclub::GossipEngine*>(engine);
+    size_t size;
+    if (!gossip->PeekOutgoingSize(size)) return 0;
+    if (size > static_cast<size_t>(capacity)) return -static_cast<int>(size);
+    fyteclub::GossipOutgoing outgoing;
+    gossip->PopOutgoing(outgoing);
+    memcpy(out, outgoing.frame.data(), outgoing.frame.size());
+    if (peer) *peer = outgoing.peer;
+    return static_cast<int>(size);
+}
+
+// Pops a candidate record. Returns 1 and fills the outputs when one was
+// waiting, 0 when none, or -(payload size) when capacity is too small (the
+// record stays queued).
+__declspec(dllexport) int GossipPopUpdate(void* engine, char* origin, int origin_capacity, uint64_t* sequence,
+                                          uint8_t* payload, int capacity, int* payload_size) {
+    if (!engine || !payload || capacity < 0) return -1;
+    auto* gossip = static_cast<fyteclub::GossipEngine*>(engine);
+    size_t size;
+    if (!gossip->PeekUpdateSize(size)) return 0;
+    if (size > static_cast<size_t>(capacity)) return -static_cast<int>(size);
+    fyteclub::GossipUpdate update;
+    gossip->PopUpdate(update);
+    if (size > 0) memcpy(payload, update.payload.data(), size);
+    fyteclub::CopyString(update.origin, origin, origin_capacity);
+    if (sequence) *sequence = update.sequence;
+    if (payload_size) *payload_size = static_cast<int>(size);
+    return 1;
+}
+
+__declspec(dllexport) uint64_t GossipVectorHash(void* engine) {
+    return engine ? static_cast<fyteclub::GossipEngine*>(engine)->VectorHash() : 0;
+}
+
+__declspec(dllexport) int GossipRecordCount(void* engine) {
+    return engine ? static_cast<int>(static_cast<fyteclub::GossipEngine*>(engine)->RecordCount()) : 0;
+}
+
+__declspec(dllexport) void DestroyGossipEngine(void* engine) {
+    delete static_cast<fyteclub::GossipEngine*>(engine);
+}
+
+}
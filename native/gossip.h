@@ -0,0 +1,122 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Push-pull gossip for phonebook state. The framework polls every
+// _phonebookPollInterval and each member fetches the full phonebook from
+// whoever it is connected to. Here every member owns one versioned record
+// (its own phonebook entry) and, each round, sends a summary of what it
+// knows to a few random connected peers. Summaries that match end the
+// exchange, so a converged syncshell costs one small frame per peer per
+// round whatever its size. On a mismatch the full version vectors are
+// compared and only newer records cross, in both directions:
+//
+//   A -> B  SUMMARY  vector hash, record count
+//   B -> A  DIGEST   (origin, seq)*                        if hashes differ
+//   A -> B  DELTA    records B lacks | origins A wants     push + pull
+//   B -> A  DELTA    the records A asked for               if it asked
+//
+//   frame  C8 | kind | body | crc32c
+//
+// An update reaches every member in O(log n) rounds. Records are opaque
+// (the signed entry as the plugin serializes it). Incoming records are only
+// candidates: the plugin verifies each one and Merges it back, so a forged
+// record is never passed on. Frames go out through the existing data
+// channels: the engine only queues them, keyed by the plugin's peer handle.
+
+namespace fyteclub {
+
+constexpr uint8_t kGossipFrameType = 0xC8;
+
+struct GossipConfig {
+    uint32_t interval_ms = 1000;
+    uint32_t fanout = 3;
+    size_t max_frame_bytes = 256 * 1024; // records past this wait for the next round
+    size_t max_record_bytes = 64 * 1024;
+    size_t max_pending_updates = 1024;   // candidates past this are dropped and re-offered next round
+};
+
+struct GossipOutgoing {
+    uint64_t peer = 0;
+    std::vector<uint8_t> frame;
+};
+
+struct GossipUpdate {
+    std::string origin;
+    uint64_t sequence = 0;
+    std::vector<uint8_t> payload;
+};
+
+class GossipEngine {
+public:
+    GossipEngine(std::string self_id, const GossipConfig& config = {});
+
+    // Replaces our own record; returns its new sequence, or 0 if it is too
+    // large. Sequences follow the wall clock in milliseconds, so a restarted
+    // member outranks what peers kept from its last run; a peer found holding
+    // a higher one for us makes us republish past it.
+    uint64_t Publish(const uint8_t* payload, size_t size);
+    // Accepts a verified record, from PopUpdate or from elsewhere (e.g. a
+    // phonebook loaded from disk). False unless it is newer than what we hold.
+    bool Merge(const std::string& origin, uint64_t sequence, const uint8_t* payload, size_t size);
+
+    void AddPeer(uint64_t peer);
+    void RemovePeer(uint64_t peer);
+
+    // Starts a round when the interval has passed; returns how many peers were contacted
+    size_t Tick(uint64_t now_ms);
+    // False for a frame that is not valid gossip
+    bool OnFrame(uint64_t peer, const uint8_t* frame, size_t size);
+
+    bool PopOutgoing(GossipOutgoing& out);
+    // Records that arrived newer than ours, for the plugin to verify and
+    // Merge; only the newest candidate per origin is kept
+    bool PopUpdate(GossipUpdate& out);
+    // Sizes of the next queued frame / update payload, so callers with fixed
+    // buffers can leave them queued; false when the queue is empty
+    bool PeekOutgoingSize(size_t& size) const;
+    bool PeekUpdateSize(size_t& size) const;
+
+    uint64_t VectorHash() const;
+    size_t RecordCount() const;
+
+private:
+    enum Kind : uint8_t { Summary = 0, Digest = 1, Delta = 2 };
+
+    struct Record {
+        uint64_t sequence = 0;
+        std::vector<uint8_t> payload;
+    };
+
+    static uint64_t EntryHash(const std::string& origin, uint64_t sequence);
+    bool StoreLocked(const std::string& origin, uint64_t sequence, const uint8_t* payload, size_t size);
+    void OutrunLocked(uint64_t sequence);
+    void AddUpdateLocked(GossipUpdate update);
+    void QueueLocked(uint64_t peer, std::vector<uint8_t> frame);
+    std::vector<uint8_t> SummaryLocked() const;
+    std::vector<uint8_t> DigestLocked() const;
+    std::vector<uint8_t> DeltaLocked(const std::vector<std::string>& push, const std::vector<std::string>& wants) const;
+
+    const std::string self_id_;
+    const GossipConfig config_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Record> records_;
+    uint64_t vector_hash_ = 0; // sum of EntryHash over records_
+    std::vector<uint64_t> peers_;
+    uint64_t last_round_ms_ = 0;
+    bool started_ = false;
+    std::mt19937_64 rng_;
+    uint64_t self_floor_ = 0; // highest sequence seen for our own origin elsewhere
+    std::deque<GossipOutgoing> outgoing_;
+    std::unordered_map<std::string, GossipUpdate> updates_;
+    std::deque<std::string> update_order_; // origins in updates_, oldest first
+};
+
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <string>
+
+// Extra ICE servers for the native peer connection, on top of the STUN
+// server passed to InitializePeerConnection. TURN relays registered with
+// AddIceServer before InitializePeerConnection are gathered and checked
+// alongside STUN from the start, so a peer that only gets through via TURN
+// does not wait for every STUN check to fail first. Check pacing and
+// renomination are left to the ICE library.
+
+namespace fyteclub {
+
+struct IceServerEntry {
+    std::string uri; // stun:host:port, turn:host:port or turns:host:port
+    std::string username;
+    std::string password;
+};
+
+}
@@ -0,0 +1,139 @@
+#include "inflight_registry.h"
+#include "frame_util.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace fyteclub {
+
+std::string InflightRegistry::Key(const std::string& hash) {
+    // Hashes arrive from both sides in either case
+    std::string key = hash;
+    for (auto& c : key) c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+    return key;
+}
+
+InflightClaim InflightRegistry::Claim(const std::string& hash, uint64_t waiter) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto key = Key(hash);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        entries_[key].owner = waiter;
+        return InflightClaim::Owner;
+    }
+    auto& entry = it->second;
+    if (entry.owner == waiter) return InflightClaim::Owner;
+    if (std::find(entry.waiters.begin(), entry.waiters.end(), waiter) == entry.waiters.end()) {
+        entry.waiters.push_back(waiter);
+    }
+    return InflightClaim::Attached;
+}
+
+void InflightRegistry::Complete(const std::string& hash, uint64_t owner, bool success, const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto key = Key(hash);
+    auto it = entries_.find(key);
+    if (it == entries_.end() || it->second.owner != owner) return;
+
+    if (!success) {
+        FailLocked(key, it->second);
+        if (it->second.owner == owner) entries_.erase(it);
+        return;
+    }
+    for (uint64_t waiter : it->second.waiters) {
+        notifications_.push_back({waiter, InflightEvent::Completed, key, path});
+    }
+    entries_.erase(it);
+}
+
+void InflightRegistry::Release(const std::string& hash, uint64_t waiter) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto key = Key(hash);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) return;
+    auto& entry = it->second;
+    if (entry.owner != waiter) {
+        entry.waiters.erase(std::remove(entry.waiters.begin(), entry.waiters.end(), waiter), entry.waiters.end());
+        return;
+    }
+    FailLocked(key, entry);
+    if (entry.owner == waiter) entries_.erase(it);
+}
+
+// Hands the download to the oldest waiter; leaves owner unchanged when there is none
+void InflightRegistry::FailLocked(const std::string& key, Entry& entry) {
+    if (entry.waiters.empty()) return;
+    entry.owner = entry.waiters.front();
+    entry.waiters.pop_front();
+    notifications_.push_back({entry.owner, InflightEvent::Promoted, key, {}});
+}
+
+bool InflightRegistry::IsInflight(const std::string& hash) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.count(Key(hash)) != 0;
+}
+
+size_t InflightRegistry::Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+bool InflightRegistry::PopNotification(InflightNotification& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (notifications_.empty()) return false;
+    out = std::move(notifications_.front());
+    notifications_.pop_front();
+    return true;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// C exports for the plugin
+// ---------------------------------------------------------------------------
+
+extern "C" {
+
+__declspec(dllexport) void* CreateInflightRegistry() {
+    return new fyteclub::InflightRegistry();
+}
+
+__declspec(dllexport) uint64_t InflightNewWaiterId(void* registry) {
+    return registry ? static_cast<fyteclub::InflightRegistry*>(registry)->NewWaiterId() : 0;
+}
+
+// 0 = owner (download it), 1 = attached (cancel the duplicate, wait), -1 = bad arguments
+__declspec(dllexport) int InflightClaim(void* registry, const char* hash, uint64_t waiter) {
+    if (!registry || !hash) return -1;
+    return static_cast<int>(static_cast<fyteclub::InflightRegistry*>(registry)->Claim(hash, waiter));
+}
+
+__declspec(dllexport) void InflightComplete(void* registry, const char* hash, uint64_t owner, int success,
+                                            const char* path) {
+    if (!registry || !hash) return;
+    static_cast<fyteclub::InflightRegistry*>(registry)->Complete(hash, owner, success != 0, path ? path : "");
+}
+
+__declspec(dllexport) void InflightRelease(void* registry, const char* hash, uint64_t waiter) {
+    if (registry && hash) static_cast<fyteclub::InflightRegistry*>(registry)->Release(hash, waiter);
+}
+
+// Returns 1 and fills the outputs when a notification was waiting, else 0.
+// event: 0 = completed, 1 = promoted to owner
+__declspec(dllexport) int InflightPopNotification(void* registry, uint64_t* waiter, int* event, char* hash,
+                                                  int hash_capacity, char* path, int path_capacity) {
+    if (!registry) return 0;
+    fyteclub::InflightNotification notification;
+    if (!static_cast<fyteclub::InflightRegistry*>(registry)->PopNotification(notification)) return 0;
+    if (waiter) *waiter = notification.waiter;
+    if (event) *event = static_cast<int>(notification.event);
+    fyteclub::CopyString(notification.hash, hash, hash_capacity);
+    fyteclub::CopyString(notification.path, path, path_capacity);
+    return 1;
+}
+
+__declspec(dllexport) void DestroyInflightRegistry(void* registry) {
+    delete static_cast<fyteclub::InflightRegistry*>(registry);
+}
+
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Downloads in flight, keyed by content hash, shared by every peer and
+// session. Two players wearing the same mod, or a ComponentRequest racing a
+// full ModDataResponse, would otherwise fetch and store the same bytes twice.
+//
+// The first Claim for a hash becomes the owner and downloads it; later claims
+// attach as waiters and should cancel their own inbound stream. When the
+// owner completes, every waiter is notified with the result. If the owner
+// fails or goes away, the oldest waiter is promoted and should fetch the
+// content itself from its peer. Notifications are polled, like the other
+// native queues, so they can be drained on the plugin's own thread.
+
+namespace fyteclub {
+
+enum class InflightClaim {
+    Owner,    // caller downloads
+    Attached, // someone else is downloading; wait for a notification
+};
+
+enum class InflightEvent {
+    Completed, // content stored at path
+    Promoted,  // previous owner failed; caller is now the owner and must download
+};
+
+struct InflightNotification {
+    uint64_t waiter = 0;
+    InflightEvent event = InflightEvent::Completed;
+    std::string hash;
+    std::string path;
+};
+
+class InflightRegistry {
+public:
+    // Unique ids for callers that have none of their own
+    uint64_t NewWaiterId() { return next_waiter_++; }
+
+    // Claiming again with the same id is harmless: a promoted waiter gets
+    // Owner, one still waiting stays attached once
+    InflightClaim Claim(const std::string& hash, uint64_t waiter);
+    // Owner finished. On failure the oldest waiter is promoted; with no
+    // waiters left the hash is simply forgotten.
+    void Complete(const std::string& hash, uint64_t owner, bool success, const std::string& path = {});
+    // Caller no longer wants the content; an owner releasing counts as a failure
+    void Release(const std::string& hash, uint64_t waiter);
+
+    bool IsInflight(const std::string& hash) const;
+    size_t Size() const;
+    bool PopNotification(InflightNotification& out);
+
+private:
+    struct Entry {
+        uint64_t owner = 0;
+        std::deque<uint64_t> waiters;
+    };
+
+    static std::string Key(const std::string& hash);
+    void FailLocked(const std::string& key, Entry& entry);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::deque<InflightNotification> notifications_;
+    std::atomic<uint64_t> next_waiter_{1};
+};
+
+}
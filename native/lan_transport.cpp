@@ -0,0 +1,550 @@
+#include "lan_transport.h"
+#include "buffer_arena.h"
+#include "chacha20_poly1305.h"
+#include "sha256.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <random>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace fyteclub {
+
+namespace {
+
+#ifdef _WIN32
+using NativeSocket = SOCKET;
+const NativeSocket kInvalidSocket = INVALID_SOCKET;
+
+bool InitializeSockets() {
+    static const bool initialized = [] {
+        WSADATA data;
+        return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    }();
+    return initialized;
+}
+
+void CloseSocket(NativeSocket s) { closesocket(s); }
+int PollSockets(pollfd* fds, unsigned count, int timeout_ms) { return WSAPoll(fds, count, timeout_ms); }
+bool WouldBlock() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+
+void SetBlocking(NativeSocket s, bool blocking) {
+    u_long mode = blocking ? 0 : 1;
+    ioctlsocket(s, FIONBIO, &mode);
+}
+#else
+using NativeSocket = int;
+const NativeSocket kInvalidSocket = -1;
+
+bool InitializeSockets() { return true; }
+void CloseSocket(NativeSocket s) { close(s); }
+int PollSockets(pollfd* fds, unsigned count, int timeout_ms) { return poll(fds, count, timeout_ms); }
+bool WouldBlock() { return errno == EINPROGRESS || errno == EWOULDBLOCK || errno == EAGAIN; }
+
+void SetBlocking(NativeSocket s, bool blocking) {
+    int flags = fcntl(s, F_GETFL, 0);
+    fcntl(s, F_SETFL, blocking ? (flags & ~O_NONBLOCK) : (flags | O_NONBLOCK));
+}
+#endif
+
+NativeSocket ToNative(intptr_t s) { return static_cast<NativeSocket>(s); }
+intptr_t FromNative(NativeSocket s) { return static_cast<intptr_t>(s); }
+
+constexpr uint8_t kMagic[4] = {'F', 'C', 'L', 'N'};
+// 2: messages are sealed with ChaCha20-Poly1305 under per-direction session keys
+constexpr uint8_t kProtocolVersion = 2;
+constexpr size_t kNonceSize = 16;
+constexpr size_t kHelloSize = sizeof(kMagic) + 1 + kNonceSize;
+constexpr uint8_t kAccepted = 1;
+constexpr int kSocketBufferSize = 4 * 1024 * 1024;
+constexpr int kHandshakeTimeoutMs = 5000;
+
+using Clock = std::chrono::steady_clock;
+
+int RemainingMs(Clock::time_point deadline) {
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+    return remaining > 0 ? static_cast<int>(remaining) : 0;
+}
+
+bool WaitFor(NativeSocket s, short events, Clock::time_point deadline) {
+    pollfd fd{};
+    fd.fd = s;
+    fd.events = events;
+    int remaining = RemainingMs(deadline);
+    return remaining > 0 && PollSockets(&fd, 1, remaining) == 1 && (fd.revents & events);
+}
+
+bool SendAll(NativeSocket s, const uint8_t* data, size_t length) {
+    while (length > 0) {
+        int chunk = static_cast<int>(length > (1u << 30) ? (1u << 30) : length);
+        int sent = send(s, reinterpret_cast<const char*>(data), chunk, 0);
+        if (sent <= 0) return false;
+        data += sent;
+        length -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+bool ReceiveAll(NativeSocket s, uint8_t* data, size_t length) {
+    while (length > 0) {
+        int chunk = static_cast<int>(length > (1u << 30) ? (1u << 30) : length);
+        int received = recv(s, reinterpret_cast<char*>(data), chunk, 0);
+        if (received <= 0) return false;
+        data += received;
+        length -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+// Handshake reads are bounded so a silent peer cannot hold a listener
+bool ReceiveAllBefore(NativeSocket s, uint8_t* data, size_t length, Clock::time_point deadline) {
+    while (length > 0) {
+        if (!WaitFor(s, POLLIN, deadline)) return false;
+        int received = recv(s, reinterpret_cast<char*>(data), static_cast<int>(length), 0);
+        if (received <= 0) return false;
+        data += received;
+        length -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+void TuneSocket(NativeSocket s) {
+    int one = 1;
+    int buffer = kSocketBufferSize;
+    setsockopt(s, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&one), sizeof(one));
+    setsockopt(s, SOL_SOCKET, SO_SNDBUF, reinterpret_cast<const char*>(&buffer), sizeof(buffer));
+    setsockopt(s, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&buffer), sizeof(buffer));
+}
+
+void RandomNonce(uint8_t nonce[kNonceSize]) {
+    std::random_device device;
+    for (size_t i = 0; i < kNonceSize; i += 4) {
+        uint32_t value = device();
+        memcpy(nonce + i, &value, 4);
+    }
+}
+
+// HMAC(key, label | client nonce | server nonce); the label keeps the two
+// proofs distinct so one side cannot reflect the other's
+void Proof(const std::vector<uint8_t>& key, const char* label, const uint8_t* client_nonce, const uint8_t* server_nonce,
+           uint8_t mac[Sha256::kDigestSize]) {
+    uint8_t message[16 + 2 * kNonceSize] = {};
+    memcpy(message, label, strlen(label));
+    memcpy(message + 16, client_nonce, kNonceSize);
+    memcpy(message + 16 + kNonceSize, server_nonce, kNonceSize);
+    Sha256::Hmac(key.data(), key.size(), message, sizeof(message), mac);
+}
+
+// One key per direction, so the two counters can never reuse a nonce under
+// the same key
+struct SessionKeys {
+    uint8_t client_to_server[kAeadKeySize];
+    uint8_t server_to_client[kAeadKeySize];
+};
+
+static_assert(Sha256::kDigestSize == kAeadKeySize, "session keys are HMAC-SHA256 outputs");
+
+void DeriveSessionKeys(const std::vector<uint8_t>& key, const uint8_t* client_nonce, const uint8_t* server_nonce,
+                       SessionKeys& keys) {
+    Proof(key, "FCLAN c2s key", client_nonce, server_nonce, keys.client_to_server);
+    Proof(key, "FCLAN s2c key", client_nonce, server_nonce, keys.server_to_client);
+}
+
+// Message counter in the last 8 bytes, little-endian
+void SequenceNonce(uint64_t sequence, uint8_t nonce[kAeadNonceSize]) {
+    memset(nonce, 0, 4);
+    for (int i = 0; i < 8; ++i) nonce[4 + i] = static_cast<uint8_t>(sequence >> (i * 8));
+}
+
+bool ConstantTimeEqual(const uint8_t* a, const uint8_t* b, size_t length) {
+    uint8_t difference = 0;
+    for (size_t i = 0; i < length; ++i) difference |= a[i] ^ b[i];
+    return difference == 0;
+}
+
+bool ClientHandshake(NativeSocket s, const std::vector<uint8_t>& key, Clock::time_point deadline, SessionKeys& keys) {
+    uint8_t hello[kHelloSize];
+    memcpy(hello, kMagic, sizeof(kMagic));
+    hello[sizeof(kMagic)] = kProtocolVersion;
+    uint8_t* client_nonce = hello + sizeof(kMagic) + 1;
+    RandomNonce(client_nonce);
+    if (!SendAll(s, hello, sizeof(hello))) return false;
+
+    uint8_t reply[kNonceSize + Sha256::kDigestSize];
+    if (!ReceiveAllBefore(s, reply, sizeof(reply), deadline)) return false;
+    uint8_t expected[Sha256::kDigestSize];
+    Proof(key, "FCLAN server", client_nonce, reply, expected);
+    if (!ConstantTimeEqual(expected, reply + kNonceSize, sizeof(expected))) return false;
+
+    uint8_t proof[Sha256::kDigestSize];
+    Proof(key, "FCLAN client", client_nonce, reply, proof);
+    if (!SendAll(s, proof, sizeof(proof))) return false;
+
+    uint8_t accepted = 0;
+    if (!ReceiveAllBefore(s, &accepted, 1, deadline) || accepted != kAccepted) return false;
+    DeriveSessionKeys(key, client_nonce, reply, keys);
+    return true;
+}
+
+bool ServerHandshake(NativeSocket s, const std::vector<uint8_t>& key, Clock::time_point deadline, SessionKeys& keys) {
+    uint8_t hello[kHelloSize];
+    if (!ReceiveAllBefore(s, hello, sizeof(hello), deadline)) return false;
+    if (memcmp(hello, kMagic, sizeof(kMagic)) != 0 || hello[sizeof(kMagic)] != kProtocolVersion) return false;
+    const uint8_t* client_nonce = hello + sizeof(kMagic) + 1;
+
+    uint8_t reply[kNonceSize + Sha256::kDigestSize];
+    RandomNonce(reply);
+    Proof(key, "FCLAN server", client_nonce, reply, reply + kNonceSize);
+    if (!SendAll(s, reply, sizeof(reply))) return false;
+
+    uint8_t proof[Sha256::kDigestSize];
+    uint8_t expected[Sha256::kDigestSize];
+    if (!ReceiveAllBefore(s, proof, sizeof(proof), deadline)) return false;
+    Proof(key, "FCLAN client", client_nonce, reply, expected);
+    if (!ConstantTimeEqual(expected, proof, sizeof(expected))) return false;
+
+    if (!SendAll(s, &kAccepted, 1)) return false;
+    DeriveSessionKeys(key, client_nonce, reply, keys);
+    return true;
+}
+
+bool IsLanIPv4(const uint8_t* a) {
+    return a[0] == 10 || a[0] == 127 || (a[0] == 172 && (a[1] & 0xF0) == 16) || (a[0] == 192 && a[1] == 168) ||
+           (a[0] == 169 && a[1] == 254);
+}
+
+}
+
+bool IsLanAddress(const std::string& host) {
+    in_addr v4{};
+    if (inet_pton(AF_INET, host.c_str(), &v4) == 1) return IsLanIPv4(reinterpret_cast<const uint8_t*>(&v4));
+
+    in6_addr v6{};
+    std::string address = host.substr(0, host.find('%')); // drop the zone id of fe80::1%eth0
+    if (inet_pton(AF_INET6, address.c_str(), &v6) != 1) return false;
+    const uint8_t* a = reinterpret_cast<const uint8_t*>(&v6);
+    static const uint8_t kLoopback[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
+    static const uint8_t kMappedPrefix[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF};
+    if (memcmp(a, kLoopback, 16) == 0) return true;
+    if (memcmp(a, kMappedPrefix, 12) == 0) return IsLanIPv4(a + 12);
+    return (a[0] == 0xFE && (a[1] & 0xC0) == 0x80) || (a[0] & 0xFE) == 0xFC;
+}
+
+// ---------------------------------------------------------------------------
+// LanConnection
+// ---------------------------------------------------------------------------
+
+LanConnection::LanConnection(intptr_t socket, const uint8_t send_key[kAeadKeySize],
+                             const uint8_t receive_key[kAeadKeySize])
+    : socket_(socket) {
+    memcpy(send_key_, send_key, kAeadKeySize);
+    memcpy(receive_key_, receive_key, kAeadKeySize);
+}
+
+LanConnection::~LanConnection() {
+    if (ToNative(socket_) != kInvalidSocket) CloseSocket(ToNative(socket_));
+}
+
+bool LanConnection::Send(const uint8_t* data, size_t length) {
+    if (length > kLanMaxMessageSize) return false;
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    // One send per message: with TCP_NODELAY a separate 4-byte header write
+    // would go out as its own segment. Sealed in place in the same buffer.
+    send_buffer_.resize(4 + length + kAeadTagSize);
+    uint8_t* header = send_buffer_.data();
+    uint8_t* body = header + 4;
+    uint32_t size = static_cast<uint32_t>(length);
+    for (int i = 0; i < 4; ++i) header[i] = static_cast<uint8_t>(size >> (i * 8));
+    if (length > 0) memcpy(body, data, length);
+    uint8_t nonce[kAeadNonceSize];
+    SequenceNonce(send_sequence_++, nonce);
+    AeadSeal(send_key_, nonce, header, 4, body, length, body + length);
+    if (!SendAll(ToNative(socket_), send_buffer_.data(), send_buffer_.size())) return false;
+    bytes_sent_ += send_buffer_.size();
+    return true;
+}
+
+bool LanConnection::Receive(std::vector<uint8_t>& message) {
+    size_t size;
+    return ReceiveInto(nullptr, 0, message, size);
+}
+
+bool LanConnection::ReceiveInto(uint8_t* out, size_t capacity, std::vector<uint8_t>& overflow, size_t& size) {
+    uint8_t header[4];
+    if (!ReceiveAll(ToNative(socket_), header, sizeof(header))) return false;
+    size = uint32_t(header[0]) | (uint32_t(header[1]) << 8) | (uint32_t(header[2]) << 16) |
+           (uint32_t(header[3]) << 24);
+    if (size > kLanMaxMessageSize) return false;
+    uint8_t* target = out;
+    if (!out || size > capacity) {
+        overflow.resize(size);
+        target = overflow.data();
+    }
+    uint8_t tag[kAeadTagSize];
+    if (size > 0 && !ReceiveAll(ToNative(socket_), target, size)) return false;
+    if (!ReceiveAll(ToNative(socket_), tag, sizeof(tag))) return false;
+    uint8_t nonce[kAeadNonceSize];
+    SequenceNonce(receive_sequence_++, nonce);
+    if (!AeadOpen(receive_key_, nonce, header, sizeof(header), target, size, tag)) {
+        // Forged, replayed or reordered; nothing after it can be trusted either
+        Close();
+        return false;
+    }
+    bytes_received_ += sizeof(header) + size + sizeof(tag);
+    return true;
+}
+
+void LanConnection::Close() {
+    // Shutdown wakes a thread blocked in Receive; the socket is released in the destructor
+#ifdef _WIN32
+    shutdown(ToNative(socket_), SD_BOTH);
+#else
+    shutdown(ToNative(socket_), SHUT_RDWR);
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// LanListener / LanConnect
+// ---------------------------------------------------------------------------
+
+LanListener::LanListener(intptr_t socket, uint16_t port, const uint8_t* key, size_t key_size)
+    : socket_(socket), port_(port), key_(key, key + key_size) {}
+
+LanListener::~LanListener() {
+    CloseSocket(ToNative(socket_));
+}
+
+std::unique_ptr<LanListener> LanListener::Create(const uint8_t* key, size_t key_size, const std::string& bind_address,
+                                                 uint16_t port) {
+    if (!key || key_size == 0 || !IsLanAddress(bind_address) || !InitializeSockets()) return nullptr;
+
+    // Only the chosen LAN interface: a wildcard bind would also accept on
+    // public and VPN interfaces
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_NUMERICHOST | AI_NUMERICSERV | AI_PASSIVE;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(bind_address.c_str(), std::to_string(port).c_str(), &hints, &result) != 0 || !result) {
+        return nullptr;
+    }
+    NativeSocket s = socket(result->ai_family, SOCK_STREAM, IPPROTO_TCP);
+    bool bound = s != kInvalidSocket && bind(s, result->ai_addr, static_cast<int>(result->ai_addrlen)) == 0;
+    freeaddrinfo(result);
+    if (!bound) {
+        if (s != kInvalidSocket) CloseSocket(s);
+        return nullptr;
+    }
+
+    // Buffer sizes must be set before listen to apply to accepted sockets' window scaling
+    int buffer = kSocketBufferSize;
+    setsockopt(s, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&buffer), sizeof(buffer));
+    if (listen(s, 4) != 0) {
+        CloseSocket(s);
+        return nullptr;
+    }
+
+    sockaddr_storage local{};
+    socklen_t local_size = sizeof(local);
+    getsockname(s, reinterpret_cast<sockaddr*>(&local), &local_size);
+    uint16_t bound_port = local.ss_family == AF_INET6 ? ntohs(reinterpret_cast<sockaddr_in6*>(&local)->sin6_port)
+                                                       : ntohs(reinterpret_cast<sockaddr_in*>(&local)->sin_port);
+    return std::unique_ptr<LanListener>(new LanListener(FromNative(s), bound_port, key, key_size));
+}
+
+std::unique_ptr<LanConnection> LanListener::Accept(int timeout_ms) {
+    const auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+    NativeSocket listener = ToNative(socket_);
+    while (WaitFor(listener, POLLIN, deadline)) {
+        NativeSocket s = accept(listener, nullptr, nullptr);
+        if (s == kInvalidSocket) continue;
+        TuneSocket(s);
+        auto handshake_deadline = std::min(deadline, Clock::now() + std::chrono::milliseconds(kHandshakeTimeoutMs));
+        SessionKeys keys;
+        if (ServerHandshake(s, key_, handshake_deadline, keys)) {
+            return std::unique_ptr<LanConnection>(
+                new LanConnection(FromNative(s), keys.server_to_client, keys.client_to_server));
+        }
+        CloseSocket(s);
+    }
+    return nullptr;
+}
+
+std::unique_ptr<LanConnection> LanConnect(const std::string& host, uint16_t port, const uint8_t* key, size_t key_size,
+                                          int timeout_ms) {
+    if (!key || key_size == 0 || !InitializeSockets()) return nullptr;
+    const auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_NUMERICHOST | AI_NUMERICSERV;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &result) != 0 || !result) return nullptr;
+
+    NativeSocket s = socket(result->ai_family, SOCK_STREAM, IPPROTO_TCP);
+    if (s == kInvalidSocket) {
+        freeaddrinfo(result);
+        return nullptr;
+    }
+    TuneSocket(s);
+
+    SetBlocking(s, false);
+    int rc = connect(s, result->ai_addr, static_cast<int>(result->ai_addrlen));
+    freeaddrinfo(result);
+    bool connected = rc == 0;
+    if (!connected && WouldBlock() && WaitFor(s, POLLOUT, deadline)) {
+        int error = 0;
+        socklen_t length = sizeof(error);
+        getsockopt(s, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &length);
+        connected = error == 0;
+    }
+    SetBlocking(s, true);
+
+    std::vector<uint8_t> key_copy(key, key + key_size);
+    SessionKeys keys;
+    if (!connected || !ClientHandshake(s, key_copy, deadline, keys)) {
+        CloseSocket(s);
+        return nullptr;
+    }
+    return std::unique_ptr<LanConnection>(new LanConnection(FromNative(s), keys.client_to_server, keys.server_to_client));
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// C exports for the plugin
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct LanConnectionHandle {
+    std::unique_ptr<fyteclub::LanConnection> connection;
+    std::vector<uint8_t> pending;
+    bool has_pending = false;
+};
+
+constexpr int kMinimumKeySize = 16;
+
+}
+
+extern "C" {
+
+// The key is the per-session secret agreed over the data channel; bind_address
+// is the LAN address advertised to the peer (nullptr if it is not a LAN address)
+__declspec(dllexport) void* CreateLanListener(const uint8_t* key, int key_length, const char* bind_address, int port) {
+    if (!key || key_length < kMinimumKeySize || !bind_address || port < 0 || port > 65535) return nullptr;
+    return fyteclub::LanListener::Create(key, static_cast<size_t>(key_length), bind_address,
+                                         static_cast<uint16_t>(port))
+        .release();
+}
+
+__declspec(dllexport) int LanListenerPort(void* listener) {
+    return listener ? static_cast<fyteclub::LanListener*>(listener)->Port() : -1;
+}
+
+__declspec(dllexport) void* LanListenerAccept(void* listener, int timeout_ms) {
+    if (!listener) return nullptr;
+    auto connection = static_cast<fyteclub::LanListener*>(listener)->Accept(timeout_ms);
+    return connection ? new LanConnectionHandle{std::move(connection), {}, false} : nullptr;
+}
+
+__declspec(dllexport) void DestroyLanListener(void* listener) {
+    delete static_cast<fyteclub::LanListener*>(listener);
+}
+
+__declspec(dllexport) int IsLanPeerAddress(const char* host) {
+    return host && fyteclub::IsLanAddress(host) ? 1 : 0;
+}
+
+// Refuses addresses outside the local network; those stay on the data channel
+__declspec(dllexport) void* LanConnectPeer(const char* host, int port, const uint8_t* key, int key_length,
+                                           int timeout_ms) {
+    if (!host || !key || key_length < kMinimumKeySize || port <= 0 || port > 65535) return nullptr;
+    if (!fyteclub::IsLanAddress(host)) return nullptr;
+    auto connection = fyteclub::LanConnect(host, static_cast<uint16_t>(port), key, static_cast<size_t>(key_length),
+                                           timeout_ms);
+    return connection ? new LanConnectionHandle{std::move(connection), {}, false} : nullptr;
+}
+
+__declspec(dllexport) int LanSend(void* connection, const uint8_t* data, int length) {
+    auto* handle = static_cast<LanConnectionHandle*>(connection);
+    if (!handle || length < 0 || (!data && length > 0)) return -1;
+    return handle->connection->Send(data, static_cast<size_t>(length)) ? 0 : -1;
+}
+
+// 0 = message copied (size in *size), 1 = buffer too small (needed size in
+// *size, message kept for the next call), -1 = closed
+__declspec(dllexport) int LanReceive(void* connection, uint8_t* out, int capacity, int* size) {
+    auto* handle = static_cast<LanConnectionHandle*>(connection);
+    if (!handle || !size || capacity < 0) return -1;
+    if (!handle->has_pending) {
+        if (!handle->connection->Receive(handle->pending)) return -1;
+        handle->has_pending = true;
+    }
+    *size = static_cast<int>(handle->pending.size());
+    if (*size > capacity || (!out && *size > 0)) return 1;
+    if (*size > 0) memcpy(out, handle->pending.data(), handle->pending.size());
+    handle->has_pending = false;
+    return 0;
+}
+
+// LanReceive into a slot of a BufferArena, with no copy on either side.
+// 0 = message received (slot in *slot, now held by the caller until
+// BufferArenaRelease; size in *size), 1 = larger than a slot (kept for
+// LanReceive, needed size in *size), 2 = no free slot (nothing read), -1 = closed
+__declspec(dllexport) int LanReceiveSlot(void* connection, void* arena, int* slot, int* size) {
+    auto* handle = static_cast<LanConnectionHandle*>(connection);
+    auto* buffers = static_cast<fyteclub::BufferArena*>(arena);
+    if (!handle || !buffers || !slot || !size) return -1;
+    if (handle->has_pending) {
+        *size = static_cast<int>(handle->pending.size());
+        return 1;
+    }
+    int acquired = buffers->Acquire();
+    if (acquired < 0) return 2;
+    size_t received;
+    if (!handle->connection->ReceiveInto(buffers->Slot(acquired), buffers->SlotSize(), handle->pending, received)) {
+        buffers->Release(acquired);
+        return -1;
+    }
+    *size = static_cast<int>(received);
+    if (received > buffers->SlotSize()) {
+        buffers->Release(acquired);
+        handle->has_pending = true;
+        return 1;
+    }
+    *slot = acquired;
+    return 0;
+}
+
+// Unblocks a pending LanReceive; call DestroyLanConnection afterwards
+__declspec(dllexport) void LanShutdown(void* connection) {
+    if (auto* handle = static_cast<LanConnectionHandle*>(connection)) handle->connection->Close();
+}
+
+__declspec(dllexport) void DestroyLanConnection(void* connection) {
+    delete static_cast<LanConnectionHandle*>(connection);
+}
+
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include "chacha20_poly1305.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Direct TCP bulk path for peers on the same LAN. DTLS/SCTP data channels top
+// out well below gigabit on a local network; once the data channel has
+// exchanged a session key and each side's LAN address, the receiver opens a
+// LanListener, the sender connects, and chunk frames (chunk_frame.h) move
+// over TCP. Control traffic stays on the data channel.
+//
+// Both sides prove knowledge of the key with an HMAC-SHA256 challenge before
+// any data flows, then derive one session key per direction from the key and
+// both handshake nonces. Every message after that is sealed with
+// ChaCha20-Poly1305 (chacha20_poly1305.h) under a per-direction message
+// counter, so a stranger on the network can neither read a transfer nor
+// inject, replay, reorder or drop a message without the connection failing.
+//
+// Messages on the wire are a 4-byte little-endian payload length, the
+// encrypted payload and a 16-byte tag. The length is authenticated as well.
+
+namespace fyteclub {
+
+constexpr size_t kLanKeySize = 32;
+constexpr size_t kLanMaxMessageSize = 64 * 1024 * 1024;
+
+// Private (RFC 1918), link-local and loopback IPv4, plus IPv6 link-local,
+// unique-local and loopback. Only these are offered as LAN paths. Carrier-grade
+// NAT space (100.64/10) is shared with other subscribers and is not LAN.
+bool IsLanAddress(const std::string& host);
+
+class LanConnection {
+public:
+    ~LanConnection();
+    LanConnection(const LanConnection&) = delete;
+    LanConnection& operator=(const LanConnection&) = delete;
+
+    // Sends one message; safe to call from several threads
+    bool Send(const uint8_t* data, size_t length);
+    // Blocks for the next message; false once the peer closes or on error,
+    // including a message that fails authentication (the connection is then
+    // shut down). Only one thread should receive at a time.
+    bool Receive(std::vector<uint8_t>& message);
+    // Same, but a message that fits in capacity lands directly in out (e.g. a
+    // BufferArena slot); a larger one goes to overflow. size is set either way.
+    bool ReceiveInto(uint8_t* out, size_t capacity, std::vector<uint8_t>& overflow, size_t& size);
+    void Close();
+
+    uint64_t BytesSent() const { return bytes_sent_; }
+    uint64_t BytesReceived() const { return bytes_received_; }
+
+private:
+    friend class LanListener;
+    friend std::unique_ptr<LanConnection> LanConnect(const std::string& host, uint16_t port, const uint8_t* key,
+                                                     size_t key_size, int timeout_ms);
+    LanConnection(intptr_t socket, const uint8_t send_key[kAeadKeySize], const uint8_t receive_key[kAeadKeySize]);
+
+    intptr_t socket_;
+    uint8_t send_key_[kAeadKeySize];
+    uint8_t receive_key_[kAeadKeySize];
+    uint64_t send_sequence_ = 0;
+    uint64_t receive_sequence_ = 0;
+    std::mutex send_mutex_;
+    std::vector<uint8_t> send_buffer_;
+    uint64_t bytes_sent_ = 0;
+    uint64_t bytes_received_ = 0;
+};
+
+class LanListener {
+public:
+    // Binds only bind_address, the numeric address of the LAN interface the
+    // peer was told to connect to, on port (0 = ephemeral). Returns nullptr if
+    // the address is not a LAN address (IsLanAddress) or cannot be bound.
+    static std::unique_ptr<LanListener> Create(const uint8_t* key, size_t key_size, const std::string& bind_address,
+                                               uint16_t port = 0);
+    ~LanListener();
+    LanListener(const LanListener&) = delete;
+    LanListener& operator=(const LanListener&) = delete;
+
+    uint16_t Port() const { return port_; }
+    // Waits for a peer that passes the key challenge; connections that fail
+    // it are dropped and waiting continues until the timeout
+    std::unique_ptr<LanConnection> Accept(int timeout_ms);
+
+private:
+    LanListener(intptr_t socket, uint16_t port, const uint8_t* key, size_t key_size);
+
+    intptr_t socket_;
+    uint16_t port_;
+    std::vector<uint8_t> key_;
+};
+
+std::unique_ptr<LanConnection> LanConnect(const std::string& host, uint16_t port, const uint8_t* key, size_t key_size,
+                                          int timeout_ms);
+
+}
@@ -0,0 +1,361 @@
+#include "manifest_log.h"
+#include "frame_util.h"
+#include "wire_codec.h"
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+namespace fyteclub {
+
+using wire::ReadVarint;
+
+namespace {
+
+constexpr uint8_t kSnapshotFlag = 0x01;
+
+void AppendString(std::vector<uint8_t>& out, const std::string& value) {
+    AppendVarint(out, value.size());
+    out.insert(out.end(), value.begin(), value.end());
+}
+
+bool ReadString(const uint8_t*& p, const uint8_t* end, std::string& out) {
+    uint64_t length;
+    if (!ReadVarint(p, end, length) || length > static_cast<uint64_t>(end - p)) return false;
+    out.assign(reinterpret_cast<const char*>(p), static_cast<size_t>(length));
+    p += length;
+    return true;
+}
+
+void AppendOp(std::vector<uint8_t>& out, ManifestOpKind kind, const ManifestEntry& entry) {
+    out.push_back(static_cast<uint8_t>(kind));
+    AppendString(out, entry.type);
+    AppendString(out, entry.identifier);
+    AppendString(out, kind == ManifestOpKind::Remove ? std::string() : entry.hash);
+}
+
+uint64_t RandomEpoch() {
+    std::random_device device;
+    uint64_t epoch = 0;
+    while (epoch == 0) epoch = (uint64_t(device()) << 32) | device();
+    return epoch;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// ManifestLog
+// ---------------------------------------------------------------------------
+
+ManifestLog::ManifestLog(size_t max_ops, uint64_t epoch)
+    : max_ops_(std::max<size_t>(max_ops, 1)), epoch_(epoch ? epoch : RandomEpoch()) {}
+
+uint64_t ManifestLog::AppendLocked(ManifestOpKind kind, const Key& key, const std::string& hash) {
+    ManifestOp op;
+    op.sequence = ++version_;
+    op.kind = kind;
+    op.entry = {key.first, key.second, hash};
+    ops_.push_back(std::move(op));
+    if (ops_.size() > max_ops_) ops_.pop_front();
+    return version_;
+}
+
+uint64_t ManifestLog::Put(const std::string& type, const std::string& identifier, const std::string& hash) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Key key{type, identifier};
+    auto it = entries_.find(key);
+    if (it != entries_.end() && it->second == hash) return 0;
+    entries_[key] = hash;
+    return AppendLocked(ManifestOpKind::Put, key, hash);
+}
+
+uint64_t ManifestLog::Remove(const std::string& type, const std::string& identifier) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Key key{type, identifier};
+    if (!entries_.erase(key)) return 0;
+    return AppendLocked(ManifestOpKind::Remove, key, {});
+}
+
+uint64_t ManifestLog::Replace(const std::vector<ManifestEntry>& entries) {
+    std::map<Key, std::string> next;
+    for (const auto& entry : entries) next[{entry.type, entry.identifier}] = entry.hash;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint64_t before = version_;
+    for (const auto& current : entries_) {
+        if (!next.count(current.first)) AppendLocked(ManifestOpKind::Remove, current.first, {});
+    }
+    for (const auto& entry : next) {
+        auto it = entries_.find(entry.first);
+        if (it == entries_.end() || it->second != entry.second) {
+            AppendLocked(ManifestOpKind::Put, entry.first, entry.second);
+        }
+    }
+    entries_ = std::move(next);
+    return version_ == before ? 0 : version_;
+}
+
+uint64_t ManifestLog::Version() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return version_;
+}
+
+size_t ManifestLog::Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+std::vector<uint8_t> ManifestLog::DeltaSince(uint64_t epoch, uint64_t since_version) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<uint8_t> frame;
+    // A version from another epoch says nothing about ours, however high it is
+    const bool same_epoch = epoch == epoch_;
+    if (same_epoch && since_version >= version_) return frame;
+
+    // Sequences in the log are consecutive, so the first op after
+    // since_version sits at a fixed offset from the front
+    std::map<Key, const ManifestOp*> latest;
+    bool snapshot = !same_epoch || ops_.empty() || since_version + 1 < ops_.front().sequence;
+    if (!snapshot) {
+        for (size_t i = static_cast<size_t>(since_version + 1 - ops_.front().sequence); i < ops_.size(); ++i) {
+            latest[{ops_[i].entry.type, ops_[i].entry.identifier}] = &ops_[i];
+        }
+        snapshot = latest.size() > entries_.size();
+    }
+
+    frame.push_back(kManifestFrameType);
+    frame.push_back(snapshot ? kSnapshotFlag : 0);
+    AppendVarint(frame, epoch_);
+    AppendVarint(frame, snapshot ? 0 : since_version);
+    AppendVarint(frame, version_);
+    if (snapshot) {
+        AppendVarint(frame, entries_.size());
+        for (const auto& entry : entries_) {
+            AppendOp(frame, ManifestOpKind::Put, {entry.first.first, entry.first.second, entry.second});
+        }
+    } else {
+        AppendVarint(frame, latest.size());
+        for (const auto& op : latest) AppendOp(frame, op.second->kind, op.second->entry);
+    }
+    SealFrame(frame);
+    return frame;
+}
+
+// ---------------------------------------------------------------------------
+// ManifestReplica
+// ---------------------------------------------------------------------------
+
+ManifestApplyResult ManifestReplica::Apply(const uint8_t* frame, size_t size) {
+    if (size <= 2 + kFrameTrailerSize || frame[0] != kManifestFrameType) return ManifestApplyResult::Invalid;
+    const uint8_t* end = frame + size - kFrameTrailerSize;
+    if (!FrameTrailerMatches(frame, size)) return ManifestApplyResult::Invalid;
+
+    const uint8_t* p = frame + 1;
+    const bool snapshot = (*p++ & kSnapshotFlag) != 0;
+    uint64_t epoch, base, version, count;
+    if (!ReadVarint(p, end, epoch) || !ReadVarint(p, end, base) || !ReadVarint(p, end, version) ||
+        !ReadVarint(p, end, count) || epoch == 0) {
+        return ManifestApplyResult::Invalid;
+    }
+    // A snapshot of a restarted sender may still be at version 0 (and empty)
+    if (snapshot ? base != 0 : base >= version) return ManifestApplyResult::Invalid;
+    std::vector<ManifestChange> ops;
+    for (uint64_t i = 0; i < count; ++i) {
+        if (p >= end || *p > static_cast<uint8_t>(ManifestOpKind::Remove)) return ManifestApplyResult::Invalid;
+        ManifestChange op;
+        op.kind = static_cast<ManifestOpKind>(*p++);
+        if (!ReadString(p, end, op.entry.type) || !ReadString(p, end, op.entry.identifier) ||
+            !ReadString(p, end, op.entry.hash)) {
+            return ManifestApplyResult::Invalid;
+        }
+        ops.push_back(std::move(op));
+    }
+    if (p != end) return ManifestApplyResult::Invalid;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const bool same_epoch = epoch == epoch_;
+    if (!snapshot) {
+        // From another epoch only a delta from the very start can be applied,
+        // and only onto a replica that holds nothing yet
+        if (same_epoch ? base > version_ : base != 0 || version_ != 0) return ManifestApplyResult::NeedSnapshot;
+    }
+    // Stale or duplicate frame: every op in it is already reflected here
+    if (same_epoch && version <= version_) return ManifestApplyResult::Applied;
+
+    if (snapshot) {
+        std::map<Key, std::string> next;
+        for (auto& op : ops) next[{op.entry.type, op.entry.identifier}] = op.entry.hash;
+        for (const auto& current : entries_) {
+            if (!next.count(current.first)) {
+                changes_.push_back({ManifestOpKind::Remove, {current.first.first, current.first.second, {}}});
+            }
+        }
+        for (const auto& entry : next) {
+            auto it = entries_.find(entry.first);
+            if (it == entries_.end() || it->second != entry.second) {
+                changes_.push_back({ManifestOpKind::Put, {entry.first.first, entry.first.second, entry.second}});
+            }
+        }
+        entries_ = std::move(next);
+    } else {
+        // Ops are the latest per component, so replaying ones we already
+        // have (base below our version) is harmless
+        for (auto& op : ops) {
+            Key key{op.entry.type, op.entry.identifier};
+            auto it = entries_.find(key);
+            if (op.kind == ManifestOpKind::Remove) {
+                if (it == entries_.end()) continue;
+                entries_.erase(it);
+            } else {
+                if (it != entries_.end() && it->second == op.entry.hash) continue;
+                entries_[key] = op.entry.hash;
+            }
+            changes_.push_back(std::move(op));
+        }
+    }
+    epoch_ = epoch;
+    version_ = version;
+    return ManifestApplyResult::Applied;
+}
+
+uint64_t ManifestReplica::Epoch() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return epoch_;
+}
+
+uint64_t ManifestReplica::Version() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return version_;
+}
+
+size_t ManifestReplica::Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+std::vector<ManifestEntry> ManifestReplica::Entries() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<ManifestEntry> entries;
+    entries.reserve(entries_.size());
+    for (const auto& entry : entries_) entries.push_back({entry.first.first, entry.first.second, entry.second});
+    return entries;
+}
+
+bool ManifestReplica::PopChange(ManifestChange& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (changes_.empty()) return false;
+    out = std::move(changes_.front());
+    changes_.pop_front();
+    return true;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// C exports for the plugin
+// ---------------------------------------------------------------------------
+
+extern "C" {
+
+__declspec(dllexport) void* CreateManifestLog(int max_ops) {
+    return new fyteclub::ManifestLog(max_ops > 0 ? static_cast<size_t>(max_ops) : 4096);
+}
+
+// Put/Remove/Replace return the new version, or 0 when nothing changed
+__declspec(dllexport) uint64_t ManifestLogPut(void* log, const char* type, const char* identifier, const char* hash) {
+    if (!log || !type || !identifier || !hash) return 0;
+    return static_cast<fyteclub::ManifestLog*>(log)->Put(type, identifier, hash);
+}
+
+__declspec(dllexport) uint64_t ManifestLogRemove(void* log, const char* type, const char* identifier) {
+    if (!log || !type || !identifier) return 0;
+    return static_cast<fyteclub::ManifestLog*>(log)->Remove(type, identifier);
+}
+
+// The full component list from a fresh scan, as three parallel arrays
+__declspec(dllexport) uint64_t ManifestLogReplace(void* log, const char** types, const char** identifiers,
+                                                  const char** hashes, int count) {
+    if (!log || count < 0 || (count > 0 && (!types || !identifiers || !hashes))) return 0;
+    std::vector<fyteclub::ManifestEntry> entries;
+    entries.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        if (!types[i] || !identifiers[i] || !hashes[i]) return 0;
+        entries.push_back({types[i], identifiers[i], hashes[i]});
+    }
+    return static_cast<fyteclub::ManifestLog*>(log)->Replace(entries);
+}
+
+__declspec(dllexport) uint64_t ManifestLogVersion(void* log) {
+    return log ? static_cast<fyteclub::ManifestLog*>(log)->Version() : 0;
+}
+
+__declspec(dllexport) uint64_t ManifestLogEpoch(void* log) {
+    return log ? static_cast<fyteclub::ManifestLog*>(log)->Epoch() : 0;
+}
+
+// Writes the frame for a peer at (epoch, since_version), as its replica
+// reports them. Returns its size, 0 when the peer is up to date, or
+// -(size needed) when capacity is too small.
+__declspec(dllexport) int ManifestLogWriteDelta(void* log, uint64_t epoch, uint64_t since_version, uint8_t* out,
+                                                int capacity) {
+    if (!log) return 0;
+    auto frame = static_cast<fyteclub::ManifestLog*>(log)->DeltaSince(epoch, since_version);
+    if (frame.size() > static_cast<size_t>(std::max(capacity, 0)) || (!out && !frame.empty())) {
+        return -static_cast<int>(frame.size());
+    }
+    if (!frame.empty()) memcpy(out, frame.data(), frame.size());
+    return static_cast<int>(frame.size());
+}
+
+__declspec(dllexport) void DestroyManifestLog(void* log) {
+    delete static_cast<fyteclub::ManifestLog*>(log);
+}
+
+__declspec(dllexport) void* CreateManifestReplica() {
+    return new fyteclub::ManifestReplica();
+}
+
+// 0 = applied, 1 = gap or new epoch (request a snapshot by asking with epoch 0), -1 = invalid frame
+__declspec(dllexport) int ManifestReplicaApply(void* replica, const uint8_t* frame, int size) {
+    if (!replica || !frame || size <= 0) return -1;
+    switch (static_cast<fyteclub::ManifestReplica*>(replica)->Apply(frame, static_cast<size_t>(size))) {
+    case fyteclub::ManifestApplyResult::Applied:
+        return 0;
+    case fyteclub::ManifestApplyResult::NeedSnapshot:
+        return 1;
+    default:
+        return -1;
+    }
+}
+
+__declspec(dllexport) uint64_t ManifestReplicaEpoch(void* replica) {
+    return replica ? static_cast<fyteclub::ManifestReplica*>(replica)->Epoch() : 0;
+}
+
+__declspec(dllexport) uint64_t ManifestReplicaVersion(void* replica) {
+    return replica ? static_cast<fyteclub::ManifestReplica*>(replica)->Version() : 0;
+}
+
+__declspec(dllexport) int ManifestReplicaSize(void* replica) {
+    return replica ? static_cast<int>(static_cast<fyteclub::ManifestReplica*>(replica)->Size()) : 0;
+}
+
+// Returns 1 and fills the outputs when a change was waiting, else 0.
+// kind: 0 = put, 1 = remove (hash is empty)
+__declspec(dllexport) int ManifestReplicaPopChange(void* replica, int* kind, char* type, int type_capacity,
+                                                   char* identifier, int identifier_capacity, char* hash,
+                                                   int hash_capacity) {
+    if (!replica) return 0;
+    fyteclub::ManifestChange change;
+    if (!static_cast<fyteclub::ManifestReplica*>(replica)->PopChange(change)) return 0;
+    if (kind) *kind = static_cast<int>(change.kind);
+    fyteclub::CopyString(change.entry.type, type, type_capacity);
+    fyteclub::CopyString(change.entry.identifier, identifier, identifier_capacity);
+    fyteclub::CopyString(change.entry.hash, hash, hash_capacity);
+    return 1;
+}
+
+__declspec(dllexport) void DestroyManifestReplica(void* replica) {
+    delete static_cast<fyteclub::ManifestReplica*>(replica);
+}
+
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Versioned manifest of a player's mod components. Whenever the local state
+// hash changes, PhonebookModStateManager rebuilds the whole PeerModState and
+// every ComponentReference goes out again. Here each add, remove or change
+// is logged under a monotonically increasing sequence number, and a peer
+// that last saw version N receives only what changed after N, collapsed to
+// the latest op per component the way PhonebookState.GetDeltaSince folds
+// its RecentDeltas.
+//
+//   DELTA  C7 | flags | epoch | base version | version | op count | (kind, type, identifier, hash)* | crc32c
+//
+// Strings are varint length + UTF-8 bytes. flags bit 0 marks a snapshot:
+// the receiver clears its copy first (base is then 0). A snapshot is sent
+// when the ops after N have been compacted away, or when it is smaller.
+//
+// Versions restart at 1 whenever the sender's process does, so each log
+// draws a random epoch and versions only compare within one epoch. A peer
+// asking with another epoch gets a snapshot, and a replica drops a delta
+// from an epoch it has not seen a snapshot of.
+
+namespace fyteclub {
+
+constexpr uint8_t kManifestFrameType = 0xC7;
+
+enum class ManifestOpKind : uint8_t {
+    Put = 0,    // component added, or its hash changed
+    Remove = 1,
+};
+
+struct ManifestEntry {
+    std::string type; // penumbra, glamourer, ...
+    std::string identifier;
+    std::string hash;
+};
+
+struct ManifestOp {
+    uint64_t sequence = 0;
+    ManifestOpKind kind = ManifestOpKind::Put;
+    ManifestEntry entry; // hash empty for Remove
+};
+
+// Sender side: the local manifest plus the recent op log
+class ManifestLog {
+public:
+    // epoch 0 draws a random one
+    explicit ManifestLog(size_t max_ops = 4096, uint64_t epoch = 0);
+
+    // Each returns the new version, or 0 when nothing changed
+    uint64_t Put(const std::string& type, const std::string& identifier, const std::string& hash);
+    uint64_t Remove(const std::string& type, const std::string& identifier);
+    // Diffs a full component list against the manifest and logs the difference
+    uint64_t Replace(const std::vector<ManifestEntry>& entries);
+
+    uint64_t Epoch() const { return epoch_; }
+    uint64_t Version() const;
+    size_t Size() const;
+
+    // Frame bringing a peer at (epoch, since_version) up to date; empty when
+    // it already is. Another epoch, or epoch 0, always gets a snapshot.
+    std::vector<uint8_t> DeltaSince(uint64_t epoch, uint64_t since_version) const;
+
+private:
+    using Key = std::pair<std::string, std::string>; // type, identifier
+
+    uint64_t AppendLocked(ManifestOpKind kind, const Key& key, const std::string& hash);
+
+    const size_t max_ops_;
+    const uint64_t epoch_;
+    mutable std::mutex mutex_;
+    std::map<Key, std::string> entries_;
+    std::deque<ManifestOp> ops_; // ascending sequence, trimmed to max_ops_
+    uint64_t version_ = 0;
+};
+
+struct ManifestChange {
+    ManifestOpKind kind = ManifestOpKind::Put;
+    ManifestEntry entry;
+};
+
+enum class ManifestApplyResult {
+    Applied,
+    NeedSnapshot, // delta starts after our version or comes from another epoch; ask with epoch 0
+    Invalid,
+};
+
+// Receiver side: a peer's manifest rebuilt from delta frames. Applied
+// changes are queued for the plugin to poll.
+class ManifestReplica {
+public:
+    ManifestApplyResult Apply(const uint8_t* frame, size_t size);
+    // What to ask the sender's DeltaSince for; 0, 0 before the first frame
+    uint64_t Epoch() const;
+    uint64_t Version() const;
+    size_t Size() const;
+    std::vector<ManifestEntry> Entries() const;
+    bool PopChange(ManifestChange& out);
+
+private:
+    using Key = std::pair<std::string, std::string>;
+
+    mutable std::mutex mutex_;
+    std::map<Key, std::string> entries_;
+    std::deque<ManifestChange> changes_;
+    uint64_t epoch_ = 0;
+    uint64_t version_ = 0;
+};
+
+}
@@ -0,0 +1,167 @@
+#include "memory_budget.h"
+#include <algorithm>
+
+namespace fyteclub {
+
+MemoryBudget::MemoryBudget(const MemoryBudgetConfig& config) : config_(config) {}
+
+void MemoryBudget::AddLocked(Peer& peer, uint64_t bytes) {
+    peer.used += bytes;
+    peer.peak = std::max(peer.peak, peer.used);
+    used_ += bytes;
+    peak_ = std::max(peak_, used_);
+}
+
+MemoryReservation MemoryBudget::Reserve(uint64_t peer_id, uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Peer& peer = peers_[peer_id];
+    peer.removed = false;
+    const uint64_t limit = LimitOf(peer);
+    if (bytes > limit || bytes > config_.global_limit) {
+        ++peer.refused;
+        return MemoryReservation::Rejected;
+    }
+    if (peer.used + bytes > limit || used_ + bytes > config_.global_limit) {
+        ++peer.refused;
+        return MemoryReservation::Backpressure;
+    }
+    AddLocked(peer, bytes);
+    return MemoryReservation::Granted;
+}
+
+void MemoryBudget::Charge(uint64_t peer_id, uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Peer& peer = peers_[peer_id];
+    peer.removed = false;
+    AddLocked(peer, bytes);
+}
+
+void MemoryBudget::Release(uint64_t peer_id, uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = peers_.find(peer_id);
+    if (it == peers_.end()) return;
+    bytes = std::min(bytes, it->second.used);
+    it->second.used -= bytes;
+    used_ -= bytes;
+    if (it->second.removed && it->second.used == 0) peers_.erase(it);
+}
+
+uint64_t MemoryBudget::Available(uint64_t peer_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t used = 0;
+    uint64_t limit = config_.peer_limit;
+    auto it = peers_.find(peer_id);
+    if (it != peers_.end()) {
+        used = it->second.used;
+        limit = LimitOf(it->second);
+    }
+    const uint64_t peer_free = limit > used ? limit - used : 0;
+    const uint64_t global_free = config_.global_limit > used_ ? config_.global_limit - used_ : 0;
+    return std::min(peer_free, global_free);
+}
+
+void MemoryBudget::SetPeerLimit(uint64_t peer_id, uint64_t limit) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    peers_[peer_id].limit = limit;
+}
+
+void MemoryBudget::RemovePeer(uint64_t peer_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = peers_.find(peer_id);
+    if (it == peers_.end()) return;
+    if (it->second.used == 0) {
+        peers_.erase(it);
+    } else {
+        it->second.removed = true;
+    }
+}
+
+PeerMemoryUsage MemoryBudget::GetPeerUsage(uint64_t peer_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    PeerMemoryUsage usage;
+    usage.limit = config_.peer_limit;
+    auto it = peers_.find(peer_id);
+    if (it == peers_.end()) return usage;
+    usage.used = it->second.used;
+    usage.peak = it->second.peak;
+    usage.limit = LimitOf(it->second);
+    usage.refused = it->second.refused;
+    return usage;
+}
+
+size_t MemoryBudget::PeerCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return peers_.size();
+}
+
+uint64_t MemoryBudget::Used() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return used_;
+}
+
+uint64_t MemoryBudget::Peak() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return peak_;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// C exports for the plugin
+// ---------------------------------------------------------------------------
+
+extern "C" {
+
+// Limits in MB; 0 keeps the default
+__declspec(dllexport) void* CreateMemoryBudget(int global_limit_mb, int peer_limit_mb) {
+    fyteclub::MemoryBudgetConfig config;
+    if (global_limit_mb > 0) config.global_limit = static_cast<uint64_t>(global_limit_mb) * 1024 * 1024;
+    if (peer_limit_mb > 0) config.peer_limit = static_cast<uint64_t>(peer_limit_mb) * 1024 * 1024;
+    return new fyteclub::MemoryBudget(config);
+}
+
+// For managed buffers (e.g. reassembling a chunked message) before they are
+// allocated. Returns a MemoryReservation value: 0 = granted, 1 = backpressure,
+// 2 = rejected; -1 for a null budget.
+__declspec(dllexport) int MemoryBudgetReserve(void* budget, uint64_t peer, uint64_t bytes) {
+    if (!budget) return -1;
+    return static_cast<int>(static_cast<fyteclub::MemoryBudget*>(budget)->Reserve(peer, bytes));
+}
+
+__declspec(dllexport) void MemoryBudgetRelease(void* budget, uint64_t peer, uint64_t bytes) {
+    if (budget) static_cast<fyteclub::MemoryBudget*>(budget)->Release(peer, bytes);
+}
+
+__declspec(dllexport) uint64_t MemoryBudgetAvailable(void* budget, uint64_t peer) {
+    return budget ? static_cast<fyteclub::MemoryBudget*>(budget)->Available(peer) : 0;
+}
+
+__declspec(dllexport) void MemoryBudgetSetPeerLimit(void* budget, uint64_t peer, uint64_t limit) {
+    if (budget) static_cast<fyteclub::MemoryBudget*>(budget)->SetPeerLimit(peer, limit);
+}
+
+// Call when the peer's connection closes, after its assembler and receiver
+// are destroyed (they release their own bytes and remove the peer too)
+__declspec(dllexport) void MemoryBudgetRemovePeer(void* budget, uint64_t peer) {
+    if (budget) static_cast<fyteclub::MemoryBudget*>(budget)->RemovePeer(peer);
+}
+
+__declspec(dllexport) void MemoryBudgetPeerUsage(void* budget, uint64_t peer, uint64_t* used, uint64_t* peak,
+                                                 uint64_t* refused) {
+    if (!budget) return;
+    auto usage = static_cast<fyteclub::MemoryBudget*>(budget)->GetPeerUsage(peer);
+    if (used) *used = usage.used;
+    if (peak) *peak = usage.peak;
+    if (refused) *refused = usage.refused;
+}
+
+__declspec(dllexport) uint64_t MemoryBudgetUsed(void* budget) {
+    return budget ? static_cast<fyteclub::MemoryBudget*>(budget)->Used() : 0;
+}
+
+// Destroy only after every assembler and receiver attached to it
+__declspec(dllexport) void DestroyMemoryBudget(void* budget) {
+    delete static_cast<fyteclub::MemoryBudget*>(budget);
+}
+
+}
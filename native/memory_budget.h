@@ -0,0 +1,84 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+// Memory accounting for everything a remote peer can make us buffer.
+// P2PModProtocol.ChunkBuffer allocates whatever size the peer claims and
+// ProgressiveFileTransfer holds whole files, so one peer can push the plugin
+// to any size. Native buffers instead charge a shared budget before they
+// grow: each peer has its own cap and all peers together share a global one.
+// Reassembly buffers (ChunkAssembler's held DATA), receive backlogs
+// (CreditReceiver) and anything else attached report here, so worst-case
+// memory is the global limit.
+//
+// Reserve is all-or-nothing. Backpressure means the bytes would fit once
+// something is released, so the caller should slow the peer down (shrink
+// its credit) or retry; Rejected means they can never fit. Charge records
+// bytes that have already arrived within credit we granted, and may run a
+// peer over its cap; Available then reads 0 until it drains. Thread-safe.
+
+namespace fyteclub {
+
+struct MemoryBudgetConfig {
+    uint64_t global_limit = 512ull * 1024 * 1024;
+    uint64_t peer_limit = 96ull * 1024 * 1024; // default per peer, see SetPeerLimit
+};
+
+enum class MemoryReservation {
+    Granted = 0,
+    Backpressure = 1,
+    Rejected = 2,
+};
+
+struct PeerMemoryUsage {
+    uint64_t used = 0;
+    uint64_t peak = 0;
+    uint64_t limit = 0;
+    uint64_t refused = 0; // Reserve calls answered with Backpressure or Rejected
+};
+
+class MemoryBudget {
+public:
+    explicit MemoryBudget(const MemoryBudgetConfig& config = {});
+
+    MemoryReservation Reserve(uint64_t peer, uint64_t bytes);
+    void Charge(uint64_t peer, uint64_t bytes);
+    void Release(uint64_t peer, uint64_t bytes);
+
+    // Bytes the peer could still reserve right now
+    uint64_t Available(uint64_t peer) const;
+    // 0 restores the default
+    void SetPeerLimit(uint64_t peer, uint64_t limit);
+    // Forgets a peer whose connection is gone. Bytes it still holds stay
+    // charged until released, and the entry goes with the last of them;
+    // reserving or charging again first keeps it.
+    void RemovePeer(uint64_t peer);
+
+    PeerMemoryUsage GetPeerUsage(uint64_t peer) const;
+    size_t PeerCount() const;
+    uint64_t Used() const;
+    uint64_t Peak() const;
+    uint64_t GlobalLimit() const { return config_.global_limit; }
+
+private:
+    struct Peer {
+        uint64_t used = 0;
+        uint64_t peak = 0;
+        uint64_t limit = 0; // 0 = config_.peer_limit
+        uint64_t refused = 0;
+        bool removed = false; // erase once used drains to 0
+    };
+
+    uint64_t LimitOf(const Peer& peer) const { return peer.limit ? peer.limit : config_.peer_limit; }
+    void AddLocked(Peer& peer, uint64_t bytes);
+
+    const MemoryBudgetConfig config_;
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, Peer> peers_;
+    uint64_t used_ = 0;
+    uint64_t peak_ = 0;
+};
+
+}
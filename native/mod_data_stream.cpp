@@ -0,0 +1,509 @@
+#include "mod_data_stream.h"
+#include "frame_util.h"
+#include "generated/p2p_messages.h"
+#include "wire_codec.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace fyteclub {
+
+namespace {
+
+constexpr size_t kMaxVarintBytes = 10;
+
+// Message, FileReplacements entry and TransferableFile field tags
+constexpr uint32_t kMessageId = 1;
+constexpr uint32_t kTimestamp = 2;
+constexpr uint32_t kResponseTo = 3;
+constexpr uint32_t kPlayerName = 4;
+constexpr uint32_t kDataHash = 5;
+constexpr uint32_t kPlayerInfo = 6;
+constexpr uint32_t kFileReplacements = 7;
+constexpr uint32_t kIsCompressed = 8;
+constexpr uint32_t kEntryKey = 1;
+constexpr uint32_t kEntryValue = 2;
+constexpr uint32_t kGamePath = 1;
+constexpr uint32_t kHash = 2;
+constexpr uint32_t kContent = 3;
+constexpr uint32_t kSize = 4;
+
+// Also names the .part file, so nothing but hex gets near the filesystem
+bool IsContentHash(const std::string& hash) {
+    if (hash.size() != Sha1::kDigestSize * 2 && hash.size() != Sha256::kDigestSize * 2) return false;
+    return std::all_of(hash.begin(), hash.end(), [](char c) { return isxdigit(static_cast<unsigned char>(c)) != 0; });
+}
+
+std::string DigestHex(const uint8_t* digest, size_t size) {
+    static const char kDigits[] = "0123456789ABCDEF";
+    std::string hex(size * 2, '0');
+    for (size_t i = 0; i < size; ++i) {
+        hex[i * 2] = kDigits[digest[i] >> 4];
+        hex[i * 2 + 1] = kDigits[digest[i] & 0xF];
+    }
+    return hex;
+}
+
+std::string Upper(std::string value) {
+    for (char& c : value) c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+    return value;
+}
+
+}
+
+ModDataStreamDecoder::ModDataStreamDecoder(std::string output_dir, const ModDataStreamLimits& limits)
+    : output_dir_(std::move(output_dir)), limits_(limits) {
+    levels_.push_back({Scope::Message, 0});
+}
+
+ModDataStreamDecoder::~ModDataStreamDecoder() {
+    if (out_) {
+        out_.reset();
+        std::error_code error;
+        fs::remove(fs::u8path(part_path_), error);
+    }
+}
+
+bool ModDataStreamDecoder::Fail() {
+    if (out_) {
+        out_.reset();
+        std::error_code error;
+        fs::remove(fs::u8path(part_path_), error);
+    }
+    failed_ = true;
+    capture_.clear();
+    capture_.shrink_to_fit();
+    return false;
+}
+
+bool ModDataStreamDecoder::ReadVarintByte(uint8_t byte, uint64_t& value) {
+    varint_ |= static_cast<uint64_t>(byte & 0x7F) << varint_shift_;
+    varint_shift_ += 7;
+    if (byte & 0x80) return false;
+    value = varint_;
+    varint_ = 0;
+    varint_shift_ = 0;
+    return true;
+}
+
+bool ModDataStreamDecoder::Feed(const uint8_t* data, size_t size) {
+    if (failed_) return false;
+    if (size && !data) return Fail();
+    const uint8_t* p = data;
+    const uint8_t* const end = data + size;
+
+    while (p < end) {
+        if (phase_ == Phase::FrameHeader) {
+            header_[header_size_++] = *p++;
+            if (header_size_ == 1 && header_[0] != wire::kFrameFlag) return Fail();
+            if (header_size_ < 3) continue;
+            uint64_t type;
+            if (!ReadVarintByte(header_[header_size_ - 1], type)) {
+                if (varint_shift_ >= 35) return Fail();
+                continue;
+            }
+            if (type != wire::ModDataResponse::kType) return Fail();
+            phase_ = Phase::Key;
+            continue;
+        }
+        if (phase_ == Phase::Done) return Fail();
+
+        const size_t available = static_cast<size_t>(end - p);
+        switch (phase_) {
+        case Phase::Key:
+        case Phase::Length:
+        case Phase::Varint: {
+            uint64_t value;
+            const uint8_t byte = *p++;
+            ++offset_;
+            if (!ReadVarintByte(byte, value)) {
+                if (varint_shift_ >= static_cast<int>(kMaxVarintBytes * 7)) return Fail();
+                break;
+            }
+            if (phase_ == Phase::Key) {
+                if (!OnKey(value)) return Fail();
+            } else if (phase_ == Phase::Length) {
+                if (!OnLength(value)) return Fail();
+            } else {
+                OnVarint(value);
+                phase_ = Phase::Key;
+            }
+            break;
+        }
+        case Phase::Capture: {
+            const size_t take = static_cast<size_t>(std::min<uint64_t>(field_remaining_, available));
+            capture_.insert(capture_.end(), p, p + take);
+            p += take;
+            offset_ += take;
+            field_remaining_ -= take;
+            if (field_remaining_ == 0) {
+                OnCapture();
+                phase_ = Phase::Key;
+            }
+            break;
+        }
+        case Phase::Content: {
+            const size_t take = static_cast<size_t>(std::min<uint64_t>(field_remaining_, available));
+            if (!discard_) {
+                if (!out_->WriteAt(content_written_, p, take)) return Fail();
+                if (file_.hash.size() == Sha1::kDigestSize * 2) sha1_.Update(p, take);
+                else sha256_.Update(p, take);
+            }
+            content_written_ += take;
+            p += take;
+            offset_ += take;
+            field_remaining_ -= take;
+            if (field_remaining_ == 0) {
+                EndContent();
+                phase_ = Phase::Key;
+            }
+            break;
+        }
+        case Phase::Skip: {
+            const size_t take = static_cast<size_t>(std::min<uint64_t>(field_remaining_, available));
+            p += take;
+            offset_ += take;
+            field_remaining_ -= take;
+            if (field_remaining_ == 0) phase_ = Phase::Key;
+            break;
+        }
+        default:
+            return Fail();
+        }
+
+        if (phase_ == Phase::Key && varint_shift_ == 0) {
+            if (levels_.back().scope != Scope::Message && offset_ > levels_.back().end) return Fail();
+            CloseScopes();
+        }
+    }
+    return true;
+}
+
+bool ModDataStreamDecoder::OnKey(uint64_t key) {
+    if (key >> 3 == 0 || key >> 3 > UINT32_MAX) return false;
+    tag_ = static_cast<uint32_t>(key >> 3);
+    switch (key & 7) {
+    case wire::kVarint:
+        phase_ = Phase::Varint;
+        return true;
+    case wire::kLengthDelimited:
+        phase_ = Phase::Length;
+        return true;
+    case wire::kFixed32:
+        field_remaining_ = 4;
+        phase_ = Phase::Skip;
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool ModDataStreamDecoder::OnLength(uint64_t length) {
+    const Level& level = levels_.back();
+    if (level.scope != Scope::Message && (offset_ > level.end || length > level.end - offset_)) return false;
+    field_remaining_ = length;
+
+    size_t capture_limit = 0;
+    switch (level.scope) {
+    case Scope::Message:
+        if (tag_ == kFileReplacements) {
+            EmitHeader();
+            levels_.push_back({Scope::Entry, offset_ + length});
+            file_ = File();
+            phase_ = Phase::Key;
+            return true;
+        }
+        if (tag_ == kPlayerInfo) capture_limit = limits_.max_player_info;
+        else if (tag_ == kMessageId || tag_ == kResponseTo || tag_ == kPlayerName || tag_ == kDataHash)
+            capture_limit = limits_.max_string;
+        break;
+    case Scope::Entry:
+        if (tag_ == kEntryValue) {
+            levels_.push_back({Scope::File, offset_ + length});
+            phase_ = Phase::Key;
+            return true;
+        }
+        if (tag_ == kEntryKey) capture_limit = limits_.max_string;
+        break;
+    case Scope::File:
+        if (tag_ == kContent) return BeginContent(length);
+        if (tag_ == kGamePath || tag_ == kHash) capture_limit = limits_.max_string;
+        break;
+    }
+
+    if (capture_limit == 0) {
+        phase_ = Phase::Skip;
+    } else {
+        if (length > capture_limit) return false;
+        capture_.clear();
+        capture_.reserve(static_cast<size_t>(length));
+        phase_ = Phase::Capture;
+    }
+    if (length == 0) {
+        if (phase_ == Phase::Capture) OnCapture();
+        phase_ = Phase::Key;
+    }
+    return true;
+}
+
+void ModDataStreamDecoder::OnVarint(uint64_t value) {
+    const Scope scope = levels_.back().scope;
+    if (scope == Scope::Message && tag_ == kTimestamp) header_event_.timestamp = wire::UnZigZag(value);
+    else if (scope == Scope::Message && tag_ == kIsCompressed) header_event_.is_compressed = value != 0;
+    else if (scope == Scope::File && tag_ == kSize) file_.size = wire::UnZigZag(value);
+}
+
+void ModDataStreamDecoder::OnCapture() {
+    const Scope scope = levels_.back().scope;
+    if (scope == Scope::Message && tag_ == kPlayerInfo) {
+        header_event_.player_info.swap(capture_);
+        capture_.clear();
+        return;
+    }
+    std::string text(capture_.begin(), capture_.end());
+    switch (scope) {
+    case Scope::Message:
+        switch (tag_) {
+        case kMessageId: header_event_.message_id = std::move(text); break;
+        case kResponseTo: header_event_.response_to = std::move(text); break;
+        case kPlayerName: header_event_.player_name = std::move(text); break;
+        case kDataHash: header_event_.data_hash = std::move(text); break;
+        }
+        break;
+    case Scope::Entry:
+        file_.key = std::move(text);
+        break;
+    case Scope::File:
+        if (tag_ == kGamePath) file_.game_path = std::move(text);
+        else file_.hash = std::move(text);
+        break;
+    }
+    capture_.clear();
+}
+
+bool ModDataStreamDecoder::BeginContent(uint64_t length) {
+    if (length > limits_.max_content) return false;
+    if (length == 0) {
+        phase_ = Phase::Key;
+        return true;
+    }
+    phase_ = Phase::Content;
+    file_.had_content = true;
+    content_written_ = 0;
+    discard_ = false;
+
+    // Writers put the hash ahead of the content. Without one (or with a
+    // repeated content field) there is nothing to name or verify it by.
+    if (!IsContentHash(file_.hash) || file_.status != ModDataFileStatus::NoContent) {
+        discard_ = true;
+        file_.status = ModDataFileStatus::Failed;
+        return true;
+    }
+    auto final_path = fs::u8path(output_dir_) / Upper(file_.hash);
+    std::error_code error;
+    if (fs::exists(final_path, error)) {
+        discard_ = true;
+        file_.status = ModDataFileStatus::Existing;
+        file_.path = final_path.u8string();
+        return true;
+    }
+
+    // Two decoders can be receiving the same content at once
+    static std::atomic<uint64_t> next_part{0};
+    part_path_ = (fs::u8path(output_dir_) / (Upper(file_.hash) + "." + std::to_string(next_part++) + ".part")).u8string();
+    out_ = PositionalFile::Create(part_path_, length);
+    if (!out_) {
+        discard_ = true;
+        file_.status = ModDataFileStatus::Failed;
+        return true;
+    }
+    sha1_ = Sha1();
+    sha256_ = Sha256();
+    return true;
+}
+
+void ModDataStreamDecoder::EndContent() {
+    if (discard_) return;
+    out_.reset();
+
+    const std::string expected = Upper(file_.hash);
+    std::string actual;
+    if (expected.size() == Sha1::kDigestSize * 2) {
+        uint8_t digest[Sha1::kDigestSize];
+        sha1_.Final(digest);
+        actual = DigestHex(digest, sizeof(digest));
+    } else {
+        uint8_t digest[Sha256::kDigestSize];
+        sha256_.Final(digest);
+        actual = DigestHex(digest, sizeof(digest));
+    }
+
+    std::error_code error;
+    auto part = fs::u8path(part_path_);
+    auto final_path = fs::u8path(output_dir_) / expected;
+    bool stored = actual == expected;
+    if (stored) {
+        fs::rename(part, final_path, error);
+        if (error) {
+            // Same content already landed some other way
+            stored = fs::exists(final_path);
+            fs::remove(part, error);
+        }
+    } else {
+        fs::remove(part, error);
+    }
+    if (stored) {
+        file_.status = ModDataFileStatus::Stored;
+        file_.path = final_path.u8string();
+    } else {
+        file_.status = ModDataFileStatus::Failed;
+    }
+}
+
+void ModDataStreamDecoder::CloseScopes() {
+    while (levels_.back().scope != Scope::Message && offset_ == levels_.back().end) {
+        const Scope scope = levels_.back().scope;
+        levels_.pop_back();
+        if (scope != Scope::Entry) continue;
+
+        ModDataStreamEvent event;
+        event.kind = ModDataStreamEventKind::File;
+        event.key = std::move(file_.key);
+        event.game_path = std::move(file_.game_path);
+        event.hash = std::move(file_.hash);
+        event.size = file_.size;
+        event.status = file_.status;
+        event.path = std::move(file_.path);
+        events_.push_back(std::move(event));
+        ++files_;
+        file_ = File();
+    }
+}
+
+void ModDataStreamDecoder::EmitHeader() {
+    if (header_sent_) return;
+    header_sent_ = true;
+    header_event_.kind = ModDataStreamEventKind::Header;
+    events_.push_back(header_event_);
+    // The scalars stay for the End event; the blob has been handed over
+    header_event_.player_info.clear();
+    header_event_.player_info.shrink_to_fit();
+}
+
+bool ModDataStreamDecoder::Finish() {
+    if (failed_) return false;
+    if (phase_ != Phase::Key || varint_shift_ != 0 || levels_.size() != 1) return Fail();
+    // Fields written after the map (isCompressed) arrive too late for the
+    // header, so a response always ends with them in the End event
+    EmitHeader();
+    ModDataStreamEvent event;
+    event.kind = ModDataStreamEventKind::End;
+    event.files = files_;
+    event.message_id = header_event_.message_id;
+    event.timestamp = header_event_.timestamp;
+    event.is_compressed = header_event_.is_compressed;
+    events_.push_back(std::move(event));
+    phase_ = Phase::Done;
+    return true;
+}
+
+bool ModDataStreamDecoder::PopEvent(ModDataStreamEvent& out) {
+    if (events_.empty()) return false;
+    out = std::move(events_.front());
+    events_.pop_front();
+    return true;
+}
+
+bool ModDataStreamDecoder::PeekEventSize(size_t& size) const {
+    if (events_.empty()) return false;
+    size = events_.front().player_info.size();
+    return true;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// C exports for the plugin
+// ---------------------------------------------------------------------------
+
+extern "C" {
+
+struct ModDataStreamEventInfo {
+    int kind;   // ModDataStreamEventKind
+    int status; // ModDataFileStatus, File events
+    int64_t size;
+    int64_t timestamp;
+    int is_compressed;
+    int player_info_size;
+    uint64_t files; // End
+};
+
+// output_dir is the content store (the plugin's FileCache); limits <= 0 keep the defaults
+__declspec(dllexport) void* CreateModDataStreamDecoder(const char* output_dir, int max_player_info,
+                                                       int64_t max_content) {
+    fyteclub::ModDataStreamLimits limits;
+    if (max_player_info > 0) limits.max_player_info = static_cast<size_t>(max_player_info);
+    if (max_content > 0) limits.max_content = static_cast<uint64_t>(max_content);
+    return new fyteclub::ModDataStreamDecoder(output_dir ? output_dir : "", limits);
+}
+
+// Feed each piece as it arrives (e.g. every ChunkedMessage in order).
+// 1 = consumed, 0 = the response is malformed or not a schema ModDataResponse.
+__declspec(dllexport) int ModDataStreamDecoderFeed(void* decoder, const uint8_t* data, int size) {
+    if (!decoder || size < 0) return 0;
+    return static_cast<fyteclub::ModDataStreamDecoder*>(decoder)->Feed(data, static_cast<size_t>(size)) ? 1 : 0;
+}
+
+__declspec(dllexport) int ModDataStreamDecoderFinish(void* decoder) {
+    return decoder && static_cast<fyteclub::ModDataStreamDecoder*>(decoder)->Finish() ? 1 : 0;
+}
+
+// Returns 1 and fills the event, 0 if none is queued, or -(player info size)
+// if player_info_capacity is too small (the event stays queued). For Header
+// events: key = player name, game_path = data hash, hash = message id,
+// path = responseTo. For File events each string is what its name says.
+__declspec(dllexport) int ModDataStreamDecoderPopEvent(void* decoder, ModDataStreamEventInfo* info, char* key,
+                                                       int key_capacity, char* game_path, int game_path_capacity,
+                                                       char* hash, int hash_capacity, char* path, int path_capacity,
+                                                       uint8_t* player_info, int player_info_capacity) {
+    if (!decoder || !info) return 0;
+    auto* self = static_cast<fyteclub::ModDataStreamDecoder*>(decoder);
+    size_t needed;
+    if (!self->PeekEventSize(needed)) return 0;
+    if (needed > 0 && (!player_info || needed > static_cast<size_t>(std::max(player_info_capacity, 0))))
+        return -static_cast<int>(needed);
+
+    fyteclub::ModDataStreamEvent event;
+    self->PopEvent(event);
+    info->kind = static_cast<int>(event.kind);
+    info->status = static_cast<int>(event.status);
+    info->size = event.size;
+    info->timestamp = event.timestamp;
+    info->is_compressed = event.is_compressed ? 1 : 0;
+    info->player_info_size = static_cast<int>(event.player_info.size());
+    info->files = event.files;
+    if (event.kind == fyteclub::ModDataStreamEventKind::File) {
+        fyteclub::CopyString(event.key, key, key_capacity);
+        fyteclub::CopyString(event.game_path, game_path, game_path_capacity);
+        fyteclub::CopyString(event.hash, hash, hash_capacity);
+        fyteclub::CopyString(event.path, path, path_capacity);
+    } else {
+        fyteclub::CopyString(event.player_name, key, key_capacity);
+        fyteclub::CopyString(event.data_hash, game_path, game_path_capacity);
+        fyteclub::CopyString(event.message_id, hash, hash_capacity);
+        fyteclub::CopyString(event.response_to, path, path_capacity);
+    }
+    if (needed > 0) memcpy(player_info, event.player_info.data(), needed);
+    return 1;
+}
+
+// Removes any half-written .part file
+__declspec(dllexport) void DestroyModDataStreamDecoder(void* decoder) {
+    delete static_cast<fyteclub::ModDataStreamDecoder*>(decoder);
+}
+
+}
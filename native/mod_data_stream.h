@@ -0,0 +1,164 @@
+#pragma once
+#include "chunk_assembler.h"
+#include "sha1.h"
+#include "sha256.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Streaming decoder for schema-encoded ModDataResponse frames (wire_codec.h).
+// The managed path reassembles every chunk of the response, inflates it into
+// one array and then builds an object graph holding every FileReplacement's
+// content at once, so peak memory is a multiple of the payload. Here bytes
+// are fed as they arrive, in pieces of any size, and each FileReplacement is
+// reported as soon as its entry has been read, with its content already
+// written to the content store: <dir>/<hash>, via <dir>/<hash>.part until
+// the hash checks out. Memory use is bounded by the largest string field and
+// the player info blob, not by the payload.
+//
+// Content is verified against its hash: 40 hex digits are SHA-1 (the
+// plugin's FileTransferSystem naming), 64 are SHA-256. Content whose file is
+// already in the store is read past without writing it. JSON responses
+// (framing flags 0/1) are not handled here and stay on the managed path.
+//
+// Not on the receive path yet: peers still send ModDataResponse as JSON, so
+// there are no flag-2 frames to feed it, and the plugin has no binding for
+// the exports below. It is inert until ModDataResponse goes out in the
+// schema encoding; the plugin then feeds it each ChunkedMessage piece in
+// place of reassembling and deserializing the response.
+
+namespace fyteclub {
+
+enum class ModDataStreamEventKind {
+    Header = 0, // the scalar fields and player info, ahead of the first file
+    File = 1,
+    End = 2,
+};
+
+enum class ModDataFileStatus {
+    Stored = 0,    // content written and verified
+    Existing = 1,  // already in the store; content was skipped
+    Failed = 2,    // content did not match its hash, or could not be written
+    NoContent = 3, // the entry carried no content (the receiver fetches it by hash)
+};
+
+struct ModDataStreamEvent {
+    ModDataStreamEventKind kind = ModDataStreamEventKind::Header;
+    // Header
+    std::string message_id;
+    std::string response_to;
+    std::string player_name;
+    std::string data_hash;
+    int64_t timestamp = 0;
+    bool is_compressed = false;
+    std::vector<uint8_t> player_info; // encoded PlayerInfo body, for the generated reader
+    // File
+    std::string key;
+    std::string game_path;
+    std::string hash;
+    int64_t size = 0;
+    std::string path;
+    ModDataFileStatus status = ModDataFileStatus::NoContent;
+    // End
+    uint64_t files = 0;
+};
+
+struct ModDataStreamLimits {
+    size_t max_string = 64 * 1024;
+    size_t max_player_info = 1024 * 1024;
+    uint64_t max_content = 1024ull * 1024 * 1024;
+};
+
+class ModDataStreamDecoder {
+public:
+    explicit ModDataStreamDecoder(std::string output_dir, const ModDataStreamLimits& limits = {});
+    ~ModDataStreamDecoder();
+    ModDataStreamDecoder(const ModDataStreamDecoder&) = delete;
+    ModDataStreamDecoder& operator=(const ModDataStreamDecoder&) = delete;
+
+    // Consumes the next piece of the frame. False once the input is invalid;
+    // the decoder then ignores everything after it.
+    bool Feed(const uint8_t* data, size_t size);
+    // Call after the last piece; false if the frame stopped mid-field
+    bool Finish();
+    bool Failed() const { return failed_; }
+
+    bool PopEvent(ModDataStreamEvent& out);
+    // Player info size of the next event, false when none is queued
+    bool PeekEventSize(size_t& size) const;
+
+private:
+    enum class Phase {
+        FrameHeader, // flag, schema version, message type
+        Key,
+        Length,
+        Varint,
+        Capture, // a bounded length-delimited field into capture_
+        Content, // file content straight to disk
+        Skip,
+        Done,
+    };
+
+    enum class Scope { Message, Entry, File };
+
+    struct Level {
+        Scope scope;
+        uint64_t end; // body offset where the scope closes; unused for Message
+    };
+
+    struct File {
+        std::string key;
+        std::string game_path;
+        std::string hash;
+        int64_t size = 0;
+        bool had_content = false;
+        ModDataFileStatus status = ModDataFileStatus::NoContent;
+        std::string path;
+    };
+
+    bool Fail();
+    bool ReadVarintByte(uint8_t byte, uint64_t& value);
+    bool OnKey(uint64_t key);
+    bool OnLength(uint64_t length);
+    void OnVarint(uint64_t value);
+    void OnCapture();
+    bool BeginContent(uint64_t length);
+    void EndContent();
+    void CloseScopes();
+    void EmitHeader();
+
+    const std::string output_dir_;
+    const ModDataStreamLimits limits_;
+
+    Phase phase_ = Phase::FrameHeader;
+    std::vector<Level> levels_;
+    uint64_t offset_ = 0;         // body bytes consumed
+    uint32_t tag_ = 0;
+    uint64_t varint_ = 0;         // partial varint
+    int varint_shift_ = 0;
+    uint8_t header_[12] = {};     // frame header bytes so far
+    size_t header_size_ = 0;
+    std::vector<uint8_t> capture_;
+    uint64_t field_remaining_ = 0; // Capture/Content/Skip bytes still to come
+    bool failed_ = false;
+    bool header_sent_ = false;
+
+    ModDataStreamEvent header_event_;
+    File file_;
+    uint64_t files_ = 0;
+
+    // Content being written
+    std::unique_ptr<PositionalFile> out_;
+    std::string part_path_;
+    uint64_t content_written_ = 0;
+    bool discard_ = false; // already stored: read past it
+    Sha1 sha1_;
+    Sha256 sha256_;
+
+    std::deque<ModDataStreamEvent> events_;
+};
+
+}
@@ -0,0 +1,331 @@
+#include "phonebook_crdt.h"
+#include "frame_util.h"
+#include <algorithm>
+#include <cstring>
+
+namespace fyteclub {
+
+namespace {
+
+// Newest sequence first within a peer, so the survivor is the front of each run
+bool EntryOrder(const CrdtEntry& a, const CrdtEntry& b) {
+    int c = a.peer_id.compare(b.peer_id);
+    return c < 0 || (c == 0 && a.sequence > b.sequence);
+}
+
+bool TombstoneOrder(const CrdtTombstone& a, const CrdtTombstone& b) {
+    return a.peer_id < b.peer_id;
+}
+
+}
+
+void PhonebookCrdt::NormalizeLocked() {
+    if (sorted_entries_ < entries_.size()) {
+        // Both sort and merge are stable, so among equal sequences the entry
+        // that arrived first survives, as with "replace only if higher"
+        auto middle = entries_.begin() + static_cast<ptrdiff_t>(sorted_entries_);
+        std::stable_sort(middle, entries_.end(), EntryOrder);
+        std::inplace_merge(entries_.begin(), middle, entries_.end(), EntryOrder);
+        entries_.erase(std::unique(entries_.begin(), entries_.end(),
+                                   [](const CrdtEntry& a, const CrdtEntry& b) { return a.peer_id == b.peer_id; }),
+                       entries_.end());
+        sorted_entries_ = entries_.size();
+    }
+    if (sorted_tombstones_ < tombstones_.size()) {
+        auto middle = tombstones_.begin() + static_cast<ptrdiff_t>(sorted_tombstones_);
+        std::stable_sort(middle, tombstones_.end(), TombstoneOrder);
+        std::inplace_merge(tombstones_.begin(), middle, tombstones_.end(), TombstoneOrder);
+        // Later tombstones overwrite earlier ones: keep the last of each run
+        size_t out = 0;
+        for (size_t i = 0; i < tombstones_.size(); ++i) {
+            if (i + 1 < tombstones_.size() && tombstones_[i + 1].peer_id == tombstones_[i].peer_id) continue;
+            if (out != i) tombstones_[out] = std::move(tombstones_[i]);
+            out++;
+        }
+        tombstones_.resize(out);
+        sorted_tombstones_ = tombstones_.size();
+    }
+}
+
+void PhonebookCrdt::RebuildIndexLocked() {
+    revoked_.clear();
+    revoked_.reserve(tombstones_.size());
+    for (const auto& tombstone : tombstones_) revoked_[tombstone.peer_id] = tombstone.timestamp;
+}
+
+bool PhonebookCrdt::AddEntry(CrdtEntry entry, int64_t now) {
+    if (entry.IsExpired(now)) return false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (revoked_.count(entry.peer_id)) return false;
+    entries_.push_back(std::move(entry));
+    return true;
+}
+
+void PhonebookCrdt::AddTombstone(CrdtTombstone tombstone, bool remove_entry) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    revoked_[tombstone.peer_id] = tombstone.timestamp;
+    if (remove_entry) {
+        NormalizeLocked();
+        auto it = std::lower_bound(entries_.begin(), entries_.end(), tombstone.peer_id,
+                                   [](const CrdtEntry& e, const std::string& id) { return e.peer_id < id; });
+        if (it != entries_.end() && it->peer_id == tombstone.peer_id) {
+            entries_.erase(it);
+            sorted_entries_--;
+        }
+    }
+    tombstones_.push_back(std::move(tombstone));
+}
+
+bool PhonebookCrdt::IsRevoked(const std::string& peer_id, int64_t now) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = revoked_.find(peer_id);
+    return it != revoked_.end() && now <= it->second + kTombstoneLifetimeSeconds;
+}
+
+bool PhonebookCrdt::GetEntry(const std::string& peer_id, int64_t now, CrdtEntry& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    NormalizeLocked();
+    auto it = std::lower_bound(entries_.begin(), entries_.end(), peer_id,
+                               [](const CrdtEntry& e, const std::string& id) { return e.peer_id < id; });
+    if (it == entries_.end() || it->peer_id != peer_id || it->IsExpired(now)) return false;
+    out = *it;
+    return true;
+}
+
+CrdtMergeStats PhonebookCrdt::Merge(PhonebookCrdt& other, int64_t now) {
+    CrdtMergeStats stats;
+    if (&other == this) return stats;
+    std::scoped_lock lock(mutex_, other.mutex_);
+    NormalizeLocked();
+    other.NormalizeLocked();
+
+    // Tombstones first: ours, overwritten or extended by their unexpired ones
+    std::vector<CrdtTombstone> tombstones;
+    tombstones.reserve(tombstones_.size() + other.tombstones_.size());
+    {
+        size_t i = 0, j = 0;
+        while (i < tombstones_.size() || j < other.tombstones_.size()) {
+            if (j < other.tombstones_.size() && other.tombstones_[j].IsExpired(now)) {
+                j++;
+                continue;
+            }
+            int c = i == tombstones_.size()         ? 1
+                    : j == other.tombstones_.size() ? -1
+                                                    : tombstones_[i].peer_id.compare(other.tombstones_[j].peer_id);
+            if (c < 0) {
+                tombstones.push_back(std::move(tombstones_[i++]));
+            } else {
+                if (c == 0) i++;
+                tombstones.push_back(other.tombstones_[j++]);
+                stats.tombstones_taken++;
+            }
+        }
+    }
+    tombstones_ = std::move(tombstones);
+    sorted_tombstones_ = tombstones_.size();
+    RebuildIndexLocked();
+
+    // Entries: one pass over both sides, with a third cursor over their
+    // tombstones to find our entries they have removed
+    std::vector<CrdtEntry> entries;
+    entries.reserve(entries_.size() + other.entries_.size());
+    size_t i = 0, k = 0, t = 0;
+    const auto& theirs = other.entries_;
+    const auto& their_tombstones = other.tombstones_;
+    auto removed_by_them = [&](const std::string& peer_id) {
+        while (t < their_tombstones.size() && their_tombstones[t].peer_id < peer_id) t++;
+        return t < their_tombstones.size() && their_tombstones[t].peer_id == peer_id &&
+               !their_tombstones[t].IsExpired(now);
+    };
+    while (i < entries_.size() || k < theirs.size()) {
+        if (k < theirs.size() && theirs[k].IsExpired(now)) {
+            k++;
+            continue;
+        }
+        int c = i == entries_.size()  ? 1
+                : k == theirs.size() ? -1
+                                     : entries_[i].peer_id.compare(theirs[k].peer_id);
+        const std::string& peer_id = c <= 0 ? entries_[i].peer_id : theirs[k].peer_id;
+        if (removed_by_them(peer_id)) {
+            if (c <= 0) stats.entries_removed++;
+            if (c <= 0) i++;
+            if (c >= 0) k++;
+            continue;
+        }
+        if (c < 0) {
+            entries.push_back(std::move(entries_[i++]));
+        } else if (c > 0) {
+            if (!revoked_.count(peer_id)) {
+                entries.push_back(theirs[k]);
+                stats.entries_added++;
+            }
+            k++;
+        } else {
+            if (!revoked_.count(peer_id) && theirs[k].sequence > entries_[i].sequence) {
+                entries.push_back(theirs[k]);
+                stats.entries_replaced++;
+            } else {
+                entries.push_back(std::move(entries_[i]));
+            }
+            i++;
+            k++;
+        }
+    }
+    entries_ = std::move(entries);
+    sorted_entries_ = entries_.size();
+    return stats;
+}
+
+size_t PhonebookCrdt::Cleanup(int64_t now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    NormalizeLocked();
+    size_t before = entries_.size() + tombstones_.size();
+    entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                  [now](const CrdtEntry& e) { return e.IsExpired(now); }),
+                   entries_.end());
+    tombstones_.erase(std::remove_if(tombstones_.begin(), tombstones_.end(),
+                                     [now](const CrdtTombstone& t) { return t.IsExpired(now); }),
+                      tombstones_.end());
+    sorted_entries_ = entries_.size();
+    sorted_tombstones_ = tombstones_.size();
+    RebuildIndexLocked();
+    return before - entries_.size() - tombstones_.size();
+}
+
+size_t PhonebookCrdt::EntryCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    NormalizeLocked();
+    return entries_.size();
+}
+
+bool PhonebookCrdt::EntryAt(size_t index, CrdtEntry& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    NormalizeLocked();
+    if (index >= entries_.size()) return false;
+    out = entries_[index];
+    return true;
+}
+
+size_t PhonebookCrdt::TombstoneCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    NormalizeLocked();
+    return tombstones_.size();
+}
+
+bool PhonebookCrdt::TombstoneAt(size_t index, CrdtTombstone& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    NormalizeLocked();
+    if (index >= tombstones_.size()) return false;
+    out = tombstones_[index];
+    return true;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// C exports for the plugin
+// ---------------------------------------------------------------------------
+//
+// Times are unix seconds; the plugin passes DateTimeOffset.UtcNow so expiry
+// agrees with PhonebookEntry.IsExpired and TombstoneRecord.IsExpired.
+
+extern "C" {
+
+struct PhonebookMergeStats {
+    int entries_added;
+    int entries_replaced;
+    int entries_removed;
+    int tombstones_taken;
+};
+
+__declspec(dllexport) void* CreatePhonebookCrdt() {
+    return new fyteclub::PhonebookCrdt();
+}
+
+// Returns 1 when accepted, 0 when expired or revoked
+__declspec(dllexport) int PhonebookCrdtAddEntry(void* crdt, const char* peer_id, int64_t sequence, int64_t timestamp,
+                                                uint64_t payload, int64_t now) {
+    if (!crdt || !peer_id) return 0;
+    return static_cast<fyteclub::PhonebookCrdt*>(crdt)->AddEntry({peer_id, sequence, timestamp, payload}, now) ? 1 : 0;
+}
+
+__declspec(dllexport) void PhonebookCrdtAddTombstone(void* crdt, const char* peer_id, int64_t entry_sequence,
+                                                     int64_t timestamp, uint64_t payload, int remove_entry) {
+    if (!crdt || !peer_id) return;
+    static_cast<fyteclub::PhonebookCrdt*>(crdt)->AddTombstone({peer_id, entry_sequence, timestamp, payload},
+                                                              remove_entry != 0);
+}
+
+__declspec(dllexport) int PhonebookCrdtIsRevoked(void* crdt, const char* peer_id, int64_t now) {
+    return crdt && peer_id && static_cast<fyteclub::PhonebookCrdt*>(crdt)->IsRevoked(peer_id, now) ? 1 : 0;
+}
+
+// Returns 1 and fills the outputs when the peer has an unexpired entry, else 0
+__declspec(dllexport) int PhonebookCrdtGetEntry(void* crdt, const char* peer_id, int64_t now, int64_t* sequence,
+                                                int64_t* timestamp, uint64_t* payload) {
+    fyteclub::CrdtEntry entry;
+    if (!crdt || !peer_id || !static_cast<fyteclub::PhonebookCrdt*>(crdt)->GetEntry(peer_id, now, entry)) return 0;
+    if (sequence) *sequence = entry.sequence;
+    if (timestamp) *timestamp = entry.timestamp;
+    if (payload) *payload = entry.payload;
+    return 1;
+}
+
+// Merges other into crdt; other is left unchanged
+__declspec(dllexport) int PhonebookCrdtMerge(void* crdt, void* other, int64_t now, PhonebookMergeStats* stats) {
+    if (!crdt || !other) return -1;
+    auto result = static_cast<fyteclub::PhonebookCrdt*>(crdt)->Merge(*static_cast<fyteclub::PhonebookCrdt*>(other), now);
+    if (stats) {
+        stats->entries_added = static_cast<int>(result.entries_added);
+        stats->entries_replaced = static_cast<int>(result.entries_replaced);
+        stats->entries_removed = static_cast<int>(result.entries_removed);
+        stats->tombstones_taken = static_cast<int>(result.tombstones_taken);
+    }
+    return 0;
+}
+
+__declspec(dllexport) int PhonebookCrdtCleanup(void* crdt, int64_t now) {
+    return crdt ? static_cast<int>(static_cast<fyteclub::PhonebookCrdt*>(crdt)->Cleanup(now)) : 0;
+}
+
+__declspec(dllexport) int PhonebookCrdtEntryCount(void* crdt) {
+    return crdt ? static_cast<int>(static_cast<fyteclub::PhonebookCrdt*>(crdt)->EntryCount()) : 0;
+}
+
+// Entries are in peer id order
+__declspec(dllexport) int PhonebookCrdtEntryAt(void* crdt, int index, char* peer_id, int peer_id_capacity,
+                                               int64_t* sequence, int64_t* timestamp, uint64_t* payload) {
+    fyteclub::CrdtEntry entry;
+    if (!crdt || index < 0 || !static_cast<fyteclub::PhonebookCrdt*>(crdt)->EntryAt(static_cast<size_t>(index), entry)) {
+        return 0;
+    }
+    fyteclub::CopyString(entry.peer_id, peer_id, peer_id_capacity);
+    if (sequence) *sequence = entry.sequence;
+    if (timestamp) *timestamp = entry.timestamp;
+    if (payload) *payload = entry.payload;
+    return 1;
+}
+
+__declspec(dllexport) int PhonebookCrdtTombstoneCount(void* crdt) {
+    return crdt ? static_cast<int>(static_cast<fyteclub::PhonebookCrdt*>(crdt)->TombstoneCount()) : 0;
+}
+
+__declspec(dllexport) int PhonebookCrdtTombstoneAt(void* crdt, int index, char* peer_id, int peer_id_capacity,
+                                                   int64_t* entry_sequence, int64_t* timestamp, uint64_t* payload) {
+    fyteclub::CrdtTombstone tombstone;
+    if (!crdt || index < 0 ||
+        !static_cast<fyteclub::PhonebookCrdt*>(crdt)->TombstoneAt(static_cast<size_t>(index), tombstone)) {
+        return 0;
+    }
+    fyteclub::CopyString(tombstone.peer_id, peer_id, peer_id_capacity);
+    if (entry_sequence) *entry_sequence = tombstone.entry_sequence;
+    if (timestamp) *timestamp = tombstone.timestamp;
+    if (payload) *payload = tombstone.payload;
+    return 1;
+}
+
+__declspec(dllexport) void DestroyPhonebookCrdt(void* crdt) {
+    delete static_cast<fyteclub::PhonebookCrdt*>(crdt);
+}
+
+}
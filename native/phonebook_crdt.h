@@ -0,0 +1,88 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Last-writer-wins-by-sequence phonebook CRDT. SignedPhonebook.Merge adds the
+// other side's entries one by one through dictionaries and re-checks
+// revocation per entry. Here entries and tombstones are kept as arrays
+// sorted by peer id, a merge is a single two-pointer pass over both sides,
+// and revocation is a hash lookup.
+//
+// Merge results match SignedPhonebook.Merge:
+//   - only the other side's unexpired entries and tombstones are considered
+//   - an entry is taken when its peer is absent here or its sequence is
+//     strictly higher; a peer with any tombstone on either side is skipped
+//   - the other side's tombstones overwrite ours and remove our entry
+//
+// Signatures are not checked here: the plugin verifies entries and
+// tombstones before handing them over, as AddEntry/AddTombstone do. Each
+// record carries an opaque payload (the plugin's handle for the signed
+// object) so results can be mapped back without copying signatures.
+
+namespace fyteclub {
+
+constexpr int64_t kPhonebookEntryLifetimeSeconds = 24 * 60 * 60;
+constexpr int64_t kTombstoneLifetimeSeconds = 7 * 24 * 60 * 60;
+
+struct CrdtEntry {
+    std::string peer_id;
+    int64_t sequence = 0;
+    int64_t timestamp = 0; // unix seconds
+    uint64_t payload = 0;
+
+    bool IsExpired(int64_t now) const { return now > timestamp + kPhonebookEntryLifetimeSeconds; }
+};
+
+struct CrdtTombstone {
+    std::string peer_id;
+    int64_t entry_sequence = 0;
+    int64_t timestamp = 0;
+    uint64_t payload = 0;
+
+    bool IsExpired(int64_t now) const { return now > timestamp + kTombstoneLifetimeSeconds; }
+};
+
+struct CrdtMergeStats {
+    size_t entries_added = 0;
+    size_t entries_replaced = 0;
+    size_t entries_removed = 0;
+    size_t tombstones_taken = 0;
+};
+
+class PhonebookCrdt {
+public:
+    // False when the entry is expired, revoked or not newer than ours
+    bool AddEntry(CrdtEntry entry, int64_t now);
+    // remove_entry = false matches loading from JSON, which keeps the entry
+    void AddTombstone(CrdtTombstone tombstone, bool remove_entry = true);
+
+    bool IsRevoked(const std::string& peer_id, int64_t now) const;
+    bool GetEntry(const std::string& peer_id, int64_t now, CrdtEntry& out);
+
+    CrdtMergeStats Merge(PhonebookCrdt& other, int64_t now);
+    // Drops expired entries and tombstones; returns how many were dropped
+    size_t Cleanup(int64_t now);
+
+    size_t EntryCount();
+    bool EntryAt(size_t index, CrdtEntry& out);
+    size_t TombstoneCount();
+    bool TombstoneAt(size_t index, CrdtTombstone& out);
+
+private:
+    // Adds append unsorted; reads and merges sort them in first
+    void NormalizeLocked();
+    void RebuildIndexLocked();
+
+    mutable std::mutex mutex_;
+    std::vector<CrdtEntry> entries_;         // sorted by peer id once normalized
+    std::vector<CrdtTombstone> tombstones_;  // sorted by peer id once normalized
+    size_t sorted_entries_ = 0;              // prefix of entries_ already sorted and unique
+    size_t sorted_tombstones_ = 0;
+    std::unordered_map<std::string, int64_t> revoked_; // peer id -> tombstone timestamp
+};
+
+}
@@ -0,0 +1,320 @@
+#include "selective_ack.h"
+#include "frame_util.h"
+#include "wire_codec.h"
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace fyteclub {
+
+using wire::ReadVarint;
+using wire::VarintSize;
+using wire::WriteVarint;
+
+namespace {
+
+constexpr size_t kMaxVarint32 = 5;
+constexpr size_t kMaxVarint64 = 10;
+
+int CountTrailingZeros(uint64_t value) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(value);
+#endif
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// ChunkIndexSet
+// ---------------------------------------------------------------------------
+
+bool ChunkIndexSet::Add(uint32_t index) {
+    const uint16_t key = static_cast<uint16_t>(index >> 16);
+    const uint16_t low = static_cast<uint16_t>(index);
+    auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+                               [](const Container& c, uint16_t k) { return c.key < k; });
+    if (it == containers_.end() || it->key != key) {
+        it = containers_.insert(it, Container{});
+        it->key = key;
+    }
+    Container& container = *it;
+
+    if (!container.bitmap.empty()) {
+        uint64_t& word = container.bitmap[low >> 6];
+        uint64_t bit = 1ull << (low & 63);
+        if (word & bit) return false;
+        word |= bit;
+    } else {
+        auto position = std::lower_bound(container.array.begin(), container.array.end(), low);
+        if (position != container.array.end() && *position == low) return false;
+        container.array.insert(position, low);
+        if (container.array.size() > kArrayMax) {
+            // Dense now: a bitmap is smaller than the array from here on
+            container.bitmap.assign(kBitmapWords, 0);
+            for (uint16_t value : container.array) container.bitmap[value >> 6] |= 1ull << (value & 63);
+            container.array.clear();
+            container.array.shrink_to_fit();
+        }
+    }
+    container.cardinality++;
+    count_++;
+    return true;
+}
+
+bool ChunkIndexSet::Contains(uint32_t index) const {
+    const uint16_t key = static_cast<uint16_t>(index >> 16);
+    const uint16_t low = static_cast<uint16_t>(index);
+    auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+                               [](const Container& c, uint16_t k) { return c.key < k; });
+    if (it == containers_.end() || it->key != key) return false;
+    if (!it->bitmap.empty()) return (it->bitmap[low >> 6] >> (low & 63)) & 1;
+    return std::binary_search(it->array.begin(), it->array.end(), low);
+}
+
+void ChunkIndexSet::ForEachRun(const std::function<bool(uint32_t, uint32_t)>& visit) const {
+    // Runs are stitched across container boundaries, so a run is only
+    // reported once the next member is known not to extend it
+    bool open = false;
+    bool stopped = false;
+    uint64_t run_start = 0;
+    uint64_t run_end = 0;
+    auto extend = [&](uint64_t start, uint64_t end) {
+        if (open && start == run_end) {
+            run_end = end;
+            return;
+        }
+        if (open && !visit(static_cast<uint32_t>(run_start), static_cast<uint32_t>(run_end - run_start))) {
+            stopped = true;
+        }
+        open = true;
+        run_start = start;
+        run_end = end;
+    };
+
+    for (const auto& container : containers_) {
+        const uint64_t base = static_cast<uint64_t>(container.key) << 16;
+        if (container.bitmap.empty()) {
+            for (size_t i = 0; i < container.array.size() && !stopped; ++i) {
+                extend(base + container.array[i], base + container.array[i] + 1);
+            }
+        } else {
+            for (size_t w = 0; w < kBitmapWords && !stopped; ++w) {
+                uint64_t word = container.bitmap[w];
+                while (word && !stopped) {
+                    int first = CountTrailingZeros(word);
+                    uint64_t ones = ~(word >> first);
+                    int length = ones == 0 ? 64 - first : CountTrailingZeros(ones);
+                    uint64_t start = base + w * 64 + first;
+                    extend(start, start + length);
+                    if (first + length >= 64) break;
+                    word &= ~0ull << (first + length);
+                }
+            }
+        }
+        if (stopped) return;
+    }
+    if (open) visit(static_cast<uint32_t>(run_start), static_cast<uint32_t>(run_end - run_start));
+}
+
+uint32_t ChunkIndexSet::ContiguousFromZero() const {
+    uint32_t through = 0;
+    ForEachRun([&](uint32_t start, uint32_t count) {
+        if (start == 0) through = count;
+        return false;
+    });
+    return through;
+}
+
+size_t ChunkIndexSet::MemoryUsage() const {
+    size_t bytes = containers_.capacity() * sizeof(Container);
+    for (const auto& container : containers_) {
+        bytes += container.array.capacity() * sizeof(uint16_t) + container.bitmap.capacity() * sizeof(uint64_t);
+    }
+    return bytes;
+}
+
+// ---------------------------------------------------------------------------
+// ACK frames
+// ---------------------------------------------------------------------------
+
+bool IsAckFrame(const uint8_t* frame, size_t size) {
+    return size > kFrameTrailerSize && frame[0] == kAckFrameType;
+}
+
+size_t MaxAckFrameSize() {
+    return 1 + kMaxVarint64 + 3 * kMaxVarint32 + kMaxAckGaps * 2 * kMaxVarint32 + kFrameTrailerSize;
+}
+
+size_t WriteAckFrame(uint64_t stream_id, const ChunkIndexSet& received, uint8_t* out, size_t capacity) {
+    uint32_t through = 0;
+    uint32_t end = 0;
+    std::vector<ChunkRange> gaps;
+    received.ForEachRun([&](uint32_t start, uint32_t count) {
+        if (start > end) {
+            // Out of gap slots: stop at the last run we can describe and let
+            // everything after it read as missing until the next ACK
+            if (gaps.size() == kMaxAckGaps) return false;
+            gaps.push_back({end, start - end});
+        } else {
+            through = count;
+        }
+        end = start + count;
+        return true;
+    });
+
+    size_t size = 1 + VarintSize(stream_id) + VarintSize(through) + VarintSize(end) + VarintSize(gaps.size());
+    uint32_t previous_end = through;
+    for (const auto& gap : gaps) {
+        size += VarintSize(gap.start - previous_end) + VarintSize(gap.count);
+        previous_end = gap.start + gap.count;
+    }
+    size += kFrameTrailerSize;
+    if (size > capacity) return 0;
+
+    uint8_t* p = out;
+    *p++ = kAckFrameType;
+    p = WriteVarint(p, stream_id);
+    p = WriteVarint(p, through);
+    p = WriteVarint(p, end);
+    p = WriteVarint(p, gaps.size());
+    previous_end = through;
+    for (const auto& gap : gaps) {
+        p = WriteVarint(p, gap.start - previous_end);
+        p = WriteVarint(p, gap.count);
+        previous_end = gap.start + gap.count;
+    }
+    WriteFrameTrailer(out, p);
+    return size;
+}
+
+bool ParseAckFrame(const uint8_t* frame, size_t size, AckInfo& out) {
+    if (!IsAckFrame(frame, size)) return false;
+    const uint8_t* end = frame + size - kFrameTrailerSize;
+    if (!FrameTrailerMatches(frame, size)) return false;
+
+    const uint8_t* p = frame + 1;
+    AckInfo ack;
+    uint64_t through, last, gap_count;
+    if (!ReadVarint(p, end, ack.stream_id) || !ReadVarint(p, end, through) || !ReadVarint(p, end, last) ||
+        !ReadVarint(p, end, gap_count)) {
+        return false;
+    }
+    if (through > last || last > UINT32_MAX || gap_count > kMaxAckGaps) return false;
+    ack.through = static_cast<uint32_t>(through);
+    ack.end = static_cast<uint32_t>(last);
+
+    uint64_t previous_end = through;
+    for (uint64_t i = 0; i < gap_count; ++i) {
+        uint64_t delta, count;
+        if (!ReadVarint(p, end, delta) || !ReadVarint(p, end, count)) return false;
+        uint64_t start = previous_end + delta;
+        if (count == 0 || start + count > last) return false;
+        ack.gaps.push_back({static_cast<uint32_t>(start), static_cast<uint32_t>(count)});
+        previous_end = start + count;
+    }
+    if (p != end) return false;
+    out = std::move(ack);
+    return true;
+}
+
+std::vector<ChunkRange> MissingChunks(const AckInfo& ack, uint32_t total_chunks) {
+    std::vector<ChunkRange> missing = ack.gaps;
+    if (total_chunks > ack.end) missing.push_back({ack.end, total_chunks - ack.end});
+    return missing;
+}
+
+// ---------------------------------------------------------------------------
+// AckTracker
+// ---------------------------------------------------------------------------
+
+bool AckTracker::OnChunk(uint64_t stream_id, uint32_t index) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return streams_[stream_id].Add(index);
+}
+
+uint64_t AckTracker::ReceivedCount(uint64_t stream_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = streams_.find(stream_id);
+    return it == streams_.end() ? 0 : it->second.Count();
+}
+
+size_t AckTracker::WriteAck(uint64_t stream_id, uint8_t* out, size_t capacity) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    static const ChunkIndexSet kEmpty;
+    auto it = streams_.find(stream_id);
+    return WriteAckFrame(stream_id, it == streams_.end() ? kEmpty : it->second, out, capacity);
+}
+
+void AckTracker::CloseStream(uint64_t stream_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    streams_.erase(stream_id);
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// C exports for the plugin
+// ---------------------------------------------------------------------------
+
+extern "C" {
+
+__declspec(dllexport) void* CreateAckTracker() {
+    return new fyteclub::AckTracker();
+}
+
+// Returns 1 for a new chunk, 0 for a duplicate
+__declspec(dllexport) int AckTrackerOnChunk(void* tracker, uint64_t stream_id, uint32_t chunk_index) {
+    if (!tracker) return -1;
+    return static_cast<fyteclub::AckTracker*>(tracker)->OnChunk(stream_id, chunk_index) ? 1 : 0;
+}
+
+__declspec(dllexport) uint64_t AckTrackerReceivedCount(void* tracker, uint64_t stream_id) {
+    return tracker ? static_cast<fyteclub::AckTracker*>(tracker)->ReceivedCount(stream_id) : 0;
+}
+
+// Writes the stream's ACK frame; returns its size, or -1 when capacity is too
+// small (AckFrameMaxSize always suffices)
+__declspec(dllexport) int AckTrackerWriteFrame(void* tracker, uint64_t stream_id, uint8_t* out, int capacity) {
+    if (!tracker || !out || capacity < 0) return -1;
+    size_t size = static_cast<fyteclub::AckTracker*>(tracker)->WriteAck(stream_id, out, static_cast<size_t>(capacity));
+    return size ? static_cast<int>(size) : -1;
+}
+
+__declspec(dllexport) int AckFrameMaxSize() {
+    return static_cast<int>(fyteclub::MaxAckFrameSize());
+}
+
+__declspec(dllexport) void AckTrackerCloseStream(void* tracker, uint64_t stream_id) {
+    if (tracker) static_cast<fyteclub::AckTracker*>(tracker)->CloseStream(stream_id);
+}
+
+__declspec(dllexport) void DestroyAckTracker(void* tracker) {
+    delete static_cast<fyteclub::AckTracker*>(tracker);
+}
+
+// Sender side: decodes an ACK and writes the chunk ranges to resend as
+// (start, count) pairs into ranges. total_chunks adds the unacknowledged
+// tail. Returns the number of ranges written (at most max_ranges), or -1 for
+// a frame that is not a valid ACK.
+__declspec(dllexport) int AckFrameMissingRanges(const uint8_t* frame, int size, uint32_t total_chunks,
+                                                uint64_t* stream_id, uint32_t* ranges, int max_ranges) {
+    if (!frame || size < 0 || !ranges || max_ranges < 0) return -1;
+    fyteclub::AckInfo ack;
+    if (!fyteclub::ParseAckFrame(frame, static_cast<size_t>(size), ack)) return -1;
+    if (stream_id) *stream_id = ack.stream_id;
+    auto missing = fyteclub::MissingChunks(ack, total_chunks);
+    int written = std::min(static_cast<int>(missing.size()), max_ranges);
+    for (int i = 0; i < written; ++i) {
+        ranges[i * 2] = missing[i].start;
+        ranges[i * 2 + 1] = missing[i].count;
+    }
+    return written;
+}
+
+}
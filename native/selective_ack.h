@@ -0,0 +1,98 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Selective acknowledgement for chunk streams. Recovery today is whole-file
+// (RecoveryRequestMessage lists completed files) and ProgressiveFileTransfer
+// keeps received chunk indexes in a HashSet<int>. Here the receiver keeps a
+// compressed set of received chunk indexes per stream and periodically sends
+// an ACK frame; after a reconnect or channel failure the sender resends
+// exactly the chunks the ACK reports missing.
+//
+//   ACK  C6 | stream id | through | end | gap count | (gap start delta, gap length)* | crc32c
+//
+// Chunks [0, through) have all arrived; end is one past the highest chunk
+// received. Each gap is a run of missing chunks between through and end,
+// its start given relative to the end of the previous gap (or to through).
+// Chunks at or past end are implicitly missing. Same varint/CRC conventions
+// as chunk_frame.h.
+
+namespace fyteclub {
+
+constexpr uint8_t kAckFrameType = 0xC6;
+// Gaps beyond this are left for the next ACK once the first ones are filled
+constexpr size_t kMaxAckGaps = 256;
+
+struct ChunkRange {
+    uint32_t start = 0;
+    uint32_t count = 0;
+};
+
+// Roaring-style set of chunk indexes: the high 16 bits pick a container, and
+// each container is a sorted array while sparse and a 64K-bit bitmap once it
+// holds more than 4096 entries. A fully received 100k-chunk stream costs a
+// couple of bitmaps instead of a hash node per chunk.
+class ChunkIndexSet {
+public:
+    // Returns true when index was not already present
+    bool Add(uint32_t index);
+    bool Contains(uint32_t index) const;
+    uint64_t Count() const { return count_; }
+    // Length of the run of members starting at 0
+    uint32_t ContiguousFromZero() const;
+    // Calls visit(start, count) for each maximal run of members, in order,
+    // until it returns false
+    void ForEachRun(const std::function<bool(uint32_t, uint32_t)>& visit) const;
+    size_t MemoryUsage() const;
+
+private:
+    static constexpr size_t kArrayMax = 4096;
+    static constexpr size_t kBitmapWords = 65536 / 64;
+
+    struct Container {
+        uint16_t key = 0;
+        uint32_t cardinality = 0;
+        std::vector<uint16_t> array;   // sorted, while cardinality <= kArrayMax
+        std::vector<uint64_t> bitmap;  // kBitmapWords words once converted
+    };
+
+    std::vector<Container> containers_; // sorted by key
+    uint64_t count_ = 0;
+};
+
+struct AckInfo {
+    uint64_t stream_id = 0;
+    uint32_t through = 0;
+    uint32_t end = 0;
+    std::vector<ChunkRange> gaps;
+};
+
+bool IsAckFrame(const uint8_t* frame, size_t size);
+// Builds an ACK for a set; returns the frame size, or 0 when capacity is too small
+size_t WriteAckFrame(uint64_t stream_id, const ChunkIndexSet& received, uint8_t* out, size_t capacity);
+size_t MaxAckFrameSize();
+bool ParseAckFrame(const uint8_t* frame, size_t size, AckInfo& out);
+
+// What the sender should resend: the reported gaps plus [end, total_chunks).
+// Zero total_chunks leaves out the tail.
+std::vector<ChunkRange> MissingChunks(const AckInfo& ack, uint32_t total_chunks);
+
+// Receiver side: one set per open stream. Thread-safe.
+class AckTracker {
+public:
+    // Returns true for a chunk not seen before
+    bool OnChunk(uint64_t stream_id, uint32_t index);
+    uint64_t ReceivedCount(uint64_t stream_id) const;
+    size_t WriteAck(uint64_t stream_id, uint8_t* out, size_t capacity) const;
+    void CloseStream(uint64_t stream_id);
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, ChunkIndexSet> streams_;
+};
+
+}
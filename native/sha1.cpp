@@ -0,0 +1,127 @@
+#include "sha1.h"
+#include <cstring>
+
+namespace fyteclub {
+
+namespace {
+
+inline uint32_t RotateLeft(uint32_t value, int bits) {
+    return (value << bits) | (value >> (32 - bits));
+}
+
+}
+
+Sha1::Sha1() {
+    state_[0] = 0x67452301;
+    state_[1] = 0xefcdab89;
+    state_[2] = 0x98badcfe;
+    state_[3] = 0x10325476;
+    state_[4] = 0xc3d2e1f0;
+}
+
+void Sha1::Transform(const uint8_t block[64]) {
+    uint32_t w[80];
+    for (int i = 0; i < 16; ++i) {
+        w[i] = (uint32_t(block[i * 4]) << 24) | (uint32_t(block[i * 4 + 1]) << 16) |
+               (uint32_t(block[i * 4 + 2]) << 8) | uint32_t(block[i * 4 + 3]);
+    }
+    for (int i = 16; i < 80; ++i) {
+        w[i] = RotateLeft(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+    }
+
+    uint32_t a = state_[0], b = state_[1], c = state_[2], d = state_[3], e = state_[4];
+    for (int i = 0; i < 80; ++i) {
+        uint32_t f, k;
+        if (i < 20) {
+            f = (b & c) | (~b & d);
+            k = 0x5a827999;
+        } else if (i < 40) {
+            f = b ^ c ^ d;
+            k = 0x6ed9eba1;
+        } else if (i < 60) {
+            f = (b & c) | (b & d) | (c & d);
+            k = 0x8f1bbcdc;
+        } else {
+            f = b ^ c ^ d;
+            k = 0xca62c1d6;
+        }
+        uint32_t t = RotateLeft(a, 5) + f + e + k + w[i];
+        e = d;
+        d = c;
+        c = RotateLeft(b, 30);
+        b = a;
+        a = t;
+    }
+
+    state_[0] += a;
+    state_[1] += b;
+    state_[2] += c;
+    state_[3] += d;
+    state_[4] += e;
+}
+
+void Sha1::Update(const uint8_t* data, size_t length) {
+    total_length_ += length;
+
+    if (buffered_ > 0) {
+        size_t take = 64 - buffered_;
+        if (take > length) take = length;
+        memcpy(buffer_ + buffered_, data, take);
+        buffered_ += take;
+        data += take;
+        length -= take;
+        if (buffered_ < 64) return;
+        Transform(buffer_);
+        buffered_ = 0;
+    }
+
+    while (length >= 64) {
+        Transform(data);
+        data += 64;
+        length -= 64;
+    }
+
+    if (length > 0) {
+        memcpy(buffer_, data, length);
+        buffered_ = length;
+    }
+}
+
+void Sha1::Final(uint8_t digest[kDigestSize]) {
+    uint64_t bit_length = total_length_ * 8;
+
+    uint8_t padding[72] = {0x80};
+    size_t pad_length = (buffered_ < 56) ? (56 - buffered_) : (120 - buffered_);
+    for (int i = 0; i < 8; ++i) {
+        padding[pad_length + i] = static_cast<uint8_t>(bit_length >> (56 - i * 8));
+    }
+    Update(padding, pad_length + 8);
+
+    for (int i = 0; i < 5; ++i) {
+        digest[i * 4] = static_cast<uint8_t>(state_[i] >> 24);
+        digest[i * 4 + 1] = static_cast<uint8_t>(state_[i] >> 16);
+        digest[i * 4 + 2] = static_cast<uint8_t>(state_[i] >> 8);
+        digest[i * 4 + 3] = static_cast<uint8_t>(state_[i]);
+    }
+}
+
+void Sha1::Hash(const uint8_t* data, size_t length, uint8_t digest[kDigestSize]) {
+    Sha1 sha;
+    sha.Update(data, length);
+    sha.Final(digest);
+}
+
+std::string Sha1::HexDigest(const uint8_t* data, size_t length) {
+    static const char kHex[] = "0123456789ABCDEF";
+    uint8_t digest[kDigestSize];
+    Hash(data, length, digest);
+
+    std::string hex(kDigestSize * 2, '0');
+    for (size_t i = 0; i < kDigestSize; ++i) {
+        hex[i * 2] = kHex[digest[i] >> 4];
+        hex[i * 2 + 1] = kHex[digest[i] & 0x0F];
+    }
+    return hex;
+}
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// SHA-1 matching System.Security.Cryptography.SHA1. The plugin names cached
+// mod files by the SHA-1 of their content (FileTransferSystem), so native
+// code that writes into that cache needs it to verify what it stores. Not
+// for anything that needs collision resistance.
+
+namespace fyteclub {
+
+class Sha1 {
+public:
+    static constexpr size_t kDigestSize = 20;
+
+    Sha1();
+
+    void Update(const uint8_t* data, size_t length);
+    void Final(uint8_t digest[kDigestSize]);
+
+    static void Hash(const uint8_t* data, size_t length, uint8_t digest[kDigestSize]);
+    // Uppercase hex, same as the plugin's ComputeFileHash
+    static std::string HexDigest(const uint8_t* data, size_t length);
+
+private:
+    void Transform(const uint8_t block[64]);
+
+    uint32_t state_[5];
+    uint8_t buffer_[64];
+    uint64_t total_length_ = 0;
+    size_t buffered_ = 0;
+};
+
+}
@@ -0,0 +1,165 @@
+#include "sha256.h"
+#include <cstring>
+
+namespace fyteclub {
+
+namespace {
+
+constexpr uint32_t kRoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+inline uint32_t RotateRight(uint32_t value, int bits) {
+    return (value >> bits) | (value << (32 - bits));
+}
+
+}
+
+Sha256::Sha256() {
+    state_[0] = 0x6a09e667;
+    state_[1] = 0xbb67ae85;
+    state_[2] = 0x3c6ef372;
+    state_[3] = 0xa54ff53a;
+    state_[4] = 0x510e527f;
+    state_[5] = 0x9b05688c;
+    state_[6] = 0x1f83d9ab;
+    state_[7] = 0x5be0cd19;
+}
+
+void Sha256::Transform(const uint8_t block[64]) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; ++i) {
+        w[i] = (uint32_t(block[i * 4]) << 24) | (uint32_t(block[i * 4 + 1]) << 16) |
+               (uint32_t(block[i * 4 + 2]) << 8) | uint32_t(block[i * 4 + 3]);
+    }
+    for (int i = 16; i < 64; ++i) {
+        uint32_t s0 = RotateRight(w[i - 15], 7) ^ RotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = RotateRight(w[i - 2], 17) ^ RotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+    uint32_t e = state_[4], f = state_[5], g = state_[6], h = state_[7];
+    for (int i = 0; i < 64; ++i) {
+        uint32_t s1 = RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+        uint32_t ch = (e & f) ^ (~e & g);
+        uint32_t t1 = h + s1 + ch + kRoundConstants[i] + w[i];
+        uint32_t s0 = RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+        uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t t2 = s0 + maj;
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    state_[0] += a;
+    state_[1] += b;
+    state_[2] += c;
+    state_[3] += d;
+    state_[4] += e;
+    state_[5] += f;
+    state_[6] += g;
+    state_[7] += h;
+}
+
+void Sha256::Update(const uint8_t* data, size_t length) {
+    total_length_ += length;
+
+    if (buffered_ > 0) {
+        size_t take = 64 - buffered_;
+        if (take > length) take = length;
+        memcpy(buffer_ + buffered_, data, take);
+        buffered_ += take;
+        data += take;
+        length -= take;
+        if (buffered_ < 64) return;
+        Transform(buffer_);
+        buffered_ = 0;
+    }
+
+    while (length >= 64) {
+        Transform(data);
+        data += 64;
+        length -= 64;
+    }
+
+    if (length > 0) {
+        memcpy(buffer_, data, length);
+        buffered_ = length;
+    }
+}
+
+void Sha256::Final(uint8_t digest[kDigestSize]) {
+    uint64_t bit_length = total_length_ * 8;
+
+    uint8_t padding[72] = {0x80};
+    size_t pad_length = (buffered_ < 56) ? (56 - buffered_) : (120 - buffered_);
+    for (int i = 0; i < 8; ++i) {
+        padding[pad_length + i] = static_cast<uint8_t>(bit_length >> (56 - i * 8));
+    }
+    Update(padding, pad_length + 8);
+
+    for (int i = 0; i < 8; ++i) {
+        digest[i * 4] = static_cast<uint8_t>(state_[i] >> 24);
+        digest[i * 4 + 1] = static_cast<uint8_t>(state_[i] >> 16);
+        digest[i * 4 + 2] = static_cast<uint8_t>(state_[i] >> 8);
+        digest[i * 4 + 3] = static_cast<uint8_t>(state_[i]);
+    }
+}
+
+void Sha256::Hash(const uint8_t* data, size_t length, uint8_t digest[kDigestSize]) {
+    Sha256 sha;
+    sha.Update(data, length);
+    sha.Final(digest);
+}
+
+void Sha256::Hmac(const uint8_t* key, size_t key_length, const uint8_t* data, size_t length,
+                  uint8_t mac[kDigestSize]) {
+    uint8_t block[64] = {};
+    if (key_length > sizeof(block)) {
+        Hash(key, key_length, block);
+    } else if (key_length > 0) {
+        memcpy(block, key, key_length);
+    }
+
+    uint8_t pad[64];
+    for (int i = 0; i < 64; ++i) pad[i] = block[i] ^ 0x36;
+    uint8_t inner[kDigestSize];
+    Sha256 inner_sha;
+    inner_sha.Update(pad, sizeof(pad));
+    inner_sha.Update(data, length);
+    inner_sha.Final(inner);
+
+    for (int i = 0; i < 64; ++i) pad[i] = block[i] ^ 0x5c;
+    Sha256 outer_sha;
+    outer_sha.Update(pad, sizeof(pad));
+    outer_sha.Update(inner, sizeof(inner));
+    outer_sha.Final(mac);
+}
+
+std::string Sha256::HexDigest(const uint8_t* data, size_t length) {
+    static const char kHex[] = "0123456789ABCDEF";
+    uint8_t digest[kDigestSize];
+    Hash(data, length, digest);
+
+    std::string hex(kDigestSize * 2, '0');
+    for (size_t i = 0; i < kDigestSize; ++i) {
+        hex[i * 2] = kHex[digest[i] >> 4];
+        hex[i * 2 + 1] = kHex[digest[i] & 0x0F];
+    }
+    return hex;
+}
+
+}
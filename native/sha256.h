@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// SHA-256 matching System.Security.Cryptography.SHA256. The native transfer
+// paths use it to verify content they name by SHA-256 and for HMACs. The
+// plugin's FileReplacements content is named by SHA-1 instead (sha1.h).
+
+namespace fyteclub {
+
+class Sha256 {
+public:
+    static constexpr size_t kDigestSize = 32;
+
+    Sha256();
+
+    void Update(const uint8_t* data, size_t length);
+    void Final(uint8_t digest[kDigestSize]);
+
+    static void Hash(const uint8_t* data, size_t length, uint8_t digest[kDigestSize]);
+    // HMAC-SHA256 (RFC 2104), same result as System.Security.Cryptography.HMACSHA256
+    static void Hmac(const uint8_t* key, size_t key_length, const uint8_t* data, size_t length,
+                     uint8_t mac[kDigestSize]);
+    // Uppercase hex, same as Convert.ToHexString on the C# side
+    static std::string HexDigest(const uint8_t* data, size_t length);
+
+private:
+    void Transform(const uint8_t block[64]);
+
+    uint32_t state_[8];
+    uint8_t buffer_[64];
+    uint64_t total_length_ = 0;
+    size_t buffered_ = 0;
+};
+
+}
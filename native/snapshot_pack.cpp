@@ -0,0 +1,622 @@
+#include "snapshot_pack.h"
+#include "frame_util.h"
+#include "wire_codec.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace fyteclub {
+
+using wire::ReadVarint;
+
+namespace {
+
+constexpr size_t kMaxPlayerIdLength = 256;
+
+std::vector<uint8_t> BeginFrame(SnapshotPackFrameKind kind, uint64_t pack_id) {
+    std::vector<uint8_t> frame = {kSnapshotPackFrameType, static_cast<uint8_t>(kind)};
+    AppendVarint(frame, pack_id);
+    return frame;
+}
+
+int HexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// 0 for an unknown algorithm byte
+size_t DigestSize(SnapshotDigestAlgorithm algorithm) {
+    switch (algorithm) {
+    case SnapshotDigestAlgorithm::Sha1: return Sha1::kDigestSize;
+    case SnapshotDigestAlgorithm::Sha256: return Sha256::kDigestSize;
+    default: return 0;
+    }
+}
+
+// The algorithm follows from the length: 40 hex is SHA-1, 64 hex SHA-256.
+// out must hold Sha256::kDigestSize bytes.
+bool ParseDigest(std::string_view hex, SnapshotDigestAlgorithm& algorithm, uint8_t* out) {
+    if (hex.size() == Sha1::kDigestSize * 2) {
+        algorithm = SnapshotDigestAlgorithm::Sha1;
+    } else if (hex.size() == Sha256::kDigestSize * 2) {
+        algorithm = SnapshotDigestAlgorithm::Sha256;
+    } else {
+        return false;
+    }
+    for (size_t i = 0; i < hex.size() / 2; ++i) {
+        int high = HexValue(hex[i * 2]);
+        int low = HexValue(hex[i * 2 + 1]);
+        if (high < 0 || low < 0) return false;
+        out[i] = static_cast<uint8_t>((high << 4) | low);
+    }
+    return true;
+}
+
+// Reads an algorithm byte and the digest behind it
+bool ReadDigest(const uint8_t*& p, const uint8_t* end, SnapshotDigestAlgorithm& algorithm, const uint8_t*& digest,
+                size_t& size) {
+    if (p == end) return false;
+    algorithm = static_cast<SnapshotDigestAlgorithm>(*p++);
+    size = DigestSize(algorithm);
+    if (size == 0 || size > static_cast<size_t>(end - p)) return false;
+    digest = p;
+    p += size;
+    return true;
+}
+
+// Uppercase, as the plugin names content files
+std::string DigestHex(const uint8_t* digest, size_t size) {
+    static const char kDigits[] = "0123456789ABCDEF";
+    std::string hex(size * 2, '0');
+    for (size_t i = 0; i < size; ++i) {
+        hex[i * 2] = kDigits[digest[i] >> 4];
+        hex[i * 2 + 1] = kDigits[digest[i] & 0xF];
+    }
+    return hex;
+}
+
+// Checks type, CRC and kind; leaves p after the pack id and end before the CRC
+bool OpenFrame(const uint8_t* frame, size_t size, SnapshotPackFrameKind& kind, uint64_t& pack_id, const uint8_t*& p,
+               const uint8_t*& end) {
+    if (!frame || size < 2 + kFrameTrailerSize || frame[0] != kSnapshotPackFrameType) return false;
+    end = frame + size - kFrameTrailerSize;
+    if (!FrameTrailerMatches(frame, size)) return false;
+    if (frame[1] > static_cast<uint8_t>(SnapshotPackFrameKind::End)) return false;
+    kind = static_cast<SnapshotPackFrameKind>(frame[1]);
+    p = frame + 2;
+    return ReadVarint(p, end, pack_id);
+}
+
+}
+
+std::vector<uint8_t> WriteSnapshotPackRequest(uint64_t pack_id, const std::vector<std::string>& have_hashes) {
+    std::vector<uint64_t> prefixes;
+    prefixes.reserve(have_hashes.size());
+    for (const auto& hash : have_hashes) {
+        SnapshotDigestAlgorithm algorithm;
+        uint8_t digest[Sha256::kDigestSize];
+        if (ParseDigest(hash, algorithm, digest)) prefixes.push_back(LoadLe64(digest));
+    }
+    std::sort(prefixes.begin(), prefixes.end());
+    prefixes.erase(std::unique(prefixes.begin(), prefixes.end()), prefixes.end());
+
+    std::vector<uint8_t> frame = BeginFrame(SnapshotPackFrameKind::Request, pack_id);
+    AppendVarint(frame, prefixes.size());
+    if (frame.size() + prefixes.size() * 8 + kFrameTrailerSize > kMaxSnapshotPackFrameSize) return {};
+    for (uint64_t prefix : prefixes) {
+        for (int i = 0; i < 8; ++i) frame.push_back(static_cast<uint8_t>(prefix >> (i * 8)));
+    }
+    SealFrame(frame);
+    return frame;
+}
+
+// ---------------------------------------------------------------------------
+// SnapshotPackWriter
+// ---------------------------------------------------------------------------
+
+size_t SnapshotPackWriter::DigestHash::operator()(const Digest& digest) const {
+    // Digests are already uniform
+    return static_cast<size_t>(LoadLe64(digest.bytes.data())) ^ static_cast<size_t>(digest.algorithm);
+}
+
+SnapshotPackWriter::SnapshotPackWriter(uint32_t chunk_size)
+    : chunk_size_(std::clamp<uint32_t>(chunk_size, 1024, kMaxSnapshotPackFrameSize - 64)) {}
+
+SnapshotPackWriter::~SnapshotPackWriter() {
+    if (file_) fclose(file_);
+}
+
+bool SnapshotPackWriter::LoadRequest(const uint8_t* frame, size_t size) {
+    SnapshotPackFrameKind kind;
+    uint64_t pack_id;
+    const uint8_t* p;
+    const uint8_t* end;
+    if (!OpenFrame(frame, size, kind, pack_id, p, end) || kind != SnapshotPackFrameKind::Request) return false;
+    uint64_t count;
+    if (!ReadVarint(p, end, count) || count != static_cast<uint64_t>(end - p) / 8 || (end - p) % 8 != 0) return false;
+
+    pack_id_ = pack_id;
+    have_.clear();
+    have_.reserve(static_cast<size_t>(count));
+    for (; p < end; p += 8) have_.insert(LoadLe64(p));
+    return true;
+}
+
+bool SnapshotPackWriter::AddMember(const std::string& player_id, const uint8_t* recipe, size_t recipe_size,
+                                   const std::vector<std::string>& hashes) {
+    if (planned_ || player_id.empty() || player_id.size() > kMaxPlayerIdLength) return false;
+    // type, kind, pack id, three length prefixes, tagged hashes, CRC
+    size_t frame_size = 2 + 10 + 3 * 10 + player_id.size() + recipe_size +
+                        hashes.size() * (1 + Sha256::kDigestSize) + kFrameTrailerSize;
+    if (frame_size > kMaxSnapshotPackFrameSize) return false;
+
+    Member member;
+    member.player_id = player_id;
+    member.recipe.assign(recipe, recipe + recipe_size);
+    member.hashes.resize(hashes.size());
+    for (size_t i = 0; i < hashes.size(); ++i) {
+        Digest& digest = member.hashes[i];
+        if (!ParseDigest(hashes[i], digest.algorithm, digest.bytes.data())) return false;
+    }
+    members_.push_back(std::move(member));
+    return true;
+}
+
+bool SnapshotPackWriter::AddContent(const std::string& hash, const std::string& path) {
+    Digest digest;
+    if (planned_ || !ParseDigest(hash, digest.algorithm, digest.bytes.data())) return false;
+    paths_[digest] = path;
+    return true;
+}
+
+void SnapshotPackWriter::Plan() {
+    planned_ = true;
+
+    // What each member would add on its own, ignoring overlap with others.
+    // Cheap members go first so the joiner sees most people quickly.
+    std::unordered_map<Digest, uint64_t, DigestHash> sizes;
+    for (const auto& [digest, path] : paths_) {
+        if (have_.count(LoadLe64(digest.bytes.data()))) continue;
+        std::error_code error;
+        uint64_t size = fs::file_size(fs::u8path(path), error);
+        if (!error) sizes.emplace(digest, size);
+    }
+    std::vector<std::pair<uint64_t, size_t>> order; // new bytes, member index
+    order.reserve(members_.size());
+    for (size_t i = 0; i < members_.size(); ++i) {
+        uint64_t bytes = 0;
+        for (const auto& digest : members_[i].hashes) {
+            auto it = sizes.find(digest);
+            if (it != sizes.end()) bytes += it->second;
+        }
+        order.emplace_back(bytes, i);
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    // Each hash goes out once, ahead of the first member that needs it
+    std::unordered_set<Digest, DigestHash> sent;
+    for (const auto& [bytes, member] : order) {
+        for (const auto& digest : members_[member].hashes) {
+            auto it = sizes.find(digest);
+            if (it == sizes.end() || !sent.insert(digest).second) continue;
+            steps_.push_back({SnapshotPackFrameKind::Content, contents_.size()});
+            contents_.push_back({digest, paths_[digest], it->second});
+            content_bytes_ += it->second;
+        }
+        steps_.push_back({SnapshotPackFrameKind::Member, member});
+    }
+}
+
+bool SnapshotPackWriter::Prepare() {
+    if (!ready_.empty()) return true;
+    if (!planned_) Plan();
+
+    if (!header_sent_) {
+        ready_ = BeginFrame(SnapshotPackFrameKind::Header, pack_id_);
+        AppendVarint(ready_, members_.size());
+        AppendVarint(ready_, contents_.size());
+        AppendVarint(ready_, content_bytes_);
+        SealFrame(ready_);
+        header_sent_ = true;
+        return true;
+    }
+
+    if (file_remaining_ > 0) {
+        size_t length = static_cast<size_t>(std::min<uint64_t>(chunk_size_, file_remaining_));
+        ready_ = BeginFrame(SnapshotPackFrameKind::Data, pack_id_);
+        size_t header = ready_.size();
+        ready_.resize(header + length);
+        size_t got = file_ ? fread(ready_.data() + header, 1, length, file_) : 0;
+        if (got < length) {
+            // The file shrank since it was planned. Zero-fill so the stream
+            // stays in step; the joiner's hash check rejects this content.
+            memset(ready_.data() + header + got, 0, length - got);
+        }
+        file_remaining_ -= length;
+        if (file_remaining_ == 0 && file_) {
+            fclose(file_);
+            file_ = nullptr;
+        }
+        SealFrame(ready_);
+        return true;
+    }
+
+    if (next_step_ < steps_.size()) {
+        const Step step = steps_[next_step_++];
+        if (step.kind == SnapshotPackFrameKind::Content) {
+            const Content& content = contents_[step.index];
+#ifdef _WIN32
+            file_ = _wfopen(fs::u8path(content.path).c_str(), L"rb");
+#else
+            file_ = fopen(content.path.c_str(), "rb");
+#endif
+            file_remaining_ = content.size;
+            ready_ = BeginFrame(SnapshotPackFrameKind::Content, pack_id_);
+            ready_.push_back(static_cast<uint8_t>(content.hash.algorithm));
+            ready_.insert(ready_.end(), content.hash.bytes.begin(),
+                          content.hash.bytes.begin() + DigestSize(content.hash.algorithm));
+            AppendVarint(ready_, content.size);
+        } else {
+            const Member& member = members_[step.index];
+            ready_ = BeginFrame(SnapshotPackFrameKind::Member, pack_id_);
+            AppendBytes(ready_, member.player_id.data(), member.player_id.size());
+            AppendBytes(ready_, member.recipe.data(), member.recipe.size());
+            AppendVarint(ready_, member.hashes.size());
+            for (const auto& digest : member.hashes) {
+                ready_.push_back(static_cast<uint8_t>(digest.algorithm));
+                ready_.insert(ready_.end(), digest.bytes.begin(), digest.bytes.begin() + DigestSize(digest.algorithm));
+            }
+        }
+        SealFrame(ready_);
+        return true;
+    }
+
+    if (!end_sent_) {
+        ready_ = BeginFrame(SnapshotPackFrameKind::End, pack_id_);
+        SealFrame(ready_);
+        end_sent_ = true;
+        return true;
+    }
+    return false;
+}
+
+bool SnapshotPackWriter::PeekFrameSize(size_t& size) {
+    if (!Prepare()) return false;
+    size = ready_.size();
+    return true;
+}
+
+size_t SnapshotPackWriter::NextFrame(uint8_t* out, size_t capacity) {
+    if (!Prepare() || ready_.size() > capacity) return 0;
+    size_t size = ready_.size();
+    memcpy(out, ready_.data(), size);
+    ready_.clear();
+    return size;
+}
+
+size_t SnapshotPackWriter::ContentCount() {
+    if (!planned_) Plan();
+    return contents_.size();
+}
+
+uint64_t SnapshotPackWriter::ContentBytes() {
+    if (!planned_) Plan();
+    return content_bytes_;
+}
+
+// ---------------------------------------------------------------------------
+// SnapshotPackReader
+// ---------------------------------------------------------------------------
+
+SnapshotPackReader::SnapshotPackReader(std::string output_dir, uint64_t pack_id)
+    : output_dir_(std::move(output_dir)), pack_id_(pack_id) {}
+
+SnapshotPackReader::~SnapshotPackReader() {
+    if (open_) AbandonContent();
+}
+
+bool SnapshotPackReader::OnFrame(const uint8_t* frame, size_t size) {
+    if (finished_ || failed_) return false;
+    SnapshotPackFrameKind kind;
+    uint64_t pack_id;
+    const uint8_t* p;
+    const uint8_t* end;
+    if (!OpenFrame(frame, size, kind, pack_id, p, end) || pack_id != pack_id_) return false;
+
+    // Anything out of sequence abandons the pack: later frames cannot be
+    // trusted to line up with what came before
+    auto fail = [&] {
+        failed_ = true;
+        if (open_) AbandonContent();
+        return false;
+    };
+    if (!header_seen_ && kind != SnapshotPackFrameKind::Header) return fail();
+    if (open_ && kind != SnapshotPackFrameKind::Data) return fail();
+
+    switch (kind) {
+    case SnapshotPackFrameKind::Header: {
+        if (header_seen_) return fail();
+        SnapshotPackEvent event;
+        event.kind = SnapshotPackEventKind::Header;
+        if (!ReadVarint(p, end, event.members) || !ReadVarint(p, end, event.contents) ||
+            !ReadVarint(p, end, event.content_bytes) || p != end) {
+            return fail();
+        }
+        header_seen_ = true;
+        events_.push_back(std::move(event));
+        return true;
+    }
+    case SnapshotPackFrameKind::Content: {
+        SnapshotDigestAlgorithm algorithm;
+        const uint8_t* digest;
+        size_t digest_size;
+        uint64_t content_size;
+        if (!ReadDigest(p, end, algorithm, digest, digest_size) || !ReadVarint(p, end, content_size) || p != end) {
+            return fail();
+        }
+        if (!OpenContent(algorithm, DigestHex(digest, digest_size), content_size)) return fail();
+        if (content_size == 0) FinishContent();
+        return true;
+    }
+    case SnapshotPackFrameKind::Data: {
+        size_t length = static_cast<size_t>(end - p);
+        if (!open_ || length == 0 || length > size_ - written_) return fail();
+        if (!file_->WriteAt(written_, p, length)) return fail();
+        if (algorithm_ == SnapshotDigestAlgorithm::Sha1) {
+            sha1_.Update(p, length);
+        } else {
+            sha256_.Update(p, length);
+        }
+        written_ += length;
+        if (written_ == size_) FinishContent();
+        return true;
+    }
+    case SnapshotPackFrameKind::Member: {
+        const uint8_t* player;
+        size_t player_size;
+        const uint8_t* recipe;
+        size_t recipe_size;
+        uint64_t count;
+        if (!ReadBytes(p, end, player, player_size) || player_size == 0 || player_size > kMaxPlayerIdLength ||
+            !ReadBytes(p, end, recipe, recipe_size) || !ReadVarint(p, end, count) ||
+            count > static_cast<uint64_t>(end - p) / (1 + Sha1::kDigestSize)) {
+            return fail();
+        }
+        SnapshotPackEvent event;
+        event.kind = SnapshotPackEventKind::Member;
+        event.player_id.assign(reinterpret_cast<const char*>(player), player_size);
+        event.recipe.assign(recipe, recipe + recipe_size);
+        for (uint64_t i = 0; i < count; ++i) {
+            SnapshotDigestAlgorithm algorithm;
+            const uint8_t* digest;
+            size_t digest_size;
+            if (!ReadDigest(p, end, algorithm, digest, digest_size)) return fail();
+            if (!failed_hashes_.empty()) event.failed += failed_hashes_.count(DigestHex(digest, digest_size)) ? 1 : 0;
+        }
+        if (p != end) return fail();
+        events_.push_back(std::move(event));
+        return true;
+    }
+    case SnapshotPackFrameKind::End: {
+        if (p != end) return fail();
+        finished_ = true;
+        SnapshotPackEvent event;
+        event.kind = SnapshotPackEventKind::End;
+        events_.push_back(std::move(event));
+        return true;
+    }
+    default:
+        return fail();
+    }
+}
+
+bool SnapshotPackReader::OpenContent(SnapshotDigestAlgorithm algorithm, const std::string& hash, uint64_t size) {
+    part_path_ = (fs::u8path(output_dir_) / (hash + ".part")).u8string();
+    file_ = PositionalFile::Create(part_path_, size);
+    if (!file_) return false;
+    hash_ = hash;
+    algorithm_ = algorithm;
+    sha1_ = Sha1();
+    sha256_ = Sha256();
+    size_ = size;
+    written_ = 0;
+    open_ = true;
+    return true;
+}
+
+void SnapshotPackReader::FinishContent() {
+    uint8_t digest[Sha256::kDigestSize];
+    if (algorithm_ == SnapshotDigestAlgorithm::Sha1) {
+        sha1_.Final(digest);
+    } else {
+        sha256_.Final(digest);
+    }
+    file_.reset();
+    open_ = false;
+
+    SnapshotPackEvent event;
+    event.kind = SnapshotPackEventKind::Content;
+    event.hash = hash_;
+    event.verified = DigestHex(digest, DigestSize(algorithm_)) == hash_;
+
+    std::error_code error;
+    auto part = fs::u8path(part_path_);
+    auto final_path = fs::u8path(output_dir_) / hash_;
+    if (event.verified) {
+        fs::rename(part, final_path, error);
+        if (error) {
+            // Same content already landed some other way
+            event.verified = fs::exists(final_path);
+            fs::remove(part, error);
+        }
+    } else {
+        fs::remove(part, error);
+    }
+    if (event.verified) {
+        event.path = final_path.u8string();
+    } else {
+        failed_hashes_.insert(hash_);
+    }
+    events_.push_back(std::move(event));
+}
+
+void SnapshotPackReader::AbandonContent() {
+    file_.reset();
+    open_ = false;
+    std::error_code error;
+    fs::remove(fs::u8path(part_path_), error);
+}
+
+bool SnapshotPackReader::PopEvent(SnapshotPackEvent& out) {
+    if (events_.empty()) return false;
+    out = std::move(events_.front());
+    events_.pop_front();
+    return true;
+}
+
+bool SnapshotPackReader::PeekEventSize(size_t& size) const {
+    if (events_.empty()) return false;
+    size = events_.front().recipe.size();
+    return true;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// C exports for the plugin
+// ---------------------------------------------------------------------------
+
+namespace {
+
+std::vector<std::string> ToStrings(const char* const* values, int count) {
+    std::vector<std::string> out;
+    if (!values || count <= 0) return out;
+    out.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) out.emplace_back(values[i] ? values[i] : "");
+    return out;
+}
+
+}
+
+extern "C" {
+
+struct SnapshotPackEventInfo {
+    int kind;          // SnapshotPackEventKind
+    int verified;      // Content
+    uint32_t failed;   // Member
+    int recipe_size;   // Member
+    uint64_t members;  // Header
+    uint64_t contents;
+    uint64_t content_bytes;
+};
+
+// Returns the frame size, or -(size needed) when capacity is too small, or
+// -1 when the have set does not fit in one frame
+__declspec(dllexport) int SnapshotPackWriteRequest(uint64_t pack_id, const char* const* have_hashes, int count,
+                                                   uint8_t* out, int capacity) {
+    if (!out || capacity < 0 || count < 0) return -1;
+    auto frame = fyteclub::WriteSnapshotPackRequest(pack_id, ToStrings(have_hashes, count));
+    if (frame.empty()) return -1;
+    if (frame.size() > static_cast<size_t>(capacity)) return -static_cast<int>(frame.size());
+    memcpy(out, frame.data(), frame.size());
+    return static_cast<int>(frame.size());
+}
+
+// Returns null if request is not a valid REQUEST frame
+__declspec(dllexport) void* CreateSnapshotPackWriter(const uint8_t* request, int size, int chunk_size) {
+    if (!request || size < 0) return nullptr;
+    auto* writer = new fyteclub::SnapshotPackWriter(chunk_size > 0 ? static_cast<uint32_t>(chunk_size) : 64 * 1024);
+    if (!writer->LoadRequest(request, static_cast<size_t>(size))) {
+        delete writer;
+        return nullptr;
+    }
+    return writer;
+}
+
+__declspec(dllexport) uint64_t SnapshotPackWriterPackId(void* writer) {
+    return writer ? static_cast<fyteclub::SnapshotPackWriter*>(writer)->PackId() : 0;
+}
+
+__declspec(dllexport) int SnapshotPackWriterAddMember(void* writer, const char* player_id, const uint8_t* recipe,
+                                                      int recipe_size, const char* const* hashes, int count) {
+    if (!writer || !player_id || recipe_size < 0 || (recipe_size > 0 && !recipe)) return 0;
+    return static_cast<fyteclub::SnapshotPackWriter*>(writer)->AddMember(
+               player_id, recipe, static_cast<size_t>(recipe_size), ToStrings(hashes, count))
+               ? 1
+               : 0;
+}
+
+__declspec(dllexport) int SnapshotPackWriterAddContent(void* writer, const char* hash, const char* path) {
+    if (!writer || !hash || !path) return 0;
+    return static_cast<fyteclub::SnapshotPackWriter*>(writer)->AddContent(hash, path) ? 1 : 0;
+}
+
+// Returns the frame size, 0 once the pack has been sent, or -(size needed)
+// when capacity is too small (the frame stays due)
+__declspec(dllexport) int SnapshotPackWriterNextFrame(void* writer, uint8_t* out, int capacity) {
+    if (!writer || !out || capacity < 0) return -1;
+    auto* pack = static_cast<fyteclub::SnapshotPackWriter*>(writer);
+    size_t size;
+    if (!pack->PeekFrameSize(size)) return 0;
+    if (size > static_cast<size_t>(capacity)) return -static_cast<int>(size);
+    return static_cast<int>(pack->NextFrame(out, static_cast<size_t>(capacity)));
+}
+
+__declspec(dllexport) void DestroySnapshotPackWriter(void* writer) {
+    delete static_cast<fyteclub::SnapshotPackWriter*>(writer);
+}
+
+__declspec(dllexport) void* CreateSnapshotPackReader(const char* output_dir, uint64_t pack_id) {
+    if (!output_dir) return nullptr;
+    return new fyteclub::SnapshotPackReader(output_dir, pack_id);
+}
+
+// 0 = handled, -1 = invalid or out of sequence (the pack is abandoned)
+__declspec(dllexport) int SnapshotPackReaderOnFrame(void* reader, const uint8_t* frame, int size) {
+    if (!reader || !frame || size < 0) return -1;
+    return static_cast<fyteclub::SnapshotPackReader*>(reader)->OnFrame(frame, static_cast<size_t>(size)) ? 0 : -1;
+}
+
+// Returns 1 and fills the outputs when an event was waiting, 0 when none, or
+// -(recipe size) when recipe_capacity is too small (the event stays queued).
+// text receives the player id (Member) or content hash (Content).
+__declspec(dllexport) int SnapshotPackReaderPopEvent(void* reader, SnapshotPackEventInfo* info, char* text,
+                                                     int text_capacity, char* path, int path_capacity,
+                                                     uint8_t* recipe, int recipe_capacity) {
+    if (!reader || !info || recipe_capacity < 0) return -1;
+    auto* pack = static_cast<fyteclub::SnapshotPackReader*>(reader);
+    size_t size;
+    if (!pack->PeekEventSize(size)) return 0;
+    if (size > static_cast<size_t>(recipe_capacity) || (size > 0 && !recipe)) return -static_cast<int>(size);
+
+    fyteclub::SnapshotPackEvent event;
+    pack->PopEvent(event);
+    info->kind = static_cast<int>(event.kind);
+    info->verified = event.verified ? 1 : 0;
+    info->failed = event.failed;
+    info->recipe_size = static_cast<int>(size);
+    info->members = event.members;
+    info->contents = event.contents;
+    info->content_bytes = event.content_bytes;
+    if (size > 0) memcpy(recipe, event.recipe.data(), size);
+    fyteclub::CopyString(event.kind == fyteclub::SnapshotPackEventKind::Member ? event.player_id : event.hash, text,
+                         text_capacity);
+    fyteclub::CopyString(event.path, path, path_capacity);
+    return 1;
+}
+
+__declspec(dllexport) int SnapshotPackReaderFinished(void* reader) {
+    return reader && static_cast<fyteclub::SnapshotPackReader*>(reader)->Finished() ? 1 : 0;
+}
+
+__declspec(dllexport) void DestroySnapshotPackReader(void* reader) {
+    delete static_cast<fyteclub::SnapshotPackReader*>(reader);
+}
+
+}
@@ -0,0 +1,208 @@
+#pragma once
+#include "chunk_assembler.h"
+#include "sha1.h"
+#include "sha256.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Snapshot pack for a new syncshell member. Joining normally sets off a
+// ModDataRequest, a manifest exchange and file transfers with every other
+// member separately, so content that several members use crosses once per
+// member. A snapshot pack is one ordered stream from a single member that
+// already holds everyone's state: each member's recipe (the plugin's
+// serialized mod data, opaque here) and the union of their content, each
+// hash sent once and only if the joiner lacks it.
+//
+//   REQUEST  CA | 0 | pack id | have count | have prefix*     joiner -> member
+//   HEADER   CA | 1 | pack id | members | contents | content bytes
+//   CONTENT  CA | 2 | pack id | algorithm | hash | size
+//   DATA     CA | 3 | pack id | payload                       appends to the open content
+//   MEMBER   CA | 4 | pack id | player id | recipe | hash count | (algorithm | hash)*
+//   END      CA | 5 | pack id
+//
+// Every frame ends with a CRC-32C. Content is named by SHA-1 (40 hex, as the
+// plugin names its files) or SHA-256 (64 hex); each hash on the wire carries
+// its algorithm byte followed by the raw digest. Have prefixes are the first
+// 8 bytes of each digest the joiner already holds (little endian), which keeps
+// the request small. A member's
+// content goes out ahead of its MEMBER frame, so when the joiner reads a
+// MEMBER frame that member can be applied at once. Members with the least
+// new content go first, so most of the syncshell appears long before the
+// biggest wardrobe has finished. The stream must be ordered and reliable,
+// and each end has one owner, so neither class takes a lock.
+
+namespace fyteclub {
+
+constexpr uint8_t kSnapshotPackFrameType = 0xCA;
+constexpr size_t kMaxSnapshotPackFrameSize = 256 * 1024;
+
+enum class SnapshotDigestAlgorithm : uint8_t {
+    Sha1 = 1,
+    Sha256 = 2,
+};
+
+enum class SnapshotPackFrameKind : uint8_t {
+    Request = 0,
+    Header = 1,
+    Content = 2,
+    Data = 3,
+    Member = 4,
+    End = 5,
+};
+
+// Builds the joiner's REQUEST; hashes that are not 40 or 64 hex digits are skipped.
+// Returns an empty frame if the have set does not fit in one frame.
+std::vector<uint8_t> WriteSnapshotPackRequest(uint64_t pack_id, const std::vector<std::string>& have_hashes);
+
+// Serving side. Fill it with AddMember/AddContent, then drain NextFrame;
+// the first NextFrame freezes the contents.
+class SnapshotPackWriter {
+public:
+    explicit SnapshotPackWriter(uint32_t chunk_size = 64 * 1024);
+    ~SnapshotPackWriter();
+    SnapshotPackWriter(const SnapshotPackWriter&) = delete;
+    SnapshotPackWriter& operator=(const SnapshotPackWriter&) = delete;
+
+    // False for a frame that is not a valid REQUEST
+    bool LoadRequest(const uint8_t* frame, size_t size);
+    uint64_t PackId() const { return pack_id_; }
+
+    // False when a hash is malformed or the MEMBER frame would be too large
+    bool AddMember(const std::string& player_id, const uint8_t* recipe, size_t recipe_size,
+                   const std::vector<std::string>& hashes);
+    // Where a content hash lives on disk. Hashes with no path are left out of
+    // the pack; the joiner fetches them the usual way.
+    bool AddContent(const std::string& hash, const std::string& path);
+
+    // Size of the next frame; false once END has been handed out
+    bool PeekFrameSize(size_t& size);
+    // Writes the next frame; 0 when done or capacity is too small
+    size_t NextFrame(uint8_t* out, size_t capacity);
+
+    // What the pack will carry; both plan the pack if it is not yet frozen
+    size_t ContentCount();
+    uint64_t ContentBytes();
+
+private:
+    struct Digest {
+        SnapshotDigestAlgorithm algorithm = SnapshotDigestAlgorithm::Sha256;
+        std::array<uint8_t, Sha256::kDigestSize> bytes{}; // SHA-1 uses the first 20
+        bool operator==(const Digest& other) const {
+            return algorithm == other.algorithm && bytes == other.bytes;
+        }
+    };
+    struct DigestHash {
+        size_t operator()(const Digest& digest) const;
+    };
+
+    struct Member {
+        std::string player_id;
+        std::vector<uint8_t> recipe;
+        std::vector<Digest> hashes;
+    };
+
+    struct Content {
+        Digest hash;
+        std::string path;
+        uint64_t size = 0;
+    };
+
+    // One step of the stream: a content (CONTENT then its DATA frames) or a MEMBER
+    struct Step {
+        SnapshotPackFrameKind kind;
+        size_t index; // into contents_ or members_
+    };
+
+    void Plan();
+    // Builds the next frame into ready_; false once the stream is done
+    bool Prepare();
+
+    const uint32_t chunk_size_;
+    uint64_t pack_id_ = 0;
+    std::unordered_set<uint64_t> have_;
+    std::vector<Member> members_;
+    std::unordered_map<Digest, std::string, DigestHash> paths_;
+
+    bool planned_ = false;
+    std::vector<Content> contents_;
+    uint64_t content_bytes_ = 0;
+    std::vector<Step> steps_;
+    size_t next_step_ = 0;
+    bool header_sent_ = false;
+    bool end_sent_ = false;
+    FILE* file_ = nullptr;        // content being sent
+    uint64_t file_remaining_ = 0;
+    std::vector<uint8_t> ready_;  // frame built by PeekFrameSize, not yet taken
+};
+
+enum class SnapshotPackEventKind {
+    Header = 0,
+    Content = 1, // one content file written (or failed to verify)
+    Member = 2,  // a member's recipe; all of its content in this pack is on disk
+    End = 3,
+};
+
+struct SnapshotPackEvent {
+    SnapshotPackEventKind kind = SnapshotPackEventKind::Header;
+    std::string player_id;          // Member
+    std::vector<uint8_t> recipe;    // Member
+    std::string hash;               // Content
+    std::string path;               // Content; empty if not verified
+    bool verified = false;          // Content
+    uint32_t failed = 0;            // Member: its hashes that failed in this pack
+    uint64_t members = 0;           // Header
+    uint64_t contents = 0;          // Header
+    uint64_t content_bytes = 0;     // Header
+};
+
+// Joining side. Content is written to <dir>/<hash>.part and renamed to
+// <dir>/<hash> once the digest named by its algorithm byte matches.
+class SnapshotPackReader {
+public:
+    SnapshotPackReader(std::string output_dir, uint64_t pack_id);
+    ~SnapshotPackReader();
+    SnapshotPackReader(const SnapshotPackReader&) = delete;
+    SnapshotPackReader& operator=(const SnapshotPackReader&) = delete;
+
+    // False for an invalid or out-of-sequence frame; the pack is then abandoned
+    bool OnFrame(const uint8_t* frame, size_t size);
+    bool PopEvent(SnapshotPackEvent& out);
+    // Recipe size of the next event, false when none is queued
+    bool PeekEventSize(size_t& size) const;
+    bool Finished() const { return finished_; }
+    bool Failed() const { return failed_; }
+
+private:
+    bool OpenContent(SnapshotDigestAlgorithm algorithm, const std::string& hash, uint64_t size);
+    void FinishContent();
+    void AbandonContent();
+
+    const std::string output_dir_;
+    const uint64_t pack_id_;
+    bool header_seen_ = false;
+    bool finished_ = false;
+    bool failed_ = false;
+
+    std::unique_ptr<PositionalFile> file_;
+    std::string hash_;
+    std::string part_path_;
+    SnapshotDigestAlgorithm algorithm_ = SnapshotDigestAlgorithm::Sha256;
+    Sha1 sha1_;
+    Sha256 sha256_;
+    uint64_t size_ = 0;
+    uint64_t written_ = 0;
+    bool open_ = false;
+
+    std::unordered_set<std::string> failed_hashes_;
+    std::deque<SnapshotPackEvent> events_;
+};
+
+}
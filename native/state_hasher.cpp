@@ -0,0 +1,244 @@
+#include "state_hasher.h"
+#include <cstring>
+
+#ifdef FYTECLUB_HAVE_XXHASH
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+#endif
+
+namespace fyteclub {
+
+namespace {
+
+// XXH64, as specified in the xxHash reference implementation
+constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t kPrime3 = 0x165667B19E3779F9ull;
+constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ull;
+constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ull;
+
+uint64_t RotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+uint64_t Load64(const uint8_t* p) {
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint32_t Load32(const uint8_t* p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint64_t Round(uint64_t acc, uint64_t input) {
+    acc += input * kPrime2;
+    return RotateLeft(acc, 31) * kPrime1;
+}
+
+uint64_t MergeRound(uint64_t acc, uint64_t value) {
+    acc ^= Round(0, value);
+    return acc * kPrime1 + kPrime4;
+}
+
+uint64_t Xxh64(const uint8_t* p, size_t size, uint64_t seed) {
+    const uint8_t* end = p + size;
+    uint64_t h;
+    if (size >= 32) {
+        uint64_t v1 = seed + kPrime1 + kPrime2;
+        uint64_t v2 = seed + kPrime2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - kPrime1;
+        do {
+            v1 = Round(v1, Load64(p));
+            v2 = Round(v2, Load64(p + 8));
+            v3 = Round(v3, Load64(p + 16));
+            v4 = Round(v4, Load64(p + 24));
+            p += 32;
+        } while (end - p >= 32);
+        h = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+        h = MergeRound(h, v1);
+        h = MergeRound(h, v2);
+        h = MergeRound(h, v3);
+        h = MergeRound(h, v4);
+    } else {
+        h = seed + kPrime5;
+    }
+    h += size;
+
+    for (; end - p >= 8; p += 8) {
+        h ^= Round(0, Load64(p));
+        h = RotateLeft(h, 27) * kPrime1 + kPrime4;
+    }
+    if (end - p >= 4) {
+        h ^= static_cast<uint64_t>(Load32(p)) * kPrime1;
+        h = RotateLeft(h, 23) * kPrime2 + kPrime3;
+        p += 4;
+    }
+    for (; p < end; ++p) {
+        h ^= *p * kPrime5;
+        h = RotateLeft(h, 11) * kPrime1;
+    }
+
+    h ^= h >> 33;
+    h *= kPrime2;
+    h ^= h >> 29;
+    h *= kPrime3;
+    h ^= h >> 32;
+    return h;
+}
+
+// Spreads a field digest by its field id before it is summed into the
+// player digest, so equal values in different fields do not look alike
+uint64_t MixField(uint32_t field, uint64_t digest) {
+    uint64_t x = digest ^ ((field + 1) * 0x9E3779B97F4A7C15ull);
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+}
+
+uint64_t StateHasher::Hash(const void* data, size_t size, uint64_t seed) {
+#ifdef FYTECLUB_HAVE_XXHASH
+    return XXH3_64bits_withSeed(data, size, seed);
+#else
+    return Xxh64(static_cast<const uint8_t*>(data), size, seed);
+#endif
+}
+
+uint64_t StateHasher::WireHash(const void* data, size_t size, uint64_t seed) {
+    return Xxh64(static_cast<const uint8_t*>(data), size, seed);
+}
+
+bool StateHasher::UpdateLocked(const std::string& player, uint32_t field, bool set, uint64_t digest) {
+    if (field >= kMaxFields) return false;
+    // Clearing must not create a player that was never fed
+    auto it = players_.find(player);
+    if (it == players_.end()) {
+        if (!set) return false;
+        it = players_.emplace(player, Player{}).first;
+    }
+    auto& state = it->second;
+    const uint64_t bit = 1ull << field;
+    const bool was_set = (state.set_mask & bit) != 0;
+    if (was_set == set && (!set || state.fields[field] == digest)) return false;
+
+    // The player digest is a sum of mixed field digests, so one field
+    // changing is a subtract and an add
+    if (was_set) state.combined -= MixField(field, state.fields[field]);
+    if (set) {
+        state.combined += MixField(field, digest);
+        state.fields[field] = digest;
+        state.set_mask |= bit;
+    } else {
+        state.set_mask &= ~bit;
+    }
+    state.generation++;
+    return true;
+}
+
+bool StateHasher::SetField(const std::string& player, uint32_t field, const void* data, size_t size) {
+    uint64_t digest = Hash(data, size);
+    std::lock_guard<std::mutex> lock(mutex_);
+    return UpdateLocked(player, field, true, digest);
+}
+
+bool StateHasher::SetStrings(const std::string& player, uint32_t field, const std::vector<std::string_view>& items,
+                             bool unordered) {
+    uint64_t digest = 0;
+    for (const auto& item : items) {
+        // Unordered: a sum of item hashes, so duplicates still count.
+        // Ordered: each item seeded with the running digest.
+        digest = unordered ? digest + Hash(item.data(), item.size()) : Hash(item.data(), item.size(), digest);
+    }
+    digest = Hash(&digest, sizeof(digest), items.size());
+    std::lock_guard<std::mutex> lock(mutex_);
+    return UpdateLocked(player, field, true, digest);
+}
+
+bool StateHasher::ClearField(const std::string& player, uint32_t field) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return UpdateLocked(player, field, false, 0);
+}
+
+bool StateHasher::GetDigest(const std::string& player, uint64_t& digest, uint64_t& generation) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = players_.find(player);
+    if (it == players_.end()) return false;
+    digest = it->second.combined;
+    generation = it->second.generation;
+    return true;
+}
+
+void StateHasher::RemovePlayer(const std::string& player) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    players_.erase(player);
+}
+
+size_t StateHasher::PlayerCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return players_.size();
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// C exports for the plugin
+// ---------------------------------------------------------------------------
+//
+// Strings are UTF-8. The plugin formats the digest with "X16" where it used
+// the first 16 hex characters of the SHA-256 before.
+
+extern "C" {
+
+__declspec(dllexport) void* CreateStateHasher() {
+    return new fyteclub::StateHasher();
+}
+
+// 1 = changed, 0 = unchanged, -1 = bad arguments. A negative size clears the field.
+__declspec(dllexport) int StateHasherSetField(void* hasher, const char* player, int field, const uint8_t* data,
+                                              int size) {
+    if (!hasher || !player || field < 0 || field >= static_cast<int>(fyteclub::StateHasher::kMaxFields)) return -1;
+    auto* state = static_cast<fyteclub::StateHasher*>(hasher);
+    if (size < 0) return state->ClearField(player, static_cast<uint32_t>(field)) ? 1 : 0;
+    if (!data && size > 0) return -1;
+    return state->SetField(player, static_cast<uint32_t>(field), data, static_cast<size_t>(size)) ? 1 : 0;
+}
+
+__declspec(dllexport) int StateHasherSetStrings(void* hasher, const char* player, int field, const char** items,
+                                                int count, int unordered) {
+    if (!hasher || !player || field < 0 || field >= static_cast<int>(fyteclub::StateHasher::kMaxFields) ||
+        count < 0 || (count > 0 && !items)) {
+        return -1;
+    }
+    std::vector<std::string_view> values;
+    values.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) values.emplace_back(items[i] ? items[i] : "");
+    return static_cast<fyteclub::StateHasher*>(hasher)->SetStrings(player, static_cast<uint32_t>(field), values,
+                                                                   unordered != 0)
+               ? 1
+               : 0;
+}
+
+// Returns 1 and fills the outputs when the player is known, else 0
+__declspec(dllexport) int StateHasherGetDigest(void* hasher, const char* player, uint64_t* digest,
+                                               uint64_t* generation) {
+    uint64_t value = 0, gen = 0;
+    if (!hasher || !player || !static_cast<fyteclub::StateHasher*>(hasher)->GetDigest(player, value, gen)) return 0;
+    if (digest) *digest = value;
+    if (generation) *generation = gen;
+    return 1;
+}
+
+__declspec(dllexport) void StateHasherRemovePlayer(void* hasher, const char* player) {
+    if (hasher && player) static_cast<fyteclub::StateHasher*>(hasher)->RemovePlayer(player);
+}
+
+__declspec(dllexport) void DestroyStateHasher(void* hasher) {
+    delete static_cast<fyteclub::StateHasher*>(hasher);
+}
+
+}
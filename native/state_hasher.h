@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Incremental appearance-state hashing. GetPlayerModHash and both
+// GenerateStateHash implementations JSON-serialize a whole
+// AdvancedPlayerInfo and SHA-256 it on every check, and CheckForHashChanges
+// does that for every tracked player. Here each field (mod list, Glamourer
+// design, Customize+ profile, heels offset, title...) is fed separately, its
+// 64-bit digest is cached, and the player's combined digest is adjusted only
+// for the fields whose digest moved. A generation counter bumps whenever the
+// combined digest changes, so "did anything change" is a single compare.
+//
+// Digests use xxHash3 when the CMake build finds xxhash.h and a built-in
+// XXH64 otherwise; build_webrtc_wrapper.bat never defines
+// FYTECLUB_HAVE_XXHASH, so the shipped DLL uses XXH64. They are change detectors for this process only: do not persist
+// them or send them to peers, which may have been built the other way.
+// WireHash is the exception, always XXH64 whatever the build.
+
+namespace fyteclub {
+
+class StateHasher {
+public:
+    static constexpr uint32_t kMaxFields = 64;
+
+    static uint64_t Hash(const void* data, size_t size, uint64_t seed = 0);
+    // Same value in every build, for hashes that cross the wire
+    static uint64_t WireHash(const void* data, size_t size, uint64_t seed = 0);
+
+    // Each setter returns true when the field's value changed. Unset fields
+    // are distinct from empty ones.
+    bool SetField(const std::string& player, uint32_t field, const void* data, size_t size);
+    // A list of strings. Unordered lists hash as a multiset, so the caller
+    // does not need to sort them first.
+    bool SetStrings(const std::string& player, uint32_t field, const std::vector<std::string_view>& items,
+                    bool unordered);
+    bool ClearField(const std::string& player, uint32_t field);
+
+    // False when nothing has been fed for the player
+    bool GetDigest(const std::string& player, uint64_t& digest, uint64_t& generation) const;
+    void RemovePlayer(const std::string& player);
+    size_t PlayerCount() const;
+
+private:
+    struct Player {
+        uint64_t fields[kMaxFields] = {};
+        uint64_t set_mask = 0;
+        uint64_t combined = 0;
+        uint64_t generation = 0;
+    };
+
+    bool UpdateLocked(const std::string& player, uint32_t field, bool set, uint64_t digest);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Player> players_;
+};
+
+}
@@ -0,0 +1,99 @@
+#include "test_util.h"
+#include "../buffer_arena.h"
+#include <set>
+#include <thread>
+
+using namespace fyteclub;
+
+TEST(SlotsAreAlignedAndDisjoint) {
+    BufferArena arena(100, 4);
+    CHECK(arena.SlotSize() == 128);
+    CHECK(arena.SlotCount() == 4);
+    for (int slot = 0; slot < 4; ++slot) {
+        CHECK(reinterpret_cast<uintptr_t>(arena.Slot(slot)) % BufferArena::kAlignment == 0);
+        CHECK(arena.Slot(slot) == arena.Data() + slot * arena.SlotSize());
+    }
+    CHECK(arena.Slot(-1) == nullptr);
+    CHECK(arena.Slot(4) == nullptr);
+}
+
+TEST(AcquireUntilExhaustedThenReuse) {
+    BufferArena arena(64, 3);
+    std::set<int> held;
+    for (int i = 0; i < 3; ++i) {
+        int slot = arena.Acquire();
+        REQUIRE(slot >= 0);
+        CHECK(held.insert(slot).second);
+    }
+    CHECK(arena.InUse() == 3);
+    CHECK(arena.Acquire() == -1);
+    CHECK(arena.Acquire() == -1);
+    CHECK(arena.Exhausted() == 2);
+
+    // The slot released last goes out first
+    const int slot = *held.begin();
+    CHECK(arena.Release(slot));
+    CHECK(arena.InUse() == 2);
+    CHECK(arena.Acquire() == slot);
+}
+
+TEST(ReleaseOnlyWhatIsHeld) {
+    BufferArena arena(64, 2);
+    int slot = arena.Acquire();
+    CHECK(arena.Release(slot));
+    CHECK(!arena.Release(slot));
+    CHECK(!arena.Release(-1));
+    CHECK(!arena.Release(2));
+    CHECK(arena.InUse() == 0);
+    // A double release must not put the slot on the free list twice
+    CHECK(arena.Acquire() != arena.Acquire());
+    CHECK(arena.Acquire() == -1);
+}
+
+TEST(PostedSlotsArePolledInOrder) {
+    BufferArena arena(64, 4);
+    int first = arena.Acquire();
+    int second = arena.Acquire();
+    arena.Slot(first)[0] = 'a';
+    arena.Slot(second)[0] = 'b';
+    CHECK(arena.Post(first, 10));
+    CHECK(arena.Post(second, 64));
+    // Only held slots, and never more than a slot holds
+    CHECK(!arena.Post(2, 1));
+    CHECK(!arena.Post(first, 65));
+
+    int slot = -1;
+    size_t length = 0;
+    REQUIRE(arena.Poll(slot, length));
+    CHECK(slot == first);
+    CHECK(length == 10);
+    CHECK(arena.Slot(slot)[0] == 'a');
+    REQUIRE(arena.Poll(slot, length));
+    CHECK(slot == second);
+    CHECK(length == 64);
+    CHECK(!arena.Poll(slot, length));
+    // Polling hands the slot over; it stays held until the poller releases it
+    CHECK(arena.InUse() == 2);
+    CHECK(arena.Release(first));
+    CHECK(arena.Release(second));
+}
+
+TEST(ConcurrentUseNeverSharesASlot) {
+    BufferArena arena(64, 8);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&arena, t] {
+            for (int i = 0; i < 2000; ++i) {
+                int slot = arena.Acquire();
+                if (slot < 0) continue;
+                // Whoever holds a slot sees only its own bytes in it
+                arena.Slot(slot)[0] = static_cast<uint8_t>(t);
+                std::this_thread::yield();
+                CHECK(arena.Slot(slot)[0] == t);
+                CHECK(arena.Release(slot));
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    CHECK(arena.InUse() == 0);
+}
@@ -0,0 +1,170 @@
+#include "test_util.h"
+#include "../chunk_assembler.h"
+#include "../sha1.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <random>
+
+using namespace fyteclub;
+
+namespace {
+
+constexpr uint32_t kChunkSize = 1000;
+
+std::string Sha256Hex(const std::vector<uint8_t>& data) {
+    static const char kDigits[] = "0123456789ABCDEF";
+    uint8_t digest[Sha256::kDigestSize];
+    Sha256::Hash(data.data(), data.size(), digest);
+    std::string hex;
+    for (uint8_t byte : digest) {
+        hex += kDigits[byte >> 4];
+        hex += kDigits[byte & 0xF];
+    }
+    return hex;
+}
+
+ParsedChunkFrame OpenFrame(uint64_t id, const std::vector<uint8_t>& content, const std::string& hash) {
+    ParsedChunkFrame frame;
+    frame.type = ChunkFrameType::Open;
+    frame.open.stream_id = id;
+    frame.open.file_size = content.size();
+    frame.open.chunk_size = kChunkSize;
+    frame.open.session_id = "session";
+    frame.open.file_name = "file.bin";
+    frame.open.file_hash = hash;
+    return frame;
+}
+
+ParsedChunkFrame DataFrame(uint64_t id, const std::vector<uint8_t>& content, size_t offset) {
+    ParsedChunkFrame frame;
+    frame.type = ChunkFrameType::Data;
+    frame.data.stream_id = id;
+    frame.data.offset = offset;
+    frame.data.payload = content.data() + offset;
+    frame.data.length = std::min<size_t>(kChunkSize, content.size() - offset);
+    return frame;
+}
+
+// Sends the chunks shuffled, with duplicates, and returns the completion
+CompletedChunkFile Assemble(ChunkAssembler& assembler, uint64_t id, const std::vector<uint8_t>& content,
+                            const std::string& hash) {
+    std::vector<size_t> offsets;
+    for (size_t offset = 0; offset < content.size(); offset += kChunkSize) offsets.push_back(offset);
+    offsets.push_back(offsets[offsets.size() / 2]);
+    std::shuffle(offsets.begin(), offsets.end(), std::mt19937(static_cast<uint32_t>(id)));
+
+    // Some DATA overtakes the OPEN
+    CHECK(assembler.OnFrame(DataFrame(id, content, offsets[0])) == ChunkAssemblyResult::Pending);
+    CHECK(assembler.OnFrame(OpenFrame(id, content, hash)) == ChunkAssemblyResult::Written);
+    for (size_t i = 1; i < offsets.size(); ++i) assembler.OnFrame(DataFrame(id, content, offsets[i]));
+
+    CompletedChunkFile completed;
+    REQUIRE(assembler.PopCompleted(completed));
+    return completed;
+}
+
+std::vector<uint8_t> ReadFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+}
+
+TEST(Sha1HashedFileIsVerified) {
+    test::TempDir dir;
+    ChunkAssembler assembler(dir.String());
+    const auto content = test::Pattern(25500, 1);
+    const std::string hash = Sha1::HexDigest(content.data(), content.size());
+    REQUIRE(hash.size() == 40);
+
+    auto completed = Assemble(assembler, 1, content, hash);
+    CHECK(completed.verified);
+    CHECK(completed.file_hash == hash);
+    CHECK(ReadFile(completed.path) == content);
+    CHECK(!std::filesystem::exists(dir.Path() / (hash + ".part")));
+}
+
+TEST(Sha256HashedFileIsVerified) {
+    test::TempDir dir;
+    ChunkAssembler assembler(dir.String());
+    const auto content = test::Pattern(9999, 2);
+    const std::string hash = Sha256Hex(content);
+
+    auto completed = Assemble(assembler, 2, content, hash);
+    CHECK(completed.verified);
+    CHECK(ReadFile(completed.path) == content);
+}
+
+TEST(LowercaseSha1IsAccepted) {
+    test::TempDir dir;
+    ChunkAssembler assembler(dir.String());
+    const auto content = test::Pattern(3000, 3);
+    std::string hash = Sha1::HexDigest(content.data(), content.size());
+    std::transform(hash.begin(), hash.end(), hash.begin(), [](char c) { return static_cast<char>(tolower(c)); });
+
+    CHECK(Assemble(assembler, 3, content, hash).verified);
+}
+
+TEST(WrongDigestIsNotKept) {
+    test::TempDir dir;
+    ChunkAssembler assembler(dir.String());
+    const auto content = test::Pattern(4000, 4);
+    const auto other = test::Pattern(4000, 5);
+
+    auto completed = Assemble(assembler, 4, content, Sha1::HexDigest(other.data(), other.size()));
+    CHECK(!completed.verified);
+    CHECK(!std::filesystem::exists(completed.path));
+    CHECK(std::filesystem::is_empty(dir.Path()));
+}
+
+TEST(OtherHashShapesAreRejected) {
+    test::TempDir dir;
+    ChunkAssembler assembler(dir.String());
+    const auto content = test::Pattern(100, 6);
+    const std::string sha1 = Sha1::HexDigest(content.data(), content.size());
+
+    CHECK(assembler.OnFrame(OpenFrame(1, content, sha1.substr(0, 32))) == ChunkAssemblyResult::Rejected);
+    CHECK(assembler.OnFrame(OpenFrame(2, content, sha1 + "00")) == ChunkAssemblyResult::Rejected);
+    CHECK(assembler.OnFrame(OpenFrame(3, content, "../" + sha1.substr(3))) == ChunkAssemblyResult::Rejected);
+    CHECK(assembler.OpenStreams() == 0);
+}
+
+TEST(RefusedStreamWaitsOnTheRegistry) {
+    test::TempDir dir;
+    InflightRegistry registry;
+    ChunkAssembler first(dir.String(), 16 * 1024 * 1024, &registry);
+    ChunkAssembler second(dir.String(), 16 * 1024 * 1024, &registry);
+    auto content = test::Pattern(3500, 21);
+    auto hash = Sha1::HexDigest(content.data(), content.size());
+
+    CHECK(first.OnFrame(OpenFrame(1, content, hash)) == ChunkAssemblyResult::Written);
+    CHECK(second.OnFrame(OpenFrame(1, content, hash)) == ChunkAssemblyResult::DuplicateContent);
+    const uint64_t waiter = second.WaiterFor(hash);
+    REQUIRE(waiter != 0);
+    CHECK(first.WaiterFor(hash) == 0);
+    // Still waiting: a second OPEN from the same peer is refused under the same id
+    CHECK(second.OnFrame(OpenFrame(2, content, hash)) == ChunkAssemblyResult::DuplicateContent);
+    CHECK(second.WaiterFor(hash) == waiter);
+
+    // The download fails, so the waiter is promoted and fetches it again
+    CHECK(first.Abort(1));
+    InflightNotification notification;
+    REQUIRE(registry.PopNotification(notification));
+    CHECK(notification.waiter == waiter);
+    CHECK(notification.event == InflightEvent::Promoted);
+    CompletedChunkFile completed = Assemble(second, 3, content, hash);
+    CHECK(completed.verified);
+    CHECK(second.WaiterFor(hash) == 0);
+    CHECK(!registry.IsInflight(hash));
+
+    // A waiter whose assembler goes away hands the download on
+    CHECK(first.OnFrame(OpenFrame(4, content, hash)) == ChunkAssemblyResult::Written);
+    {
+        ChunkAssembler third(dir.String(), 16 * 1024 * 1024, &registry);
+        CHECK(third.OnFrame(OpenFrame(1, content, hash)) == ChunkAssemblyResult::DuplicateContent);
+    }
+    CHECK(first.Abort(4));
+    CHECK(!registry.PopNotification(notification));
+    CHECK(!registry.IsInflight(hash));
+}
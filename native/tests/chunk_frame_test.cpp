@@ -0,0 +1,90 @@
+#include "test_util.h"
+#include "../chunk_frame.h"
+#include "../crc32c.h"
+#include <cstring>
+#include <string>
+
+using namespace fyteclub;
+
+TEST(Crc32cMatchesReferenceVector) {
+    const char* check = "123456789";
+    CHECK(Crc32c(reinterpret_cast<const uint8_t*>(check), 9) == 0xE3069283u);
+    CHECK(Crc32c(nullptr, 0) == 0);
+}
+
+TEST(Crc32cPiecewiseEqualsWhole) {
+    auto data = test::Pattern(100000, 1);
+    const uint32_t whole = Crc32c(data.data(), data.size());
+    // Split points that land on and off the 8-byte slicing boundary
+    for (size_t split : {size_t(1), size_t(7), size_t(8), size_t(4093), size_t(99999)}) {
+        uint32_t crc = Crc32c(data.data(), split);
+        crc = Crc32c(data.data() + split, data.size() - split, crc);
+        CHECK(crc == whole);
+    }
+}
+
+TEST(OpenFrameRoundTrip) {
+    ChunkStreamOpen open;
+    open.stream_id = 300;
+    open.file_size = 5ull * 1024 * 1024 * 1024;
+    open.chunk_size = 128 * 1024;
+    open.session_id = "session-1";
+    open.file_name = "chara/equipment/e0001/texture/v01_c0101e0001_top_d.tex";
+    open.file_hash = "0123456789ABCDEF0123456789ABCDEF01234567";
+
+    std::vector<uint8_t> frame(ChunkOpenFrameSize(open));
+    REQUIRE(WriteChunkOpenFrame(open, frame.data(), frame.size()) == frame.size());
+    CHECK(WriteChunkOpenFrame(open, frame.data(), frame.size() - 1) == 0);
+    CHECK(IsChunkFrame(frame.data(), frame.size()));
+
+    ParsedChunkFrame parsed;
+    REQUIRE(ParseChunkFrame(frame.data(), frame.size(), parsed) == ChunkFrameStatus::Ok);
+    CHECK(parsed.type == ChunkFrameType::Open);
+    CHECK(parsed.open.stream_id == open.stream_id);
+    CHECK(parsed.open.file_size == open.file_size);
+    CHECK(parsed.open.chunk_size == open.chunk_size);
+    CHECK(parsed.open.session_id == open.session_id);
+    CHECK(parsed.open.file_name == open.file_name);
+    CHECK(parsed.open.file_hash == open.file_hash);
+}
+
+TEST(DataFrameRoundTripAndZeroCopyHeader) {
+    auto payload = test::Pattern(128 * 1024, 2);
+    ChunkData data{7, 3ull << 32, payload.data(), payload.size()};
+    std::vector<uint8_t> frame(ChunkDataFrameSize(data.stream_id, data.offset, data.length));
+    REQUIRE(WriteChunkDataFrame(data, frame.data(), frame.size()) == frame.size());
+
+    ParsedChunkFrame parsed;
+    REQUIRE(ParseChunkFrame(frame.data(), frame.size(), parsed) == ChunkFrameStatus::Ok);
+    CHECK(parsed.type == ChunkFrameType::Data);
+    CHECK(parsed.data.stream_id == 7);
+    CHECK(parsed.data.offset == data.offset);
+    REQUIRE(parsed.data.length == payload.size());
+    CHECK(memcmp(parsed.data.payload, payload.data(), payload.size()) == 0);
+
+    // Header, payload written in place, then seal: same bytes as the one-shot writer
+    std::vector<uint8_t> built(kMaxChunkDataHeaderSize + payload.size() + kChunkFrameTrailerSize);
+    size_t header = WriteChunkDataHeader(data.stream_id, data.offset, built.data());
+    CHECK(header == ChunkDataHeaderSize(data.stream_id, data.offset));
+    memcpy(built.data() + header, payload.data(), payload.size());
+    size_t sealed = SealChunkFrame(built.data(), header + payload.size());
+    built.resize(sealed);
+    CHECK(built == frame);
+}
+
+TEST(CorruptionAndTruncationAreDetected) {
+    auto payload = test::Pattern(1000, 3);
+    ChunkData data{1, 0, payload.data(), payload.size()};
+    std::vector<uint8_t> frame(ChunkDataFrameSize(1, 0, payload.size()));
+    WriteChunkDataFrame(data, frame.data(), frame.size());
+
+    ParsedChunkFrame parsed;
+    for (size_t i = 1; i < frame.size(); i += 97) {
+        auto corrupt = frame;
+        corrupt[i] ^= 0x10;
+        CHECK(ParseChunkFrame(corrupt.data(), corrupt.size(), parsed) != ChunkFrameStatus::Ok);
+    }
+    CHECK(ParseChunkFrame(frame.data(), 3, parsed) != ChunkFrameStatus::Ok);
+    uint8_t unknown[8] = {0x7B};
+    CHECK(ParseChunkFrame(unknown, sizeof(unknown), parsed) == ChunkFrameStatus::UnknownType);
+}
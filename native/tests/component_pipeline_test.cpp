@@ -0,0 +1,111 @@
+#include "test_util.h"
+#include "../component_pipeline.h"
+#include "../sha1.h"
+#include <fstream>
+#include <iterator>
+#include <map>
+
+using namespace fyteclub;
+
+namespace {
+
+std::string WriteFile(const test::TempDir& dir, const std::string& name, const std::vector<uint8_t>& content) {
+    auto path = dir.Path() / name;
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(content.data()), static_cast<std::streamsize>(content.size()));
+    return path.u8string();
+}
+
+std::vector<uint8_t> ReadFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// Runs requests and responses between the two until neither has anything to
+// send; the server serves every request from files[hash]
+void Exchange(ComponentFetcher& fetcher, ComponentServer& server, const std::map<std::string, std::string>& files) {
+    std::vector<uint8_t> frame;
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        while (fetcher.PopFrame(frame)) {
+            CHECK(server.OnFrame(frame.data(), frame.size()));
+            progress = true;
+        }
+        ComponentServeRequest request;
+        while (server.PopRequest(request)) {
+            auto it = files.find(request.hash);
+            if (it == files.end()) {
+                server.Reject(request.request_id);
+            } else {
+                CHECK(server.Serve(request.request_id, it->second));
+            }
+            progress = true;
+        }
+        size_t size;
+        while (server.PeekFrameSize(size)) {
+            frame.resize(size);
+            REQUIRE(server.NextFrame(frame.data(), frame.size()) == size);
+            CHECK(fetcher.OnFrame(frame.data(), size) != ComponentFrameResult::Invalid);
+            progress = true;
+        }
+    }
+}
+
+}
+
+TEST(Sha1ComponentIsFetchedAndVerified) {
+    test::TempDir source;
+    test::TempDir cache;
+    const auto content = test::Pattern(200000, 1);
+    const std::string hash = Sha1::HexDigest(content.data(), content.size());
+    REQUIRE(hash.size() == 40);
+
+    ComponentFetcher fetcher(cache.String());
+    ComponentServer server(16 * 1024);
+    const uint64_t id = fetcher.Request(hash);
+    REQUIRE(id != 0);
+    Exchange(fetcher, server, {{hash, WriteFile(source, "component", content)}});
+
+    ComponentCompletion completion;
+    REQUIRE(fetcher.PopCompletion(completion));
+    CHECK(completion.request_id == id);
+    CHECK(completion.status == ComponentStatus::Completed);
+    CHECK(completion.hash == hash);
+    CHECK(ReadFile(completion.path) == content);
+    CHECK(fetcher.InFlight() == 0);
+}
+
+TEST(MismatchedSha1ComponentFails) {
+    test::TempDir source;
+    test::TempDir cache;
+    const auto content = test::Pattern(50000, 2);
+    const auto other = test::Pattern(50000, 3);
+    const std::string hash = Sha1::HexDigest(other.data(), other.size());
+
+    ComponentFetcher fetcher(cache.String());
+    ComponentServer server;
+    fetcher.Request(hash);
+    Exchange(fetcher, server, {{hash, WriteFile(source, "component", content)}});
+
+    ComponentCompletion completion;
+    REQUIRE(fetcher.PopCompletion(completion));
+    CHECK(completion.status == ComponentStatus::Failed);
+    CHECK(completion.path.empty());
+    CHECK(std::filesystem::is_empty(cache.Path()));
+}
+
+TEST(UnknownComponentIsMissing) {
+    test::TempDir cache;
+    const auto content = test::Pattern(10, 4);
+    const std::string hash = Sha1::HexDigest(content.data(), content.size());
+
+    ComponentFetcher fetcher(cache.String());
+    ComponentServer server;
+    fetcher.Request(hash);
+    Exchange(fetcher, server, {});
+
+    ComponentCompletion completion;
+    REQUIRE(fetcher.PopCompletion(completion));
+    CHECK(completion.status == ComponentStatus::Missing);
+}
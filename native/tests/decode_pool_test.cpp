@@ -0,0 +1,133 @@
+#include "test_util.h"
+#include "../buffer_arena.h"
+#include "../chunk_assembler.h"
+#include "../decode_pool.h"
+#include "../sha1.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+
+using namespace fyteclub;
+
+// Mirrors the export's struct, as the plugin does
+struct DecodedFrameResult {
+    uint64_t stream_key;
+    uint64_t stream_id;
+    int32_t status;
+    int32_t result;
+};
+
+extern "C" {
+void* CreateDecodePool(int threads);
+int DecodePoolSubmitChunkSlot(void* pool, uint64_t stream_key, void* assembler, void* arena, int slot, int size);
+int DecodePoolPollResult(void* pool, DecodedFrameResult* result);
+void DecodePoolWaitIdle(void* pool);
+void DestroyDecodePool(void* pool);
+}
+
+TEST(SameKeyRunsInOrder) {
+    std::mutex mutex;
+    std::vector<std::vector<int>> seen(4);
+    {
+        DecodePool pool(4);
+        for (int i = 0; i < 400; ++i) {
+            uint64_t key = static_cast<uint64_t>(i % 4);
+            pool.Submit(key, [&, key, i] {
+                std::lock_guard<std::mutex> lock(mutex);
+                seen[key].push_back(i);
+            });
+        }
+        pool.WaitIdle();
+        CHECK(pool.GetStats().tasks_run == 400);
+    }
+    for (const auto& order : seen) {
+        CHECK(order.size() == 100);
+        for (size_t i = 1; i < order.size(); ++i) CHECK(order[i] > order[i - 1]);
+    }
+}
+
+TEST(ChunkSlotsAreAssembledOnThePool) {
+    test::TempDir dir;
+    ChunkAssembler assembler(dir.String());
+    BufferArena arena(8 * 1024, 4);
+    void* pool = CreateDecodePool(2);
+
+    const auto content = test::Pattern(50000, 1);
+    const std::string hash = Sha1::HexDigest(content.data(), content.size());
+    constexpr uint64_t kStream = 5;
+    constexpr size_t kChunk = 4096;
+
+    // Rents a slot, frames into it and hands it over; waits for a slot when
+    // all are queued, as a receiver would
+    auto submit = [&](auto write) {
+        int slot = arena.Acquire();
+        while (slot < 0) {
+            DecodePoolWaitIdle(pool);
+            slot = arena.Acquire();
+        }
+        size_t size = write(arena.Slot(slot), arena.SlotSize());
+        REQUIRE(size > 0);
+        CHECK(DecodePoolSubmitChunkSlot(pool, kStream, &assembler, &arena, slot, static_cast<int>(size)) == 0);
+    };
+    ChunkStreamOpen open;
+    open.stream_id = kStream;
+    open.file_size = content.size();
+    open.chunk_size = kChunk;
+    open.file_hash = hash;
+    submit([&](uint8_t* out, size_t capacity) { return WriteChunkOpenFrame(open, out, capacity); });
+    for (size_t offset = 0; offset < content.size(); offset += kChunk) {
+        ChunkData data;
+        data.stream_id = kStream;
+        data.offset = offset;
+        data.payload = content.data() + offset;
+        data.length = std::min(kChunk, content.size() - offset);
+        submit([&](uint8_t* out, size_t capacity) { return WriteChunkDataFrame(data, out, capacity); });
+    }
+    // A corrupted frame is reported, not applied
+    submit([&](uint8_t* out, size_t) {
+        memset(out, 0xC7, 64);
+        return size_t{64};
+    });
+    DecodePoolWaitIdle(pool);
+
+    DecodedFrameResult result;
+    int completed = 0;
+    int invalid = 0;
+    size_t results = 0;
+    while (DecodePoolPollResult(pool, &result)) {
+        ++results;
+        CHECK(result.stream_key == kStream);
+        if (result.status != 0) {
+            ++invalid;
+        } else {
+            CHECK(result.stream_id == kStream);
+            completed += result.result == static_cast<int32_t>(ChunkAssemblyResult::Completed) ? 1 : 0;
+        }
+    }
+    CHECK(results == 2 + (content.size() + kChunk - 1) / kChunk);
+    CHECK(completed == 1);
+    CHECK(invalid == 1);
+    CHECK(arena.InUse() == 0);
+
+    CompletedChunkFile file;
+    REQUIRE(assembler.PopCompleted(file));
+    CHECK(file.verified);
+    std::ifstream in(file.path, std::ios::binary);
+    CHECK(std::vector<uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()) == content);
+    DestroyDecodePool(pool);
+}
+
+TEST(BadSlotsStayWithTheCaller) {
+    test::TempDir dir;
+    ChunkAssembler assembler(dir.String());
+    BufferArena arena(1024, 1);
+    void* pool = CreateDecodePool(1);
+    int slot = arena.Acquire();
+    CHECK(DecodePoolSubmitChunkSlot(pool, 1, &assembler, &arena, slot, 2048) == -1);
+    CHECK(DecodePoolSubmitChunkSlot(pool, 1, &assembler, &arena, 7, 10) == -1);
+    CHECK(DecodePoolSubmitChunkSlot(pool, 1, nullptr, &arena, slot, 10) == -1);
+    CHECK(arena.InUse() == 1);
+    arena.Release(slot);
+    DestroyDecodePool(pool);
+}
@@ -0,0 +1,91 @@
+#include "test_util.h"
+#include "../fec.h"
+#include <algorithm>
+#include <map>
+#include <random>
+
+using namespace fyteclub;
+
+namespace {
+
+std::vector<std::vector<uint8_t>> Messages(size_t count) {
+    std::vector<std::vector<uint8_t>> messages;
+    for (size_t i = 0; i < count; ++i) messages.push_back(test::Pattern(50 + (i * 379) % 2000, static_cast<uint32_t>(i)));
+    return messages;
+}
+
+FecPackets Encode(const std::vector<std::vector<uint8_t>>& messages, FecConfig config) {
+    FecEncoder encoder(config);
+    FecPackets packets;
+    for (const auto& message : messages) encoder.Add(message.data(), message.size(), packets);
+    encoder.Flush(packets);
+    return packets;
+}
+
+// Delivered messages as a multiset keyed by content, order ignored
+std::map<std::vector<uint8_t>, int> Counts(const FecPackets& messages) {
+    std::map<std::vector<uint8_t>, int> counts;
+    for (const auto& message : messages) counts[message]++;
+    return counts;
+}
+
+}
+
+TEST(LosslessDeliveryIsExactlyOnce) {
+    auto messages = Messages(37);
+    auto packets = Encode(messages, {8, 2});
+    for (const auto& packet : packets) CHECK(IsFecPacket(packet.data(), packet.size()));
+
+    FecDecoder decoder;
+    FecPackets delivered;
+    for (const auto& packet : packets) CHECK(decoder.Receive(packet.data(), packet.size(), delivered));
+    CHECK(delivered == messages);
+    CHECK(decoder.GetStats().recovered == 0);
+}
+
+TEST(RecoversUpToRepairCountPerBlock) {
+    auto messages = Messages(64);
+    const FecConfig config{8, 3};
+    auto packets = Encode(messages, config);
+
+    // Packets go out as K sources then R repairs per block. Drop R of each
+    // block's K+R packets, varying which ones, and shuffle what is left.
+    std::mt19937 rng(11);
+    FecPackets kept;
+    const size_t block = config.source_symbols + config.repair_symbols;
+    for (size_t start = 0; start < packets.size(); start += block) {
+        std::vector<size_t> order(std::min(block, packets.size() - start));
+        for (size_t i = 0; i < order.size(); ++i) order[i] = start + i;
+        std::shuffle(order.begin(), order.end(), rng);
+        for (size_t i = config.repair_symbols; i < order.size(); ++i) kept.push_back(packets[order[i]]);
+    }
+    std::shuffle(kept.begin(), kept.end(), rng);
+
+    FecDecoder decoder;
+    FecPackets delivered;
+    for (const auto& packet : kept) decoder.Receive(packet.data(), packet.size(), delivered);
+    CHECK(Counts(delivered) == Counts(messages));
+    CHECK(decoder.GetStats().recovered > 0);
+}
+
+TEST(PartialFlushedBlockIsProtected) {
+    auto messages = Messages(5); // K = 8, so only Flush closes the block
+    auto packets = Encode(messages, {8, 2});
+    REQUIRE(packets.size() == 7);
+
+    FecDecoder decoder;
+    FecPackets delivered;
+    // Lose the first two sources
+    for (size_t i = 2; i < packets.size(); ++i) decoder.Receive(packets[i].data(), packets[i].size(), delivered);
+    CHECK(Counts(delivered) == Counts(messages));
+}
+
+TEST(MalformedPacketsAreRejected) {
+    FecDecoder decoder;
+    FecPackets delivered;
+    uint8_t truncated[] = {static_cast<uint8_t>(FecPacketType::Repair), 0x80};
+    CHECK(!decoder.Receive(truncated, sizeof(truncated), delivered));
+    uint8_t other[] = {0x7B, 0x00};
+    CHECK(!decoder.Receive(other, sizeof(other), delivered));
+    CHECK(delivered.empty());
+}
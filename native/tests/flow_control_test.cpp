@@ -0,0 +1,217 @@
+#include "test_util.h"
+#include "../flow_control.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace fyteclub;
+
+namespace {
+
+FlowControlConfig SmallConfig() {
+    FlowControlConfig config;
+    config.initial_stream_credit = 1000;
+    config.initial_connection_credit = 4000;
+    config.max_stream_window = 8000;
+    config.memory_budget = 16000;
+    return config;
+}
+
+// Sends the grants through real CREDIT frames
+void Deliver(const std::vector<CreditGrant>& grants, CreditSender& sender) {
+    for (const auto& grant : grants) {
+        uint8_t frame[32];
+        size_t size = WriteCreditFrame(grant, frame, sizeof(frame));
+        REQUIRE(size == CreditFrameSize(grant));
+        CreditGrant parsed;
+        REQUIRE(ParseCreditFrame(frame, size, parsed));
+        CHECK(parsed.stream_id == grant.stream_id);
+        CHECK(parsed.limit == grant.limit);
+        sender.OnGrant(parsed);
+    }
+}
+
+}
+
+TEST(CreditFrameRejectsDamage) {
+    uint8_t frame[32];
+    size_t size = WriteCreditFrame({7, 123456789}, frame, sizeof(frame));
+    REQUIRE(size > 0);
+    CHECK(WriteCreditFrame({7, 123456789}, frame, size - 1) == 0);
+    CreditGrant grant;
+    for (size_t i = 1; i < size; ++i) {
+        frame[i] ^= 0x01;
+        CHECK(!ParseCreditFrame(frame, size, grant));
+        frame[i] ^= 0x01;
+    }
+    CHECK(!ParseCreditFrame(frame, size - 1, grant));
+    REQUIRE(ParseCreditFrame(frame, size, grant));
+    CHECK(grant.stream_id == 7);
+    CHECK(grant.limit == 123456789);
+}
+
+TEST(SenderStopsAtCreditUntilGranted) {
+    CreditSender sender(SmallConfig());
+    CHECK(sender.Available(1) == 1000);
+    CHECK(sender.Acquire(1, 600, 0));
+    CHECK(sender.Acquire(1, 400, 0));
+    CHECK(!sender.Acquire(1, 1, 0));
+    CHECK(sender.Available(1) == 0);
+
+    sender.OnGrant({1, 1500});
+    CHECK(sender.Available(1) == 500);
+    CHECK(sender.Acquire(1, 500, 0));
+
+    // The connection limit bounds all streams together
+    for (uint64_t stream = 2; stream <= 3; ++stream) CHECK(sender.Acquire(stream, 1000, 0));
+    CHECK(sender.Available(5) == 500);
+    CHECK(!sender.Acquire(5, 501, 0));
+    sender.OnGrant({kConnectionCreditStream, 10000});
+    CHECK(sender.Acquire(5, 1000, 0));
+}
+
+TEST(LimitsOnlyGrow) {
+    CreditSender sender(SmallConfig());
+    CHECK(sender.Acquire(1, 100, 0));
+    sender.OnGrant({1, 3000});
+    // Reordered or duplicated grants never take credit back
+    sender.OnGrant({1, 2000});
+    sender.OnGrant({1, 3000});
+    CHECK(sender.Available(1) == 2900);
+    sender.OnGrant({kConnectionCreditStream, 100});
+    CHECK(sender.Acquire(1, 2900, 0));
+
+    // Grants for streams never sent on are stale and do not open credit early
+    sender.OnGrant({9, 1 << 20});
+    CHECK(sender.Available(9) == 1000);
+}
+
+TEST(ReceiverDetectsPeerOverrunningCredit) {
+    CreditReceiver receiver(SmallConfig());
+    CHECK(receiver.OnData(1, 1000));
+    CHECK(!receiver.OnData(1, 1));
+
+    // Each stream within its own credit, the connection over its total
+    CreditReceiver connection(SmallConfig());
+    for (uint64_t stream = 1; stream <= 4; ++stream) CHECK(connection.OnData(stream, 1000));
+    CHECK(!connection.OnData(5, 1));
+
+    // Credit granted back makes room again
+    CreditReceiver granted(SmallConfig());
+    CHECK(granted.OnData(1, 1000));
+    granted.OnConsumed(1, 1000);
+    std::vector<CreditGrant> grants;
+    granted.CollectGrants(grants);
+    CHECK(!grants.empty());
+    CHECK(granted.OnData(1, 1000));
+    CHECK(granted.Buffered() == 1000);
+}
+
+TEST(CloseStreamWakesAndFailsWaiters) {
+    // Connection credit tight enough that Available(2) reads the connection's share
+    FlowControlConfig config = SmallConfig();
+    config.initial_connection_credit = 1600;
+    for (int round = 0; round < 50; ++round) {
+        CreditSender sender(config);
+        CHECK(sender.Acquire(1, 1000, 0));
+        const uint64_t connection_before = sender.Available(2);
+
+        std::atomic<int> result{-1};
+        std::thread waiter([&] { result = sender.Acquire(1, 500, 5000) ? 1 : 0; });
+        if (round % 2) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        const auto start = std::chrono::steady_clock::now();
+        sender.CloseStream(1);
+        // Reopening the same id must not hand the old waiter the new stream's credit
+        if (round % 3 == 0) CHECK(sender.Acquire(1, 100, 0));
+        waiter.join();
+        CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(2));
+
+        // Either it gave up without charging the connection, or the close
+        // landed first and it sent on the reopened stream
+        const uint64_t reopened = round % 3 == 0 ? 100 : 0;
+        if (result == 0) {
+            CHECK(sender.Available(2) == connection_before - reopened);
+        } else {
+            CHECK(result == 1);
+            CHECK(sender.Available(2) == connection_before - reopened - 500);
+        }
+    }
+
+    CreditSender sender(SmallConfig());
+    CHECK(sender.Acquire(1, 1000, 0));
+    std::thread waiter([&] { CHECK(!sender.Acquire(1, 1, 5000)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    sender.Close();
+    waiter.join();
+    CHECK(!sender.Acquire(2, 1, 0));
+}
+
+TEST(GrantsStayWithinSharedBudget) {
+    MemoryBudgetConfig budget_config;
+    budget_config.global_limit = 10000;
+    budget_config.peer_limit = 10000;
+    MemoryBudget budget(budget_config);
+    {
+        CreditReceiver receiver(SmallConfig());
+        receiver.SetMemoryBudget(&budget, 1);
+        // Another peer holds most of the global budget
+        budget.Charge(2, 8000);
+        CHECK(receiver.OnData(1, 1000));
+        CHECK(budget.Used() == 9000);
+
+        std::vector<CreditGrant> grants;
+        receiver.CollectGrants(grants);
+        CHECK(grants.empty());
+
+        budget.Release(2, 8000);
+        receiver.CollectGrants(grants);
+        REQUIRE(grants.size() == 2);
+        CHECK(grants[0].stream_id == kConnectionCreditStream);
+        // Never more than what is buffered plus what the budget has left
+        CHECK(grants[0].limit == 10000);
+        CHECK(grants[1].stream_id == 1);
+        CHECK(grants[1].limit == 8000); // max_stream_window
+
+        // Nothing moved a quarter window, so nothing is re-advertised
+        grants.clear();
+        receiver.OnConsumed(1, 100);
+        receiver.CollectGrants(grants);
+        CHECK(grants.empty());
+        CHECK(budget.Used() == 900);
+    }
+    // Whatever was still buffered goes back when the receiver goes, and
+    // the budget forgets the peer
+    CHECK(budget.Used() == 0);
+    CHECK(budget.PeerCount() == 1);
+    budget.RemovePeer(2);
+    CHECK(budget.PeerCount() == 0);
+}
+
+TEST(SenderAndReceiverTransferWithinBudget) {
+    const FlowControlConfig config = SmallConfig();
+    CreditSender sender(config);
+    CreditReceiver receiver(config);
+    uint64_t remaining[3] = {50000, 20000, 7000};
+    uint64_t peak = 0;
+    for (int step = 0; step < 100000; ++step) {
+        bool sent = false;
+        for (uint64_t stream = 1; stream <= 3; ++stream) {
+            uint64_t bytes = std::min<uint64_t>(remaining[stream - 1], 700);
+            if (bytes == 0 || !sender.Acquire(stream, bytes, 0)) continue;
+            CHECK(receiver.OnData(stream, bytes));
+            remaining[stream - 1] -= bytes;
+            sent = true;
+        }
+        peak = std::max(peak, receiver.Buffered());
+        if (remaining[0] + remaining[1] + remaining[2] == 0) break;
+        if (!sent) {
+            // Blocked: the receiver writes out what it holds and grants more
+            for (uint64_t stream = 1; stream <= 3; ++stream) receiver.OnConsumed(stream, ~0ull);
+            std::vector<CreditGrant> grants;
+            receiver.CollectGrants(grants);
+            Deliver(grants, sender);
+        }
+    }
+    CHECK(remaining[0] + remaining[1] + remaining[2] == 0);
+    CHECK(peak <= config.memory_budget);
+}
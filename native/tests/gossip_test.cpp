@@ -0,0 +1,220 @@
+#include "test_util.h"
+#include "../gossip.h"
+#include <map>
+#include <memory>
+#include <random>
+
+using namespace fyteclub;
+
+namespace {
+
+std::vector<uint8_t> Bytes(const std::string& text) {
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+// Members wired the way the plugin wires them: the peer handle is the
+// member's index, frames go straight to OnFrame and every candidate is
+// taken as verified and Merged back
+struct Network {
+    std::vector<std::unique_ptr<GossipEngine>> engines;
+    std::vector<std::map<std::string, std::string>> seen; // what each member Merged
+
+    void Add(const std::string& id, const GossipConfig& config = {}) {
+        engines.push_back(std::make_unique<GossipEngine>(id, config));
+        seen.emplace_back();
+    }
+
+    void Connect(size_t a, size_t b) {
+        engines[a]->AddPeer(b);
+        engines[b]->AddPeer(a);
+    }
+
+    void Publish(size_t member, const std::string& id, const std::string& payload) {
+        auto bytes = Bytes(payload);
+        CHECK(engines[member]->Publish(bytes.data(), bytes.size()) > 1);
+        seen[member][id] = payload;
+    }
+
+    // Delivers until every exchange started this round has finished
+    void Deliver() {
+        for (bool moved = true; moved;) {
+            moved = false;
+            for (size_t from = 0; from < engines.size(); ++from) {
+                GossipOutgoing out;
+                while (engines[from]->PopOutgoing(out)) {
+                    CHECK(engines[out.peer]->OnFrame(from, out.frame.data(), out.frame.size()));
+                    moved = true;
+                }
+            }
+        }
+    }
+
+    void MergeAll() {
+        for (size_t i = 0; i < engines.size(); ++i) {
+            GossipUpdate update;
+            while (engines[i]->PopUpdate(update)) {
+                if (engines[i]->Merge(update.origin, update.sequence, update.payload.data(), update.payload.size())) {
+                    seen[i][update.origin] = std::string(update.payload.begin(), update.payload.end());
+                }
+            }
+        }
+    }
+
+    void Round(uint64_t now_ms) {
+        for (auto& engine : engines) engine->Tick(now_ms);
+        Deliver();
+        MergeAll();
+    }
+
+    bool Converged(size_t records) const {
+        for (const auto& engine : engines) {
+            if (engine->RecordCount() != records || engine->VectorHash() != engines[0]->VectorHash()) return false;
+        }
+        return true;
+    }
+};
+
+}
+
+TEST(MembersConvergeOnEveryRecord) {
+    constexpr size_t kMembers = 30;
+    std::mt19937 random(3);
+    Network network;
+    for (size_t i = 0; i < kMembers; ++i) network.Add("m" + std::to_string(i));
+    // A ring keeps the graph connected; random chords make it small-world
+    for (size_t i = 0; i < kMembers; ++i) {
+        network.Connect(i, (i + 1) % kMembers);
+        network.Connect(i, random() % kMembers == i ? (i + 2) % kMembers : random() % kMembers);
+    }
+    for (size_t i = 0; i < kMembers; ++i) network.Publish(i, "m" + std::to_string(i), "v1-" + std::to_string(i));
+
+    uint64_t now = 0;
+    int rounds = 0;
+    while (!network.Converged(kMembers) && rounds < 40) {
+        network.Round(now += 1000);
+        ++rounds;
+    }
+    CHECK(network.Converged(kMembers));
+    CHECK(rounds <= 20);
+    for (const auto& seen : network.seen) {
+        REQUIRE(seen.size() == kMembers);
+        for (size_t i = 0; i < kMembers; ++i) CHECK(seen.at("m" + std::to_string(i)) == "v1-" + std::to_string(i));
+    }
+
+    // Converged: a round is one SUMMARY per contact and nothing else
+    for (auto& engine : network.engines) engine->Tick(now += 1000);
+    size_t frames = 0;
+    for (size_t from = 0; from < kMembers; ++from) {
+        GossipOutgoing out;
+        while (network.engines[from]->PopOutgoing(out)) {
+            CHECK(network.engines[out.peer]->OnFrame(from, out.frame.data(), out.frame.size()));
+            ++frames;
+        }
+    }
+    CHECK(frames == kMembers * 3);
+    for (const auto& engine : network.engines) {
+        GossipOutgoing out;
+        CHECK(!engine->PopOutgoing(out));
+    }
+}
+
+TEST(RestartedMemberOutranksItsOldRecord) {
+    constexpr size_t kMembers = 8;
+    Network network;
+    for (size_t i = 0; i < kMembers; ++i) {
+        network.Add("m" + std::to_string(i));
+        if (i > 0) network.Connect(i - 1, i);
+    }
+    // The last run's clock was ahead, so its sequence is past anything Publish picks now
+    network.Publish(0, "m0", "old");
+    auto old = Bytes("old");
+    const uint64_t ahead = network.engines[0]->Publish(old.data(), old.size()) + 3600 * 1000;
+    REQUIRE(network.engines[0]->Merge("m0", ahead, old.data(), old.size()));
+    for (size_t i = 1; i < kMembers; ++i) network.Publish(i, "m" + std::to_string(i), "v1");
+    uint64_t now = 0;
+    for (int i = 0; i < 30 && !network.Converged(kMembers); ++i) network.Round(now += 1000);
+    REQUIRE(network.Converged(kMembers));
+
+    // Same id, new process: nothing persisted, so it starts from the clock
+    network.engines[0] = std::make_unique<GossipEngine>("m0");
+    network.seen[0].clear();
+    network.Connect(0, 1);
+    network.Publish(0, "m0", "new");
+    for (int i = 0; i < 30 && !network.Converged(kMembers); ++i) network.Round(now += 1000);
+    CHECK(network.Converged(kMembers));
+    for (const auto& seen : network.seen) CHECK(seen.at("m0") == "new");
+    // It jumped past the old record once instead of walking up to it
+    auto next = Bytes("next");
+    CHECK(network.engines[0]->Publish(next.data(), next.size()) == ahead + 2);
+}
+
+TEST(PendingUpdatesKeepNewestPerOriginWithinCap) {
+    GossipConfig config;
+    config.fanout = 2;
+    config.max_pending_updates = 3;
+    Network network;
+    network.Add("x", config);
+    network.Add("p");
+    network.Add("q");
+    network.Connect(0, 1);
+    network.Connect(0, 2);
+    auto payload = Bytes("record");
+    for (const char* origin : {"a", "b", "c"}) {
+        CHECK(network.engines[1]->Merge(origin, 5, payload.data(), payload.size()));
+        CHECK(network.engines[2]->Merge(origin, origin[0] == 'a' ? 7 : 5, payload.data(), payload.size()));
+    }
+
+    // Both peers offer every record; each origin is queued once, at its newest
+    network.engines[0]->Tick(1000);
+    network.Deliver();
+    std::map<std::string, uint64_t> popped;
+    GossipUpdate update;
+    while (network.engines[0]->PopUpdate(update)) {
+        CHECK(popped.emplace(update.origin, update.sequence).second);
+    }
+    CHECK(popped == (std::map<std::string, uint64_t>{{"a", 7}, {"b", 5}, {"c", 5}}));
+
+    // Past the cap new origins wait for a later round
+    GossipConfig tight;
+    tight.max_pending_updates = 2;
+    Network small;
+    small.Add("x", tight);
+    small.Add("p");
+    small.Connect(0, 1);
+    for (const char* origin : {"a", "b", "c"}) {
+        CHECK(small.engines[1]->Merge(origin, 5, payload.data(), payload.size()));
+    }
+    small.engines[0]->Tick(1000);
+    small.Deliver();
+    size_t size = 0;
+    size_t pending = 0;
+    while (small.engines[0]->PeekUpdateSize(size) && small.engines[0]->PopUpdate(update)) {
+        CHECK(size == payload.size());
+        CHECK(small.engines[0]->Merge(update.origin, update.sequence, update.payload.data(), update.payload.size()));
+        ++pending;
+    }
+    CHECK(pending == 2);
+    small.Round(2000);
+    CHECK(small.Converged(3));
+}
+
+TEST(DamagedFramesAreRejected) {
+    GossipEngine a("a");
+    GossipEngine b("b");
+    a.AddPeer(1);
+    auto payload = Bytes("entry");
+    a.Publish(payload.data(), payload.size());
+    REQUIRE(a.Tick(1000) == 1);
+    GossipOutgoing out;
+    REQUIRE(a.PopOutgoing(out));
+    for (size_t i = 0; i < out.frame.size(); ++i) {
+        auto damaged = out.frame;
+        damaged[i] ^= 0x10;
+        CHECK(!b.OnFrame(0, damaged.data(), damaged.size()));
+    }
+    CHECK(!b.OnFrame(0, out.frame.data(), out.frame.size() - 1));
+    CHECK(b.OnFrame(0, out.frame.data(), out.frame.size()));
+    GossipOutgoing reply;
+    CHECK(b.PopOutgoing(reply)); // b knows nothing, so it answers with a DIGEST
+    CHECK(reply.peer == 0);
+}
@@ -0,0 +1,95 @@
+#include "test_util.h"
+#include "../inflight_registry.h"
+#include <vector>
+
+using namespace fyteclub;
+
+namespace {
+
+std::vector<InflightNotification> Drain(InflightRegistry& registry) {
+    std::vector<InflightNotification> notifications;
+    InflightNotification notification;
+    while (registry.PopNotification(notification)) notifications.push_back(std::move(notification));
+    return notifications;
+}
+
+}
+
+TEST(CompletionReachesEveryWaiter) {
+    InflightRegistry registry;
+    CHECK(registry.Claim("abc", 1) == InflightClaim::Owner);
+    CHECK(registry.Claim("ABC", 2) == InflightClaim::Attached);
+    CHECK(registry.Claim("abc", 3) == InflightClaim::Attached);
+    // Repeats change nothing
+    CHECK(registry.Claim("abc", 1) == InflightClaim::Owner);
+    CHECK(registry.Claim("abc", 2) == InflightClaim::Attached);
+    CHECK(registry.IsInflight("Abc"));
+    CHECK(registry.Size() == 1);
+
+    // Only the owner can complete
+    registry.Complete("abc", 2, true, "/store/ABC");
+    CHECK(Drain(registry).empty());
+    registry.Complete("abc", 1, true, "/store/ABC");
+    auto notifications = Drain(registry);
+    REQUIRE(notifications.size() == 2);
+    for (size_t i = 0; i < notifications.size(); ++i) {
+        CHECK(notifications[i].waiter == i + 2);
+        CHECK(notifications[i].event == InflightEvent::Completed);
+        CHECK(notifications[i].hash == "ABC");
+        CHECK(notifications[i].path == "/store/ABC");
+    }
+    CHECK(!registry.IsInflight("abc"));
+    CHECK(registry.Claim("abc", 4) == InflightClaim::Owner);
+}
+
+TEST(FailedOwnerPromotesTheOldestWaiter) {
+    InflightRegistry registry;
+    registry.Claim("h", 1);
+    registry.Claim("h", 2);
+    registry.Claim("h", 3);
+    registry.Complete("h", 1, false);
+    auto notifications = Drain(registry);
+    REQUIRE(notifications.size() == 1);
+    CHECK(notifications[0].waiter == 2);
+    CHECK(notifications[0].event == InflightEvent::Promoted);
+    CHECK(notifications[0].path.empty());
+
+    // The promoted waiter owns it now; claiming again says so
+    CHECK(registry.Claim("h", 2) == InflightClaim::Owner);
+    CHECK(registry.Claim("h", 1) == InflightClaim::Attached);
+    registry.Complete("h", 2, true, "p");
+    notifications = Drain(registry);
+    REQUIRE(notifications.size() == 2);
+    CHECK(notifications[0].waiter == 3);
+    CHECK(notifications[1].waiter == 1);
+
+    // With nobody waiting a failure just forgets the hash
+    registry.Claim("h", 5);
+    registry.Complete("h", 5, false);
+    CHECK(Drain(registry).empty());
+    CHECK(registry.Size() == 0);
+}
+
+TEST(ReleaseDependsOnWhoLetsGo) {
+    InflightRegistry registry;
+    registry.Claim("h", 1);
+    registry.Claim("h", 2);
+    registry.Claim("h", 3);
+
+    // A waiter leaving is never notified
+    registry.Release("h", 2);
+    CHECK(Drain(registry).empty());
+    // The owner leaving is a failure
+    registry.Release("h", 1);
+    auto notifications = Drain(registry);
+    REQUIRE(notifications.size() == 1);
+    CHECK(notifications[0].waiter == 3);
+    CHECK(notifications[0].event == InflightEvent::Promoted);
+    registry.Release("h", 3);
+    CHECK(!registry.IsInflight("h"));
+    CHECK(Drain(registry).empty());
+    registry.Release("unknown", 9);
+    CHECK(registry.Size() == 0);
+
+    CHECK(registry.NewWaiterId() != registry.NewWaiterId());
+}
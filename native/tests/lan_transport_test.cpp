@@ -0,0 +1,162 @@
+#include "test_util.h"
+#include "../buffer_arena.h"
+#include "../chacha20_poly1305.h"
+#include "../lan_transport.h"
+#include <cstring>
+#include <future>
+#include <thread>
+
+using namespace fyteclub;
+
+namespace {
+
+const std::vector<uint8_t> kKey = test::Pattern(kLanKeySize, 1);
+constexpr int kTimeoutMs = 3000;
+
+struct Pair {
+    std::unique_ptr<LanConnection> client;
+    std::unique_ptr<LanConnection> server;
+};
+
+// The listener keeps waiting after a failed handshake, so rejections end at accept_timeout_ms
+Pair Connect(const std::vector<uint8_t>& client_key, int accept_timeout_ms = kTimeoutMs) {
+    auto listener = LanListener::Create(kKey.data(), kKey.size(), "127.0.0.1");
+    REQUIRE(listener);
+    auto accepted = std::async(std::launch::async, [&] { return listener->Accept(accept_timeout_ms); });
+    Pair pair;
+    pair.client = LanConnect("127.0.0.1", listener->Port(), client_key.data(), client_key.size(), kTimeoutMs);
+    pair.server = accepted.get();
+    return pair;
+}
+
+}
+
+// RFC 8439 section 2.8.2
+TEST(AeadMatchesRfc8439Vector) {
+    const char* text = "Ladies and Gentlemen of the class of '99: If I could offer you only one tip for the future, "
+                       "sunscreen would be it.";
+    uint8_t key[kAeadKeySize];
+    for (size_t i = 0; i < sizeof(key); ++i) key[i] = static_cast<uint8_t>(0x80 + i);
+    const uint8_t nonce[kAeadNonceSize] = {0x07, 0x00, 0x00, 0x00, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47};
+    const uint8_t aad[] = {0x50, 0x51, 0x52, 0x53, 0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7};
+    const uint8_t ciphertext[] = {
+        0xd3, 0x1a, 0x8d, 0x34, 0x64, 0x8e, 0x60, 0xdb, 0x7b, 0x86, 0xaf, 0xbc, 0x53, 0xef, 0x7e, 0xc2, 0xa4, 0xad, 0xed,
+        0x51, 0x29, 0x6e, 0x08, 0xfe, 0xa9, 0xe2, 0xb5, 0xa7, 0x36, 0xee, 0x62, 0xd6, 0x3d, 0xbe, 0xa4, 0x5e, 0x8c, 0xa9,
+        0x67, 0x12, 0x82, 0xfa, 0xfb, 0x69, 0xda, 0x92, 0x72, 0x8b, 0x1a, 0x71, 0xde, 0x0a, 0x9e, 0x06, 0x0b, 0x29, 0x05,
+        0xd6, 0xa5, 0xb6, 0x7e, 0xcd, 0x3b, 0x36, 0x92, 0xdd, 0xbd, 0x7f, 0x2d, 0x77, 0x8b, 0x8c, 0x98, 0x03, 0xae, 0xe3,
+        0x28, 0x09, 0x1b, 0x58, 0xfa, 0xb3, 0x24, 0xe4, 0xfa, 0xd6, 0x75, 0x94, 0x55, 0x85, 0x80, 0x8b, 0x48, 0x31, 0xd7,
+        0xbc, 0x3f, 0xf4, 0xde, 0xf0, 0x8e, 0x4b, 0x7a, 0x9d, 0xe5, 0x76, 0xd2, 0x65, 0x86, 0xce, 0xc6, 0x4b, 0x61, 0x16};
+    const uint8_t expected_tag[kAeadTagSize] = {0x1a, 0xe1, 0x0b, 0x59, 0x4f, 0x09, 0xe2, 0x6a,
+                                                0x7e, 0x90, 0x2e, 0xcb, 0xd0, 0x60, 0x06, 0x91};
+
+    std::vector<uint8_t> data(text, text + strlen(text));
+    REQUIRE(data.size() == sizeof(ciphertext));
+    uint8_t tag[kAeadTagSize];
+    AeadSeal(key, nonce, aad, sizeof(aad), data.data(), data.size(), tag);
+    CHECK(memcmp(data.data(), ciphertext, sizeof(ciphertext)) == 0);
+    CHECK(memcmp(tag, expected_tag, sizeof(tag)) == 0);
+
+    CHECK(AeadOpen(key, nonce, aad, sizeof(aad), data.data(), data.size(), tag));
+    CHECK(memcmp(data.data(), text, data.size()) == 0);
+}
+
+TEST(AeadRejectsAlteredMessages) {
+    const auto key = test::Pattern(kAeadKeySize, 2);
+    const uint8_t nonce[kAeadNonceSize] = {1};
+    const uint8_t aad[4] = {1, 2, 3, 4};
+    const auto plain = test::Pattern(300, 3);
+    auto sealed = plain;
+    uint8_t tag[kAeadTagSize];
+    AeadSeal(key.data(), nonce, aad, sizeof(aad), sealed.data(), sealed.size(), tag);
+
+    auto data = sealed;
+    data[150] ^= 1;
+    CHECK(!AeadOpen(key.data(), nonce, aad, sizeof(aad), data.data(), data.size(), tag));
+    CHECK(data[150] == (sealed[150] ^ 1)); // left as ciphertext
+
+    data = sealed;
+    const uint8_t other_aad[4] = {1, 2, 3, 5};
+    CHECK(!AeadOpen(key.data(), nonce, other_aad, sizeof(other_aad), data.data(), data.size(), tag));
+    const uint8_t next_nonce[kAeadNonceSize] = {2};
+    CHECK(!AeadOpen(key.data(), next_nonce, aad, sizeof(aad), data.data(), data.size(), tag));
+    CHECK(AeadOpen(key.data(), nonce, aad, sizeof(aad), data.data(), data.size(), tag));
+    CHECK(data == plain);
+}
+
+TEST(LanAddressesExcludeCarrierGradeNat) {
+    CHECK(IsLanAddress("192.168.1.20"));
+    CHECK(IsLanAddress("10.0.0.5"));
+    CHECK(IsLanAddress("172.16.4.1"));
+    CHECK(IsLanAddress("fe80::1%eth0"));
+    CHECK(IsLanAddress("::ffff:192.168.0.2"));
+    CHECK(!IsLanAddress("100.64.0.1"));
+    CHECK(!IsLanAddress("100.127.255.254"));
+    CHECK(!IsLanAddress("172.32.0.1"));
+    CHECK(!IsLanAddress("8.8.8.8"));
+}
+
+TEST(ListenerOnlyBindsLanAddresses) {
+    CHECK(!LanListener::Create(kKey.data(), kKey.size(), "8.8.8.8"));
+    CHECK(!LanListener::Create(kKey.data(), kKey.size(), "100.64.0.1"));
+    CHECK(!LanListener::Create(kKey.data(), kKey.size(), "not an address"));
+    auto listener = LanListener::Create(kKey.data(), kKey.size(), "127.0.0.1");
+    REQUIRE(listener);
+    CHECK(listener->Port() != 0);
+}
+
+TEST(HandshakeRejectsWrongKey) {
+    auto wrong = kKey;
+    wrong[0] ^= 0x80;
+    auto pair = Connect(wrong, 300);
+    CHECK(!pair.client);
+    CHECK(!pair.server);
+}
+
+TEST(MessagesRoundTripBothWays) {
+    auto pair = Connect(kKey);
+    REQUIRE(pair.client);
+    REQUIRE(pair.server);
+
+    std::vector<std::vector<uint8_t>> messages;
+    for (uint32_t i = 0; i < 20; ++i) messages.push_back(test::Pattern((i * 7919) % 70000, i));
+    messages.push_back({});
+    std::thread sender([&] {
+        for (const auto& message : messages) CHECK(pair.client->Send(message.data(), message.size()));
+    });
+    for (const auto& expected : messages) {
+        std::vector<uint8_t> received;
+        REQUIRE(pair.server->Receive(received));
+        CHECK(received == expected);
+    }
+    sender.join();
+
+    const auto reply = test::Pattern(1000, 99);
+    CHECK(pair.server->Send(reply.data(), reply.size()));
+    std::vector<uint8_t> received;
+    REQUIRE(pair.client->Receive(received));
+    CHECK(received == reply);
+    CHECK(pair.client->BytesSent() == pair.server->BytesReceived());
+}
+
+TEST(ReceiveIntoSlotDecryptsInPlace) {
+    auto pair = Connect(kKey);
+    REQUIRE(pair.client);
+    REQUIRE(pair.server);
+
+    BufferArena arena(4096, 2);
+    const auto small = test::Pattern(3000, 5);
+    const auto large = test::Pattern(10000, 6);
+    CHECK(pair.client->Send(small.data(), small.size()));
+    CHECK(pair.client->Send(large.data(), large.size()));
+
+    int slot = arena.Acquire();
+    std::vector<uint8_t> overflow;
+    size_t size = 0;
+    REQUIRE(pair.server->ReceiveInto(arena.Slot(slot), arena.SlotSize(), overflow, size));
+    CHECK(size == small.size());
+    CHECK(memcmp(arena.Slot(slot), small.data(), small.size()) == 0);
+    REQUIRE(pair.server->ReceiveInto(arena.Slot(slot), arena.SlotSize(), overflow, size));
+    CHECK(size == large.size());
+    CHECK(overflow == large);
+    arena.Release(slot);
+}
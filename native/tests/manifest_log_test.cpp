@@ -0,0 +1,213 @@
+#include "test_util.h"
+#include "../manifest_log.h"
+#include <map>
+#include <random>
+
+using namespace fyteclub;
+
+namespace {
+
+using Manifest = std::map<std::pair<std::string, std::string>, std::string>;
+
+Manifest FromLog(const std::vector<ManifestEntry>& entries) {
+    Manifest manifest;
+    for (const auto& entry : entries) manifest[{entry.type, entry.identifier}] = entry.hash;
+    return manifest;
+}
+
+// What the plugin does with a frame: apply, and on a gap ask again for a snapshot
+ManifestApplyResult Sync(const ManifestLog& log, ManifestReplica& replica) {
+    auto frame = log.DeltaSince(replica.Epoch(), replica.Version());
+    if (frame.empty()) return ManifestApplyResult::Applied;
+    auto result = replica.Apply(frame.data(), frame.size());
+    if (result == ManifestApplyResult::NeedSnapshot) {
+        frame = log.DeltaSince(0, 0);
+        CHECK(replica.Apply(frame.data(), frame.size()) == ManifestApplyResult::Applied);
+    }
+    return result;
+}
+
+size_t DrainChanges(ManifestReplica& replica) {
+    size_t count = 0;
+    ManifestChange change;
+    while (replica.PopChange(change)) ++count;
+    return count;
+}
+
+}
+
+TEST(DeltaCarriesOnlyLatestOpPerComponent) {
+    ManifestLog log(4096, 11);
+    ManifestReplica replica;
+    CHECK(log.Put("penumbra", "hair", "aa") == 1);
+    CHECK(log.Put("penumbra", "body", "bb") == 2);
+    CHECK(log.Put("penumbra", "hair", "aa") == 0); // unchanged
+    CHECK(Sync(log, replica) == ManifestApplyResult::Applied);
+    CHECK(replica.Epoch() == 11);
+    CHECK(replica.Version() == 2);
+    CHECK(DrainChanges(replica) == 2);
+
+    CHECK(log.Put("penumbra", "hair", "a2") == 3);
+    CHECK(log.Put("penumbra", "hair", "a3") == 4);
+    CHECK(log.Remove("penumbra", "body") == 5);
+    CHECK(log.Remove("penumbra", "body") == 0);
+    auto frame = log.DeltaSince(11, 2);
+    REQUIRE(!frame.empty());
+    CHECK(replica.Apply(frame.data(), frame.size()) == ManifestApplyResult::Applied);
+    // hair's two puts fold into one change
+    ManifestChange change;
+    REQUIRE(replica.PopChange(change));
+    CHECK(change.kind == ManifestOpKind::Remove);
+    CHECK(change.entry.identifier == "body");
+    REQUIRE(replica.PopChange(change));
+    CHECK(change.entry.hash == "a3");
+    CHECK(!replica.PopChange(change));
+
+    // Up to date: nothing to send, and a replayed frame changes nothing
+    CHECK(log.DeltaSince(11, 5).empty());
+    CHECK(replica.Apply(frame.data(), frame.size()) == ManifestApplyResult::Applied);
+    CHECK(DrainChanges(replica) == 0);
+    CHECK(FromLog(replica.Entries()) == FromLog({{"penumbra", "hair", "a3"}}));
+}
+
+TEST(CompactedLogFallsBackToSnapshot) {
+    ManifestLog log(4, 3);
+    ManifestReplica replica;
+    log.Put("penumbra", "a", "1");
+    CHECK(Sync(log, replica) == ManifestApplyResult::Applied);
+    for (int i = 0; i < 10; ++i) log.Put("glamourer", "state", std::to_string(i));
+    log.Remove("penumbra", "a");
+    // The ops after version 1 are gone, so the replica gets the whole manifest
+    CHECK(Sync(log, replica) == ManifestApplyResult::Applied);
+    CHECK(replica.Version() == log.Version());
+    CHECK(FromLog(replica.Entries()) == FromLog({{"glamourer", "state", "9"}}));
+}
+
+TEST(GapAsksForSnapshot) {
+    ManifestLog log(4096, 5);
+    ManifestReplica replica;
+    log.Put("penumbra", "a", "1");
+    Sync(log, replica);
+    log.Put("penumbra", "b", "2");
+    log.Put("penumbra", "c", "3");
+    // A delta from version 2 reaches a replica still at 1
+    auto frame = log.DeltaSince(5, 2);
+    CHECK(replica.Apply(frame.data(), frame.size()) == ManifestApplyResult::NeedSnapshot);
+    CHECK(replica.Version() == 1);
+    frame = log.DeltaSince(0, 0);
+    CHECK(replica.Apply(frame.data(), frame.size()) == ManifestApplyResult::Applied);
+    CHECK(replica.Version() == 3);
+    CHECK(replica.Size() == 3);
+}
+
+TEST(RestartedSenderIsNotMistakenForUpToDate) {
+    ManifestReplica replica;
+    {
+        ManifestLog before(4096, 100);
+        for (int i = 0; i < 50; ++i) before.Put("penumbra", "item" + std::to_string(i), "old");
+        Sync(before, replica);
+        CHECK(replica.Version() == 50);
+    }
+
+    // Same player, new process: versions start over under a new epoch
+    ManifestLog after(4096, 200);
+    after.Put("penumbra", "item0", "new");
+    after.Put("penumbra", "fresh", "x");
+    after.Put("glamourer", "state", "y");
+    CHECK(after.Version() == 3);
+    auto frame = after.DeltaSince(replica.Epoch(), replica.Version());
+    REQUIRE(!frame.empty());
+    CHECK(replica.Apply(frame.data(), frame.size()) == ManifestApplyResult::Applied);
+    CHECK(replica.Epoch() == 200);
+    CHECK(replica.Version() == 3);
+    CHECK(FromLog(replica.Entries()) ==
+          FromLog({{"penumbra", "item0", "new"}, {"penumbra", "fresh", "x"}, {"glamourer", "state", "y"}}));
+
+    // A delta from another epoch never applies onto stale state
+    ManifestReplica stale;
+    {
+        ManifestLog before(4096, 100);
+        before.Put("penumbra", "a", "1");
+        Sync(before, stale);
+    }
+    ManifestLog restarted(4096, 300);
+    restarted.Put("penumbra", "b", "2");
+    restarted.Put("penumbra", "c", "3");
+    frame = restarted.DeltaSince(300, 1);
+    CHECK(stale.Apply(frame.data(), frame.size()) == ManifestApplyResult::NeedSnapshot);
+
+    // A restarted sender with nothing yet still clears the replica
+    ManifestLog empty(4096, 400);
+    frame = empty.DeltaSince(stale.Epoch(), stale.Version());
+    REQUIRE(!frame.empty());
+    CHECK(stale.Apply(frame.data(), frame.size()) == ManifestApplyResult::Applied);
+    CHECK(stale.Size() == 0);
+    CHECK(stale.Epoch() == 400);
+    CHECK(empty.DeltaSince(stale.Epoch(), stale.Version()).empty());
+}
+
+TEST(DamagedFrameIsInvalid) {
+    ManifestLog log(4096, 9);
+    log.Put("penumbra", "a", "1");
+    auto frame = log.DeltaSince(0, 0);
+    for (size_t i = 1; i < frame.size(); ++i) {
+        ManifestReplica replica;
+        auto damaged = frame;
+        damaged[i] ^= 0x04;
+        CHECK(replica.Apply(damaged.data(), damaged.size()) == ManifestApplyResult::Invalid);
+        CHECK(replica.Size() == 0);
+    }
+    ManifestReplica replica;
+    CHECK(replica.Apply(frame.data(), frame.size() - 1) == ManifestApplyResult::Invalid);
+    CHECK(replica.Apply(frame.data(), frame.size()) == ManifestApplyResult::Applied);
+}
+
+TEST(ReplicasConvergeUnderRandomOpsAndLoss) {
+    std::mt19937 random(17);
+    ManifestLog log(64, 1);
+    ManifestReplica replica;
+    std::vector<std::vector<uint8_t>> stale_frames;
+    for (int round = 0; round < 2000; ++round) {
+        const int ops = 1 + random() % 20;
+        for (int i = 0; i < ops; ++i) {
+            const std::string id = "c" + std::to_string(random() % 40);
+            if (random() % 4 == 0) {
+                log.Remove("penumbra", id);
+            } else {
+                log.Put("penumbra", id, std::to_string(random() % 3));
+            }
+        }
+        if (random() % 10 == 0) {
+            // Full rescans go through Replace
+            std::vector<ManifestEntry> entries;
+            for (int i = 0; i < 40; ++i) {
+                if (random() % 2) entries.push_back({"penumbra", "c" + std::to_string(i), std::to_string(random() % 3)});
+            }
+            log.Replace(entries);
+        }
+
+        auto frame = log.DeltaSince(replica.Epoch(), replica.Version());
+        if (!frame.empty()) stale_frames.push_back(frame);
+        switch (random() % 4) {
+        case 0:
+            break; // lost
+        case 1:
+            // An old frame arriving late
+            if (!stale_frames.empty()) {
+                auto& old = stale_frames[random() % stale_frames.size()];
+                CHECK(replica.Apply(old.data(), old.size()) != ManifestApplyResult::Invalid);
+            }
+            break;
+        default:
+            Sync(log, replica);
+            CHECK(replica.Version() == log.Version());
+        }
+    }
+    Sync(log, replica);
+    CHECK(replica.Version() == log.Version());
+    auto snapshot = log.DeltaSince(0, 0);
+    ManifestReplica fresh;
+    CHECK(fresh.Apply(snapshot.data(), snapshot.size()) == ManifestApplyResult::Applied);
+    CHECK(FromLog(replica.Entries()) == FromLog(fresh.Entries()));
+    CHECK(replica.Size() == log.Size());
+}
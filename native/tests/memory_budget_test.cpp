@@ -0,0 +1,101 @@
+#include "test_util.h"
+#include "../memory_budget.h"
+
+using namespace fyteclub;
+
+namespace {
+
+MemoryBudgetConfig SmallConfig() {
+    MemoryBudgetConfig config;
+    config.global_limit = 1000;
+    config.peer_limit = 600;
+    return config;
+}
+
+}
+
+TEST(ReserveGrantsBackpressuresOrRejects) {
+    MemoryBudget budget(SmallConfig());
+    CHECK(budget.Reserve(1, 400) == MemoryReservation::Granted);
+    // Fits the cap, just not on top of what the peer holds
+    CHECK(budget.Reserve(1, 300) == MemoryReservation::Backpressure);
+    // Can never fit the peer's cap
+    CHECK(budget.Reserve(1, 601) == MemoryReservation::Rejected);
+    CHECK(budget.Used() == 400);
+    CHECK(budget.GetPeerUsage(1).refused == 2);
+
+    budget.Release(1, 200);
+    CHECK(budget.Reserve(1, 300) == MemoryReservation::Granted);
+    auto usage = budget.GetPeerUsage(1);
+    CHECK(usage.used == 500);
+    CHECK(usage.peak == 500);
+    CHECK(usage.limit == 600);
+
+    // A raised cap still cannot pass the global limit
+    budget.SetPeerLimit(2, 2000);
+    CHECK(budget.Reserve(2, 1001) == MemoryReservation::Rejected);
+    CHECK(budget.Reserve(2, 600) == MemoryReservation::Backpressure);
+    CHECK(budget.Reserve(2, 500) == MemoryReservation::Granted);
+    CHECK(budget.Used() == 1000);
+    // Releasing more than is held only frees what is held
+    budget.Release(2, 5000);
+    CHECK(budget.Used() == 500);
+    CHECK(budget.Peak() == 1000);
+}
+
+TEST(ChargeMayRunPastTheCap) {
+    MemoryBudget budget(SmallConfig());
+    // Bytes that already arrived are counted whatever the cap
+    budget.Charge(1, 700);
+    CHECK(budget.GetPeerUsage(1).used == 700);
+    CHECK(budget.Available(1) == 0);
+    CHECK(budget.Reserve(1, 1) == MemoryReservation::Backpressure);
+    budget.Release(1, 200);
+    CHECK(budget.Available(1) == 100);
+}
+
+TEST(AvailableIsBoundedByTheSharedLimit) {
+    MemoryBudget budget(SmallConfig());
+    CHECK(budget.Available(1) == 600);
+    budget.Charge(2, 550);
+    // Peer 1 holds nothing but only 450 are left overall
+    CHECK(budget.Available(1) == 450);
+    CHECK(budget.Reserve(1, 500) == MemoryReservation::Backpressure);
+    CHECK(budget.Reserve(1, 450) == MemoryReservation::Granted);
+    CHECK(budget.Available(1) == 0);
+    CHECK(budget.Available(3) == 0);
+    budget.Release(2, 550);
+    CHECK(budget.Available(1) == 150);
+    CHECK(budget.Available(3) == 550);
+}
+
+TEST(RemovedPeersAreForgotten) {
+    MemoryBudget budget(SmallConfig());
+    for (uint64_t peer = 1; peer <= 100; ++peer) {
+        CHECK(budget.Reserve(peer, 10) == MemoryReservation::Granted);
+        budget.Release(peer, 10);
+        budget.RemovePeer(peer);
+    }
+    CHECK(budget.PeerCount() == 0);
+
+    // Bytes still held stay charged; the last release drops the entry
+    budget.SetPeerLimit(1, 100);
+    budget.Charge(1, 80);
+    budget.RemovePeer(1);
+    CHECK(budget.PeerCount() == 1);
+    CHECK(budget.Used() == 80);
+    budget.Release(1, 30);
+    CHECK(budget.PeerCount() == 1);
+    budget.Release(1, 50);
+    CHECK(budget.PeerCount() == 0);
+    CHECK(budget.Used() == 0);
+    // Back with the default cap
+    CHECK(budget.Available(1) == 600);
+
+    // Charging again before the drain keeps the peer
+    budget.Charge(2, 10);
+    budget.RemovePeer(2);
+    budget.Charge(2, 10);
+    budget.Release(2, 20);
+    CHECK(budget.PeerCount() == 1);
+}
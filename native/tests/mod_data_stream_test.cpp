@@ -0,0 +1,273 @@
+#include "test_util.h"
+#include "../generated/p2p_messages.h"
+#include "../mod_data_stream.h"
+#include <fstream>
+#include <iterator>
+
+using namespace fyteclub;
+namespace fs = std::filesystem;
+
+namespace {
+
+struct FileSpec {
+    std::string key;
+    std::string game_path;
+    std::string hash;
+    std::vector<uint8_t> content;
+};
+
+FileSpec Sha1File(const std::string& key, size_t size, uint32_t seed) {
+    auto content = test::Pattern(size, seed);
+    return {key, "chara/" + key + ".mdl", Sha1::HexDigest(content.data(), content.size()), content};
+}
+
+FileSpec Sha256File(const std::string& key, size_t size, uint32_t seed) {
+    auto content = test::Pattern(size, seed);
+    return {key, "chara/" + key + ".tex", Sha256::HexDigest(content.data(), content.size()), content};
+}
+
+std::vector<uint8_t> Encode(const std::vector<FileSpec>& files) {
+    std::vector<wire::MapEntry<wire::TransferableFile>> entries;
+    for (const auto& file : files) {
+        wire::TransferableFile value;
+        value.game_path = file.game_path;
+        value.hash = file.hash;
+        value.content = {file.content.data(), file.content.size()};
+        value.size = static_cast<int64_t>(file.content.size());
+        entries.push_back({file.key, value});
+    }
+    wire::ModDataResponse response;
+    response.message_id = "msg-1";
+    response.timestamp = 1700000000123;
+    response.response_to = "req-7";
+    response.player_name = "Alice Example";
+    response.data_hash = "abcdef";
+    response.player_info.player_name = "Alice Example";
+    response.player_info.world_id = 73;
+    response.file_replacements = {entries.data(), entries.size()};
+    response.is_compressed = true;
+
+    std::vector<uint8_t> frame(wire::EncodedSize(response, wire::kSchemaVersion));
+    REQUIRE(wire::Encode(response, frame.data(), frame.size()) == frame.size());
+    return frame;
+}
+
+std::vector<ModDataStreamEvent> Drain(ModDataStreamDecoder& decoder) {
+    std::vector<ModDataStreamEvent> events;
+    ModDataStreamEvent event;
+    while (decoder.PopEvent(event)) events.push_back(std::move(event));
+    return events;
+}
+
+std::vector<uint8_t> ReadFile(const fs::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+size_t PartFiles(const fs::path& dir) {
+    size_t count = 0;
+    for (const auto& entry : fs::directory_iterator(dir)) count += entry.path().extension() == ".part";
+    return count;
+}
+
+// Header, one File per spec with the given statuses, End
+void CheckEvents(const std::vector<ModDataStreamEvent>& events, const std::vector<FileSpec>& files,
+                 const std::vector<ModDataFileStatus>& statuses) {
+    REQUIRE(events.size() == files.size() + 2);
+    CHECK(events[0].kind == ModDataStreamEventKind::Header);
+    CHECK(events[0].message_id == "msg-1");
+    CHECK(events[0].response_to == "req-7");
+    CHECK(events[0].player_name == "Alice Example");
+    CHECK(events[0].data_hash == "abcdef");
+    CHECK(events[0].timestamp == 1700000000123);
+    CHECK(!events[0].player_info.empty());
+    for (size_t i = 0; i < files.size(); ++i) {
+        const auto& event = events[i + 1];
+        CHECK(event.kind == ModDataStreamEventKind::File);
+        CHECK(event.key == files[i].key);
+        CHECK(event.game_path == files[i].game_path);
+        CHECK(event.hash == files[i].hash);
+        CHECK(event.size == static_cast<int64_t>(files[i].content.size()));
+        CHECK(event.status == statuses[i]);
+    }
+    CHECK(events.back().kind == ModDataStreamEventKind::End);
+    CHECK(events.back().files == files.size());
+    // isCompressed follows the map, so only End has it
+    CHECK(events.back().is_compressed);
+}
+
+}
+
+TEST(EverySplitPointDecodesTheSame) {
+    const std::vector<FileSpec> files = {Sha1File("a", 700, 1), Sha256File("b", 300, 2), Sha1File("c", 1, 3)};
+    const std::vector<ModDataFileStatus> stored(files.size(), ModDataFileStatus::Stored);
+    const auto frame = Encode(files);
+
+    for (size_t split = 0; split <= frame.size(); ++split) {
+        test::TempDir dir;
+        ModDataStreamDecoder decoder(dir.String());
+        REQUIRE(decoder.Feed(frame.data(), split));
+        REQUIRE(decoder.Feed(frame.data() + split, frame.size() - split));
+        REQUIRE(decoder.Finish());
+        CheckEvents(Drain(decoder), files, stored);
+        for (const auto& file : files) CHECK(ReadFile(dir.Path() / file.hash) == file.content);
+        CHECK(PartFiles(dir.Path()) == 0);
+    }
+
+    // A byte at a time, events popped as they come
+    test::TempDir dir;
+    ModDataStreamDecoder decoder(dir.String());
+    std::vector<ModDataStreamEvent> events;
+    for (uint8_t byte : frame) {
+        REQUIRE(decoder.Feed(&byte, 1));
+        for (auto& event : Drain(decoder)) events.push_back(std::move(event));
+    }
+    REQUIRE(decoder.Finish());
+    for (auto& event : Drain(decoder)) events.push_back(std::move(event));
+    CheckEvents(events, files, stored);
+}
+
+TEST(TruncatedFrameLeavesNoPartialFiles) {
+    const std::vector<FileSpec> files = {Sha1File("a", 500, 4), Sha256File("b", 500, 5)};
+    const auto frame = Encode(files);
+    for (size_t size = 0; size < frame.size(); ++size) {
+        test::TempDir dir;
+        {
+            ModDataStreamDecoder decoder(dir.String());
+            REQUIRE(decoder.Feed(frame.data(), size));
+            // Cut at a top-level field boundary the frame reads as complete
+            // (just shorter); anything cut inside the map must not
+            if (decoder.Finish()) {
+                auto events = Drain(decoder);
+                REQUIRE(!events.empty());
+                CHECK(events.back().kind == ModDataStreamEventKind::End);
+            }
+        }
+        CHECK(PartFiles(dir.Path()) == 0);
+        // Only whole, verified content ever reaches the store
+        for (const auto& entry : fs::directory_iterator(dir.Path())) {
+            const auto content = ReadFile(entry.path());
+            const auto name = entry.path().filename().u8string();
+            CHECK(name == Sha1::HexDigest(content.data(), content.size()) ||
+                  name == Sha256::HexDigest(content.data(), content.size()));
+        }
+    }
+
+    // Cut in the middle of content
+    test::TempDir dir;
+    ModDataStreamDecoder decoder(dir.String());
+    REQUIRE(decoder.Feed(frame.data(), frame.size() / 2));
+    CHECK(!decoder.Finish());
+    CHECK(decoder.Failed());
+    CHECK(!decoder.Feed(frame.data() + frame.size() / 2, frame.size() - frame.size() / 2));
+}
+
+TEST(OversizedFieldsAreRejected) {
+    const std::vector<FileSpec> files = {Sha1File("a", 4096, 6)};
+    const auto frame = Encode(files);
+
+    ModDataStreamLimits content_limit;
+    content_limit.max_content = 4095;
+    ModDataStreamLimits string_limit;
+    string_limit.max_string = 4; // "msg-1" is five bytes
+    ModDataStreamLimits info_limit;
+    info_limit.max_player_info = 4;
+    for (const auto& limits : {content_limit, string_limit, info_limit}) {
+        test::TempDir dir;
+        ModDataStreamDecoder decoder(dir.String(), limits);
+        CHECK(!decoder.Feed(frame.data(), frame.size()));
+        CHECK(!decoder.Finish());
+        CHECK(fs::is_empty(dir.Path()));
+    }
+
+    // Not a schema ModDataResponse at all
+    test::TempDir dir;
+    for (uint8_t flag : {0, 1, 3}) {
+        ModDataStreamDecoder decoder(dir.String());
+        auto other = frame;
+        other[0] = flag;
+        CHECK(!decoder.Feed(other.data(), other.size()));
+    }
+    ModDataStreamDecoder decoder(dir.String());
+    auto request = frame;
+    request[2] = static_cast<uint8_t>(wire::ModDataRequest::kType);
+    CHECK(!decoder.Feed(request.data(), request.size()));
+
+    // Trailing bytes after Finish
+    ModDataStreamDecoder done(dir.String());
+    REQUIRE(done.Feed(frame.data(), frame.size()));
+    REQUIRE(done.Finish());
+    CHECK(!done.Feed(frame.data(), 1));
+}
+
+TEST(ContentNotMatchingItsHashIsDropped) {
+    auto good = Sha1File("good", 800, 7);
+    auto bad = Sha256File("bad", 800, 8);
+    bad.content[100] ^= 1;
+    const std::vector<FileSpec> files = {bad, good};
+    const auto frame = Encode(files);
+    test::TempDir dir;
+    ModDataStreamDecoder decoder(dir.String());
+    REQUIRE(decoder.Feed(frame.data(), frame.size()));
+    REQUIRE(decoder.Finish());
+    CheckEvents(Drain(decoder), files, {ModDataFileStatus::Failed, ModDataFileStatus::Stored});
+    CHECK(!fs::exists(dir.Path() / bad.hash));
+    CHECK(ReadFile(dir.Path() / good.hash) == good.content);
+    CHECK(PartFiles(dir.Path()) == 0);
+}
+
+TEST(ExistingContentIsSkipped) {
+    const auto file = Sha1File("a", 600, 9);
+    test::TempDir dir;
+    // Whatever is already there is trusted and left alone
+    const std::vector<uint8_t> marker = {'k', 'e', 'e', 'p'};
+    {
+        std::ofstream out(dir.Path() / file.hash, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(marker.data()), static_cast<std::streamsize>(marker.size()));
+    }
+    const auto frame = Encode({file});
+    ModDataStreamDecoder decoder(dir.String());
+    REQUIRE(decoder.Feed(frame.data(), frame.size()));
+    REQUIRE(decoder.Finish());
+    auto events = Drain(decoder);
+    CheckEvents(events, {file}, {ModDataFileStatus::Existing});
+    CHECK(events[1].path == (dir.Path() / file.hash).u8string());
+    CHECK(ReadFile(dir.Path() / file.hash) == marker);
+
+    // An entry without content is reported for the receiver to fetch by hash
+    FileSpec empty = Sha1File("empty", 0, 10);
+    const auto no_content = Encode({empty});
+    ModDataStreamDecoder fetch(dir.String());
+    REQUIRE(fetch.Feed(no_content.data(), no_content.size()));
+    REQUIRE(fetch.Finish());
+    CheckEvents(Drain(fetch), {empty}, {ModDataFileStatus::NoContent});
+}
+
+TEST(HashesCannotEscapeTheOutputDirectory) {
+    test::TempDir root;
+    const fs::path store = root.Path() / "store";
+    fs::create_directories(store);
+    auto content = test::Pattern(256, 11);
+    // Right lengths for SHA-1 and SHA-256, but not hex
+    const std::vector<std::string> hashes = {
+        "../" + std::string(37, 'A'),
+        "..\\" + std::string(37, 'A'),
+        "/tmp/" + std::string(59, 'A'),
+        "../../" + std::string(58, '0'),
+        std::string(39, 'A') + "/",
+        std::string(63, 'A') + ".",
+        std::string(20, 'A') + std::string("\0", 1) + std::string(19, 'A'),
+    };
+    std::vector<FileSpec> files;
+    for (size_t i = 0; i < hashes.size(); ++i) files.push_back({"f" + std::to_string(i), "x", hashes[i], content});
+
+    ModDataStreamDecoder decoder(store.u8string());
+    const auto frame = Encode(files);
+    REQUIRE(decoder.Feed(frame.data(), frame.size()));
+    REQUIRE(decoder.Finish());
+    CheckEvents(Drain(decoder), files, std::vector<ModDataFileStatus>(files.size(), ModDataFileStatus::Failed));
+    CHECK(fs::is_empty(store));
+    size_t entries = 0;
+    for (const auto& entry : fs::recursive_directory_iterator(root.Path())) entries += entry.path() != store;
+    CHECK(entries == 0);
+}
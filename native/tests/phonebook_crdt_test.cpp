@@ -0,0 +1,160 @@
+#include "test_util.h"
+#include "../phonebook_crdt.h"
+#include <map>
+#include <random>
+
+using namespace fyteclub;
+
+namespace {
+
+constexpr int64_t kNow = 1700000000;
+
+// SignedPhonebook (plugin/src/Phonebook/SignedPhonebook.cs) transcribed onto
+// dictionaries, signatures assumed valid: the behaviour Merge must reproduce
+struct ReferencePhonebook {
+    std::map<std::string, CrdtEntry> entries;
+    std::map<std::string, CrdtTombstone> tombstones;
+
+    void AddEntry(const CrdtEntry& entry, int64_t now) {
+        if (entry.IsExpired(now)) return; // Verify() fails for expired entries
+        if (tombstones.count(entry.peer_id)) return;
+        auto it = entries.find(entry.peer_id);
+        if (it == entries.end() || entry.sequence > it->second.sequence) entries[entry.peer_id] = entry;
+    }
+
+    void AddTombstone(const CrdtTombstone& tombstone, bool remove_entry) {
+        tombstones[tombstone.peer_id] = tombstone;
+        if (remove_entry) entries.erase(tombstone.peer_id);
+    }
+
+    void Merge(const ReferencePhonebook& other, int64_t now) {
+        for (const auto& [peer_id, entry] : other.entries) {
+            if (!entry.IsExpired(now)) AddEntry(entry, now);
+        }
+        for (const auto& [peer_id, tombstone] : other.tombstones) {
+            if (!tombstone.IsExpired(now)) {
+                tombstones[peer_id] = tombstone;
+                entries.erase(peer_id);
+            }
+        }
+    }
+};
+
+struct Pair {
+    ReferencePhonebook reference;
+    PhonebookCrdt crdt;
+};
+
+// Same random adds to both; ids from a small pool so peers collide, times
+// straddling both lifetimes so some records are expired
+void Fill(Pair& pair, std::mt19937& random, uint64_t& payload) {
+    auto peer = [&] { return "peer" + std::to_string(random() % 40); };
+    for (int i = 0; i < 120; ++i) {
+        if (random() % 4 == 0) {
+            CrdtTombstone tombstone;
+            tombstone.peer_id = peer();
+            tombstone.entry_sequence = random() % 5;
+            tombstone.timestamp = kNow - static_cast<int64_t>(random() % (9 * 24 * 3600));
+            tombstone.payload = ++payload;
+            bool remove_entry = random() % 5 != 0;
+            pair.reference.AddTombstone(tombstone, remove_entry);
+            pair.crdt.AddTombstone(tombstone, remove_entry);
+        } else {
+            CrdtEntry entry;
+            entry.peer_id = peer();
+            entry.sequence = random() % 5;
+            entry.timestamp = kNow - static_cast<int64_t>(random() % (30 * 3600));
+            entry.payload = ++payload;
+            pair.reference.AddEntry(entry, kNow);
+            pair.crdt.AddEntry(entry, kNow);
+        }
+    }
+}
+
+void CheckSame(Pair& pair) {
+    const auto& reference = pair.reference;
+    REQUIRE(pair.crdt.EntryCount() == reference.entries.size());
+    size_t index = 0;
+    for (const auto& [peer_id, expected] : reference.entries) {
+        CrdtEntry entry;
+        REQUIRE(pair.crdt.EntryAt(index++, entry));
+        CHECK(entry.peer_id == peer_id);
+        CHECK(entry.sequence == expected.sequence);
+        CHECK(entry.payload == expected.payload);
+    }
+    REQUIRE(pair.crdt.TombstoneCount() == reference.tombstones.size());
+    index = 0;
+    for (const auto& [peer_id, expected] : reference.tombstones) {
+        CrdtTombstone tombstone;
+        REQUIRE(pair.crdt.TombstoneAt(index++, tombstone));
+        CHECK(tombstone.peer_id == peer_id);
+        CHECK(tombstone.payload == expected.payload);
+    }
+    for (int i = 0; i < 40; ++i) {
+        const std::string peer_id = "peer" + std::to_string(i);
+        auto tombstone = reference.tombstones.find(peer_id);
+        CHECK(pair.crdt.IsRevoked(peer_id, kNow) ==
+              (tombstone != reference.tombstones.end() && !tombstone->second.IsExpired(kNow)));
+        auto expected = reference.entries.find(peer_id);
+        CrdtEntry entry;
+        bool found = pair.crdt.GetEntry(peer_id, kNow, entry);
+        CHECK(found == (expected != reference.entries.end() && !expected->second.IsExpired(kNow)));
+        if (found) CHECK(entry.payload == expected->second.payload);
+    }
+}
+
+}
+
+TEST(MergeMatchesSignedPhonebook) {
+    std::mt19937 random(5);
+    uint64_t payload = 0;
+    for (int round = 0; round < 200; ++round) {
+        Pair ours;
+        Pair theirs;
+        Fill(ours, random, payload);
+        Fill(theirs, random, payload);
+        CheckSame(ours);
+        CheckSame(theirs);
+
+        ours.reference.Merge(theirs.reference, kNow);
+        ours.crdt.Merge(theirs.crdt, kNow);
+        CheckSame(ours);
+        // The other side is only read
+        CheckSame(theirs);
+
+        // Adds after a merge go through the rebuilt revocation index
+        Fill(ours, random, payload);
+        CheckSame(ours);
+    }
+}
+
+TEST(MergeStatsCountEachOutcome) {
+    PhonebookCrdt ours;
+    PhonebookCrdt theirs;
+    CHECK(ours.AddEntry({"kept", 2, kNow, 1}, kNow));
+    CHECK(ours.AddEntry({"replaced", 1, kNow, 2}, kNow));
+    CHECK(ours.AddEntry({"removed", 1, kNow, 3}, kNow));
+    CHECK(theirs.AddEntry({"kept", 2, kNow, 4}, kNow));
+    CHECK(theirs.AddEntry({"replaced", 2, kNow, 5}, kNow));
+    CHECK(theirs.AddEntry({"added", 1, kNow, 6}, kNow));
+    CHECK(!theirs.AddEntry({"stale", 1, kNow - kPhonebookEntryLifetimeSeconds - 1, 7}, kNow));
+    theirs.AddTombstone({"removed", 1, kNow, 8});
+    theirs.AddTombstone({"old", 1, kNow - kTombstoneLifetimeSeconds - 1, 9});
+
+    auto stats = ours.Merge(theirs, kNow);
+    CHECK(stats.entries_added == 1);
+    CHECK(stats.entries_replaced == 1);
+    CHECK(stats.entries_removed == 1);
+    CHECK(stats.tombstones_taken == 1);
+
+    CrdtEntry entry;
+    REQUIRE(ours.GetEntry("kept", kNow, entry));
+    CHECK(entry.payload == 1); // equal sequence keeps ours
+    REQUIRE(ours.GetEntry("replaced", kNow, entry));
+    CHECK(entry.payload == 5);
+    CHECK(!ours.GetEntry("removed", kNow, entry));
+    CHECK(ours.IsRevoked("removed", kNow));
+    CHECK(!ours.IsRevoked("old", kNow));
+    CHECK(ours.Cleanup(kNow + kPhonebookEntryLifetimeSeconds + 1) == 3);
+    CHECK(ours.EntryCount() == 0);
+}
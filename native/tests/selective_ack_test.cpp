@@ -0,0 +1,163 @@
+#include "test_util.h"
+#include "../selective_ack.h"
+#include <random>
+#include <set>
+
+using namespace fyteclub;
+
+namespace {
+
+// Maximal runs of a reference set, as ForEachRun reports them
+std::vector<ChunkRange> Runs(const std::set<uint32_t>& members) {
+    std::vector<ChunkRange> runs;
+    for (uint32_t index : members) {
+        if (!runs.empty() && runs.back().start + runs.back().count == index) {
+            ++runs.back().count;
+        } else {
+            runs.push_back({index, 1});
+        }
+    }
+    return runs;
+}
+
+std::vector<ChunkRange> Runs(const ChunkIndexSet& set) {
+    std::vector<ChunkRange> runs;
+    set.ForEachRun([&](uint32_t start, uint32_t count) {
+        runs.push_back({start, count});
+        return true;
+    });
+    return runs;
+}
+
+bool SameRanges(const std::vector<ChunkRange>& a, const std::vector<ChunkRange>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].start != b[i].start || a[i].count != b[i].count) return false;
+    }
+    return true;
+}
+
+AckInfo RoundTrip(uint64_t stream_id, const ChunkIndexSet& set) {
+    std::vector<uint8_t> frame(MaxAckFrameSize());
+    size_t size = WriteAckFrame(stream_id, set, frame.data(), frame.size());
+    REQUIRE(size > 0);
+    REQUIRE(IsAckFrame(frame.data(), size));
+    AckInfo ack;
+    REQUIRE(ParseAckFrame(frame.data(), size, ack));
+    return ack;
+}
+
+}
+
+TEST(IndexSetMatchesReferenceAcrossContainers) {
+    ChunkIndexSet set;
+    std::set<uint32_t> reference;
+    std::mt19937 random(7);
+    // Dense enough in container 0 to become a bitmap, sparse in 1 and 3
+    for (int i = 0; i < 30000; ++i) {
+        uint32_t index = random() % 40000;
+        CHECK(set.Add(index) == reference.insert(index).second);
+    }
+    for (int i = 0; i < 500; ++i) {
+        uint32_t index = 65536 + random() % 65536;
+        CHECK(set.Add(index) == reference.insert(index).second);
+        index = 3 * 65536 + random() % 1000;
+        CHECK(set.Add(index) == reference.insert(index).second);
+    }
+    CHECK(set.Count() == reference.size());
+    for (uint32_t index = 0; index < 4 * 65536; index += 7) CHECK(set.Contains(index) == (reference.count(index) > 0));
+    CHECK(SameRanges(Runs(set), Runs(reference)));
+
+    uint32_t contiguous = 0;
+    while (reference.count(contiguous)) ++contiguous;
+    CHECK(set.ContiguousFromZero() == contiguous);
+}
+
+TEST(AckReportsExactlyTheMissingChunks) {
+    constexpr uint32_t kTotal = 20000;
+    ChunkIndexSet set;
+    std::set<uint32_t> reference;
+    std::mt19937 random(11);
+    for (uint32_t index = 0; index < 15000; ++index) {
+        // Everything below 1000 arrives, then about one in a hundred is lost
+        if (index < 1000 || random() % 100 != 0) {
+            set.Add(index);
+            reference.insert(index);
+        }
+    }
+
+    auto ack = RoundTrip(42, set);
+    CHECK(ack.stream_id == 42);
+    CHECK(ack.through == set.ContiguousFromZero());
+    CHECK(ack.end == *reference.rbegin() + 1);
+    REQUIRE(ack.gaps.size() < kMaxAckGaps);
+
+    std::set<uint32_t> missing;
+    for (uint32_t index = 0; index < kTotal; ++index) {
+        if (!reference.count(index)) missing.insert(index);
+    }
+    CHECK(SameRanges(MissingChunks(ack, kTotal), Runs(missing)));
+    // Without a total only the gaps are reported
+    CHECK(SameRanges(MissingChunks(ack, 0), ack.gaps));
+}
+
+TEST(AckBeyondMaxGapsLeavesTheRestMissing) {
+    ChunkIndexSet set;
+    // Every other chunk, so there is a gap between each pair
+    for (uint32_t index = 0; index < 4 * kMaxAckGaps; index += 2) set.Add(index);
+
+    auto ack = RoundTrip(1, set);
+    CHECK(ack.through == 1);
+    CHECK(ack.gaps.size() == kMaxAckGaps);
+    // The sender resends everything past the last described run; nothing received is lost
+    auto missing = MissingChunks(ack, 4 * kMaxAckGaps);
+    for (const auto& range : missing) {
+        for (uint32_t index = range.start; index < range.start + range.count; ++index) {
+            if (index < ack.end) CHECK(!set.Contains(index));
+        }
+    }
+    CHECK(missing.back().start == ack.end);
+}
+
+TEST(DamagedAckIsRejected) {
+    ChunkIndexSet set;
+    for (uint32_t index : {0u, 1u, 2u, 5u, 9u}) set.Add(index);
+    std::vector<uint8_t> frame(MaxAckFrameSize());
+    size_t size = WriteAckFrame(3, set, frame.data(), frame.size());
+    REQUIRE(size > 0);
+    CHECK(WriteAckFrame(3, set, frame.data(), size - 1) == 0);
+
+    AckInfo ack;
+    for (size_t i = 1; i < size; ++i) {
+        auto damaged = frame;
+        damaged[i] ^= 0x10;
+        CHECK(!ParseAckFrame(damaged.data(), size, ack));
+    }
+    CHECK(!ParseAckFrame(frame.data(), size - 1, ack));
+    frame[0] = 0xC5;
+    CHECK(!IsAckFrame(frame.data(), size));
+}
+
+TEST(TrackerCountsEachChunkOnce) {
+    AckTracker tracker;
+    CHECK(tracker.OnChunk(1, 0));
+    CHECK(tracker.OnChunk(1, 2));
+    CHECK(!tracker.OnChunk(1, 2));
+    CHECK(tracker.OnChunk(2, 2));
+    CHECK(tracker.ReceivedCount(1) == 2);
+
+    std::vector<uint8_t> frame(MaxAckFrameSize());
+    size_t size = tracker.WriteAck(1, frame.data(), frame.size());
+    AckInfo ack;
+    REQUIRE(ParseAckFrame(frame.data(), size, ack));
+    REQUIRE(ack.gaps.size() == 1);
+    CHECK(ack.gaps[0].start == 1);
+    CHECK(ack.gaps[0].count == 1);
+
+    tracker.CloseStream(1);
+    CHECK(tracker.ReceivedCount(1) == 0);
+    size = tracker.WriteAck(1, frame.data(), frame.size());
+    REQUIRE(ParseAckFrame(frame.data(), size, ack));
+    CHECK(ack.end == 0);
+    CHECK(tracker.ReceivedCount(2) == 1);
+}
@@ -0,0 +1,140 @@
+#include "test_util.h"
+#include "../snapshot_pack.h"
+#include <fstream>
+#include <iterator>
+#include <map>
+
+using namespace fyteclub;
+
+namespace {
+
+std::string Sha256Hex(const std::vector<uint8_t>& data) {
+    static const char kDigits[] = "0123456789ABCDEF";
+    uint8_t digest[Sha256::kDigestSize];
+    Sha256::Hash(data.data(), data.size(), digest);
+    std::string hex;
+    for (uint8_t byte : digest) {
+        hex += kDigits[byte >> 4];
+        hex += kDigits[byte & 0xF];
+    }
+    return hex;
+}
+
+std::string Sha1Hex(const std::vector<uint8_t>& data) {
+    return Sha1::HexDigest(data.data(), data.size());
+}
+
+std::string WriteFile(const test::TempDir& dir, const std::string& name, const std::vector<uint8_t>& content) {
+    auto path = dir.Path() / name;
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(content.data()), static_cast<std::streamsize>(content.size()));
+    return path.u8string();
+}
+
+std::vector<uint8_t> ReadFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+std::vector<SnapshotPackEvent> Transfer(SnapshotPackWriter& writer, SnapshotPackReader& reader) {
+    std::vector<uint8_t> frame;
+    size_t size;
+    while (writer.PeekFrameSize(size)) {
+        frame.resize(size);
+        REQUIRE(writer.NextFrame(frame.data(), frame.size()) == size);
+        REQUIRE(reader.OnFrame(frame.data(), size));
+    }
+    std::vector<SnapshotPackEvent> events;
+    SnapshotPackEvent event;
+    while (reader.PopEvent(event)) events.push_back(event);
+    return events;
+}
+
+}
+
+TEST(MixedDigestPackRoundTrips) {
+    test::TempDir source;
+    test::TempDir joiner;
+    const auto shared = test::Pattern(150000, 1);
+    const auto sha1_only = test::Pattern(3000, 2);
+    const auto sha256_only = test::Pattern(70000, 3);
+    const auto already_held = test::Pattern(500, 4);
+    const std::string shared_hash = Sha1Hex(shared);
+    const std::string sha1_hash = Sha1Hex(sha1_only);
+    const std::string sha256_hash = Sha256Hex(sha256_only);
+    const std::string held_hash = Sha1Hex(already_held);
+
+    auto request = WriteSnapshotPackRequest(7, {held_hash, "not a hash"});
+    REQUIRE(!request.empty());
+    SnapshotPackWriter writer(16 * 1024);
+    REQUIRE(writer.LoadRequest(request.data(), request.size()));
+    const uint8_t recipe[] = {1, 2, 3};
+    CHECK(writer.AddMember("alice", recipe, sizeof(recipe), {shared_hash, sha1_hash, held_hash}));
+    CHECK(writer.AddMember("bob", recipe, sizeof(recipe), {shared_hash, sha256_hash}));
+    CHECK(writer.AddContent(shared_hash, WriteFile(source, "shared", shared)));
+    CHECK(writer.AddContent(sha1_hash, WriteFile(source, "sha1", sha1_only)));
+    CHECK(writer.AddContent(sha256_hash, WriteFile(source, "sha256", sha256_only)));
+    CHECK(writer.AddContent(held_hash, WriteFile(source, "held", already_held)));
+    CHECK(writer.ContentCount() == 3);
+
+    SnapshotPackReader reader(joiner.String(), 7);
+    auto events = Transfer(writer, reader);
+    CHECK(reader.Finished());
+
+    std::map<std::string, std::vector<uint8_t>> expected = {
+        {shared_hash, shared}, {sha1_hash, sha1_only}, {sha256_hash, sha256_only}};
+    size_t contents = 0;
+    size_t members = 0;
+    for (const auto& event : events) {
+        if (event.kind == SnapshotPackEventKind::Content) {
+            ++contents;
+            CHECK(event.verified);
+            REQUIRE(expected.count(event.hash));
+            CHECK(ReadFile(event.path) == expected[event.hash]);
+        } else if (event.kind == SnapshotPackEventKind::Member) {
+            ++members;
+            CHECK(event.failed == 0);
+            CHECK(event.recipe == std::vector<uint8_t>(recipe, recipe + sizeof(recipe)));
+        }
+    }
+    CHECK(contents == 3);
+    CHECK(members == 2);
+    CHECK(events.front().kind == SnapshotPackEventKind::Header);
+    CHECK(events.back().kind == SnapshotPackEventKind::End);
+}
+
+TEST(WrongContentFailsItsMember) {
+    test::TempDir source;
+    test::TempDir joiner;
+    const auto content = test::Pattern(5000, 5);
+    const auto impostor = test::Pattern(5000, 6);
+    const std::string hash = Sha1Hex(content);
+
+    auto request = WriteSnapshotPackRequest(1, {});
+    SnapshotPackWriter writer;
+    REQUIRE(writer.LoadRequest(request.data(), request.size()));
+    CHECK(writer.AddMember("carol", nullptr, 0, {hash}));
+    CHECK(writer.AddContent(hash, WriteFile(source, "impostor", impostor)));
+
+    SnapshotPackReader reader(joiner.String(), 1);
+    auto events = Transfer(writer, reader);
+    bool saw_member = false;
+    for (const auto& event : events) {
+        if (event.kind == SnapshotPackEventKind::Content) CHECK(!event.verified);
+        if (event.kind == SnapshotPackEventKind::Member) {
+            saw_member = true;
+            CHECK(event.failed == 1);
+        }
+    }
+    CHECK(saw_member);
+    CHECK(std::filesystem::is_empty(joiner.Path()));
+}
+
+TEST(MalformedHashesAreRefused) {
+    SnapshotPackWriter writer;
+    const std::string sha1(40, 'A');
+    CHECK(!writer.AddMember("dave", nullptr, 0, {sha1.substr(0, 39)}));
+    CHECK(!writer.AddMember("dave", nullptr, 0, {std::string(48, 'A')}));
+    CHECK(!writer.AddContent(std::string(39, 'G') + "A", "/nowhere"));
+    CHECK(writer.AddMember("dave", nullptr, 0, {sha1, std::string(64, 'b')}));
+}
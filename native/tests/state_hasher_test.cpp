@@ -0,0 +1,95 @@
+#include "test_util.h"
+#include "../state_hasher.h"
+
+using namespace fyteclub;
+
+namespace {
+
+uint64_t Digest(const StateHasher& hasher, const std::string& player) {
+    uint64_t digest = 0, generation = 0;
+    REQUIRE(hasher.GetDigest(player, digest, generation));
+    return digest;
+}
+
+uint64_t Generation(const StateHasher& hasher, const std::string& player) {
+    uint64_t digest = 0, generation = 0;
+    REQUIRE(hasher.GetDigest(player, digest, generation));
+    return generation;
+}
+
+}
+
+TEST(WireHashIsXxh64) {
+    // Reference vectors, so peers built with and without xxhash.h agree
+    CHECK(StateHasher::WireHash("", 0) == 0xEF46DB3751D8E999ull);
+    CHECK(StateHasher::WireHash("abc", 3) == 0x44BC2CF5AD770999ull);
+    // Every tail length and the 32-byte stripe loop
+    auto data = test::Pattern(100, 1);
+    for (size_t size = 0; size < data.size(); ++size) {
+        CHECK(StateHasher::WireHash(data.data(), size) != StateHasher::WireHash(data.data(), size, 1));
+    }
+}
+
+TEST(UnorderedListsHashAsMultisets) {
+    StateHasher hasher;
+    hasher.SetStrings("a", 0, {"mod1", "mod2", "mod3"}, true);
+    hasher.SetStrings("b", 0, {"mod3", "mod1", "mod2"}, true);
+    CHECK(Digest(hasher, "a") == Digest(hasher, "b"));
+
+    // Duplicates count, and order matters for ordered lists
+    hasher.SetStrings("c", 0, {"mod1", "mod1", "mod2", "mod3"}, true);
+    CHECK(Digest(hasher, "c") != Digest(hasher, "a"));
+    hasher.SetStrings("d", 0, {"mod1", "mod2"}, false);
+    hasher.SetStrings("e", 0, {"mod2", "mod1"}, false);
+    CHECK(Digest(hasher, "d") != Digest(hasher, "e"));
+    // An empty list is a value like any other
+    hasher.SetStrings("f", 0, {}, true);
+    hasher.SetStrings("g", 0, {""}, true);
+    CHECK(Digest(hasher, "f") != Digest(hasher, "g"));
+}
+
+TEST(SetClearedAndUnsetFieldsAreDistinct) {
+    StateHasher hasher;
+    const char title[] = "Warrior of Light";
+    hasher.SetField("unset", 1, title, sizeof(title));
+    hasher.SetField("empty", 1, title, sizeof(title));
+    hasher.SetField("empty", 2, nullptr, 0);
+    CHECK(Digest(hasher, "unset") != Digest(hasher, "empty"));
+    CHECK(hasher.ClearField("empty", 2));
+    CHECK(Digest(hasher, "unset") == Digest(hasher, "empty"));
+
+    // The same value in another field is a different state
+    hasher.SetField("moved", 3, title, sizeof(title));
+    CHECK(Digest(hasher, "moved") != Digest(hasher, "unset"));
+
+    // Clearing never creates a player
+    CHECK(!hasher.ClearField("stranger", 1));
+    uint64_t digest = 0, generation = 0;
+    CHECK(!hasher.GetDigest("stranger", digest, generation));
+    CHECK(hasher.PlayerCount() == 3);
+    hasher.RemovePlayer("moved");
+    CHECK(hasher.PlayerCount() == 2);
+    CHECK(!hasher.SetField("unset", StateHasher::kMaxFields, title, sizeof(title)));
+}
+
+TEST(GenerationBumpsOnlyOnChange) {
+    StateHasher hasher;
+    const char glamour[] = "design-1";
+    CHECK(hasher.SetField("p", 0, glamour, sizeof(glamour)));
+    const uint64_t first = Generation(hasher, "p");
+    CHECK(!hasher.SetField("p", 0, glamour, sizeof(glamour)));
+    CHECK(!hasher.ClearField("p", 5));
+    CHECK(Generation(hasher, "p") == first);
+
+    const char other[] = "design-2";
+    CHECK(hasher.SetField("p", 0, other, sizeof(other)));
+    CHECK(Generation(hasher, "p") == first + 1);
+    CHECK(hasher.ClearField("p", 0));
+    CHECK(!hasher.ClearField("p", 0));
+    CHECK(Generation(hasher, "p") == first + 2);
+    // Back to the first value, back to the first digest
+    const uint64_t cleared = Digest(hasher, "p");
+    CHECK(hasher.SetField("p", 0, glamour, sizeof(glamour)));
+    CHECK(hasher.ClearField("p", 0));
+    CHECK(Digest(hasher, "p") == cleared);
+}
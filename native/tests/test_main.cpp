@@ -0,0 +1,22 @@
+#include "test_util.h"
+#include <exception>
+
+int main() {
+    using namespace fyteclub::test;
+    int failed_cases = 0;
+    for (const auto& test_case : Cases()) {
+        const int before = Failures();
+        try {
+            test_case.body();
+        } catch (const RequireFailed&) {
+        } catch (const std::exception& error) {
+            std::fprintf(stderr, "%s: unexpected exception: %s\n", test_case.name, error.what());
+            ++Failures();
+        }
+        const bool passed = Failures() == before;
+        if (!passed) ++failed_cases;
+        std::printf("[%s] %s\n", passed ? " OK " : "FAIL", test_case.name);
+    }
+    std::printf("%zu cases, %d failed\n", Cases().size(), failed_cases);
+    return failed_cases == 0 ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Minimal test harness for the native unit tests (one executable per module,
+// run by ctest). TEST registers a case, CHECK records a failure and keeps
+// going, REQUIRE stops the case. test_main.cpp runs every case and returns
+// non-zero if any failed.
+
+namespace fyteclub::test {
+
+struct Case {
+    const char* name;
+    std::function<void()> body;
+};
+
+inline std::vector<Case>& Cases() {
+    static std::vector<Case> cases;
+    return cases;
+}
+
+inline int& Failures() {
+    static int failures = 0;
+    return failures;
+}
+
+struct Registrar {
+    Registrar(const char* name, std::function<void()> body) { Cases().push_back({name, std::move(body)}); }
+};
+
+struct RequireFailed {};
+
+inline void Fail(const char* file, int line, const char* expression) {
+    std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", file, line, expression);
+    ++Failures();
+}
+
+// Fresh directory under the system temp dir, removed when the case ends
+class TempDir {
+public:
+    TempDir() {
+        static std::atomic<int> next{0};
+        path_ = std::filesystem::temp_directory_path() /
+                ("fyteclub_test_" + std::to_string(reinterpret_cast<uintptr_t>(this)) + "_" + std::to_string(next++));
+        std::filesystem::remove_all(path_);
+        std::filesystem::create_directories(path_);
+    }
+    ~TempDir() {
+        std::error_code error;
+        std::filesystem::remove_all(path_, error);
+    }
+    TempDir(const TempDir&) = delete;
+    TempDir& operator=(const TempDir&) = delete;
+
+    const std::filesystem::path& Path() const { return path_; }
+    std::string String() const { return path_.u8string(); }
+
+private:
+    std::filesystem::path path_;
+};
+
+// Deterministic bytes for payloads
+inline std::vector<uint8_t> Pattern(size_t size, uint32_t seed) {
+    std::vector<uint8_t> out(size);
+    uint32_t state = seed * 2654435761u + 1;
+    for (auto& byte : out) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        byte = static_cast<uint8_t>(state);
+    }
+    return out;
+}
+
+}
+
+#define FC_TEST_CONCAT_(a, b) a##b
+#define FC_TEST_CONCAT(a, b) FC_TEST_CONCAT_(a, b)
+
+#define TEST(name)                                                                                  \
+    static void name();                                                                             \
+    static ::fyteclub::test::Registrar FC_TEST_CONCAT(name, _registrar)(#name, name);               \
+    static void name()
+
+#define CHECK(condition)                                                                            \
+    do {                                                                                            \
+        if (!(condition)) ::fyteclub::test::Fail(__FILE__, __LINE__, #condition);                   \
+    } while (0)
+
+#define REQUIRE(condition)                                                                          \
+    do {                                                                                            \
+        if (!(condition)) {                                                                         \
+            ::fyteclub::test::Fail(__FILE__, __LINE__, #condition);                                 \
+            throw ::fyteclub::test::RequireFailed{};                                                \
+        }                                                                                           \
+    } while (0)
@@ -0,0 +1,144 @@
+#include "test_util.h"
+#include "../timer_wheel.h"
+#include <algorithm>
+#include <map>
+#include <random>
+
+using namespace fyteclub;
+
+namespace {
+
+constexpr uint32_t kTickMs = 10;
+
+// Brute-force reference: every timer's due tick, checked on each advance
+struct Model {
+    uint64_t tick = 0;
+    std::map<uint64_t, uint64_t> due;        // id -> tick
+    std::map<uint64_t, TimerEvent> events;   // id -> what it was scheduled with
+
+    uint64_t DueFor(uint64_t delay_ms) const { return tick + std::max<uint64_t>((delay_ms + kTickMs - 1) / kTickMs, 1); }
+
+    uint64_t Schedule(TimerWheel& wheel, uint64_t delay_ms, uint32_t kind, uint64_t key) {
+        uint64_t id = wheel.Schedule(delay_ms, kind, key);
+        CHECK(id != 0);
+        CHECK(!events.count(id));
+        due[id] = DueFor(delay_ms);
+        events[id] = {id, kind, key};
+        return id;
+    }
+};
+
+// Advances both and checks the wheel fired exactly the timers that came due, in due order
+void AdvanceBoth(TimerWheel& wheel, Model& model, uint64_t now_ms) {
+    const size_t fired = wheel.Advance(now_ms);
+    model.tick = std::max(model.tick, now_ms / kTickMs);
+
+    std::map<uint64_t, uint64_t> expected; // id -> due tick
+    for (auto it = model.due.begin(); it != model.due.end();) {
+        if (it->second <= model.tick) {
+            expected.insert(*it);
+            it = model.due.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    CHECK(fired == expected.size());
+
+    size_t popped = 0;
+    uint64_t last_due = 0;
+    TimerEvent event;
+    while (wheel.PopExpired(event)) {
+        ++popped;
+        auto it = expected.find(event.id);
+        REQUIRE(it != expected.end());
+        CHECK(it->second >= last_due);
+        last_due = it->second;
+        CHECK(event.kind == model.events[event.id].kind);
+        CHECK(event.key == model.events[event.id].key);
+        expected.erase(it);
+    }
+    CHECK(popped == fired);
+    CHECK(expected.empty());
+    CHECK(wheel.Pending() == model.due.size());
+}
+
+}
+
+TEST(RandomOperationsMatchReference) {
+    const uint64_t start_ms = 123457;
+    TimerWheel wheel(kTickMs, start_ms);
+    Model model;
+    model.tick = start_ms / kTickMs;
+    std::mt19937_64 random(3);
+    uint64_t now_ms = start_ms;
+
+    // Delays from one tick to ~2.5 hours, log-uniform, so every level below the top sees traffic
+    auto delay = [&] { return static_cast<uint64_t>(std::exp2(std::uniform_real_distribution<double>(0, 23.1)(random))); };
+    std::vector<uint64_t> ids;
+    for (int round = 0; round < 3000; ++round) {
+        for (int op = 0; op < 4; ++op) {
+            uint64_t roll = random() % 10;
+            if (roll < 6 || ids.empty()) {
+                ids.push_back(model.Schedule(wheel, delay(), static_cast<uint32_t>(random() % 5), random()));
+            } else {
+                uint64_t id = ids[random() % ids.size()];
+                bool pending = model.due.count(id) > 0;
+                if (roll < 8) {
+                    uint64_t d = delay();
+                    CHECK(wheel.Reschedule(id, d) == pending);
+                    if (pending) model.due[id] = model.DueFor(d);
+                } else {
+                    CHECK(wheel.Cancel(id) == pending);
+                    model.due.erase(id);
+                }
+            }
+        }
+        // Steps from a fraction of a tick to a couple of root revolutions
+        now_ms += random() % (kTickMs * 600);
+        AdvanceBoth(wheel, model, now_ms);
+    }
+
+    // Drain: everything left fires by its due time and not before
+    while (!model.due.empty()) {
+        uint64_t next_due = std::min_element(model.due.begin(), model.due.end(), [](const auto& a, const auto& b) {
+                                return a.second < b.second;
+                            })->second;
+        AdvanceBoth(wheel, model, next_due * kTickMs - 1);
+        AdvanceBoth(wheel, model, next_due * kTickMs);
+    }
+    CHECK(wheel.Pending() == 0);
+}
+
+TEST(DelaysBeyondTheWheelAreRefiled) {
+    TimerWheel wheel(kTickMs, 0);
+    Model model;
+    // Past the ~7.8 day span of the top level
+    const uint64_t delays[] = {8ull * 24 * 3600 * 1000, 3ull * 24 * 3600 * 1000, 1};
+    for (uint64_t d : delays) model.Schedule(wheel, d, 2, d);
+    std::vector<uint64_t> dues;
+    for (const auto& entry : model.due) dues.push_back(entry.second);
+    std::sort(dues.begin(), dues.end());
+    for (uint64_t due : dues) {
+        AdvanceBoth(wheel, model, due * kTickMs - 1);
+        AdvanceBoth(wheel, model, due * kTickMs);
+    }
+    CHECK(model.due.empty());
+}
+
+TEST(ClockGoingBackwardsIsIgnored) {
+    TimerWheel wheel(kTickMs, 5000);
+    uint64_t id = wheel.Schedule(100, 1, 7);
+    CHECK(wheel.Advance(5050) == 0);
+    CHECK(wheel.Advance(1000) == 0);
+    // Still measured from 5000, not reset to 1000
+    CHECK(wheel.Advance(5099) == 0);
+    CHECK(wheel.Advance(5100) == 1);
+    TimerEvent event;
+    REQUIRE(wheel.PopExpired(event));
+    CHECK(event.id == id);
+    CHECK(event.kind == 1);
+    CHECK(event.key == 7);
+    CHECK(!wheel.PopExpired(event));
+    CHECK(!wheel.Reschedule(id, 10));
+    CHECK(!wheel.Cancel(id));
+}
@@ -0,0 +1,154 @@
+#include "test_util.h"
+#include "../upload_admission.h"
+
+using namespace fyteclub;
+
+namespace {
+
+UploadAdmissionConfig SmallConfig() {
+    UploadAdmissionConfig config;
+    config.max_active = 2;
+    config.max_queue = 4;
+    config.memory_limit_bytes = 1000;
+    config.cpu_limit_percent = 80;
+    return config;
+}
+
+}
+
+TEST(QueuedUploadsStartInArrivalOrder) {
+    UploadAdmission admission(SmallConfig());
+    auto first = admission.Request(1, 100, 1000, 0);
+    auto second = admission.Request(2, 200, 1000, 0);
+    CHECK(first.result == AdmissionResult::Admitted);
+    CHECK(second.result == AdmissionResult::Admitted);
+
+    uint64_t queued[4];
+    for (uint64_t peer = 3; peer <= 6; ++peer) {
+        auto decision = admission.Request(peer, peer * 100, 1000, 0);
+        REQUIRE(decision.result == AdmissionResult::Queued);
+        CHECK(decision.position == peer - 2);
+        queued[peer - 3] = decision.ticket;
+    }
+    auto full = admission.Request(7, 700, 1000, 0);
+    CHECK(full.result == AdmissionResult::Shed);
+    CHECK(full.reason == ShedReason::QueueFull);
+    CHECK(admission.QueuedCount() == 4);
+
+    // Each freed slot promotes the oldest queued ticket, cancelled ones skipped
+    uint64_t ticket = 0;
+    CHECK(!admission.PopAdmitted(ticket));
+    CHECK(admission.Cancel(queued[0], 10));
+    CHECK(!admission.PopAdmitted(ticket));
+    admission.Complete(first.ticket, 1000, 10);
+    REQUIRE(admission.PopAdmitted(ticket));
+    CHECK(ticket == queued[1]);
+    CHECK(admission.Cancel(second.ticket, 20));
+    REQUIRE(admission.PopAdmitted(ticket));
+    CHECK(ticket == queued[2]);
+    CHECK(admission.ActiveCount() == 2);
+    CHECK(admission.QueuedCount() == 1);
+    CHECK(!admission.Cancel(queued[0], 20));
+}
+
+TEST(WaitEstimateFollowsMeasuredThroughput) {
+    UploadAdmissionConfig config = SmallConfig();
+    config.max_active = 1;
+    UploadAdmission admission(config);
+    const uint64_t initial = admission.ThroughputBytesPerSecond();
+    CHECK(initial > 0);
+
+    // 1 MB in 100 ms pulls the estimate toward 10 MB/s
+    auto upload = admission.Request(1, 100, 1 << 20, 0);
+    admission.Complete(upload.ticket, 1 << 20, 100);
+    const uint64_t faster = admission.ThroughputBytesPerSecond();
+    CHECK(faster > initial);
+    // Tiny uploads say nothing about the link
+    upload = admission.Request(1, 100, 10, 100);
+    admission.Complete(upload.ticket, 10, 101);
+    CHECK(admission.ThroughputBytesPerSecond() == faster);
+
+    // Running bytes plus everything ahead, so each later position waits longer
+    admission.Request(1, 100, 4 << 20, 1000);
+    uint32_t last_wait = 0;
+    for (uint64_t peer = 2; peer <= 4; ++peer) {
+        auto decision = admission.Request(peer, peer, 4 << 20, 1000);
+        REQUIRE(decision.result == AdmissionResult::Queued);
+        CHECK(decision.wait_ms > last_wait);
+        last_wait = decision.wait_ms;
+    }
+    // The running upload's share shrinks as time passes
+    auto later = admission.Request(5, 5, 4 << 20, 1200);
+    auto again = admission.Request(5, 5, 4 << 20, 1300);
+    CHECK(again.result == AdmissionResult::Duplicate);
+    CHECK(again.wait_ms < later.wait_ms);
+}
+
+TEST(RepeatRequestsFoldIntoOneTicket) {
+    UploadAdmissionConfig config = SmallConfig();
+    config.max_active = 1;
+    UploadAdmission admission(config);
+    auto active = admission.Request(1, 100, 1000, 0);
+    REQUIRE(active.result == AdmissionResult::Admitted);
+    auto repeat = admission.Request(1, 100, 1000, 0);
+    CHECK(repeat.result == AdmissionResult::Duplicate);
+    CHECK(repeat.ticket == active.ticket);
+    CHECK(repeat.position == 0);
+
+    // A new state for a peer with an upload running queues behind it
+    auto next = admission.Request(1, 101, 1000, 0);
+    CHECK(next.result == AdmissionResult::Queued);
+    auto other = admission.Request(2, 200, 1000, 0);
+    CHECK(other.position == 2);
+
+    // Yet another state replaces the queued one and keeps its place
+    auto newer = admission.Request(1, 102, 1000, 0);
+    CHECK(newer.result == AdmissionResult::Queued);
+    CHECK(newer.ticket == next.ticket);
+    CHECK(newer.position == 1);
+    CHECK(admission.Request(1, 102, 1000, 0).result == AdmissionResult::Duplicate);
+    CHECK(admission.QueuedCount() == 2);
+}
+
+TEST(PressureHalvesSlotsAndShedsRedundantUploads) {
+    UploadAdmissionConfig config = SmallConfig();
+    config.max_active = 4;
+    config.max_queue = 8;
+    UploadAdmission admission(config);
+    admission.ReportLoad(500, 10);
+    CHECK(!admission.UnderPressure());
+    admission.ReportLoad(1001, 10);
+    CHECK(admission.UnderPressure());
+
+    CHECK(admission.Request(1, 100, 1000, 0).result == AdmissionResult::Admitted);
+    CHECK(admission.Request(2, 200, 1000, 0).result == AdmissionResult::Admitted);
+    // Two of four slots while under pressure
+    auto queued = admission.Request(3, 300, 1000, 0);
+    CHECK(queued.result == AdmissionResult::Queued);
+    // Content another peer is already receiving is refused: that peer can serve it
+    auto redundant = admission.Request(4, 100, 1000, 0);
+    CHECK(redundant.result == AdmissionResult::Shed);
+    CHECK(redundant.reason == ShedReason::Redundant);
+    CHECK(redundant.wait_ms > 0);
+    // The queue shrinks to the configured active count
+    for (uint64_t peer = 5; peer <= 7; ++peer) admission.Request(peer, peer * 100, 1000, 0);
+    CHECK(admission.QueuedCount() == 4);
+    CHECK(admission.Request(8, 800, 1000, 0).reason == ShedReason::QueueFull);
+
+    // Hysteresis: pressure holds until both are under 90% of their limits
+    admission.ReportLoad(950, 10);
+    CHECK(admission.UnderPressure());
+    admission.ReportLoad(800, 81);
+    CHECK(admission.UnderPressure());
+    admission.ReportLoad(800, 75);
+    CHECK(admission.UnderPressure());
+    admission.ReportLoad(800, 70);
+    CHECK(!admission.UnderPressure());
+    CHECK(admission.Cancel(queued.ticket, 0));
+    CHECK(admission.Request(9, 100, 1000, 0).result == AdmissionResult::Queued);
+
+    // Limits of 0 are never checked
+    UploadAdmission unchecked(UploadAdmissionConfig{});
+    unchecked.ReportLoad(~0ull, 100);
+    CHECK(!unchecked.UnderPressure());
+}
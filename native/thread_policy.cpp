@@ -0,0 +1,164 @@
+#include "thread_policy.h"
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+namespace fyteclub {
+
+namespace {
+
+constexpr size_t kPoolCount = static_cast<size_t>(ThreadPool::Count);
+
+std::mutex g_policy_mutex;
+ThreadPoolPolicy g_policies[kPoolCount];
+
+uint64_t AllProcessorsMask(unsigned count) {
+    return count >= 64 ? ~0ull : (1ull << count) - 1;
+}
+
+bool SetCurrentThreadPriority(ThreadPriority priority) {
+#ifdef _WIN32
+    int value = THREAD_PRIORITY_NORMAL;
+    switch (priority) {
+        case ThreadPriority::Lowest: value = THREAD_PRIORITY_LOWEST; break;
+        case ThreadPriority::BelowNormal: value = THREAD_PRIORITY_BELOW_NORMAL; break;
+        case ThreadPriority::Normal: value = THREAD_PRIORITY_NORMAL; break;
+        case ThreadPriority::AboveNormal: value = THREAD_PRIORITY_ABOVE_NORMAL; break;
+    }
+    return SetThreadPriority(GetCurrentThread(), value) != 0;
+#elif defined(__linux__)
+    // Linux nice values are per thread; raising priority back needs CAP_SYS_NICE
+    int nice_value = -5 * static_cast<int>(priority);
+    return setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), nice_value) == 0;
+#else
+    return priority == ThreadPriority::Normal;
+#endif
+}
+
+bool SetCurrentThreadAffinity(uint64_t mask) {
+    mask &= AllProcessorsMask(ThreadPolicy::LogicalProcessorCount());
+    if (mask == 0) return true;
+#ifdef _WIN32
+    return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(mask)) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (unsigned cpu = 0; cpu < 64; ++cpu) {
+        if (mask & (1ull << cpu)) CPU_SET(cpu, &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+}
+
+void ThreadPolicy::Set(ThreadPool pool, const ThreadPoolPolicy& policy) {
+    if (pool >= ThreadPool::Count) return;
+    std::lock_guard<std::mutex> lock(g_policy_mutex);
+    g_policies[static_cast<size_t>(pool)] = policy;
+}
+
+ThreadPoolPolicy ThreadPolicy::Get(ThreadPool pool) {
+    if (pool >= ThreadPool::Count) return {};
+    std::lock_guard<std::mutex> lock(g_policy_mutex);
+    return g_policies[static_cast<size_t>(pool)];
+}
+
+void ThreadPolicy::Reset() {
+    std::lock_guard<std::mutex> lock(g_policy_mutex);
+    for (auto& policy : g_policies) policy = {};
+}
+
+void ThreadPolicy::ApplyGameFriendlyPreset() {
+    // The game's main and render threads tend to sit on the first cores;
+    // leave those (and their SMT siblings) to the game
+    const unsigned count = LogicalProcessorCount();
+    const unsigned reserved = count <= 2 ? 0 : count <= 4 ? 1 : count <= 8 ? 2 : 4;
+    const uint64_t bulk_mask = AllProcessorsMask(count) & ~AllProcessorsMask(reserved);
+    const unsigned bulk_threads = std::max(1u, (count - reserved) / 2);
+
+    std::lock_guard<std::mutex> lock(g_policy_mutex);
+    // Socket pumping is light and latency sensitive: normal priority, any core
+    g_policies[static_cast<size_t>(ThreadPool::Io)] = {ThreadPriority::Normal, 0, 2};
+    g_policies[static_cast<size_t>(ThreadPool::Crypto)] = {ThreadPriority::BelowNormal, bulk_mask, bulk_threads};
+    g_policies[static_cast<size_t>(ThreadPool::Compression)] = {ThreadPriority::Lowest, bulk_mask, bulk_threads};
+    g_policies[static_cast<size_t>(ThreadPool::Disk)] = {ThreadPriority::BelowNormal, bulk_mask, 2};
+}
+
+unsigned ThreadPolicy::ThreadCount(ThreadPool pool, unsigned requested) {
+    unsigned cap = Get(pool).max_threads;
+    if (cap > 0) requested = std::min(requested, cap);
+    return std::max(requested, 1u);
+}
+
+bool ThreadPolicy::ApplyToCurrentThread(ThreadPool pool) {
+    ThreadPoolPolicy policy = Get(pool);
+    bool priority_ok = SetCurrentThreadPriority(policy.priority);
+    bool affinity_ok = SetCurrentThreadAffinity(policy.affinity_mask);
+    return priority_ok && affinity_ok;
+}
+
+unsigned ThreadPolicy::LogicalProcessorCount() {
+    // Affinity masks cover one 64-processor group
+    return std::min(std::max(std::thread::hardware_concurrency(), 1u), 64u);
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// C exports for the plugin
+// ---------------------------------------------------------------------------
+
+extern "C" {
+
+// pool: 0 = I/O, 1 = crypto, 2 = compression, 3 = disk
+// priority: -2 lowest .. 1 above normal; affinity_mask 0 = any core; max_threads 0 = no cap
+__declspec(dllexport) int SetThreadPoolPolicy(int pool, int priority, uint64_t affinity_mask, int max_threads) {
+    if (pool < 0 || pool >= static_cast<int>(fyteclub::ThreadPool::Count)) return -1;
+    if (priority < -2 || priority > 1 || max_threads < 0) return -1;
+    fyteclub::ThreadPoolPolicy policy;
+    policy.priority = static_cast<fyteclub::ThreadPriority>(priority);
+    policy.affinity_mask = affinity_mask;
+    policy.max_threads = static_cast<unsigned>(max_threads);
+    fyteclub::ThreadPolicy::Set(static_cast<fyteclub::ThreadPool>(pool), policy);
+    return 0;
+}
+
+__declspec(dllexport) int GetThreadPoolPolicy(int pool, int* priority, uint64_t* affinity_mask, int* max_threads) {
+    if (pool < 0 || pool >= static_cast<int>(fyteclub::ThreadPool::Count)) return -1;
+    auto policy = fyteclub::ThreadPolicy::Get(static_cast<fyteclub::ThreadPool>(pool));
+    if (priority) *priority = static_cast<int>(policy.priority);
+    if (affinity_mask) *affinity_mask = policy.affinity_mask;
+    if (max_threads) *max_threads = static_cast<int>(policy.max_threads);
+    return 0;
+}
+
+__declspec(dllexport) void ApplyGameFriendlyThreadPolicy() {
+    fyteclub::ThreadPolicy::ApplyGameFriendlyPreset();
+}
+
+__declspec(dllexport) void ResetThreadPolicy() {
+    fyteclub::ThreadPolicy::Reset();
+}
+
+}
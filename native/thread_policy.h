@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+
+// Priority, CPU placement and size limits for native worker threads. Bulk
+// transfers otherwise run at normal priority on whatever core the scheduler
+// picks, right next to the game's main and render threads, and a big sync
+// shows up as frame time spikes.
+//
+// Each pool has its own policy. Worker threads call ApplyToCurrentThread once
+// at start-up and size themselves with ThreadCount. The game-friendly preset
+// keeps bulk work off the first logical processors, where the game's busiest
+// threads live, and drops compression and hashing below normal priority.
+
+namespace fyteclub {
+
+enum class ThreadPool : uint8_t {
+    Io,          // sockets, data channel pumping
+    Crypto,      // hashing and verification
+    Compression, // compress / decompress
+    Disk,        // file reads and writes
+    Count,
+};
+
+enum class ThreadPriority : int8_t {
+    Lowest = -2,
+    BelowNormal = -1,
+    Normal = 0,
+    AboveNormal = 1,
+};
+
+struct ThreadPoolPolicy {
+    ThreadPriority priority = ThreadPriority::Normal;
+    uint64_t affinity_mask = 0; // bit per logical processor, 0 = any
+    unsigned max_threads = 0;   // 0 = no cap
+};
+
+class ThreadPolicy {
+public:
+    static void Set(ThreadPool pool, const ThreadPoolPolicy& policy);
+    static ThreadPoolPolicy Get(ThreadPool pool);
+    static void Reset();
+    static void ApplyGameFriendlyPreset();
+
+    // requested clamped to the pool's cap, never below 1
+    static unsigned ThreadCount(ThreadPool pool, unsigned requested);
+    // Applies the pool's priority and affinity to the calling thread. Returns
+    // false when the OS refused either; the thread keeps running regardless.
+    static bool ApplyToCurrentThread(ThreadPool pool);
+
+    static unsigned LogicalProcessorCount();
+};
+
+}
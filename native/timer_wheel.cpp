@@ -0,0 +1,199 @@
+#include "timer_wheel.h"
+#include <algorithm>
+
+namespace fyteclub {
+
+namespace {
+
+constexpr uint64_t kRootSize = 1ull << 8;
+constexpr uint64_t kLevelSize = 1ull << 6;
+constexpr uint64_t kLevelMask = kLevelSize - 1;
+// Furthest a timer can be filed ahead of the clock
+constexpr uint64_t kMaxTicks = 1ull << (8 + 3 * 6);
+
+}
+
+TimerWheel::TimerWheel(uint32_t tick_ms, uint64_t now_ms)
+    : tick_ms_(std::max<uint32_t>(tick_ms, 1)), current_tick_(now_ms / std::max<uint32_t>(tick_ms, 1)) {}
+
+TimerWheel::~TimerWheel() = default;
+
+uint64_t TimerWheel::TicksFor(uint64_t delay_ms) const {
+    return std::max<uint64_t>((delay_ms + tick_ms_ - 1) / tick_ms_, 1);
+}
+
+void TimerWheel::Insert(Timer* timer) {
+    // A cascaded timer can be due on the very tick that pulled it down; its
+    // root slot is walked right after the cascade
+    uint64_t expires = std::max(timer->expires, current_tick_);
+    uint64_t delta = expires - current_tick_;
+    Timer** slot;
+    if (delta < kRootSize) {
+        slot = &root_[expires & (kRootSize - 1)];
+    } else if (delta < kRootSize << kLevelBits) {
+        slot = &levels_[0][(expires >> kRootBits) & kLevelMask];
+    } else if (delta < kRootSize << (2 * kLevelBits)) {
+        slot = &levels_[1][(expires >> (kRootBits + kLevelBits)) & kLevelMask];
+    } else {
+        // Beyond the wheel: park in the furthest slot and re-file when it cascades
+        if (delta >= kMaxTicks) expires = current_tick_ + kMaxTicks - 1;
+        slot = &levels_[2][(expires >> (kRootBits + 2 * kLevelBits)) & kLevelMask];
+    }
+    timer->slot = slot;
+    timer->prev = nullptr;
+    timer->next = *slot;
+    if (*slot) (*slot)->prev = timer;
+    *slot = timer;
+}
+
+void TimerWheel::Unlink(Timer* timer) {
+    if (timer->prev) {
+        timer->prev->next = timer->next;
+    } else {
+        *timer->slot = timer->next;
+    }
+    if (timer->next) timer->next->prev = timer->prev;
+    timer->prev = timer->next = nullptr;
+    timer->slot = nullptr;
+}
+
+void TimerWheel::Cascade(int level, size_t index) {
+    Timer* timer = levels_[level][index];
+    levels_[level][index] = nullptr;
+    while (timer) {
+        Timer* next = timer->next;
+        Insert(timer);
+        timer = next;
+    }
+}
+
+uint64_t TimerWheel::Schedule(uint64_t delay_ms, uint32_t kind, uint64_t key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto timer = std::make_unique<Timer>();
+    timer->event = {next_id_++, kind, key};
+    timer->expires = current_tick_ + TicksFor(delay_ms);
+    Insert(timer.get());
+    uint64_t id = timer->event.id;
+    timers_.emplace(id, std::move(timer));
+    return id;
+}
+
+bool TimerWheel::Reschedule(uint64_t id, uint64_t delay_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = timers_.find(id);
+    if (it == timers_.end()) return false;
+    Timer* timer = it->second.get();
+    Unlink(timer);
+    timer->expires = current_tick_ + TicksFor(delay_ms);
+    Insert(timer);
+    return true;
+}
+
+bool TimerWheel::Cancel(uint64_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = timers_.find(id);
+    if (it == timers_.end()) return false;
+    Unlink(it->second.get());
+    timers_.erase(it);
+    return true;
+}
+
+size_t TimerWheel::Advance(uint64_t now_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint64_t target = now_ms / tick_ms_;
+    size_t fired = 0;
+    while (current_tick_ < target) {
+        if (timers_.empty()) {
+            current_tick_ = target;
+            break;
+        }
+        current_tick_++;
+        const size_t index = static_cast<size_t>(current_tick_ & (kRootSize - 1));
+        if (index == 0) {
+            // Entering a new root revolution: pull the next level's slot down,
+            // and the level above's when that one wraps too
+            for (int level = 0; level < kLevels - 1; ++level) {
+                size_t level_index = static_cast<size_t>((current_tick_ >> (kRootBits + level * kLevelBits)) & kLevelMask);
+                Cascade(level, level_index);
+                if (level_index != 0) break;
+            }
+        }
+
+        Timer* timer = root_[index];
+        root_[index] = nullptr;
+        while (timer) {
+            Timer* next = timer->next;
+            expired_.push_back(timer->event);
+            timers_.erase(timer->event.id);
+            fired++;
+            timer = next;
+        }
+    }
+    return fired;
+}
+
+bool TimerWheel::PopExpired(TimerEvent& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (expired_.empty()) return false;
+    out = expired_.front();
+    expired_.pop_front();
+    return true;
+}
+
+size_t TimerWheel::Pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return timers_.size();
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// C exports for the plugin
+// ---------------------------------------------------------------------------
+//
+// The plugin drives the clock (Environment.TickCount64) from its framework
+// update and drains expired timers in the same place.
+
+extern "C" {
+
+__declspec(dllexport) void* CreateTimerWheel(int tick_ms, uint64_t now_ms) {
+    return new fyteclub::TimerWheel(tick_ms > 0 ? static_cast<uint32_t>(tick_ms) : 10, now_ms);
+}
+
+__declspec(dllexport) uint64_t TimerWheelSchedule(void* wheel, uint64_t delay_ms, int kind, uint64_t key) {
+    if (!wheel) return 0;
+    return static_cast<fyteclub::TimerWheel*>(wheel)->Schedule(delay_ms, static_cast<uint32_t>(kind), key);
+}
+
+__declspec(dllexport) int TimerWheelReschedule(void* wheel, uint64_t id, uint64_t delay_ms) {
+    return wheel && static_cast<fyteclub::TimerWheel*>(wheel)->Reschedule(id, delay_ms) ? 0 : -1;
+}
+
+__declspec(dllexport) int TimerWheelCancel(void* wheel, uint64_t id) {
+    return wheel && static_cast<fyteclub::TimerWheel*>(wheel)->Cancel(id) ? 0 : -1;
+}
+
+// Returns how many timers expired
+__declspec(dllexport) int TimerWheelAdvance(void* wheel, uint64_t now_ms) {
+    return wheel ? static_cast<int>(static_cast<fyteclub::TimerWheel*>(wheel)->Advance(now_ms)) : 0;
+}
+
+// Returns 1 and fills the outputs when an expired timer was waiting, else 0
+__declspec(dllexport) int TimerWheelPopExpired(void* wheel, uint64_t* id, int* kind, uint64_t* key) {
+    fyteclub::TimerEvent event;
+    if (!wheel || !static_cast<fyteclub::TimerWheel*>(wheel)->PopExpired(event)) return 0;
+    if (id) *id = event.id;
+    if (kind) *kind = static_cast<int>(event.kind);
+    if (key) *key = event.key;
+    return 1;
+}
+
+__declspec(dllexport) int TimerWheelPending(void* wheel) {
+    return wheel ? static_cast<int>(static_cast<fyteclub::TimerWheel*>(wheel)->Pending()) : 0;
+}
+
+__declspec(dllexport) void DestroyTimerWheel(void* wheel) {
+    delete static_cast<fyteclub::TimerWheel*>(wheel);
+}
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+// Hierarchical timing wheel for session, chunk and reconnect timeouts.
+// PerformMaintenance, the chunk-buffer expiry and the session LastActivity
+// checks each scan their whole collection on a timer, so their cost grows
+// with the number of sessions. Here scheduling, rescheduling (an activity
+// "touch") and cancelling are O(1), and advancing the clock only visits the
+// timers that are actually due.
+//
+// Four levels: 256 slots of one tick, then 64 slots each of 256, 16384 and
+// 1048576 ticks. With the default 10 ms tick that covers about 7.8 days;
+// longer delays are parked in the last level and re-filed as they come due.
+// Expired timers are queued and polled, so they fire on the caller's thread.
+
+namespace fyteclub {
+
+struct TimerEvent {
+    uint64_t id = 0;
+    uint32_t kind = 0; // caller-defined: session, chunk, reconnect...
+    uint64_t key = 0;  // caller-defined subject of the timer
+};
+
+class TimerWheel {
+public:
+    explicit TimerWheel(uint32_t tick_ms = 10, uint64_t now_ms = 0);
+    ~TimerWheel();
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // Returns the timer id (never 0). Delays are rounded up to whole ticks.
+    uint64_t Schedule(uint64_t delay_ms, uint32_t kind, uint64_t key);
+    // Moves a pending timer to delay_ms from now; false if it already fired or was cancelled
+    bool Reschedule(uint64_t id, uint64_t delay_ms);
+    bool Cancel(uint64_t id);
+
+    // Moves the clock forward and queues every timer now due. Returns how
+    // many fired. A clock that goes backwards is ignored.
+    size_t Advance(uint64_t now_ms);
+    bool PopExpired(TimerEvent& out);
+
+    size_t Pending() const;
+
+private:
+    static constexpr int kLevels = 4;
+    static constexpr int kRootBits = 8;
+    static constexpr int kLevelBits = 6;
+
+    struct Timer {
+        TimerEvent event;
+        uint64_t expires = 0; // tick
+        Timer* prev = nullptr;
+        Timer* next = nullptr;
+        Timer** slot = nullptr;
+    };
+
+    void Insert(Timer* timer);
+    void Unlink(Timer* timer);
+    void Cascade(int level, size_t index);
+    uint64_t TicksFor(uint64_t delay_ms) const;
+
+    const uint32_t tick_ms_;
+    uint64_t current_tick_;
+    uint64_t next_id_ = 1;
+
+    mutable std::mutex mutex_;
+    Timer* root_[1 << kRootBits] = {};
+    Timer* levels_[kLevels - 1][1 << kLevelBits] = {};
+    std::unordered_map<uint64_t, std::unique_ptr<Timer>> timers_;
+    std::deque<TimerEvent> expired_;
+};
+
+}
@@ -0,0 +1,726 @@
+// Wire schema code generator.
+//
+// Reads a .schema file (see schema/p2p_messages.schema) and writes:
+//   - a C++ header with view structs and constexpr field tables for wire_codec.h
+//   - a C# file with size/write/read methods for the existing plugin classes
+//
+// Usage: schema_codegen <input.schema> <output.h> <output.cs>
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Schema model
+// ---------------------------------------------------------------------------
+
+struct TypeRef {
+    enum class Kind { Scalar, Enum, Struct, List, Map } kind = Kind::Scalar;
+    std::string name; // scalar keyword or declared enum/struct name
+    bool nullable = false;
+    std::shared_ptr<TypeRef> element; // list element or map value
+};
+
+struct FieldDef {
+    uint32_t tag = 0;
+    TypeRef type;
+    std::string name;
+    uint32_t since = 1;
+    int line = 0;
+};
+
+struct EnumDef {
+    std::string name;
+    std::string cs_name;
+    std::vector<std::pair<std::string, int64_t>> values;
+};
+
+struct StructDef {
+    std::string name;
+    std::string cs_name;
+    bool is_message = false;
+    uint32_t message_id = 0;
+    bool base_only = false;
+    std::vector<FieldDef> fields;
+};
+
+struct Schema {
+    uint32_t version = 0;
+    std::string cs_namespace;
+    std::vector<EnumDef> enums;
+    std::vector<StructDef> structs;
+
+    const EnumDef* FindEnum(const std::string& name) const {
+        for (const auto& e : enums) {
+            if (e.name == name) return &e;
+        }
+        return nullptr;
+    }
+
+    const StructDef* FindStruct(const std::string& name) const {
+        for (const auto& s : structs) {
+            if (s.name == name) return &s;
+        }
+        return nullptr;
+    }
+};
+
+const std::set<std::string> kScalars = {"bool", "i32", "i64", "u32", "u64", "f32", "string", "bytes"};
+
+// ---------------------------------------------------------------------------
+// Parser
+// ---------------------------------------------------------------------------
+
+class Parser {
+public:
+    Parser(std::string path, std::string text) : path_(std::move(path)), text_(std::move(text)) {}
+
+    bool Parse(Schema& schema) {
+        while (Peek() != "") {
+            std::string keyword = Next();
+            if (keyword == "schema") {
+                schema.version = static_cast<uint32_t>(ParseNumber());
+                Expect(";");
+            } else if (keyword == "csharp_namespace") {
+                schema.cs_namespace = ParseDotted();
+                Expect(";");
+            } else if (keyword == "enum") {
+                ParseEnum(schema);
+            } else if (keyword == "struct" || keyword == "message") {
+                ParseStruct(schema, keyword == "message");
+            } else {
+                Fail("unexpected '" + keyword + "'");
+            }
+            if (failed_) return false;
+        }
+        if (schema.version == 0 || schema.version > 255) Fail("schema version must be 1-255");
+        if (schema.cs_namespace.empty()) Fail("missing csharp_namespace");
+        return !failed_;
+    }
+
+private:
+    void Fail(const std::string& message) {
+        if (!failed_) fprintf(stderr, "%s:%d: error: %s\n", path_.c_str(), line_, message.c_str());
+        failed_ = true;
+    }
+
+    void SkipSpaceAndComments() {
+        while (pos_ < text_.size()) {
+            char c = text_[pos_];
+            if (c == '\n') {
+                ++line_;
+                ++pos_;
+            } else if (std::isspace(static_cast<unsigned char>(c))) {
+                ++pos_;
+            } else if (c == '/' && pos_ + 1 < text_.size() && text_[pos_ + 1] == '/') {
+                while (pos_ < text_.size() && text_[pos_] != '\n') ++pos_;
+            } else {
+                break;
+            }
+        }
+    }
+
+    std::string Lex(bool consume) {
+        SkipSpaceAndComments();
+        if (pos_ >= text_.size()) return "";
+        size_t start = pos_;
+        size_t end = pos_;
+        if (std::isalnum(static_cast<unsigned char>(text_[end])) || text_[end] == '_' || text_[end] == '-') {
+            ++end;
+            while (end < text_.size() && (std::isalnum(static_cast<unsigned char>(text_[end])) || text_[end] == '_')) ++end;
+        } else {
+            ++end;
+        }
+        if (consume) pos_ = end;
+        return text_.substr(start, end - start);
+    }
+
+    std::string Peek() { return Lex(false); }
+    std::string Next() { return Lex(true); }
+
+    void Expect(const std::string& token) {
+        std::string actual = Next();
+        if (actual != token) Fail("expected '" + token + "' but found '" + actual + "'");
+    }
+
+    bool Accept(const std::string& token) {
+        if (Peek() != token) return false;
+        Next();
+        return true;
+    }
+
+    int64_t ParseNumber() {
+        std::string token = Next();
+        char* end = nullptr;
+        long long value = std::strtoll(token.c_str(), &end, 10);
+        if (token.empty() || *end != '\0') Fail("expected a number but found '" + token + "'");
+        return value;
+    }
+
+    std::string ParseIdentifier() {
+        std::string token = Next();
+        if (token.empty() || !(std::isalpha(static_cast<unsigned char>(token[0])) || token[0] == '_')) {
+            Fail("expected an identifier but found '" + token + "'");
+        }
+        return token;
+    }
+
+    std::string ParseDotted() {
+        std::string name = ParseIdentifier();
+        while (Accept(".")) name += "." + ParseIdentifier();
+        return name;
+    }
+
+    TypeRef ParseType(const Schema& schema) {
+        TypeRef type;
+        std::string name = ParseIdentifier();
+        if (name == "list") {
+            type.kind = TypeRef::Kind::List;
+            Expect("<");
+            type.element = std::make_shared<TypeRef>(ParseType(schema));
+            Expect(">");
+        } else if (name == "map") {
+            type.kind = TypeRef::Kind::Map;
+            Expect("<");
+            if (ParseIdentifier() != "string") Fail("map keys must be string");
+            Expect(",");
+            type.element = std::make_shared<TypeRef>(ParseType(schema));
+            Expect(">");
+        } else if (kScalars.count(name)) {
+            type.kind = TypeRef::Kind::Scalar;
+            type.name = name;
+        } else if (schema.FindEnum(name)) {
+            type.kind = TypeRef::Kind::Enum;
+            type.name = name;
+        } else if (const StructDef* def = schema.FindStruct(name)) {
+            if (def->is_message) Fail("messages cannot be nested, declare '" + name + "' as a struct");
+            type.kind = TypeRef::Kind::Struct;
+            type.name = name;
+        } else {
+            Fail("unknown type '" + name + "' (types must be declared before use)");
+        }
+
+        if (Accept("?")) {
+            bool nullable_ok = type.kind == TypeRef::Kind::Scalar && (type.name == "string" || type.name == "f32");
+            if (!nullable_ok) Fail("only string and f32 can be nullable");
+            type.nullable = true;
+        }
+        if (type.kind == TypeRef::Kind::List && type.element->kind != TypeRef::Kind::Struct &&
+            !(type.element->kind == TypeRef::Kind::Scalar && type.element->name == "string")) {
+            Fail("lists may only hold string or struct elements");
+        }
+        if (type.element && type.element->nullable) Fail("list and map elements cannot be nullable");
+        return type;
+    }
+
+    void ParseEnum(Schema& schema) {
+        EnumDef def;
+        def.name = ParseIdentifier();
+        def.cs_name = def.name;
+        if (Accept("as")) def.cs_name = ParseDotted();
+        Expect("{");
+        while (!failed_ && !Accept("}")) {
+            std::string value_name = ParseIdentifier();
+            Expect("=");
+            def.values.emplace_back(value_name, ParseNumber());
+            Expect(";");
+        }
+        schema.enums.push_back(std::move(def));
+    }
+
+    void ParseStruct(Schema& schema, bool is_message) {
+        StructDef def;
+        def.is_message = is_message;
+        def.name = ParseIdentifier();
+        if (schema.FindStruct(def.name) || schema.FindEnum(def.name)) Fail("duplicate type '" + def.name + "'");
+        if (is_message) {
+            Expect("=");
+            def.message_id = static_cast<uint32_t>(ParseNumber());
+            for (const auto& other : schema.structs) {
+                if (other.is_message && other.message_id == def.message_id) Fail("duplicate message id");
+            }
+        }
+        def.cs_name = is_message ? schema.cs_namespace + "." + def.name : def.name;
+        if (Accept("as")) def.cs_name = ParseDotted();
+        if (Accept(":")) {
+            std::string base_name = ParseIdentifier();
+            const StructDef* base = schema.FindStruct(base_name);
+            if (!base || base->is_message) {
+                Fail("unknown base struct '" + base_name + "'");
+            } else {
+                def.fields = base->fields;
+                for (auto& s : schema.structs) {
+                    if (s.name == base_name) s.base_only = true;
+                }
+            }
+        }
+
+        Expect("{");
+        std::set<uint32_t> tags;
+        for (const auto& f : def.fields) tags.insert(f.tag);
+        while (!failed_ && !Accept("}")) {
+            FieldDef field;
+            field.line = line_;
+            int64_t tag = ParseNumber();
+            if (tag < 1 || tag > (1 << 28)) Fail("field tags must be between 1 and 2^28");
+            field.tag = static_cast<uint32_t>(tag);
+            if (!tags.insert(field.tag).second) Fail("duplicate field tag " + std::to_string(tag));
+            Expect(":");
+            field.type = ParseType(schema);
+            field.name = ParseIdentifier();
+            if (Accept("@")) {
+                if (ParseIdentifier() != "since") Fail("unknown attribute");
+                Expect("(");
+                field.since = static_cast<uint32_t>(ParseNumber());
+                Expect(")");
+            }
+            Expect(";");
+            def.fields.push_back(std::move(field));
+        }
+        schema.structs.push_back(std::move(def));
+    }
+
+    std::string path_;
+    std::string text_;
+    size_t pos_ = 0;
+    int line_ = 1;
+    bool failed_ = false;
+};
+
+// ---------------------------------------------------------------------------
+// Naming helpers
+// ---------------------------------------------------------------------------
+
+std::string SnakeCase(const std::string& name) {
+    std::string out;
+    for (size_t i = 0; i < name.size(); ++i) {
+        char c = name[i];
+        bool upper = std::isupper(static_cast<unsigned char>(c));
+        bool previous_lower = i > 0 && !std::isupper(static_cast<unsigned char>(name[i - 1]));
+        bool next_lower = i + 1 < name.size() && std::islower(static_cast<unsigned char>(name[i + 1]));
+        if (upper && i > 0 && (previous_lower || next_lower)) out += '_';
+        out += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return out;
+}
+
+std::string PascalCase(const std::string& name) {
+    std::string out = name;
+    if (!out.empty()) out[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(out[0])));
+    return out;
+}
+
+std::string Global(const std::string& cs_name) { return "global::" + cs_name; }
+
+// ---------------------------------------------------------------------------
+// C++ output
+// ---------------------------------------------------------------------------
+
+std::string CppType(const TypeRef& type) {
+    switch (type.kind) {
+    case TypeRef::Kind::List:
+        return "List<" + CppType(*type.element) + ">";
+    case TypeRef::Kind::Map:
+        return "List<MapEntry<" + CppType(*type.element) + ">>";
+    case TypeRef::Kind::Enum:
+    case TypeRef::Kind::Struct:
+        return type.name;
+    case TypeRef::Kind::Scalar:
+        break;
+    }
+    static const std::map<std::string, std::string> kTypes = {
+        {"bool", "bool"},     {"i32", "int32_t"},  {"i64", "int64_t"},          {"u32", "uint32_t"},
+        {"u64", "uint64_t"},  {"f32", "float"},    {"string", "std::string_view"}, {"bytes", "Bytes"},
+    };
+    std::string base = kTypes.at(type.name);
+    return type.nullable ? "std::optional<" + base + ">" : base;
+}
+
+std::string CppDefault(const TypeRef& type) {
+    if (type.kind == TypeRef::Kind::Enum) return "{}";
+    if (type.kind != TypeRef::Kind::Scalar || type.nullable) return "";
+    if (type.name == "bool") return " = false";
+    if (type.name == "string" || type.name == "bytes") return "";
+    return " = 0";
+}
+
+std::string GenerateCpp(const Schema& schema, const std::string& source_name) {
+    std::ostringstream out;
+    out << "// <auto-generated> by schema_codegen from " << source_name << " - do not edit.\n";
+    out << "#pragma once\n#include \"../wire_codec.h\"\n\n";
+    out << "namespace fyteclub::wire {\n\n";
+    out << "constexpr uint32_t kSchemaVersion = " << schema.version << ";\n\n";
+
+    for (const auto& e : schema.enums) {
+        out << "enum class " << e.name << " : int32_t {\n";
+        for (const auto& [name, value] : e.values) out << "    " << name << " = " << value << ",\n";
+        out << "};\n\n";
+    }
+
+    for (const auto& s : schema.structs) {
+        if (s.base_only) continue;
+        out << "struct " << s.name << " {\n";
+        if (s.is_message) out << "    static constexpr uint32_t kType = " << s.message_id << ";\n\n";
+        for (const auto& f : s.fields) {
+            out << "    " << CppType(f.type) << " " << SnakeCase(f.name) << CppDefault(f.type) << ";\n";
+        }
+        out << "};\n\n";
+
+        out << "template <> struct MessageSchema<" << s.name << "> {\n";
+        out << "    static constexpr auto kFields = std::make_tuple(\n";
+        for (size_t i = 0; i < s.fields.size(); ++i) {
+            const auto& f = s.fields[i];
+            out << "        Field<&" << s.name << "::" << SnakeCase(f.name) << ", " << f.tag;
+            if (f.since > 1) out << ", " << f.since;
+            out << ">{\"" << f.name << "\"}" << (i + 1 < s.fields.size() ? "," : ");") << "\n";
+        }
+        out << "};\n\n";
+    }
+
+    out << "template <typename T> size_t Encode(const T& message, uint8_t* out, size_t capacity) {\n";
+    out << "    return Encode(message, out, capacity, kSchemaVersion);\n}\n\n";
+
+    out << "// Decodes a frame and calls visitor(message) with the concrete message type\n";
+    out << "template <typename Visitor> bool DecodeFrame(const uint8_t* data, size_t size, Visitor&& visitor) {\n";
+    out << "    FrameHeader header;\n";
+    out << "    if (!ReadFrameHeader(data, size, header)) return false;\n";
+    out << "    switch (header.message_type) {\n";
+    for (const auto& s : schema.structs) {
+        if (!s.is_message) continue;
+        out << "    case " << s.name << "::kType: {\n";
+        out << "        " << s.name << " message;\n";
+        out << "        if (!Decode(header, message)) return false;\n";
+        out << "        visitor(message);\n";
+        out << "        return true;\n";
+        out << "    }\n";
+    }
+    out << "    default:\n        return false;\n    }\n}\n\n}\n";
+    return out.str();
+}
+
+// ---------------------------------------------------------------------------
+// C# output
+// ---------------------------------------------------------------------------
+
+struct CsEmitter {
+    const Schema& schema;
+
+    std::string CsName(const TypeRef& type) const {
+        if (type.kind == TypeRef::Kind::Enum) return Global(schema.FindEnum(type.name)->cs_name);
+        return Global(schema.FindStruct(type.name)->cs_name);
+    }
+
+    std::string WireType(const TypeRef& type) const {
+        if (type.kind == TypeRef::Kind::Scalar && type.name == "f32") return "WireFormat.Fixed32";
+        if (type.kind == TypeRef::Kind::Scalar && type.name != "string" && type.name != "bytes") return "WireFormat.Varint";
+        if (type.kind == TypeRef::Kind::Enum) return "WireFormat.Varint";
+        return "WireFormat.LengthDelimited";
+    }
+
+    // Condition under which a singular field is written (empty = always)
+    std::string Present(const TypeRef& type, const std::string& expr) const {
+        if (type.kind == TypeRef::Kind::Enum) return "(int)" + expr + " != 0";
+        if (type.kind == TypeRef::Kind::Struct) return expr + " != null";
+        if (type.nullable) return type.name == "f32" ? expr + ".HasValue" : expr + " != null";
+        if (type.name == "string") return "!string.IsNullOrEmpty(" + expr + ")";
+        if (type.name == "bytes") return expr + " != null && " + expr + ".Length > 0";
+        if (type.name == "bool") return expr;
+        if (type.name == "f32") return expr + " != 0f";
+        return expr + " != 0";
+    }
+
+    std::string Value(const TypeRef& type, const std::string& expr) const {
+        return type.nullable && type.name == "f32" ? expr + ".Value" : expr;
+    }
+
+    std::string ValueSize(const TypeRef& type, const std::string& expr) const {
+        std::string v = Value(type, expr);
+        if (type.kind == TypeRef::Kind::Enum) return "WireFormat.SignedSize((int)" + v + ")";
+        if (type.kind == TypeRef::Kind::Struct) return "WireFormat.LengthPrefixedSize(SizeOf(" + v + ", version))";
+        if (type.name == "string") return "WireFormat.StringSize(" + v + ")";
+        if (type.name == "bytes") return "WireFormat.BytesSize(" + v + ")";
+        if (type.name == "bool") return "1";
+        if (type.name == "f32") return "4";
+        if (type.name == "i32" || type.name == "i64") return "WireFormat.SignedSize(" + v + ")";
+        return "WireFormat.VarintSize(" + v + ")";
+    }
+
+    std::string WriteValue(const TypeRef& type, const std::string& expr, const std::string& indent) const {
+        std::string v = Value(type, expr);
+        if (type.kind == TypeRef::Kind::Enum) return "writer.WriteSigned((int)" + v + ");";
+        if (type.kind == TypeRef::Kind::Struct) {
+            return "writer.WriteLength(SizeOf(" + v + ", version));\n" + indent + "Write(ref writer, " + v + ", version);";
+        }
+        if (type.name == "string") return "writer.WriteString(" + v + ");";
+        if (type.name == "bytes") return "writer.WriteBytes(" + v + ");";
+        if (type.name == "bool") return "writer.WriteVarint(" + v + " ? 1UL : 0UL);";
+        if (type.name == "f32") return "writer.WriteFloat(" + v + ");";
+        if (type.name == "i32" || type.name == "i64") return "writer.WriteSigned(" + v + ");";
+        return "writer.WriteVarint(" + v + ");";
+    }
+
+    std::string ReadValue(const TypeRef& type, const std::string& reader) const {
+        if (type.kind == TypeRef::Kind::Enum) return "(" + CsName(type) + ")(int)" + reader + ".ReadSigned()";
+        if (type.kind == TypeRef::Kind::Struct) return "Read" + type.name + "(" + reader + ".ReadLengthDelimited())";
+        if (type.name == "string") return reader + ".ReadString()";
+        if (type.name == "bytes") return reader + ".ReadBytes()";
+        if (type.name == "bool") return reader + ".ReadVarint() != 0";
+        if (type.name == "f32") return reader + ".ReadFloat()";
+        if (type.name == "i32") return "(int)" + reader + ".ReadSigned()";
+        if (type.name == "i64") return reader + ".ReadSigned()";
+        if (type.name == "u32") return "(uint)" + reader + ".ReadVarint()";
+        return reader + ".ReadVarint()";
+    }
+
+    std::string DefaultValue(const TypeRef& type) const {
+        if (type.kind == TypeRef::Kind::Struct) return "new()";
+        if (type.name == "string") return "string.Empty";
+        if (type.name == "bytes") return "Array.Empty<byte>()";
+        return "default";
+    }
+
+    // Map entries mirror MapEntry<V> in wire_codec.h: key = tag 1, value = tag 2
+    std::string EntrySize(const TypeRef& value_type) const {
+        std::string size = "(string.IsNullOrEmpty(entry.Key) ? 0 : 1 + WireFormat.StringSize(entry.Key))";
+        std::string present = Present(value_type, "entry.Value");
+        std::string value = "1 + " + ValueSize(value_type, "entry.Value");
+        return size + " + (" + present + " ? " + value + " : 0)";
+    }
+
+    void EmitSize(std::ostringstream& out, const StructDef& s) const {
+        out << "        internal static int SizeOf(" << Global(s.cs_name) << " m, int version)\n        {\n";
+        out << "            var size = 0;\n";
+        for (const auto& f : s.fields) {
+            std::string expr = "m." + PascalCase(f.name);
+            std::string indent = "            ";
+            if (f.since > 1) {
+                out << indent << "if (version >= " << f.since << ")\n" << indent << "{\n";
+                indent += "    ";
+            }
+            std::string key = "WireFormat.KeySize(" + std::to_string(f.tag) + ")";
+            if (f.type.kind == TypeRef::Kind::List) {
+                out << indent << "if (" << expr << " != null)\n" << indent << "{\n";
+                out << indent << "    foreach (var item in " << expr << ")\n";
+                out << indent << "        size += " << key << " + " << ValueSize(*f.type.element, "(item ?? " + DefaultValue(*f.type.element) + ")") << ";\n";
+                out << indent << "}\n";
+            } else if (f.type.kind == TypeRef::Kind::Map) {
+                out << indent << "if (" << expr << " != null)\n" << indent << "{\n";
+                out << indent << "    foreach (var entry in " << expr << ")\n";
+                out << indent << "        size += " << key << " + WireFormat.LengthPrefixedSize(" << EntrySize(*f.type.element) << ");\n";
+                out << indent << "}\n";
+            } else {
+                out << indent << "if (" << Present(f.type, expr) << ")\n";
+                out << indent << "    size += " << key << " + " << ValueSize(f.type, expr) << ";\n";
+            }
+            if (f.since > 1) out << "            }\n";
+        }
+        out << "            return size;\n        }\n\n";
+    }
+
+    void EmitWrite(std::ostringstream& out, const StructDef& s) const {
+        out << "        internal static void Write(ref WireWriter writer, " << Global(s.cs_name) << " m, int version)\n        {\n";
+        for (const auto& f : s.fields) {
+            std::string expr = "m." + PascalCase(f.name);
+            std::string indent = "            ";
+            if (f.since > 1) {
+                out << indent << "if (version >= " << f.since << ")\n" << indent << "{\n";
+                indent += "    ";
+            }
+            std::string tag = std::to_string(f.tag);
+            if (f.type.kind == TypeRef::Kind::List) {
+                const TypeRef& element = *f.type.element;
+                out << indent << "if (" << expr << " != null)\n" << indent << "{\n";
+                out << indent << "    foreach (var listItem in " << expr << ")\n" << indent << "    {\n";
+                out << indent << "        var item = listItem ?? " << DefaultValue(element) << ";\n";
+                out << indent << "        writer.WriteKey(" << tag << ", " << WireType(element) << ");\n";
+                out << indent << "        " << WriteValue(element, "item", indent + "        ") << "\n";
+                out << indent << "    }\n" << indent << "}\n";
+            } else if (f.type.kind == TypeRef::Kind::Map) {
+                const TypeRef& value = *f.type.element;
+                out << indent << "if (" << expr << " != null)\n" << indent << "{\n";
+                out << indent << "    foreach (var entry in " << expr << ")\n" << indent << "    {\n";
+                out << indent << "        writer.WriteKey(" << tag << ", WireFormat.LengthDelimited);\n";
+                out << indent << "        writer.WriteLength(" << EntrySize(value) << ");\n";
+                out << indent << "        if (!string.IsNullOrEmpty(entry.Key))\n" << indent << "        {\n";
+                out << indent << "            writer.WriteKey(1, WireFormat.LengthDelimited);\n";
+                out << indent << "            writer.WriteString(entry.Key);\n";
+                out << indent << "        }\n";
+                out << indent << "        if (" << Present(value, "entry.Value") << ")\n" << indent << "        {\n";
+                out << indent << "            writer.WriteKey(2, " << WireType(value) << ");\n";
+                out << indent << "            " << WriteValue(value, "entry.Value", indent + "            ") << "\n";
+                out << indent << "        }\n";
+                out << indent << "    }\n" << indent << "}\n";
+            } else {
+                out << indent << "if (" << Present(f.type, expr) << ")\n" << indent << "{\n";
+                out << indent << "    writer.WriteKey(" << tag << ", " << WireType(f.type) << ");\n";
+                out << indent << "    " << WriteValue(f.type, expr, indent + "    ") << "\n";
+                out << indent << "}\n";
+            }
+            if (f.since > 1) out << "            }\n";
+        }
+        out << "        }\n\n";
+    }
+
+    void EmitRead(std::ostringstream& out, const StructDef& s) const {
+        out << "        internal static " << Global(s.cs_name) << " Read" << s.name << "(ReadOnlySpan<byte> data)\n        {\n";
+        out << "            var m = new " << Global(s.cs_name) << "();\n";
+        out << "            var reader = new WireReader(data);\n";
+        out << "            while (reader.TryReadKey(out var tag, out var wireType))\n            {\n";
+        out << "                switch (tag)\n                {\n";
+        for (const auto& f : s.fields) {
+            std::string expr = "m." + PascalCase(f.name);
+            const TypeRef& element = f.type.element ? *f.type.element : f.type;
+            std::string wire = f.type.kind == TypeRef::Kind::Map ? "WireFormat.LengthDelimited" : WireType(element);
+            out << "                    case " << f.tag << " when wireType == " << wire << ":\n";
+            if (f.type.kind == TypeRef::Kind::List) {
+                out << "                        " << expr << ".Add(" << ReadValue(element, "reader") << ");\n";
+            } else if (f.type.kind == TypeRef::Kind::Map) {
+                out << "                    {\n";
+                out << "                        var entryReader = new WireReader(reader.ReadLengthDelimited());\n";
+                out << "                        var key = string.Empty;\n";
+                out << "                        " << (element.kind == TypeRef::Kind::Struct ? CsName(element) : "var")
+                    << " value = " << DefaultValue(element) << ";\n";
+                out << "                        while (entryReader.TryReadKey(out var entryTag, out var entryWireType))\n";
+                out << "                        {\n";
+                out << "                            if (entryTag == 1 && entryWireType == WireFormat.LengthDelimited)\n";
+                out << "                                key = entryReader.ReadString();\n";
+                out << "                            else if (entryTag == 2 && entryWireType == " << WireType(element) << ")\n";
+                out << "                                value = " << ReadValue(element, "entryReader") << ";\n";
+                out << "                            else\n";
+                out << "                                entryReader.Skip(entryWireType);\n";
+                out << "                        }\n";
+                out << "                        " << expr << "[key] = value;\n";
+                out << "                        break;\n";
+                out << "                    }\n";
+                continue;
+            } else {
+                out << "                        " << expr << " = " << ReadValue(f.type, "reader") << ";\n";
+            }
+            out << "                        break;\n";
+        }
+        out << "                    default:\n";
+        out << "                        reader.Skip(wireType);\n";
+        out << "                        break;\n";
+        out << "                }\n            }\n";
+        out << "            return m;\n        }\n\n";
+    }
+};
+
+std::string GenerateCs(const Schema& schema, const std::string& source_name) {
+    CsEmitter emitter{schema};
+    std::ostringstream out;
+    out << "// <auto-generated>\n";
+    out << "//     Generated by native/tools/schema_codegen from " << source_name << ".\n";
+    out << "//     Do not edit by hand - change the schema and build the generate_wire_codec target.\n";
+    out << "// </auto-generated>\n";
+    out << "#nullable enable\n";
+    out << "using System;\n";
+    out << "using System.Collections.Generic;\n\n";
+    out << "namespace " << schema.cs_namespace << "\n{\n";
+    out << "    /// <summary>\n";
+    out << "    /// Schema-generated binary codec for P2P messages, byte-compatible with native/generated/p2p_messages.h\n";
+    out << "    /// </summary>\n";
+    out << "    public static partial class P2PWireCodec\n    {\n";
+    out << "        public const int SchemaVersion = " << schema.version << ";\n\n";
+
+    out << "        /// <summary>\n";
+    out << "        /// Serialize a message as a schema frame for a peer on the given schema version\n";
+    out << "        /// </summary>\n";
+    out << "        public static byte[]? Serialize(P2PModMessage message, int version = SchemaVersion)\n        {\n";
+    out << "            switch (message)\n            {\n";
+    for (const auto& s : schema.structs) {
+        if (!s.is_message) continue;
+        out << "                case " << Global(s.cs_name) << " m:\n                {\n";
+        out << "                    var buffer = new byte[WireFormat.FrameHeaderSize(" << s.message_id << ") + SizeOf(m, version)];\n";
+        out << "                    var writer = new WireWriter(buffer);\n";
+        out << "                    writer.WriteFrameHeader(version, " << s.message_id << ");\n";
+        out << "                    Write(ref writer, m, version);\n";
+        out << "                    return buffer;\n";
+        out << "                }\n";
+    }
+    out << "                default:\n                    return null;\n            }\n        }\n\n";
+
+    out << "        /// <summary>\n";
+    out << "        /// Deserialize a schema frame; unknown fields from newer peers are skipped\n";
+    out << "        /// </summary>\n";
+    out << "        public static P2PModMessage? Deserialize(ReadOnlySpan<byte> data)\n        {\n";
+    out << "            if (!WireFormat.TryReadFrameHeader(data, out _, out var messageType, out var body))\n";
+    out << "                return null;\n\n";
+    out << "            return messageType switch\n            {\n";
+    for (const auto& s : schema.structs) {
+        if (!s.is_message) continue;
+        out << "                " << s.message_id << " => Read" << s.name << "(body),\n";
+    }
+    out << "                _ => null\n            };\n        }\n\n";
+
+    for (const auto& s : schema.structs) {
+        if (s.base_only) continue;
+        emitter.EmitSize(out, s);
+        emitter.EmitWrite(out, s);
+        emitter.EmitRead(out, s);
+    }
+
+    std::string text = out.str();
+    text.erase(text.size() - 1); // trailing blank line inside the class
+    text += "    }\n}\n";
+    return text;
+}
+
+bool WriteIfChanged(const std::string& path, const std::string& content) {
+    std::ifstream existing(path, std::ios::binary);
+    if (existing) {
+        std::stringstream current;
+        current << existing.rdbuf();
+        if (current.str() == content) return true;
+    }
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    stream << content;
+    return static_cast<bool>(stream);
+}
+
+std::string BaseName(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    size_t parent = slash == std::string::npos ? std::string::npos : path.find_last_of("/\\", slash - 1);
+    return parent == std::string::npos ? path : path.substr(parent + 1);
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc != 4) {
+        fprintf(stderr, "usage: schema_codegen <input.schema> <output.h> <output.cs>\n");
+        return 2;
+    }
+
+    std::ifstream input(argv[1], std::ios::binary);
+    if (!input) {
+        fprintf(stderr, "schema_codegen: cannot open %s\n", argv[1]);
+        return 1;
+    }
+    std::stringstream text;
+    text << input.rdbuf();
+
+    Schema schema;
+    Parser parser(argv[1], text.str());
+    if (!parser.Parse(schema)) return 1;
+
+    std::string source_name = BaseName(argv[1]);
+    for (char& c : source_name) {
+        if (c == '\\') c = '/';
+    }
+    if (!WriteIfChanged(argv[2], GenerateCpp(schema, source_name)) ||
+        !WriteIfChanged(argv[3], GenerateCs(schema, source_name))) {
+        fprintf(stderr, "schema_codegen: failed to write output\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,283 @@
+#include "upload_admission.h"
+#include <algorithm>
+
+namespace fyteclub {
+
+namespace {
+
+constexpr double kThroughputWeight = 0.25; // weight of the newest sample
+constexpr uint32_t kMaxWaitMs = 10 * 60 * 1000;
+
+}
+
+UploadAdmission::UploadAdmission(const UploadAdmissionConfig& config) : config_(config) {
+    config_.max_active = std::max<uint32_t>(config_.max_active, 1);
+}
+
+uint32_t UploadAdmission::ActiveLimitLocked() const {
+    return pressure_ ? std::max<uint32_t>(config_.max_active / 2, 1) : config_.max_active;
+}
+
+uint32_t UploadAdmission::QueueLimitLocked() const {
+    return pressure_ ? std::min(config_.max_queue, config_.max_active) : config_.max_queue;
+}
+
+uint32_t UploadAdmission::EstimateWaitLocked(size_t queue_ahead, uint64_t now_ms) const {
+    // Bytes still to go on the running uploads plus everything queued ahead,
+    // drained by every slot at the measured per-upload rate
+    double bytes = 0;
+    for (const auto& [ticket, upload] : uploads_) {
+        if (!upload.active) continue;
+        double done = bytes_per_ms_ * static_cast<double>(now_ms > upload.started_ms ? now_ms - upload.started_ms : 0);
+        bytes += std::max(0.0, static_cast<double>(upload.estimated_bytes) - done);
+    }
+    for (size_t i = 0; i < queue_ahead && i < queue_.size(); ++i) {
+        bytes += static_cast<double>(uploads_.at(queue_[i]).estimated_bytes);
+    }
+    double wait = bytes / (bytes_per_ms_ * ActiveLimitLocked());
+    return static_cast<uint32_t>(std::min<double>(wait, kMaxWaitMs));
+}
+
+bool UploadAdmission::KeyServedElsewhereLocked(uint64_t peer, uint64_t content_key) const {
+    return std::any_of(uploads_.begin(), uploads_.end(), [&](const auto& entry) {
+        return entry.second.content_key == content_key && entry.second.peer != peer;
+    });
+}
+
+AdmissionDecision UploadAdmission::Request(uint64_t peer, uint64_t content_key, uint64_t estimated_bytes,
+                                           uint64_t now_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    AdmissionDecision decision;
+
+    // A few dozen uploads at most, so a scan is cheaper than a second index
+    for (auto& [ticket, upload] : uploads_) {
+        if (upload.peer != peer) continue;
+        if (upload.active && upload.content_key != content_key) continue; // new state queues behind it
+
+        auto position = std::find(queue_.begin(), queue_.end(), ticket);
+        size_t ahead = static_cast<size_t>(position - queue_.begin());
+        decision.ticket = ticket;
+        decision.position = upload.active ? 0 : static_cast<uint32_t>(ahead + 1);
+        decision.wait_ms = upload.active ? 0 : EstimateWaitLocked(ahead, now_ms);
+        if (upload.content_key == content_key) {
+            decision.result = AdmissionResult::Duplicate;
+        } else {
+            // Newer state for a queued request: send that instead, keeping its place
+            upload.content_key = content_key;
+            upload.estimated_bytes = estimated_bytes;
+            decision.result = AdmissionResult::Queued;
+        }
+        return decision;
+    }
+
+    if (pressure_ && KeyServedElsewhereLocked(peer, content_key)) {
+        decision.reason = ShedReason::Redundant;
+        decision.wait_ms = EstimateWaitLocked(queue_.size(), now_ms);
+        return decision;
+    }
+
+    if (active_ < ActiveLimitLocked() && queue_.empty()) {
+        uint64_t ticket = next_ticket_++;
+        uploads_.emplace(ticket, Upload{peer, content_key, estimated_bytes, now_ms, true});
+        ++active_;
+        decision.result = AdmissionResult::Admitted;
+        decision.ticket = ticket;
+        return decision;
+    }
+
+    if (queue_.size() >= QueueLimitLocked()) {
+        decision.reason = ShedReason::QueueFull;
+        decision.wait_ms = EstimateWaitLocked(queue_.size(), now_ms);
+        return decision;
+    }
+
+    uint64_t ticket = next_ticket_++;
+    decision.wait_ms = EstimateWaitLocked(queue_.size(), now_ms);
+    uploads_.emplace(ticket, Upload{peer, content_key, estimated_bytes, 0, false});
+    queue_.push_back(ticket);
+    decision.result = AdmissionResult::Queued;
+    decision.ticket = ticket;
+    decision.position = static_cast<uint32_t>(queue_.size());
+    return decision;
+}
+
+void UploadAdmission::Complete(uint64_t ticket, uint64_t bytes_sent, uint64_t now_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = uploads_.find(ticket);
+    if (it == uploads_.end() || !it->second.active) return;
+
+    uint64_t elapsed = now_ms > it->second.started_ms ? now_ms - it->second.started_ms : 0;
+    // Tiny uploads finish inside one tick and say nothing about the link
+    if (elapsed > 0 && bytes_sent >= 64 * 1024) {
+        double sample = static_cast<double>(bytes_sent) / static_cast<double>(elapsed);
+        bytes_per_ms_ += kThroughputWeight * (sample - bytes_per_ms_);
+    }
+    uploads_.erase(it);
+    --active_;
+    PromoteLocked(now_ms);
+}
+
+bool UploadAdmission::Cancel(uint64_t ticket, uint64_t now_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = uploads_.find(ticket);
+    if (it == uploads_.end()) return false;
+    if (it->second.active) {
+        --active_;
+    } else {
+        queue_.erase(std::find(queue_.begin(), queue_.end(), ticket));
+    }
+    uploads_.erase(it);
+    PromoteLocked(now_ms);
+    return true;
+}
+
+void UploadAdmission::PromoteLocked(uint64_t now_ms) {
+    while (active_ < ActiveLimitLocked() && !queue_.empty()) {
+        uint64_t ticket = queue_.front();
+        queue_.pop_front();
+        Upload& upload = uploads_.at(ticket);
+        upload.active = true;
+        upload.started_ms = now_ms;
+        ++active_;
+        admitted_.push_back(ticket);
+    }
+}
+
+bool UploadAdmission::PopAdmitted(uint64_t& ticket) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Skip tickets cancelled before the plugin picked them up
+    while (!admitted_.empty()) {
+        ticket = admitted_.front();
+        admitted_.pop_front();
+        if (uploads_.count(ticket)) return true;
+    }
+    return false;
+}
+
+void UploadAdmission::ReportLoad(uint64_t memory_bytes, uint32_t cpu_percent) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const bool memory_over = config_.memory_limit_bytes && memory_bytes > config_.memory_limit_bytes;
+    const bool cpu_over = config_.cpu_limit_percent && cpu_percent > config_.cpu_limit_percent;
+    const bool memory_clear = !config_.memory_limit_bytes || memory_bytes < config_.memory_limit_bytes / 10 * 9;
+    const bool cpu_clear = !config_.cpu_limit_percent || cpu_percent < config_.cpu_limit_percent * 9 / 10;
+
+    // Running uploads are left to finish; pressure only holds back new ones
+    if (memory_over || cpu_over) {
+        pressure_ = true;
+    } else if (memory_clear && cpu_clear) {
+        pressure_ = false;
+    }
+}
+
+void UploadAdmission::SetLimits(uint32_t max_active, uint32_t max_queue) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_.max_active = std::max<uint32_t>(max_active, 1);
+    config_.max_queue = max_queue;
+}
+
+bool UploadAdmission::UnderPressure() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pressure_;
+}
+
+size_t UploadAdmission::ActiveCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return active_;
+}
+
+size_t UploadAdmission::QueuedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+uint64_t UploadAdmission::ThroughputBytesPerSecond() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<uint64_t>(bytes_per_ms_ * 1000.0 * ActiveLimitLocked());
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// C exports for the plugin
+// ---------------------------------------------------------------------------
+
+extern "C" {
+
+struct UploadAdmissionDecision {
+    int result;       // AdmissionResult
+    int reason;       // ShedReason
+    uint64_t ticket;
+    uint32_t position;
+    uint32_t wait_ms;
+};
+
+// memory_limit_mb / cpu_limit_percent of 0 disable that check
+__declspec(dllexport) void* CreateUploadAdmission(int max_active, int max_queue, int memory_limit_mb,
+                                                  int cpu_limit_percent) {
+    fyteclub::UploadAdmissionConfig config;
+    if (max_active > 0) config.max_active = static_cast<uint32_t>(max_active);
+    if (max_queue >= 0) config.max_queue = static_cast<uint32_t>(max_queue);
+    if (memory_limit_mb > 0) config.memory_limit_bytes = static_cast<uint64_t>(memory_limit_mb) * 1024 * 1024;
+    if (cpu_limit_percent > 0) config.cpu_limit_percent = static_cast<uint32_t>(cpu_limit_percent);
+    return new fyteclub::UploadAdmission(config);
+}
+
+// Returns the AdmissionResult and fills out, or -1 for bad arguments
+__declspec(dllexport) int UploadAdmissionRequest(void* admission, uint64_t peer, uint64_t content_key,
+                                                 uint64_t estimated_bytes, uint64_t now_ms,
+                                                 UploadAdmissionDecision* out) {
+    if (!admission || !out) return -1;
+    auto decision =
+        static_cast<fyteclub::UploadAdmission*>(admission)->Request(peer, content_key, estimated_bytes, now_ms);
+    out->result = static_cast<int>(decision.result);
+    out->reason = static_cast<int>(decision.reason);
+    out->ticket = decision.ticket;
+    out->position = decision.position;
+    out->wait_ms = decision.wait_ms;
+    return out->result;
+}
+
+__declspec(dllexport) void UploadAdmissionComplete(void* admission, uint64_t ticket, uint64_t bytes_sent,
+                                                   uint64_t now_ms) {
+    if (admission) static_cast<fyteclub::UploadAdmission*>(admission)->Complete(ticket, bytes_sent, now_ms);
+}
+
+__declspec(dllexport) int UploadAdmissionCancel(void* admission, uint64_t ticket, uint64_t now_ms) {
+    return admission && static_cast<fyteclub::UploadAdmission*>(admission)->Cancel(ticket, now_ms) ? 1 : 0;
+}
+
+// Returns 1 and fills ticket when a queued upload may start, 0 when none
+__declspec(dllexport) int UploadAdmissionPopAdmitted(void* admission, uint64_t* ticket) {
+    if (!admission || !ticket) return 0;
+    return static_cast<fyteclub::UploadAdmission*>(admission)->PopAdmitted(*ticket) ? 1 : 0;
+}
+
+__declspec(dllexport) void UploadAdmissionReportLoad(void* admission, uint64_t memory_bytes, int cpu_percent) {
+    if (!admission) return;
+    static_cast<fyteclub::UploadAdmission*>(admission)->ReportLoad(
+        memory_bytes, cpu_percent > 0 ? static_cast<uint32_t>(cpu_percent) : 0);
+}
+
+__declspec(dllexport) void UploadAdmissionSetLimits(void* admission, int max_active, int max_queue) {
+    if (!admission || max_active <= 0 || max_queue < 0) return;
+    static_cast<fyteclub::UploadAdmission*>(admission)->SetLimits(static_cast<uint32_t>(max_active),
+                                                                  static_cast<uint32_t>(max_queue));
+}
+
+__declspec(dllexport) int UploadAdmissionUnderPressure(void* admission) {
+    return admission && static_cast<fyteclub::UploadAdmission*>(admission)->UnderPressure() ? 1 : 0;
+}
+
+__declspec(dllexport) int UploadAdmissionActiveCount(void* admission) {
+    return admission ? static_cast<int>(static_cast<fyteclub::UploadAdmission*>(admission)->ActiveCount()) : 0;
+}
+
+__declspec(dllexport) int UploadAdmissionQueuedCount(void* admission) {
+    return admission ? static_cast<int>(static_cast<fyteclub::UploadAdmission*>(admission)->QueuedCount()) : 0;
+}
+
+__declspec(dllexport) void DestroyUploadAdmission(void* admission) {
+    delete static_cast<fyteclub::UploadAdmission*>(admission);
+}
+
+}
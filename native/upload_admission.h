@@ -0,0 +1,106 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+// Admission control for outgoing mod uploads. When a popular player walks
+// into a venue every nearby member sends ModDataRequest at once and each one
+// starts its own SyncModsToPeer, so the sender's game stutters under dozens
+// of concurrent uploads. Here a request first asks for a slot:
+//
+//   - at most max_active uploads run; the rest wait in a FIFO queue
+//   - a queued request gets its position and an estimated wait, from the
+//     measured upload throughput, so the requester can go to a swarm source
+//     instead of waiting
+//   - a repeat request from the same peer for the same state is folded into
+//     the one already admitted or queued; a newer state replaces a queued one
+//   - while memory or CPU is over its limit the pressure mode halves the
+//     active slots, shortens the queue and sheds requests for content that is
+//     already being uploaded to another peer, since that peer can serve it
+//
+// Content keys are the plugin's hash of the state being sent (e.g. the
+// appearance hash), peers are the plugin's peer handles. Thread-safe.
+
+namespace fyteclub {
+
+struct UploadAdmissionConfig {
+    uint32_t max_active = 3;
+    uint32_t max_queue = 32;
+    uint64_t memory_limit_bytes = 0; // 0 = not checked
+    uint32_t cpu_limit_percent = 0;  // 0 = not checked
+};
+
+enum class AdmissionResult {
+    Admitted = 0,  // start uploading now
+    Queued = 1,    // wait for PopAdmitted; see position and wait_ms
+    Duplicate = 2, // this peer already has this state admitted or queued
+    Shed = 3,      // refused; retry after wait_ms or use a swarm source
+};
+
+enum class ShedReason {
+    None = 0,
+    QueueFull = 1,
+    Redundant = 2, // under pressure and another peer is already receiving it
+};
+
+struct AdmissionDecision {
+    AdmissionResult result = AdmissionResult::Shed;
+    ShedReason reason = ShedReason::None;
+    uint64_t ticket = 0;
+    uint32_t position = 0; // 1-based queue position when queued
+    uint32_t wait_ms = 0;  // estimated time until a slot opens
+};
+
+class UploadAdmission {
+public:
+    explicit UploadAdmission(const UploadAdmissionConfig& config = {});
+
+    AdmissionDecision Request(uint64_t peer, uint64_t content_key, uint64_t estimated_bytes, uint64_t now_ms);
+    // Frees the slot; bytes_sent feeds the throughput estimate
+    void Complete(uint64_t ticket, uint64_t bytes_sent, uint64_t now_ms);
+    // Drops a queued or active ticket without touching the estimate
+    bool Cancel(uint64_t ticket, uint64_t now_ms);
+    // Tickets promoted from the queue, in order, for the plugin to start
+    bool PopAdmitted(uint64_t& ticket);
+
+    // Latest process memory and CPU use. Pressure starts when either is over
+    // its limit and ends once both are back under 90% of it.
+    void ReportLoad(uint64_t memory_bytes, uint32_t cpu_percent);
+    // Takes effect as running uploads finish
+    void SetLimits(uint32_t max_active, uint32_t max_queue);
+    bool UnderPressure() const;
+
+    size_t ActiveCount() const;
+    size_t QueuedCount() const;
+    // Aggregate bytes per second the estimate is using
+    uint64_t ThroughputBytesPerSecond() const;
+
+private:
+    struct Upload {
+        uint64_t peer = 0;
+        uint64_t content_key = 0;
+        uint64_t estimated_bytes = 0;
+        uint64_t started_ms = 0; // active only
+        bool active = false;
+    };
+
+    uint32_t ActiveLimitLocked() const;
+    uint32_t QueueLimitLocked() const;
+    uint32_t EstimateWaitLocked(size_t queue_ahead, uint64_t now_ms) const;
+    bool KeyServedElsewhereLocked(uint64_t peer, uint64_t content_key) const;
+    void PromoteLocked(uint64_t now_ms);
+
+    mutable std::mutex mutex_;
+    UploadAdmissionConfig config_;
+    bool pressure_ = false;
+    uint64_t next_ticket_ = 1;
+    std::unordered_map<uint64_t, Upload> uploads_; // ticket -> upload
+    std::deque<uint64_t> queue_;                   // queued tickets, oldest first
+    size_t active_ = 0;
+    double bytes_per_ms_ = 1024.0; // per upload, EWMA; starts at ~1 MB/s
+    std::deque<uint64_t> admitted_;
+};
+
+}
@@ -1,14 +1,18 @@
 #ifdef USE_LIBDATACHANNEL
 // libdatachannel implementation for MSVC compatibility
 #include <rtc/rtc.hpp>
+#include "ice_servers.h"
 #include <memory>
 #include <string>
+#include <vector>
 
 extern "C" {
 
 struct WebRTCPeer {
     std::shared_ptr<rtc::PeerConnection> pc;
     std::shared_ptr<rtc::DataChannel> dc;
+    std::vector<std::shared_ptr<rtc::DataChannel>> bulk_channels;
+    std::vector<fyteclub::IceServerEntry> ice_servers;
     bool initialized = false;
 };
 
@@ -21,6 +25,13 @@ __declspec(dllexport) int InitializePeerConnection(WebRTCPeer* peer, const char*
     
     rtc::Configuration config;
     config.iceServers.emplace_back(stun_server);
+    // TURN relays from AddIceServer are offered alongside STUN from the start
+    for (const auto& entry : peer->ice_servers) {
+        rtc::IceServer server(entry.uri);
+        server.username = entry.username;
+        server.password = entry.password;
+        config.iceServers.push_back(server);
+    }
     
     peer->pc = std::make_shared<rtc::PeerConnection>(config);
     peer->initialized = true;
@@ -34,6 +45,32 @@ __declspec(dllexport) void* CreateDataChannel(WebRTCPeer* peer, const char* labe
     return peer->dc.get();
 }
 
+// Extra STUN/TURN server (see ice_servers.h). Must precede InitializePeerConnection.
+__declspec(dllexport) int AddIceServer(WebRTCPeer* peer, const char* uri, const char* username, const char* password) {
+    if (!peer || peer->initialized || !uri) return -1;
+    try {
+        rtc::IceServer validated(uri);
+    } catch (const std::exception&) {
+        return -1;
+    }
+    peer->ice_servers.push_back({uri, username ? username : "", password ? password : ""});
+    return 0;
+}
+
+// Bulk channels for FEC-protected transfers: unordered and/or partially
+// reliable. max_retransmits < 0 keeps full reliability.
+__declspec(dllexport) void* CreateBulkDataChannel(WebRTCPeer* peer, const char* label, int ordered, int max_retransmits) {
+    if (!peer || !peer->initialized || !peer->pc) return nullptr;
+
+    rtc::DataChannelInit init;
+    init.reliability.unordered = ordered == 0;
+    if (max_retransmits >= 0) init.reliability.maxRetransmits = static_cast<unsigned int>(max_retransmits);
+
+    auto channel = peer->pc->createDataChannel(label, init);
+    peer->bulk_channels.push_back(channel);
+    return channel.get();
+}
+
 __declspec(dllexport) int CreateOffer(WebRTCPeer* peer) {
     if (!peer || !peer->pc) return -1;
     
@@ -56,6 +93,7 @@ __declspec(dllexport) int SendData(void* data_channel, const uint8_t* data, int
 
 __declspec(dllexport) void DestroyPeerConnection(WebRTCPeer* peer) {
     if (peer) {
+        peer->bulk_channels.clear();
         peer->dc.reset();
         peer->pc.reset();
         delete peer;
@@ -66,11 +104,14 @@ __declspec(dllexport) void DestroyPeerConnection(WebRTCPeer* peer) {
 
 #else
 // Mock implementation for testing
+#include "ice_servers.h"
 #include <cstdint>
+#include <vector>
 
 extern "C" {
 
 struct WebRTCPeer {
+    std::vector<fyteclub::IceServerEntry> ice_servers;
     bool initialized = false;
     bool connected = false;
 };
@@ -91,6 +132,18 @@ __declspec(dllexport) void* CreateDataChannel(WebRTCPeer* peer, const char* labe
     return (void*)0x12345678;
 }
 
+__declspec(dllexport) int AddIceServer(WebRTCPeer* peer, const char* uri, const char* username, const char* password) {
+    if (!peer || peer->initialized || !uri) return -1;
+    peer->ice_servers.push_back({uri, username ? username : "", password ? password : ""});
+    return 0;
+}
+
+__declspec(dllexport) void* CreateBulkDataChannel(WebRTCPeer* peer, const char* /*label*/, int /*ordered*/,
+                                                  int /*max_retransmits*/) {
+    if (!peer || !peer->initialized) return nullptr;
+    return (void*)0x12345679;
+}
+
 __declspec(dllexport) int CreateOffer(WebRTCPeer* peer) {
     return peer && peer->initialized ? 0 : -1;
 }
@@ -113,12 +166,14 @@ __declspec(dllexport) void DestroyPeerConnection(WebRTCPeer* peer) {
 #define WIN32_LEAN_AND_MEAN
 #include <memory>
 #include <string>
+#include <vector>
 #include "../webrtc-checkout/src/api/peer_connection_interface.h"
 #include "../webrtc-checkout/src/api/create_peerconnection_factory.h"
 #include "../webrtc-checkout/src/api/data_channel_interface.h"
 #include "../webrtc-checkout/src/rtc_base/ref_counted_object.h"
 #include "../webrtc-checkout/src/rtc_base/copy_on_write_buffer.h"
 #include "../webrtc-checkout/src/api/scoped_refptr.h"
+#include "ice_servers.h"
 
 using namespace webrtc;
 
@@ -128,6 +183,8 @@ struct WebRTCPeer {
     webrtc::scoped_refptr<PeerConnectionFactoryInterface> factory;
     webrtc::scoped_refptr<PeerConnectionInterface> peer_connection;
     webrtc::scoped_refptr<DataChannelInterface> data_channel;
+    std::vector<webrtc::scoped_refptr<DataChannelInterface>> bulk_channels;
+    std::vector<fyteclub::IceServerEntry> ice_servers;
 };
 
 __declspec(dllexport) WebRTCPeer* CreatePeerConnection() {
@@ -144,6 +201,13 @@ __declspec(dllexport) int InitializePeerConnection(WebRTCPeer* peer, const char*
     PeerConnectionInterface::IceServer server;
     server.uri = stun_server;
     config.servers.push_back(server);
+    for (const auto& entry : peer->ice_servers) {
+        PeerConnectionInterface::IceServer extra;
+        extra.uri = entry.uri;
+        extra.username = entry.username;
+        extra.password = entry.password;
+        config.servers.push_back(extra);
+    }
     
     PeerConnectionDependencies dependencies(nullptr);
     auto result = peer->factory->CreatePeerConnectionOrError(config, std::move(dependencies));
@@ -168,6 +232,27 @@ __declspec(dllexport) void* CreateDataChannel(WebRTCPeer* peer, const char* labe
     return nullptr;
 }
 
+__declspec(dllexport) int AddIceServer(WebRTCPeer* peer, const char* uri, const char* username, const char* password) {
+    if (!peer || peer->peer_connection || !uri) return -1;
+    peer->ice_servers.push_back({uri, username ? username : "", password ? password : ""});
+    return 0;
+}
+
+__declspec(dllexport) void* CreateBulkDataChannel(WebRTCPeer* peer, const char* label, int ordered, int max_retransmits) {
+    if (!peer || !peer->peer_connection) return nullptr;
+
+    DataChannelInit config;
+    config.ordered = ordered != 0;
+    if (max_retransmits >= 0) config.maxRetransmits = max_retransmits;
+
+    auto result = peer->peer_connection->CreateDataChannelOrError(label, &config);
+    if (result.ok()) {
+        peer->bulk_channels.push_back(result.value());
+        return peer->bulk_channels.back().get();
+    }
+    return nullptr;
+}
+
 __declspec(dllexport) int CreateOffer(WebRTCPeer* peer) {
     if (!peer || !peer->peer_connection) return -1;
     
@@ -185,6 +270,7 @@ __declspec(dllexport) int SendData(void* data_channel, const uint8_t* data, int
 
 __declspec(dllexport) void DestroyPeerConnection(WebRTCPeer* peer) {
     if (peer) {
+        peer->bulk_channels.clear();
         peer->data_channel = nullptr;
         peer->peer_connection = nullptr;
         peer->factory = nullptr;
@@ -0,0 +1,477 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+// Tag/length wire format for schema-generated messages (see
+// schema/p2p_messages.schema and generated/p2p_messages.h). The C# side is
+// WireCodec.cs + Generated/P2PWireCodec.g.cs and produces identical bytes.
+//
+// Frame:  0x02 | schema version | varint message type | body
+// Body:   repeated (varint key = tag << 3 | wire type, value)
+//
+// Wire types follow protobuf numbering so unknown fields from newer schema
+// versions can always be skipped. Integers are zigzag varints, f32 is 4 bytes
+// little endian, strings/bytes/nested messages/map entries are length
+// delimited. Zero scalars, empty strings and empty bytes are not written;
+// nullable fields are written whenever they hold a value.
+//
+// Field tables are constexpr tuples, so Encode/Decode expand into straight-line
+// code per message type with no virtual dispatch. Decoding does not allocate:
+// strings and bytes are views into the input buffer and repeated fields are
+// lazily iterated views, so the input must outlive the decoded message.
+//
+// The plugin decodes these frames but still sends JSON: there is no
+// capability exchange yet to tell whether a peer can read them.
+
+namespace fyteclub::wire {
+
+constexpr uint8_t kFrameFlag = 0x02; // 0/1 are the JSON framing flags in SerializeMessage
+
+enum WireType : uint8_t {
+    kVarint = 0,
+    kLengthDelimited = 2,
+    kFixed32 = 5,
+};
+
+struct Bytes {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+};
+
+template <auto Member, uint32_t Tag, uint32_t Since = 1>
+struct Field {
+    static constexpr auto kMember = Member;
+    static constexpr uint32_t kTag = Tag;
+    static constexpr uint32_t kSince = Since;
+    std::string_view name;
+};
+
+// Specialized by the generated header with the constexpr field table
+template <typename T> struct MessageSchema;
+
+template <typename T, typename = void> struct IsMessage : std::false_type {};
+template <typename T> struct IsMessage<T, std::void_t<decltype(MessageSchema<T>::kFields)>> : std::true_type {};
+
+template <typename V> struct MapEntry {
+    std::string_view key;
+    V value{};
+};
+
+template <typename V> struct MessageSchema<MapEntry<V>> {
+    static constexpr auto kFields = std::make_tuple(Field<&MapEntry<V>::key, 1>{"key"},
+                                                    Field<&MapEntry<V>::value, 2>{"value"});
+};
+
+// ---------------------------------------------------------------------------
+// Primitive encoding
+// ---------------------------------------------------------------------------
+
+inline size_t VarintSize(uint64_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+inline uint8_t* WriteVarint(uint8_t* out, uint64_t value) {
+    while (value >= 0x80) {
+        *out++ = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = static_cast<uint8_t>(value);
+    return out;
+}
+
+inline bool ReadVarint(const uint8_t*& p, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        uint8_t byte = *p++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+inline uint64_t ZigZag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t UnZigZag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+inline bool SkipValue(uint8_t wire_type, const uint8_t*& p, const uint8_t* end) {
+    uint64_t value;
+    switch (wire_type) {
+    case kVarint:
+        return ReadVarint(p, end, value);
+    case kFixed32:
+        if (end - p < 4) return false;
+        p += 4;
+        return true;
+    case kLengthDelimited:
+        if (!ReadVarint(p, end, value) || value > static_cast<uint64_t>(end - p)) return false;
+        p += value;
+        return true;
+    default:
+        return false;
+    }
+}
+
+template <typename T> class List;
+
+template <typename T> struct IsList : std::false_type {};
+template <typename T> struct IsList<List<T>> : std::true_type {};
+
+// Per-type value traits: wire type, presence, size and read/write
+template <typename T, typename = void> struct ValueCodec;
+
+template <typename T>
+struct ValueCodec<T, std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>>> {
+    static constexpr uint8_t kWireType = kVarint;
+
+    static uint64_t Raw(T value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            return value ? 1 : 0;
+        } else if constexpr (std::is_enum_v<T>) {
+            return ZigZag(static_cast<int64_t>(value));
+        } else if constexpr (std::is_signed_v<T>) {
+            return ZigZag(static_cast<int64_t>(value));
+        } else {
+            return static_cast<uint64_t>(value);
+        }
+    }
+
+    static bool Present(T value) { return value != T{}; }
+    static size_t Size(T value) { return VarintSize(Raw(value)); }
+    static uint8_t* Write(uint8_t* out, T value) { return WriteVarint(out, Raw(value)); }
+
+    static bool Read(const uint8_t*& p, const uint8_t* end, T& value) {
+        uint64_t raw;
+        if (!ReadVarint(p, end, raw)) return false;
+        if constexpr (std::is_same_v<T, bool>) {
+            value = raw != 0;
+        } else if constexpr (std::is_enum_v<T> || std::is_signed_v<T>) {
+            value = static_cast<T>(UnZigZag(raw));
+        } else {
+            value = static_cast<T>(raw);
+        }
+        return true;
+    }
+};
+
+template <> struct ValueCodec<float> {
+    static constexpr uint8_t kWireType = kFixed32;
+    static bool Present(float value) { return value != 0.0f; }
+    static size_t Size(float) { return 4; }
+    static uint8_t* Write(uint8_t* out, float value) {
+        uint32_t bits;
+        memcpy(&bits, &value, 4);
+        for (int i = 0; i < 4; ++i) *out++ = static_cast<uint8_t>(bits >> (i * 8));
+        return out;
+    }
+    static bool Read(const uint8_t*& p, const uint8_t* end, float& value) {
+        if (end - p < 4) return false;
+        uint32_t bits = uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+        memcpy(&value, &bits, 4);
+        p += 4;
+        return true;
+    }
+};
+
+template <> struct ValueCodec<std::string_view> {
+    static constexpr uint8_t kWireType = kLengthDelimited;
+    static bool Present(std::string_view value) { return !value.empty(); }
+    static size_t Size(std::string_view value) { return VarintSize(value.size()) + value.size(); }
+    static uint8_t* Write(uint8_t* out, std::string_view value) {
+        out = WriteVarint(out, value.size());
+        if (!value.empty()) memcpy(out, value.data(), value.size());
+        return out + value.size();
+    }
+    static bool Read(const uint8_t*& p, const uint8_t* end, std::string_view& value) {
+        uint64_t length;
+        if (!ReadVarint(p, end, length) || length > static_cast<uint64_t>(end - p)) return false;
+        value = std::string_view(reinterpret_cast<const char*>(p), static_cast<size_t>(length));
+        p += length;
+        return true;
+    }
+};
+
+// Nullable fields (string?, f32? in the schema). Present-but-empty is written
+// so C# can tell null from "".
+template <typename T> struct ValueCodec<std::optional<T>> {
+    static constexpr uint8_t kWireType = ValueCodec<T>::kWireType;
+    static bool Present(const std::optional<T>& value) { return value.has_value(); }
+    static size_t Size(const std::optional<T>& value) { return ValueCodec<T>::Size(*value); }
+    static uint8_t* Write(uint8_t* out, const std::optional<T>& value) { return ValueCodec<T>::Write(out, *value); }
+    static bool Read(const uint8_t*& p, const uint8_t* end, std::optional<T>& value) {
+        T raw{};
+        if (!ValueCodec<T>::Read(p, end, raw)) return false;
+        value = raw;
+        return true;
+    }
+};
+
+template <> struct ValueCodec<Bytes> {
+    static constexpr uint8_t kWireType = kLengthDelimited;
+    static bool Present(const Bytes& value) { return value.size > 0; }
+    static size_t Size(const Bytes& value) { return VarintSize(value.size) + value.size; }
+    static uint8_t* Write(uint8_t* out, const Bytes& value) {
+        out = WriteVarint(out, value.size);
+        memcpy(out, value.data, value.size);
+        return out + value.size;
+    }
+    static bool Read(const uint8_t*& p, const uint8_t* end, Bytes& value) {
+        uint64_t length;
+        if (!ReadVarint(p, end, length) || length > static_cast<uint64_t>(end - p)) return false;
+        value = Bytes{p, static_cast<size_t>(length)};
+        p += length;
+        return true;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Messages
+// ---------------------------------------------------------------------------
+
+template <typename T> size_t BodySize(const T& message, uint32_t version);
+template <typename T> uint8_t* WriteBody(uint8_t* out, const T& message, uint32_t version);
+template <typename T> bool ReadBody(const uint8_t* p, const uint8_t* end, T& message);
+
+template <typename T> struct ValueCodec<T, std::enable_if_t<IsMessage<T>::value>> {
+    static constexpr uint8_t kWireType = kLengthDelimited;
+    static bool Present(const T&) { return true; }
+    static size_t Size(const T& value, uint32_t version) {
+        size_t body = BodySize(value, version);
+        return VarintSize(body) + body;
+    }
+    static uint8_t* Write(uint8_t* out, const T& value, uint32_t version) {
+        out = WriteVarint(out, BodySize(value, version));
+        return WriteBody(out, value, version);
+    }
+    static bool Read(const uint8_t*& p, const uint8_t* end, T& value) {
+        uint64_t length;
+        if (!ReadVarint(p, end, length) || length > static_cast<uint64_t>(end - p)) return false;
+        const uint8_t* body_end = p + length;
+        if (!ReadBody(p, body_end, value)) return false;
+        p = body_end;
+        return true;
+    }
+};
+
+// Repeated field. Built from an array when encoding; after decoding it is a
+// view over the enclosing message body that yields matching elements lazily.
+template <typename T> class List {
+public:
+    List() = default;
+    List(const T* items, size_t count) : items_(items), count_(count) {}
+
+    static List Encoded(const uint8_t* body, const uint8_t* body_end, uint32_t tag) {
+        List list;
+        list.body_ = body;
+        list.body_end_ = body_end;
+        list.tag_ = tag;
+        return list;
+    }
+
+    bool IsEncoded() const { return body_ != nullptr; }
+
+    // Visits each element; returns false if the encoded data is malformed
+    template <typename F> bool ForEach(F&& visit) const {
+        if (!IsEncoded()) {
+            for (size_t i = 0; i < count_; ++i) visit(items_[i]);
+            return true;
+        }
+        const uint8_t* p = body_;
+        while (p < body_end_) {
+            uint64_t key;
+            if (!ReadVarint(p, body_end_, key)) return false;
+            uint8_t wire_type = static_cast<uint8_t>(key & 7);
+            if ((key >> 3) == tag_ && wire_type == ValueCodec<T>::kWireType) {
+                T item{};
+                if (!ValueCodec<T>::Read(p, body_end_, item)) return false;
+                visit(item);
+            } else if (!SkipValue(wire_type, p, body_end_)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t Count() const {
+        if (!IsEncoded()) return count_;
+        size_t count = 0;
+        ForEach([&](const T&) { ++count; });
+        return count;
+    }
+
+    const T* Items() const { return items_; }
+
+private:
+    const T* items_ = nullptr;
+    size_t count_ = 0;
+    const uint8_t* body_ = nullptr;
+    const uint8_t* body_end_ = nullptr;
+    uint32_t tag_ = 0;
+};
+
+namespace detail {
+
+template <typename T> struct MemberType;
+template <typename C, typename M> struct MemberType<M C::*> { using Type = M; };
+
+template <typename V> size_t ValueSize(const V& value, uint32_t version) {
+    if constexpr (IsMessage<V>::value) {
+        return ValueCodec<V>::Size(value, version);
+    } else {
+        (void)version;
+        return ValueCodec<V>::Size(value);
+    }
+}
+
+template <typename V> uint8_t* WriteValue(uint8_t* out, const V& value, uint32_t version) {
+    if constexpr (IsMessage<V>::value) {
+        return ValueCodec<V>::Write(out, value, version);
+    } else {
+        (void)version;
+        return ValueCodec<V>::Write(out, value);
+    }
+}
+
+template <typename F, typename T> size_t FieldSize(const F&, const T& message, uint32_t version) {
+    using V = typename MemberType<std::remove_cv_t<decltype(F::kMember)>>::Type;
+    if (F::kSince > version) return 0;
+    const V& value = message.*(F::kMember);
+    const size_t key_size = VarintSize(static_cast<uint64_t>(F::kTag) << 3);
+    if constexpr (IsList<V>::value) {
+        size_t size = 0;
+        value.ForEach([&](const auto& item) { size += key_size + ValueSize(item, version); });
+        return size;
+    } else {
+        return ValueCodec<V>::Present(value) ? key_size + ValueSize(value, version) : 0;
+    }
+}
+
+template <typename F, typename T> uint8_t* WriteField(uint8_t* out, const F&, const T& message, uint32_t version) {
+    using V = typename MemberType<std::remove_cv_t<decltype(F::kMember)>>::Type;
+    if (F::kSince > version) return out;
+    const V& value = message.*(F::kMember);
+    if constexpr (IsList<V>::value) {
+        using Item = std::decay_t<decltype(*value.Items())>;
+        value.ForEach([&](const Item& item) {
+            out = WriteVarint(out, (static_cast<uint64_t>(F::kTag) << 3) | ValueCodec<Item>::kWireType);
+            out = WriteValue(out, item, version);
+        });
+        return out;
+    } else {
+        if (!ValueCodec<V>::Present(value)) return out;
+        out = WriteVarint(out, (static_cast<uint64_t>(F::kTag) << 3) | ValueCodec<V>::kWireType);
+        return WriteValue(out, value, version);
+    }
+}
+
+// Returns true when the tag belongs to this field; ok is cleared on bad data
+template <typename F, typename T>
+bool ReadField(const F&, T& message, uint32_t tag, uint8_t wire_type, const uint8_t*& p, const uint8_t* body,
+               const uint8_t* end, bool& ok) {
+    using V = typename MemberType<std::remove_cv_t<decltype(F::kMember)>>::Type;
+    if (tag != F::kTag) return false;
+    V& value = message.*(F::kMember);
+    if constexpr (IsList<V>::value) {
+        using Item = std::decay_t<decltype(*value.Items())>;
+        if (wire_type != ValueCodec<Item>::kWireType) return false;
+        if (!value.IsEncoded()) value = V::Encoded(body, end, F::kTag);
+        ok = SkipValue(wire_type, p, end);
+    } else {
+        if (wire_type != ValueCodec<V>::kWireType) return false;
+        ok = ValueCodec<V>::Read(p, end, value);
+    }
+    return true;
+}
+
+}
+
+template <typename T> size_t BodySize(const T& message, uint32_t version) {
+    return std::apply([&](const auto&... fields) { return (detail::FieldSize(fields, message, version) + ... + size_t{0}); },
+                      MessageSchema<T>::kFields);
+}
+
+template <typename T> uint8_t* WriteBody(uint8_t* out, const T& message, uint32_t version) {
+    std::apply([&](const auto&... fields) { ((out = detail::WriteField(out, fields, message, version)), ...); },
+               MessageSchema<T>::kFields);
+    return out;
+}
+
+template <typename T> bool ReadBody(const uint8_t* p, const uint8_t* end, T& message) {
+    const uint8_t* body = p;
+    while (p < end) {
+        uint64_t key;
+        if (!ReadVarint(p, end, key)) return false;
+        const uint32_t tag = static_cast<uint32_t>(key >> 3);
+        const uint8_t wire_type = static_cast<uint8_t>(key & 7);
+        bool ok = true;
+        bool handled = std::apply(
+            [&](const auto&... fields) {
+                return (detail::ReadField(fields, message, tag, wire_type, p, body, end, ok) || ...);
+            },
+            MessageSchema<T>::kFields);
+        if (!ok) return false;
+        if (!handled && !SkipValue(wire_type, p, end)) return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Framed messages
+// ---------------------------------------------------------------------------
+
+struct FrameHeader {
+    uint32_t schema_version = 0;
+    uint32_t message_type = 0;
+    const uint8_t* body = nullptr;
+    size_t body_size = 0;
+};
+
+template <typename T> size_t EncodedSize(const T& message, uint32_t version) {
+    return 2 + VarintSize(static_cast<uint64_t>(T::kType)) + BodySize(message, version);
+}
+
+// Writes a complete frame for a peer on the given schema version. Returns the
+// number of bytes written, or 0 when capacity is too small.
+template <typename T> size_t Encode(const T& message, uint8_t* out, size_t capacity, uint32_t version) {
+    const size_t size = EncodedSize(message, version);
+    if (size > capacity) return 0;
+    uint8_t* p = out;
+    *p++ = kFrameFlag;
+    *p++ = static_cast<uint8_t>(version);
+    p = WriteVarint(p, static_cast<uint64_t>(T::kType));
+    p = WriteBody(p, message, version);
+    return static_cast<size_t>(p - out);
+}
+
+inline bool ReadFrameHeader(const uint8_t* data, size_t size, FrameHeader& header) {
+    if (size < 3 || data[0] != kFrameFlag) return false;
+    const uint8_t* p = data + 2;
+    const uint8_t* end = data + size;
+    uint64_t type;
+    if (!ReadVarint(p, end, type)) return false;
+    header.schema_version = data[1];
+    header.message_type = static_cast<uint32_t>(type);
+    header.body = p;
+    header.body_size = static_cast<size_t>(end - p);
+    return true;
+}
+
+template <typename T> bool Decode(const FrameHeader& header, T& message) {
+    if (header.message_type != static_cast<uint32_t>(T::kType)) return false;
+    return ReadBody(header.body, header.body + header.body_size, message);
+}
+
+}
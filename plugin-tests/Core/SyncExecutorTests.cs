@@ -0,0 +1,158 @@
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Threading;
+using System.Threading.Tasks;
+using FyteClub.Core;
+using Xunit;
+
+namespace FyteClub.Tests.Core
+{
+    /// <summary>
+    /// Tests for the concurrent player sync executor: parallelism cap, distance priority with
+    /// aging, per-player replacement and the Drained event
+    /// </summary>
+    public class SyncExecutorTests
+    {
+        private static readonly TimeSpan Timeout = TimeSpan.FromSeconds(5);
+
+        private static SyncQueueEntry Entry(string playerName, float priority) => new()
+        {
+            PlayerName = playerName,
+            DetectedAt = DateTime.UtcNow,
+            Priority = priority
+        };
+
+        private static async Task WaitUntil(Func<bool> condition)
+        {
+            var deadline = DateTime.UtcNow + Timeout;
+            while (!condition())
+            {
+                Assert.True(DateTime.UtcNow < deadline, "Timed out waiting for the executor");
+                await Task.Delay(10);
+            }
+        }
+
+        [Fact]
+        public async Task RunningSyncs_NeverExceedMaxParallelism()
+        {
+            var release = new TaskCompletionSource<bool>(TaskCreationOptions.RunContinuationsAsynchronously);
+            var drained = new TaskCompletionSource<bool>(TaskCreationOptions.RunContinuationsAsynchronously);
+            var running = 0;
+            var peak = 0;
+            var completed = new ConcurrentBag<string>();
+
+            using var executor = new SyncExecutor(async entry =>
+            {
+                var now = Interlocked.Increment(ref running);
+                int seen;
+                while ((seen = Volatile.Read(ref peak)) < now && Interlocked.CompareExchange(ref peak, now, seen) != seen) { }
+                await release.Task;
+                Interlocked.Decrement(ref running);
+                completed.Add(entry.PlayerName);
+            }, maxParallelism: 2);
+            executor.Drained += () => drained.TrySetResult(true);
+
+            for (var i = 0; i < 5; i++)
+            {
+                executor.Enqueue(Entry($"Player{i}", i));
+            }
+
+            await WaitUntil(() => executor.RunningCount == 2);
+            Assert.Equal(3, executor.PendingCount);
+
+            release.SetResult(true);
+            Assert.Same(drained.Task, await Task.WhenAny(drained.Task, Task.Delay(Timeout)));
+            Assert.Equal(2, peak);
+            Assert.Equal(5, completed.Count);
+        }
+
+        [Fact]
+        public async Task NearerPlayers_GoFirst_UntilFarOnesHaveAged()
+        {
+            foreach (var (aging, expectedFirst) in new[] { (0f, "Near"), (1000f, "Far") })
+            {
+                var release = new TaskCompletionSource<bool>(TaskCreationOptions.RunContinuationsAsynchronously);
+                var order = new ConcurrentQueue<string>();
+                using var executor = new SyncExecutor(async entry =>
+                {
+                    if (entry.PlayerName == "Blocker") await release.Task;
+                    order.Enqueue(entry.PlayerName);
+                }, maxParallelism: 1, agingPerSecond: aging);
+
+                executor.Enqueue(Entry("Blocker", 0));
+                await WaitUntil(() => executor.RunningCount == 1);
+
+                // Far waits ~300ms longer: 100 - 1000 * 0.3 beats Near's 1 once aging counts
+                executor.Enqueue(Entry("Far", 100));
+                await Task.Delay(300);
+                executor.Enqueue(Entry("Near", 1));
+
+                release.SetResult(true);
+                await WaitUntil(() => order.Count == 3);
+                Assert.Equal(new[] { "Blocker", expectedFirst }, new List<string>(order).GetRange(0, 2));
+            }
+        }
+
+        [Fact]
+        public async Task PendingRequest_IsReplacedByNewerOne_AndDrainedFiresOnce()
+        {
+            var release = new TaskCompletionSource<bool>(TaskCreationOptions.RunContinuationsAsynchronously);
+            var runs = new ConcurrentQueue<SyncQueueEntry>();
+            var drainedCount = 0;
+
+            using var executor = new SyncExecutor(async entry =>
+            {
+                runs.Enqueue(entry);
+                await release.Task;
+            }, maxParallelism: 4);
+            executor.Drained += () => Interlocked.Increment(ref drainedCount);
+
+            // The same player never runs twice at once, so the second and third wait and fold
+            var first = Entry("Alice", 5);
+            var newest = Entry("Alice", 2);
+            executor.Enqueue(first);
+            await WaitUntil(() => executor.RunningCount == 1);
+            executor.Enqueue(Entry("Alice", 9));
+            executor.Enqueue(newest);
+            Assert.Equal(1, executor.PendingCount);
+
+            release.SetResult(true);
+            await WaitUntil(() => Volatile.Read(ref drainedCount) > 0);
+            await Task.Delay(100);
+
+            Assert.Equal(1, drainedCount);
+            Assert.Equal(new[] { first, newest }, runs.ToArray());
+            Assert.Equal(0, executor.PendingCount);
+            Assert.Equal(0, executor.RunningCount);
+        }
+
+        [Fact]
+        public async Task CancelledPlayer_NeverRuns()
+        {
+            var release = new TaskCompletionSource<bool>(TaskCreationOptions.RunContinuationsAsynchronously);
+            var drained = new TaskCompletionSource<bool>(TaskCreationOptions.RunContinuationsAsynchronously);
+            var runs = new ConcurrentQueue<string>();
+
+            using var executor = new SyncExecutor(async entry =>
+            {
+                runs.Enqueue(entry.PlayerName);
+                await release.Task;
+            }, maxParallelism: 1);
+            executor.Drained += () => drained.TrySetResult(true);
+
+            executor.Enqueue(Entry("Blocker", 0));
+            await WaitUntil(() => executor.RunningCount == 1);
+            executor.Enqueue(Entry("Despawned", 1));
+
+            Assert.True(executor.Cancel("Despawned"));
+            Assert.False(executor.Cancel("Despawned"));
+            // Only pending requests are cancelled; the running one finishes
+            Assert.False(executor.Cancel("Blocker"));
+
+            release.SetResult(true);
+            Assert.Same(drained.Task, await Task.WhenAny(drained.Task, Task.Delay(Timeout)));
+            Assert.Equal(new[] { "Blocker" }, runs.ToArray());
+        }
+    }
+}
@@ -0,0 +1,109 @@
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Security.Cryptography;
+using Dalamud.Plugin.Services;
+using FyteClub.ModSystem;
+using Moq;
+using Xunit;
+
+namespace FyteClub.Tests.ModSystem
+{
+    /// <summary>
+    /// Tests for chunked-message reassembly in P2PModProtocol: per-index duplicate handling and
+    /// release of the reassembly budget on completion and on peer disconnect
+    /// </summary>
+    public class ChunkReassemblyTests
+    {
+        private const int ChunkSize = 1024;
+
+        private readonly P2PModProtocol _protocol = new(new Mock<IPluginLog>().Object);
+
+        // Splits a serialized message into the ChunkedMessage frames SendChunkedMessage would send
+        private List<byte[]> Chunk(P2PModMessage message, string chunkId)
+        {
+            var data = _protocol.SerializeMessage(message);
+            var totalChunks = (data.Length + ChunkSize - 1) / ChunkSize;
+            var frames = new List<byte[]>();
+            for (var i = 0; i < totalChunks; i++)
+            {
+                var chunk = new ChunkedMessage
+                {
+                    ChunkId = chunkId,
+                    ChunkIndex = i,
+                    TotalChunks = totalChunks,
+                    ChunkData = data.Skip(i * ChunkSize).Take(ChunkSize).ToArray(),
+                    OriginalMessageType = message.Type,
+                    OriginalMessageTypeName = message.GetType().FullName!
+                };
+                frames.Add(_protocol.SerializeMessage(chunk));
+            }
+            return frames;
+        }
+
+        private static ErrorMessage LargeMessage() => new()
+        {
+            ErrorCode = "TEST",
+            // Random text does not compress below a few chunks
+            ErrorDescription = Convert.ToBase64String(RandomNumberGenerator.GetBytes(6000))
+        };
+
+        [Fact]
+        public void DuplicateChunks_DoNotCompleteTheMessageEarly()
+        {
+            var message = LargeMessage();
+            var frames = Chunk(message, "dup");
+            Assert.True(frames.Count >= 3);
+
+            // Last chunk first, then chunk 0 repeated until it would make up the count
+            Assert.Null(_protocol.DeserializeMessage(frames[^1], "peerA"));
+            for (var i = 0; i < frames.Count; i++)
+            {
+                Assert.Null(_protocol.DeserializeMessage(frames[0], "peerA"));
+            }
+            Assert.Equal((long)frames.Count * ChunkSize, _protocol.ReassemblyBytes);
+
+            P2PModMessage? result = null;
+            for (var i = 1; i < frames.Count - 1; i++)
+            {
+                result = _protocol.DeserializeMessage(frames[i], "peerA");
+            }
+
+            var error = Assert.IsType<ErrorMessage>(result);
+            Assert.Equal(message.ErrorDescription, error.ErrorDescription);
+            Assert.Equal(0, _protocol.ReassemblyBytes);
+        }
+
+        [Fact]
+        public void PeerDisconnect_ReleasesOnlyThatPeersBuffers()
+        {
+            var framesA = Chunk(LargeMessage(), "same-id");
+            var framesB = Chunk(LargeMessage(), "same-id");
+
+            // Equal chunk ids from different peers reassemble separately
+            Assert.Null(_protocol.DeserializeMessage(framesA[0], "peerA"));
+            Assert.Null(_protocol.DeserializeMessage(framesB[0], "peerB"));
+            var bytesA = (long)framesA.Count * ChunkSize;
+            var bytesB = (long)framesB.Count * ChunkSize;
+            Assert.Equal(bytesA + bytesB, _protocol.ReassemblyBytes);
+
+            Assert.Equal(0, _protocol.ReleasePeerReassemblies("peerC"));
+            Assert.Equal(1, _protocol.ReleasePeerReassemblies("peerA"));
+            Assert.Equal(bytesB, _protocol.ReassemblyBytes);
+
+            // Peer B's message still completes; peer A's remaining chunks start over
+            P2PModMessage? result = null;
+            foreach (var frame in framesB.Skip(1))
+            {
+                result = _protocol.DeserializeMessage(frame, "peerB");
+            }
+            Assert.IsType<ErrorMessage>(result);
+            Assert.Equal(0, _protocol.ReassemblyBytes);
+
+            Assert.Null(_protocol.DeserializeMessage(framesA[1], "peerA"));
+            Assert.Equal(bytesA, _protocol.ReassemblyBytes);
+            Assert.Equal(1, _protocol.ReleasePeerReassemblies("peerA"));
+            Assert.Equal(0, _protocol.ReassemblyBytes);
+        }
+    }
+}
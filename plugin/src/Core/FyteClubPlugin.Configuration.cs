@@ -36,7 +36,8 @@ namespace FyteClub.Core
                 TurnServerPort = existingConfig.TurnServerPort,
                 TurnMaxConnections = existingConfig.TurnMaxConnections,
                 TurnSessionTimeoutMinutes = existingConfig.TurnSessionTimeoutMinutes,
-                TurnEnableLogging = existingConfig.TurnEnableLogging
+                TurnEnableLogging = existingConfig.TurnEnableLogging,
+                MaxConcurrentSyncs = existingConfig.MaxConcurrentSyncs
             };
             _pluginInterface.SavePluginConfig(config);
         }
@@ -66,6 +67,11 @@ namespace FyteClub.Core
                 }
             }
             
+            if (_syncExecutor != null)
+            {
+                _syncExecutor.MaxParallelism = config.MaxConcurrentSyncs;
+            }
+            
             foreach (var blockedUser in config.BlockedUsers ?? new List<string>())
             {
                 _blockedUsers.TryAdd(blockedUser, 0);
@@ -190,5 +196,6 @@ namespace FyteClub.Core
         public int TurnMaxConnections { get; set; } = 50;
         public int TurnSessionTimeoutMinutes { get; set; } = 10;
         public bool TurnEnableLogging { get; set; } = false;
+        public int MaxConcurrentSyncs { get; set; } = 4;
     }
 }
\ No newline at end of file
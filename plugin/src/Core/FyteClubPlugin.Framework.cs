@@ -64,6 +64,7 @@ namespace FyteClub.Core
                 
                 _mediator.ProcessQueue();
                 _playerDetection?.ScanForPlayers();
+                _modSyncOrchestrator?.ReportUploadLoad();
                 
                 if (ShouldBulkApplyCachedMods())
                 {
@@ -35,6 +35,13 @@ namespace FyteClub.Core
             }
         }
 
+        // True when any syncshell already holds a connection to the player, connected or still negotiating
+        private bool HasP2PConnection(string playerName)
+        {
+            if (_syncshellManager == null) return false;
+            return _syncshellManager.GetSyncshells().Any(s => _syncshellManager.GetWebRTCConnection(s.Id + "_" + playerName) != null);
+        }
+
         private async Task TryEstablishP2PConnectionToKnownPlayer(string playerName)
         {
             try
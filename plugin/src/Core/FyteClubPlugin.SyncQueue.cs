@@ -15,12 +15,12 @@ namespace FyteClub.Core
     /// </summary>
     public sealed partial class FyteClubPlugin
     {
-        private readonly PriorityQueue<SyncQueueEntry, float> _syncQueue = new();
-        private readonly Dictionary<string, string> _playerHashes = new();
-        private readonly SemaphoreSlim _syncProcessingSemaphore = new(1, 1);
-        private Timer? _syncQueueProcessor;
-        private const int BATCH_SIZE = 5;
-        private bool _isProcessingQueue = false;
+        private readonly ConcurrentDictionary<string, string> _playerHashes = new();
+        private SyncExecutor? _syncExecutor;
+        private readonly object _hashCheckLock = new();
+        private DateTime _lastHashCheck = DateTime.MinValue;
+        private bool _hashCheckScheduled;
+        private readonly TimeSpan _hashCheckInterval = TimeSpan.FromSeconds(3);
         
         // Timing controls
         private DateTime _lastReconnectionAttempt = DateTime.MinValue;
@@ -34,8 +34,42 @@ namespace FyteClub.Core
 
         private void InitializeSyncQueue()
         {
-            _syncQueueProcessor = new Timer(_ => _ = Task.Run(ProcessSyncQueue), null, 
-                TimeSpan.FromSeconds(3), TimeSpan.FromSeconds(3));
+            _syncExecutor = new SyncExecutor(ProcessPlayerSync);
+            _syncExecutor.Drained += OnSyncQueueDrained;
+        }
+
+        private void OnSyncQueueDrained()
+        {
+            // Re-check hashes once the queue empties, at most every few seconds. A drain inside
+            // the interval moves the check to the end of it instead of dropping it.
+            TimeSpan delay;
+            lock (_hashCheckLock)
+            {
+                if (_hashCheckScheduled) return;
+                _hashCheckScheduled = true;
+                var sinceLast = DateTime.UtcNow - _lastHashCheck;
+                delay = sinceLast < _hashCheckInterval ? _hashCheckInterval - sinceLast : TimeSpan.Zero;
+            }
+
+            var token = _cancellationTokenSource.Token;
+            _ = Task.Run(async () =>
+            {
+                try
+                {
+                    if (delay > TimeSpan.Zero) await Task.Delay(delay, token);
+                }
+                catch (OperationCanceledException)
+                {
+                    return;
+                }
+
+                lock (_hashCheckLock)
+                {
+                    _hashCheckScheduled = false;
+                    _lastHashCheck = DateTime.UtcNow;
+                }
+                await CheckForHashChanges();
+            });
         }
 
         // Player detection handlers are in FyteClubPluginCore.cs
@@ -107,58 +141,12 @@ namespace FyteClub.Core
                     Priority = distance
                 };
                 
-                lock (_syncQueue)
-                {
-                    _syncQueue.Enqueue(entry, distance);
-                }
+                _syncExecutor?.Enqueue(entry);
                 
                 ModularLogger.LogDebug(LogModule.ModSync, "Queued {0} for P2P sync at {1:F1}m", message.PlayerName, distance);
             });
         }
 
-        private async Task ProcessSyncQueue()
-        {
-            if (_isProcessingQueue || !await _syncProcessingSemaphore.WaitAsync(100)) return;
-            
-            _isProcessingQueue = true;
-            try
-            {
-                var batch = new List<SyncQueueEntry>();
-                
-                lock (_syncQueue)
-                {
-                    while (_syncQueue.Count > 0 && batch.Count < BATCH_SIZE)
-                    {
-                        batch.Add(_syncQueue.Dequeue());
-                    }
-                }
-                
-                if (batch.Count == 0) return;
-                
-                ModularLogger.LogDebug(LogModule.ModSync, "Processing sync batch: {0} players", batch.Count);
-                
-                var tasks = batch.Select(async entry =>
-                {
-                    try
-                    {
-                        await ProcessPlayerSync(entry);
-                    }
-                    catch (Exception ex)
-                    {
-                        ModularLogger.LogAlways(LogModule.ModSync, "Failed to sync {0}: {1}", entry.PlayerName, ex.Message);
-                    }
-                });
-                
-                await Task.WhenAll(tasks);
-                await CheckForHashChanges();
-            }
-            finally
-            {
-                _isProcessingQueue = false;
-                _syncProcessingSemaphore.Release();
-            }
-        }
-
         private async Task ProcessPlayerSync(SyncQueueEntry entry)
         {
             if (_loadingStates.TryGetValue(entry.PlayerName, out var state) && 
@@ -169,7 +157,16 @@ namespace FyteClub.Core
             ModularLogger.LogDebug(LogModule.ModSync, "🔄 P2P Sync: {0} (queued {1:F1}s ago)", 
                 entry.PlayerName, (DateTime.UtcNow - entry.DetectedAt).TotalSeconds);
             
-            await TryEstablishP2PConnection(entry.PlayerName);
+            // Reuse the connection detection already started, or one that is pending or open
+            var attempt = GetConnectionAttempt(entry.PlayerName);
+            if (attempt != null)
+            {
+                await attempt;
+            }
+            else if (!HasP2PConnection(entry.PlayerName))
+            {
+                await TryEstablishP2PConnection(entry.PlayerName);
+            }
             await RequestPlayerModsSafely(entry.PlayerName);
             
             var currentHash = await GetPlayerModHash(entry.PlayerName);
@@ -217,10 +214,7 @@ namespace FyteClub.Core
                         Priority = 0.1f
                     };
                     
-                    lock (_syncQueue)
-                    {
-                        _syncQueue.Enqueue(entry, 0.1f);
-                    }
+                    _syncExecutor?.Enqueue(entry);
                 }
             }
             catch (Exception ex)
@@ -64,6 +64,7 @@ namespace FyteClub.Core
         private readonly ConcurrentDictionary<string, SyncshellInfo> _playerSyncshellAssociations = new();
         private readonly ConcurrentDictionary<string, DateTime> _playerLastSeen = new();
         private readonly ConcurrentDictionary<string, LoadingState> _loadingStates = new();
+        private readonly Dictionary<string, Task> _connectionAttempts = new();
         
         // State tracking
         private bool _hasPerformedInitialUpload = false;
@@ -159,6 +160,7 @@ namespace FyteClub.Core
             
             InitializeIPCHandlers();
             CheckModSystemAvailability();
+            InitializeSyncQueue();
             LoadConfiguration();
         }
         
@@ -186,7 +188,7 @@ namespace FyteClub.Core
                             ModularLogger.LogDebug(LogModule.Core, "Found {0} in syncshell {1} phonebook - initiating automatic P2P connection", message.PlayerName, syncshell.Name);
                             
                             // Automatically establish P2P connection using TURN servers
-                            _ = EstablishAutomaticP2PConnection(syncshell.Id, message.PlayerName);
+                            StartAutomaticP2PConnection(syncshell.Id, message.PlayerName);
                             break; // Only connect once per player
                         }
                     }
@@ -194,7 +196,8 @@ namespace FyteClub.Core
                 
                 if (isInSyncshell)
                 {
-                    ModularLogger.LogDebug(LogModule.Core, "Player {0} is in syncshell - P2P orchestrator will handle mod sync", message.PlayerName);
+                    ModularLogger.LogDebug(LogModule.Core, "Player {0} is in syncshell - queueing mod sync", message.PlayerName);
+                    AddPlayerToSyncQueue(message);
                 }
                 else
                 {
@@ -214,6 +217,7 @@ namespace FyteClub.Core
                 ModularLogger.LogDebug(LogModule.Core, "Player removed: {0}", message.PlayerName);
                 
                 _loadingStates.TryRemove(message.PlayerName, out _);
+                _syncExecutor?.Cancel(message.PlayerName);
                 
                 // Disconnect P2P connection when player leaves proximity
                 if (_syncshellManager != null)
@@ -231,6 +235,36 @@ namespace FyteClub.Core
             }
         }
         
+        // Starts at most one automatic connection per player. The sync queue awaits the
+        // attempt in flight instead of opening a second connection of its own.
+        private void StartAutomaticP2PConnection(string syncshellId, string playerName)
+        {
+            Task attempt;
+            lock (_connectionAttempts)
+            {
+                if (_connectionAttempts.ContainsKey(playerName)) return;
+                attempt = EstablishAutomaticP2PConnection(syncshellId, playerName);
+                _connectionAttempts[playerName] = attempt;
+            }
+
+            _ = attempt.ContinueWith(_ =>
+            {
+                lock (_connectionAttempts)
+                {
+                    if (_connectionAttempts.TryGetValue(playerName, out var current) && current == attempt)
+                        _connectionAttempts.Remove(playerName);
+                }
+            }, TaskScheduler.Default);
+        }
+
+        private Task? GetConnectionAttempt(string playerName)
+        {
+            lock (_connectionAttempts)
+            {
+                return _connectionAttempts.TryGetValue(playerName, out var attempt) ? attempt : null;
+            }
+        }
+
         private Task EstablishAutomaticP2PConnection(string syncshellId, string playerName)
         {
             return Task.Run(async () =>
@@ -869,6 +903,7 @@ namespace FyteClub.Core
                 try { _syncshellManager?.Dispose(); } catch { }
                 try { _modSyncOrchestrator?.Dispose(); } catch { }
                 try { _p2pModSyncIntegration?.Dispose(); } catch { }
+                try { _syncExecutor?.Dispose(); } catch { }
                 try { _httpClient?.Dispose(); } catch { }
                 try { _cancellationTokenSource.Dispose(); } catch { }
                 
@@ -0,0 +1,163 @@
+using System;
+using System.Collections.Generic;
+using System.Threading.Tasks;
+using FyteClub.Core.Logging;
+
+namespace FyteClub.Core
+{
+    /// <summary>
+    /// Bounded concurrent executor for player syncs. Each player has at most one pending
+    /// request (a newer one replaces it) and one sync running; different players run in
+    /// parallel up to MaxParallelism. Lower Priority (distance) goes first, and a waiting
+    /// request gains AgingPerSecond every second so far-away players are not starved.
+    /// </summary>
+    public sealed class SyncExecutor : IDisposable
+    {
+        private readonly Func<SyncQueueEntry, Task> _work;
+        private readonly Dictionary<string, PendingSync> _pending = new();
+        private readonly HashSet<string> _running = new();
+        private readonly object _lock = new();
+        private int _maxParallelism;
+        private bool _disposed;
+
+        private sealed class PendingSync
+        {
+            public SyncQueueEntry Entry = null!;
+            public DateTime QueuedAt;
+        }
+
+        /// <summary>
+        /// Raised when the last running sync finishes and nothing is pending.
+        /// </summary>
+        public event Action? Drained;
+
+        public SyncExecutor(Func<SyncQueueEntry, Task> work, int maxParallelism = 4, float agingPerSecond = 5f)
+        {
+            _work = work;
+            _maxParallelism = Math.Clamp(maxParallelism, 1, 32);
+            AgingPerSecond = agingPerSecond;
+        }
+
+        public int MaxParallelism
+        {
+            get { lock (_lock) return _maxParallelism; }
+            set
+            {
+                lock (_lock) _maxParallelism = Math.Clamp(value, 1, 32);
+                Pump();
+            }
+        }
+
+        public float AgingPerSecond { get; set; }
+
+        public int PendingCount
+        {
+            get { lock (_lock) return _pending.Count; }
+        }
+
+        public int RunningCount
+        {
+            get { lock (_lock) return _running.Count; }
+        }
+
+        public void Enqueue(SyncQueueEntry entry)
+        {
+            lock (_lock)
+            {
+                if (_disposed) return;
+
+                // Newest request wins, but keeps the original wait for aging
+                if (_pending.TryGetValue(entry.PlayerName, out var existing))
+                {
+                    existing.Entry = entry;
+                }
+                else
+                {
+                    _pending[entry.PlayerName] = new PendingSync { Entry = entry, QueuedAt = DateTime.UtcNow };
+                }
+            }
+            Pump();
+        }
+
+        public bool Cancel(string playerName)
+        {
+            lock (_lock)
+            {
+                return _pending.Remove(playerName);
+            }
+        }
+
+        private void Pump()
+        {
+            var started = new List<SyncQueueEntry>();
+            lock (_lock)
+            {
+                var now = DateTime.UtcNow;
+                while (!_disposed && _running.Count < _maxParallelism)
+                {
+                    // A few dozen players at most, so a scan beats keeping a heap in step
+                    // with replaced entries and aging priorities
+                    PendingSync? best = null;
+                    var bestScore = float.MaxValue;
+                    foreach (var pending in _pending.Values)
+                    {
+                        if (_running.Contains(pending.Entry.PlayerName)) continue;
+                        var score = pending.Entry.Priority - AgingPerSecond * (float)(now - pending.QueuedAt).TotalSeconds;
+                        if (score < bestScore)
+                        {
+                            best = pending;
+                            bestScore = score;
+                        }
+                    }
+                    if (best == null) break;
+
+                    _pending.Remove(best.Entry.PlayerName);
+                    _running.Add(best.Entry.PlayerName);
+                    started.Add(best.Entry);
+                }
+            }
+
+            foreach (var entry in started)
+            {
+                _ = Task.Run(() => RunAsync(entry));
+            }
+        }
+
+        private async Task RunAsync(SyncQueueEntry entry)
+        {
+            try
+            {
+                await _work(entry);
+            }
+            catch (Exception ex)
+            {
+                ModularLogger.LogAlways(LogModule.ModSync, "Failed to sync {0}: {1}", entry.PlayerName, ex.Message);
+            }
+
+            bool drained;
+            lock (_lock)
+            {
+                _running.Remove(entry.PlayerName);
+                drained = !_disposed && _running.Count == 0 && _pending.Count == 0;
+            }
+
+            if (drained)
+            {
+                Drained?.Invoke();
+            }
+            else
+            {
+                Pump();
+            }
+        }
+
+        public void Dispose()
+        {
+            lock (_lock)
+            {
+                _disposed = true;
+                _pending.Clear();
+            }
+        }
+    }
+}
@@ -183,6 +183,13 @@ namespace FyteClub
             // Clean up smart transfer resources
             _smartTransfer.HandlePeerDisconnected(peerId);
             
+            // Partial chunked messages are resent under new chunk ids, so none of them survive a reconnect
+            var released = _protocol.ReleasePeerReassemblies(peerId);
+            if (released > 0)
+            {
+                _pluginLog.Info($"[EnhancedP2PSync] Released {released} partial chunked message(s) from {peerId}");
+            }
+            
             _pluginLog.Debug($"[EnhancedP2PSync] Unregistered peer {peerId}");
         }
 
@@ -443,6 +450,14 @@ namespace FyteClub
             }
         }
 
+        /// <summary>
+        /// Feeds process load to upload admission; called from the framework update
+        /// </summary>
+        public void ReportUploadLoad()
+        {
+            _smartTransfer.ReportLoad();
+        }
+
         /// <summary>
         /// Process incoming P2P message data
         /// </summary>
@@ -481,7 +496,7 @@ namespace FyteClub
                     }
                 }
                 
-                var message = _protocol.DeserializeMessage(messageData);
+                var message = _protocol.DeserializeMessage(messageData, peerId);
                 if (message == null)
                 {
                     // Check if this might be a chunked message that's still being collected
@@ -674,7 +689,18 @@ namespace FyteClub
                     sendFunction, 
                     TimeSpan.FromSeconds(120)); // Increased from 30s to allow large file transfers
 
-                if (response != null)
+                if (response != null && response.UploadDeferred)
+                {
+                    LogUploadDeferred(playerName, response);
+                    if (response.QueuePosition == 0)
+                    {
+                        // Shed: hold further requests to this peer until it expects a free slot
+                        var retryAt = DateTime.UtcNow.AddMilliseconds(response.RetryAfterMs);
+                        _lastSyncTimes[peerId] = retryAt.AddMilliseconds(-MIN_SYNC_INTERVAL_MS);
+                    }
+                    return null;
+                }
+                else if (response != null)
                 {
                     _pluginLog.Info($"[EnhancedP2PSync] Received mod data for {playerName}: {response.FileReplacements.Count} files, hash: {response.DataHash[..12]}...");
                     
@@ -695,6 +721,18 @@ namespace FyteClub
             }
         }
 
+        private void LogUploadDeferred(string playerName, ModDataResponse response)
+        {
+            if (response.QueuePosition > 0)
+            {
+                _pluginLog.Info($"[EnhancedP2PSync] Mod data for {playerName} is queued at position {response.QueuePosition}, expected in ~{response.RetryAfterMs} ms");
+            }
+            else
+            {
+                _pluginLog.Info($"[EnhancedP2PSync] Sender is shedding uploads; mod data for {playerName} can be requested again in {response.RetryAfterMs} ms");
+            }
+        }
+
         /// <summary>
         /// Process received mod data and apply it
         /// </summary>
@@ -1197,6 +1235,14 @@ namespace FyteClub
             {
                 // Normalize player name for consistent processing
                 var normalizedPlayerName = response.PlayerName.Split('@')[0].Trim();
+                
+                // The sender's upload admission queued or shed this sync; nothing to apply yet
+                if (response.UploadDeferred)
+                {
+                    LogUploadDeferred(normalizedPlayerName, response);
+                    return;
+                }
+                
                 _pluginLog.Info($"[EnhancedP2PSync] Received broadcast mod data for {normalizedPlayerName} with {response.FileReplacements.Count} files");
                 
                 // CRITICAL: Add player to phonebook immediately when we receive their mod data
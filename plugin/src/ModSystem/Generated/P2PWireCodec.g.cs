@@ -0,0 +1,2286 @@
+// <auto-generated>
+//     Generated by native/tools/schema_codegen from schema/p2p_messages.schema.
+//     Do not edit by hand - change the schema and build the generate_wire_codec target.
+// </auto-generated>
+#nullable enable
+using System;
+using System.Collections.Generic;
+
+namespace FyteClub.ModSystem
+{
+    /// <summary>
+    /// Schema-generated binary codec for P2P messages, byte-compatible with native/generated/p2p_messages.h
+    /// </summary>
+    public static partial class P2PWireCodec
+    {
+        public const int SchemaVersion = 2;
+
+        /// <summary>
+        /// Serialize a message as a schema frame for a peer on the given schema version
+        /// </summary>
+        public static byte[]? Serialize(P2PModMessage message, int version = SchemaVersion)
+        {
+            switch (message)
+            {
+                case global::FyteClub.ModSystem.ModDataRequest m:
+                {
+                    var buffer = new byte[WireFormat.FrameHeaderSize(0) + SizeOf(m, version)];
+                    var writer = new WireWriter(buffer);
+                    writer.WriteFrameHeader(version, 0);
+                    Write(ref writer, m, version);
+                    return buffer;
+                }
+                case global::FyteClub.ModSystem.ModDataResponse m:
+                {
+                    var buffer = new byte[WireFormat.FrameHeaderSize(1) + SizeOf(m, version)];
+                    var writer = new WireWriter(buffer);
+                    writer.WriteFrameHeader(version, 1);
+                    Write(ref writer, m, version);
+                    return buffer;
+                }
+                case global::FyteClub.ModSystem.ComponentRequest m:
+                {
+                    var buffer = new byte[WireFormat.FrameHeaderSize(2) + SizeOf(m, version)];
+                    var writer = new WireWriter(buffer);
+                    writer.WriteFrameHeader(version, 2);
+                    Write(ref writer, m, version);
+                    return buffer;
+                }
+                case global::FyteClub.ModSystem.ComponentResponse m:
+                {
+                    var buffer = new byte[WireFormat.FrameHeaderSize(3) + SizeOf(m, version)];
+                    var writer = new WireWriter(buffer);
+                    writer.WriteFrameHeader(version, 3);
+                    Write(ref writer, m, version);
+                    return buffer;
+                }
+                case global::FyteClub.ModSystem.ModApplicationRequest m:
+                {
+                    var buffer = new byte[WireFormat.FrameHeaderSize(4) + SizeOf(m, version)];
+                    var writer = new WireWriter(buffer);
+                    writer.WriteFrameHeader(version, 4);
+                    Write(ref writer, m, version);
+                    return buffer;
+                }
+                case global::FyteClub.ModSystem.ModApplicationResponse m:
+                {
+                    var buffer = new byte[WireFormat.FrameHeaderSize(5) + SizeOf(m, version)];
+                    var writer = new WireWriter(buffer);
+                    writer.WriteFrameHeader(version, 5);
+                    Write(ref writer, m, version);
+                    return buffer;
+                }
+                case global::FyteClub.ModSystem.SyncCompleteMessage m:
+                {
+                    var buffer = new byte[WireFormat.FrameHeaderSize(6) + SizeOf(m, version)];
+                    var writer = new WireWriter(buffer);
+                    writer.WriteFrameHeader(version, 6);
+                    Write(ref writer, m, version);
+                    return buffer;
+                }
+                case global::FyteClub.ModSystem.ErrorMessage m:
+                {
+                    var buffer = new byte[WireFormat.FrameHeaderSize(7) + SizeOf(m, version)];
+                    var writer = new WireWriter(buffer);
+                    writer.WriteFrameHeader(version, 7);
+                    Write(ref writer, m, version);
+                    return buffer;
+                }
+                case global::FyteClub.ModSystem.ChunkedMessage m:
+                {
+                    var buffer = new byte[WireFormat.FrameHeaderSize(8) + SizeOf(m, version)];
+                    var writer = new WireWriter(buffer);
+                    writer.WriteFrameHeader(version, 8);
+                    Write(ref writer, m, version);
+                    return buffer;
+                }
+                case global::FyteClub.ModSystem.FileChunkMessage m:
+                {
+                    var buffer = new byte[WireFormat.FrameHeaderSize(9) + SizeOf(m, version)];
+                    var writer = new WireWriter(buffer);
+                    writer.WriteFrameHeader(version, 9);
+                    Write(ref writer, m, version);
+                    return buffer;
+                }
+                case global::FyteClub.ModSystem.MemberListRequestMessage m:
+                {
+                    var buffer = new byte[WireFormat.FrameHeaderSize(10) + SizeOf(m, version)];
+                    var writer = new WireWriter(buffer);
+                    writer.WriteFrameHeader(version, 10);
+                    Write(ref writer, m, version);
+                    return buffer;
+                }
+                case global::FyteClub.ModSystem.MemberListResponseMessage m:
+                {
+                    var buffer = new byte[WireFormat.FrameHeaderSize(11) + SizeOf(m, version)];
+                    var writer = new WireWriter(buffer);
+                    writer.WriteFrameHeader(version, 11);
+                    Write(ref writer, m, version);
+                    return buffer;
+                }
+                case global::FyteClub.ModSystem.ChannelNegotiationMessage m:
+                {
+                    var buffer = new byte[WireFormat.FrameHeaderSize(12) + SizeOf(m, version)];
+                    var writer = new WireWriter(buffer);
+                    writer.WriteFrameHeader(version, 12);
+                    Write(ref writer, m, version);
+                    return buffer;
+                }
+                case global::FyteClub.ModSystem.ChannelNegotiationResponse m:
+                {
+                    var buffer = new byte[WireFormat.FrameHeaderSize(13) + SizeOf(m, version)];
+                    var writer = new WireWriter(buffer);
+                    writer.WriteFrameHeader(version, 13);
+                    Write(ref writer, m, version);
+                    return buffer;
+                }
+                case global::FyteClub.ModSystem.ReconnectOfferMessage m:
+                {
+                    var buffer = new byte[WireFormat.FrameHeaderSize(14) + SizeOf(m, version)];
+                    var writer = new WireWriter(buffer);
+                    writer.WriteFrameHeader(version, 14);
+                    Write(ref writer, m, version);
+                    return buffer;
+                }
+                case global::FyteClub.ModSystem.ReconnectAnswerMessage m:
+                {
+                    var buffer = new byte[WireFormat.FrameHeaderSize(15) + SizeOf(m, version)];
+                    var writer = new WireWriter(buffer);
+                    writer.WriteFrameHeader(version, 15);
+                    Write(ref writer, m, version);
+                    return buffer;
+                }
+                case global::FyteClub.ModSystem.RecoveryRequestMessage m:
+                {
+                    var buffer = new byte[WireFormat.FrameHeaderSize(16) + SizeOf(m, version)];
+                    var writer = new WireWriter(buffer);
+                    writer.WriteFrameHeader(version, 16);
+                    Write(ref writer, m, version);
+                    return buffer;
+                }
+                default:
+                    return null;
+            }
+        }
+
+        /// <summary>
+        /// Deserialize a schema frame; unknown fields from newer peers are skipped
+        /// </summary>
+        public static P2PModMessage? Deserialize(ReadOnlySpan<byte> data)
+        {
+            if (!WireFormat.TryReadFrameHeader(data, out _, out var messageType, out var body))
+                return null;
+
+            return messageType switch
+            {
+                0 => ReadModDataRequest(body),
+                1 => ReadModDataResponse(body),
+                2 => ReadComponentRequest(body),
+                3 => ReadComponentResponse(body),
+                4 => ReadModApplicationRequest(body),
+                5 => ReadModApplicationResponse(body),
+                6 => ReadSyncCompleteMessage(body),
+                7 => ReadErrorMessage(body),
+                8 => ReadChunkedMessage(body),
+                9 => ReadFileChunkMessage(body),
+                10 => ReadMemberListRequestMessage(body),
+                11 => ReadMemberListResponseMessage(body),
+                12 => ReadChannelNegotiationMessage(body),
+                13 => ReadChannelNegotiationResponse(body),
+                14 => ReadReconnectOfferMessage(body),
+                15 => ReadReconnectAnswerMessage(body),
+                16 => ReadRecoveryRequestMessage(body),
+                _ => null
+            };
+        }
+
+        internal static int SizeOf(global::FyteClub.TransferableFile m, int version)
+        {
+            var size = 0;
+            if (!string.IsNullOrEmpty(m.GamePath))
+                size += WireFormat.KeySize(1) + WireFormat.StringSize(m.GamePath);
+            if (!string.IsNullOrEmpty(m.Hash))
+                size += WireFormat.KeySize(2) + WireFormat.StringSize(m.Hash);
+            if (m.Content != null && m.Content.Length > 0)
+                size += WireFormat.KeySize(3) + WireFormat.BytesSize(m.Content);
+            if (m.Size != 0)
+                size += WireFormat.KeySize(4) + WireFormat.SignedSize(m.Size);
+            return size;
+        }
+
+        internal static void Write(ref WireWriter writer, global::FyteClub.TransferableFile m, int version)
+        {
+            if (!string.IsNullOrEmpty(m.GamePath))
+            {
+                writer.WriteKey(1, WireFormat.LengthDelimited);
+                writer.WriteString(m.GamePath);
+            }
+            if (!string.IsNullOrEmpty(m.Hash))
+            {
+                writer.WriteKey(2, WireFormat.LengthDelimited);
+                writer.WriteString(m.Hash);
+            }
+            if (m.Content != null && m.Content.Length > 0)
+            {
+                writer.WriteKey(3, WireFormat.LengthDelimited);
+                writer.WriteBytes(m.Content);
+            }
+            if (m.Size != 0)
+            {
+                writer.WriteKey(4, WireFormat.Varint);
+                writer.WriteSigned(m.Size);
+            }
+        }
+
+        internal static global::FyteClub.TransferableFile ReadTransferableFile(ReadOnlySpan<byte> data)
+        {
+            var m = new global::FyteClub.TransferableFile();
+            var reader = new WireReader(data);
+            while (reader.TryReadKey(out var tag, out var wireType))
+            {
+                switch (tag)
+                {
+                    case 1 when wireType == WireFormat.LengthDelimited:
+                        m.GamePath = reader.ReadString();
+                        break;
+                    case 2 when wireType == WireFormat.LengthDelimited:
+                        m.Hash = reader.ReadString();
+                        break;
+                    case 3 when wireType == WireFormat.LengthDelimited:
+                        m.Content = reader.ReadBytes();
+                        break;
+                    case 4 when wireType == WireFormat.Varint:
+                        m.Size = reader.ReadSigned();
+                        break;
+                    default:
+                        reader.Skip(wireType);
+                        break;
+                }
+            }
+            return m;
+        }
+
+        internal static int SizeOf(global::FyteClub.AdvancedPlayerInfo m, int version)
+        {
+            var size = 0;
+            if (!string.IsNullOrEmpty(m.PlayerId))
+                size += WireFormat.KeySize(1) + WireFormat.StringSize(m.PlayerId);
+            if (!string.IsNullOrEmpty(m.PlayerName))
+                size += WireFormat.KeySize(2) + WireFormat.StringSize(m.PlayerName);
+            if ((int)m.State != 0)
+                size += WireFormat.KeySize(3) + WireFormat.SignedSize((int)m.State);
+            if (m.Mods != null)
+            {
+                foreach (var item in m.Mods)
+                    size += WireFormat.KeySize(4) + WireFormat.StringSize((item ?? string.Empty));
+            }
+            if (m.ActiveCollection != null)
+                size += WireFormat.KeySize(5) + WireFormat.StringSize(m.ActiveCollection);
+            if (m.ManipulationData != null)
+                size += WireFormat.KeySize(6) + WireFormat.StringSize(m.ManipulationData);
+            if (m.GlamourerDesign != null)
+                size += WireFormat.KeySize(7) + WireFormat.StringSize(m.GlamourerDesign);
+            if (m.GlamourerData != null)
+                size += WireFormat.KeySize(8) + WireFormat.StringSize(m.GlamourerData);
+            if (m.CustomizePlusProfile != null)
+                size += WireFormat.KeySize(9) + WireFormat.StringSize(m.CustomizePlusProfile);
+            if (m.CustomizePlusData != null)
+                size += WireFormat.KeySize(10) + WireFormat.StringSize(m.CustomizePlusData);
+            if (m.SimpleHeelsOffset.HasValue)
+                size += WireFormat.KeySize(11) + 4;
+            if (m.HeelsData != null)
+                size += WireFormat.KeySize(12) + WireFormat.StringSize(m.HeelsData);
+            if (m.HonorificTitle != null)
+                size += WireFormat.KeySize(13) + WireFormat.StringSize(m.HonorificTitle);
+            if (m.LockCode != null)
+                size += WireFormat.KeySize(14) + WireFormat.StringSize(m.LockCode);
+            if (m.WorldId != 0)
+                size += WireFormat.KeySize(15) + WireFormat.VarintSize(m.WorldId);
+            return size;
+        }
+
+        internal static void Write(ref WireWriter writer, global::FyteClub.AdvancedPlayerInfo m, int version)
+        {
+            if (!string.IsNullOrEmpty(m.PlayerId))
+            {
+                writer.WriteKey(1, WireFormat.LengthDelimited);
+                writer.WriteString(m.PlayerId);
+            }
+            if (!string.IsNullOrEmpty(m.PlayerName))
+            {
+                writer.WriteKey(2, WireFormat.LengthDelimited);
+                writer.WriteString(m.PlayerName);
+            }
+            if ((int)m.State != 0)
+            {
+                writer.WriteKey(3, WireFormat.Varint);
+                writer.WriteSigned((int)m.State);
+            }
+            if (m.Mods != null)
+            {
+                foreach (var listItem in m.Mods)
+                {
+                    var item = listItem ?? string.Empty;
+                    writer.WriteKey(4, WireFormat.LengthDelimited);
+                    writer.WriteString(item);
+                }
+            }
+            if (m.ActiveCollection != null)
+            {
+                writer.WriteKey(5, WireFormat.LengthDelimited);
+                writer.WriteString(m.ActiveCollection);
+            }
+            if (m.ManipulationData != null)
+            {
+                writer.WriteKey(6, WireFormat.LengthDelimited);
+                writer.WriteString(m.ManipulationData);
+            }
+            if (m.GlamourerDesign != null)
+            {
+                writer.WriteKey(7, WireFormat.LengthDelimited);
+                writer.WriteString(m.GlamourerDesign);
+            }
+            if (m.GlamourerData != null)
+            {
+                writer.WriteKey(8, WireFormat.LengthDelimited);
+                writer.WriteString(m.GlamourerData);
+            }
+            if (m.CustomizePlusProfile != null)
+            {
+                writer.WriteKey(9, WireFormat.LengthDelimited);
+                writer.WriteString(m.CustomizePlusProfile);
+            }
+            if (m.CustomizePlusData != null)
+            {
+                writer.WriteKey(10, WireFormat.LengthDelimited);
+                writer.WriteString(m.CustomizePlusData);
+            }
+            if (m.SimpleHeelsOffset.HasValue)
+            {
+                writer.WriteKey(11, WireFormat.Fixed32);
+                writer.WriteFloat(m.SimpleHeelsOffset.Value);
+            }
+            if (m.HeelsData != null)
+            {
+                writer.WriteKey(12, WireFormat.LengthDelimited);
+                writer.WriteString(m.HeelsData);
+            }
+            if (m.HonorificTitle != null)
+            {
+                writer.WriteKey(13, WireFormat.LengthDelimited);
+                writer.WriteString(m.HonorificTitle);
+            }
+            if (m.LockCode != null)
+            {
+                writer.WriteKey(14, WireFormat.LengthDelimited);
+                writer.WriteString(m.LockCode);
+            }
+            if (m.WorldId != 0)
+            {
+                writer.WriteKey(15, WireFormat.Varint);
+                writer.WriteVarint(m.WorldId);
+            }
+        }
+
+        internal static global::FyteClub.AdvancedPlayerInfo ReadPlayerInfo(ReadOnlySpan<byte> data)
+        {
+            var m = new global::FyteClub.AdvancedPlayerInfo();
+            var reader = new WireReader(data);
+            while (reader.TryReadKey(out var tag, out var wireType))
+            {
+                switch (tag)
+                {
+                    case 1 when wireType == WireFormat.LengthDelimited:
+                        m.PlayerId = reader.ReadString();
+                        break;
+                    case 2 when wireType == WireFormat.LengthDelimited:
+                        m.PlayerName = reader.ReadString();
+                        break;
+                    case 3 when wireType == WireFormat.Varint:
+                        m.State = (global::FyteClub.PlayerState)(int)reader.ReadSigned();
+                        break;
+                    case 4 when wireType == WireFormat.LengthDelimited:
+                        m.Mods.Add(reader.ReadString());
+                        break;
+                    case 5 when wireType == WireFormat.LengthDelimited:
+                        m.ActiveCollection = reader.ReadString();
+                        break;
+                    case 6 when wireType == WireFormat.LengthDelimited:
+                        m.ManipulationData = reader.ReadString();
+                        break;
+                    case 7 when wireType == WireFormat.LengthDelimited:
+                        m.GlamourerDesign = reader.ReadString();
+                        break;
+                    case 8 when wireType == WireFormat.LengthDelimited:
+                        m.GlamourerData = reader.ReadString();
+                        break;
+                    case 9 when wireType == WireFormat.LengthDelimited:
+                        m.CustomizePlusProfile = reader.ReadString();
+                        break;
+                    case 10 when wireType == WireFormat.LengthDelimited:
+                        m.CustomizePlusData = reader.ReadString();
+                        break;
+                    case 11 when wireType == WireFormat.Fixed32:
+                        m.SimpleHeelsOffset = reader.ReadFloat();
+                        break;
+                    case 12 when wireType == WireFormat.LengthDelimited:
+                        m.HeelsData = reader.ReadString();
+                        break;
+                    case 13 when wireType == WireFormat.LengthDelimited:
+                        m.HonorificTitle = reader.ReadString();
+                        break;
+                    case 14 when wireType == WireFormat.LengthDelimited:
+                        m.LockCode = reader.ReadString();
+                        break;
+                    case 15 when wireType == WireFormat.Varint:
+                        m.WorldId = (uint)reader.ReadVarint();
+                        break;
+                    default:
+                        reader.Skip(wireType);
+                        break;
+                }
+            }
+            return m;
+        }
+
+        internal static int SizeOf(global::FyteClub.Plugin.ModSystem.ProgressiveFileTransfer.FileChunk m, int version)
+        {
+            var size = 0;
+            if (!string.IsNullOrEmpty(m.SessionId))
+                size += WireFormat.KeySize(1) + WireFormat.StringSize(m.SessionId);
+            if (!string.IsNullOrEmpty(m.FileName))
+                size += WireFormat.KeySize(2) + WireFormat.StringSize(m.FileName);
+            if (m.ChunkIndex != 0)
+                size += WireFormat.KeySize(3) + WireFormat.SignedSize(m.ChunkIndex);
+            if (m.TotalChunks != 0)
+                size += WireFormat.KeySize(4) + WireFormat.SignedSize(m.TotalChunks);
+            if (m.Data != null && m.Data.Length > 0)
+                size += WireFormat.KeySize(5) + WireFormat.BytesSize(m.Data);
+            if (!string.IsNullOrEmpty(m.FileHash))
+                size += WireFormat.KeySize(6) + WireFormat.StringSize(m.FileHash);
+            if (m.ChannelIndex != 0)
+                size += WireFormat.KeySize(7) + WireFormat.SignedSize(m.ChannelIndex);
+            return size;
+        }
+
+        internal static void Write(ref WireWriter writer, global::FyteClub.Plugin.ModSystem.ProgressiveFileTransfer.FileChunk m, int version)
+        {
+            if (!string.IsNullOrEmpty(m.SessionId))
+            {
+                writer.WriteKey(1, WireFormat.LengthDelimited);
+                writer.WriteString(m.SessionId);
+            }
+            if (!string.IsNullOrEmpty(m.FileName))
+            {
+                writer.WriteKey(2, WireFormat.LengthDelimited);
+                writer.WriteString(m.FileName);
+            }
+            if (m.ChunkIndex != 0)
+            {
+                writer.WriteKey(3, WireFormat.Varint);
+                writer.WriteSigned(m.ChunkIndex);
+            }
+            if (m.TotalChunks != 0)
+            {
+                writer.WriteKey(4, WireFormat.Varint);
+                writer.WriteSigned(m.TotalChunks);
+            }
+            if (m.Data != null && m.Data.Length > 0)
+            {
+                writer.WriteKey(5, WireFormat.LengthDelimited);
+                writer.WriteBytes(m.Data);
+            }
+            if (!string.IsNullOrEmpty(m.FileHash))
+            {
+                writer.WriteKey(6, WireFormat.LengthDelimited);
+                writer.WriteString(m.FileHash);
+            }
+            if (m.ChannelIndex != 0)
+            {
+                writer.WriteKey(7, WireFormat.Varint);
+                writer.WriteSigned(m.ChannelIndex);
+            }
+        }
+
+        internal static global::FyteClub.Plugin.ModSystem.ProgressiveFileTransfer.FileChunk ReadFileChunk(ReadOnlySpan<byte> data)
+        {
+            var m = new global::FyteClub.Plugin.ModSystem.ProgressiveFileTransfer.FileChunk();
+            var reader = new WireReader(data);
+            while (reader.TryReadKey(out var tag, out var wireType))
+            {
+                switch (tag)
+                {
+                    case 1 when wireType == WireFormat.LengthDelimited:
+                        m.SessionId = reader.ReadString();
+                        break;
+                    case 2 when wireType == WireFormat.LengthDelimited:
+                        m.FileName = reader.ReadString();
+                        break;
+                    case 3 when wireType == WireFormat.Varint:
+                        m.ChunkIndex = (int)reader.ReadSigned();
+                        break;
+                    case 4 when wireType == WireFormat.Varint:
+                        m.TotalChunks = (int)reader.ReadSigned();
+                        break;
+                    case 5 when wireType == WireFormat.LengthDelimited:
+                        m.Data = reader.ReadBytes();
+                        break;
+                    case 6 when wireType == WireFormat.LengthDelimited:
+                        m.FileHash = reader.ReadString();
+                        break;
+                    case 7 when wireType == WireFormat.Varint:
+                        m.ChannelIndex = (int)reader.ReadSigned();
+                        break;
+                    default:
+                        reader.Skip(wireType);
+                        break;
+                }
+            }
+            return m;
+        }
+
+        internal static int SizeOf(global::FyteClub.ModSystem.ModDataRequest m, int version)
+        {
+            var size = 0;
+            if (!string.IsNullOrEmpty(m.MessageId))
+                size += WireFormat.KeySize(1) + WireFormat.StringSize(m.MessageId);
+            if (m.Timestamp != 0)
+                size += WireFormat.KeySize(2) + WireFormat.SignedSize(m.Timestamp);
+            if (m.ResponseTo != null)
+                size += WireFormat.KeySize(3) + WireFormat.StringSize(m.ResponseTo);
+            if (!string.IsNullOrEmpty(m.PlayerName))
+                size += WireFormat.KeySize(4) + WireFormat.StringSize(m.PlayerName);
+            if (m.LastKnownHash != null)
+                size += WireFormat.KeySize(5) + WireFormat.StringSize(m.LastKnownHash);
+            return size;
+        }
+
+        internal static void Write(ref WireWriter writer, global::FyteClub.ModSystem.ModDataRequest m, int version)
+        {
+            if (!string.IsNullOrEmpty(m.MessageId))
+            {
+                writer.WriteKey(1, WireFormat.LengthDelimited);
+                writer.WriteString(m.MessageId);
+            }
+            if (m.Timestamp != 0)
+            {
+                writer.WriteKey(2, WireFormat.Varint);
+                writer.WriteSigned(m.Timestamp);
+            }
+            if (m.ResponseTo != null)
+            {
+                writer.WriteKey(3, WireFormat.LengthDelimited);
+                writer.WriteString(m.ResponseTo);
+            }
+            if (!string.IsNullOrEmpty(m.PlayerName))
+            {
+                writer.WriteKey(4, WireFormat.LengthDelimited);
+                writer.WriteString(m.PlayerName);
+            }
+            if (m.LastKnownHash != null)
+            {
+                writer.WriteKey(5, WireFormat.LengthDelimited);
+                writer.WriteString(m.LastKnownHash);
+            }
+        }
+
+        internal static global::FyteClub.ModSystem.ModDataRequest ReadModDataRequest(ReadOnlySpan<byte> data)
+        {
+            var m = new global::FyteClub.ModSystem.ModDataRequest();
+            var reader = new WireReader(data);
+            while (reader.TryReadKey(out var tag, out var wireType))
+            {
+                switch (tag)
+                {
+                    case 1 when wireType == WireFormat.LengthDelimited:
+                        m.MessageId = reader.ReadString();
+                        break;
+                    case 2 when wireType == WireFormat.Varint:
+                        m.Timestamp = reader.ReadSigned();
+                        break;
+                    case 3 when wireType == WireFormat.LengthDelimited:
+                        m.ResponseTo = reader.ReadString();
+                        break;
+                    case 4 when wireType == WireFormat.LengthDelimited:
+                        m.PlayerName = reader.ReadString();
+                        break;
+                    case 5 when wireType == WireFormat.LengthDelimited:
+                        m.LastKnownHash = reader.ReadString();
+                        break;
+                    default:
+                        reader.Skip(wireType);
+                        break;
+                }
+            }
+            return m;
+        }
+
+        internal static int SizeOf(global::FyteClub.ModSystem.ModDataResponse m, int version)
+        {
+            var size = 0;
+            if (!string.IsNullOrEmpty(m.MessageId))
+                size += WireFormat.KeySize(1) + WireFormat.StringSize(m.MessageId);
+            if (m.Timestamp != 0)
+                size += WireFormat.KeySize(2) + WireFormat.SignedSize(m.Timestamp);
+            if (m.ResponseTo != null)
+                size += WireFormat.KeySize(3) + WireFormat.StringSize(m.ResponseTo);
+            if (!string.IsNullOrEmpty(m.PlayerName))
+                size += WireFormat.KeySize(4) + WireFormat.StringSize(m.PlayerName);
+            if (!string.IsNullOrEmpty(m.DataHash))
+                size += WireFormat.KeySize(5) + WireFormat.StringSize(m.DataHash);
+            if (m.PlayerInfo != null)
+                size += WireFormat.KeySize(6) + WireFormat.LengthPrefixedSize(SizeOf(m.PlayerInfo, version));
+            if (m.FileReplacements != null)
+            {
+                foreach (var entry in m.FileReplacements)
+                    size += WireFormat.KeySize(7) + WireFormat.LengthPrefixedSize((string.IsNullOrEmpty(entry.Key) ? 0 : 1 + WireFormat.StringSize(entry.Key)) + (entry.Value != null ? 1 + WireFormat.LengthPrefixedSize(SizeOf(entry.Value, version)) : 0));
+            }
+            if (m.IsCompressed)
+                size += WireFormat.KeySize(8) + 1;
+            if (version >= 2)
+            {
+                if (m.UploadDeferred)
+                    size += WireFormat.KeySize(9) + 1;
+            }
+            if (version >= 2)
+            {
+                if (m.QueuePosition != 0)
+                    size += WireFormat.KeySize(10) + WireFormat.SignedSize(m.QueuePosition);
+            }
+            if (version >= 2)
+            {
+                if (m.RetryAfterMs != 0)
+                    size += WireFormat.KeySize(11) + WireFormat.SignedSize(m.RetryAfterMs);
+            }
+            return size;
+        }
+
+        internal static void Write(ref WireWriter writer, global::FyteClub.ModSystem.ModDataResponse m, int version)
+        {
+            if (!string.IsNullOrEmpty(m.MessageId))
+            {
+                writer.WriteKey(1, WireFormat.LengthDelimited);
+                writer.WriteString(m.MessageId);
+            }
+            if (m.Timestamp != 0)
+            {
+                writer.WriteKey(2, WireFormat.Varint);
+                writer.WriteSigned(m.Timestamp);
+            }
+            if (m.ResponseTo != null)
+            {
+                writer.WriteKey(3, WireFormat.LengthDelimited);
+                writer.WriteString(m.ResponseTo);
+            }
+            if (!string.IsNullOrEmpty(m.PlayerName))
+            {
+                writer.WriteKey(4, WireFormat.LengthDelimited);
+                writer.WriteString(m.PlayerName);
+            }
+            if (!string.IsNullOrEmpty(m.DataHash))
+            {
+                writer.WriteKey(5, WireFormat.LengthDelimited);
+                writer.WriteString(m.DataHash);
+            }
+            if (m.PlayerInfo != null)
+            {
+                writer.WriteKey(6, WireFormat.LengthDelimited);
+                writer.WriteLength(SizeOf(m.PlayerInfo, version));
+                Write(ref writer, m.PlayerInfo, version);
+            }
+            if (m.FileReplacements != null)
+            {
+                foreach (var entry in m.FileReplacements)
+                {
+                    writer.WriteKey(7, WireFormat.LengthDelimited);
+                    writer.WriteLength((string.IsNullOrEmpty(entry.Key) ? 0 : 1 + WireFormat.StringSize(entry.Key)) + (entry.Value != null ? 1 + WireFormat.LengthPrefixedSize(SizeOf(entry.Value, version)) : 0));
+                    if (!string.IsNullOrEmpty(entry.Key))
+                    {
+                        writer.WriteKey(1, WireFormat.LengthDelimited);
+                        writer.WriteString(entry.Key);
+                    }
+                    if (entry.Value != null)
+                    {
+                        writer.WriteKey(2, WireFormat.LengthDelimited);
+                        writer.WriteLength(SizeOf(entry.Value, version));
+                        Write(ref writer, entry.Value, version);
+                    }
+                }
+            }
+            if (m.IsCompressed)
+            {
+                writer.WriteKey(8, WireFormat.Varint);
+                writer.WriteVarint(m.IsCompressed ? 1UL : 0UL);
+            }
+            if (version >= 2)
+            {
+                if (m.UploadDeferred)
+                {
+                    writer.WriteKey(9, WireFormat.Varint);
+                    writer.WriteVarint(m.UploadDeferred ? 1UL : 0UL);
+                }
+            }
+            if (version >= 2)
+            {
+                if (m.QueuePosition != 0)
+                {
+                    writer.WriteKey(10, WireFormat.Varint);
+                    writer.WriteSigned(m.QueuePosition);
+                }
+            }
+            if (version >= 2)
+            {
+                if (m.RetryAfterMs != 0)
+                {
+                    writer.WriteKey(11, WireFormat.Varint);
+                    writer.WriteSigned(m.RetryAfterMs);
+                }
+            }
+        }
+
+        internal static global::FyteClub.ModSystem.ModDataResponse ReadModDataResponse(ReadOnlySpan<byte> data)
+        {
+            var m = new global::FyteClub.ModSystem.ModDataResponse();
+            var reader = new WireReader(data);
+            while (reader.TryReadKey(out var tag, out var wireType))
+            {
+                switch (tag)
+                {
+                    case 1 when wireType == WireFormat.LengthDelimited:
+                        m.MessageId = reader.ReadString();
+                        break;
+                    case 2 when wireType == WireFormat.Varint:
+                        m.Timestamp = reader.ReadSigned();
+                        break;
+                    case 3 when wireType == WireFormat.LengthDelimited:
+                        m.ResponseTo = reader.ReadString();
+                        break;
+                    case 4 when wireType == WireFormat.LengthDelimited:
+                        m.PlayerName = reader.ReadString();
+                        break;
+                    case 5 when wireType == WireFormat.LengthDelimited:
+                        m.DataHash = reader.ReadString();
+                        break;
+                    case 6 when wireType == WireFormat.LengthDelimited:
+                        m.PlayerInfo = ReadPlayerInfo(reader.ReadLengthDelimited());
+                        break;
+                    case 7 when wireType == WireFormat.LengthDelimited:
+                    {
+                        var entryReader = new WireReader(reader.ReadLengthDelimited());
+                        var key = string.Empty;
+                        global::FyteClub.TransferableFile value = new();
+                        while (entryReader.TryReadKey(out var entryTag, out var entryWireType))
+                        {
+                            if (entryTag == 1 && entryWireType == WireFormat.LengthDelimited)
+                                key = entryReader.ReadString();
+                            else if (entryTag == 2 && entryWireType == WireFormat.LengthDelimited)
+                                value = ReadTransferableFile(entryReader.ReadLengthDelimited());
+                            else
+                                entryReader.Skip(entryWireType);
+                        }
+                        m.FileReplacements[key] = value;
+                        break;
+                    }
+                    case 8 when wireType == WireFormat.Varint:
+                        m.IsCompressed = reader.ReadVarint() != 0;
+                        break;
+                    case 9 when wireType == WireFormat.Varint:
+                        m.UploadDeferred = reader.ReadVarint() != 0;
+                        break;
+                    case 10 when wireType == WireFormat.Varint:
+                        m.QueuePosition = (int)reader.ReadSigned();
+                        break;
+                    case 11 when wireType == WireFormat.Varint:
+                        m.RetryAfterMs = (int)reader.ReadSigned();
+                        break;
+                    default:
+                        reader.Skip(wireType);
+                        break;
+                }
+            }
+            return m;
+        }
+
+        internal static int SizeOf(global::FyteClub.ModSystem.ComponentRequest m, int version)
+        {
+            var size = 0;
+            if (!string.IsNullOrEmpty(m.MessageId))
+                size += WireFormat.KeySize(1) + WireFormat.StringSize(m.MessageId);
+            if (m.Timestamp != 0)
+                size += WireFormat.KeySize(2) + WireFormat.SignedSize(m.Timestamp);
+            if (m.ResponseTo != null)
+                size += WireFormat.KeySize(3) + WireFormat.StringSize(m.ResponseTo);
+            if (m.RequestedHashes != null)
+            {
+                foreach (var item in m.RequestedHashes)
+                    size += WireFormat.KeySize(4) + WireFormat.StringSize((item ?? string.Empty));
+            }
+            if (!string.IsNullOrEmpty(m.PlayerName))
+                size += WireFormat.KeySize(5) + WireFormat.StringSize(m.PlayerName);
+            return size;
+        }
+
+        internal static void Write(ref WireWriter writer, global::FyteClub.ModSystem.ComponentRequest m, int version)
+        {
+            if (!string.IsNullOrEmpty(m.MessageId))
+            {
+                writer.WriteKey(1, WireFormat.LengthDelimited);
+                writer.WriteString(m.MessageId);
+            }
+            if (m.Timestamp != 0)
+            {
+                writer.WriteKey(2, WireFormat.Varint);
+                writer.WriteSigned(m.Timestamp);
+            }
+            if (m.ResponseTo != null)
+            {
+                writer.WriteKey(3, WireFormat.LengthDelimited);
+                writer.WriteString(m.ResponseTo);
+            }
+            if (m.RequestedHashes != null)
+            {
+                foreach (var listItem in m.RequestedHashes)
+                {
+                    var item = listItem ?? string.Empty;
+                    writer.WriteKey(4, WireFormat.LengthDelimited);
+                    writer.WriteString(item);
+                }
+            }
+            if (!string.IsNullOrEmpty(m.PlayerName))
+            {
+                writer.WriteKey(5, WireFormat.LengthDelimited);
+                writer.WriteString(m.PlayerName);
+            }
+        }
+
+        internal static global::FyteClub.ModSystem.ComponentRequest ReadComponentRequest(ReadOnlySpan<byte> data)
+        {
+            var m = new global::FyteClub.ModSystem.ComponentRequest();
+            var reader = new WireReader(data);
+            while (reader.TryReadKey(out var tag, out var wireType))
+            {
+                switch (tag)
+                {
+                    case 1 when wireType == WireFormat.LengthDelimited:
+                        m.MessageId = reader.ReadString();
+                        break;
+                    case 2 when wireType == WireFormat.Varint:
+                        m.Timestamp = reader.ReadSigned();
+                        break;
+                    case 3 when wireType == WireFormat.LengthDelimited:
+                        m.ResponseTo = reader.ReadString();
+                        break;
+                    case 4 when wireType == WireFormat.LengthDelimited:
+                        m.RequestedHashes.Add(reader.ReadString());
+                        break;
+                    case 5 when wireType == WireFormat.LengthDelimited:
+                        m.PlayerName = reader.ReadString();
+                        break;
+                    default:
+                        reader.Skip(wireType);
+                        break;
+                }
+            }
+            return m;
+        }
+
+        internal static int SizeOf(global::FyteClub.ModSystem.ComponentResponse m, int version)
+        {
+            var size = 0;
+            if (!string.IsNullOrEmpty(m.MessageId))
+                size += WireFormat.KeySize(1) + WireFormat.StringSize(m.MessageId);
+            if (m.Timestamp != 0)
+                size += WireFormat.KeySize(2) + WireFormat.SignedSize(m.Timestamp);
+            if (m.ResponseTo != null)
+                size += WireFormat.KeySize(3) + WireFormat.StringSize(m.ResponseTo);
+            if (m.Components != null)
+            {
+                foreach (var entry in m.Components)
+                    size += WireFormat.KeySize(4) + WireFormat.LengthPrefixedSize((string.IsNullOrEmpty(entry.Key) ? 0 : 1 + WireFormat.StringSize(entry.Key)) + (entry.Value != null ? 1 + WireFormat.LengthPrefixedSize(SizeOf(entry.Value, version)) : 0));
+            }
+            if (m.MissingHashes != null)
+            {
+                foreach (var item in m.MissingHashes)
+                    size += WireFormat.KeySize(5) + WireFormat.StringSize((item ?? string.Empty));
+            }
+            return size;
+        }
+
+        internal static void Write(ref WireWriter writer, global::FyteClub.ModSystem.ComponentResponse m, int version)
+        {
+            if (!string.IsNullOrEmpty(m.MessageId))
+            {
+                writer.WriteKey(1, WireFormat.LengthDelimited);
+                writer.WriteString(m.MessageId);
+            }
+            if (m.Timestamp != 0)
+            {
+                writer.WriteKey(2, WireFormat.Varint);
+                writer.WriteSigned(m.Timestamp);
+            }
+            if (m.ResponseTo != null)
+            {
+                writer.WriteKey(3, WireFormat.LengthDelimited);
+                writer.WriteString(m.ResponseTo);
+            }
+            if (m.Components != null)
+            {
+                foreach (var entry in m.Components)
+                {
+                    writer.WriteKey(4, WireFormat.LengthDelimited);
+                    writer.WriteLength((string.IsNullOrEmpty(entry.Key) ? 0 : 1 + WireFormat.StringSize(entry.Key)) + (entry.Value != null ? 1 + WireFormat.LengthPrefixedSize(SizeOf(entry.Value, version)) : 0));
+                    if (!string.IsNullOrEmpty(entry.Key))
+                    {
+                        writer.WriteKey(1, WireFormat.LengthDelimited);
+                        writer.WriteString(entry.Key);
+                    }
+                    if (entry.Value != null)
+                    {
+                        writer.WriteKey(2, WireFormat.LengthDelimited);
+                        writer.WriteLength(SizeOf(entry.Value, version));
+                        Write(ref writer, entry.Value, version);
+                    }
+                }
+            }
+            if (m.MissingHashes != null)
+            {
+                foreach (var listItem in m.MissingHashes)
+                {
+                    var item = listItem ?? string.Empty;
+                    writer.WriteKey(5, WireFormat.LengthDelimited);
+                    writer.WriteString(item);
+                }
+            }
+        }
+
+        internal static global::FyteClub.ModSystem.ComponentResponse ReadComponentResponse(ReadOnlySpan<byte> data)
+        {
+            var m = new global::FyteClub.ModSystem.ComponentResponse();
+            var reader = new WireReader(data);
+            while (reader.TryReadKey(out var tag, out var wireType))
+            {
+                switch (tag)
+                {
+                    case 1 when wireType == WireFormat.LengthDelimited:
+                        m.MessageId = reader.ReadString();
+                        break;
+                    case 2 when wireType == WireFormat.Varint:
+                        m.Timestamp = reader.ReadSigned();
+                        break;
+                    case 3 when wireType == WireFormat.LengthDelimited:
+                        m.ResponseTo = reader.ReadString();
+                        break;
+                    case 4 when wireType == WireFormat.LengthDelimited:
+                    {
+                        var entryReader = new WireReader(reader.ReadLengthDelimited());
+                        var key = string.Empty;
+                        global::FyteClub.TransferableFile value = new();
+                        while (entryReader.TryReadKey(out var entryTag, out var entryWireType))
+                        {
+                            if (entryTag == 1 && entryWireType == WireFormat.LengthDelimited)
+                                key = entryReader.ReadString();
+                            else if (entryTag == 2 && entryWireType == WireFormat.LengthDelimited)
+                                value = ReadTransferableFile(entryReader.ReadLengthDelimited());
+                            else
+                                entryReader.Skip(entryWireType);
+                        }
+                        m.Components[key] = value;
+                        break;
+                    }
+                    case 5 when wireType == WireFormat.LengthDelimited:
+                        m.MissingHashes.Add(reader.ReadString());
+                        break;
+                    default:
+                        reader.Skip(wireType);
+                        break;
+                }
+            }
+            return m;
+        }
+
+        internal static int SizeOf(global::FyteClub.ModSystem.ModApplicationRequest m, int version)
+        {
+            var size = 0;
+            if (!string.IsNullOrEmpty(m.MessageId))
+                size += WireFormat.KeySize(1) + WireFormat.StringSize(m.MessageId);
+            if (m.Timestamp != 0)
+                size += WireFormat.KeySize(2) + WireFormat.SignedSize(m.Timestamp);
+            if (m.ResponseTo != null)
+                size += WireFormat.KeySize(3) + WireFormat.StringSize(m.ResponseTo);
+            if (!string.IsNullOrEmpty(m.TargetPlayerName))
+                size += WireFormat.KeySize(4) + WireFormat.StringSize(m.TargetPlayerName);
+            if (!string.IsNullOrEmpty(m.SourcePlayerName))
+                size += WireFormat.KeySize(5) + WireFormat.StringSize(m.SourcePlayerName);
+            if (m.PlayerInfo != null)
+                size += WireFormat.KeySize(6) + WireFormat.LengthPrefixedSize(SizeOf(m.PlayerInfo, version));
+            if (m.FileReplacements != null)
+            {
+                foreach (var entry in m.FileReplacements)
+                    size += WireFormat.KeySize(7) + WireFormat.LengthPrefixedSize((string.IsNullOrEmpty(entry.Key) ? 0 : 1 + WireFormat.StringSize(entry.Key)) + (entry.Value != null ? 1 + WireFormat.LengthPrefixedSize(SizeOf(entry.Value, version)) : 0));
+            }
+            return size;
+        }
+
+        internal static void Write(ref WireWriter writer, global::FyteClub.ModSystem.ModApplicationRequest m, int version)
+        {
+            if (!string.IsNullOrEmpty(m.MessageId))
+            {
+                writer.WriteKey(1, WireFormat.LengthDelimited);
+                writer.WriteString(m.MessageId);
+            }
+            if (m.Timestamp != 0)
+            {
+                writer.WriteKey(2, WireFormat.Varint);
+                writer.WriteSigned(m.Timestamp);
+            }
+            if (m.ResponseTo != null)
+            {
+                writer.WriteKey(3, WireFormat.LengthDelimited);
+                writer.WriteString(m.ResponseTo);
+            }
+            if (!string.IsNullOrEmpty(m.TargetPlayerName))
+            {
+                writer.WriteKey(4, WireFormat.LengthDelimited);
+                writer.WriteString(m.TargetPlayerName);
+            }
+            if (!string.IsNullOrEmpty(m.SourcePlayerName))
+            {
+                writer.WriteKey(5, WireFormat.LengthDelimited);
+                writer.WriteString(m.SourcePlayerName);
+            }
+            if (m.PlayerInfo != null)
+            {
+                writer.WriteKey(6, WireFormat.LengthDelimited);
+                writer.WriteLength(SizeOf(m.PlayerInfo, version));
+                Write(ref writer, m.PlayerInfo, version);
+            }
+            if (m.FileReplacements != null)
+            {
+                foreach (var entry in m.FileReplacements)
+                {
+                    writer.WriteKey(7, WireFormat.LengthDelimited);
+                    writer.WriteLength((string.IsNullOrEmpty(entry.Key) ? 0 : 1 + WireFormat.StringSize(entry.Key)) + (entry.Value != null ? 1 + WireFormat.LengthPrefixedSize(SizeOf(entry.Value, version)) : 0));
+                    if (!string.IsNullOrEmpty(entry.Key))
+                    {
+                        writer.WriteKey(1, WireFormat.LengthDelimited);
+                        writer.WriteString(entry.Key);
+                    }
+                    if (entry.Value != null)
+                    {
+                        writer.WriteKey(2, WireFormat.LengthDelimited);
+                        writer.WriteLength(SizeOf(entry.Value, version));
+                        Write(ref writer, entry.Value, version);
+                    }
+                }
+            }
+        }
+
+        internal static global::FyteClub.ModSystem.ModApplicationRequest ReadModApplicationRequest(ReadOnlySpan<byte> data)
+        {
+            var m = new global::FyteClub.ModSystem.ModApplicationRequest();
+            var reader = new WireReader(data);
+            while (reader.TryReadKey(out var tag, out var wireType))
+            {
+                switch (tag)
+                {
+                    case 1 when wireType == WireFormat.LengthDelimited:
+                        m.MessageId = reader.ReadString();
+                        break;
+                    case 2 when wireType == WireFormat.Varint:
+                        m.Timestamp = reader.ReadSigned();
+                        break;
+                    case 3 when wireType == WireFormat.LengthDelimited:
+                        m.ResponseTo = reader.ReadString();
+                        break;
+                    case 4 when wireType == WireFormat.LengthDelimited:
+                        m.TargetPlayerName = reader.ReadString();
+                        break;
+                    case 5 when wireType == WireFormat.LengthDelimited:
+                        m.SourcePlayerName = reader.ReadString();
+                        break;
+                    case 6 when wireType == WireFormat.LengthDelimited:
+                        m.PlayerInfo = ReadPlayerInfo(reader.ReadLengthDelimited());
+                        break;
+                    case 7 when wireType == WireFormat.LengthDelimited:
+                    {
+                        var entryReader = new WireReader(reader.ReadLengthDelimited());
+                        var key = string.Empty;
+                        global::FyteClub.TransferableFile value = new();
+                        while (entryReader.TryReadKey(out var entryTag, out var entryWireType))
+                        {
+                            if (entryTag == 1 && entryWireType == WireFormat.LengthDelimited)
+                                key = entryReader.ReadString();
+                            else if (entryTag == 2 && entryWireType == WireFormat.LengthDelimited)
+                                value = ReadTransferableFile(entryReader.ReadLengthDelimited());
+                            else
+                                entryReader.Skip(entryWireType);
+                        }
+                        m.FileReplacements[key] = value;
+                        break;
+                    }
+                    default:
+                        reader.Skip(wireType);
+                        break;
+                }
+            }
+            return m;
+        }
+
+        internal static int SizeOf(global::FyteClub.ModSystem.ModApplicationResponse m, int version)
+        {
+            var size = 0;
+            if (!string.IsNullOrEmpty(m.MessageId))
+                size += WireFormat.KeySize(1) + WireFormat.StringSize(m.MessageId);
+            if (m.Timestamp != 0)
+                size += WireFormat.KeySize(2) + WireFormat.SignedSize(m.Timestamp);
+            if (m.ResponseTo != null)
+                size += WireFormat.KeySize(3) + WireFormat.StringSize(m.ResponseTo);
+            if (m.Success)
+                size += WireFormat.KeySize(4) + 1;
+            if (m.ErrorMessage != null)
+                size += WireFormat.KeySize(5) + WireFormat.StringSize(m.ErrorMessage);
+            if (!string.IsNullOrEmpty(m.PlayerName))
+                size += WireFormat.KeySize(6) + WireFormat.StringSize(m.PlayerName);
+            return size;
+        }
+
+        internal static void Write(ref WireWriter writer, global::FyteClub.ModSystem.ModApplicationResponse m, int version)
+        {
+            if (!string.IsNullOrEmpty(m.MessageId))
+            {
+                writer.WriteKey(1, WireFormat.LengthDelimited);
+                writer.WriteString(m.MessageId);
+            }
+            if (m.Timestamp != 0)
+            {
+                writer.WriteKey(2, WireFormat.Varint);
+                writer.WriteSigned(m.Timestamp);
+            }
+            if (m.ResponseTo != null)
+            {
+                writer.WriteKey(3, WireFormat.LengthDelimited);
+                writer.WriteString(m.ResponseTo);
+            }
+            if (m.Success)
+            {
+                writer.WriteKey(4, WireFormat.Varint);
+                writer.WriteVarint(m.Success ? 1UL : 0UL);
+            }
+            if (m.ErrorMessage != null)
+            {
+                writer.WriteKey(5, WireFormat.LengthDelimited);
+                writer.WriteString(m.ErrorMessage);
+            }
+            if (!string.IsNullOrEmpty(m.PlayerName))
+            {
+                writer.WriteKey(6, WireFormat.LengthDelimited);
+                writer.WriteString(m.PlayerName);
+            }
+        }
+
+        internal static global::FyteClub.ModSystem.ModApplicationResponse ReadModApplicationResponse(ReadOnlySpan<byte> data)
+        {
+            var m = new global::FyteClub.ModSystem.ModApplicationResponse();
+            var reader = new WireReader(data);
+            while (reader.TryReadKey(out var tag, out var wireType))
+            {
+                switch (tag)
+                {
+                    case 1 when wireType == WireFormat.LengthDelimited:
+                        m.MessageId = reader.ReadString();
+                        break;
+                    case 2 when wireType == WireFormat.Varint:
+                        m.Timestamp = reader.ReadSigned();
+                        break;
+                    case 3 when wireType == WireFormat.LengthDelimited:
+                        m.ResponseTo = reader.ReadString();
+                        break;
+                    case 4 when wireType == WireFormat.Varint:
+                        m.Success = reader.ReadVarint() != 0;
+                        break;
+                    case 5 when wireType == WireFormat.LengthDelimited:
+                        m.ErrorMessage = reader.ReadString();
+                        break;
+                    case 6 when wireType == WireFormat.LengthDelimited:
+                        m.PlayerName = reader.ReadString();
+                        break;
+                    default:
+                        reader.Skip(wireType);
+                        break;
+                }
+            }
+            return m;
+        }
+
+        internal static int SizeOf(global::FyteClub.ModSystem.SyncCompleteMessage m, int version)
+        {
+            var size = 0;
+            if (!string.IsNullOrEmpty(m.MessageId))
+                size += WireFormat.KeySize(1) + WireFormat.StringSize(m.MessageId);
+            if (m.Timestamp != 0)
+                size += WireFormat.KeySize(2) + WireFormat.SignedSize(m.Timestamp);
+            if (m.ResponseTo != null)
+                size += WireFormat.KeySize(3) + WireFormat.StringSize(m.ResponseTo);
+            if (!string.IsNullOrEmpty(m.PlayerName))
+                size += WireFormat.KeySize(4) + WireFormat.StringSize(m.PlayerName);
+            if (m.ProcessedFiles != 0)
+                size += WireFormat.KeySize(5) + WireFormat.SignedSize(m.ProcessedFiles);
+            if (m.TotalBytes != 0)
+                size += WireFormat.KeySize(6) + WireFormat.SignedSize(m.TotalBytes);
+            return size;
+        }
+
+        internal static void Write(ref WireWriter writer, global::FyteClub.ModSystem.SyncCompleteMessage m, int version)
+        {
+            if (!string.IsNullOrEmpty(m.MessageId))
+            {
+                writer.WriteKey(1, WireFormat.LengthDelimited);
+                writer.WriteString(m.MessageId);
+            }
+            if (m.Timestamp != 0)
+            {
+                writer.WriteKey(2, WireFormat.Varint);
+                writer.WriteSigned(m.Timestamp);
+            }
+            if (m.ResponseTo != null)
+            {
+                writer.WriteKey(3, WireFormat.LengthDelimited);
+                writer.WriteString(m.ResponseTo);
+            }
+            if (!string.IsNullOrEmpty(m.PlayerName))
+            {
+                writer.WriteKey(4, WireFormat.LengthDelimited);
+                writer.WriteString(m.PlayerName);
+            }
+            if (m.ProcessedFiles != 0)
+            {
+                writer.WriteKey(5, WireFormat.Varint);
+                writer.WriteSigned(m.ProcessedFiles);
+            }
+            if (m.TotalBytes != 0)
+            {
+                writer.WriteKey(6, WireFormat.Varint);
+                writer.WriteSigned(m.TotalBytes);
+            }
+        }
+
+        internal static global::FyteClub.ModSystem.SyncCompleteMessage ReadSyncCompleteMessage(ReadOnlySpan<byte> data)
+        {
+            var m = new global::FyteClub.ModSystem.SyncCompleteMessage();
+            var reader = new WireReader(data);
+            while (reader.TryReadKey(out var tag, out var wireType))
+            {
+                switch (tag)
+                {
+                    case 1 when wireType == WireFormat.LengthDelimited:
+                        m.MessageId = reader.ReadString();
+                        break;
+                    case 2 when wireType == WireFormat.Varint:
+                        m.Timestamp = reader.ReadSigned();
+                        break;
+                    case 3 when wireType == WireFormat.LengthDelimited:
+                        m.ResponseTo = reader.ReadString();
+                        break;
+                    case 4 when wireType == WireFormat.LengthDelimited:
+                        m.PlayerName = reader.ReadString();
+                        break;
+                    case 5 when wireType == WireFormat.Varint:
+                        m.ProcessedFiles = (int)reader.ReadSigned();
+                        break;
+                    case 6 when wireType == WireFormat.Varint:
+                        m.TotalBytes = reader.ReadSigned();
+                        break;
+                    default:
+                        reader.Skip(wireType);
+                        break;
+                }
+            }
+            return m;
+        }
+
+        internal static int SizeOf(global::FyteClub.ModSystem.ErrorMessage m, int version)
+        {
+            var size = 0;
+            if (!string.IsNullOrEmpty(m.MessageId))
+                size += WireFormat.KeySize(1) + WireFormat.StringSize(m.MessageId);
+            if (m.Timestamp != 0)
+                size += WireFormat.KeySize(2) + WireFormat.SignedSize(m.Timestamp);
+            if (m.ResponseTo != null)
+                size += WireFormat.KeySize(3) + WireFormat.StringSize(m.ResponseTo);
+            if (!string.IsNullOrEmpty(m.ErrorCode))
+                size += WireFormat.KeySize(4) + WireFormat.StringSize(m.ErrorCode);
+            if (!string.IsNullOrEmpty(m.ErrorDescription))
+                size += WireFormat.KeySize(5) + WireFormat.StringSize(m.ErrorDescription);
+            if (m.FailedOperation != null)
+                size += WireFormat.KeySize(6) + WireFormat.StringSize(m.FailedOperation);
+            return size;
+        }
+
+        internal static void Write(ref WireWriter writer, global::FyteClub.ModSystem.ErrorMessage m, int version)
+        {
+            if (!string.IsNullOrEmpty(m.MessageId))
+            {
+                writer.WriteKey(1, WireFormat.LengthDelimited);
+                writer.WriteString(m.MessageId);
+            }
+            if (m.Timestamp != 0)
+            {
+                writer.WriteKey(2, WireFormat.Varint);
+                writer.WriteSigned(m.Timestamp);
+            }
+            if (m.ResponseTo != null)
+            {
+                writer.WriteKey(3, WireFormat.LengthDelimited);
+                writer.WriteString(m.ResponseTo);
+            }
+            if (!string.IsNullOrEmpty(m.ErrorCode))
+            {
+                writer.WriteKey(4, WireFormat.LengthDelimited);
+                writer.WriteString(m.ErrorCode);
+            }
+            if (!string.IsNullOrEmpty(m.ErrorDescription))
+            {
+                writer.WriteKey(5, WireFormat.LengthDelimited);
+                writer.WriteString(m.ErrorDescription);
+            }
+            if (m.FailedOperation != null)
+            {
+                writer.WriteKey(6, WireFormat.LengthDelimited);
+                writer.WriteString(m.FailedOperation);
+            }
+        }
+
+        internal static global::FyteClub.ModSystem.ErrorMessage ReadErrorMessage(ReadOnlySpan<byte> data)
+        {
+            var m = new global::FyteClub.ModSystem.ErrorMessage();
+            var reader = new WireReader(data);
+            while (reader.TryReadKey(out var tag, out var wireType))
+            {
+                switch (tag)
+                {
+                    case 1 when wireType == WireFormat.LengthDelimited:
+                        m.MessageId = reader.ReadString();
+                        break;
+                    case 2 when wireType == WireFormat.Varint:
+                        m.Timestamp = reader.ReadSigned();
+                        break;
+                    case 3 when wireType == WireFormat.LengthDelimited:
+                        m.ResponseTo = reader.ReadString();
+                        break;
+                    case 4 when wireType == WireFormat.LengthDelimited:
+                        m.ErrorCode = reader.ReadString();
+                        break;
+                    case 5 when wireType == WireFormat.LengthDelimited:
+                        m.ErrorDescription = reader.ReadString();
+                        break;
+                    case 6 when wireType == WireFormat.LengthDelimited:
+                        m.FailedOperation = reader.ReadString();
+                        break;
+                    default:
+                        reader.Skip(wireType);
+                        break;
+                }
+            }
+            return m;
+        }
+
+        internal static int SizeOf(global::FyteClub.ModSystem.ChunkedMessage m, int version)
+        {
+            var size = 0;
+            if (!string.IsNullOrEmpty(m.MessageId))
+                size += WireFormat.KeySize(1) + WireFormat.StringSize(m.MessageId);
+            if (m.Timestamp != 0)
+                size += WireFormat.KeySize(2) + WireFormat.SignedSize(m.Timestamp);
+            if (m.ResponseTo != null)
+                size += WireFormat.KeySize(3) + WireFormat.StringSize(m.ResponseTo);
+            if (!string.IsNullOrEmpty(m.ChunkId))
+                size += WireFormat.KeySize(4) + WireFormat.StringSize(m.ChunkId);
+            if (m.ChunkIndex != 0)
+                size += WireFormat.KeySize(5) + WireFormat.SignedSize(m.ChunkIndex);
+            if (m.TotalChunks != 0)
+                size += WireFormat.KeySize(6) + WireFormat.SignedSize(m.TotalChunks);
+            if (m.ChunkData != null && m.ChunkData.Length > 0)
+                size += WireFormat.KeySize(7) + WireFormat.BytesSize(m.ChunkData);
+            if ((int)m.OriginalMessageType != 0)
+                size += WireFormat.KeySize(8) + WireFormat.SignedSize((int)m.OriginalMessageType);
+            return size;
+        }
+
+        internal static void Write(ref WireWriter writer, global::FyteClub.ModSystem.ChunkedMessage m, int version)
+        {
+            if (!string.IsNullOrEmpty(m.MessageId))
+            {
+                writer.WriteKey(1, WireFormat.LengthDelimited);
+                writer.WriteString(m.MessageId);
+            }
+            if (m.Timestamp != 0)
+            {
+                writer.WriteKey(2, WireFormat.Varint);
+                writer.WriteSigned(m.Timestamp);
+            }
+            if (m.ResponseTo != null)
+            {
+                writer.WriteKey(3, WireFormat.LengthDelimited);
+                writer.WriteString(m.ResponseTo);
+            }
+            if (!string.IsNullOrEmpty(m.ChunkId))
+            {
+                writer.WriteKey(4, WireFormat.LengthDelimited);
+                writer.WriteString(m.ChunkId);
+            }
+            if (m.ChunkIndex != 0)
+            {
+                writer.WriteKey(5, WireFormat.Varint);
+                writer.WriteSigned(m.ChunkIndex);
+            }
+            if (m.TotalChunks != 0)
+            {
+                writer.WriteKey(6, WireFormat.Varint);
+                writer.WriteSigned(m.TotalChunks);
+            }
+            if (m.ChunkData != null && m.ChunkData.Length > 0)
+            {
+                writer.WriteKey(7, WireFormat.LengthDelimited);
+                writer.WriteBytes(m.ChunkData);
+            }
+            if ((int)m.OriginalMessageType != 0)
+            {
+                writer.WriteKey(8, WireFormat.Varint);
+                writer.WriteSigned((int)m.OriginalMessageType);
+            }
+        }
+
+        internal static global::FyteClub.ModSystem.ChunkedMessage ReadChunkedMessage(ReadOnlySpan<byte> data)
+        {
+            var m = new global::FyteClub.ModSystem.ChunkedMessage();
+            var reader = new WireReader(data);
+            while (reader.TryReadKey(out var tag, out var wireType))
+            {
+                switch (tag)
+                {
+                    case 1 when wireType == WireFormat.LengthDelimited:
+                        m.MessageId = reader.ReadString();
+                        break;
+                    case 2 when wireType == WireFormat.Varint:
+                        m.Timestamp = reader.ReadSigned();
+                        break;
+                    case 3 when wireType == WireFormat.LengthDelimited:
+                        m.ResponseTo = reader.ReadString();
+                        break;
+                    case 4 when wireType == WireFormat.LengthDelimited:
+                        m.ChunkId = reader.ReadString();
+                        break;
+                    case 5 when wireType == WireFormat.Varint:
+                        m.ChunkIndex = (int)reader.ReadSigned();
+                        break;
+                    case 6 when wireType == WireFormat.Varint:
+                        m.TotalChunks = (int)reader.ReadSigned();
+                        break;
+                    case 7 when wireType == WireFormat.LengthDelimited:
+                        m.ChunkData = reader.ReadBytes();
+                        break;
+                    case 8 when wireType == WireFormat.Varint:
+                        m.OriginalMessageType = (global::FyteClub.ModSystem.P2PModMessageType)(int)reader.ReadSigned();
+                        break;
+                    default:
+                        reader.Skip(wireType);
+                        break;
+                }
+            }
+            return m;
+        }
+
+        internal static int SizeOf(global::FyteClub.ModSystem.FileChunkMessage m, int version)
+        {
+            var size = 0;
+            if (!string.IsNullOrEmpty(m.MessageId))
+                size += WireFormat.KeySize(1) + WireFormat.StringSize(m.MessageId);
+            if (m.Timestamp != 0)
+                size += WireFormat.KeySize(2) + WireFormat.SignedSize(m.Timestamp);
+            if (m.ResponseTo != null)
+                size += WireFormat.KeySize(3) + WireFormat.StringSize(m.ResponseTo);
+            if (m.Chunk != null)
+                size += WireFormat.KeySize(4) + WireFormat.LengthPrefixedSize(SizeOf(m.Chunk, version));
+            return size;
+        }
+
+        internal static void Write(ref WireWriter writer, global::FyteClub.ModSystem.FileChunkMessage m, int version)
+        {
+            if (!string.IsNullOrEmpty(m.MessageId))
+            {
+                writer.WriteKey(1, WireFormat.LengthDelimited);
+                writer.WriteString(m.MessageId);
+            }
+            if (m.Timestamp != 0)
+            {
+                writer.WriteKey(2, WireFormat.Varint);
+                writer.WriteSigned(m.Timestamp);
+            }
+            if (m.ResponseTo != null)
+            {
+                writer.WriteKey(3, WireFormat.LengthDelimited);
+                writer.WriteString(m.ResponseTo);
+            }
+            if (m.Chunk != null)
+            {
+                writer.WriteKey(4, WireFormat.LengthDelimited);
+                writer.WriteLength(SizeOf(m.Chunk, version));
+                Write(ref writer, m.Chunk, version);
+            }
+        }
+
+        internal static global::FyteClub.ModSystem.FileChunkMessage ReadFileChunkMessage(ReadOnlySpan<byte> data)
+        {
+            var m = new global::FyteClub.ModSystem.FileChunkMessage();
+            var reader = new WireReader(data);
+            while (reader.TryReadKey(out var tag, out var wireType))
+            {
+                switch (tag)
+                {
+                    case 1 when wireType == WireFormat.LengthDelimited:
+                        m.MessageId = reader.ReadString();
+                        break;
+                    case 2 when wireType == WireFormat.Varint:
+                        m.Timestamp = reader.ReadSigned();
+                        break;
+                    case 3 when wireType == WireFormat.LengthDelimited:
+                        m.ResponseTo = reader.ReadString();
+                        break;
+                    case 4 when wireType == WireFormat.LengthDelimited:
+                        m.Chunk = ReadFileChunk(reader.ReadLengthDelimited());
+                        break;
+                    default:
+                        reader.Skip(wireType);
+                        break;
+                }
+            }
+            return m;
+        }
+
+        internal static int SizeOf(global::FyteClub.ModSystem.MemberListRequestMessage m, int version)
+        {
+            var size = 0;
+            if (!string.IsNullOrEmpty(m.MessageId))
+                size += WireFormat.KeySize(1) + WireFormat.StringSize(m.MessageId);
+            if (m.Timestamp != 0)
+                size += WireFormat.KeySize(2) + WireFormat.SignedSize(m.Timestamp);
+            if (m.ResponseTo != null)
+                size += WireFormat.KeySize(3) + WireFormat.StringSize(m.ResponseTo);
+            if (!string.IsNullOrEmpty(m.SyncshellId))
+                size += WireFormat.KeySize(4) + WireFormat.StringSize(m.SyncshellId);
+            if (!string.IsNullOrEmpty(m.RequestedBy))
+                size += WireFormat.KeySize(5) + WireFormat.StringSize(m.RequestedBy);
+            return size;
+        }
+
+        internal static void Write(ref WireWriter writer, global::FyteClub.ModSystem.MemberListRequestMessage m, int version)
+        {
+            if (!string.IsNullOrEmpty(m.MessageId))
+            {
+                writer.WriteKey(1, WireFormat.LengthDelimited);
+                writer.WriteString(m.MessageId);
+            }
+            if (m.Timestamp != 0)
+            {
+                writer.WriteKey(2, WireFormat.Varint);
+                writer.WriteSigned(m.Timestamp);
+            }
+            if (m.ResponseTo != null)
+            {
+                writer.WriteKey(3, WireFormat.LengthDelimited);
+                writer.WriteString(m.ResponseTo);
+            }
+            if (!string.IsNullOrEmpty(m.SyncshellId))
+            {
+                writer.WriteKey(4, WireFormat.LengthDelimited);
+                writer.WriteString(m.SyncshellId);
+            }
+            if (!string.IsNullOrEmpty(m.RequestedBy))
+            {
+                writer.WriteKey(5, WireFormat.LengthDelimited);
+                writer.WriteString(m.RequestedBy);
+            }
+        }
+
+        internal static global::FyteClub.ModSystem.MemberListRequestMessage ReadMemberListRequestMessage(ReadOnlySpan<byte> data)
+        {
+            var m = new global::FyteClub.ModSystem.MemberListRequestMessage();
+            var reader = new WireReader(data);
+            while (reader.TryReadKey(out var tag, out var wireType))
+            {
+                switch (tag)
+                {
+                    case 1 when wireType == WireFormat.LengthDelimited:
+                        m.MessageId = reader.ReadString();
+                        break;
+                    case 2 when wireType == WireFormat.Varint:
+                        m.Timestamp = reader.ReadSigned();
+                        break;
+                    case 3 when wireType == WireFormat.LengthDelimited:
+                        m.ResponseTo = reader.ReadString();
+                        break;
+                    case 4 when wireType == WireFormat.LengthDelimited:
+                        m.SyncshellId = reader.ReadString();
+                        break;
+                    case 5 when wireType == WireFormat.LengthDelimited:
+                        m.RequestedBy = reader.ReadString();
+                        break;
+                    default:
+                        reader.Skip(wireType);
+                        break;
+                }
+            }
+            return m;
+        }
+
+        internal static int SizeOf(global::FyteClub.ModSystem.MemberListResponseMessage m, int version)
+        {
+            var size = 0;
+            if (!string.IsNullOrEmpty(m.MessageId))
+                size += WireFormat.KeySize(1) + WireFormat.StringSize(m.MessageId);
+            if (m.Timestamp != 0)
+                size += WireFormat.KeySize(2) + WireFormat.SignedSize(m.Timestamp);
+            if (m.ResponseTo != null)
+                size += WireFormat.KeySize(3) + WireFormat.StringSize(m.ResponseTo);
+            if (!string.IsNullOrEmpty(m.SyncshellId))
+                size += WireFormat.KeySize(4) + WireFormat.StringSize(m.SyncshellId);
+            if (!string.IsNullOrEmpty(m.HostName))
+                size += WireFormat.KeySize(5) + WireFormat.StringSize(m.HostName);
+            if (m.Members != null)
+            {
+                foreach (var item in m.Members)
+                    size += WireFormat.KeySize(6) + WireFormat.StringSize((item ?? string.Empty));
+            }
+            if (m.IsHost)
+                size += WireFormat.KeySize(7) + 1;
+            return size;
+        }
+
+        internal static void Write(ref WireWriter writer, global::FyteClub.ModSystem.MemberListResponseMessage m, int version)
+        {
+            if (!string.IsNullOrEmpty(m.MessageId))
+            {
+                writer.WriteKey(1, WireFormat.LengthDelimited);
+                writer.WriteString(m.MessageId);
+            }
+            if (m.Timestamp != 0)
+            {
+                writer.WriteKey(2, WireFormat.Varint);
+                writer.WriteSigned(m.Timestamp);
+            }
+            if (m.ResponseTo != null)
+            {
+                writer.WriteKey(3, WireFormat.LengthDelimited);
+                writer.WriteString(m.ResponseTo);
+            }
+            if (!string.IsNullOrEmpty(m.SyncshellId))
+            {
+                writer.WriteKey(4, WireFormat.LengthDelimited);
+                writer.WriteString(m.SyncshellId);
+            }
+            if (!string.IsNullOrEmpty(m.HostName))
+            {
+                writer.WriteKey(5, WireFormat.LengthDelimited);
+                writer.WriteString(m.HostName);
+            }
+            if (m.Members != null)
+            {
+                foreach (var listItem in m.Members)
+                {
+                    var item = listItem ?? string.Empty;
+                    writer.WriteKey(6, WireFormat.LengthDelimited);
+                    writer.WriteString(item);
+                }
+            }
+            if (m.IsHost)
+            {
+                writer.WriteKey(7, WireFormat.Varint);
+                writer.WriteVarint(m.IsHost ? 1UL : 0UL);
+            }
+        }
+
+        internal static global::FyteClub.ModSystem.MemberListResponseMessage ReadMemberListResponseMessage(ReadOnlySpan<byte> data)
+        {
+            var m = new global::FyteClub.ModSystem.MemberListResponseMessage();
+            var reader = new WireReader(data);
+            while (reader.TryReadKey(out var tag, out var wireType))
+            {
+                switch (tag)
+                {
+                    case 1 when wireType == WireFormat.LengthDelimited:
+                        m.MessageId = reader.ReadString();
+                        break;
+                    case 2 when wireType == WireFormat.Varint:
+                        m.Timestamp = reader.ReadSigned();
+                        break;
+                    case 3 when wireType == WireFormat.LengthDelimited:
+                        m.ResponseTo = reader.ReadString();
+                        break;
+                    case 4 when wireType == WireFormat.LengthDelimited:
+                        m.SyncshellId = reader.ReadString();
+                        break;
+                    case 5 when wireType == WireFormat.LengthDelimited:
+                        m.HostName = reader.ReadString();
+                        break;
+                    case 6 when wireType == WireFormat.LengthDelimited:
+                        m.Members.Add(reader.ReadString());
+                        break;
+                    case 7 when wireType == WireFormat.Varint:
+                        m.IsHost = reader.ReadVarint() != 0;
+                        break;
+                    default:
+                        reader.Skip(wireType);
+                        break;
+                }
+            }
+            return m;
+        }
+
+        internal static int SizeOf(global::FyteClub.ModSystem.ChannelNegotiationMessage m, int version)
+        {
+            var size = 0;
+            if (!string.IsNullOrEmpty(m.MessageId))
+                size += WireFormat.KeySize(1) + WireFormat.StringSize(m.MessageId);
+            if (m.Timestamp != 0)
+                size += WireFormat.KeySize(2) + WireFormat.SignedSize(m.Timestamp);
+            if (m.ResponseTo != null)
+                size += WireFormat.KeySize(3) + WireFormat.StringSize(m.ResponseTo);
+            if (m.ModCount != 0)
+                size += WireFormat.KeySize(4) + WireFormat.SignedSize(m.ModCount);
+            if (m.LargeModCount != 0)
+                size += WireFormat.KeySize(5) + WireFormat.SignedSize(m.LargeModCount);
+            if (m.SmallModCount != 0)
+                size += WireFormat.KeySize(6) + WireFormat.SignedSize(m.SmallModCount);
+            if (m.AvailableMemoryMB != 0)
+                size += WireFormat.KeySize(7) + WireFormat.VarintSize(m.AvailableMemoryMB);
+            if (m.TotalDataMB != 0)
+                size += WireFormat.KeySize(8) + WireFormat.VarintSize(m.TotalDataMB);
+            if (m.RequestedChannels != 0)
+                size += WireFormat.KeySize(9) + WireFormat.SignedSize(m.RequestedChannels);
+            if (!string.IsNullOrEmpty(m.PlayerName))
+                size += WireFormat.KeySize(10) + WireFormat.StringSize(m.PlayerName);
+            return size;
+        }
+
+        internal static void Write(ref WireWriter writer, global::FyteClub.ModSystem.ChannelNegotiationMessage m, int version)
+        {
+            if (!string.IsNullOrEmpty(m.MessageId))
+            {
+                writer.WriteKey(1, WireFormat.LengthDelimited);
+                writer.WriteString(m.MessageId);
+            }
+            if (m.Timestamp != 0)
+            {
+                writer.WriteKey(2, WireFormat.Varint);
+                writer.WriteSigned(m.Timestamp);
+            }
+            if (m.ResponseTo != null)
+            {
+                writer.WriteKey(3, WireFormat.LengthDelimited);
+                writer.WriteString(m.ResponseTo);
+            }
+            if (m.ModCount != 0)
+            {
+                writer.WriteKey(4, WireFormat.Varint);
+                writer.WriteSigned(m.ModCount);
+            }
+            if (m.LargeModCount != 0)
+            {
+                writer.WriteKey(5, WireFormat.Varint);
+                writer.WriteSigned(m.LargeModCount);
+            }
+            if (m.SmallModCount != 0)
+            {
+                writer.WriteKey(6, WireFormat.Varint);
+                writer.WriteSigned(m.SmallModCount);
+            }
+            if (m.AvailableMemoryMB != 0)
+            {
+                writer.WriteKey(7, WireFormat.Varint);
+                writer.WriteVarint(m.AvailableMemoryMB);
+            }
+            if (m.TotalDataMB != 0)
+            {
+                writer.WriteKey(8, WireFormat.Varint);
+                writer.WriteVarint(m.TotalDataMB);
+            }
+            if (m.RequestedChannels != 0)
+            {
+                writer.WriteKey(9, WireFormat.Varint);
+                writer.WriteSigned(m.RequestedChannels);
+            }
+            if (!string.IsNullOrEmpty(m.PlayerName))
+            {
+                writer.WriteKey(10, WireFormat.LengthDelimited);
+                writer.WriteString(m.PlayerName);
+            }
+        }
+
+        internal static global::FyteClub.ModSystem.ChannelNegotiationMessage ReadChannelNegotiationMessage(ReadOnlySpan<byte> data)
+        {
+            var m = new global::FyteClub.ModSystem.ChannelNegotiationMessage();
+            var reader = new WireReader(data);
+            while (reader.TryReadKey(out var tag, out var wireType))
+            {
+                switch (tag)
+                {
+                    case 1 when wireType == WireFormat.LengthDelimited:
+                        m.MessageId = reader.ReadString();
+                        break;
+                    case 2 when wireType == WireFormat.Varint:
+                        m.Timestamp = reader.ReadSigned();
+                        break;
+                    case 3 when wireType == WireFormat.LengthDelimited:
+                        m.ResponseTo = reader.ReadString();
+                        break;
+                    case 4 when wireType == WireFormat.Varint:
+                        m.ModCount = (int)reader.ReadSigned();
+                        break;
+                    case 5 when wireType == WireFormat.Varint:
+                        m.LargeModCount = (int)reader.ReadSigned();
+                        break;
+                    case 6 when wireType == WireFormat.Varint:
+                        m.SmallModCount = (int)reader.ReadSigned();
+                        break;
+                    case 7 when wireType == WireFormat.Varint:
+                        m.AvailableMemoryMB = reader.ReadVarint();
+                        break;
+                    case 8 when wireType == WireFormat.Varint:
+                        m.TotalDataMB = reader.ReadVarint();
+                        break;
+                    case 9 when wireType == WireFormat.Varint:
+                        m.RequestedChannels = (int)reader.ReadSigned();
+                        break;
+                    case 10 when wireType == WireFormat.LengthDelimited:
+                        m.PlayerName = reader.ReadString();
+                        break;
+                    default:
+                        reader.Skip(wireType);
+                        break;
+                }
+            }
+            return m;
+        }
+
+        internal static int SizeOf(global::FyteClub.ModSystem.ChannelNegotiationResponse m, int version)
+        {
+            var size = 0;
+            if (!string.IsNullOrEmpty(m.MessageId))
+                size += WireFormat.KeySize(1) + WireFormat.StringSize(m.MessageId);
+            if (m.Timestamp != 0)
+                size += WireFormat.KeySize(2) + WireFormat.SignedSize(m.Timestamp);
+            if (m.ResponseTo != null)
+                size += WireFormat.KeySize(3) + WireFormat.StringSize(m.ResponseTo);
+            if (m.MyChannels != 0)
+                size += WireFormat.KeySize(4) + WireFormat.SignedSize(m.MyChannels);
+            if (m.YourChannels != 0)
+                size += WireFormat.KeySize(5) + WireFormat.SignedSize(m.YourChannels);
+            if (m.LimitingMemoryMB != 0)
+                size += WireFormat.KeySize(6) + WireFormat.VarintSize(m.LimitingMemoryMB);
+            if (!string.IsNullOrEmpty(m.PlayerName))
+                size += WireFormat.KeySize(7) + WireFormat.StringSize(m.PlayerName);
+            return size;
+        }
+
+        internal static void Write(ref WireWriter writer, global::FyteClub.ModSystem.ChannelNegotiationResponse m, int version)
+        {
+            if (!string.IsNullOrEmpty(m.MessageId))
+            {
+                writer.WriteKey(1, WireFormat.LengthDelimited);
+                writer.WriteString(m.MessageId);
+            }
+            if (m.Timestamp != 0)
+            {
+                writer.WriteKey(2, WireFormat.Varint);
+                writer.WriteSigned(m.Timestamp);
+            }
+            if (m.ResponseTo != null)
+            {
+                writer.WriteKey(3, WireFormat.LengthDelimited);
+                writer.WriteString(m.ResponseTo);
+            }
+            if (m.MyChannels != 0)
+            {
+                writer.WriteKey(4, WireFormat.Varint);
+                writer.WriteSigned(m.MyChannels);
+            }
+            if (m.YourChannels != 0)
+            {
+                writer.WriteKey(5, WireFormat.Varint);
+                writer.WriteSigned(m.YourChannels);
+            }
+            if (m.LimitingMemoryMB != 0)
+            {
+                writer.WriteKey(6, WireFormat.Varint);
+                writer.WriteVarint(m.LimitingMemoryMB);
+            }
+            if (!string.IsNullOrEmpty(m.PlayerName))
+            {
+                writer.WriteKey(7, WireFormat.LengthDelimited);
+                writer.WriteString(m.PlayerName);
+            }
+        }
+
+        internal static global::FyteClub.ModSystem.ChannelNegotiationResponse ReadChannelNegotiationResponse(ReadOnlySpan<byte> data)
+        {
+            var m = new global::FyteClub.ModSystem.ChannelNegotiationResponse();
+            var reader = new WireReader(data);
+            while (reader.TryReadKey(out var tag, out var wireType))
+            {
+                switch (tag)
+                {
+                    case 1 when wireType == WireFormat.LengthDelimited:
+                        m.MessageId = reader.ReadString();
+                        break;
+                    case 2 when wireType == WireFormat.Varint:
+                        m.Timestamp = reader.ReadSigned();
+                        break;
+                    case 3 when wireType == WireFormat.LengthDelimited:
+                        m.ResponseTo = reader.ReadString();
+                        break;
+                    case 4 when wireType == WireFormat.Varint:
+                        m.MyChannels = (int)reader.ReadSigned();
+                        break;
+                    case 5 when wireType == WireFormat.Varint:
+                        m.YourChannels = (int)reader.ReadSigned();
+                        break;
+                    case 6 when wireType == WireFormat.Varint:
+                        m.LimitingMemoryMB = reader.ReadVarint();
+                        break;
+                    case 7 when wireType == WireFormat.LengthDelimited:
+                        m.PlayerName = reader.ReadString();
+                        break;
+                    default:
+                        reader.Skip(wireType);
+                        break;
+                }
+            }
+            return m;
+        }
+
+        internal static int SizeOf(global::FyteClub.ModSystem.ReconnectOfferMessage m, int version)
+        {
+            var size = 0;
+            if (!string.IsNullOrEmpty(m.MessageId))
+                size += WireFormat.KeySize(1) + WireFormat.StringSize(m.MessageId);
+            if (m.Timestamp != 0)
+                size += WireFormat.KeySize(2) + WireFormat.SignedSize(m.Timestamp);
+            if (m.ResponseTo != null)
+                size += WireFormat.KeySize(3) + WireFormat.StringSize(m.ResponseTo);
+            if (!string.IsNullOrEmpty(m.TargetPeerId))
+                size += WireFormat.KeySize(4) + WireFormat.StringSize(m.TargetPeerId);
+            if (!string.IsNullOrEmpty(m.SourcePeerId))
+                size += WireFormat.KeySize(5) + WireFormat.StringSize(m.SourcePeerId);
+            if (!string.IsNullOrEmpty(m.OfferSdp))
+                size += WireFormat.KeySize(6) + WireFormat.StringSize(m.OfferSdp);
+            if (!string.IsNullOrEmpty(m.RecoverySessionId))
+                size += WireFormat.KeySize(7) + WireFormat.StringSize(m.RecoverySessionId);
+            return size;
+        }
+
+        internal static void Write(ref WireWriter writer, global::FyteClub.ModSystem.ReconnectOfferMessage m, int version)
+        {
+            if (!string.IsNullOrEmpty(m.MessageId))
+            {
+                writer.WriteKey(1, WireFormat.LengthDelimited);
+                writer.WriteString(m.MessageId);
+            }
+            if (m.Timestamp != 0)
+            {
+                writer.WriteKey(2, WireFormat.Varint);
+                writer.WriteSigned(m.Timestamp);
+            }
+            if (m.ResponseTo != null)
+            {
+                writer.WriteKey(3, WireFormat.LengthDelimited);
+                writer.WriteString(m.ResponseTo);
+            }
+            if (!string.IsNullOrEmpty(m.TargetPeerId))
+            {
+                writer.WriteKey(4, WireFormat.LengthDelimited);
+                writer.WriteString(m.TargetPeerId);
+            }
+            if (!string.IsNullOrEmpty(m.SourcePeerId))
+            {
+                writer.WriteKey(5, WireFormat.LengthDelimited);
+                writer.WriteString(m.SourcePeerId);
+            }
+            if (!string.IsNullOrEmpty(m.OfferSdp))
+            {
+                writer.WriteKey(6, WireFormat.LengthDelimited);
+                writer.WriteString(m.OfferSdp);
+            }
+            if (!string.IsNullOrEmpty(m.RecoverySessionId))
+            {
+                writer.WriteKey(7, WireFormat.LengthDelimited);
+                writer.WriteString(m.RecoverySessionId);
+            }
+        }
+
+        internal static global::FyteClub.ModSystem.ReconnectOfferMessage ReadReconnectOfferMessage(ReadOnlySpan<byte> data)
+        {
+            var m = new global::FyteClub.ModSystem.ReconnectOfferMessage();
+            var reader = new WireReader(data);
+            while (reader.TryReadKey(out var tag, out var wireType))
+            {
+                switch (tag)
+                {
+                    case 1 when wireType == WireFormat.LengthDelimited:
+                        m.MessageId = reader.ReadString();
+                        break;
+                    case 2 when wireType == WireFormat.Varint:
+                        m.Timestamp = reader.ReadSigned();
+                        break;
+                    case 3 when wireType == WireFormat.LengthDelimited:
+                        m.ResponseTo = reader.ReadString();
+                        break;
+                    case 4 when wireType == WireFormat.LengthDelimited:
+                        m.TargetPeerId = reader.ReadString();
+                        break;
+                    case 5 when wireType == WireFormat.LengthDelimited:
+                        m.SourcePeerId = reader.ReadString();
+                        break;
+                    case 6 when wireType == WireFormat.LengthDelimited:
+                        m.OfferSdp = reader.ReadString();
+                        break;
+                    case 7 when wireType == WireFormat.LengthDelimited:
+                        m.RecoverySessionId = reader.ReadString();
+                        break;
+                    default:
+                        reader.Skip(wireType);
+                        break;
+                }
+            }
+            return m;
+        }
+
+        internal static int SizeOf(global::FyteClub.ModSystem.ReconnectAnswerMessage m, int version)
+        {
+            var size = 0;
+            if (!string.IsNullOrEmpty(m.MessageId))
+                size += WireFormat.KeySize(1) + WireFormat.StringSize(m.MessageId);
+            if (m.Timestamp != 0)
+                size += WireFormat.KeySize(2) + WireFormat.SignedSize(m.Timestamp);
+            if (m.ResponseTo != null)
+                size += WireFormat.KeySize(3) + WireFormat.StringSize(m.ResponseTo);
+            if (!string.IsNullOrEmpty(m.TargetPeerId))
+                size += WireFormat.KeySize(4) + WireFormat.StringSize(m.TargetPeerId);
+            if (!string.IsNullOrEmpty(m.SourcePeerId))
+                size += WireFormat.KeySize(5) + WireFormat.StringSize(m.SourcePeerId);
+            if (!string.IsNullOrEmpty(m.AnswerSdp))
+                size += WireFormat.KeySize(6) + WireFormat.StringSize(m.AnswerSdp);
+            if (!string.IsNullOrEmpty(m.RecoverySessionId))
+                size += WireFormat.KeySize(7) + WireFormat.StringSize(m.RecoverySessionId);
+            return size;
+        }
+
+        internal static void Write(ref WireWriter writer, global::FyteClub.ModSystem.ReconnectAnswerMessage m, int version)
+        {
+            if (!string.IsNullOrEmpty(m.MessageId))
+            {
+                writer.WriteKey(1, WireFormat.LengthDelimited);
+                writer.WriteString(m.MessageId);
+            }
+            if (m.Timestamp != 0)
+            {
+                writer.WriteKey(2, WireFormat.Varint);
+                writer.WriteSigned(m.Timestamp);
+            }
+            if (m.ResponseTo != null)
+            {
+                writer.WriteKey(3, WireFormat.LengthDelimited);
+                writer.WriteString(m.ResponseTo);
+            }
+            if (!string.IsNullOrEmpty(m.TargetPeerId))
+            {
+                writer.WriteKey(4, WireFormat.LengthDelimited);
+                writer.WriteString(m.TargetPeerId);
+            }
+            if (!string.IsNullOrEmpty(m.SourcePeerId))
+            {
+                writer.WriteKey(5, WireFormat.LengthDelimited);
+                writer.WriteString(m.SourcePeerId);
+            }
+            if (!string.IsNullOrEmpty(m.AnswerSdp))
+            {
+                writer.WriteKey(6, WireFormat.LengthDelimited);
+                writer.WriteString(m.AnswerSdp);
+            }
+            if (!string.IsNullOrEmpty(m.RecoverySessionId))
+            {
+                writer.WriteKey(7, WireFormat.LengthDelimited);
+                writer.WriteString(m.RecoverySessionId);
+            }
+        }
+
+        internal static global::FyteClub.ModSystem.ReconnectAnswerMessage ReadReconnectAnswerMessage(ReadOnlySpan<byte> data)
+        {
+            var m = new global::FyteClub.ModSystem.ReconnectAnswerMessage();
+            var reader = new WireReader(data);
+            while (reader.TryReadKey(out var tag, out var wireType))
+            {
+                switch (tag)
+                {
+                    case 1 when wireType == WireFormat.LengthDelimited:
+                        m.MessageId = reader.ReadString();
+                        break;
+                    case 2 when wireType == WireFormat.Varint:
+                        m.Timestamp = reader.ReadSigned();
+                        break;
+                    case 3 when wireType == WireFormat.LengthDelimited:
+                        m.ResponseTo = reader.ReadString();
+                        break;
+                    case 4 when wireType == WireFormat.LengthDelimited:
+                        m.TargetPeerId = reader.ReadString();
+                        break;
+                    case 5 when wireType == WireFormat.LengthDelimited:
+                        m.SourcePeerId = reader.ReadString();
+                        break;
+                    case 6 when wireType == WireFormat.LengthDelimited:
+                        m.AnswerSdp = reader.ReadString();
+                        break;
+                    case 7 when wireType == WireFormat.LengthDelimited:
+                        m.RecoverySessionId = reader.ReadString();
+                        break;
+                    default:
+                        reader.Skip(wireType);
+                        break;
+                }
+            }
+            return m;
+        }
+
+        internal static int SizeOf(global::FyteClub.ModSystem.RecoveryRequestMessage m, int version)
+        {
+            var size = 0;
+            if (!string.IsNullOrEmpty(m.MessageId))
+                size += WireFormat.KeySize(1) + WireFormat.StringSize(m.MessageId);
+            if (m.Timestamp != 0)
+                size += WireFormat.KeySize(2) + WireFormat.SignedSize(m.Timestamp);
+            if (m.ResponseTo != null)
+                size += WireFormat.KeySize(3) + WireFormat.StringSize(m.ResponseTo);
+            if (!string.IsNullOrEmpty(m.SyncshellId))
+                size += WireFormat.KeySize(4) + WireFormat.StringSize(m.SyncshellId);
+            if (!string.IsNullOrEmpty(m.PeerId))
+                size += WireFormat.KeySize(5) + WireFormat.StringSize(m.PeerId);
+            if (m.CompletedFiles != null)
+            {
+                foreach (var item in m.CompletedFiles)
+                    size += WireFormat.KeySize(6) + WireFormat.StringSize((item ?? string.Empty));
+            }
+            if (m.CompletedHashes != null)
+            {
+                foreach (var entry in m.CompletedHashes)
+                    size += WireFormat.KeySize(7) + WireFormat.LengthPrefixedSize((string.IsNullOrEmpty(entry.Key) ? 0 : 1 + WireFormat.StringSize(entry.Key)) + (!string.IsNullOrEmpty(entry.Value) ? 1 + WireFormat.StringSize(entry.Value) : 0));
+            }
+            return size;
+        }
+
+        internal static void Write(ref WireWriter writer, global::FyteClub.ModSystem.RecoveryRequestMessage m, int version)
+        {
+            if (!string.IsNullOrEmpty(m.MessageId))
+            {
+                writer.WriteKey(1, WireFormat.LengthDelimited);
+                writer.WriteString(m.MessageId);
+            }
+            if (m.Timestamp != 0)
+            {
+                writer.WriteKey(2, WireFormat.Varint);
+                writer.WriteSigned(m.Timestamp);
+            }
+            if (m.ResponseTo != null)
+            {
+                writer.WriteKey(3, WireFormat.LengthDelimited);
+                writer.WriteString(m.ResponseTo);
+            }
+            if (!string.IsNullOrEmpty(m.SyncshellId))
+            {
+                writer.WriteKey(4, WireFormat.LengthDelimited);
+                writer.WriteString(m.SyncshellId);
+            }
+            if (!string.IsNullOrEmpty(m.PeerId))
+            {
+                writer.WriteKey(5, WireFormat.LengthDelimited);
+                writer.WriteString(m.PeerId);
+            }
+            if (m.CompletedFiles != null)
+            {
+                foreach (var listItem in m.CompletedFiles)
+                {
+                    var item = listItem ?? string.Empty;
+                    writer.WriteKey(6, WireFormat.LengthDelimited);
+                    writer.WriteString(item);
+                }
+            }
+            if (m.CompletedHashes != null)
+            {
+                foreach (var entry in m.CompletedHashes)
+                {
+                    writer.WriteKey(7, WireFormat.LengthDelimited);
+                    writer.WriteLength((string.IsNullOrEmpty(entry.Key) ? 0 : 1 + WireFormat.StringSize(entry.Key)) + (!string.IsNullOrEmpty(entry.Value) ? 1 + WireFormat.StringSize(entry.Value) : 0));
+                    if (!string.IsNullOrEmpty(entry.Key))
+                    {
+                        writer.WriteKey(1, WireFormat.LengthDelimited);
+                        writer.WriteString(entry.Key);
+                    }
+                    if (!string.IsNullOrEmpty(entry.Value))
+                    {
+                        writer.WriteKey(2, WireFormat.LengthDelimited);
+                        writer.WriteString(entry.Value);
+                    }
+                }
+            }
+        }
+
+        internal static global::FyteClub.ModSystem.RecoveryRequestMessage ReadRecoveryRequestMessage(ReadOnlySpan<byte> data)
+        {
+            var m = new global::FyteClub.ModSystem.RecoveryRequestMessage();
+            var reader = new WireReader(data);
+            while (reader.TryReadKey(out var tag, out var wireType))
+            {
+                switch (tag)
+                {
+                    case 1 when wireType == WireFormat.LengthDelimited:
+                        m.MessageId = reader.ReadString();
+                        break;
+                    case 2 when wireType == WireFormat.Varint:
+                        m.Timestamp = reader.ReadSigned();
+                        break;
+                    case 3 when wireType == WireFormat.LengthDelimited:
+                        m.ResponseTo = reader.ReadString();
+                        break;
+                    case 4 when wireType == WireFormat.LengthDelimited:
+                        m.SyncshellId = reader.ReadString();
+                        break;
+                    case 5 when wireType == WireFormat.LengthDelimited:
+                        m.PeerId = reader.ReadString();
+                        break;
+                    case 6 when wireType == WireFormat.LengthDelimited:
+                        m.CompletedFiles.Add(reader.ReadString());
+                        break;
+                    case 7 when wireType == WireFormat.LengthDelimited:
+                    {
+                        var entryReader = new WireReader(reader.ReadLengthDelimited());
+                        var key = string.Empty;
+                        var value = string.Empty;
+                        while (entryReader.TryReadKey(out var entryTag, out var entryWireType))
+                        {
+                            if (entryTag == 1 && entryWireType == WireFormat.LengthDelimited)
+                                key = entryReader.ReadString();
+                            else if (entryTag == 2 && entryWireType == WireFormat.LengthDelimited)
+                                value = entryReader.ReadString();
+                            else
+                                entryReader.Skip(entryWireType);
+                        }
+                        m.CompletedHashes[key] = value;
+                        break;
+                    }
+                    default:
+                        reader.Skip(wireType);
+                        break;
+                }
+            }
+            return m;
+        }
+    }
+}
@@ -102,6 +102,13 @@ namespace FyteClub.ModSystem
         public AdvancedPlayerInfo PlayerInfo { get; set; } = new();
         public Dictionary<string, TransferableFile> FileReplacements { get; set; } = new();
         public bool IsCompressed { get; set; } = false;
+
+        // Set when the sender's upload admission queued or refused this sync and no files
+        // follow in this message: QueuePosition > 0 means the upload will start on its own
+        // after about RetryAfterMs, 0 means it was shed and should be retried after RetryAfterMs
+        public bool UploadDeferred { get; set; } = false;
+        public int QueuePosition { get; set; } = 0;
+        public int RetryAfterMs { get; set; } = 0;
     }
 
     /// <summary>
@@ -295,21 +302,32 @@ namespace FyteClub.ModSystem
         private readonly Dictionary<string, ChunkBuffer> _chunkBuffers = new();
         private readonly object _requestLock = new();
         private const int CHUNK_SIZE = 1024; // 1KB to respect MTU limits and prevent fragmentation
+        private const long MAX_REASSEMBLY_BYTES = 64L * 1024 * 1024; // one chunked message
+        private const long MAX_TOTAL_REASSEMBLY_BYTES = 256L * 1024 * 1024; // all messages being reassembled
+        private static readonly TimeSpan REASSEMBLY_TIMEOUT = TimeSpan.FromSeconds(60); // since the last chunk arrived
+        private long _reassemblyBytes; // guarded by _requestLock
         
         private class ChunkBuffer
         {
             public byte[] Data;
+            public bool[] Received;
             public int ReceivedChunks;
             public int TotalChunks;
+            public int LastChunkLength;
+            public string PeerId;
+            public DateTime LastActivity;
             public P2PModMessageType OriginalType;
             public string OriginalTypeName;
             public Dictionary<string, object> Metadata;
             
-            public ChunkBuffer(int totalChunks, int totalSize, P2PModMessageType type, string typeName, Dictionary<string, object> metadata)
+            public ChunkBuffer(int totalChunks, int totalSize, string peerId, P2PModMessageType type, string typeName, Dictionary<string, object> metadata)
             {
                 Data = new byte[totalSize];
+                Received = new bool[totalChunks];
                 ReceivedChunks = 0;
                 TotalChunks = totalChunks;
+                PeerId = peerId;
+                LastActivity = DateTime.UtcNow;
                 OriginalType = type;
                 OriginalTypeName = typeName;
                 Metadata = metadata;
@@ -426,7 +444,9 @@ namespace FyteClub.ModSystem
         }
 
         /// <summary>
-        /// Serialize a message for transmission over WebRTC
+        /// Serialize a message for transmission over WebRTC. Always JSON: DeserializeMessage
+        /// accepts schema frames (P2PWireCodec), but peers do not advertise that support yet, and
+        /// builds from before it would drop them. Sending binary needs that exchange first.
         /// </summary>
         public byte[] SerializeMessage(P2PModMessage message)
         {
@@ -478,9 +498,10 @@ namespace FyteClub.ModSystem
         }
 
         /// <summary>
-        /// Deserialize a message received over WebRTC
+        /// Deserialize a message received over WebRTC. peerId scopes chunked-message reassembly
+        /// so a peer's partial messages can be released when it disconnects.
         /// </summary>
-        public P2PModMessage? DeserializeMessage(byte[] data)
+        public P2PModMessage? DeserializeMessage(byte[] data, string? peerId = null)
         {
             try
             {
@@ -490,6 +511,15 @@ namespace FyteClub.ModSystem
                     return null;
                 }
 
+                // Schema-encoded binary frame (see P2PWireCodec)
+                if (data[0] == WireFormat.FrameFlag)
+                {
+                    var binaryMessage = P2PWireCodec.Deserialize(data);
+                    if (binaryMessage == null)
+                        _pluginLog.Warning($"[P2P] Unknown binary message frame ({data.Length} bytes)");
+                    return binaryMessage;
+                }
+
                 byte[] jsonBytes;
                 bool hasFraming = data[0] == 0 || data[0] == 1;
                 bool isCompressed = hasFraming && data[0] == 1;
@@ -689,7 +719,7 @@ else
                     if (messageType == P2PModMessageType.ChunkedMessage)
                     {
                         var chunkedMessage = JsonSerializer.Deserialize<ChunkedMessage>(json, options);
-                        var result = HandleChunkedMessage(chunkedMessage);
+                        var result = HandleChunkedMessage(chunkedMessage, peerId ?? string.Empty);
                         
                         // For chunked messages, null return is normal (still collecting chunks)
                         
@@ -925,18 +955,29 @@ else
         /// <summary>
         /// Handle chunked message reassembly
         /// </summary>
-        private P2PModMessage? HandleChunkedMessage(ChunkedMessage? chunk)
+        private P2PModMessage? HandleChunkedMessage(ChunkedMessage? chunk, string peerId)
         {
             if (chunk == null) return null;
 
             lock (_requestLock)
             {
-                if (string.IsNullOrEmpty(chunk.ChunkId) || !_chunkBuffers.TryGetValue(chunk.ChunkId, out var buffer))
+                // Chunk ids are chosen by the sender, so keep each peer's apart
+                var bufferKey = $"{peerId}/{chunk.ChunkId}";
+                if (string.IsNullOrEmpty(chunk.ChunkId) || !_chunkBuffers.TryGetValue(bufferKey, out var buffer))
                 {
-                    var totalSize = chunk.TotalChunks * CHUNK_SIZE; // Estimate, will be exact for last chunk
-                    buffer = new ChunkBuffer(chunk.TotalChunks, totalSize, chunk.OriginalMessageType, chunk.OriginalMessageTypeName, chunk.MessageMetadata);
-                    _chunkBuffers[chunk.ChunkId] = buffer;
+                    ExpireStaleReassembliesLocked(DateTime.UtcNow);
+                    var totalSize = (long)chunk.TotalChunks * CHUNK_SIZE; // Estimate, will be exact for last chunk
+                    // The size is whatever the peer claims, so bound it before allocating
+                    if (chunk.TotalChunks <= 0 || totalSize > MAX_REASSEMBLY_BYTES || _reassemblyBytes + totalSize > MAX_TOTAL_REASSEMBLY_BYTES)
+                    {
+                        _pluginLog.Warning($"[P2P] Refusing chunk {chunk.ChunkIndex} of {chunk.ChunkId}: {chunk.TotalChunks} chunks ({totalSize / 1024.0 / 1024.0:F1} MB) exceeds the reassembly budget");
+                        return null;
+                    }
+                    buffer = new ChunkBuffer(chunk.TotalChunks, (int)totalSize, peerId, chunk.OriginalMessageType, chunk.OriginalMessageTypeName, chunk.MessageMetadata);
+                    _chunkBuffers[bufferKey] = buffer;
+                    _reassemblyBytes += totalSize;
                 }
+                buffer.LastActivity = DateTime.UtcNow;
 
                 // Direct copy to pre-allocated buffer with bounds checks
                 var offset = chunk.ChunkIndex * CHUNK_SIZE;
@@ -954,11 +995,19 @@ else
                 {
                     _pluginLog.Error($"[P2P] No remaining space for chunk {chunk.ChunkIndex} at offset {offset} (buffer {buffer.Data.Length}) for {chunk.ChunkId}");
                 }
+                else if (buffer.Received[chunk.ChunkIndex])
+                {
+                    // Resent after a retry; counting it again would complete the message early
+                    _pluginLog.Debug($"[P2P] Ignoring duplicate chunk {chunk.ChunkIndex} for {chunk.ChunkId}");
+                    return null;
+                }
                 else
                 {
                     var safeLen = Math.Min(copyLen, remaining);
                     if (chunk.ChunkData != null) Buffer.BlockCopy(chunk.ChunkData, 0, buffer.Data, offset, safeLen);
+                    buffer.Received[chunk.ChunkIndex] = true;
                     buffer.ReceivedChunks++;
+                    if (chunk.ChunkIndex == buffer.TotalChunks - 1) buffer.LastChunkLength = safeLen;
                 }
                 
                 // Log progress every 25%
@@ -974,11 +1023,12 @@ else
                 
                 if (buffer.ReceivedChunks == buffer.TotalChunks)
                 {
-                    // Calculate actual size (last chunk might be smaller)
-                    var actualSize = (buffer.TotalChunks - 1) * CHUNK_SIZE + (chunk.ChunkData?.Length ?? 0);
+                    // Calculate actual size (last chunk might be smaller, and need not arrive last)
+                    var actualSize = (buffer.TotalChunks - 1) * CHUNK_SIZE + buffer.LastChunkLength;
                     var finalData = actualSize == buffer.Data.Length ? buffer.Data : buffer.Data[..actualSize];
                     
-                    _chunkBuffers.Remove(chunk.ChunkId);
+                    _chunkBuffers.Remove(bufferKey);
+                    _reassemblyBytes -= buffer.Data.Length;
                     _pluginLog.Info($"[P2P] ✅ Reassembled {actualSize} bytes from {buffer.TotalChunks} chunks ({actualSize / 1024.0 / 1024.0:F1} MB)");
                     
                     var reassembledMessage = ReconstructTypedMessage(finalData, buffer.OriginalType, buffer.OriginalTypeName, buffer.Metadata);
@@ -1003,6 +1053,49 @@ else
             return null;
         }
 
+        /// <summary>
+        /// Bytes currently held by partially received chunked messages
+        /// </summary>
+        public long ReassemblyBytes
+        {
+            get { lock (_requestLock) return _reassemblyBytes; }
+        }
+
+        /// <summary>
+        /// Drop a disconnected peer's partially received chunked messages and release their bytes
+        /// </summary>
+        public int ReleasePeerReassemblies(string peerId)
+        {
+            lock (_requestLock)
+            {
+                return RemoveReassembliesLocked(buffer => buffer.PeerId == peerId);
+            }
+        }
+
+        /// <summary>
+        /// Drop chunked messages with no new chunk for REASSEMBLY_TIMEOUT; their sender gave up
+        /// or disconnected without us hearing, and they would hold the budget forever
+        /// </summary>
+        private void ExpireStaleReassembliesLocked(DateTime now)
+        {
+            var expired = RemoveReassembliesLocked(buffer => now - buffer.LastActivity > REASSEMBLY_TIMEOUT);
+            if (expired > 0)
+            {
+                _pluginLog.Info($"[P2P] Expired {expired} stale chunked message(s), {_reassemblyBytes / 1024.0 / 1024.0:F1} MB still reassembling");
+            }
+        }
+
+        private int RemoveReassembliesLocked(Func<ChunkBuffer, bool> predicate)
+        {
+            var removed = _chunkBuffers.Where(kvp => predicate(kvp.Value)).ToList();
+            foreach (var (key, buffer) in removed)
+            {
+                _chunkBuffers.Remove(key);
+                _reassemblyBytes -= buffer.Data.Length;
+            }
+            return removed.Count;
+        }
+
         /// <summary>
         /// Explicitly reconstruct a message by type to ensure proper deserialization
         /// </summary>
@@ -1,9 +1,11 @@
 using System;
 using System.Collections.Generic;
+using System.Diagnostics;
 using System.Linq;
 using System.Threading.Tasks;
 using Dalamud.Plugin.Services;
 using FyteClub.ModSystem;
+using FyteClub.WebRTC;
 using FyteClub;
 
 namespace FyteClub.Plugin.ModSystem
@@ -22,6 +24,20 @@ namespace FyteClub.Plugin.ModSystem
         private readonly TransferCoordinator _transferCoordinator;
         private readonly TransferProtocolHandler _protocolHandler;
         
+        // Upload admission: null when webrtc_native is unavailable, and uploads run ungated
+        private readonly NativeUploadAdmission? _admission;
+        private readonly object _admissionLock = new();
+        private readonly Dictionary<ulong, TaskCompletionSource<bool>> _admissionWaiters = new(); // true = start, false = drop
+        private const ulong UNGATED_TICKET = 0; // native tickets start at 1
+        private const int MAX_ACTIVE_UPLOADS = 3;
+        private const int MAX_QUEUED_UPLOADS = 32;
+        private static readonly TimeSpan MAX_QUEUE_WAIT = TimeSpan.FromMinutes(2);
+        private const int UPLOAD_MEMORY_LIMIT_MB = 6144; // game working set; a heavily modded client sits around 3-4 GB
+        private const int UPLOAD_CPU_LIMIT_PERCENT = 85; // of all cores
+        private static readonly TimeSpan LOAD_SAMPLE_INTERVAL = TimeSpan.FromSeconds(1);
+        private DateTime _lastLoadSample = DateTime.MinValue;
+        private TimeSpan _lastProcessorTime;
+        
         // Size thresholds for different transfer strategies
         private const long SMALL_TRANSFER_THRESHOLD = 1 * 1024 * 1024; // 1MB - use direct streaming
         private const long MEDIUM_TRANSFER_THRESHOLD = 50 * 1024 * 1024; // 50MB - use progressive transfer
@@ -38,6 +54,12 @@ namespace FyteClub.Plugin.ModSystem
             _transferCoordinator = new TransferCoordinator(pluginLog);
             _protocolHandler = new TransferProtocolHandler(pluginLog, _transferCoordinator);
             
+            _admission = NativeUploadAdmission.TryCreate(MAX_ACTIVE_UPLOADS, MAX_QUEUED_UPLOADS, UPLOAD_MEMORY_LIMIT_MB, UPLOAD_CPU_LIMIT_PERCENT);
+            if (_admission == null)
+            {
+                _pluginLog.Warning("[SmartTransfer] Native upload admission unavailable - uploads are not gated");
+            }
+            
             // Wire up events
             _transferCoordinator.OnChannelCompleted += OnChannelCompleted;
             _transferCoordinator.OnTransferSessionCompleted += OnTransferSessionCompleted;
@@ -58,10 +80,18 @@ namespace FyteClub.Plugin.ModSystem
         /// </summary>
         public async Task SyncModsToPeer(string peerId, AdvancedPlayerInfo playerInfo, Dictionary<string, TransferableFile> files, Func<byte[], Task> sendFunction)
         {
+            // Calculate total data size
+            var totalSize = files.Values.Sum(f => (long)(f.Content?.Length ?? 0));
+            
+            // Wait for an upload slot; a queued or shed sync tells the peer when to expect it instead
+            var ticket = await AdmitUpload(peerId, playerInfo, files, totalSize, sendFunction);
+            if (ticket == null)
+            {
+                return;
+            }
+            
             try
             {
-                // Calculate total data size
-                var totalSize = files.Values.Sum(f => f.Content?.Length ?? 0);
                 _pluginLog.Info($"[SmartTransfer] Syncing to {peerId}: {totalSize / 1024.0 / 1024.0:F1} MB total");
                 
                 // Create current manifest
@@ -90,14 +120,171 @@ namespace FyteClub.Plugin.ModSystem
                 _differentialSync.StorePeerManifest(peerId, currentManifest);
                 
                 _pluginLog.Info($"[SmartTransfer] Sync completed for {peerId}");
+                ReleaseUpload(ticket.Value, totalSize);
             }
             catch (Exception ex)
             {
                 _pluginLog.Error($"[SmartTransfer] Sync failed for {peerId}: {ex.Message}");
+                ReleaseUpload(ticket.Value, null);
                 throw;
             }
         }
         
+        /// <summary>
+        /// Asks the native admission for an upload slot. Returns the ticket to release once the
+        /// upload ends, or null when this sync must not be sent now: already in flight to the
+        /// peer, shed under load, or queued past MAX_QUEUE_WAIT. Queued and shed syncs send the
+        /// peer a deferred ModDataResponse carrying the queue position and estimated wait.
+        /// </summary>
+        private async Task<ulong?> AdmitUpload(string peerId, AdvancedPlayerInfo playerInfo, Dictionary<string, TransferableFile> files,
+            long totalSize, Func<byte[], Task> sendFunction)
+        {
+            if (_admission == null)
+            {
+                return UNGATED_TICKET;
+            }
+            
+            var dataHash = CalculateDataHash(playerInfo, files);
+            UploadAdmissionDecision decision;
+            TaskCompletionSource<bool>? waiter = null;
+            lock (_admissionLock)
+            {
+                decision = _admission.Request(peerId, dataHash, totalSize);
+                if (decision.Result == UploadAdmissionResult.Queued)
+                {
+                    // A newer state for the same peer takes over the queued ticket and its place
+                    if (_admissionWaiters.Remove(decision.Ticket, out var superseded))
+                    {
+                        superseded.TrySetResult(false);
+                    }
+                    waiter = new TaskCompletionSource<bool>(TaskCreationOptions.RunContinuationsAsynchronously);
+                    _admissionWaiters[decision.Ticket] = waiter;
+                }
+            }
+            
+            switch (decision.Result)
+            {
+                case UploadAdmissionResult.Admitted:
+                    return decision.Ticket;
+                    
+                case UploadAdmissionResult.Duplicate:
+                    _pluginLog.Debug($"[SmartTransfer] Sync of {dataHash[..8]} to {peerId} is already admitted or queued");
+                    return null;
+                    
+                case UploadAdmissionResult.Shed:
+                    _pluginLog.Info($"[SmartTransfer] Shed sync to {peerId} ({decision.Reason}), retry after {decision.WaitMs} ms");
+                    await SendUploadDeferred(playerInfo, dataHash, decision, sendFunction);
+                    return null;
+            }
+            
+            _pluginLog.Info($"[SmartTransfer] Queued sync to {peerId} at position {decision.Position}, ~{decision.WaitMs} ms");
+            await SendUploadDeferred(playerInfo, dataHash, decision, sendFunction);
+            if (await Task.WhenAny(waiter!.Task, Task.Delay(MAX_QUEUE_WAIT)) == waiter.Task)
+            {
+                // false: superseded by a newer sync to this peer, or shutting down
+                return waiter.Task.Result ? decision.Ticket : null;
+            }
+            
+            lock (_admissionLock)
+            {
+                // Resolved between the timeout and here
+                if (!_admissionWaiters.TryGetValue(decision.Ticket, out var current) || current != waiter)
+                {
+                    return waiter.Task.Result ? decision.Ticket : null;
+                }
+                _admissionWaiters.Remove(decision.Ticket);
+            }
+            _pluginLog.Warning($"[SmartTransfer] Sync to {peerId} waited over {MAX_QUEUE_WAIT.TotalSeconds:F0}s for a slot - dropping it");
+            // Drops it from the queue, or frees the slot if it was promoted meanwhile
+            ReleaseUpload(decision.Ticket, null);
+            return null;
+        }
+        
+        /// <summary>
+        /// Feeds process memory and CPU use to the upload admission, which halves the upload slots
+        /// and sheds redundant uploads while either is over its limit. Called from the framework
+        /// update; samples at most once per LOAD_SAMPLE_INTERVAL.
+        /// </summary>
+        public void ReportLoad()
+        {
+            var now = DateTime.UtcNow;
+            var elapsed = now - _lastLoadSample;
+            if (_admission == null || elapsed < LOAD_SAMPLE_INTERVAL)
+            {
+                return;
+            }
+            
+            using var process = Process.GetCurrentProcess();
+            var processorTime = process.TotalProcessorTime;
+            // The first sample only sets the CPU baseline
+            if (_lastLoadSample != DateTime.MinValue)
+            {
+                var cpuPercent = (processorTime - _lastProcessorTime).TotalMilliseconds * 100.0 /
+                    (elapsed.TotalMilliseconds * Environment.ProcessorCount);
+                _admission.ReportLoad(process.WorkingSet64, (int)Math.Clamp(cpuPercent, 0, 100));
+            }
+            _lastLoadSample = now;
+            _lastProcessorTime = processorTime;
+        }
+        
+        private async Task SendUploadDeferred(AdvancedPlayerInfo playerInfo, string dataHash, UploadAdmissionDecision decision, Func<byte[], Task> sendFunction)
+        {
+            var notice = new ModDataResponse
+            {
+                PlayerName = playerInfo.PlayerName,
+                DataHash = dataHash,
+                UploadDeferred = true,
+                QueuePosition = (int)decision.Position,
+                RetryAfterMs = (int)Math.Min(decision.WaitMs, int.MaxValue)
+            };
+            
+            try
+            {
+                await _protocol.SendChunkedMessage(notice, sendFunction);
+            }
+            catch (Exception ex)
+            {
+                _pluginLog.Warning($"[SmartTransfer] Failed to send deferred notice: {ex.Message}");
+            }
+        }
+        
+        /// <summary>
+        /// Frees an upload slot and starts whichever queued syncs it promotes. bytesSent is null
+        /// for failed or abandoned uploads, which must not feed the wait estimate.
+        /// </summary>
+        private void ReleaseUpload(ulong ticket, long? bytesSent)
+        {
+            if (_admission == null || ticket == UNGATED_TICKET)
+            {
+                return;
+            }
+            
+            lock (_admissionLock)
+            {
+                if (bytesSent.HasValue)
+                {
+                    _admission.Complete(ticket, bytesSent.Value);
+                }
+                else
+                {
+                    _admission.Cancel(ticket);
+                }
+                
+                while (_admission.PopAdmitted(out var promoted))
+                {
+                    if (_admissionWaiters.Remove(promoted, out var waiter))
+                    {
+                        waiter.TrySetResult(true);
+                    }
+                    else
+                    {
+                        // Its sync gave up waiting; hand the slot on
+                        _admission.Cancel(promoted);
+                    }
+                }
+            }
+        }
+        
         /// <summary>
         /// Handle differential sync - only send what's changed
         /// </summary>
@@ -751,6 +938,16 @@ namespace FyteClub.Plugin.ModSystem
                 _peerChannelCounts.Clear();
                 _peerMultiChannelSendFunctions.Clear();
                 
+                lock (_admissionLock)
+                {
+                    foreach (var waiter in _admissionWaiters.Values)
+                    {
+                        waiter.TrySetResult(false);
+                    }
+                    _admissionWaiters.Clear();
+                    _admission?.Dispose();
+                }
+                
                 _pluginLog.Info("[SmartTransfer] SmartTransferOrchestrator disposed successfully");
             }
             catch (Exception ex)
@@ -0,0 +1,214 @@
+using System;
+using System.Buffers.Binary;
+using System.IO;
+using System.Text;
+
+namespace FyteClub.ModSystem
+{
+    /// <summary>
+    /// Wire format shared with native/wire_codec.h: a frame is flag 2, schema version,
+    /// varint message type, then tag/wire-type keyed fields. Signed integers and enums
+    /// are zigzag varints; empty strings and zero scalars are not written.
+    /// Only the receive side uses it so far; see P2PModProtocol.SerializeMessage.
+    /// </summary>
+    public static class WireFormat
+    {
+        public const byte FrameFlag = 2; // 0/1 are the JSON framing flags in SerializeMessage
+
+        public const int Varint = 0;
+        public const int LengthDelimited = 2;
+        public const int Fixed32 = 5;
+
+        public static ulong ZigZag(long value) => (ulong)((value << 1) ^ (value >> 63));
+        public static long UnZigZag(ulong value) => (long)(value >> 1) ^ -(long)(value & 1);
+
+        public static int VarintSize(ulong value)
+        {
+            var size = 1;
+            while (value >= 0x80)
+            {
+                value >>= 7;
+                size++;
+            }
+            return size;
+        }
+
+        public static int SignedSize(long value) => VarintSize(ZigZag(value));
+        public static int KeySize(int tag) => VarintSize((ulong)tag << 3);
+        public static int LengthPrefixedSize(int length) => VarintSize((ulong)length) + length;
+        public static int StringSize(string value) => LengthPrefixedSize(Encoding.UTF8.GetByteCount(value));
+        public static int BytesSize(byte[] value) => LengthPrefixedSize(value.Length);
+        public static int FrameHeaderSize(int messageType) => 2 + VarintSize((ulong)messageType);
+
+        public static bool IsFrame(ReadOnlySpan<byte> data) => data.Length >= 3 && data[0] == FrameFlag;
+
+        public static bool TryReadFrameHeader(ReadOnlySpan<byte> data, out int version, out int messageType, out ReadOnlySpan<byte> body)
+        {
+            version = 0;
+            messageType = 0;
+            body = default;
+            if (!IsFrame(data))
+                return false;
+
+            var reader = new WireReader(data.Slice(2));
+            version = data[1];
+            messageType = (int)reader.ReadVarint();
+            body = data.Slice(2 + reader.Position);
+            return true;
+        }
+    }
+
+    /// <summary>
+    /// Writes wire fields into a buffer sized up front by the generated SizeOf methods
+    /// </summary>
+    public ref struct WireWriter
+    {
+        private readonly Span<byte> _buffer;
+        private int _position;
+
+        public WireWriter(Span<byte> buffer)
+        {
+            _buffer = buffer;
+            _position = 0;
+        }
+
+        public int Position => _position;
+
+        public void WriteFrameHeader(int version, int messageType)
+        {
+            _buffer[_position++] = WireFormat.FrameFlag;
+            _buffer[_position++] = (byte)version;
+            WriteVarint((ulong)messageType);
+        }
+
+        public void WriteKey(int tag, int wireType) => WriteVarint(((ulong)tag << 3) | (uint)wireType);
+
+        public void WriteVarint(ulong value)
+        {
+            while (value >= 0x80)
+            {
+                _buffer[_position++] = (byte)(value | 0x80);
+                value >>= 7;
+            }
+            _buffer[_position++] = (byte)value;
+        }
+
+        public void WriteSigned(long value) => WriteVarint(WireFormat.ZigZag(value));
+
+        public void WriteLength(int length) => WriteVarint((ulong)length);
+
+        public void WriteFloat(float value)
+        {
+            BinaryPrimitives.WriteInt32LittleEndian(_buffer.Slice(_position), BitConverter.SingleToInt32Bits(value));
+            _position += 4;
+        }
+
+        public void WriteString(string value)
+        {
+            var length = Encoding.UTF8.GetByteCount(value);
+            WriteLength(length);
+            Encoding.UTF8.GetBytes(value, _buffer.Slice(_position, length));
+            _position += length;
+        }
+
+        public void WriteBytes(byte[] value)
+        {
+            WriteLength(value.Length);
+            value.CopyTo(_buffer.Slice(_position));
+            _position += value.Length;
+        }
+    }
+
+    /// <summary>
+    /// Reads wire fields; throws InvalidDataException on truncated or malformed input
+    /// </summary>
+    public ref struct WireReader
+    {
+        private readonly ReadOnlySpan<byte> _data;
+        private int _position;
+
+        public WireReader(ReadOnlySpan<byte> data)
+        {
+            _data = data;
+            _position = 0;
+        }
+
+        public int Position => _position;
+
+        public bool TryReadKey(out int tag, out int wireType)
+        {
+            tag = 0;
+            wireType = 0;
+            if (_position >= _data.Length)
+                return false;
+
+            var key = ReadVarint();
+            tag = (int)(key >> 3);
+            wireType = (int)(key & 7);
+            return true;
+        }
+
+        public ulong ReadVarint()
+        {
+            ulong value = 0;
+            for (var shift = 0; shift < 64; shift += 7)
+            {
+                if (_position >= _data.Length)
+                    throw new InvalidDataException("Truncated varint");
+
+                var b = _data[_position++];
+                value |= (ulong)(b & 0x7F) << shift;
+                if (b < 0x80)
+                    return value;
+            }
+            throw new InvalidDataException("Varint too long");
+        }
+
+        public long ReadSigned() => WireFormat.UnZigZag(ReadVarint());
+
+        public float ReadFloat()
+        {
+            var bits = BinaryPrimitives.ReadInt32LittleEndian(Take(4));
+            return BitConverter.Int32BitsToSingle(bits);
+        }
+
+        public ReadOnlySpan<byte> ReadLengthDelimited()
+        {
+            var length = ReadVarint();
+            if (length > (ulong)(_data.Length - _position))
+                throw new InvalidDataException("Length-delimited field exceeds message");
+            return Take((int)length);
+        }
+
+        public string ReadString() => Encoding.UTF8.GetString(ReadLengthDelimited());
+
+        public byte[] ReadBytes() => ReadLengthDelimited().ToArray();
+
+        public void Skip(int wireType)
+        {
+            switch (wireType)
+            {
+                case WireFormat.Varint:
+                    ReadVarint();
+                    break;
+                case WireFormat.LengthDelimited:
+                    ReadLengthDelimited();
+                    break;
+                case WireFormat.Fixed32:
+                    Take(4);
+                    break;
+                default:
+                    throw new InvalidDataException($"Unknown wire type {wireType}");
+            }
+        }
+
+        private ReadOnlySpan<byte> Take(int count)
+        {
+            if (_data.Length - _position < count)
+                throw new InvalidDataException("Truncated field");
+            var slice = _data.Slice(_position, count);
+            _position += count;
+            return slice;
+        }
+    }
+}
@@ -0,0 +1,182 @@
+using System;
+using System.Buffers;
+using System.Runtime.InteropServices;
+using System.Threading;
+
+namespace FyteClub.WebRTC
+{
+    /// <summary>
+    /// Fixed set of equal-size buffers allocated by webrtc_native (native/buffer_arena.h) and
+    /// shared with it. Native memory never moves, so a rented buffer can be framed into from C#
+    /// and handed to a native send, or filled by a native receive and read from C#, without
+    /// pinning, marshaling or a GC-tracked array. Create one per connection or transfer path and
+    /// keep it for the connection's lifetime.
+    /// Not used yet: the MixedReality WebRTC data channels send and receive managed arrays, so
+    /// this only pays off on a transport that takes a pointer (native SendData, LanSend,
+    /// LanReceiveSlot) once the plugin binds one.
+    /// </summary>
+    public sealed class NativeBufferArena : IDisposable
+    {
+        private const string NativeLibrary = "webrtc_native";
+
+        [DllImport(NativeLibrary)] private static extern IntPtr CreateBufferArena(int slotSize, int slotCount);
+        [DllImport(NativeLibrary)] private static extern IntPtr BufferArenaData(IntPtr arena);
+        [DllImport(NativeLibrary)] private static extern int BufferArenaSlotSize(IntPtr arena);
+        [DllImport(NativeLibrary)] private static extern int BufferArenaAcquire(IntPtr arena);
+        [DllImport(NativeLibrary)] private static extern int BufferArenaRelease(IntPtr arena, int slot);
+        [DllImport(NativeLibrary)] private static extern int BufferArenaPoll(IntPtr arena, out int slot, out int length);
+        [DllImport(NativeLibrary)] private static extern void DestroyBufferArena(IntPtr arena);
+
+        private readonly object _lock = new();
+        private readonly IntPtr _data;
+        private IntPtr _handle;
+        private int _outstanding;
+        private bool _disposed;
+
+        public int SlotSize { get; }
+        public int SlotCount { get; }
+
+        /// <summary>
+        /// Native handle, for exports that fill slots themselves (e.g. LanReceiveSlot).
+        /// </summary>
+        public IntPtr Handle => _handle;
+
+        public NativeBufferArena(int slotSize, int slotCount)
+        {
+            _handle = CreateBufferArena(slotSize, slotCount);
+            if (_handle == IntPtr.Zero)
+                throw new ArgumentOutOfRangeException(nameof(slotSize), "Buffer arena size is out of range");
+            _data = BufferArenaData(_handle);
+            SlotSize = BufferArenaSlotSize(_handle);
+            SlotCount = slotCount;
+        }
+
+        /// <summary>
+        /// Rents a free buffer, or returns null when all are in use (fall back to a managed
+        /// array or wait for one to come back). Dispose the buffer to return it.
+        /// </summary>
+        public ArenaBuffer? Rent()
+        {
+            lock (_lock)
+            {
+                if (_disposed) return null;
+                int slot = BufferArenaAcquire(_handle);
+                return slot < 0 ? null : Wrap(slot, 0);
+            }
+        }
+
+        /// <summary>
+        /// Next buffer a native receiver filled and posted, or null. The caller owns it.
+        /// </summary>
+        public ArenaBuffer? PollReceived()
+        {
+            lock (_lock)
+            {
+                if (_disposed) return null;
+                return BufferArenaPoll(_handle, out int slot, out int length) != 0 ? Wrap(slot, length) : null;
+            }
+        }
+
+        /// <summary>
+        /// Takes ownership of a slot a native export handed back by index (e.g. LanReceiveSlot).
+        /// </summary>
+        public ArenaBuffer Adopt(int slot, int length)
+        {
+            if ((uint)slot >= (uint)SlotCount) throw new ArgumentOutOfRangeException(nameof(slot));
+            if ((uint)length > (uint)SlotSize) throw new ArgumentOutOfRangeException(nameof(length));
+            lock (_lock)
+            {
+                if (_disposed) throw new ObjectDisposedException(nameof(NativeBufferArena));
+                return Wrap(slot, length);
+            }
+        }
+
+        private ArenaBuffer Wrap(int slot, int length)
+        {
+            _outstanding++;
+            return new ArenaBuffer(this, slot, _data + slot * SlotSize, SlotSize, length);
+        }
+
+        internal void Return(int slot)
+        {
+            lock (_lock)
+            {
+                BufferArenaRelease(_handle, slot);
+                if (--_outstanding == 0 && _disposed) Destroy();
+            }
+        }
+
+        /// <summary>
+        /// The native memory is freed once every rented buffer has been returned.
+        /// </summary>
+        public void Dispose()
+        {
+            lock (_lock)
+            {
+                if (_disposed) return;
+                _disposed = true;
+                if (_outstanding == 0) Destroy();
+            }
+        }
+
+        private void Destroy()
+        {
+            DestroyBufferArena(_handle);
+            _handle = IntPtr.Zero;
+        }
+    }
+
+    /// <summary>
+    /// One slot of a <see cref="NativeBufferArena"/> as Memory&lt;byte&gt;. Memory spans the
+    /// whole slot; Data is the Length bytes written or received. Pass Pointer and Length
+    /// straight to native sends. Dispose returns the slot; the memory must not be used after.
+    /// </summary>
+    public sealed unsafe class ArenaBuffer : MemoryManager<byte>
+    {
+        private readonly NativeBufferArena _arena;
+        private readonly byte* _pointer;
+        private int _length;
+        private int _returned;
+
+        public int Slot { get; }
+        public int Capacity { get; }
+        public IntPtr Pointer => (IntPtr)_pointer;
+
+        public int Length
+        {
+            get => _length;
+            set
+            {
+                if ((uint)value > (uint)Capacity) throw new ArgumentOutOfRangeException(nameof(value));
+                _length = value;
+            }
+        }
+
+        public Memory<byte> Data => Memory.Slice(0, _length);
+
+        internal ArenaBuffer(NativeBufferArena arena, int slot, IntPtr pointer, int capacity, int length)
+        {
+            _arena = arena;
+            Slot = slot;
+            _pointer = (byte*)pointer;
+            Capacity = capacity;
+            _length = length;
+        }
+
+        public override Span<byte> GetSpan() => new Span<byte>(_pointer, Capacity);
+
+        // Native memory is already fixed
+        public override MemoryHandle Pin(int elementIndex = 0)
+        {
+            if ((uint)elementIndex > (uint)Capacity) throw new ArgumentOutOfRangeException(nameof(elementIndex));
+            return new MemoryHandle(_pointer + elementIndex);
+        }
+
+        public override void Unpin() { }
+
+        protected override void Dispose(bool disposing)
+        {
+            if (Interlocked.Exchange(ref _returned, 1) == 0) _arena.Return(Slot);
+        }
+    }
+}
@@ -0,0 +1,154 @@
+using System;
+using System.Runtime.InteropServices;
+using System.Text;
+
+namespace FyteClub.WebRTC
+{
+    public enum UploadAdmissionResult
+    {
+        Admitted = 0,
+        Queued = 1,
+        Duplicate = 2,
+        Shed = 3,
+    }
+
+    public enum UploadShedReason
+    {
+        None = 0,
+        QueueFull = 1,
+        Redundant = 2,
+    }
+
+    public readonly record struct UploadAdmissionDecision(
+        UploadAdmissionResult Result, UploadShedReason Reason, ulong Ticket, uint Position, uint WaitMs);
+
+    /// <summary>
+    /// Outgoing upload admission from webrtc_native (native/upload_admission.h). Caps concurrent
+    /// uploads, queues the rest with a position and estimated wait, folds repeat requests and
+    /// sheds redundant ones under memory or CPU pressure. Peers and content are keyed by
+    /// <see cref="Key"/> of their ids. Thread-safe.
+    /// </summary>
+    public sealed class NativeUploadAdmission : IDisposable
+    {
+        private const string NativeLibrary = "webrtc_native";
+
+        [StructLayout(LayoutKind.Sequential)]
+        private struct NativeDecision
+        {
+            public int Result;
+            public int Reason;
+            public ulong Ticket;
+            public uint Position;
+            public uint WaitMs;
+        }
+
+        [DllImport(NativeLibrary)] private static extern IntPtr CreateUploadAdmission(int maxActive, int maxQueue, int memoryLimitMb, int cpuLimitPercent);
+        [DllImport(NativeLibrary)] private static extern int UploadAdmissionRequest(IntPtr admission, ulong peer, ulong contentKey, ulong estimatedBytes, ulong nowMs, out NativeDecision decision);
+        [DllImport(NativeLibrary)] private static extern void UploadAdmissionComplete(IntPtr admission, ulong ticket, ulong bytesSent, ulong nowMs);
+        [DllImport(NativeLibrary)] private static extern int UploadAdmissionCancel(IntPtr admission, ulong ticket, ulong nowMs);
+        [DllImport(NativeLibrary)] private static extern int UploadAdmissionPopAdmitted(IntPtr admission, out ulong ticket);
+        [DllImport(NativeLibrary)] private static extern void UploadAdmissionReportLoad(IntPtr admission, ulong memoryBytes, int cpuPercent);
+        [DllImport(NativeLibrary)] private static extern void DestroyUploadAdmission(IntPtr admission);
+
+        private readonly object _lock = new();
+        private IntPtr _handle;
+
+        private NativeUploadAdmission(IntPtr handle)
+        {
+            _handle = handle;
+        }
+
+        /// <summary>
+        /// Null when webrtc_native is missing or too old; callers then upload ungated.
+        /// memoryLimitMb / cpuLimitPercent of 0 disable that check.
+        /// </summary>
+        public static NativeUploadAdmission? TryCreate(int maxActive, int maxQueue, int memoryLimitMb = 0, int cpuLimitPercent = 0)
+        {
+            try
+            {
+                var handle = CreateUploadAdmission(maxActive, maxQueue, memoryLimitMb, cpuLimitPercent);
+                return handle == IntPtr.Zero ? null : new NativeUploadAdmission(handle);
+            }
+            catch (Exception ex) when (ex is DllNotFoundException || ex is EntryPointNotFoundException)
+            {
+                return null;
+            }
+        }
+
+        /// <summary>
+        /// Stable 64-bit key (FNV-1a over UTF-8) for a peer id or content hash.
+        /// </summary>
+        public static ulong Key(string value)
+        {
+            ulong hash = 14695981039346656037UL;
+            foreach (var b in Encoding.UTF8.GetBytes(value))
+            {
+                hash ^= b;
+                hash *= 1099511628211UL;
+            }
+            return hash;
+        }
+
+        private static ulong NowMs => (ulong)Environment.TickCount64;
+
+        public UploadAdmissionDecision Request(string peerId, string contentHash, long estimatedBytes)
+        {
+            lock (_lock)
+            {
+                if (_handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(NativeUploadAdmission));
+                UploadAdmissionRequest(_handle, Key(peerId), Key(contentHash), (ulong)Math.Max(0, estimatedBytes), NowMs, out var decision);
+                return new UploadAdmissionDecision((UploadAdmissionResult)decision.Result, (UploadShedReason)decision.Reason,
+                    decision.Ticket, decision.Position, decision.WaitMs);
+            }
+        }
+
+        /// <summary>
+        /// Frees the ticket's slot; bytesSent feeds the wait estimate.
+        /// </summary>
+        public void Complete(ulong ticket, long bytesSent)
+        {
+            lock (_lock)
+            {
+                if (_handle != IntPtr.Zero) UploadAdmissionComplete(_handle, ticket, (ulong)Math.Max(0, bytesSent), NowMs);
+            }
+        }
+
+        public bool Cancel(ulong ticket)
+        {
+            lock (_lock)
+            {
+                return _handle != IntPtr.Zero && UploadAdmissionCancel(_handle, ticket, NowMs) != 0;
+            }
+        }
+
+        /// <summary>
+        /// Next queued ticket that has been given a slot, in queue order.
+        /// </summary>
+        public bool PopAdmitted(out ulong ticket)
+        {
+            lock (_lock)
+            {
+                ticket = 0;
+                return _handle != IntPtr.Zero && UploadAdmissionPopAdmitted(_handle, out ticket) != 0;
+            }
+        }
+
+        public void ReportLoad(long memoryBytes, int cpuPercent)
+        {
+            lock (_lock)
+            {
+                if (_handle != IntPtr.Zero) UploadAdmissionReportLoad(_handle, (ulong)Math.Max(0, memoryBytes), cpuPercent);
+            }
+        }
+
+        public void Dispose()
+        {
+            lock (_lock)
+            {
+                if (_handle == IntPtr.Zero) return;
+                DestroyUploadAdmission(_handle);
+                _handle = IntPtr.Zero;
+            }
+        }
+    }
+}